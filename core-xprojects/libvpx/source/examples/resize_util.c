@@ -16,6 +16,7 @@
 #include <string.h>
 
 #include "../tools_common.h"
+#include "./vp9_rtcd.h"
 #include "../vp9/encoder/vp9_resize.h"
 
 static const char *exec_name = NULL;
@@ -104,6 +105,8 @@ int main(int argc, char *argv[]) {
   inbuf_v = inbuf_u + width * height / 4;
   outbuf_u = outbuf + target_width * target_height;
   outbuf_v = outbuf_u + target_width * target_height / 4;
+  // No codec is created here to set up the kernels of the resizer.
+  vp9_rtcd();
   f = 0;
   while (f < frames) {
     if (fread(inbuf, width * height * 3 / 2, 1, fpin) != 1) break;
@@ -318,7 +318,11 @@ int main(int argc, char **argv) {
   double psnr_totals[NUM_ENCODERS][4] = { { 0, 0 } };
   int psnr_count[NUM_ENCODERS] = { 0 };
 
+  /* Set pipeline to 1 to encode the resolutions concurrently. */
+  int pipeline = 0;
+
   int64_t cx_time = 0;
+  int64_t max_frame_time = 0;
 
   /* Set the required target bitrates for each resolution level.
    * If target bitrate for highest-resolution level is set to 0,
@@ -339,10 +343,10 @@ int main(int argc, char **argv) {
    * starting from highest resoln down to lowest resoln. */
   unsigned int num_temporal_layers[NUM_ENCODERS] = { 3, 3, 3 };
 
-  if (argc != (7 + 3 * NUM_ENCODERS))
+  if (argc != (7 + 3 * NUM_ENCODERS) && argc != (8 + 3 * NUM_ENCODERS))
     die("Usage: %s <width> <height> <frame_rate>  <infile> <outfile(s)> "
         "<rate_encoder(s)> <temporal_layer(s)> <key_frame_insert> <output "
-        "psnr?> \n",
+        "psnr?> [pipeline?] \n",
         argv[0]);
 
   printf("Using %s\n", vpx_codec_iface_name(interface));
@@ -396,6 +400,9 @@ int main(int argc, char **argv) {
 
   show_psnr = (int)strtol(argv[3 * NUM_ENCODERS + 6], NULL, 0);
 
+  if (argc == 8 + 3 * NUM_ENCODERS)
+    pipeline = (int)strtol(argv[3 * NUM_ENCODERS + 7], NULL, 0);
+
   /* Populate default encoder configuration */
   for (i = 0; i < NUM_ENCODERS; i++) {
     res[i] = vpx_codec_enc_config_default(interface, &cfg[i], 0);
@@ -533,6 +540,12 @@ int main(int argc, char **argv) {
     // printf("%d %d \n",i,max_intra_size_pct);
   }
 
+  /* Encode the resolutions on separate threads */
+  for (i = 0; i < NUM_ENCODERS; i++) {
+    if (vpx_codec_control(&codec[i], VP8E_SET_MULTI_RES_PIPELINE, pipeline))
+      die_codec(&codec[i], "Failed to set multi-res pipeline");
+  }
+
   frame_avail = 1;
   got_data = 0;
 
@@ -595,6 +608,8 @@ int main(int argc, char **argv) {
     }
     vpx_usec_timer_mark(&timer);
     cx_time += vpx_usec_timer_elapsed(&timer);
+    if (vpx_usec_timer_elapsed(&timer) > max_frame_time)
+      max_frame_time = vpx_usec_timer_elapsed(&timer);
 
     for (i = NUM_ENCODERS - 1; i >= 0; i--) {
       got_data = 0;
@@ -630,6 +645,8 @@ int main(int argc, char **argv) {
   printf("Frame cnt and encoding time/FPS stats for encoding: %d %f %f \n",
          frame_cnt, 1000 * (float)cx_time / (double)(frame_cnt * 1000000),
          1000000 * (double)frame_cnt / (double)cx_time);
+  printf("Maximum encoding time per frame (ms): %f\n",
+         (double)max_frame_time / 1000);
 
   fclose(infile);
 
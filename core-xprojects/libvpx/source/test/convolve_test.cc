@@ -615,6 +615,44 @@ TEST_P(ConvolveTest, DISABLED_Scale_Speed) {
          UUT_->use_highbd_ ? UUT_->use_highbd_ : 8, elapsed_time);
 }
 
+// Times the scaled functions the way reference scaling uses them: a 2:1
+// reference (step 32) and a 3:2 one (step 24), in each direction.
+TEST_P(ConvolveTest, DISABLED_Scaled_Ref_Speed) {
+  const uint8_t *const in = input();
+  uint8_t *const out = output();
+  const InterpKernel *const eighttap = vp9_filter_kernels[EIGHTTAP];
+  const int kNumTests = 1000000;
+  const int width = Width();
+  const int height = Height();
+  static const char *const kNames[3] = { "horiz", "vert", "2d" };
+  const ConvolveFunc *const funcs[3] = { UUT_->sh8_, UUT_->sv8_,
+                                         UUT_->shv8_ };
+
+  SetConstantInput(127);
+
+  for (int step = 24; step <= 32; step += 8) {
+    for (int dir = 0; dir < 3; ++dir) {
+      const int x_step_q4 = (dir == 1) ? 16 : step;
+      const int y_step_q4 = (dir == 0) ? 16 : step;
+      for (int i = 0; i < 2; ++i) {
+        vpx_usec_timer timer;
+        vpx_usec_timer_start(&timer);
+        for (int n = 0; n < kNumTests; ++n) {
+          funcs[dir][i](in, kInputStride, out, kOutputStride, eighttap, 5,
+                        x_step_q4, 5, y_step_q4, width, height);
+        }
+        vpx_usec_timer_mark(&timer);
+
+        const int elapsed_time =
+            static_cast<int>(vpx_usec_timer_elapsed(&timer));
+        printf("convolve_scaled_%s%s_step%d_%dx%d_%d: %d us\n",
+               i ? "avg_" : "", kNames[dir], step, width, height,
+               UUT_->use_highbd_ ? UUT_->use_highbd_ : 8, elapsed_time);
+      }
+    }
+  }
+}
+
 TEST_P(ConvolveTest, DISABLED_8Tap_Speed) {
   const uint8_t *const in = input();
   uint8_t *const out = output();
@@ -1076,43 +1114,107 @@ TEST_P(ConvolveTest, FilterExtremes) {
 
 /* This test exercises that enough rows and columns are filtered with every
    possible initial fractional positions and scaling steps. */
-#if !CONFIG_VP9_HIGHBITDEPTH
-static const ConvolveFunc scaled_2d_c_funcs[2] = { vpx_scaled_2d_c,
-                                                   vpx_scaled_avg_2d_c };
+typedef void (*ScaledRefFunc)(const uint8_t *src, ptrdiff_t src_stride,
+                              uint8_t *dst, ptrdiff_t dst_stride,
+                              const InterpKernel *filter, int x0_q4,
+                              int x_step_q4, int y0_q4, int y_step_q4, int w,
+                              int h, int bd);
+
+#if CONFIG_VP9_HIGHBITDEPTH
+#define SCALED_REF(func)                                                      \
+  void ref_##func(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst,     \
+                  ptrdiff_t dst_stride, const InterpKernel *filter,           \
+                  int x0_q4, int x_step_q4, int y0_q4, int y_step_q4, int w,  \
+                  int h, int bd) {                                            \
+    vpx_highbd_##func##_c(CAST_TO_SHORTPTR(src), src_stride,                  \
+                          CAST_TO_SHORTPTR(dst), dst_stride, filter, x0_q4,   \
+                          x_step_q4, y0_q4, y_step_q4, w, h, bd);             \
+  }
+#else
+#define SCALED_REF(func)                                                     \
+  void ref_##func(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst,    \
+                  ptrdiff_t dst_stride, const InterpKernel *filter,          \
+                  int x0_q4, int x_step_q4, int y0_q4, int y_step_q4, int w, \
+                  int h, int bd) {                                           \
+    (void)bd;                                                                \
+    vpx_##func##_c(src, src_stride, dst, dst_stride, filter, x0_q4,          \
+                   x_step_q4, y0_q4, y_step_q4, w, h);                       \
+  }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+SCALED_REF(scaled_horiz)
+SCALED_REF(scaled_avg_horiz)
+SCALED_REF(scaled_vert)
+SCALED_REF(scaled_avg_vert)
+SCALED_REF(scaled_2d)
+SCALED_REF(scaled_avg_2d)
+#undef SCALED_REF
+
+static const ScaledRefFunc scaled_ref_funcs[3][2] = {
+  { ref_scaled_horiz, ref_scaled_avg_horiz },
+  { ref_scaled_vert, ref_scaled_avg_vert },
+  { ref_scaled_2d, ref_scaled_avg_2d }
+};
 
 TEST_P(ConvolveTest, CheckScalingFiltering) {
   uint8_t *const in = input();
   uint8_t *const out = output();
+#if CONFIG_VP9_HIGHBITDEPTH
+  uint16_t ref16[kOutputStride * kMaxDimension];
+  uint8_t *const ref = UUT_->use_highbd_
+                           ? CAST_TO_BYTEPTR(ref16)
+                           : reinterpret_cast<uint8_t *>(ref16);
+#else
   uint8_t ref[kOutputStride * kMaxDimension];
+#endif
+  const ConvolveFunc *const funcs[3] = { UUT_->sh8_, UUT_->sv8_,
+                                         UUT_->shv8_ };
+  static const char *const kNames[3] = { "horiz", "vert", "2d" };
 
   ::libvpx_test::ACMRandom prng;
   for (int y = 0; y < Height(); ++y) {
     for (int x = 0; x < Width(); ++x) {
+#if CONFIG_VP9_HIGHBITDEPTH
+      const uint16_t r =
+          UUT_->use_highbd_ > 8 ? prng.Rand16() & mask_ : prng.Rand8Extremes();
+#else
       const uint16_t r = prng.Rand8Extremes();
+#endif
       assign_val(in, y * kInputStride + x, r);
     }
   }
 
-  for (int i = 0; i < 2; ++i) {
-    for (INTERP_FILTER filter_type = 0; filter_type < 4; ++filter_type) {
-      const InterpKernel *const eighttap = vp9_filter_kernels[filter_type];
-      for (int frac = 0; frac < 16; ++frac) {
-        for (int step = 1; step <= 32; ++step) {
-          /* Test the horizontal and vertical filters in combination. */
-          scaled_2d_c_funcs[i](in, kInputStride, ref, kOutputStride, eighttap,
-                               frac, step, frac, step, Width(), Height());
-          ASM_REGISTER_STATE_CHECK(
-              UUT_->shv8_[i](in, kInputStride, out, kOutputStride, eighttap,
-                             frac, step, frac, step, Width(), Height()));
-
-          CheckGuardBlocks();
+  // The first call of each direction is a plain one, which leaves ref and out
+  // equal before they are averaged into.
+  for (int dir = 0; dir < 3; ++dir) {
+    for (int i = 0; i < 2; ++i) {
+      for (INTERP_FILTER filter_type = 0; filter_type < 4; ++filter_type) {
+        const InterpKernel *const eighttap = vp9_filter_kernels[filter_type];
+        for (int frac = 0; frac < 16; ++frac) {
+          for (int step = 1; step <= 32; ++step) {
+            const int x0_q4 = (dir == 1) ? 0 : frac;
+            const int x_step_q4 = (dir == 1) ? 16 : step;
+            const int y0_q4 = (dir == 0) ? 0 : frac;
+            const int y_step_q4 = (dir == 0) ? 16 : step;
+
+            scaled_ref_funcs[dir][i](in, kInputStride, ref, kOutputStride,
+                                     eighttap, x0_q4, x_step_q4, y0_q4,
+                                     y_step_q4, Width(), Height(),
+                                     UUT_->use_highbd_);
+            ASM_REGISTER_STATE_CHECK(funcs[dir][i](
+                in, kInputStride, out, kOutputStride, eighttap, x0_q4,
+                x_step_q4, y0_q4, y_step_q4, Width(), Height()));
+
+            CheckGuardBlocks();
 
-          for (int y = 0; y < Height(); ++y) {
-            for (int x = 0; x < Width(); ++x) {
-              ASSERT_EQ(lookup(ref, y * kOutputStride + x),
-                        lookup(out, y * kOutputStride + x))
-                  << "x == " << x << ", y == " << y << ", frac == " << frac
-                  << ", step == " << step;
+            for (int y = 0; y < Height(); ++y) {
+              for (int x = 0; x < Width(); ++x) {
+                ASSERT_EQ(lookup(ref, y * kOutputStride + x),
+                          lookup(out, y * kOutputStride + x))
+                    << "x == " << x << ", y == " << y << ", frac == " << frac
+                    << ", step == " << step << ", " << (i ? "avg_" : "")
+                    << kNames[dir];
+              }
             }
           }
         }
@@ -1120,7 +1222,6 @@ TEST_P(ConvolveTest, CheckScalingFiltering) {
     }
   }
 }
-#endif
 
 using std::make_tuple;
 
@@ -1169,6 +1270,12 @@ WRAP(convolve8_horiz_avx2, 8)
 WRAP(convolve8_avg_horiz_avx2, 8)
 WRAP(convolve8_vert_avx2, 8)
 WRAP(convolve8_avg_vert_avx2, 8)
+WRAP(scaled_horiz_avx2, 8)
+WRAP(scaled_avg_horiz_avx2, 8)
+WRAP(scaled_vert_avx2, 8)
+WRAP(scaled_avg_vert_avx2, 8)
+WRAP(scaled_2d_avx2, 8)
+WRAP(scaled_avg_2d_avx2, 8)
 WRAP(convolve8_avx2, 8)
 WRAP(convolve8_avg_avx2, 8)
 
@@ -1180,6 +1287,12 @@ WRAP(convolve8_vert_avx2, 10)
 WRAP(convolve8_avg_avx2, 10)
 WRAP(convolve8_avg_horiz_avx2, 10)
 WRAP(convolve8_avg_vert_avx2, 10)
+WRAP(scaled_horiz_avx2, 10)
+WRAP(scaled_avg_horiz_avx2, 10)
+WRAP(scaled_vert_avx2, 10)
+WRAP(scaled_avg_vert_avx2, 10)
+WRAP(scaled_2d_avx2, 10)
+WRAP(scaled_avg_2d_avx2, 10)
 
 WRAP(convolve_copy_avx2, 12)
 WRAP(convolve_avg_avx2, 12)
@@ -1189,6 +1302,12 @@ WRAP(convolve8_vert_avx2, 12)
 WRAP(convolve8_avg_avx2, 12)
 WRAP(convolve8_avg_horiz_avx2, 12)
 WRAP(convolve8_avg_vert_avx2, 12)
+WRAP(scaled_horiz_avx2, 12)
+WRAP(scaled_avg_horiz_avx2, 12)
+WRAP(scaled_vert_avx2, 12)
+WRAP(scaled_avg_vert_avx2, 12)
+WRAP(scaled_2d_avx2, 12)
+WRAP(scaled_avg_2d_avx2, 12)
 #endif  // HAVE_AVX2
 
 #if HAVE_NEON
@@ -1226,6 +1345,12 @@ WRAP(convolve8_vert_c, 8)
 WRAP(convolve8_avg_vert_c, 8)
 WRAP(convolve8_c, 8)
 WRAP(convolve8_avg_c, 8)
+WRAP(scaled_horiz_c, 8)
+WRAP(scaled_avg_horiz_c, 8)
+WRAP(scaled_vert_c, 8)
+WRAP(scaled_avg_vert_c, 8)
+WRAP(scaled_2d_c, 8)
+WRAP(scaled_avg_2d_c, 8)
 WRAP(convolve_copy_c, 10)
 WRAP(convolve_avg_c, 10)
 WRAP(convolve8_horiz_c, 10)
@@ -1234,6 +1359,12 @@ WRAP(convolve8_vert_c, 10)
 WRAP(convolve8_avg_vert_c, 10)
 WRAP(convolve8_c, 10)
 WRAP(convolve8_avg_c, 10)
+WRAP(scaled_horiz_c, 10)
+WRAP(scaled_avg_horiz_c, 10)
+WRAP(scaled_vert_c, 10)
+WRAP(scaled_avg_vert_c, 10)
+WRAP(scaled_2d_c, 10)
+WRAP(scaled_avg_2d_c, 10)
 WRAP(convolve_copy_c, 12)
 WRAP(convolve_avg_c, 12)
 WRAP(convolve8_horiz_c, 12)
@@ -1242,29 +1373,34 @@ WRAP(convolve8_vert_c, 12)
 WRAP(convolve8_avg_vert_c, 12)
 WRAP(convolve8_c, 12)
 WRAP(convolve8_avg_c, 12)
+WRAP(scaled_horiz_c, 12)
+WRAP(scaled_avg_horiz_c, 12)
+WRAP(scaled_vert_c, 12)
+WRAP(scaled_avg_vert_c, 12)
+WRAP(scaled_2d_c, 12)
+WRAP(scaled_avg_2d_c, 12)
 #undef WRAP
 
 const ConvolveFunctions convolve8_c(
     wrap_convolve_copy_c_8, wrap_convolve_avg_c_8, wrap_convolve8_horiz_c_8,
     wrap_convolve8_avg_horiz_c_8, wrap_convolve8_vert_c_8,
     wrap_convolve8_avg_vert_c_8, wrap_convolve8_c_8, wrap_convolve8_avg_c_8,
-    wrap_convolve8_horiz_c_8, wrap_convolve8_avg_horiz_c_8,
-    wrap_convolve8_vert_c_8, wrap_convolve8_avg_vert_c_8, wrap_convolve8_c_8,
-    wrap_convolve8_avg_c_8, 8);
+    wrap_scaled_horiz_c_8, wrap_scaled_avg_horiz_c_8, wrap_scaled_vert_c_8,
+    wrap_scaled_avg_vert_c_8, wrap_scaled_2d_c_8, wrap_scaled_avg_2d_c_8, 8);
 const ConvolveFunctions convolve10_c(
     wrap_convolve_copy_c_10, wrap_convolve_avg_c_10, wrap_convolve8_horiz_c_10,
     wrap_convolve8_avg_horiz_c_10, wrap_convolve8_vert_c_10,
     wrap_convolve8_avg_vert_c_10, wrap_convolve8_c_10, wrap_convolve8_avg_c_10,
-    wrap_convolve8_horiz_c_10, wrap_convolve8_avg_horiz_c_10,
-    wrap_convolve8_vert_c_10, wrap_convolve8_avg_vert_c_10, wrap_convolve8_c_10,
-    wrap_convolve8_avg_c_10, 10);
+    wrap_scaled_horiz_c_10, wrap_scaled_avg_horiz_c_10, wrap_scaled_vert_c_10,
+    wrap_scaled_avg_vert_c_10, wrap_scaled_2d_c_10, wrap_scaled_avg_2d_c_10,
+    10);
 const ConvolveFunctions convolve12_c(
     wrap_convolve_copy_c_12, wrap_convolve_avg_c_12, wrap_convolve8_horiz_c_12,
     wrap_convolve8_avg_horiz_c_12, wrap_convolve8_vert_c_12,
     wrap_convolve8_avg_vert_c_12, wrap_convolve8_c_12, wrap_convolve8_avg_c_12,
-    wrap_convolve8_horiz_c_12, wrap_convolve8_avg_horiz_c_12,
-    wrap_convolve8_vert_c_12, wrap_convolve8_avg_vert_c_12, wrap_convolve8_c_12,
-    wrap_convolve8_avg_c_12, 12);
+    wrap_scaled_horiz_c_12, wrap_scaled_avg_horiz_c_12, wrap_scaled_vert_c_12,
+    wrap_scaled_avg_vert_c_12, wrap_scaled_2d_c_12, wrap_scaled_avg_2d_c_12,
+    12);
 const ConvolveParam kArrayConvolve_c[] = { ALL_SIZES(convolve8_c),
                                            ALL_SIZES(convolve10_c),
                                            ALL_SIZES(convolve12_c) };
@@ -1329,8 +1465,8 @@ const ConvolveFunctions convolve8_ssse3(
     vpx_convolve_copy_c, vpx_convolve_avg_c, vpx_convolve8_horiz_ssse3,
     vpx_convolve8_avg_horiz_ssse3, vpx_convolve8_vert_ssse3,
     vpx_convolve8_avg_vert_ssse3, vpx_convolve8_ssse3, vpx_convolve8_avg_ssse3,
-    vpx_scaled_horiz_c, vpx_scaled_avg_horiz_c, vpx_scaled_vert_c,
-    vpx_scaled_avg_vert_c, vpx_scaled_2d_ssse3, vpx_scaled_avg_2d_c, 0);
+    vpx_scaled_horiz_ssse3, vpx_scaled_avg_horiz_ssse3, vpx_scaled_vert_ssse3,
+    vpx_scaled_avg_vert_ssse3, vpx_scaled_2d_ssse3, vpx_scaled_avg_2d_ssse3, 0);
 
 const ConvolveParam kArrayConvolve8_ssse3[] = { ALL_SIZES(convolve8_ssse3) };
 INSTANTIATE_TEST_SUITE_P(SSSE3, ConvolveTest,
@@ -1343,25 +1479,26 @@ const ConvolveFunctions convolve8_avx2(
     wrap_convolve_copy_avx2_8, wrap_convolve_avg_avx2_8,
     wrap_convolve8_horiz_avx2_8, wrap_convolve8_avg_horiz_avx2_8,
     wrap_convolve8_vert_avx2_8, wrap_convolve8_avg_vert_avx2_8,
-    wrap_convolve8_avx2_8, wrap_convolve8_avg_avx2_8, wrap_convolve8_horiz_c_8,
-    wrap_convolve8_avg_horiz_c_8, wrap_convolve8_vert_c_8,
-    wrap_convolve8_avg_vert_c_8, wrap_convolve8_c_8, wrap_convolve8_avg_c_8, 8);
+    wrap_convolve8_avx2_8, wrap_convolve8_avg_avx2_8, wrap_scaled_horiz_avx2_8,
+    wrap_scaled_avg_horiz_avx2_8, wrap_scaled_vert_avx2_8,
+    wrap_scaled_avg_vert_avx2_8, wrap_scaled_2d_avx2_8,
+    wrap_scaled_avg_2d_avx2_8, 8);
 const ConvolveFunctions convolve10_avx2(
     wrap_convolve_copy_avx2_10, wrap_convolve_avg_avx2_10,
     wrap_convolve8_horiz_avx2_10, wrap_convolve8_avg_horiz_avx2_10,
     wrap_convolve8_vert_avx2_10, wrap_convolve8_avg_vert_avx2_10,
     wrap_convolve8_avx2_10, wrap_convolve8_avg_avx2_10,
-    wrap_convolve8_horiz_c_10, wrap_convolve8_avg_horiz_c_10,
-    wrap_convolve8_vert_c_10, wrap_convolve8_avg_vert_c_10, wrap_convolve8_c_10,
-    wrap_convolve8_avg_c_10, 10);
+    wrap_scaled_horiz_avx2_10, wrap_scaled_avg_horiz_avx2_10,
+    wrap_scaled_vert_avx2_10, wrap_scaled_avg_vert_avx2_10,
+    wrap_scaled_2d_avx2_10, wrap_scaled_avg_2d_avx2_10, 10);
 const ConvolveFunctions convolve12_avx2(
     wrap_convolve_copy_avx2_12, wrap_convolve_avg_avx2_12,
     wrap_convolve8_horiz_avx2_12, wrap_convolve8_avg_horiz_avx2_12,
     wrap_convolve8_vert_avx2_12, wrap_convolve8_avg_vert_avx2_12,
     wrap_convolve8_avx2_12, wrap_convolve8_avg_avx2_12,
-    wrap_convolve8_horiz_c_12, wrap_convolve8_avg_horiz_c_12,
-    wrap_convolve8_vert_c_12, wrap_convolve8_avg_vert_c_12, wrap_convolve8_c_12,
-    wrap_convolve8_avg_c_12, 12);
+    wrap_scaled_horiz_avx2_12, wrap_scaled_avg_horiz_avx2_12,
+    wrap_scaled_vert_avx2_12, wrap_scaled_avg_vert_avx2_12,
+    wrap_scaled_2d_avx2_12, wrap_scaled_avg_2d_avx2_12, 12);
 const ConvolveParam kArrayConvolve8_avx2[] = { ALL_SIZES(convolve8_avx2),
                                                ALL_SIZES(convolve10_avx2),
                                                ALL_SIZES(convolve12_avx2) };
@@ -1372,8 +1509,8 @@ const ConvolveFunctions convolve8_avx2(
     vpx_convolve_copy_c, vpx_convolve_avg_c, vpx_convolve8_horiz_avx2,
     vpx_convolve8_avg_horiz_avx2, vpx_convolve8_vert_avx2,
     vpx_convolve8_avg_vert_avx2, vpx_convolve8_avx2, vpx_convolve8_avg_avx2,
-    vpx_scaled_horiz_c, vpx_scaled_avg_horiz_c, vpx_scaled_vert_c,
-    vpx_scaled_avg_vert_c, vpx_scaled_2d_c, vpx_scaled_avg_2d_c, 0);
+    vpx_scaled_horiz_avx2, vpx_scaled_avg_horiz_avx2, vpx_scaled_vert_avx2,
+    vpx_scaled_avg_vert_avx2, vpx_scaled_2d_avx2, vpx_scaled_avg_2d_avx2, 0);
 const ConvolveParam kArrayConvolve8_avx2[] = { ALL_SIZES(convolve8_avx2) };
 INSTANTIATE_TEST_SUITE_P(AVX2, ConvolveTest,
                          ::testing::ValuesIn(kArrayConvolve8_avx2));
@@ -26,6 +26,7 @@
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_integer.h"
 #include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
 
 using libvpx_test::ACMRandom;
 using libvpx_test::Buffer;
@@ -605,6 +606,27 @@ TEST_P(TransHT, MemCheck) { RunMemCheck(); }
 
 TEST_P(TransHT, InvAccuracyCheck) { RunInvAccuracyCheck(1); }
 
+TEST_P(TransHT, DISABLED_Speed) {
+  if (pixel_size_ == 1 && bit_depth_ > VPX_BITS_8) return;
+  const int count_test_block = 200000;
+  Buffer<int16_t> input_block =
+      Buffer<int16_t>(size_, size_, 8, size_ == 4 ? 0 : 16);
+  ASSERT_TRUE(input_block.Init());
+  Buffer<tran_low_t> output_block = Buffer<tran_low_t>(size_, size_, 0, 16);
+  ASSERT_TRUE(output_block.Init());
+  input_block.Set(&rnd_, -max_pixel_value_, max_pixel_value_);
+
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < count_test_block; ++i) {
+    RunFwdTxfm(input_block, &output_block);
+  }
+  vpx_usec_timer_mark(&timer);
+  const int elapsed_time = static_cast<int>(vpx_usec_timer_elapsed(&timer));
+  printf("%dx%d tx_type: %d bd: %d time: %5d us\n", size_, size_, tx_type_,
+         bit_depth_, elapsed_time);
+}
+
 static const FuncInfo ht_c_func_info[] = {
 #if CONFIG_VP9_HIGHBITDEPTH
   { &vp9_highbd_fht4x4_c, &highbd_iht_wrapper<vp9_highbd_iht4x4_16_add_c>, 4,
@@ -688,6 +710,28 @@ INSTANTIATE_TEST_SUITE_P(
                                          VPX_BITS_12)));
 #endif  // HAVE_SSE4_1 && CONFIG_VP9_HIGHBITDEPTH
 
+#if HAVE_AVX2
+static const FuncInfo ht_avx2_func_info[] = {
+#if CONFIG_VP9_HIGHBITDEPTH
+  { &vp9_highbd_fht4x4_avx2, &highbd_iht_wrapper<vp9_highbd_iht4x4_16_add_c>,
+    4, 2 },
+  { &vp9_highbd_fht8x8_avx2, &highbd_iht_wrapper<vp9_highbd_iht8x8_64_add_c>,
+    8, 2 },
+  { &vp9_highbd_fht16x16_avx2,
+    &highbd_iht_wrapper<vp9_highbd_iht16x16_256_add_c>, 16, 2 },
+#endif
+  { &vp9_fht16x16_avx2, &iht_wrapper<vp9_iht16x16_256_add_sse2>, 16, 1 }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, TransHT,
+    ::testing::Combine(
+        ::testing::Range(0, static_cast<int>(sizeof(ht_avx2_func_info) /
+                                             sizeof(ht_avx2_func_info[0]))),
+        ::testing::Values(ht_avx2_func_info), ::testing::Range(0, 4),
+        ::testing::Values(VPX_BITS_8, VPX_BITS_10, VPX_BITS_12)));
+#endif  // HAVE_AVX2
+
 #if HAVE_VSX && !CONFIG_EMULATE_HARDWARE && !CONFIG_VP9_HIGHBITDEPTH
 static const FuncInfo ht_vsx_func_info[3] = {
   { &vp9_fht4x4_c, &iht_wrapper<vp9_iht4x4_16_add_vsx>, 4, 1 },
@@ -50,6 +50,7 @@ const EncodePerfTestVideo kVP9EncodePerfTestVectors[] = {
 
 const int kEncodePerfTestSpeeds[] = { 5, 6, 7, 8, 9 };
 const int kEncodePerfTestThreads[] = { 1, 2, 4 };
+const int kEncodePerfTestPyramidMe[] = { 0, 1 };
 
 #define NELEMENTS(x) (sizeof((x)) / sizeof((x)[0]))
 
@@ -59,7 +60,8 @@ class VP9EncodePerfTest
  protected:
   VP9EncodePerfTest()
       : EncoderTest(GET_PARAM(0)), min_psnr_(kMaxPsnr), nframes_(0),
-        encoding_mode_(GET_PARAM(1)), speed_(0), threads_(1) {}
+        encoding_mode_(GET_PARAM(1)), speed_(0), threads_(1),
+        pyramid_me_(0) {}
 
   virtual ~VP9EncodePerfTest() {}
 
@@ -90,6 +92,7 @@ class VP9EncodePerfTest
       encoder->Control(VP9E_SET_TILE_COLUMNS, log2_tile_columns);
       encoder->Control(VP9E_SET_FRAME_PARALLEL_DECODING, 1);
       encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 0);
+      encoder->Control(VP9E_SET_PYRAMID_ME, pyramid_me_);
     }
   }
 
@@ -113,12 +116,15 @@ class VP9EncodePerfTest
 
   void set_threads(unsigned int threads) { threads_ = threads; }
 
+  void set_pyramid_me(int pyramid_me) { pyramid_me_ = pyramid_me; }
+
  private:
   double min_psnr_;
   unsigned int nframes_;
   libvpx_test::TestMode encoding_mode_;
   unsigned speed_;
   unsigned int threads_;
+  int pyramid_me_;
 };
 
 TEST_P(VP9EncodePerfTest, PerfTest) {
@@ -133,51 +139,56 @@ TEST_P(VP9EncodePerfTest, PerfTest) {
           continue;
         }
 
-        set_threads(kEncodePerfTestThreads[k]);
-        SetUp();
-
-        const vpx_rational timebase = { 33333333, 1000000000 };
-        cfg_.g_timebase = timebase;
-        cfg_.rc_target_bitrate = kVP9EncodePerfTestVectors[i].bitrate;
-
-        init_flags_ = VPX_CODEC_USE_PSNR;
-
-        const unsigned frames = kVP9EncodePerfTestVectors[i].frames;
-        const char *video_name = kVP9EncodePerfTestVectors[i].name;
-        libvpx_test::I420VideoSource video(
-            video_name, kVP9EncodePerfTestVectors[i].width,
-            kVP9EncodePerfTestVectors[i].height, timebase.den, timebase.num, 0,
-            kVP9EncodePerfTestVectors[i].frames);
-        set_speed(kEncodePerfTestSpeeds[j]);
-
-        vpx_usec_timer t;
-        vpx_usec_timer_start(&t);
-
-        ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
-
-        vpx_usec_timer_mark(&t);
-        const double elapsed_secs = vpx_usec_timer_elapsed(&t) / kUsecsInSec;
-        const double fps = frames / elapsed_secs;
-        const double minimum_psnr = min_psnr();
-        std::string display_name(video_name);
-        if (kEncodePerfTestThreads[k] > 1) {
-          char thread_count[32];
-          snprintf(thread_count, sizeof(thread_count), "_t-%d",
-                   kEncodePerfTestThreads[k]);
-          display_name += thread_count;
+        for (size_t m = 0; m < NELEMENTS(kEncodePerfTestPyramidMe); ++m) {
+          set_threads(kEncodePerfTestThreads[k]);
+          SetUp();
+
+          const vpx_rational timebase = { 33333333, 1000000000 };
+          cfg_.g_timebase = timebase;
+          cfg_.rc_target_bitrate = kVP9EncodePerfTestVectors[i].bitrate;
+
+          init_flags_ = VPX_CODEC_USE_PSNR;
+
+          const unsigned frames = kVP9EncodePerfTestVectors[i].frames;
+          const char *video_name = kVP9EncodePerfTestVectors[i].name;
+          libvpx_test::I420VideoSource video(
+              video_name, kVP9EncodePerfTestVectors[i].width,
+              kVP9EncodePerfTestVectors[i].height, timebase.den, timebase.num,
+              0, kVP9EncodePerfTestVectors[i].frames);
+          set_speed(kEncodePerfTestSpeeds[j]);
+          set_pyramid_me(kEncodePerfTestPyramidMe[m]);
+
+          vpx_usec_timer t;
+          vpx_usec_timer_start(&t);
+
+          ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+
+          vpx_usec_timer_mark(&t);
+          const double elapsed_secs = vpx_usec_timer_elapsed(&t) / kUsecsInSec;
+          const double fps = frames / elapsed_secs;
+          const double minimum_psnr = min_psnr();
+          std::string display_name(video_name);
+          if (kEncodePerfTestThreads[k] > 1) {
+            char thread_count[32];
+            snprintf(thread_count, sizeof(thread_count), "_t-%d",
+                     kEncodePerfTestThreads[k]);
+            display_name += thread_count;
+          }
+          if (kEncodePerfTestPyramidMe[m]) display_name += "_pyramid-me";
+
+          printf("{\n");
+          printf("\t\"type\" : \"encode_perf_test\",\n");
+          printf("\t\"version\" : \"%s\",\n", VERSION_STRING_NOSP);
+          printf("\t\"videoName\" : \"%s\",\n", display_name.c_str());
+          printf("\t\"encodeTimeSecs\" : %f,\n", elapsed_secs);
+          printf("\t\"totalFrames\" : %u,\n", frames);
+          printf("\t\"framesPerSecond\" : %f,\n", fps);
+          printf("\t\"minPsnr\" : %f,\n", minimum_psnr);
+          printf("\t\"speed\" : %d,\n", kEncodePerfTestSpeeds[j]);
+          printf("\t\"threads\" : %d,\n", kEncodePerfTestThreads[k]);
+          printf("\t\"pyramidMe\" : %d\n", kEncodePerfTestPyramidMe[m]);
+          printf("}\n");
         }
-
-        printf("{\n");
-        printf("\t\"type\" : \"encode_perf_test\",\n");
-        printf("\t\"version\" : \"%s\",\n", VERSION_STRING_NOSP);
-        printf("\t\"videoName\" : \"%s\",\n", display_name.c_str());
-        printf("\t\"encodeTimeSecs\" : %f,\n", elapsed_secs);
-        printf("\t\"totalFrames\" : %u,\n", frames);
-        printf("\t\"framesPerSecond\" : %f,\n", fps);
-        printf("\t\"minPsnr\" : %f,\n", minimum_psnr);
-        printf("\t\"speed\" : %d,\n", kEncodePerfTestSpeeds[j]);
-        printf("\t\"threads\" : %d\n", kEncodePerfTestThreads[k]);
-        printf("}\n");
       }
     }
   }
@@ -0,0 +1,355 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/md5_helper.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+#include "vpx/vpx_frame_buffer_pool.h"
+
+namespace {
+
+const int kWidth = 176;
+const int kHeight = 144;
+const int kNumFrames = 10;
+
+// Encodes |kNumFrames| frames of a moving gradient and returns the
+// compressed frames.
+std::vector<std::string> EncodeFrames(vpx_codec_iface_t *iface) {
+  std::vector<std::string> frames;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  vpx_image_t img;
+
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_enc_config_default(iface, &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_enc_init(&enc, iface, &cfg, 0));
+  EXPECT_NE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 1),
+            nullptr);
+
+  for (int i = 0; i <= kNumFrames; ++i) {
+    const vpx_image_t *const raw = i < kNumFrames ? &img : nullptr;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane ? (kWidth + 1) >> 1 : kWidth;
+      const int h = plane ? (kHeight + 1) >> 1 : kHeight;
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          img.planes[plane][y * img.stride[plane] + x] =
+              static_cast<uint8_t>(x + 2 * y + 4 * i + 64 * plane);
+        }
+      }
+    }
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_encode(&enc, raw, i, 1, 0, VPX_DL_REALTIME));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      frames.push_back(std::string(
+          static_cast<const char *>(pkt->data.frame.buf), pkt->data.frame.sz));
+    }
+  }
+
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  return frames;
+}
+
+#if defined(__linux__)
+// Maps an exported frame the way a consumer process would and returns the
+// MD5 of its visible area.
+std::string MapAndHash(const vpx_shared_frame_t &frame) {
+  void *const base = mmap(nullptr, frame.size, PROT_READ, MAP_SHARED, frame.fd,
+                          0);
+  if (base == MAP_FAILED) return std::string();
+
+  vpx_image_t img;
+  memset(&img, 0, sizeof(img));
+  img.fmt = frame.fmt;
+  img.d_w = frame.d_w;
+  img.d_h = frame.d_h;
+  img.x_chroma_shift = frame.x_chroma_shift;
+  img.y_chroma_shift = frame.y_chroma_shift;
+  for (int plane = 0; plane < 3; ++plane) {
+    img.planes[plane] = static_cast<uint8_t *>(base) + frame.offset[plane];
+    img.stride[plane] = frame.stride[plane];
+  }
+  libvpx_test::MD5 md5;
+  md5.Add(&img);
+  const std::string digest = md5.Get();
+  munmap(base, frame.size);
+  return digest;
+}
+
+std::string ImageHash(const vpx_image_t *img) {
+  libvpx_test::MD5 md5;
+  md5.Add(img);
+  return md5.Get();
+}
+
+// Sends |frame| and its fd over |sock|.
+bool SendFrame(int sock, const vpx_shared_frame_t &frame) {
+  struct msghdr msg;
+  struct iovec iov;
+  char control[CMSG_SPACE(sizeof(int))];
+  memset(&msg, 0, sizeof(msg));
+  memset(control, 0, sizeof(control));
+  iov.iov_base = const_cast<vpx_shared_frame_t *>(&frame);
+  iov.iov_len = sizeof(frame);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr *const cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cmsg), &frame.fd, sizeof(int));
+  return sendmsg(sock, &msg, 0) == static_cast<ssize_t>(sizeof(frame));
+}
+
+// Receives a frame sent by SendFrame(). The fd is replaced by the one
+// installed in this process.
+bool ReceiveFrame(int sock, vpx_shared_frame_t *frame) {
+  struct msghdr msg;
+  struct iovec iov;
+  char control[CMSG_SPACE(sizeof(int))];
+  memset(&msg, 0, sizeof(msg));
+  iov.iov_base = frame;
+  iov.iov_len = sizeof(*frame);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  if (recvmsg(sock, &msg, 0) != static_cast<ssize_t>(sizeof(*frame))) {
+    return false;
+  }
+  struct cmsghdr *const cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS) return false;
+  memcpy(&frame->fd, CMSG_DATA(cmsg), sizeof(int));
+  return true;
+}
+
+// Consumer process: maps every frame it receives and replies with its MD5
+// and the frame id, so the producer can drop its reference.
+void RunConsumer(int sock) {
+  vpx_shared_frame_t frame;
+  while (ReceiveFrame(sock, &frame)) {
+    char reply[33 + sizeof(int)];
+    const std::string digest = MapAndHash(frame);
+    close(frame.fd);
+    memset(reply, 0, sizeof(reply));
+    memcpy(reply, digest.c_str(), digest.size());
+    memcpy(reply + 33, &frame.id, sizeof(int));
+    if (write(sock, reply, sizeof(reply)) != sizeof(reply)) break;
+  }
+  close(sock);
+  _exit(0);
+}
+#endif  // __linux__
+
+#if CONFIG_VP9_ENCODER && CONFIG_VP9_DECODER
+const int kVP9MinBuffers = VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS;
+
+TEST(FrameBufferPoolTest, VP9RecyclesBuffers) {
+  const std::vector<std::string> frames = EncodeFrames(vpx_codec_vp9_cx());
+  ASSERT_EQ(kNumFrames, static_cast<int>(frames.size()));
+
+  vpx_frame_buffer_pool_t *const pool =
+      vpx_frame_buffer_pool_create(kVP9MinBuffers);
+  ASSERT_NE(pool, nullptr);
+  vpx_codec_ctx_t dec;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, vpx_codec_vp9_dx(), nullptr, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_attach(pool, &dec));
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(
+                  &dec, reinterpret_cast<const uint8_t *>(frames[i].data()),
+                  static_cast<unsigned int>(frames[i].size()), nullptr, 0));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_image_t *const img = vpx_codec_get_frame(&dec, &iter);
+    ASSERT_NE(img, nullptr);
+    ASSERT_NE(img->fb_priv, nullptr);
+
+    vpx_shared_frame_t frame;
+    ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_export(pool, img, &frame));
+#if defined(__linux__)
+    ASSERT_GE(frame.fd, 0);
+    EXPECT_EQ(ImageHash(img), MapAndHash(frame));
+#endif
+    EXPECT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_unref(pool, frame.id));
+    EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+              vpx_frame_buffer_pool_unref(pool, frame.id));
+    EXPECT_LE(vpx_frame_buffer_pool_num_in_use(pool), kVP9MinBuffers);
+  }
+
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+  EXPECT_EQ(0, vpx_frame_buffer_pool_num_in_use(pool));
+  vpx_frame_buffer_pool_destroy(pool);
+}
+
+#if defined(__linux__)
+// An exported frame must survive the decoder releasing its buffer.
+TEST(FrameBufferPoolTest, VP9ExportOutlivesDecoderRef) {
+  const std::vector<std::string> frames = EncodeFrames(vpx_codec_vp9_cx());
+  ASSERT_EQ(kNumFrames, static_cast<int>(frames.size()));
+
+  vpx_frame_buffer_pool_t *const pool =
+      vpx_frame_buffer_pool_create(kVP9MinBuffers + 1);
+  ASSERT_NE(pool, nullptr);
+  vpx_codec_ctx_t dec;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, vpx_codec_vp9_dx(), nullptr, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_attach(pool, &dec));
+
+  vpx_shared_frame_t held;
+  std::string held_digest;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(
+                  &dec, reinterpret_cast<const uint8_t *>(frames[i].data()),
+                  static_cast<unsigned int>(frames[i].size()), nullptr, 0));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_image_t *const img = vpx_codec_get_frame(&dec, &iter);
+    ASSERT_NE(img, nullptr);
+    if (i == 0) {
+      ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_export(pool, img, &held));
+      held_digest = ImageHash(img);
+    }
+  }
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+
+  EXPECT_EQ(1, vpx_frame_buffer_pool_num_in_use(pool));
+  EXPECT_EQ(held_digest, MapAndHash(held));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_unref(pool, held.id));
+  EXPECT_EQ(0, vpx_frame_buffer_pool_num_in_use(pool));
+  vpx_frame_buffer_pool_destroy(pool);
+}
+
+// Decodes in this process and hands every frame to a forked consumer over a
+// unix socket. The consumer only receives fds and maps them; pixels are never
+// copied between the processes.
+TEST(FrameBufferPoolTest, VP9CrossProcessHandoff) {
+  const std::vector<std::string> frames = EncodeFrames(vpx_codec_vp9_cx());
+  ASSERT_EQ(kNumFrames, static_cast<int>(frames.size()));
+
+  int socks[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, socks));
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    close(socks[0]);
+    RunConsumer(socks[1]);
+  }
+  close(socks[1]);
+
+  vpx_frame_buffer_pool_t *const pool =
+      vpx_frame_buffer_pool_create(kVP9MinBuffers + 2);
+  ASSERT_NE(pool, nullptr);
+  vpx_codec_ctx_t dec;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, vpx_codec_vp9_dx(), nullptr, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_attach(pool, &dec));
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(
+                  &dec, reinterpret_cast<const uint8_t *>(frames[i].data()),
+                  static_cast<unsigned int>(frames[i].size()), nullptr, 0));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_image_t *const img = vpx_codec_get_frame(&dec, &iter);
+    ASSERT_NE(img, nullptr);
+
+    vpx_shared_frame_t frame;
+    ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_export(pool, img, &frame));
+    ASSERT_TRUE(SendFrame(socks[0], frame));
+
+    char reply[33 + sizeof(int)];
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(reply)),
+              read(socks[0], reply, sizeof(reply)));
+    int id;
+    memcpy(&id, reply + 33, sizeof(id));
+    EXPECT_EQ(ImageHash(img), std::string(reply)) << "frame " << i;
+    EXPECT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_unref(pool, id));
+  }
+
+  close(socks[0]);
+  int status;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+  EXPECT_EQ(0, vpx_frame_buffer_pool_num_in_use(pool));
+  vpx_frame_buffer_pool_destroy(pool);
+}
+#endif  // __linux__
+#endif  // CONFIG_VP9_ENCODER && CONFIG_VP9_DECODER
+
+#if CONFIG_VP8_ENCODER && CONFIG_VP8_DECODER
+// VP8 has no external frame buffer support; exporting copies the frame into
+// the pool once.
+TEST(FrameBufferPoolTest, VP8ExportCopies) {
+  const std::vector<std::string> frames = EncodeFrames(vpx_codec_vp8_cx());
+  ASSERT_EQ(kNumFrames, static_cast<int>(frames.size()));
+
+  vpx_frame_buffer_pool_t *const pool = vpx_frame_buffer_pool_create(2);
+  ASSERT_NE(pool, nullptr);
+  vpx_codec_ctx_t dec;
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_dec_init(&dec, vpx_codec_vp8_dx(), nullptr, 0));
+  EXPECT_EQ(VPX_CODEC_INCAPABLE, vpx_frame_buffer_pool_attach(pool, &dec));
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_decode(
+                  &dec, reinterpret_cast<const uint8_t *>(frames[i].data()),
+                  static_cast<unsigned int>(frames[i].size()), nullptr, 0));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_image_t *const img = vpx_codec_get_frame(&dec, &iter);
+    ASSERT_NE(img, nullptr);
+
+    vpx_shared_frame_t frame;
+    ASSERT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_export(pool, img, &frame));
+    EXPECT_EQ(1, vpx_frame_buffer_pool_num_in_use(pool));
+#if defined(__linux__)
+    EXPECT_EQ(ImageHash(img), MapAndHash(frame));
+#endif
+    EXPECT_EQ(VPX_CODEC_OK, vpx_frame_buffer_pool_unref(pool, frame.id));
+  }
+
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+  EXPECT_EQ(0, vpx_frame_buffer_pool_num_in_use(pool));
+  vpx_frame_buffer_pool_destroy(pool);
+}
+#endif  // CONFIG_VP8_ENCODER && CONFIG_VP8_DECODER
+
+}  // namespace
@@ -58,6 +58,9 @@ typedef void (*SadMxNx8Func)(const uint8_t *src_ptr, int src_stride,
 
 typedef TestParams<SadMxNx8Func> SadMxNx8Param;
 
+// Same signature as the x4d functions, with 8 references.
+typedef TestParams<SadMxNx4Func> SadMxNx8dParam;
+
 using libvpx_test::ACMRandom;
 
 namespace {
@@ -316,6 +319,50 @@ class SADx4Test : public SADTestBase<SadMxNx4Param> {
   }
 };
 
+class SADx8dTest : public SADTestBase<SadMxNx8dParam> {
+ public:
+  SADx8dTest() : SADTestBase(GetParam()) {}
+
+ protected:
+  // Pairs of overlapping references, as motion search candidates are.
+  int GetRefOffset(int ref_idx) const {
+    return GetBlockRefOffset(ref_idx >> 1) +
+           (ref_idx & 1) * (params_.width / 2 + 1);
+  }
+
+  void FillRefsRandom() {
+    for (int ref = 0; ref < 8; ++ref) {
+      FillRandom(GetReferenceFromOffset(GetRefOffset(ref)), reference_stride_);
+    }
+  }
+
+  void FillRefsConstant(uint16_t fill_constant) {
+    for (int ref = 0; ref < 8; ++ref) {
+      FillConstant(GetReferenceFromOffset(GetRefOffset(ref)), reference_stride_,
+                   fill_constant);
+    }
+  }
+
+  void SADs(unsigned int *results) const {
+    const uint8_t *references[8];
+    for (int ref = 0; ref < 8; ++ref) {
+      references[ref] = GetReferenceFromOffset(GetRefOffset(ref));
+    }
+
+    ASM_REGISTER_STATE_CHECK(params_.func(
+        source_data_, source_stride_, references, reference_stride_, results));
+  }
+
+  void CheckSADs() const {
+    DECLARE_ALIGNED(kDataAlignment, uint32_t, exp_sad[8]);
+
+    SADs(exp_sad);
+    for (int ref = 0; ref < 8; ++ref) {
+      EXPECT_EQ(ReferenceSAD(GetRefOffset(ref)), exp_sad[ref]) << "ref " << ref;
+    }
+  }
+};
+
 class SADTest : public AbstractBench, public SADTestBase<SadMxNParam> {
  public:
   SADTest() : SADTestBase(GetParam()) {}
@@ -343,7 +390,7 @@ class SADTest : public AbstractBench, public SADTestBase<SadMxNParam> {
   }
 };
 
-class SADavgTest : public SADTestBase<SadMxNAvgParam> {
+class SADavgTest : public AbstractBench, public SADTestBase<SadMxNAvgParam> {
  public:
   SADavgTest() : SADTestBase(GetParam()) {}
 
@@ -364,6 +411,11 @@ class SADavgTest : public SADTestBase<SadMxNAvgParam> {
 
     ASSERT_EQ(reference_sad, exp_sad);
   }
+
+  void Run() {
+    params_.func(source_data_, source_stride_, reference_data_,
+                 reference_stride_, second_pred_);
+  }
 };
 
 TEST_P(SADTest, MaxRef) {
@@ -463,6 +515,19 @@ TEST_P(SADavgTest, ShortSrc) {
   source_stride_ = tmp_stride;
 }
 
+TEST_P(SADavgTest, DISABLED_Speed) {
+  const int kCountSpeedTestBlock = 50000000 / (params_.width * params_.height);
+  FillRandom(source_data_, source_stride_);
+  FillRandom(reference_data_, reference_stride_);
+  FillRandom(second_pred_, params_.width);
+
+  RunNTimes(kCountSpeedTestBlock);
+
+  char title[16];
+  snprintf(title, sizeof(title), "%dx%d", params_.width, params_.height);
+  PrintMedian(title);
+}
+
 TEST_P(SADx4Test, MaxRef) {
   FillConstant(source_data_, source_stride_, 0);
   FillConstant(GetReference(0), reference_stride_, mask_);
@@ -564,6 +629,78 @@ TEST_P(SADx4Test, DISABLED_Speed) {
   reference_stride_ = tmp_stride;
 }
 
+TEST_P(SADx8dTest, MaxRef) {
+  FillConstant(source_data_, source_stride_, 0);
+  FillRefsConstant(mask_);
+  CheckSADs();
+}
+
+TEST_P(SADx8dTest, MaxSrc) {
+  FillConstant(source_data_, source_stride_, mask_);
+  FillRefsConstant(0);
+  CheckSADs();
+}
+
+TEST_P(SADx8dTest, ShortRef) {
+  const int tmp_stride = reference_stride_;
+  reference_stride_ >>= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRefsRandom();
+  CheckSADs();
+  reference_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8dTest, UnalignedRef) {
+  const int tmp_stride = reference_stride_;
+  reference_stride_ -= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRefsRandom();
+  CheckSADs();
+  reference_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8dTest, ShortSrc) {
+  const int tmp_stride = source_stride_;
+  source_stride_ >>= 1;
+  FillRandom(source_data_, source_stride_);
+  FillRefsRandom();
+  CheckSADs();
+  source_stride_ = tmp_stride;
+}
+
+TEST_P(SADx8dTest, SrcAlignedByWidth) {
+  uint8_t *tmp_source_data = source_data_;
+  source_data_ += params_.width;
+  FillRandom(source_data_, source_stride_);
+  FillRefsRandom();
+  CheckSADs();
+  source_data_ = tmp_source_data;
+}
+
+TEST_P(SADx8dTest, DISABLED_Speed) {
+  const int kCountSpeedTestBlock = 500000000 / (params_.width * params_.height);
+  DECLARE_ALIGNED(kDataAlignment, uint32_t, sads[8]);
+  const uint8_t *references[8];
+  vpx_usec_timer timer;
+
+  FillRandom(source_data_, source_stride_);
+  FillRefsRandom();
+  for (int ref = 0; ref < 8; ++ref) {
+    references[ref] = GetReferenceFromOffset(GetRefOffset(ref));
+  }
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kCountSpeedTestBlock; ++i) {
+    params_.func(source_data_, source_stride_, references, reference_stride_,
+                 sads);
+  }
+  vpx_usec_timer_mark(&timer);
+  const int elapsed_time =
+      static_cast<int>(vpx_usec_timer_elapsed(&timer) / 1000);
+  printf("sad%dx%dx8d time: %5d ms\n", params_.width, params_.height,
+         elapsed_time);
+  CheckSADs();
+}
+
 TEST_P(SADx8Test, Regular) {
   FillRandomWH(source_data_, source_stride_, params_.width, params_.height);
   FillRandomWH(GetReferenceFromOffset(0), reference_stride_, params_.width + 8,
@@ -747,6 +884,23 @@ const SadMxNx4Param x4d_c_tests[] = {
 };
 INSTANTIATE_TEST_SUITE_P(C, SADx4Test, ::testing::ValuesIn(x4d_c_tests));
 
+const SadMxNx8dParam x8d_c_tests[] = {
+  SadMxNx8dParam(64, 64, &vpx_sad64x64x8d_c),
+  SadMxNx8dParam(64, 32, &vpx_sad64x32x8d_c),
+  SadMxNx8dParam(32, 64, &vpx_sad32x64x8d_c),
+  SadMxNx8dParam(32, 32, &vpx_sad32x32x8d_c),
+  SadMxNx8dParam(32, 16, &vpx_sad32x16x8d_c),
+  SadMxNx8dParam(16, 32, &vpx_sad16x32x8d_c),
+  SadMxNx8dParam(16, 16, &vpx_sad16x16x8d_c),
+  SadMxNx8dParam(16, 8, &vpx_sad16x8x8d_c),
+  SadMxNx8dParam(8, 16, &vpx_sad8x16x8d_c),
+  SadMxNx8dParam(8, 8, &vpx_sad8x8x8d_c),
+  SadMxNx8dParam(8, 4, &vpx_sad8x4x8d_c),
+  SadMxNx8dParam(4, 8, &vpx_sad4x8x8d_c),
+  SadMxNx8dParam(4, 4, &vpx_sad4x4x8d_c),
+};
+INSTANTIATE_TEST_SUITE_P(C, SADx8dTest, ::testing::ValuesIn(x8d_c_tests));
+
 // TODO(angiebird): implement the marked-down sad functions
 const SadMxNx8Param x8_c_tests[] = {
   // SadMxNx8Param(64, 64, &vpx_sad64x64x8_c),
@@ -1011,6 +1165,47 @@ const SadMxNParam avx2_tests[] = {
   SadMxNParam(32, 64, &vpx_sad32x64_avx2),
   SadMxNParam(32, 32, &vpx_sad32x32_avx2),
   SadMxNParam(32, 16, &vpx_sad32x16_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH
+  SadMxNParam(64, 64, &vpx_highbd_sad64x64_avx2, 8),
+  SadMxNParam(64, 32, &vpx_highbd_sad64x32_avx2, 8),
+  SadMxNParam(32, 64, &vpx_highbd_sad32x64_avx2, 8),
+  SadMxNParam(32, 32, &vpx_highbd_sad32x32_avx2, 8),
+  SadMxNParam(32, 16, &vpx_highbd_sad32x16_avx2, 8),
+  SadMxNParam(16, 32, &vpx_highbd_sad16x32_avx2, 8),
+  SadMxNParam(16, 16, &vpx_highbd_sad16x16_avx2, 8),
+  SadMxNParam(16, 8, &vpx_highbd_sad16x8_avx2, 8),
+  SadMxNParam(8, 16, &vpx_highbd_sad8x16_avx2, 8),
+  SadMxNParam(8, 8, &vpx_highbd_sad8x8_avx2, 8),
+  SadMxNParam(8, 4, &vpx_highbd_sad8x4_avx2, 8),
+  SadMxNParam(4, 8, &vpx_highbd_sad4x8_avx2, 8),
+  SadMxNParam(4, 4, &vpx_highbd_sad4x4_avx2, 8),
+  SadMxNParam(64, 64, &vpx_highbd_sad64x64_avx2, 10),
+  SadMxNParam(64, 32, &vpx_highbd_sad64x32_avx2, 10),
+  SadMxNParam(32, 64, &vpx_highbd_sad32x64_avx2, 10),
+  SadMxNParam(32, 32, &vpx_highbd_sad32x32_avx2, 10),
+  SadMxNParam(32, 16, &vpx_highbd_sad32x16_avx2, 10),
+  SadMxNParam(16, 32, &vpx_highbd_sad16x32_avx2, 10),
+  SadMxNParam(16, 16, &vpx_highbd_sad16x16_avx2, 10),
+  SadMxNParam(16, 8, &vpx_highbd_sad16x8_avx2, 10),
+  SadMxNParam(8, 16, &vpx_highbd_sad8x16_avx2, 10),
+  SadMxNParam(8, 8, &vpx_highbd_sad8x8_avx2, 10),
+  SadMxNParam(8, 4, &vpx_highbd_sad8x4_avx2, 10),
+  SadMxNParam(4, 8, &vpx_highbd_sad4x8_avx2, 10),
+  SadMxNParam(4, 4, &vpx_highbd_sad4x4_avx2, 10),
+  SadMxNParam(64, 64, &vpx_highbd_sad64x64_avx2, 12),
+  SadMxNParam(64, 32, &vpx_highbd_sad64x32_avx2, 12),
+  SadMxNParam(32, 64, &vpx_highbd_sad32x64_avx2, 12),
+  SadMxNParam(32, 32, &vpx_highbd_sad32x32_avx2, 12),
+  SadMxNParam(32, 16, &vpx_highbd_sad32x16_avx2, 12),
+  SadMxNParam(16, 32, &vpx_highbd_sad16x32_avx2, 12),
+  SadMxNParam(16, 16, &vpx_highbd_sad16x16_avx2, 12),
+  SadMxNParam(16, 8, &vpx_highbd_sad16x8_avx2, 12),
+  SadMxNParam(8, 16, &vpx_highbd_sad8x16_avx2, 12),
+  SadMxNParam(8, 8, &vpx_highbd_sad8x8_avx2, 12),
+  SadMxNParam(8, 4, &vpx_highbd_sad8x4_avx2, 12),
+  SadMxNParam(4, 8, &vpx_highbd_sad4x8_avx2, 12),
+  SadMxNParam(4, 4, &vpx_highbd_sad4x4_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADTest, ::testing::ValuesIn(avx2_tests));
 
@@ -1020,15 +1215,115 @@ const SadMxNAvgParam avg_avx2_tests[] = {
   SadMxNAvgParam(32, 64, &vpx_sad32x64_avg_avx2),
   SadMxNAvgParam(32, 32, &vpx_sad32x32_avg_avx2),
   SadMxNAvgParam(32, 16, &vpx_sad32x16_avg_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH
+  SadMxNAvgParam(64, 64, &vpx_highbd_sad64x64_avg_avx2, 8),
+  SadMxNAvgParam(64, 32, &vpx_highbd_sad64x32_avg_avx2, 8),
+  SadMxNAvgParam(32, 64, &vpx_highbd_sad32x64_avg_avx2, 8),
+  SadMxNAvgParam(32, 32, &vpx_highbd_sad32x32_avg_avx2, 8),
+  SadMxNAvgParam(32, 16, &vpx_highbd_sad32x16_avg_avx2, 8),
+  SadMxNAvgParam(16, 32, &vpx_highbd_sad16x32_avg_avx2, 8),
+  SadMxNAvgParam(16, 16, &vpx_highbd_sad16x16_avg_avx2, 8),
+  SadMxNAvgParam(16, 8, &vpx_highbd_sad16x8_avg_avx2, 8),
+  SadMxNAvgParam(8, 16, &vpx_highbd_sad8x16_avg_avx2, 8),
+  SadMxNAvgParam(8, 8, &vpx_highbd_sad8x8_avg_avx2, 8),
+  SadMxNAvgParam(8, 4, &vpx_highbd_sad8x4_avg_avx2, 8),
+  SadMxNAvgParam(4, 8, &vpx_highbd_sad4x8_avg_avx2, 8),
+  SadMxNAvgParam(4, 4, &vpx_highbd_sad4x4_avg_avx2, 8),
+  SadMxNAvgParam(64, 64, &vpx_highbd_sad64x64_avg_avx2, 10),
+  SadMxNAvgParam(64, 32, &vpx_highbd_sad64x32_avg_avx2, 10),
+  SadMxNAvgParam(32, 64, &vpx_highbd_sad32x64_avg_avx2, 10),
+  SadMxNAvgParam(32, 32, &vpx_highbd_sad32x32_avg_avx2, 10),
+  SadMxNAvgParam(32, 16, &vpx_highbd_sad32x16_avg_avx2, 10),
+  SadMxNAvgParam(16, 32, &vpx_highbd_sad16x32_avg_avx2, 10),
+  SadMxNAvgParam(16, 16, &vpx_highbd_sad16x16_avg_avx2, 10),
+  SadMxNAvgParam(16, 8, &vpx_highbd_sad16x8_avg_avx2, 10),
+  SadMxNAvgParam(8, 16, &vpx_highbd_sad8x16_avg_avx2, 10),
+  SadMxNAvgParam(8, 8, &vpx_highbd_sad8x8_avg_avx2, 10),
+  SadMxNAvgParam(8, 4, &vpx_highbd_sad8x4_avg_avx2, 10),
+  SadMxNAvgParam(4, 8, &vpx_highbd_sad4x8_avg_avx2, 10),
+  SadMxNAvgParam(4, 4, &vpx_highbd_sad4x4_avg_avx2, 10),
+  SadMxNAvgParam(64, 64, &vpx_highbd_sad64x64_avg_avx2, 12),
+  SadMxNAvgParam(64, 32, &vpx_highbd_sad64x32_avg_avx2, 12),
+  SadMxNAvgParam(32, 64, &vpx_highbd_sad32x64_avg_avx2, 12),
+  SadMxNAvgParam(32, 32, &vpx_highbd_sad32x32_avg_avx2, 12),
+  SadMxNAvgParam(32, 16, &vpx_highbd_sad32x16_avg_avx2, 12),
+  SadMxNAvgParam(16, 32, &vpx_highbd_sad16x32_avg_avx2, 12),
+  SadMxNAvgParam(16, 16, &vpx_highbd_sad16x16_avg_avx2, 12),
+  SadMxNAvgParam(16, 8, &vpx_highbd_sad16x8_avg_avx2, 12),
+  SadMxNAvgParam(8, 16, &vpx_highbd_sad8x16_avg_avx2, 12),
+  SadMxNAvgParam(8, 8, &vpx_highbd_sad8x8_avg_avx2, 12),
+  SadMxNAvgParam(8, 4, &vpx_highbd_sad8x4_avg_avx2, 12),
+  SadMxNAvgParam(4, 8, &vpx_highbd_sad4x8_avg_avx2, 12),
+  SadMxNAvgParam(4, 4, &vpx_highbd_sad4x4_avg_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADavgTest, ::testing::ValuesIn(avg_avx2_tests));
 
 const SadMxNx4Param x4d_avx2_tests[] = {
   SadMxNx4Param(64, 64, &vpx_sad64x64x4d_avx2),
   SadMxNx4Param(32, 32, &vpx_sad32x32x4d_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH
+  SadMxNx4Param(64, 64, &vpx_highbd_sad64x64x4d_avx2, 8),
+  SadMxNx4Param(64, 32, &vpx_highbd_sad64x32x4d_avx2, 8),
+  SadMxNx4Param(32, 64, &vpx_highbd_sad32x64x4d_avx2, 8),
+  SadMxNx4Param(32, 32, &vpx_highbd_sad32x32x4d_avx2, 8),
+  SadMxNx4Param(32, 16, &vpx_highbd_sad32x16x4d_avx2, 8),
+  SadMxNx4Param(16, 32, &vpx_highbd_sad16x32x4d_avx2, 8),
+  SadMxNx4Param(16, 16, &vpx_highbd_sad16x16x4d_avx2, 8),
+  SadMxNx4Param(16, 8, &vpx_highbd_sad16x8x4d_avx2, 8),
+  SadMxNx4Param(8, 16, &vpx_highbd_sad8x16x4d_avx2, 8),
+  SadMxNx4Param(8, 8, &vpx_highbd_sad8x8x4d_avx2, 8),
+  SadMxNx4Param(8, 4, &vpx_highbd_sad8x4x4d_avx2, 8),
+  SadMxNx4Param(4, 8, &vpx_highbd_sad4x8x4d_avx2, 8),
+  SadMxNx4Param(4, 4, &vpx_highbd_sad4x4x4d_avx2, 8),
+  SadMxNx4Param(64, 64, &vpx_highbd_sad64x64x4d_avx2, 10),
+  SadMxNx4Param(64, 32, &vpx_highbd_sad64x32x4d_avx2, 10),
+  SadMxNx4Param(32, 64, &vpx_highbd_sad32x64x4d_avx2, 10),
+  SadMxNx4Param(32, 32, &vpx_highbd_sad32x32x4d_avx2, 10),
+  SadMxNx4Param(32, 16, &vpx_highbd_sad32x16x4d_avx2, 10),
+  SadMxNx4Param(16, 32, &vpx_highbd_sad16x32x4d_avx2, 10),
+  SadMxNx4Param(16, 16, &vpx_highbd_sad16x16x4d_avx2, 10),
+  SadMxNx4Param(16, 8, &vpx_highbd_sad16x8x4d_avx2, 10),
+  SadMxNx4Param(8, 16, &vpx_highbd_sad8x16x4d_avx2, 10),
+  SadMxNx4Param(8, 8, &vpx_highbd_sad8x8x4d_avx2, 10),
+  SadMxNx4Param(8, 4, &vpx_highbd_sad8x4x4d_avx2, 10),
+  SadMxNx4Param(4, 8, &vpx_highbd_sad4x8x4d_avx2, 10),
+  SadMxNx4Param(4, 4, &vpx_highbd_sad4x4x4d_avx2, 10),
+  SadMxNx4Param(64, 64, &vpx_highbd_sad64x64x4d_avx2, 12),
+  SadMxNx4Param(64, 32, &vpx_highbd_sad64x32x4d_avx2, 12),
+  SadMxNx4Param(32, 64, &vpx_highbd_sad32x64x4d_avx2, 12),
+  SadMxNx4Param(32, 32, &vpx_highbd_sad32x32x4d_avx2, 12),
+  SadMxNx4Param(32, 16, &vpx_highbd_sad32x16x4d_avx2, 12),
+  SadMxNx4Param(16, 32, &vpx_highbd_sad16x32x4d_avx2, 12),
+  SadMxNx4Param(16, 16, &vpx_highbd_sad16x16x4d_avx2, 12),
+  SadMxNx4Param(16, 8, &vpx_highbd_sad16x8x4d_avx2, 12),
+  SadMxNx4Param(8, 16, &vpx_highbd_sad8x16x4d_avx2, 12),
+  SadMxNx4Param(8, 8, &vpx_highbd_sad8x8x4d_avx2, 12),
+  SadMxNx4Param(8, 4, &vpx_highbd_sad8x4x4d_avx2, 12),
+  SadMxNx4Param(4, 8, &vpx_highbd_sad4x8x4d_avx2, 12),
+  SadMxNx4Param(4, 4, &vpx_highbd_sad4x4x4d_avx2, 12),
+#endif  // CONFIG_VP9_HIGHBITDEPTH
 };
 INSTANTIATE_TEST_SUITE_P(AVX2, SADx4Test, ::testing::ValuesIn(x4d_avx2_tests));
 
+const SadMxNx8dParam x8d_avx2_tests[] = {
+  SadMxNx8dParam(64, 64, &vpx_sad64x64x8d_avx2),
+  SadMxNx8dParam(64, 32, &vpx_sad64x32x8d_avx2),
+  SadMxNx8dParam(32, 64, &vpx_sad32x64x8d_avx2),
+  SadMxNx8dParam(32, 32, &vpx_sad32x32x8d_avx2),
+  SadMxNx8dParam(32, 16, &vpx_sad32x16x8d_avx2),
+  SadMxNx8dParam(16, 32, &vpx_sad16x32x8d_avx2),
+  SadMxNx8dParam(16, 16, &vpx_sad16x16x8d_avx2),
+  SadMxNx8dParam(16, 8, &vpx_sad16x8x8d_avx2),
+  SadMxNx8dParam(8, 16, &vpx_sad8x16x8d_avx2),
+  SadMxNx8dParam(8, 8, &vpx_sad8x8x8d_avx2),
+  SadMxNx8dParam(8, 4, &vpx_sad8x4x8d_avx2),
+  SadMxNx8dParam(4, 8, &vpx_sad4x8x8d_avx2),
+  SadMxNx8dParam(4, 4, &vpx_sad4x4x8d_avx2),
+};
+INSTANTIATE_TEST_SUITE_P(AVX2, SADx8dTest,
+                         ::testing::ValuesIn(x8d_avx2_tests));
+
 const SadMxNx8Param x8_avx2_tests[] = {
   // SadMxNx8Param(64, 64, &vpx_sad64x64x8_c),
   SadMxNx8Param(32, 32, &vpx_sad32x32x8_avx2),
@@ -1042,6 +1337,16 @@ const SadMxNx4Param x4d_avx512_tests[] = {
 };
 INSTANTIATE_TEST_SUITE_P(AVX512, SADx4Test,
                          ::testing::ValuesIn(x4d_avx512_tests));
+
+const SadMxNx8dParam x8d_avx512_tests[] = {
+  SadMxNx8dParam(64, 64, &vpx_sad64x64x8d_avx512),
+  SadMxNx8dParam(64, 32, &vpx_sad64x32x8d_avx512),
+  SadMxNx8dParam(32, 64, &vpx_sad32x64x8d_avx512),
+  SadMxNx8dParam(32, 32, &vpx_sad32x32x8d_avx512),
+  SadMxNx8dParam(32, 16, &vpx_sad32x16x8d_avx512),
+};
+INSTANTIATE_TEST_SUITE_P(AVX512, SADx8dTest,
+                         ::testing::ValuesIn(x8d_avx512_tests));
 #endif  // HAVE_AVX512
 
 //------------------------------------------------------------------------------
@@ -83,5 +83,42 @@ vp8_multi_resolution_encoder_three_formats() {
   fi
 }
 
-vp8_mre_tests="vp8_multi_resolution_encoder_three_formats"
+# Encodes the three formats with and without the multi-res pipeline, and
+# checks that the outputs match.
+vp8_multi_resolution_encoder_pipeline() {
+  local layer_bitrates="150 80 50"
+  local keyframe_insert="200"
+  local temporal_layers="3 3 3"
+  local framerate="30"
+
+  if [ "$(vpx_config_option_enabled CONFIG_MULTI_RES_ENCODING)" = "yes" ]; then
+    if [ "$(vp8_encode_available)" = "yes" ]; then
+      for pipeline in 0 1; do
+        vp8_mre "${YUV_RAW_INPUT_WIDTH}" \
+          "${YUV_RAW_INPUT_HEIGHT}" \
+          "${framerate}" \
+          "${YUV_RAW_INPUT}" \
+          "${VPX_TEST_OUTPUT_DIR}/vp8_mre_p${pipeline}_0.ivf" \
+          "${VPX_TEST_OUTPUT_DIR}/vp8_mre_p${pipeline}_1.ivf" \
+          "${VPX_TEST_OUTPUT_DIR}/vp8_mre_p${pipeline}_2.ivf" \
+          ${layer_bitrates} \
+          ${temporal_layers} \
+          "${keyframe_insert}" \
+          0 \
+          "${pipeline}" || return 1
+      done
+
+      for i in 0 1 2; do
+        if ! cmp -s "${VPX_TEST_OUTPUT_DIR}/vp8_mre_p0_${i}.ivf" \
+                    "${VPX_TEST_OUTPUT_DIR}/vp8_mre_p1_${i}.ivf"; then
+          elog "Pipelined output ${i} does not match."
+          return 1
+        fi
+      done
+    fi
+  fi
+}
+
+vp8_mre_tests="vp8_multi_resolution_encoder_three_formats
+               vp8_multi_resolution_encoder_pipeline"
 run_tests vp8_multi_resolution_encoder_verify_environment "${vp8_mre_tests}"
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "vpx/vp8cx.h"
+
+namespace {
+
+const int kFrames = 20;
+
+class RecodeFreeRcTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<vpx_rc_mode, int> {
+ protected:
+  RecodeFreeRcTest()
+      : EncoderTest(GET_PARAM(0)), end_usage_(GET_PARAM(1)),
+        cpu_used_(GET_PARAM(2)), recode_free_rc_(0), bits_total_(0),
+        frame_requantizations_(0), key_frames_(0),
+        key_frame_requantizations_(0) {}
+  ~RecodeFreeRcTest() override {}
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.rc_end_usage = end_usage_;
+    cfg_.rc_target_bitrate = 300;
+    cfg_.g_lag_in_frames = 0;
+  }
+
+  void BeginPassHook(unsigned int /*pass*/) override {
+    memset(&stats_, 0, sizeof(stats_));
+    bits_total_ = 0;
+    key_frames_ = 0;
+    key_frame_requantizations_ = 0;
+  }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used_);
+      encoder->Control(VP8E_SET_RECODE_FREE_RC, recode_free_rc_);
+    }
+  }
+
+  void PostEncodeFrameHook(::libvpx_test::Encoder *encoder) override {
+    const uint64_t requantizations = stats_.requantizations;
+    encoder->Control(VP8E_GET_RECODE_STATS, &stats_);
+    frame_requantizations_ = stats_.requantizations - requantizations;
+  }
+
+  void FramePktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    bits_total_ += pkt->data.frame.sz * 8;
+    // The first key frame is not forced by the interval.
+    if ((pkt->data.frame.flags & VPX_FRAME_IS_KEY) && pkt->data.frame.pts > 0) {
+      ++key_frames_;
+      key_frame_requantizations_ += frame_requantizations_;
+    }
+  }
+
+  void Encode(unsigned int recode_free_rc) {
+    ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352,
+                                         288, 30, 1, 0, kFrames);
+    recode_free_rc_ = recode_free_rc;
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  }
+
+  vpx_rc_mode end_usage_;
+  int cpu_used_;
+  unsigned int recode_free_rc_;
+  size_t bits_total_;
+  vpx_recode_stats_t stats_;
+  uint64_t frame_requantizations_;
+  int key_frames_;
+  uint64_t key_frame_requantizations_;
+};
+
+TEST_P(RecodeFreeRcTest, AtMostOneRequantizationPerFrame) {
+  ASSERT_NO_FATAL_FAILURE(Encode(1));
+  EXPECT_EQ(static_cast<uint64_t>(kFrames), stats_.frames);
+  EXPECT_EQ(0u, stats_.recodes);
+  EXPECT_LE(stats_.requantizations, stats_.frames);
+  EXPECT_LE(stats_.extra_encode_us, stats_.encode_us);
+}
+
+TEST_P(RecodeFreeRcTest, RateCloseToRecodingEncoder) {
+  ASSERT_NO_FATAL_FAILURE(Encode(0));
+  const size_t recode_bits = bits_total_;
+
+  ASSERT_NO_FATAL_FAILURE(Encode(1));
+  EXPECT_GE(bits_total_, recode_bits * 85 / 100);
+  EXPECT_LE(bits_total_, recode_bits * 115 / 100);
+}
+
+// Key frames forced by the maximum interval search their Q with full
+// encodes, as the recoding encoder does.
+TEST_P(RecodeFreeRcTest, ForcedKeyFramesAreNotRequantized) {
+  cfg_.kf_max_dist = 4;
+  ASSERT_NO_FATAL_FAILURE(Encode(1));
+  EXPECT_GT(key_frames_, 0);
+  EXPECT_EQ(0u, key_frame_requantizations_);
+}
+
+VP8_INSTANTIATE_TEST_SUITE(RecodeFreeRcTest,
+                           ::testing::Values(VPX_VBR, VPX_CBR),
+                           ::testing::Values(0, 2));
+
+}  // namespace
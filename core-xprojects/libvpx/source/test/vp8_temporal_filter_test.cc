@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp8_rtcd.h"
+#include "test/acm_random.h"
+#include "test/register_state_check.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+using ::libvpx_test::ACMRandom;
+
+typedef void (*TemporalFilterFunc)(unsigned char *frame1, unsigned int stride,
+                                   unsigned char *frame2,
+                                   unsigned int block_size, int strength,
+                                   int filter_weight,
+                                   unsigned int *accumulator,
+                                   unsigned short *count);
+
+const int kStride = 48;
+
+class VP8TemporalFilterTest
+    : public ::testing::TestWithParam<TemporalFilterFunc> {
+ public:
+  void SetUp() override {
+    filter_func_ = GetParam();
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+ protected:
+  // Fills the source block with random values and the predictor with values
+  // within max_diff of it.
+  void FillBlocks(unsigned int block_size, int max_diff) {
+    for (unsigned int i = 0; i < block_size; ++i) {
+      for (unsigned int j = 0; j < block_size; ++j) {
+        const int src = rnd_.Rand8();
+        const int diff = rnd_(2 * max_diff + 1) - max_diff;
+        src_[i * kStride + j] = src;
+        pred_[i * block_size + j] =
+            static_cast<uint8_t>(VPXMAX(0, VPXMIN(255, src + diff)));
+      }
+    }
+  }
+
+  void RunAndCompare(unsigned int block_size, int strength, int weight) {
+    unsigned int accum_ref[16 * 16], accum_test[16 * 16];
+    unsigned short count_ref[16 * 16], count_test[16 * 16];
+    for (int i = 0; i < 16 * 16; ++i) {
+      accum_ref[i] = accum_test[i] = rnd_.Rand16();
+      count_ref[i] = count_test[i] = rnd_.Rand8();
+    }
+
+    vp8_temporal_filter_apply_c(src_, kStride, pred_, block_size, strength,
+                                weight, accum_ref, count_ref);
+    ASM_REGISTER_STATE_CHECK(filter_func_(src_, kStride, pred_, block_size,
+                                          strength, weight, accum_test,
+                                          count_test));
+
+    for (unsigned int i = 0; i < block_size * block_size; ++i) {
+      ASSERT_EQ(accum_ref[i], accum_test[i])
+          << "size " << block_size << " strength " << strength << " weight "
+          << weight << " at " << i;
+      ASSERT_EQ(count_ref[i], count_test[i])
+          << "size " << block_size << " strength " << strength << " weight "
+          << weight << " at " << i;
+    }
+  }
+
+  TemporalFilterFunc filter_func_;
+  ACMRandom rnd_;
+  DECLARE_ALIGNED(16, uint8_t, src_[16 * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, pred_[16 * 16]);
+};
+
+TEST_P(VP8TemporalFilterTest, CompareReferenceRandom) {
+  for (unsigned int block_size = 8; block_size <= 16; block_size += 8) {
+    for (int strength = 0; strength <= 6; ++strength) {
+      for (int weight = 0; weight <= 2; ++weight) {
+        for (int iter = 0; iter < 10; ++iter) {
+          FillBlocks(block_size, iter < 5 ? 8 : 255);
+          RunAndCompare(block_size, strength, weight);
+        }
+      }
+    }
+  }
+}
+
+TEST_P(VP8TemporalFilterTest, Extremes) {
+  for (unsigned int block_size = 8; block_size <= 16; block_size += 8) {
+    for (int strength = 0; strength <= 6; ++strength) {
+      memset(src_, 255, sizeof(src_));
+      memset(pred_, 0, sizeof(pred_));
+      RunAndCompare(block_size, strength, 2);
+      memset(src_, 0, sizeof(src_));
+      memset(pred_, 255, sizeof(pred_));
+      RunAndCompare(block_size, strength, 2);
+      memset(pred_, 0, sizeof(pred_));
+      RunAndCompare(block_size, strength, 2);
+    }
+  }
+}
+
+TEST_P(VP8TemporalFilterTest, DISABLED_Speed) {
+  unsigned int accum[16 * 16];
+  unsigned short count[16 * 16];
+  memset(accum, 0, sizeof(accum));
+  memset(count, 0, sizeof(count));
+  FillBlocks(16, 32);
+
+  for (unsigned int block_size = 8; block_size <= 16; block_size += 8) {
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < 1000000; ++i) {
+      filter_func_(src_, kStride, pred_, block_size, 6, 2, accum, count);
+    }
+    vpx_usec_timer_mark(&timer);
+    printf("Temporal filter %ux%u: %d us\n", block_size, block_size,
+           static_cast<int>(vpx_usec_timer_elapsed(&timer)));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(C, VP8TemporalFilterTest,
+                         ::testing::Values(&vp8_temporal_filter_apply_c));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(SSE2, VP8TemporalFilterTest,
+                         ::testing::Values(&vp8_temporal_filter_apply_sse2));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(AVX2, VP8TemporalFilterTest,
+                         ::testing::Values(&vp8_temporal_filter_apply_avx2));
+#endif  // HAVE_AVX2
+
+#if HAVE_MSA
+INSTANTIATE_TEST_SUITE_P(MSA, VP8TemporalFilterTest,
+                         ::testing::Values(&vp8_temporal_filter_apply_msa));
+#endif  // HAVE_MSA
+}  // namespace
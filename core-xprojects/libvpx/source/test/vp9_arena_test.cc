@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "vp9/encoder/vp9_arena.h"
+
+namespace {
+
+const int kFrames = 60;
+// Frames after which the arenas are expected to have reached their largest
+// size. By then the encoder has coded both frame sizes it switches between.
+const int kWarmupFrames = 20;
+// Frames between switches of the internal frame size.
+const int kScaleInterval = 5;
+
+class ArenaTest : public ::libvpx_test::EncoderTest,
+                  public ::libvpx_test::CodecTestWithParam<int> {
+ protected:
+  ArenaTest()
+      : EncoderTest(GET_PARAM(0)), threads_(GET_PARAM(1)), frame_(0),
+        heap_allocs_before_encode_(0), steady_heap_allocs_(0),
+        last_arena_allocs_(0) {}
+  ~ArenaTest() override {}
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(::libvpx_test::kRealTime);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.g_threads = threads_;
+    cfg_.rc_end_usage = VPX_CBR;
+    cfg_.rc_target_bitrate = 500;
+    cfg_.kf_max_dist = 9999;
+  }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 7);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, threads_ > 1 ? 1 : 0);
+      encoder->Control(VP9E_SET_ROW_MT, threads_ > 1);
+    }
+    // Switch between the full and the half size, as spatial layers do.
+    if (video->frame() % kScaleInterval == 0) {
+      const VPX_SCALING_MODE scale =
+          (video->frame() / kScaleInterval) % 2 ? VP8E_ONETWO : VP8E_NORMAL;
+      struct vpx_scaling_mode mode = { scale, scale };
+      encoder->Control(VP8E_SET_SCALEMODE, &mode);
+    }
+
+    vpx_arena_stats_t stats;
+    encoder->Control(VP9E_GET_ARENA_STATS, &stats);
+    heap_allocs_before_encode_ = stats.heap_allocs;
+  }
+
+  void PostEncodeFrameHook(::libvpx_test::Encoder *encoder) override {
+    // The last call flushes the encoder without encoding a frame.
+    if (frame_ == kFrames) return;
+
+    vpx_arena_stats_t stats;
+    encoder->Control(VP9E_GET_ARENA_STATS, &stats);
+    if (frame_ > kWarmupFrames)
+      steady_heap_allocs_ += stats.heap_allocs - heap_allocs_before_encode_;
+    // Every frame takes its partitioning scratch from the frame arena.
+    ASSERT_GT(stats.arena_allocs, last_arena_allocs_);
+    last_arena_allocs_ = stats.arena_allocs;
+    ++frame_;
+  }
+
+  int threads_;
+  int frame_;
+  uint64_t heap_allocs_before_encode_;
+  uint64_t steady_heap_allocs_;
+  uint64_t last_arena_allocs_;
+};
+
+// The arenas, and the regions of the buffers that grow on their own, stop
+// calling the heap once they have seen both frame sizes.
+TEST_P(ArenaTest, NoHeapAllocationsInSteadyState) {
+  ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, kFrames);
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_EQ(kFrames, frame_);
+  EXPECT_EQ(0u, steady_heap_allocs_);
+}
+
+TEST(ArenaRegionTest, GrowsToHighWater) {
+  VP9Arena arena;
+  VP9ArenaRegion *region = nullptr;
+  memset(&arena, 0, sizeof(arena));
+
+  void *const first = vp9_arena_region_alloc(&arena, &region, 1000, 32);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first) % 32);
+  EXPECT_EQ(1u, arena.stats.heap_allocs);
+
+  // A smaller buffer reuses the region, also across a reset.
+  vp9_arena_reset(&arena);
+  EXPECT_EQ(first, vp9_arena_region_alloc(&arena, &region, 500, 32));
+  EXPECT_EQ(1u, arena.stats.heap_allocs);
+
+  // Growing it replaces the memory rather than adding to it.
+  uint8_t *const grown = static_cast<uint8_t *>(
+      vp9_arena_region_calloc(&arena, &region, 4, 1000, 16));
+  ASSERT_NE(grown, nullptr);
+  EXPECT_EQ(2u, arena.stats.heap_allocs);
+  EXPECT_EQ(arena.regions, region);
+  EXPECT_EQ(nullptr, region->next);
+  for (int i = 0; i < 4000; ++i) ASSERT_EQ(0, grown[i]);
+  EXPECT_EQ(grown, vp9_arena_region_alloc(&arena, &region, 1000, 16));
+  EXPECT_EQ(2u, arena.stats.heap_allocs);
+
+  vp9_arena_free(&arena);
+  EXPECT_EQ(nullptr, arena.regions);
+}
+
+VP9_INSTANTIATE_TEST_SUITE(ArenaTest, ::testing::Values(1, 4));
+
+}  // namespace
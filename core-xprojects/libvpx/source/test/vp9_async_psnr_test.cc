@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+
+namespace {
+
+const int kFrames = 20;
+
+struct PsnrResult {
+  uint64_t sse[4];
+  uint32_t samples[4];
+
+  bool operator==(const PsnrResult &other) const {
+    for (int i = 0; i < 4; ++i) {
+      if (sse[i] != other.sse[i] || samples[i] != other.samples[i])
+        return false;
+    }
+    return true;
+  }
+};
+
+class AsyncPsnrTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+ protected:
+  AsyncPsnrTest()
+      : EncoderTest(GET_PARAM(0)), mode_(GET_PARAM(1)),
+        lag_in_frames_(GET_PARAM(2)), async_psnr_(0), async_off_frame_(-1),
+        shown_frames_(0) {}
+  ~AsyncPsnrTest() override {}
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(mode_);
+    init_flags_ = VPX_CODEC_USE_PSNR;
+    cfg_.g_lag_in_frames = lag_in_frames_;
+    cfg_.rc_target_bitrate = 300;
+  }
+
+  void BeginPassHook(unsigned int /*pass*/) override {
+    results_.clear();
+    shown_frames_ = 0;
+  }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      const int cpu_used = mode_ == ::libvpx_test::kRealTime ? 7 : 4;
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used);
+      encoder->Control(VP9E_SET_ROW_MT, 1);
+      encoder->Control(VP9E_SET_ASYNC_PSNR, async_psnr_);
+      if (lag_in_frames_ > 0) encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+    }
+    if (static_cast<int>(video->frame()) == async_off_frame_)
+      encoder->Control(VP9E_SET_ASYNC_PSNR, 0);
+  }
+
+  void FramePktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    if (!(pkt->data.frame.flags & VPX_FRAME_IS_INVISIBLE)) ++shown_frames_;
+  }
+
+  void PSNRPktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    PsnrResult result;
+    for (int i = 0; i < 4; ++i) {
+      result.sse[i] = pkt->data.psnr.sse[i];
+      result.samples[i] = pkt->data.psnr.samples[i];
+    }
+    results_.push_back(result);
+  }
+
+  void Encode(int threads, int async_psnr, std::vector<PsnrResult> *results) {
+    ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352,
+                                         288, 30, 1, 0, kFrames);
+    cfg_.g_threads = threads;
+    async_psnr_ = async_psnr;
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    EXPECT_EQ(kFrames, shown_frames_);
+    *results = results_;
+  }
+
+  ::libvpx_test::TestMode mode_;
+  int lag_in_frames_;
+  int async_psnr_;
+  // Frame before which VP9E_SET_ASYNC_PSNR is turned off, or -1.
+  int async_off_frame_;
+  int shown_frames_;
+  std::vector<PsnrResult> results_;
+};
+
+TEST_P(AsyncPsnrTest, MatchesSynchronousPsnr) {
+  // With several threads the synchronous PSNR is split by rows across the
+  // encoder threads, while the background one is computed whole.
+  for (int threads = 1; threads <= 4; threads += 3) {
+    SCOPED_TRACE(threads);
+    std::vector<PsnrResult> sync_results;
+    ASSERT_NO_FATAL_FAILURE(Encode(threads, 0, &sync_results));
+    ASSERT_EQ(static_cast<size_t>(kFrames), sync_results.size());
+
+    std::vector<PsnrResult> async_results;
+    ASSERT_NO_FATAL_FAILURE(Encode(threads, 1, &async_results));
+    EXPECT_EQ(sync_results, async_results);
+  }
+}
+
+TEST_P(AsyncPsnrTest, TurnedOffMidStream) {
+  std::vector<PsnrResult> sync_results;
+  ASSERT_NO_FATAL_FAILURE(Encode(1, 0, &sync_results));
+  ASSERT_EQ(static_cast<size_t>(kFrames), sync_results.size());
+
+  // The PSNR still pending when the background computation is turned off is
+  // returned before that of the next frame.
+  std::vector<PsnrResult> toggled_results;
+  async_off_frame_ = kFrames / 2;
+  ASSERT_NO_FATAL_FAILURE(Encode(1, 1, &toggled_results));
+  EXPECT_EQ(sync_results, toggled_results);
+}
+
+VP9_INSTANTIATE_TEST_SUITE(AsyncPsnrTest,
+                           ::testing::Values(::libvpx_test::kRealTime,
+                                             ::libvpx_test::kOnePassGood),
+                           ::testing::Values(0, 25));
+
+}  // namespace
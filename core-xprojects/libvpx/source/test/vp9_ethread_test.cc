@@ -13,6 +13,7 @@
 #include "third_party/googletest/src/include/gtest/gtest.h"
 #include "test/codec_factory.h"
 #include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
 #include "test/md5_helper.h"
 #include "test/util.h"
 #include "test/y4m_video_source.h"
@@ -390,6 +391,64 @@ TEST_P(VPxEncoderThreadTest, EncoderResultTest) {
   EXPECT_NEAR(single_thr_psnr, multi_thr_psnr, 0.2);
 }
 
+// In real-time mode the tiles are packed in parallel across tile rows and
+// columns. With row_mt on, the bitstream must not depend on the number of
+// threads once there is more than one.
+class VPxTilePackingThreadTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<int, int> {
+ protected:
+  VPxTilePackingThreadTest()
+      : EncoderTest(GET_PARAM(0)), tile_rows_(GET_PARAM(1)),
+        threads_(GET_PARAM(2)) {}
+  virtual ~VPxTilePackingThreadTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(::libvpx_test::kRealTime);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = VPX_CBR;
+    cfg_.rc_target_bitrate = 500;
+  }
+
+  virtual void BeginPassHook(unsigned int /*pass*/) { md5_.clear(); }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 7);
+      // Tile rows are only used without tile columns when multithreaded.
+      encoder->Control(VP9E_SET_TILE_COLUMNS, 0);
+      encoder->Control(VP9E_SET_TILE_ROWS, tile_rows_);
+      encoder->Control(VP9E_SET_ROW_MT, 1);
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    ::libvpx_test::MD5 md5_res;
+    md5_res.Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+                pkt->data.frame.sz);
+    md5_.push_back(md5_res.Get());
+  }
+
+  int tile_rows_;
+  int threads_;
+  std::vector<std::string> md5_;
+};
+
+TEST_P(VPxTilePackingThreadTest, BitstreamMatchesTwoThreads) {
+  ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352, 288,
+                                       30, 1, 0, 20);
+
+  cfg_.g_threads = 2;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  const std::vector<std::string> two_thr_md5 = md5_;
+
+  cfg_.g_threads = threads_;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  ASSERT_EQ(two_thr_md5, md5_);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     VP9, VPxFirstPassEncoderThreadTest,
     ::testing::Combine(
@@ -425,4 +484,8 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Range(0, 3),    // tile_columns
         ::testing::Range(2, 5)));  // threads
 
+VP9_INSTANTIATE_TEST_SUITE(VPxTilePackingThreadTest,
+                           ::testing::Range(1, 3),  // log2 of tile rows
+                           ::testing::Values(3, 4));
+
 }  // namespace
@@ -8,15 +8,24 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <map>
 #include <new>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "test/codec_factory.h"
 #include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
 #include "test/util.h"
 #include "test/yuv_video_source.h"
 #include "third_party/googletest/src/include/gtest/gtest.h"
 #include "vpx/vpx_ext_ratectrl.h"
+#include "vpx_ports/vpx_timer.h"
 
 namespace {
 
@@ -175,7 +184,7 @@ class ExtRateCtrlTest : public ::libvpx_test::EncoderTest,
   void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
                           ::libvpx_test::Encoder *encoder) override {
     if (video->frame() == 0) {
-      vpx_rc_funcs_t rc_funcs;
+      vpx_rc_funcs_t rc_funcs = {};
       rc_funcs.create_model = rc_create_model;
       rc_funcs.send_firstpass_stats = rc_send_firstpass_stats;
       rc_funcs.get_encodeframe_decision = rc_get_encodeframe_decision;
@@ -199,4 +208,251 @@ TEST_F(ExtRateCtrlTest, EncodeTest) {
   ASSERT_NO_FATAL_FAILURE(RunLoop(video.get()));
 }
 
+// A stand-in for an external model that decides the Q of a whole group of
+// pictures at once: the group's key, golden and alt-ref frames get a lower Q,
+// lowered further by their share of the propagated temporal dependency cost,
+// and the base Q follows the bits the previous frames spent. latency_us is
+// added to every call to stand for the time a real model takes.
+constexpr int kGopFrameNum = 20;
+constexpr int kGopTargetBitrateKbps = 1000;
+
+struct GopRateCtrlLog {
+  int latency_us = 0;
+  int num_calls = 0;
+  int num_tpl_frames = 0;
+  int num_results = 0;
+  int next_result_coding_index = 0;
+  std::map<int, int> q_index;  // Decided Q by coding index.
+};
+
+struct GopRateCtrl {
+  GopRateCtrlLog *log;
+  int target_frame_bits;
+  int base_q;
+};
+
+void Wait(int latency_us) {
+  if (latency_us > 0) {
+    std::this_thread::sleep_for(std::chrono::microseconds(latency_us));
+  }
+}
+
+void UpdateBaseQ(GopRateCtrl *model,
+                 const vpx_rc_encodeframe_result_t &result) {
+  if (result.bit_count > model->target_frame_bits) {
+    model->base_q = std::min(model->base_q + 4, 200);
+  } else {
+    model->base_q = std::max(model->base_q - 4, 40);
+  }
+}
+
+int PickQ(const GopRateCtrl &model, int frame_type,
+          const vpx_rc_tpl_frame_stats_t *tpl_stats) {
+  if (frame_type == 1 /*kFrameTypeInter*/ ||
+      frame_type == 3 /*kFrameTypeOverlay*/) {
+    return model.base_q;
+  }
+  int delta = 20;
+  if (tpl_stats != nullptr && tpl_stats->valid &&
+      tpl_stats->mc_dep_cost > 0) {
+    delta += static_cast<int>(20 * tpl_stats->intra_cost /
+                              tpl_stats->mc_dep_cost);
+  }
+  return std::max(model.base_q - delta, 0);
+}
+
+vpx_rc_status_t gop_rc_create_model(void *priv,
+                                    const vpx_rc_config_t *ratectrl_config,
+                                    vpx_rc_model_t *rate_ctrl_model_pt) {
+  GopRateCtrl *model = new (std::nothrow) GopRateCtrl;
+  EXPECT_NE(model, nullptr);
+  if (model == nullptr) return VPX_RC_ERROR;
+  model->log = static_cast<GopRateCtrlLog *>(priv);
+  model->target_frame_bits = ratectrl_config->target_bitrate_kbps * 1000 *
+                             ratectrl_config->frame_rate_den /
+                             ratectrl_config->frame_rate_num;
+  model->base_q = 120;
+  EXPECT_EQ(ratectrl_config->show_frame_count, kGopFrameNum);
+  *rate_ctrl_model_pt = model;
+  return VPX_RC_OK;
+}
+
+vpx_rc_status_t gop_rc_send_firstpass_stats(
+    vpx_rc_model_t /*rate_ctrl_model*/,
+    const vpx_rc_firstpass_stats_t *first_pass_stats) {
+  EXPECT_EQ(first_pass_stats->num_frames, kGopFrameNum);
+  return VPX_RC_OK;
+}
+
+vpx_rc_status_t gop_rc_get_gop_decisions(
+    vpx_rc_model_t rate_ctrl_model, const vpx_rc_gop_info_t *gop_info,
+    vpx_rc_encodeframe_decision_t *frame_decisions) {
+  GopRateCtrl *model = static_cast<GopRateCtrl *>(rate_ctrl_model);
+  GopRateCtrlLog *log = model->log;
+  ++log->num_calls;
+  Wait(log->latency_us);
+
+  for (int i = 0; i < gop_info->num_results; ++i) {
+    const vpx_rc_encodeframe_result_t &result = gop_info->results[i];
+    const int coding_index = log->next_result_coding_index++;
+    EXPECT_EQ(result.actual_encoding_qindex, log->q_index[coding_index])
+        << "coding_index " << coding_index;
+    EXPECT_EQ(result.pixel_count, 352 * 288 * 3 / 2);
+    UpdateBaseQ(model, result);
+    ++log->num_results;
+  }
+
+  EXPECT_GT(gop_info->num_frames, 0);
+  int min_show_index = kGopFrameNum;
+  for (int i = 0; i < gop_info->num_frames; ++i) {
+    const vpx_rc_encodeframe_info_t &info = gop_info->frame_info[i];
+    EXPECT_EQ(info.coding_index, gop_info->frame_info[0].coding_index + i);
+    EXPECT_EQ(info.gop_index, gop_info->frame_info[0].gop_index + i);
+    // The last group of pictures may reach past the end of the video.
+    EXPECT_LE(info.show_index, kGopFrameNum);
+    min_show_index = std::min(min_show_index, info.show_index);
+    if (gop_info->tpl_stats[i].valid) ++log->num_tpl_frames;
+    frame_decisions[i].q_index =
+        PickQ(*model, info.frame_type, &gop_info->tpl_stats[i]);
+    frame_decisions[i].max_frame_size = 0;
+    log->q_index[info.coding_index] = frame_decisions[i].q_index;
+  }
+  EXPECT_GT(gop_info->num_frame_stats, 0);
+  EXPECT_DOUBLE_EQ(gop_info->frame_stats[0].frame, min_show_index);
+  return VPX_RC_OK;
+}
+
+// The same model answering one frame at a time, to compare against.
+vpx_rc_status_t gop_rc_get_encodeframe_decision(
+    vpx_rc_model_t rate_ctrl_model,
+    const vpx_rc_encodeframe_info_t *encode_frame_info,
+    vpx_rc_encodeframe_decision_t *frame_decision) {
+  GopRateCtrl *model = static_cast<GopRateCtrl *>(rate_ctrl_model);
+  ++model->log->num_calls;
+  Wait(model->log->latency_us);
+  frame_decision->q_index =
+      PickQ(*model, encode_frame_info->frame_type, nullptr);
+  frame_decision->max_frame_size = 0;
+  model->log->q_index[encode_frame_info->coding_index] =
+      frame_decision->q_index;
+  return VPX_RC_OK;
+}
+
+vpx_rc_status_t gop_rc_update_encodeframe_result(
+    vpx_rc_model_t rate_ctrl_model,
+    const vpx_rc_encodeframe_result_t *encode_frame_result) {
+  GopRateCtrl *model = static_cast<GopRateCtrl *>(rate_ctrl_model);
+  Wait(model->log->latency_us);
+  UpdateBaseQ(model, *encode_frame_result);
+  ++model->log->num_results;
+  ++model->log->next_result_coding_index;
+  return VPX_RC_OK;
+}
+
+vpx_rc_status_t gop_rc_delete_model(vpx_rc_model_t rate_ctrl_model) {
+  delete static_cast<GopRateCtrl *>(rate_ctrl_model);
+  return VPX_RC_OK;
+}
+
+enum GopRateCtrlMode { kPerFrame, kGopSync, kGopAsync };
+
+class ExtRateCtrlGopTest : public ::libvpx_test::EncoderTest,
+                           public ::testing::Test {
+ protected:
+  ExtRateCtrlGopTest() : EncoderTest(&::libvpx_test::kVP9) {}
+
+  ~ExtRateCtrlGopTest() override = default;
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(::libvpx_test::kTwoPassGood);
+    cfg_.rc_target_bitrate = kGopTargetBitrateKbps;
+  }
+
+  void BeginPassHook(unsigned int /*pass*/) override {
+    md5_ = libvpx_test::MD5();
+    num_frames_ = 0;
+  }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      vpx_rc_funcs_t rc_funcs = {};
+      rc_funcs.create_model = gop_rc_create_model;
+      rc_funcs.send_firstpass_stats = gop_rc_send_firstpass_stats;
+      rc_funcs.update_encodeframe_result = gop_rc_update_encodeframe_result;
+      rc_funcs.delete_model = gop_rc_delete_model;
+      if (mode_ == kPerFrame) {
+        rc_funcs.get_encodeframe_decision = gop_rc_get_encodeframe_decision;
+      } else {
+        rc_funcs.get_gop_decisions = gop_rc_get_gop_decisions;
+        rc_funcs.async_gop_decisions = mode_ == kGopAsync;
+      }
+      rc_funcs.priv = &log_;
+      encoder->Control(VP9E_SET_EXTERNAL_RATE_CONTROL, &rc_funcs);
+    }
+  }
+
+  void FramePktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    md5_.Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+             pkt->data.frame.sz);
+    ++num_frames_;
+  }
+
+  void Encode(GopRateCtrlMode mode, int latency_us) {
+    mode_ = mode;
+    log_ = GopRateCtrlLog();
+    log_.latency_us = latency_us;
+    libvpx_test::YUVVideoSource video("hantro_collage_w352h288.yuv",
+                                      VPX_IMG_FMT_I420, 352, 288, 30, 1, 0,
+                                      kGopFrameNum);
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  }
+
+  GopRateCtrlMode mode_ = kPerFrame;
+  GopRateCtrlLog log_;
+  libvpx_test::MD5 md5_;
+  int num_frames_ = 0;
+};
+
+TEST_F(ExtRateCtrlGopTest, DecisionsAreBatchedPerGop) {
+  ASSERT_NO_FATAL_FAILURE(Encode(kGopSync, 0));
+  EXPECT_EQ(num_frames_, kGopFrameNum);
+  // Every coded frame, alt-refs included, has its result sent back. The
+  // results of the last frames come through update_encodeframe_result().
+  EXPECT_GT(log_.num_results, kGopFrameNum);
+  EXPECT_LE(log_.num_results, static_cast<int>(log_.q_index.size()));
+  // Each group of pictures is asked for once, and again with the temporal
+  // dependency stats when the model runs on it.
+  EXPECT_LT(log_.num_calls, log_.num_results / 2);
+  EXPECT_GT(log_.num_tpl_frames, 0);
+}
+
+TEST_F(ExtRateCtrlGopTest, AsyncMatchesSync) {
+  ASSERT_NO_FATAL_FAILURE(Encode(kGopSync, 0));
+  const std::string sync_md5 = md5_.Get();
+  const std::map<int, int> sync_q_index = log_.q_index;
+  ASSERT_NO_FATAL_FAILURE(Encode(kGopAsync, 100));
+  EXPECT_EQ(sync_md5, md5_.Get());
+  EXPECT_EQ(sync_q_index, log_.q_index);
+}
+
+// Reports the time of each whole encode, not of a frame.
+TEST_F(ExtRateCtrlGopTest, DISABLED_Speed) {
+  const char *const kModeNames[] = { "frame", "gop", "gop_async" };
+  const int kLatencyUs = 20000;
+  for (int mode = kPerFrame; mode <= kGopAsync; ++mode) {
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    ASSERT_NO_FATAL_FAILURE(
+        Encode(static_cast<GopRateCtrlMode>(mode), kLatencyUs));
+    vpx_usec_timer_mark(&timer);
+    const int elapsed_time =
+        static_cast<int>(vpx_usec_timer_elapsed(&timer) / 1000);
+    printf("ext_rc_%-9s calls: %2d time: %5d ms\n", kModeNames[mode],
+           log_.num_calls, elapsed_time);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+const int kFrames = 60;
+// Frames given to the deadline control to settle before timing starts.
+const int kWarmupFrames = 20;
+const int64_t kBudget = 1000;
+
+DEADLINE_CONTROL NewDeadlineControl(int speed) {
+  DEADLINE_CONTROL dc;
+  memset(&dc, 0, sizeof(dc));
+  dc.budget_us = kBudget;
+  dc.base_speed = speed;
+  dc.speed = speed;
+  return dc;
+}
+
+TEST(DeadlineControlTest, RaisesSpeedWhileOverBudget) {
+  DEADLINE_CONTROL dc = NewDeadlineControl(DEADLINE_MIN_SPEED);
+  vp9_deadline_control_update(&dc, 2 * kBudget);
+  EXPECT_EQ(DEADLINE_MIN_SPEED + 1, dc.speed);
+  for (int i = 0; i < DEADLINE_HOLD_UP; ++i) {
+    vp9_deadline_control_update(&dc, 2 * kBudget);
+    EXPECT_EQ(DEADLINE_MIN_SPEED + 1, dc.speed);
+  }
+  vp9_deadline_control_update(&dc, 2 * kBudget);
+  EXPECT_EQ(DEADLINE_MIN_SPEED + 2, dc.speed);
+  for (int i = 0; i < 100; ++i) vp9_deadline_control_update(&dc, 2 * kBudget);
+  EXPECT_EQ(DEADLINE_MAX_SPEED, dc.speed);
+}
+
+TEST(DeadlineControlTest, LowersSpeedWithSlack) {
+  DEADLINE_CONTROL dc = NewDeadlineControl(DEADLINE_MAX_SPEED);
+  vp9_deadline_control_update(&dc, kBudget / 2);
+  EXPECT_EQ(DEADLINE_MAX_SPEED - 1, dc.speed);
+  for (int i = 0; i < DEADLINE_HOLD_DOWN; ++i) {
+    vp9_deadline_control_update(&dc, kBudget / 2);
+    EXPECT_EQ(DEADLINE_MAX_SPEED - 1, dc.speed);
+  }
+  vp9_deadline_control_update(&dc, kBudget / 2);
+  EXPECT_EQ(DEADLINE_MAX_SPEED - 2, dc.speed);
+  for (int i = 0; i < 100; ++i) vp9_deadline_control_update(&dc, kBudget / 2);
+  EXPECT_EQ(DEADLINE_MIN_SPEED, dc.speed);
+}
+
+TEST(DeadlineControlTest, KeepsSpeedWithinBudget) {
+  // Between 2/3 of the budget and the budget the speed does not move, and a
+  // single slow frame does not pull the average over the budget.
+  DEADLINE_CONTROL dc = NewDeadlineControl(7);
+  for (int i = 0; i < 100; ++i) {
+    vp9_deadline_control_update(&dc, kBudget * 4 / 5);
+  }
+  EXPECT_EQ(7, dc.speed);
+  vp9_deadline_control_update(&dc, kBudget * 11 / 10);
+  EXPECT_EQ(7, dc.speed);
+}
+
+class FrameTimeBudgetTest : public ::libvpx_test::EncoderTest,
+                            public ::testing::Test {
+ protected:
+  FrameTimeBudgetTest()
+      : EncoderTest(&::libvpx_test::kVP9), cpu_used_(5), budget_(0),
+        frame_(0), timed_frames_(0), total_time_(0) {}
+  ~FrameTimeBudgetTest() override {}
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(::libvpx_test::kRealTime);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.g_threads = 1;
+    cfg_.rc_end_usage = VPX_CBR;
+    cfg_.rc_target_bitrate = 800;
+    cfg_.kf_max_dist = 9999;
+  }
+
+  void BeginPassHook(unsigned int /*pass*/) override {
+    frame_ = 0;
+    timed_frames_ = 0;
+    total_time_ = 0;
+    md5_.clear();
+  }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used_);
+      encoder->Control(VP9E_SET_FRAME_TIME_BUDGET, budget_);
+    }
+    vpx_usec_timer_start(&timer_);
+  }
+
+  void PostEncodeFrameHook(::libvpx_test::Encoder * /*encoder*/) override {
+    vpx_usec_timer_mark(&timer_);
+    if (frame_++ >= kWarmupFrames) {
+      total_time_ += vpx_usec_timer_elapsed(&timer_);
+      ++timed_frames_;
+    }
+  }
+
+  void FramePktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    ::libvpx_test::MD5 md5_res;
+    md5_res.Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+                pkt->data.frame.sz);
+    md5_.push_back(md5_res.Get());
+  }
+
+  // Encodes the clip and returns the average encode time per frame after the
+  // warm up, in microseconds.
+  int64_t Encode(int cpu_used, unsigned int budget) {
+    ::libvpx_test::I420VideoSource video("hantro_collage_w352h288.yuv", 352,
+                                         288, 30, 1, 0, kFrames);
+    cpu_used_ = cpu_used;
+    budget_ = budget;
+    EXPECT_NO_FATAL_FAILURE(RunLoop(&video));
+    EXPECT_GT(timed_frames_, 0);
+    return timed_frames_ > 0 ? total_time_ / timed_frames_ : 0;
+  }
+
+  int cpu_used_;
+  unsigned int budget_;
+  int frame_;
+  int timed_frames_;
+  int64_t total_time_;
+  vpx_usec_timer timer_;
+  std::vector<std::string> md5_;
+};
+
+TEST_F(FrameTimeBudgetTest, SpeedFollowsBudget) {
+  Encode(5, 0);
+  const std::vector<std::string> speed5_md5 = md5_;
+  Encode(9, 0);
+  const std::vector<std::string> speed9_md5 = md5_;
+  ASSERT_EQ(static_cast<size_t>(kFrames), speed5_md5.size());
+
+  // A budget no frame can exceed leaves the speed alone.
+  Encode(5, 1000000000);
+  EXPECT_EQ(speed5_md5, md5_);
+
+  // A budget no frame can meet raises the speed, but not past the maximum.
+  Encode(5, 1);
+  EXPECT_NE(speed5_md5, md5_);
+  Encode(9, 1);
+  EXPECT_EQ(speed9_md5, md5_);
+}
+
+// Depends on the wall clock, so it is only run on demand.
+TEST_F(FrameTimeBudgetTest, DISABLED_DeadlineMet) {
+  const int64_t slow_time = Encode(5, 0);
+  const int64_t fast_time = Encode(9, 0);
+  ASSERT_GT(slow_time, 0);
+  ASSERT_LT(fast_time, slow_time);
+
+  // A budget between the slowest and the fastest speed can only be met by
+  // raising the speed.
+  const unsigned int budget =
+      static_cast<unsigned int>((slow_time + fast_time) / 2);
+  const int64_t budget_time = Encode(5, budget);
+
+  // Allow some slack for timing noise.
+  EXPECT_LE(budget_time, budget + budget / 4)
+      << "speed 5: " << slow_time << " us, speed 9: " << fast_time << " us";
+  EXPECT_LT(budget_time, slow_time);
+}
+
+}  // namespace
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/y4m_video_source.h"
+
+namespace {
+
+const int kFrames = 8;
+
+// The pyramid motion field is searched by the encoder workers when there are
+// several, so the bitstream must not depend on the number of threads.
+class PyramidMeThreadTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+ protected:
+  PyramidMeThreadTest()
+      : EncoderTest(GET_PARAM(0)), mode_(GET_PARAM(1)),
+        threads_(GET_PARAM(2)), row_mt_(0) {}
+  ~PyramidMeThreadTest() override {}
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(mode_);
+    if (mode_ == ::libvpx_test::kRealTime) {
+      cfg_.g_lag_in_frames = 0;
+      cfg_.rc_end_usage = VPX_CBR;
+    } else {
+      cfg_.rc_end_usage = VPX_VBR;
+    }
+    cfg_.rc_target_bitrate = 1000;
+  }
+
+  void BeginPassHook(unsigned int /*pass*/) override { md5_.clear(); }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      const int cpu_used = mode_ == ::libvpx_test::kRealTime ? 7 : 4;
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, 2);
+      encoder->Control(VP9E_SET_ROW_MT, row_mt_);
+      encoder->Control(VP9E_SET_PYRAMID_ME, 1);
+    }
+  }
+
+  void FramePktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    ::libvpx_test::MD5 md5_res;
+    md5_res.Add(static_cast<const uint8_t *>(pkt->data.frame.buf),
+                pkt->data.frame.sz);
+    md5_.push_back(md5_res.Get());
+  }
+
+  void Encode(int threads, std::vector<std::string> *md5) {
+    ::libvpx_test::Y4mVideoSource video("niklas_1280_720_30.y4m", 0, kFrames);
+    cfg_.g_threads = threads;
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+    *md5 = md5_;
+  }
+
+  ::libvpx_test::TestMode mode_;
+  int threads_;
+  int row_mt_;
+  std::vector<std::string> md5_;
+};
+
+TEST_P(PyramidMeThreadTest, BitExact) {
+  // Without row_mt the output matches the single threaded one.
+  row_mt_ = 0;
+  std::vector<std::string> single_thr_md5;
+  ASSERT_NO_FATAL_FAILURE(Encode(1, &single_thr_md5));
+  ASSERT_EQ(static_cast<size_t>(kFrames), single_thr_md5.size());
+  std::vector<std::string> multi_thr_md5;
+  ASSERT_NO_FATAL_FAILURE(Encode(threads_, &multi_thr_md5));
+  EXPECT_EQ(single_thr_md5, multi_thr_md5);
+
+  // With row_mt on it only matches for more than one thread.
+  row_mt_ = 1;
+  std::vector<std::string> row_mt_two_thr_md5;
+  ASSERT_NO_FATAL_FAILURE(Encode(2, &row_mt_two_thr_md5));
+  std::vector<std::string> row_mt_multi_thr_md5;
+  ASSERT_NO_FATAL_FAILURE(Encode(threads_, &row_mt_multi_thr_md5));
+  EXPECT_EQ(row_mt_two_thr_md5, row_mt_multi_thr_md5);
+}
+
+VP9_INSTANTIATE_TEST_SUITE(PyramidMeThreadTest,
+                           ::testing::Values(::libvpx_test::kRealTime,
+                                             ::libvpx_test::kOnePassGood),
+                           ::testing::Values(4));
+
+}  // namespace
@@ -11,18 +11,22 @@
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
+#include <tuple>
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vp9_rtcd.h"
 #include "./vpx_config.h"
 #include "./vpx_scale_rtcd.h"
+#include "test/acm_random.h"
 #include "test/clear_system_state.h"
 #include "test/register_state_check.h"
 #include "test/vpx_scale_test.h"
+#include "vp9/encoder/vp9_resize.h"
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/yv12config.h"
+#include "vpx_util/vpx_thread.h"
 
 namespace libvpx_test {
 
@@ -212,4 +216,204 @@ INSTANTIATE_TEST_SUITE_P(NEON, ScaleTest,
                          ::testing::Values(vp9_scale_and_extend_frame_neon));
 #endif  // HAVE_NEON
 
+// The kernels of the non-normative resizer, vp9_resize_plane().
+const int kResizeTaps = 8;
+const int kResizePhases = 32;
+const int kResizeMaxWidth = 67;
+
+typedef void (*ResizeHorzFunc)(const uint8_t *src, uint8_t *dst, int w,
+                               int64_t pos, int64_t step,
+                               const int16_t *filters);
+typedef void (*ResizeVertFunc)(const uint8_t *const *src, uint8_t *dst, int w,
+                               const int16_t *filter);
+typedef std::tuple<ResizeHorzFunc, ResizeVertFunc> ResizeKernelParam;
+
+// Random filters, including ones with too much gain to check the clamping.
+static void RandomResizeFilters(ACMRandom *rnd, int16_t *filters) {
+  for (int i = 0; i < kResizePhases * kResizeTaps; ++i) {
+    filters[i] = static_cast<int16_t>(rnd->Rand8() - 64);
+  }
+}
+
+class ResizeKernelTest : public ::testing::TestWithParam<ResizeKernelParam> {
+ protected:
+  ResizeKernelTest() : rnd_(ACMRandom::DeterministicSeed()) {}
+
+  ACMRandom rnd_;
+};
+
+TEST_P(ResizeKernelTest, HorzMatchesC) {
+  const ResizeHorzFunc horz = std::get<0>(GetParam());
+  // Room for a step of up to 2 pels per output and the taps.
+  uint8_t src[2 * kResizeMaxWidth + kResizeTaps];
+  uint8_t ref[kResizeMaxWidth], dst[kResizeMaxWidth];
+  int16_t filters[kResizePhases * kResizeTaps];
+  for (int i = 0; i < 1000; ++i) {
+    const int w = 1 + rnd_(kResizeMaxWidth);
+    const int64_t step = (static_cast<int64_t>(rnd_.Rand16()) << 16) * 3 / 2 +
+                         (static_cast<int64_t>(1) << 31);
+    // The first taps start 3 pels before the position.
+    const int64_t pos = (static_cast<int64_t>(3) << 32) + rnd_.Rand16();
+    for (size_t j = 0; j < sizeof(src); ++j) src[j] = rnd_.Rand8();
+    RandomResizeFilters(&rnd_, filters);
+    vp9_resize_horz_8tap_c(src, ref, w, pos, step, filters);
+    ASM_REGISTER_STATE_CHECK(horz(src, dst, w, pos, step, filters));
+    ASSERT_EQ(memcmp(ref, dst, w), 0) << "w: " << w << " step: " << step;
+  }
+}
+
+TEST_P(ResizeKernelTest, VertMatchesC) {
+  const ResizeVertFunc vert = std::get<1>(GetParam());
+  uint8_t src[kResizeTaps][kResizeMaxWidth];
+  const uint8_t *rows[kResizeTaps];
+  uint8_t ref[kResizeMaxWidth], dst[kResizeMaxWidth];
+  int16_t filters[kResizePhases * kResizeTaps];
+  for (int i = 0; i < 1000; ++i) {
+    const int w = 1 + rnd_(kResizeMaxWidth);
+    for (int k = 0; k < kResizeTaps; ++k) {
+      for (int j = 0; j < kResizeMaxWidth; ++j) src[k][j] = rnd_.Rand8();
+      // Rows repeat at the plane edges.
+      rows[k] = src[rnd_(kResizeTaps)];
+    }
+    RandomResizeFilters(&rnd_, filters);
+    vp9_resize_vert_8tap_c(rows, ref, w, filters);
+    ASM_REGISTER_STATE_CHECK(vert(rows, dst, w, filters));
+    ASSERT_EQ(memcmp(ref, dst, w), 0) << "w: " << w;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(C, ResizeKernelTest,
+                         ::testing::Values(ResizeKernelParam(
+                             vp9_resize_horz_8tap_c, vp9_resize_vert_8tap_c)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, ResizeKernelTest,
+    ::testing::Values(ResizeKernelParam(vp9_resize_horz_8tap_sse2,
+                                        vp9_resize_vert_8tap_sse2)));
+#endif  // HAVE_SSE2
+
+#if CONFIG_VP9_HIGHBITDEPTH
+typedef void (*HighbdResizeHorzFunc)(const uint16_t *src, uint16_t *dst,
+                                     int w, int64_t pos, int64_t step,
+                                     const int16_t *filters, int bd);
+typedef void (*HighbdResizeVertFunc)(const uint16_t *const *src,
+                                     uint16_t *dst, int w,
+                                     const int16_t *filter, int bd);
+typedef std::tuple<HighbdResizeHorzFunc, HighbdResizeVertFunc, int>
+    HighbdResizeKernelParam;
+
+class HighbdResizeKernelTest
+    : public ::testing::TestWithParam<HighbdResizeKernelParam> {
+ protected:
+  HighbdResizeKernelTest() : rnd_(ACMRandom::DeterministicSeed()) {}
+
+  uint16_t RandPixel() {
+    const int bd = std::get<2>(GetParam());
+    return rnd_.Rand16() & ((1 << bd) - 1);
+  }
+
+  ACMRandom rnd_;
+};
+
+TEST_P(HighbdResizeKernelTest, HorzMatchesC) {
+  const HighbdResizeHorzFunc horz = std::get<0>(GetParam());
+  const int bd = std::get<2>(GetParam());
+  uint16_t src[2 * kResizeMaxWidth + kResizeTaps];
+  uint16_t ref[kResizeMaxWidth], dst[kResizeMaxWidth];
+  int16_t filters[kResizePhases * kResizeTaps];
+  for (int i = 0; i < 1000; ++i) {
+    const int w = 1 + rnd_(kResizeMaxWidth);
+    const int64_t step = (static_cast<int64_t>(rnd_.Rand16()) << 16) * 3 / 2 +
+                         (static_cast<int64_t>(1) << 31);
+    const int64_t pos = (static_cast<int64_t>(3) << 32) + rnd_.Rand16();
+    for (size_t j = 0; j < sizeof(src) / sizeof(src[0]); ++j) {
+      src[j] = RandPixel();
+    }
+    RandomResizeFilters(&rnd_, filters);
+    vp9_highbd_resize_horz_8tap_c(src, ref, w, pos, step, filters, bd);
+    ASM_REGISTER_STATE_CHECK(horz(src, dst, w, pos, step, filters, bd));
+    ASSERT_EQ(memcmp(ref, dst, w * sizeof(dst[0])), 0)
+        << "w: " << w << " step: " << step;
+  }
+}
+
+TEST_P(HighbdResizeKernelTest, VertMatchesC) {
+  const HighbdResizeVertFunc vert = std::get<1>(GetParam());
+  const int bd = std::get<2>(GetParam());
+  uint16_t src[kResizeTaps][kResizeMaxWidth];
+  const uint16_t *rows[kResizeTaps];
+  uint16_t ref[kResizeMaxWidth], dst[kResizeMaxWidth];
+  int16_t filters[kResizePhases * kResizeTaps];
+  for (int i = 0; i < 1000; ++i) {
+    const int w = 1 + rnd_(kResizeMaxWidth);
+    for (int k = 0; k < kResizeTaps; ++k) {
+      for (int j = 0; j < kResizeMaxWidth; ++j) src[k][j] = RandPixel();
+      rows[k] = src[rnd_(kResizeTaps)];
+    }
+    RandomResizeFilters(&rnd_, filters);
+    vp9_highbd_resize_vert_8tap_c(rows, ref, w, filters, bd);
+    ASM_REGISTER_STATE_CHECK(vert(rows, dst, w, filters, bd));
+    ASSERT_EQ(memcmp(ref, dst, w * sizeof(dst[0])), 0) << "w: " << w;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    C, HighbdResizeKernelTest,
+    ::testing::Values(
+        HighbdResizeKernelParam(vp9_highbd_resize_horz_8tap_c,
+                                vp9_highbd_resize_vert_8tap_c, 10),
+        HighbdResizeKernelParam(vp9_highbd_resize_horz_8tap_c,
+                                vp9_highbd_resize_vert_8tap_c, 12)));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, HighbdResizeKernelTest,
+    ::testing::Values(
+        HighbdResizeKernelParam(vp9_highbd_resize_horz_8tap_sse2,
+                                vp9_highbd_resize_vert_8tap_sse2, 10),
+        HighbdResizeKernelParam(vp9_highbd_resize_horz_8tap_sse2,
+                                vp9_highbd_resize_vert_8tap_sse2, 12)));
+#endif  // HAVE_SSE2
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+TEST(ResizePlaneTest, WorkersMatchSingleThread) {
+  static const int kNumWorkers = 4;
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  VPxWorker workers[kNumWorkers];
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  for (int i = 0; i < kNumWorkers; ++i) {
+    winterface->init(&workers[i]);
+    ASSERT_NE(winterface->reset(&workers[i]), 0);
+  }
+
+  // Odd sizes, factors of 2 and 3/4, and upscaling.
+  static const int kSizes[][4] = {
+    { 352, 288, 176, 144 }, { 352, 288, 264, 216 }, { 321, 203, 97, 61 },
+    { 640, 360, 480, 270 }, { 96, 64, 192, 128 },   { 48, 130, 40, 33 },
+  };
+  for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+    const int width = kSizes[s][0], height = kSizes[s][1];
+    const int width2 = kSizes[s][2], height2 = kSizes[s][3];
+    uint8_t *const src = new uint8_t[width * height];
+    uint8_t *const ref = new uint8_t[width2 * height2];
+    uint8_t *const dst = new uint8_t[width2 * height2];
+    for (int i = 0; i < width * height; ++i) src[i] = rnd.Rand8();
+    vp9_resize_plane(src, height, width, width, ref, height2, width2, width2);
+    for (int num_workers = 1; num_workers <= kNumWorkers; ++num_workers) {
+      memset(dst, 0, width2 * height2);
+      vp9_resize_plane_mt(src, height, width, width, dst, height2, width2,
+                          width2, workers, num_workers);
+      EXPECT_EQ(memcmp(ref, dst, width2 * height2), 0)
+          << width << "x" << height << " -> " << width2 << "x" << height2
+          << " with " << num_workers << " workers";
+    }
+    delete[] src;
+    delete[] ref;
+    delete[] dst;
+  }
+
+  for (int i = 0; i < kNumWorkers; ++i) winterface->end(&workers[i]);
+}
+
 }  // namespace libvpx_test
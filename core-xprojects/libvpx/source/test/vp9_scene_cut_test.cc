@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/i420_video_source.h"
+#include "test/util.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+const unsigned int kSceneCutFrame = 30;
+const int kFrames = 60;
+
+// Inverts the frames from kSceneCutFrame on, so the cut does not depend on
+// the content of the clip.
+class SceneCutVideoSource : public ::libvpx_test::I420VideoSource {
+ public:
+  explicit SceneCutVideoSource(int limit)
+      : I420VideoSource("hantro_collage_w352h288.yuv", 352, 288, 30, 1, 0,
+                        limit) {}
+
+  void FillFrame() override {
+    I420VideoSource::FillFrame();
+    if (frame_ < kSceneCutFrame) return;
+    for (size_t i = 0; i < raw_size_; ++i)
+      img_->img_data[i] = 255 - img_->img_data[i];
+  }
+};
+
+class SceneCutKeyFrameTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<int, int> {
+ protected:
+  SceneCutKeyFrameTest()
+      : EncoderTest(GET_PARAM(0)), cpu_used_(GET_PARAM(1)),
+        content_(GET_PARAM(2)), scene_cut_key_frame_(0) {}
+  ~SceneCutKeyFrameTest() override {}
+
+  void SetUp() override {
+    InitializeConfig();
+    SetMode(::libvpx_test::kRealTime);
+    cfg_.g_lag_in_frames = 0;
+    cfg_.rc_end_usage = VPX_CBR;
+    cfg_.rc_target_bitrate = 500;
+    cfg_.rc_buf_sz = 1000;
+    cfg_.rc_buf_initial_sz = 500;
+    cfg_.rc_buf_optimal_sz = 600;
+    cfg_.kf_max_dist = 9999;
+  }
+
+  void BeginPassHook(unsigned int /*pass*/) override {
+    key_frames_.clear();
+    frame_sizes_.clear();
+  }
+
+  void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                          ::libvpx_test::Encoder *encoder) override {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, cpu_used_);
+      encoder->Control(VP9E_SET_TUNE_CONTENT, content_);
+      encoder->Control(VP9E_SET_SCENE_CUT_KEY_FRAME, scene_cut_key_frame_);
+    }
+  }
+
+  void FramePktHook(const vpx_codec_cx_pkt_t *pkt) override {
+    if (pkt->data.frame.flags & VPX_FRAME_IS_KEY)
+      key_frames_.push_back(pkt->data.frame.pts);
+    frame_sizes_.push_back(pkt->data.frame.sz);
+  }
+
+  void Encode(int scene_cut_key_frame) {
+    SceneCutVideoSource video(kFrames);
+    scene_cut_key_frame_ = scene_cut_key_frame;
+    ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  }
+
+  int cpu_used_;
+  int content_;
+  int scene_cut_key_frame_;
+  std::vector<vpx_codec_pts_t> key_frames_;
+  std::vector<size_t> frame_sizes_;
+};
+
+TEST_P(SceneCutKeyFrameTest, KeyFrameAtSceneCut) {
+  ASSERT_NO_FATAL_FAILURE(Encode(0));
+  ASSERT_EQ(1u, key_frames_.size());
+
+  ASSERT_NO_FATAL_FAILURE(Encode(1));
+  ASSERT_EQ(2u, key_frames_.size());
+  EXPECT_EQ(0, key_frames_[0]);
+  EXPECT_EQ(kSceneCutFrame, key_frames_[1]);
+
+  // The key frame at the cut is coded at key frame size, well above the
+  // inter frame before it.
+  ASSERT_EQ(static_cast<size_t>(kFrames), frame_sizes_.size());
+  EXPECT_GT(frame_sizes_[kSceneCutFrame],
+            2 * frame_sizes_[kSceneCutFrame - 1]);
+}
+
+TEST_P(SceneCutKeyFrameTest, NoKeyFrameWithoutSceneCut) {
+  // Only use the frames before the scene cut.
+  SceneCutVideoSource video(kSceneCutFrame);
+  scene_cut_key_frame_ = 1;
+  ASSERT_NO_FATAL_FAILURE(RunLoop(&video));
+  EXPECT_EQ(1u, key_frames_.size());
+}
+
+TEST(SceneCutKeyFrameControlTest, RejectsInvalidValue) {
+  vpx_codec_iface_t *const iface = vpx_codec_vp9_cx();
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_enc_config_default(iface, &cfg, 0));
+  ASSERT_EQ(VPX_CODEC_OK, vpx_codec_enc_init(&enc, iface, &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&enc, VP9E_SET_SCENE_CUT_KEY_FRAME, 1));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&enc, VP9E_SET_SCENE_CUT_KEY_FRAME, 2));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+}
+
+VP9_INSTANTIATE_TEST_SUITE(SceneCutKeyFrameTest, ::testing::Range(5, 10),
+                           ::testing::Values(VP9E_CONTENT_DEFAULT,
+                                             VP9E_CONTENT_SCREEN));
+
+}  // namespace
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/md5_helper.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+const int kWidth = 176;
+const int kHeight = 144;
+const int kNumFrames = 24;
+
+// Odd frames refresh no reference buffer, so VP9D_SET_SKIP_NON_REF_FRAMES
+// may skip their reconstruction.
+bool IsNonRefFrame(int frame) { return frame & 1; }
+
+// Encodes a pattern moving by a couple of pixels per frame, so the stream
+// carries real motion vectors from one frame to the next.
+std::vector<std::string> EncodeFrames() {
+  std::vector<std::string> frames;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  vpx_image_t img;
+
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0));
+  cfg.g_w = kWidth;
+  cfg.g_h = kHeight;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_target_bitrate = 400;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, vpx_codec_vp9_cx(), &cfg, 0));
+  EXPECT_NE(vpx_img_alloc(&img, VPX_IMG_FMT_I420, kWidth, kHeight, 1),
+            nullptr);
+
+  for (int i = 0; i <= kNumFrames; ++i) {
+    const vpx_image_t *const raw = i < kNumFrames ? &img : nullptr;
+    const vpx_enc_frame_flags_t flags =
+        (i < kNumFrames && IsNonRefFrame(i))
+            ? VP8_EFLAG_NO_UPD_LAST | VP8_EFLAG_NO_UPD_GF | VP8_EFLAG_NO_UPD_ARF
+            : 0;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane ? (kWidth + 1) >> 1 : kWidth;
+      const int h = plane ? (kHeight + 1) >> 1 : kHeight;
+      const int shift = plane ? i : 2 * i;
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          const int u = x + shift;
+          img.planes[plane][y * img.stride[plane] + x] =
+              static_cast<uint8_t>(((u >> 3) ^ (y >> 3)) & 1 ? 200 - y : u);
+        }
+      }
+    }
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_encode(&enc, raw, i, 1, flags, VPX_DL_REALTIME));
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t *pkt;
+    while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != nullptr) {
+      if (pkt->kind != VPX_CODEC_CX_FRAME_PKT) continue;
+      frames.push_back(std::string(
+          static_cast<const char *>(pkt->data.frame.buf), pkt->data.frame.sz));
+    }
+  }
+
+  vpx_img_free(&img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  return frames;
+}
+
+class SkipNonRefTest : public ::testing::TestWithParam<int> {
+ protected:
+  void SetUp() override {
+    frames_ = EncodeFrames();
+    ASSERT_EQ(kNumFrames, static_cast<int>(frames_.size()));
+  }
+
+  // Decodes all frames. Frames before |target| are decoded with
+  // VP9D_SET_SKIP_NON_REF_FRAMES enabled. Returns the MD5 of each frame, or
+  // an empty string when no image was output.
+  std::vector<std::string> Decode(int target) {
+    std::vector<std::string> md5s;
+    vpx_codec_dec_cfg_t cfg = vpx_codec_dec_cfg_t();
+    vpx_codec_ctx_t dec;
+    cfg.threads = GetParam();
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_dec_init(&dec, vpx_codec_vp9_dx(), &cfg, 0));
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&dec, VP9D_SET_ROW_MT, cfg.threads > 1));
+
+    for (int i = 0; i < kNumFrames; ++i) {
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_control(&dec, VP9D_SET_SKIP_NON_REF_FRAMES,
+                                  i < target));
+      EXPECT_EQ(VPX_CODEC_OK,
+                vpx_codec_decode(
+                    &dec, reinterpret_cast<const uint8_t *>(frames_[i].data()),
+                    static_cast<unsigned int>(frames_[i].size()), nullptr, 0));
+      vpx_codec_iter_t iter = nullptr;
+      const vpx_image_t *const img = vpx_codec_get_frame(&dec, &iter);
+      if (img == nullptr) {
+        md5s.push_back(std::string());
+        continue;
+      }
+      libvpx_test::MD5 md5;
+      md5.Add(img);
+      md5s.push_back(md5.Get());
+    }
+
+    EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&dec));
+    return md5s;
+  }
+
+  std::vector<std::string> frames_;
+};
+
+TEST_P(SkipNonRefTest, SkipsOnlyNonRefFrames) {
+  const std::vector<std::string> ref = Decode(0);
+  const std::vector<std::string> skipped = Decode(kNumFrames);
+  for (int i = 0; i < kNumFrames; ++i) {
+    ASSERT_FALSE(ref[i].empty()) << "frame " << i;
+    if (IsNonRefFrame(i)) {
+      EXPECT_TRUE(skipped[i].empty()) << "frame " << i;
+    } else {
+      EXPECT_EQ(ref[i], skipped[i]) << "frame " << i;
+    }
+  }
+}
+
+TEST_P(SkipNonRefTest, DecodeToTarget) {
+  const std::vector<std::string> ref = Decode(0);
+  for (int target = 1; target < kNumFrames; target += 5) {
+    const std::vector<std::string> seek = Decode(target);
+    for (int i = target; i < kNumFrames; ++i) {
+      EXPECT_EQ(ref[i], seek[i]) << "target " << target << " frame " << i;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(VP9, SkipNonRefTest, ::testing::Values(1, 2));
+
+}  // namespace
@@ -225,6 +225,50 @@ vpxenc_vp8_ivf_piped_input() {
   fi
 }
 
+# Live WebM output never seeks, so it can be written to a pipe.
+vpxenc_vp8_webm_live_piped_output() {
+  if [ "$(vpxenc_can_encode_vp8)" = "yes" ] && \
+     [ "$(webm_io_available)" = "yes" ]; then
+    local encoder="$(vpx_tool_path vpxenc)"
+    local output="${VPX_TEST_OUTPUT_DIR}/vp8_live_piped_output.webm"
+    eval "${VPX_TEST_PREFIX}" "${encoder}" $(yuv_input_hantro_collage) \
+      --codec=vp8 \
+      --limit="${TEST_FRAMES}" \
+      --kf-max-dist=3 \
+      --test-decode=fatal \
+      --quiet \
+      --webm-live \
+      --output=- | cat > "${output}" || return 1
+
+    if [ ! -s "${output}" ]; then
+      elog "Output file is empty."
+      return 1
+    fi
+
+    # The piped stream must decode to the same frames as a file written with
+    # the same settings.
+    if [ "$(vp8_decode_available)" = "yes" ]; then
+      local file_output="${VPX_TEST_OUTPUT_DIR}/vp8_live_file_output.webm"
+      vpxenc $(yuv_input_hantro_collage) \
+        --codec=vp8 \
+        --limit="${TEST_FRAMES}" \
+        --kf-max-dist=3 \
+        --webm-live \
+        --output="${file_output}" || return 1
+
+      local decoder="$(vpx_tool_path vpxdec)"
+      local piped_md5="$(eval "${VPX_TEST_PREFIX}" "${decoder}" --md5 \
+        "${output}")"
+      local file_md5="$(eval "${VPX_TEST_PREFIX}" "${decoder}" --md5 \
+        "${file_output}")"
+      if [ -z "${piped_md5}" ] || [ "${piped_md5}" != "${file_md5}" ]; then
+        elog "Piped output decodes to ${piped_md5}, expected ${file_md5}."
+        return 1
+      fi
+    fi
+  fi
+}
+
 vpxenc_vp9_ivf() {
   if [ "$(vpxenc_can_encode_vp9)" = "yes" ]; then
     local output="${VPX_TEST_OUTPUT_DIR}/vp9.ivf"
@@ -468,6 +512,7 @@ vpxenc_tests="vpxenc_vp8_ivf
               vpxenc_vp8_webm
               vpxenc_vp8_webm_rt
               vpxenc_vp8_ivf_piped_input
+              vpxenc_vp8_webm_live_piped_output
               vpxenc_vp9_ivf
               vpxenc_vp9_webm
               vpxenc_vp9_webm_rt
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "../tools_common.h"
+#include "../webmdec.h"
+#include "test/video_source.h"
+
+namespace {
+
+struct WebmFrame {
+  uint64_t timestamp_ns;
+  int is_key_frame;
+  std::vector<uint8_t> data;
+};
+
+const char *const kWebmTestVectors[] = {
+  "vp90-2-00-quantizer-00.webm",
+  "vp90-2-07-frame_parallel-1.webm",
+  "vp90-2-14-resize-fp-tiles-1-2.webm",
+};
+
+class WebmDecTest : public ::testing::TestWithParam<const char *> {
+ protected:
+  void SetUp() override {
+    memset(&vpx_ctx_, 0, sizeof(vpx_ctx_));
+    memset(&webm_ctx_, 0, sizeof(webm_ctx_));
+    vpx_ctx_.file = libvpx_test::OpenTestDataFile(GetParam());
+    ASSERT_NE(vpx_ctx_.file, nullptr) << "Failed to open " << GetParam();
+    ASSERT_EQ(file_is_webm(&webm_ctx_, &vpx_ctx_), 1);
+  }
+
+  void TearDown() override {
+    webm_free(&webm_ctx_);
+    if (vpx_ctx_.file != nullptr) fclose(vpx_ctx_.file);
+  }
+
+  // Reads every frame in order, loading the clusters as they are reached.
+  void ReadAll(std::vector<WebmFrame> *frames) {
+    uint8_t *buffer = nullptr;
+    size_t buffer_size = 0;
+    int status;
+    while ((status = webm_read_frame(&webm_ctx_, &buffer, &buffer_size)) ==
+           0) {
+      WebmFrame frame;
+      frame.timestamp_ns = webm_ctx_.timestamp_ns;
+      frame.is_key_frame = webm_ctx_.is_key_frame;
+      frame.data.assign(buffer, buffer + buffer_size);
+      frames->push_back(frame);
+    }
+    ASSERT_EQ(status, 1);
+  }
+
+  VpxInputContext vpx_ctx_;
+  WebmInputContext webm_ctx_;
+};
+
+// The frame webm_seek_to_keyframe() should land on for |timestamp_ns|.
+int ExpectedKeyframe(const std::vector<WebmFrame> &frames,
+                     uint64_t timestamp_ns) {
+  int key = -1;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    if (frames[i].timestamp_ns > timestamp_ns) break;
+    if (frames[i].is_key_frame) key = static_cast<int>(i);
+  }
+  return key;
+}
+
+TEST_P(WebmDecTest, SeekAfterReadingEverything) {
+  std::vector<WebmFrame> frames;
+  ASSERT_NO_FATAL_FAILURE(ReadAll(&frames));
+  ASSERT_FALSE(frames.empty());
+  ASSERT_TRUE(frames[0].is_key_frame);
+
+  // Walk backwards so every seek goes against the direction of reading.
+  for (int i = static_cast<int>(frames.size()) - 1; i >= 0; --i) {
+    const int key = ExpectedKeyframe(frames, frames[i].timestamp_ns);
+    ASSERT_EQ(webm_seek_to_keyframe(&webm_ctx_, frames[i].timestamp_ns), 0);
+    uint8_t *buffer = nullptr;
+    size_t buffer_size = 0;
+    ASSERT_EQ(webm_read_frame(&webm_ctx_, &buffer, &buffer_size), 0);
+    EXPECT_EQ(webm_ctx_.timestamp_ns, frames[key].timestamp_ns);
+    ASSERT_EQ(std::vector<uint8_t>(buffer, buffer + buffer_size),
+              frames[key].data);
+  }
+}
+
+TEST_P(WebmDecTest, ReadKeyframes) {
+  std::vector<WebmFrame> frames;
+  ASSERT_NO_FATAL_FAILURE(ReadAll(&frames));
+
+  // Every frame time, a time between frames and one past the end.
+  std::vector<uint64_t> timestamps;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    timestamps.push_back(frames[i].timestamp_ns);
+    timestamps.push_back(frames[i].timestamp_ns + 1);
+  }
+  timestamps.push_back(frames.back().timestamp_ns + 1000000000);
+  const int count = static_cast<int>(timestamps.size());
+
+  const std::string filename =
+      libvpx_test::GetDataPath() + "/" + std::string(GetParam());
+  for (int threads = 1; threads <= 4; ++threads) {
+    SCOPED_TRACE(threads);
+    std::vector<uint8_t *> data(count);
+    std::vector<size_t> sizes(count);
+    ASSERT_EQ(webm_read_keyframes(filename.c_str(), &timestamps[0], count,
+                                  threads, &data[0], &sizes[0]),
+              0);
+    for (int i = 0; i < count; ++i) {
+      const int key = ExpectedKeyframe(frames, timestamps[i]);
+      ASSERT_NE(data[i], nullptr);
+      EXPECT_EQ(std::vector<uint8_t>(data[i], data[i] + sizes[i]),
+                frames[key].data);
+      free(data[i]);
+    }
+  }
+}
+
+TEST(WebmDecMissingFileTest, ReadKeyframesFails) {
+  const uint64_t timestamp_ns = 0;
+  uint8_t *data = reinterpret_cast<uint8_t *>(&data);
+  size_t size = 1;
+  EXPECT_EQ(webm_read_keyframes("no-such-file.webm", &timestamp_ns, 1, 2,
+                                &data, &size),
+            -1);
+  EXPECT_EQ(data, nullptr);
+  EXPECT_EQ(size, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(WebmDec, WebmDecTest,
+                         ::testing::ValuesIn(kWebmTestVectors));
+
+}  // namespace
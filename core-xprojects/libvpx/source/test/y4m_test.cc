@@ -9,11 +9,14 @@
  */
 
 #include <string>
+#include <tuple>
 
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
 #include "./y4menc.h"
+#include "./y4minput.h"
+#include "test/acm_random.h"
 #include "test/md5_helper.h"
 #include "test/util.h"
 #include "test/y4m_video_source.h"
@@ -239,4 +242,156 @@ TEST(Y4MHeaderTest, LongHeader) {
   y4m_input_close(&y4m);
 }
 
+// The row kernels must match the C versions exactly, including the clamping.
+typedef std::tuple<y4m_filter_v_func, y4m_filter_h_func, y4m_filter_h_func>
+    Y4mFilterParam;
+
+const int kFilterMaxWidth = 100;
+// Border needed around the row for the taps.
+const int kFilterBorder = 4;
+
+class Y4mFilterTest : public ::testing::TestWithParam<Y4mFilterParam> {
+ protected:
+  void FillRandom(unsigned char *buf, int size, bool extremes) {
+    for (int i = 0; i < size; ++i) {
+      buf[i] = extremes ? rnd_.Rand8Extremes() : rnd_.Rand8();
+    }
+  }
+
+  libvpx_test::ACMRandom rnd_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Y4mFilterTest);
+
+TEST_P(Y4mFilterTest, MatchesC) {
+  const int stride = kFilterMaxWidth + 2 * kFilterBorder;
+  const int src_size = 2 * stride * (2 * kFilterBorder + 1);
+  unsigned char src[src_size];
+  unsigned char ref[kFilterMaxWidth];
+  unsigned char dst[kFilterMaxWidth];
+  const unsigned char *const row = src + kFilterBorder * stride + kFilterBorder;
+  for (int i = 0; i < 200; ++i) {
+    const int w = 1 + i % kFilterMaxWidth;
+    FillRandom(src, src_size, i % 2 == 0);
+
+    y4m_422jpeg_420jpeg_row_c(ref, row, stride, w);
+    std::get<0>(GetParam())(dst, row, stride, w);
+    ASSERT_EQ(0, memcmp(ref, dst, w)) << "vertical, w=" << w;
+
+    y4m_42xmpeg2_42xjpeg_row_c(ref, row, w);
+    std::get<1>(GetParam())(dst, row, w);
+    ASSERT_EQ(0, memcmp(ref, dst, w)) << "mpeg2 horizontal, w=" << w;
+
+    // Each output of the 444 decimation takes two input samples.
+    y4m_444_420jpeg_row_c(ref, row, w / 2);
+    std::get<2>(GetParam())(dst, row, w / 2);
+    ASSERT_EQ(0, memcmp(ref, dst, w / 2)) << "444 horizontal, w=" << w;
+  }
+}
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_SUITE_P(
+    SSE2, Y4mFilterTest,
+    ::testing::Values(Y4mFilterParam(y4m_422jpeg_420jpeg_row_sse2,
+                                     y4m_42xmpeg2_42xjpeg_row_sse2,
+                                     y4m_444_420jpeg_row_sse2)));
+#endif
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Y4mFilterTest,
+    ::testing::Values(Y4mFilterParam(y4m_422jpeg_420jpeg_row_avx2,
+                                     y4m_42xmpeg2_42xjpeg_row_avx2,
+                                     y4m_444_420jpeg_row_avx2)));
+#endif
+
+// Converts synthetic files of the 8-bit chroma types to 420 and checks that
+// the row kernels and the read ahead thread do not change the output.
+struct Y4mConvertParam {
+  const char *chroma_type;
+  int dec_h;
+  int dec_v;
+  int width;
+  int height;
+};
+
+const Y4mConvertParam kY4mConvertParams[] = {
+  { "420jpeg", 2, 2, 37, 21 },
+  { "420paldv", 2, 2, 37, 21 },  { "420paldv", 2, 2, 97, 35 },
+  { "420mpeg2", 2, 2, 37, 21 },  { "420mpeg2", 2, 2, 97, 35 },
+  { "422jpeg", 2, 1, 37, 21 },   { "422jpeg", 2, 1, 97, 35 },
+  { "422", 2, 1, 37, 21 },       { "422", 2, 1, 97, 35 },
+  { "444", 1, 1, 37, 21 },       { "444", 1, 1, 97, 35 },
+};
+
+const int kConvertFrames = 7;
+
+class Y4mConvertTest : public ::testing::TestWithParam<Y4mConvertParam> {
+ protected:
+  void SetUp() override {
+    const Y4mConvertParam &p = GetParam();
+    const int c_w = (p.width + p.dec_h - 1) / p.dec_h;
+    const int c_h = (p.height + p.dec_v - 1) / p.dec_v;
+    const int frame_size = p.width * p.height + 2 * c_w * c_h;
+    libvpx_test::ACMRandom rnd;
+    file_ = new libvpx_test::TempOutFile;
+    ASSERT_NE(file_->file(), nullptr);
+    fprintf(file_->file(), "YUV4MPEG2 W%d H%d F30:1 Ip C%s\n", p.width,
+            p.height, p.chroma_type);
+    for (int i = 0; i < kConvertFrames; ++i) {
+      fputs("FRAME\n", file_->file());
+      for (int j = 0; j < frame_size; ++j) {
+        fputc(i == 0 ? rnd.Rand8Extremes() : rnd.Rand8(), file_->file());
+      }
+    }
+    fflush(file_->file());
+  }
+
+  void TearDown() override { delete file_; }
+
+  // Returns the MD5 of the converted frames.
+  std::string ReadFrames(bool c_only, bool read_ahead) {
+    y4m_input y4m;
+    vpx_image_t img;
+    libvpx_test::MD5 md5;
+    int frames = 0;
+    EXPECT_EQ(0, fseek(file_->file(), 0, SEEK_SET));
+    if (y4m_input_open(&y4m, file_->file(), /*skip_buffer=*/NULL,
+                       /*num_skip=*/0, /*only_420=*/1) != 0) {
+      ADD_FAILURE() << "Failed to open " << GetParam().chroma_type;
+      return "";
+    }
+    EXPECT_EQ(VPX_IMG_FMT_I420, y4m.vpx_fmt);
+    if (c_only) {
+      y4m.filter_422jpeg_420jpeg = y4m_422jpeg_420jpeg_row_c;
+      y4m.filter_42xmpeg2_42xjpeg = y4m_42xmpeg2_42xjpeg_row_c;
+      y4m.filter_444_420jpeg = y4m_444_420jpeg_row_c;
+    }
+    if (read_ahead) {
+#if CONFIG_MULTITHREAD
+      EXPECT_EQ(0, y4m_input_start_read_ahead(&y4m, file_->file(), 3));
+#else
+      EXPECT_EQ(-1, y4m_input_start_read_ahead(&y4m, file_->file(), 3));
+#endif
+    }
+    while (y4m_input_fetch_frame(&y4m, file_->file(), &img) > 0) {
+      md5.Add(&img);
+      ++frames;
+    }
+    EXPECT_EQ(kConvertFrames, frames);
+    y4m_input_close(&y4m);
+    return md5.Get();
+  }
+
+  libvpx_test::TempOutFile *file_;
+};
+
+TEST_P(Y4mConvertTest, MatchesC) {
+  const std::string c_md5 = ReadFrames(/*c_only=*/true, /*read_ahead=*/false);
+  EXPECT_EQ(c_md5, ReadFrames(/*c_only=*/false, /*read_ahead=*/false));
+  EXPECT_EQ(c_md5, ReadFrames(/*c_only=*/false, /*read_ahead=*/true));
+}
+
+INSTANTIATE_TEST_SUITE_P(C, Y4mConvertTest,
+                         ::testing::ValuesIn(kY4mConvertParams));
+
 }  // namespace
@@ -8,9 +8,14 @@
 ##  be found in the AUTHORS file in the root of the source tree.
 ##
 
+Y4MINPUT_SRCS-yes += y4minput.c y4minput.h vpx_ports/x86.h
+Y4MINPUT_SRCS-yes += vpx_util/vpx_thread.h
+Y4MINPUT_SRCS-$(HAVE_SSE2) += y4minput_sse2.c
+Y4MINPUT_SRCS-$(HAVE_AVX2) += y4minput_avx2.c
+
 # List of tools to build.
 TOOLS-yes            += tiny_ssim.c
-tiny_ssim.SRCS       += vpx/vpx_integer.h y4minput.c y4minput.h \
+tiny_ssim.SRCS       += vpx/vpx_integer.h $(Y4MINPUT_SRCS-yes) \
                         vpx/vpx_codec.h vpx/src/vpx_image.c
 tiny_ssim.SRCS       += vpx_mem/vpx_mem.c vpx_mem/vpx_mem.h
 tiny_ssim.SRCS       += vpx_dsp/ssim.h vpx_scale/yv12config.h
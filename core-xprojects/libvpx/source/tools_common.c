@@ -341,6 +341,9 @@ void open_input_file(struct VpxInputContext *input) {
       input->framerate.denominator = input->y4m.fps_d;
       input->fmt = input->y4m.vpx_fmt;
       input->bit_depth = input->y4m.bit_depth;
+      /* Read and convert the next frames while the current one is encoded.
+       * This is only an optimization, so failing to start it is fine. */
+      y4m_input_start_read_ahead(&input->y4m, input->file, 4);
     } else {
       fatal("Unsupported Y4M stream.");
     }
@@ -352,8 +355,9 @@ void open_input_file(struct VpxInputContext *input) {
 }
 
 void close_input_file(struct VpxInputContext *input) {
-  fclose(input->file);
+  // Stop the Y4M read ahead thread before closing the file it reads from.
   if (input->file_type == FILE_TYPE_Y4M) y4m_input_close(&input->y4m);
+  fclose(input->file);
 }
 #endif
 
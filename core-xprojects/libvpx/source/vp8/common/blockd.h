@@ -19,6 +19,7 @@ void vpx_log(const char *format, ...);
 #include "mv.h"
 #include "treecoder.h"
 #include "vpx_ports/mem.h"
+#include "vpx_util/vpx_atomics.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -167,11 +168,34 @@ typedef struct {
   int dissim; /* dissimilarity level of the macroblock */
 } LOWER_RES_MB_INFO;
 
-/* The frame-level information needed to be stored for higher-resolution
- *  encoder */
+/* Maximum number of resolutions in a multi-resolution encoder. */
+#define MAX_MR_RESOLUTIONS 16
+
+/* The information one resolution stores for the next higher resolution.
+ * Each resolution writes its own copy, so that the encoders can run
+ * concurrently, the higher resolution working on the rows the lower one
+ * has already published.
+ */
 typedef struct {
   FRAME_TYPE frame_type;
   int is_frame_dropped;
+  /* The frame number of each reference frames */
+  unsigned int low_res_ref_frames[MAX_REF_FRAMES];
+  // Flag to signal skipped encoding of this stream.
+  unsigned int skip_encoding_prev_stream;
+  LOWER_RES_MB_INFO *mb_info;
+  // Progress through the current frame: the frame-level fields above are
+  // valid, the number of macroblock rows of mb_info written, and the frame
+  // is complete (all fields valid), along with its encode status.
+  vpx_atomic_int frame_info_ready;
+  vpx_atomic_int rows_ready;
+  vpx_atomic_int frame_done;
+  vpx_codec_err_t status;
+} LOWER_RES_LEVEL_INFO;
+
+/* The frame-level information needed to be stored for higher-resolution
+ *  encoder */
+typedef struct {
   // If frame is dropped due to overshoot after encode_frame. This triggers a
   // drop and resets rate control with Q forced to max for following frame.
   // The check for this dropping due to overshoot is only done on lowest stream,
@@ -179,14 +203,14 @@ typedef struct {
   int is_frame_dropped_overshoot_maxqp;
   // The frame rate for the lowest resolution.
   double low_res_framerate;
-  /* The frame number of each reference frames */
-  unsigned int low_res_ref_frames[MAX_REF_FRAMES];
   // The video frame counter value for the key frame, for lowest resolution.
   unsigned int key_frame_counter_value;
-  // Flags to signal skipped encoding of previous and base layer stream.
-  unsigned int skip_encoding_prev_stream;
+  // Flag to signal skipped encoding of base layer stream.
   unsigned int skip_encoding_base_stream;
-  LOWER_RES_MB_INFO *mb_info;
+  // Number of entries in the mb_info of each level.
+  unsigned int mb_info_size;
+  // Indexed by mr_encoder_id.
+  LOWER_RES_LEVEL_INFO level_info[MAX_MR_RESOLUTIONS];
 } LOWER_RES_FRAME_INFO;
 #endif
 
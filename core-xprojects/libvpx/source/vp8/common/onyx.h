@@ -113,6 +113,10 @@ typedef struct {
   /* percent of rate boost for golden frame in CBR mode. */
   unsigned int gf_cbr_boost_pct;
   unsigned int screen_content_mode;
+  /* Choose Q from a size model and re-quantize at most once rather than
+   * recode (VP8E_SET_RECODE_FREE_RC).
+   */
+  unsigned int recode_free_rc;
 
   /* mode ->
    *(0)=Realtime/Live Encoding. This mode is optimized for realtim
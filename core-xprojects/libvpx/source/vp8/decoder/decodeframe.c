@@ -105,7 +105,7 @@ static void decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
     vp8_reset_mb_tokens_context(xd);
   } else if (!vp8dx_bool_error(xd->current_bc)) {
     int eobtotal;
-    eobtotal = vp8_decode_mb_tokens(pbi, xd);
+    eobtotal = vp8_decode_mb_tokens(pbi, xd, xd->qcoeff, xd->eobs);
 
     /* Special case:  Force the loopfilter to skip when eobtotal is zero */
     xd->mode_info_context->mbmi.mb_skip_coeff = (eobtotal == 0);
@@ -804,10 +804,8 @@ static void setup_token_decoder(VP8D_COMP *pbi,
   }
 
 #if CONFIG_MULTITHREAD
-  /* Clamp number of decoder threads */
-  if (pbi->decoding_thread_count > num_token_partitions - 1) {
-    pbi->decoding_thread_count = num_token_partitions - 1;
-  }
+  /* Clamp number of decoder threads. Token partitions are parsed ahead of
+   * reconstruction, so the threads are not limited by the partition count. */
   if ((int)pbi->decoding_thread_count > pbi->common.mb_rows - 1) {
     assert(pbi->common.mb_rows > 0);
     pbi->decoding_thread_count = pbi->common.mb_rows - 1;
@@ -1215,8 +1213,7 @@ int vp8_decode_frame(VP8D_COMP *pbi) {
   pbi->frame_corrupt_residual = 0;
 
 #if CONFIG_MULTITHREAD
-  if (vpx_atomic_load_acquire(&pbi->b_multithreaded_rd) &&
-      pc->multi_token_partition != ONE_PARTITION) {
+  if (vpx_atomic_load_acquire(&pbi->b_multithreaded_rd)) {
     unsigned int thread;
     if (vp8mt_decode_mb_rows(pbi, xd)) {
       vp8_decoder_remove_threads(pbi);
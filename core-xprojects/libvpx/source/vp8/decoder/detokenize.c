@@ -139,10 +139,10 @@ static int GetCoeffs(BOOL_DECODER *br, ProbaArray prob, int ctx, int n,
   }
 }
 
-int vp8_decode_mb_tokens(VP8D_COMP *dx, MACROBLOCKD *x) {
+int vp8_decode_mb_tokens(VP8D_COMP *dx, MACROBLOCKD *x, short *qcoeff,
+                         char *eobs) {
   BOOL_DECODER *bc = x->current_bc;
   const FRAME_CONTEXT *const fc = &dx->common.fc;
-  char *eobs = x->eobs;
 
   int i;
   int nonzeros;
@@ -156,7 +156,7 @@ int vp8_decode_mb_tokens(VP8D_COMP *dx, MACROBLOCKD *x) {
   ENTROPY_CONTEXT *l;
   int skip_dc = 0;
 
-  qcoeff_ptr = &x->qcoeff[0];
+  qcoeff_ptr = qcoeff;
 
   if (!x->mode_info_context->mbmi.is_4x4) {
     a = a_ctx + 8;
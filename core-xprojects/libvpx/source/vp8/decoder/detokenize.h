@@ -18,7 +18,8 @@ extern "C" {
 #endif
 
 void vp8_reset_mb_tokens_context(MACROBLOCKD *x);
-int vp8_decode_mb_tokens(VP8D_COMP *, MACROBLOCKD *);
+int vp8_decode_mb_tokens(VP8D_COMP *, MACROBLOCKD *, short *qcoeff,
+                         char *eobs);
 
 #ifdef __cplusplus
 }  // extern "C"
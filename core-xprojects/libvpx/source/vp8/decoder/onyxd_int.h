@@ -35,6 +35,15 @@ typedef struct {
   MACROBLOCKD mbd;
 } MB_ROW_DEC;
 
+/* Coefficients of one macroblock, parsed ahead of its reconstruction. */
+typedef struct {
+  DECLARE_ALIGNED(16, short, qcoeff[25 * 16]);
+  char eobs[25];
+  /* Bool decoder error state before and after reading this MB's tokens. */
+  char bc_error_before;
+  char bc_error;
+} MB_TOKEN_DATA;
+
 typedef struct {
   int enabled;
   unsigned int count;
@@ -80,6 +89,9 @@ typedef struct VP8D_COMP {
   int sync_range;
   /* Each row remembers its already decoded column. */
   vpx_atomic_int *mt_current_mb_col;
+  /* Each row remembers its already parsed column. */
+  vpx_atomic_int *mt_parsed_mb_col;
+  MB_TOKEN_DATA *mt_tokens; /* mb_rows x mb_cols */
 
   unsigned char **mt_yabove_row; /* mb_rows x width */
   unsigned char **mt_uabove_row;
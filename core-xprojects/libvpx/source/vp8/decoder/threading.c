@@ -79,29 +79,106 @@ static void setup_decoding_thread_data(VP8D_COMP *pbi, MACROBLOCKD *xd,
     if (pc->full_pixel) mbd->fullpixel_mask = 0xfffffff8;
   }
 
-  for (i = 0; i < pc->mb_rows; ++i)
+  for (i = 0; i < pc->mb_rows; ++i) {
     vpx_atomic_store_release(&pbi->mt_current_mb_col[i], -1);
+    vpx_atomic_store_release(&pbi->mt_parsed_mb_col[i], -1);
+  }
 }
 
-static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
-                                 unsigned int mb_idx) {
-  MB_PREDICTION_MODE mode;
-  int i;
-#if CONFIG_ERROR_CONCEALMENT
-  int corruption_detected = 0;
-#else
-  (void)mb_idx;
-#endif
+static void mt_parse_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
+                                MB_TOKEN_DATA *tokens) {
+  tokens->bc_error_before = vp8dx_bool_error(xd->current_bc);
 
   if (xd->mode_info_context->mbmi.mb_skip_coeff) {
     vp8_reset_mb_tokens_context(xd);
-  } else if (!vp8dx_bool_error(xd->current_bc)) {
+  } else if (!tokens->bc_error_before) {
     int eobtotal;
-    eobtotal = vp8_decode_mb_tokens(pbi, xd);
+    eobtotal = vp8_decode_mb_tokens(pbi, xd, tokens->qcoeff, tokens->eobs);
 
     /* Special case:  Force the loopfilter to skip when eobtotal is zero */
     xd->mode_info_context->mbmi.mb_skip_coeff = (eobtotal == 0);
+  } else {
+    /* eobs are left over from the previous frame */
+    memset(tokens->eobs, 0, 25);
+  }
+
+  tokens->bc_error = vp8dx_bool_error(xd->current_bc);
+}
+
+/* Entropy decodes the token partitions into pbi->mt_tokens. Every partition
+ * is owned by a single thread, which walks its rows in order. Rows only depend
+ * on the above entropy context of the previous row, so parsing runs as a light
+ * wavefront of its own, ahead of the reconstruction in mt_decode_mb_rows().
+ */
+static void mt_parse_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd, int ithread) {
+  VP8_COMMON *pc = &pbi->common;
+  const int nsync = pbi->sync_range;
+  const vpx_atomic_int first_row_no_sync_above =
+      VPX_ATOMIC_INIT(pc->mb_cols + nsync);
+  const int num_part = 1 << pc->multi_token_partition;
+  const int num_threads = (int)pbi->decoding_thread_count + 1;
+  int mb_row;
+
+  for (mb_row = 0; mb_row < pc->mb_rows; ++mb_row) {
+    const vpx_atomic_int *last_row_parsed_mb_col;
+    vpx_atomic_int *parsed_mb_col;
+    MB_TOKEN_DATA *tokens;
+    int mb_col;
+
+    /* Hand the partitions to the threads reconstructing the bottom rows of
+     * each group, so the top rows can be reconstructed while parsing. */
+    if (num_threads - 1 - (mb_row % num_part) % num_threads != ithread) {
+      continue;
+    }
+
+    /* select bool coder for current partition */
+    xd->current_bc = &pbi->mbc[mb_row % num_part];
+
+    if (mb_row > 0) {
+      last_row_parsed_mb_col = &pbi->mt_parsed_mb_col[mb_row - 1];
+    } else {
+      last_row_parsed_mb_col = &first_row_no_sync_above;
+    }
+
+    parsed_mb_col = &pbi->mt_parsed_mb_col[mb_row];
+    tokens = pbi->mt_tokens + mb_row * pc->mb_cols;
+
+    xd->mode_info_context = pc->mi + pc->mode_info_stride * mb_row;
+
+    /* reset contexts */
+    xd->above_context = pc->above_context;
+    memset(xd->left_context, 0, sizeof(ENTROPY_CONTEXT_PLANES));
+
+    for (mb_col = 0; mb_col < pc->mb_cols; ++mb_col) {
+      if (((mb_col - 1) % nsync) == 0) {
+        vpx_atomic_store_release(parsed_mb_col, mb_col - 1);
+      }
+
+      if (mb_row && !(mb_col & (nsync - 1))) {
+        vp8_atomic_spin_wait(mb_col, last_row_parsed_mb_col, nsync);
+      }
+
+      mt_parse_macroblock(pbi, xd, &tokens[mb_col]);
+
+      ++xd->mode_info_context; /* next mb */
+      xd->above_context++;
+    }
+
+    vpx_atomic_store_release(parsed_mb_col, mb_col + nsync);
   }
+}
+
+static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
+                                 MB_TOKEN_DATA *tokens, unsigned int mb_idx) {
+  short *const qcoeff = tokens->qcoeff;
+  char *const eobs = tokens->eobs;
+  MB_PREDICTION_MODE mode;
+  int i;
+#if CONFIG_ERROR_CONCEALMENT
+  int corruption_detected = 0;
+#else
+  (void)mb_idx;
+#endif
 
   mode = xd->mode_info_context->mbmi.mode;
 
@@ -116,21 +193,21 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
      */
     throw_residual =
         (!pbi->independent_partitions && pbi->frame_corrupt_residual);
-    throw_residual = (throw_residual || vp8dx_bool_error(xd->current_bc));
+    throw_residual = (throw_residual || tokens->bc_error);
 
     if ((mb_idx >= pbi->mvs_corrupt_from_mb || throw_residual)) {
       /* MB with corrupt residuals or corrupt mode/motion vectors.
        * Better to use the predictor as reconstruction.
        */
       pbi->frame_corrupt_residual = 1;
-      memset(xd->qcoeff, 0, sizeof(xd->qcoeff));
+      memset(qcoeff, 0, sizeof(tokens->qcoeff));
 
       corruption_detected = 1;
 
       /* force idct to be skipped for B_PRED and use the
        * prediction only for reconstruction
        * */
-      memset(xd->eobs, 0, 25);
+      memset(eobs, 0, 25);
     }
   }
 #endif
@@ -151,12 +228,13 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
       int dst_stride = xd->dst.y_stride;
 
       /* clear out residual eob info */
-      if (xd->mode_info_context->mbmi.mb_skip_coeff) memset(xd->eobs, 0, 25);
+      if (xd->mode_info_context->mbmi.mb_skip_coeff) memset(eobs, 0, 25);
 
       intra_prediction_down_copy(xd, xd->recon_above[0] + 16);
 
       for (i = 0; i < 16; ++i) {
         BLOCKD *b = &xd->block[i];
+        short *b_qcoeff = qcoeff + i * 16;
         unsigned char *dst = xd->dst.y_buffer + b->offset;
         B_PREDICTION_MODE b_mode = xd->mode_info_context->bmi[i].as_mode;
         unsigned char *Above;
@@ -189,13 +267,13 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
         vp8_intra4x4_predict(Above, yleft, left_stride, b_mode, dst, dst_stride,
                              top_left);
 
-        if (xd->eobs[i]) {
-          if (xd->eobs[i] > 1) {
-            vp8_dequant_idct_add(b->qcoeff, DQC, dst, dst_stride);
+        if (eobs[i]) {
+          if (eobs[i] > 1) {
+            vp8_dequant_idct_add(b_qcoeff, DQC, dst, dst_stride);
           } else {
-            vp8_dc_only_idct_add(b->qcoeff[0] * DQC[0], dst, dst_stride, dst,
+            vp8_dc_only_idct_add(b_qcoeff[0] * DQC[0], dst, dst_stride, dst,
                                  dst_stride);
-            memset(b->qcoeff, 0, 2 * sizeof(b->qcoeff[0]));
+            memset(b_qcoeff, 0, 2 * sizeof(b_qcoeff[0]));
           }
         }
       }
@@ -216,18 +294,20 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
       short *DQC = xd->dequant_y1;
 
       if (mode != SPLITMV) {
-        BLOCKD *b = &xd->block[24];
+        /* the y2 block reads its coefficients from the parsed tokens */
+        BLOCKD b = xd->block[24];
+        b.qcoeff = qcoeff + 24 * 16;
 
         /* do 2nd order transform on the dc block */
-        if (xd->eobs[24] > 1) {
-          vp8_dequantize_b(b, xd->dequant_y2);
+        if (eobs[24] > 1) {
+          vp8_dequantize_b(&b, xd->dequant_y2);
 
-          vp8_short_inv_walsh4x4(&b->dqcoeff[0], xd->qcoeff);
-          memset(b->qcoeff, 0, 16 * sizeof(b->qcoeff[0]));
+          vp8_short_inv_walsh4x4(&b.dqcoeff[0], qcoeff);
+          memset(b.qcoeff, 0, 16 * sizeof(b.qcoeff[0]));
         } else {
-          b->dqcoeff[0] = b->qcoeff[0] * xd->dequant_y2[0];
-          vp8_short_inv_walsh4x4_1(&b->dqcoeff[0], xd->qcoeff);
-          memset(b->qcoeff, 0, 2 * sizeof(b->qcoeff[0]));
+          b.dqcoeff[0] = b.qcoeff[0] * xd->dequant_y2[0];
+          vp8_short_inv_walsh4x4_1(&b.dqcoeff[0], qcoeff);
+          memset(b.qcoeff, 0, 2 * sizeof(b.qcoeff[0]));
         }
 
         /* override the dc dequant constant in order to preserve the
@@ -236,13 +316,13 @@ static void mt_decode_macroblock(VP8D_COMP *pbi, MACROBLOCKD *xd,
         DQC = xd->dequant_y1_dc;
       }
 
-      vp8_dequant_idct_add_y_block(xd->qcoeff, DQC, xd->dst.y_buffer,
-                                   xd->dst.y_stride, xd->eobs);
+      vp8_dequant_idct_add_y_block(qcoeff, DQC, xd->dst.y_buffer,
+                                   xd->dst.y_stride, eobs);
     }
 
-    vp8_dequant_idct_add_uv_block(xd->qcoeff + 16 * 16, xd->dequant_uv,
+    vp8_dequant_idct_add_uv_block(qcoeff + 16 * 16, xd->dequant_uv,
                                   xd->dst.u_buffer, xd->dst.v_buffer,
-                                  xd->dst.uv_stride, xd->eobs + 16);
+                                  xd->dst.uv_stride, eobs + 16);
   }
 }
 
@@ -250,12 +330,13 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
                               int start_mb_row) {
   const vpx_atomic_int *last_row_current_mb_col;
   vpx_atomic_int *current_mb_col;
+  const vpx_atomic_int *parsed_mb_col;
+  MB_TOKEN_DATA *tokens;
   int mb_row;
   VP8_COMMON *pc = &pbi->common;
   const int nsync = pbi->sync_range;
   const vpx_atomic_int first_row_no_sync_above =
       VPX_ATOMIC_INIT(pc->mb_cols + nsync);
-  int num_part = 1 << pbi->common.multi_token_partition;
   int last_mb_row = start_mb_row;
 
   YV12_BUFFER_CONFIG *yv12_fb_new = pbi->dec_fb_ref[INTRA_FRAME];
@@ -285,6 +366,10 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
   dst_buffer[1] = yv12_fb_new->u_buffer;
   dst_buffer[2] = yv12_fb_new->v_buffer;
 
+  /* Stage 1: entropy decode this thread's share of the token partitions. */
+  mt_parse_mb_rows(pbi, xd, start_mb_row);
+
+  /* Stage 2: reconstruct and loop filter this thread's rows. */
   xd->up_available = (start_mb_row != 0);
 
   xd->mode_info_context = pc->mi + pc->mode_info_stride * start_mb_row;
@@ -299,8 +384,6 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
 
     /* save last row processed by this thread */
     last_mb_row = mb_row;
-    /* select bool coder for current partition */
-    xd->current_bc = &pbi->mbc[mb_row % num_part];
 
     if (mb_row > 0) {
       last_row_current_mb_col = &pbi->mt_current_mb_col[mb_row - 1];
@@ -309,14 +392,12 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
     }
 
     current_mb_col = &pbi->mt_current_mb_col[mb_row];
+    parsed_mb_col = &pbi->mt_parsed_mb_col[mb_row];
+    tokens = pbi->mt_tokens + mb_row * pc->mb_cols;
 
     recon_yoffset = mb_row * recon_y_stride * 16;
     recon_uvoffset = mb_row * recon_uv_stride * 8;
 
-    /* reset contexts */
-    xd->above_context = pc->above_context;
-    memset(xd->left_context, 0, sizeof(ENTROPY_CONTEXT_PLANES));
-
     xd->left_available = 0;
 
     xd->mb_to_top_edge = -((mb_row * 16) << 3);
@@ -361,8 +442,11 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
         vpx_atomic_store_release(current_mb_col, mb_col - 1);
       }
 
-      if (mb_row && !(mb_col & (nsync - 1))) {
-        vp8_atomic_spin_wait(mb_col, last_row_current_mb_col, nsync);
+      if (!(mb_col & (nsync - 1))) {
+        if (mb_row) {
+          vp8_atomic_spin_wait(mb_col, last_row_current_mb_col, nsync);
+        }
+        vp8_atomic_spin_wait(mb_col, parsed_mb_col, nsync);
       }
 
       /* Distance of MB to the various image edges.
@@ -376,7 +460,7 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
       {
         int corrupt_residual =
             (!pbi->independent_partitions && pbi->frame_corrupt_residual) ||
-            vp8dx_bool_error(xd->current_bc);
+            tokens[mb_col].bc_error_before;
         if (pbi->ec_active &&
             (xd->mode_info_context->mbmi.ref_frame == INTRA_FRAME) &&
             corrupt_residual) {
@@ -426,12 +510,12 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
         xd->pre.u_buffer = 0;
         xd->pre.v_buffer = 0;
       }
-      mt_decode_macroblock(pbi, xd, 0);
+      mt_decode_macroblock(pbi, xd, &tokens[mb_col], 0);
 
       xd->left_available = 1;
 
       /* check if the boolean decoder has suffered an error */
-      xd->corrupted |= vp8dx_bool_error(xd->current_bc);
+      xd->corrupted |= tokens[mb_col].bc_error;
 
       xd->recon_above[0] += 16;
       xd->recon_above[1] += 8;
@@ -539,8 +623,6 @@ static void mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd,
       recon_uvoffset += 8;
 
       ++xd->mode_info_context; /* next mb */
-
-      xd->above_context++;
     }
 
     /* adjust to the next row of mbs */
@@ -673,6 +755,12 @@ void vp8mt_de_alloc_temp_buffers(VP8D_COMP *pbi, int mb_rows) {
   vpx_free(pbi->mt_current_mb_col);
   pbi->mt_current_mb_col = NULL;
 
+  vpx_free(pbi->mt_parsed_mb_col);
+  pbi->mt_parsed_mb_col = NULL;
+
+  vpx_free(pbi->mt_tokens);
+  pbi->mt_tokens = NULL;
+
   /* Free above_row buffers. */
   if (pbi->mt_yabove_row) {
     for (i = 0; i < mb_rows; ++i) {
@@ -759,6 +847,16 @@ void vp8mt_alloc_temp_buffers(VP8D_COMP *pbi, int width, int prev_mb_rows) {
     for (i = 0; i < pc->mb_rows; ++i)
       vpx_atomic_init(&pbi->mt_current_mb_col[i], 0);
 
+    CHECK_MEM_ERROR(pbi->mt_parsed_mb_col,
+                    vpx_malloc(sizeof(*pbi->mt_parsed_mb_col) * pc->mb_rows));
+    for (i = 0; i < pc->mb_rows; ++i)
+      vpx_atomic_init(&pbi->mt_parsed_mb_col[i], 0);
+
+    /* Allocate the parsed coefficients, one row of MB_TOKEN_DATA per mb row.
+     * Reconstruction clears the coefficients it consumes, so they only need
+     * to be zeroed here. */
+    CALLOC_ARRAY_ALIGNED(pbi->mt_tokens, pc->mb_rows * pc->mb_cols, 16);
+
     /* Allocate memory for above_row buffers. */
     CALLOC_ARRAY(pbi->mt_yabove_row, pc->mb_rows);
     for (i = 0; i < pc->mb_rows; ++i) {
@@ -842,6 +940,7 @@ int vp8mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd) {
   VP8_COMMON *pc = &pbi->common;
   unsigned int i;
   int j;
+  int corrupted;
 
   int filter_level = pc->filter_level;
   YV12_BUFFER_CONFIG *yv12_fb_new = pbi->dec_fb_ref[INTRA_FRAME];
@@ -901,5 +1000,16 @@ int vp8mt_decode_mb_rows(VP8D_COMP *pbi, MACROBLOCKD *xd) {
   for (i = 0; i < pbi->decoding_thread_count + 1; ++i)
     sem_wait(&pbi->h_event_end_decoding); /* add back for each frame */
 
+  /* A corrupt frame stops reconstruction early and leaves parsed coefficients
+   * behind. Clear them so that the next frame starts from zero. */
+  corrupted = xd->corrupted;
+  for (i = 0; i < pbi->decoding_thread_count; ++i) {
+    corrupted |= pbi->mb_row_di[i].mbd.corrupted;
+  }
+  if (corrupted) {
+    memset(pbi->mt_tokens, 0,
+           sizeof(*pbi->mt_tokens) * pc->mb_rows * pc->mb_cols);
+  }
+
   return 0;
 }
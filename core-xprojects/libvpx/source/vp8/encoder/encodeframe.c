@@ -37,6 +37,9 @@
 #include "bitstream.h"
 #endif
 #include "encodeframe.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "mr_dissim.h"
+#endif
 
 extern void vp8_stuff_mb(VP8_COMP *cpi, MACROBLOCK *x, TOKENEXTRA **t);
 static void adjust_act_zbin(VP8_COMP *cpi, MACROBLOCK *x);
@@ -608,8 +611,10 @@ static void init_encode_frame_mb_context(VP8_COMP *cpi) {
 
   vp8_build_block_offsets(x);
 
-  xd->mode_info_context->mbmi.mode = DC_PRED;
-  xd->mode_info_context->mbmi.uv_mode = DC_PRED;
+  if (!cpi->reuse_mb_modes) {
+    xd->mode_info_context->mbmi.mode = DC_PRED;
+    xd->mode_info_context->mbmi.uv_mode = DC_PRED;
+  }
 
   xd->left_context = &cm->left_context;
 
@@ -639,9 +644,17 @@ static void init_encode_frame_mb_context(VP8_COMP *cpi) {
 
   vp8_zero(x->coef_counts);
   vp8_zero(x->ymode_count);
-  vp8_zero(x->uv_mode_count) x->prediction_error = 0;
-  x->intra_error = 0;
+  vp8_zero(x->uv_mode_count);
   vp8_zero(x->count_mb_ref_frame_usage);
+
+  /* The errors and motion vector counts are those of the mode decision,
+   * which a re-quantization for the recode-free rate control keeps.
+   */
+  if (!cpi->reuse_mb_modes) {
+    x->prediction_error = 0;
+    x->intra_error = 0;
+    vp8_zero(x->MVcount);
+  }
 }
 
 #if CONFIG_MULTITHREAD
@@ -714,8 +727,6 @@ void vp8_encode_frame(VP8_COMP *cpi) {
 
   xd->mode_info_context = cm->mi;
 
-  vp8_zero(cpi->mb.MVcount);
-
   vp8cx_frame_init_quantizer(cpi);
 
   vp8_initialize_rd_consts(cpi, x,
@@ -866,6 +877,11 @@ void vp8_encode_frame(VP8_COMP *cpi) {
 
         encode_mb_row(cpi, cm, mb_row, x, xd, &tp, segment_counts, &totalrate);
 
+#if CONFIG_MULTI_RES_ENCODING
+        /* Hand the rows done so far to the next higher resolution. */
+        vp8_mr_row_encoded(cpi, mb_row);
+#endif
+
         /* adjust to the next row of mbs */
         x->src.y_buffer += 16 * x->src.y_stride - 16 * cm->mb_cols;
         x->src.u_buffer += 8 * x->src.uv_stride - 8 * cm->mb_cols;
@@ -1078,12 +1094,43 @@ static void adjust_act_zbin(VP8_COMP *cpi, MACROBLOCK *x) {
 #endif
 }
 
+/* Sets up the encode of an MB with the modes its first encode chose, for the
+ * recode-free rate control.
+ */
+static void reuse_mb_modes(VP8_COMP *cpi, MACROBLOCK *x) {
+  MACROBLOCKD *const xd = &x->e_mbd;
+
+  x->skip = cpi->mb_rc_stats[xd->mode_info_context - cpi->common.mi].skip;
+
+  /* The 4x4 intra coder reads the modes of the blocks, not the mode info. */
+  if (xd->mode_info_context->mbmi.mode == B_PRED) {
+    int i;
+    for (i = 0; i < 16; ++i) {
+      xd->block[i].bmi.as_mode = xd->mode_info_context->bmi[i].as_mode;
+    }
+  }
+}
+
+static void record_mb_rc_stats(VP8_COMP *cpi, MACROBLOCK *x,
+                               const TOKENEXTRA *start,
+                               const TOKENEXTRA *stop) {
+  MB_RC_STATS *const stats =
+      &cpi->mb_rc_stats[x->e_mbd.mode_info_context - cpi->common.mi];
+
+  stats->coef_cost = vp8_tokens_cost(start, stop);
+  stats->skip = x->skip;
+}
+
 int vp8cx_encode_intra_macroblock(VP8_COMP *cpi, MACROBLOCK *x,
                                   TOKENEXTRA **t) {
   MACROBLOCKD *xd = &x->e_mbd;
+  const TOKENEXTRA *const t_start = *t;
   int rate;
 
-  if (cpi->sf.RD && cpi->compressor_speed != 2) {
+  if (cpi->reuse_mb_modes) {
+    reuse_mb_modes(cpi, x);
+    rate = 0;
+  } else if (cpi->sf.RD && cpi->compressor_speed != 2) {
     vp8_rd_pick_intra_mode(x, &rate);
   } else {
     vp8_pick_intra_mode(x, &rate);
@@ -1106,6 +1153,8 @@ int vp8cx_encode_intra_macroblock(VP8_COMP *cpi, MACROBLOCK *x,
 
   vp8_tokenize_mb(cpi, x, t);
 
+  if (cpi->oxcf.recode_free_rc) record_mb_rc_stats(cpi, x, t_start, *t);
+
   if (xd->mode_info_context->mbmi.mode != B_PRED) vp8_inverse_transform_mby(xd);
 
   vp8_dequant_idct_add_uv_block(xd->qcoeff + 16 * 16, xd->dequant_uv,
@@ -1123,6 +1172,7 @@ int vp8cx_encode_inter_macroblock(VP8_COMP *cpi, MACROBLOCK *x, TOKENEXTRA **t,
                                   int recon_yoffset, int recon_uvoffset,
                                   int mb_row, int mb_col) {
   MACROBLOCKD *const xd = &x->e_mbd;
+  const TOKENEXTRA *const t_start = *t;
   int intra_error = 0;
   int rate;
   int distortion;
@@ -1145,7 +1195,11 @@ int vp8cx_encode_inter_macroblock(VP8_COMP *cpi, MACROBLOCK *x, TOKENEXTRA **t,
   x->need_to_clamp_best_mvs = 0;
 #endif
 
-  if (cpi->sf.RD) {
+  if (cpi->reuse_mb_modes) {
+    reuse_mb_modes(cpi, x);
+    rate = 0;
+    distortion = 0;
+  } else if (cpi->sf.RD) {
     int zbin_mode_boost_enabled = x->zbin_mode_boost_enabled;
 
     /* Are we using the fast quantizer for the mode selection? */
@@ -1290,5 +1344,7 @@ int vp8cx_encode_inter_macroblock(VP8_COMP *cpi, MACROBLOCK *x, TOKENEXTRA **t,
     }
   }
 
+  if (cpi->oxcf.recode_free_rc) record_mb_rc_stats(cpi, x, t_start, *t);
+
   return rate;
 }
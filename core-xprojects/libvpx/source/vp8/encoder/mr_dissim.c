@@ -16,6 +16,7 @@
 #include "vpx_mem/vpx_mem.h"
 #include "rdopt.h"
 #include "vp8/common/common.h"
+#include "vp8/common/threading.h"
 
 void vp8_cal_low_res_mb_cols(VP8_COMP *cpi) {
   int low_res_w;
@@ -47,22 +48,183 @@ void vp8_cal_low_res_mb_cols(VP8_COMP *cpi) {
     cnt++;                                              \
   }
 
-void vp8_cal_dissimilarity(VP8_COMP *cpi) {
+static LOWER_RES_LEVEL_INFO *get_level_info(const VP8_COMP *cpi, int id) {
+  return &((LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info)
+              ->level_info[id];
+}
+
+/* Returns 1 if this encoder stores information for a higher resolution. */
+static int stores_level_info(const VP8_COMP *cpi) {
+  return cpi->oxcf.mr_total_resolutions > 1 &&
+         cpi->oxcf.mr_encoder_id < (cpi->oxcf.mr_total_resolutions - 1);
+}
+
+#if CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD
+static void wait_for_progress(const vpx_atomic_int *progress, int value,
+                              const vpx_atomic_int *frame_done) {
+  while (vpx_atomic_load_acquire(progress) < value &&
+         !vpx_atomic_load_acquire(frame_done)) {
+    x86_pause_hint();
+    thread_sleep(0);
+  }
+}
+#endif
+
+/* Computes the dissimilarity of the macroblocks of mb_row and stores their
+ * mode info for the next resolution. Needs the mode info of the rows above
+ * and below.
+ */
+static void cal_dissimilarity_row(VP8_COMP *cpi, int mb_row) {
   VP8_COMMON *cm = &cpi->common;
-  int i;
+  const MODE_INFO *tmp = cm->mi + mb_row * cm->mode_info_stride;
+  LOWER_RES_MB_INFO *store_mode_info =
+      get_level_info(cpi, cpi->oxcf.mr_encoder_id)->mb_info +
+      mb_row * cm->mb_cols;
+  int mb_col;
 
-  /* Note: The first row & first column in mip are outside the frame, which
-   * were initialized to all 0.(ref_frame, mode, mv...)
-   * Their ref_frame = 0 means they won't be counted in the following
-   * calculation.
-   */
-  if (cpi->oxcf.mr_total_resolutions > 1 &&
-      cpi->oxcf.mr_encoder_id < (cpi->oxcf.mr_total_resolutions - 1)) {
+  for (mb_col = 0; mb_col < cm->mb_cols; ++mb_col) {
+    int dissim = INT_MAX;
+
+    if (tmp->mbmi.ref_frame != INTRA_FRAME) {
+      int mvx[8];
+      int mvy[8];
+      int mmvx;
+      int mmvy;
+      int cnt = 0;
+      const MODE_INFO *here = tmp;
+      const MODE_INFO *above = here - cm->mode_info_stride;
+      const MODE_INFO *left = here - 1;
+      const MODE_INFO *aboveleft = above - 1;
+      const MODE_INFO *aboveright = NULL;
+      const MODE_INFO *right = NULL;
+      const MODE_INFO *belowleft = NULL;
+      const MODE_INFO *below = NULL;
+      const MODE_INFO *belowright = NULL;
+
+      /* If alternate reference frame is used, we have to
+       * check sign of MV. */
+      if (cpi->oxcf.play_alternate) {
+        /* Gather mv of neighboring MBs */
+        GET_MV_SIGN(above)
+        GET_MV_SIGN(left)
+        GET_MV_SIGN(aboveleft)
+
+        if (mb_col < (cm->mb_cols - 1)) {
+          right = here + 1;
+          aboveright = above + 1;
+          GET_MV_SIGN(right)
+          GET_MV_SIGN(aboveright)
+        }
+
+        if (mb_row < (cm->mb_rows - 1)) {
+          below = here + cm->mode_info_stride;
+          belowleft = below - 1;
+          GET_MV_SIGN(below)
+          GET_MV_SIGN(belowleft)
+        }
+
+        if (mb_col < (cm->mb_cols - 1) && mb_row < (cm->mb_rows - 1)) {
+          belowright = below + 1;
+          GET_MV_SIGN(belowright)
+        }
+      } else {
+        /* No alt_ref and gather mv of neighboring MBs */
+        GET_MV(above)
+        GET_MV(left)
+        GET_MV(aboveleft)
+
+        if (mb_col < (cm->mb_cols - 1)) {
+          right = here + 1;
+          aboveright = above + 1;
+          GET_MV(right)
+          GET_MV(aboveright)
+        }
+
+        if (mb_row < (cm->mb_rows - 1)) {
+          below = here + cm->mode_info_stride;
+          belowleft = below - 1;
+          GET_MV(below)
+          GET_MV(belowleft)
+        }
+
+        if (mb_col < (cm->mb_cols - 1) && mb_row < (cm->mb_rows - 1)) {
+          belowright = below + 1;
+          GET_MV(belowright)
+        }
+      }
+
+      if (cnt > 0) {
+        int max_mvx = mvx[0];
+        int min_mvx = mvx[0];
+        int max_mvy = mvy[0];
+        int min_mvy = mvy[0];
+        int i;
+
+        if (cnt > 1) {
+          for (i = 1; i < cnt; ++i) {
+            if (mvx[i] > max_mvx)
+              max_mvx = mvx[i];
+            else if (mvx[i] < min_mvx)
+              min_mvx = mvx[i];
+            if (mvy[i] > max_mvy)
+              max_mvy = mvy[i];
+            else if (mvy[i] < min_mvy)
+              min_mvy = mvy[i];
+          }
+        }
+
+        mmvx = VPXMAX(abs(min_mvx - here->mbmi.mv.as_mv.row),
+                      abs(max_mvx - here->mbmi.mv.as_mv.row));
+        mmvy = VPXMAX(abs(min_mvy - here->mbmi.mv.as_mv.col),
+                      abs(max_mvy - here->mbmi.mv.as_mv.col));
+        dissim = VPXMAX(mmvx, mmvy);
+      }
+    }
+
+    /* Store mode info for next resolution encoding */
+    store_mode_info->mode = tmp->mbmi.mode;
+    store_mode_info->ref_frame = tmp->mbmi.ref_frame;
+    store_mode_info->mv.as_int = tmp->mbmi.mv.as_int;
+    store_mode_info->dissim = dissim;
+    tmp++;
+    store_mode_info++;
+  }
+}
+
+void vp8_mr_start_frame(VP8_COMP *cpi) {
+  if (cpi->oxcf.mr_total_resolutions > 1) {
+    LOWER_RES_LEVEL_INFO *const level =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id);
+
+    vpx_atomic_store_release(&level->frame_info_ready, 0);
+    vpx_atomic_store_release(&level->rows_ready, 0);
+    vpx_atomic_store_release(&level->frame_done, 0);
+    level->status = VPX_CODEC_OK;
+  }
+}
+
+void vp8_mr_finish_frame(VP8_COMP *cpi, vpx_codec_err_t status) {
+  if (cpi->oxcf.mr_total_resolutions > 1) {
+    LOWER_RES_LEVEL_INFO *const level =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id);
+
+    level->status = status;
+    vpx_atomic_store_release(&level->frame_done, 1);
+  }
+}
+
+void vp8_mr_store_frame_info(VP8_COMP *cpi) {
+  VP8_COMMON *cm = &cpi->common;
+
+  if (stores_level_info(cpi)) {
     /* Store info for show/no-show frames for supporting alt_ref.
      * If parent frame is alt_ref, child has one too.
      */
-    LOWER_RES_FRAME_INFO *store_info =
-        (LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info;
+    LOWER_RES_LEVEL_INFO *const store_info =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id);
+    int i;
+
+    if (vpx_atomic_load_acquire(&store_info->frame_info_ready)) return;
 
     store_info->frame_type = cm->frame_type;
 
@@ -70,127 +232,97 @@ void vp8_cal_dissimilarity(VP8_COMP *cpi) {
       store_info->is_frame_dropped = 0;
       for (i = 1; i < MAX_REF_FRAMES; ++i)
         store_info->low_res_ref_frames[i] = cpi->current_ref_frames[i];
+    } else {
+      /* No mode info is stored for key frames. */
+      vpx_atomic_store_release(&store_info->rows_ready, cm->mb_rows);
     }
+    vpx_atomic_store_release(&store_info->frame_info_ready, 1);
+  }
+}
+
+void vp8_mr_row_encoded(VP8_COMP *cpi, int mb_row) {
+  if (stores_level_info(cpi) && mb_row > 0 &&
+      cpi->common.frame_type != KEY_FRAME) {
+    LOWER_RES_LEVEL_INFO *const store_info =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id);
+
+    /* Rows are only handed out once the frame info is final. */
+    if (!vpx_atomic_load_acquire(&store_info->frame_info_ready)) return;
+
+    cal_dissimilarity_row(cpi, mb_row - 1);
+    vpx_atomic_store_release(&store_info->rows_ready, mb_row);
+  }
+}
+
+void vp8_cal_dissimilarity(VP8_COMP *cpi) {
+  VP8_COMMON *cm = &cpi->common;
+
+  /* Note: The first row & first column in mip are outside the frame, which
+   * were initialized to all 0.(ref_frame, mode, mv...)
+   * Their ref_frame = 0 means they won't be counted in the following
+   * calculation.
+   */
+  if (stores_level_info(cpi)) {
+    LOWER_RES_LEVEL_INFO *const store_info =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id);
+
+    vp8_mr_store_frame_info(cpi);
 
     if (cm->frame_type != KEY_FRAME) {
       int mb_row;
-      int mb_col;
-      /* Point to beginning of allocated MODE_INFO arrays. */
-      MODE_INFO *tmp = cm->mip + cm->mode_info_stride;
-      LOWER_RES_MB_INFO *store_mode_info = store_info->mb_info;
-
-      for (mb_row = 0; mb_row < cm->mb_rows; ++mb_row) {
-        tmp++;
-        for (mb_col = 0; mb_col < cm->mb_cols; ++mb_col) {
-          int dissim = INT_MAX;
-
-          if (tmp->mbmi.ref_frame != INTRA_FRAME) {
-            int mvx[8];
-            int mvy[8];
-            int mmvx;
-            int mmvy;
-            int cnt = 0;
-            const MODE_INFO *here = tmp;
-            const MODE_INFO *above = here - cm->mode_info_stride;
-            const MODE_INFO *left = here - 1;
-            const MODE_INFO *aboveleft = above - 1;
-            const MODE_INFO *aboveright = NULL;
-            const MODE_INFO *right = NULL;
-            const MODE_INFO *belowleft = NULL;
-            const MODE_INFO *below = NULL;
-            const MODE_INFO *belowright = NULL;
-
-            /* If alternate reference frame is used, we have to
-             * check sign of MV. */
-            if (cpi->oxcf.play_alternate) {
-              /* Gather mv of neighboring MBs */
-              GET_MV_SIGN(above)
-              GET_MV_SIGN(left)
-              GET_MV_SIGN(aboveleft)
-
-              if (mb_col < (cm->mb_cols - 1)) {
-                right = here + 1;
-                aboveright = above + 1;
-                GET_MV_SIGN(right)
-                GET_MV_SIGN(aboveright)
-              }
-
-              if (mb_row < (cm->mb_rows - 1)) {
-                below = here + cm->mode_info_stride;
-                belowleft = below - 1;
-                GET_MV_SIGN(below)
-                GET_MV_SIGN(belowleft)
-              }
-
-              if (mb_col < (cm->mb_cols - 1) && mb_row < (cm->mb_rows - 1)) {
-                belowright = below + 1;
-                GET_MV_SIGN(belowright)
-              }
-            } else {
-              /* No alt_ref and gather mv of neighboring MBs */
-              GET_MV(above)
-              GET_MV(left)
-              GET_MV(aboveleft)
-
-              if (mb_col < (cm->mb_cols - 1)) {
-                right = here + 1;
-                aboveright = above + 1;
-                GET_MV(right)
-                GET_MV(aboveright)
-              }
-
-              if (mb_row < (cm->mb_rows - 1)) {
-                below = here + cm->mode_info_stride;
-                belowleft = below - 1;
-                GET_MV(below)
-                GET_MV(belowleft)
-              }
-
-              if (mb_col < (cm->mb_cols - 1) && mb_row < (cm->mb_rows - 1)) {
-                belowright = below + 1;
-                GET_MV(belowright)
-              }
-            }
-
-            if (cnt > 0) {
-              int max_mvx = mvx[0];
-              int min_mvx = mvx[0];
-              int max_mvy = mvy[0];
-              int min_mvy = mvy[0];
-              int i;
-
-              if (cnt > 1) {
-                for (i = 1; i < cnt; ++i) {
-                  if (mvx[i] > max_mvx)
-                    max_mvx = mvx[i];
-                  else if (mvx[i] < min_mvx)
-                    min_mvx = mvx[i];
-                  if (mvy[i] > max_mvy)
-                    max_mvy = mvy[i];
-                  else if (mvy[i] < min_mvy)
-                    min_mvy = mvy[i];
-                }
-              }
-
-              mmvx = VPXMAX(abs(min_mvx - here->mbmi.mv.as_mv.row),
-                            abs(max_mvx - here->mbmi.mv.as_mv.row));
-              mmvy = VPXMAX(abs(min_mvy - here->mbmi.mv.as_mv.col),
-                            abs(max_mvy - here->mbmi.mv.as_mv.col));
-              dissim = VPXMAX(mmvx, mmvy);
-            }
-          }
 
-          /* Store mode info for next resolution encoding */
-          store_mode_info->mode = tmp->mbmi.mode;
-          store_mode_info->ref_frame = tmp->mbmi.ref_frame;
-          store_mode_info->mv.as_int = tmp->mbmi.mv.as_int;
-          store_mode_info->dissim = dissim;
-          tmp++;
-          store_mode_info++;
-        }
+      for (mb_row = vpx_atomic_load_acquire(&store_info->rows_ready);
+           mb_row < cm->mb_rows; ++mb_row) {
+        cal_dissimilarity_row(cpi, mb_row);
       }
+      vpx_atomic_store_release(&store_info->rows_ready, cm->mb_rows);
+    }
+  }
+}
+
+void vp8_mr_wait_frame_info(VP8_COMP *cpi) {
+#if CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD
+  if (cpi->oxcf.mr_encoder_id > 0) {
+    const LOWER_RES_LEVEL_INFO *const base = get_level_info(cpi, 0);
+    const LOWER_RES_LEVEL_INFO *const parent =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id - 1);
+
+    wait_for_progress(&base->frame_info_ready, 1, &base->frame_done);
+    wait_for_progress(&parent->frame_info_ready, 1, &parent->frame_done);
+  }
+#else
+  (void)cpi;
+#endif
+}
+
+void vp8_mr_wait_rows(VP8_COMP *cpi, int rows) {
+#if CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD
+  const LOWER_RES_LEVEL_INFO *const parent =
+      get_level_info(cpi, cpi->oxcf.mr_encoder_id - 1);
+
+  wait_for_progress(&parent->rows_ready, rows, &parent->frame_done);
+#else
+  (void)cpi;
+  (void)rows;
+#endif
+}
+
+vpx_codec_err_t vp8_mr_wait_lower_resolutions(VP8_COMP *cpi, int id) {
+  vpx_codec_err_t status = VPX_CODEC_OK;
+  int i;
+
+  for (i = 0; i < id; ++i) {
+    const LOWER_RES_LEVEL_INFO *const level = get_level_info(cpi, i);
+
+#if CONFIG_OS_SUPPORT && CONFIG_MULTITHREAD
+    while (!vpx_atomic_load_acquire(&level->frame_done)) {
+      x86_pause_hint();
+      thread_sleep(0);
     }
+#endif
+    if (status == VPX_CODEC_OK) status = level->status;
   }
+  return status;
 }
 
 /* This function is called only when this frame is dropped at current
@@ -205,11 +337,12 @@ void vp8_store_drop_frame_info(VP8_COMP *cpi) {
     /* Store info for show/no-show frames for supporting alt_ref.
      * If parent frame is alt_ref, child has one too.
      */
-    LOWER_RES_FRAME_INFO *store_info =
-        (LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info;
+    LOWER_RES_LEVEL_INFO *const store_info =
+        get_level_info(cpi, cpi->oxcf.mr_encoder_id);
 
     /* Set frame_type to be INTER_FRAME since we won't drop key frame. */
     store_info->frame_type = INTER_FRAME;
     store_info->is_frame_dropped = 1;
+    vpx_atomic_store_release(&store_info->frame_info_ready, 1);
   }
 }
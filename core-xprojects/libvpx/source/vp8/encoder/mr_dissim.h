@@ -20,6 +20,18 @@ extern void vp8_cal_low_res_mb_cols(VP8_COMP *cpi);
 extern void vp8_cal_dissimilarity(VP8_COMP *cpi);
 extern void vp8_store_drop_frame_info(VP8_COMP *cpi);
 
+/* Helpers for encoding the resolutions on separate threads. Each level
+ * publishes its frame info and its mode info row by row; a higher level
+ * waits on the progress of the level below it.
+ */
+extern void vp8_mr_start_frame(VP8_COMP *cpi);
+extern void vp8_mr_finish_frame(VP8_COMP *cpi, vpx_codec_err_t status);
+extern void vp8_mr_store_frame_info(VP8_COMP *cpi);
+extern void vp8_mr_row_encoded(VP8_COMP *cpi, int mb_row);
+extern void vp8_mr_wait_frame_info(VP8_COMP *cpi);
+extern void vp8_mr_wait_rows(VP8_COMP *cpi, int rows);
+extern vpx_codec_err_t vp8_mr_wait_lower_resolutions(VP8_COMP *cpi, int id);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -442,6 +442,9 @@ static void dealloc_compressor_data(VP8_COMP *cpi) {
   vpx_free(cpi->mb_activity_map);
   cpi->mb_activity_map = 0;
 
+  vpx_free(cpi->mb_rc_stats);
+  cpi->mb_rc_stats = NULL;
+
   vpx_free(cpi->mb.pip);
   cpi->mb.pip = 0;
 
@@ -1189,6 +1192,11 @@ void vp8_alloc_compressor_data(VP8_COMP *cpi) {
       cpi->mb_activity_map,
       vpx_calloc(sizeof(*cpi->mb_activity_map), cm->mb_rows * cm->mb_cols));
 
+  vpx_free(cpi->mb_rc_stats);
+  CHECK_MEM_ERROR(cpi->mb_rc_stats,
+                  vpx_calloc(sizeof(*cpi->mb_rc_stats),
+                             cm->mb_rows * cm->mode_info_stride));
+
   /* allocate memory for storing last frame's MVs for MV prediction. */
   vpx_free(cpi->lfmv);
   CHECK_MEM_ERROR(cpi->lfmv, vpx_calloc((cm->mb_rows + 2) * (cm->mb_cols + 2),
@@ -2813,7 +2821,46 @@ void write_cx_frame_to_file(YV12_BUFFER_CONFIG *frame, int this_frame)
 }
 #endif
 
+#if CONFIG_MULTI_RES_ENCODING
+/* Returns 1 if the recode loop of encode_frame_to_data_rate() may encode the
+ * frame more than once, or turn it into a key frame.
+ */
+static int mr_frame_may_recode(const VP8_COMP *cpi) {
+#if CONFIG_REALTIME_ONLY
+  (void)cpi;
+  return 0;
+#else
+  const VP8_COMMON *cm = &cpi->common;
+
+  if (cm->frame_type == KEY_FRAME)
+    return cpi->this_key_frame_forced || cpi->sf.recode_loop;
+  if (cpi->pass != 2 && cpi->oxcf.auto_key && cpi->compressor_speed != 2)
+    return 1;
+  return cpi->sf.recode_loop == 1 ||
+         (cpi->sf.recode_loop == 2 &&
+          (cm->refresh_golden_frame || cm->refresh_alt_ref_frame));
+#endif
+}
+#endif
+
 #if !CONFIG_REALTIME_ONLY
+/* Returns the bits of the coefficient tokens of the frame just encoded. */
+static int mb_rc_coef_bits(const VP8_COMP *cpi) {
+  const VP8_COMMON *const cm = &cpi->common;
+  int64_t cost = 0;
+  int mb_row, mb_col;
+
+  for (mb_row = 0; mb_row < cm->mb_rows; ++mb_row) {
+    const MB_RC_STATS *const stats =
+        cpi->mb_rc_stats + mb_row * cm->mode_info_stride;
+    for (mb_col = 0; mb_col < cm->mb_cols; ++mb_col) {
+      cost += stats[mb_col].coef_cost;
+    }
+  }
+
+  return (int)(cost >> 8);
+}
+
 /* Function to test for conditions that indeicate we should loop
  * back and recode a frame.
  */
@@ -3214,6 +3261,7 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
 
   int Loop = 0;
   int loop_count;
+  struct vpx_usec_timer encode_timer;
 
   VP8_COMMON *cm = &cpi->common;
   int active_worst_qchanged = 0;
@@ -3227,6 +3275,11 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
   int bottom_index;
   int overshoot_seen = 0;
   int undershoot_seen = 0;
+  /* Recode-free rate control: the bits of the first encode that do not
+   * depend on Q, and those of its coefficient tokens.
+   */
+  int rc_fixed_bits = 0;
+  int rc_coef_bits = 0;
 #endif
 
   int drop_mark = (int)(cpi->oxcf.drop_frames_water_mark *
@@ -3311,22 +3364,26 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
   if (cpi->oxcf.mr_total_resolutions > 1) {
     LOWER_RES_FRAME_INFO *low_res_frame_info =
         (LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info;
+    LOWER_RES_LEVEL_INFO *level_info =
+        &low_res_frame_info->level_info[cpi->oxcf.mr_encoder_id];
 
     if (cpi->oxcf.mr_encoder_id) {
+      const LOWER_RES_LEVEL_INFO *prev_level_info = level_info - 1;
+
       // Check if lower resolution is available for motion vector reuse.
       if (cm->frame_type != KEY_FRAME) {
         cpi->mr_low_res_mv_avail = 1;
-        cpi->mr_low_res_mv_avail &= !(low_res_frame_info->is_frame_dropped);
+        cpi->mr_low_res_mv_avail &= !(prev_level_info->is_frame_dropped);
 
         if (cpi->ref_frame_flags & VP8_LAST_FRAME)
           cpi->mr_low_res_mv_avail &=
               (cpi->current_ref_frames[LAST_FRAME] ==
-               low_res_frame_info->low_res_ref_frames[LAST_FRAME]);
+               prev_level_info->low_res_ref_frames[LAST_FRAME]);
 
         if (cpi->ref_frame_flags & VP8_GOLD_FRAME)
           cpi->mr_low_res_mv_avail &=
               (cpi->current_ref_frames[GOLDEN_FRAME] ==
-               low_res_frame_info->low_res_ref_frames[GOLDEN_FRAME]);
+               prev_level_info->low_res_ref_frames[GOLDEN_FRAME]);
 
         // Don't use altref to determine whether low res is available.
         // TODO (marpan): Should we make this type of condition on a
@@ -3334,19 +3391,19 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
         /*
         if (cpi->ref_frame_flags & VP8_ALTR_FRAME)
             cpi->mr_low_res_mv_avail &= (cpi->current_ref_frames[ALTREF_FRAME]
-                     == low_res_frame_info->low_res_ref_frames[ALTREF_FRAME]);
+                     == prev_level_info->low_res_ref_frames[ALTREF_FRAME]);
         */
       }
       // Disable motion vector reuse (i.e., disable any usage of the low_res)
       // if the previous lower stream is skipped/disabled.
-      if (low_res_frame_info->skip_encoding_prev_stream) {
+      if (prev_level_info->skip_encoding_prev_stream) {
         cpi->mr_low_res_mv_avail = 0;
       }
     }
     // This stream is not skipped (i.e., it's being encoded), so set this skip
     // flag to 0. This is needed for the next stream (i.e., which is the next
     // frame to be encoded).
-    low_res_frame_info->skip_encoding_prev_stream = 0;
+    level_info->skip_encoding_prev_stream = 0;
 
     // On a key frame: For the lowest resolution, keep track of the key frame
     // counter value. For the higher resolutions, reset the current video
@@ -3827,6 +3884,14 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
   vpx_write_yuv_frame(yuv_file, cpi->Source);
 #endif
 
+#if CONFIG_MULTI_RES_ENCODING
+  /* Unless the loop below may change the frame type or recode the frame,
+   * the frame info is final here: publish it, so that the next resolution
+   * can start, and then each row as it is encoded.
+   */
+  if (!mr_frame_may_recode(cpi)) vp8_mr_store_frame_info(cpi);
+#endif
+
   do {
     vpx_clear_system_state();
 
@@ -3925,6 +3990,8 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
       vp8_setup_key_frame(cpi);
     }
 
+    vpx_usec_timer_start(&encode_timer);
+
 #if CONFIG_REALTIME_ONLY & CONFIG_ONTHEFLY_BITPACKING
     {
       if (cpi->oxcf.error_resilient_mode) cm->refresh_entropy_probs = 0;
@@ -3966,7 +4033,26 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
     cpi->projected_frame_size -= vp8_estimate_entropy_savings(cpi);
     cpi->projected_frame_size =
         (cpi->projected_frame_size > 0) ? cpi->projected_frame_size : 0;
+
+    if (cpi->oxcf.recode_free_rc) {
+      const int coef_bits = mb_rc_coef_bits(cpi);
+
+      if (cpi->reuse_mb_modes) {
+        /* The modes and motion vectors have not changed. */
+        cpi->projected_frame_size = rc_fixed_bits + coef_bits;
+      } else {
+        rc_coef_bits = VPXMIN(coef_bits, cpi->projected_frame_size);
+        rc_fixed_bits = cpi->projected_frame_size - rc_coef_bits;
+      }
+    }
 #endif
+    vpx_usec_timer_mark(&encode_timer);
+    cpi->recode_stats.encode_us += vpx_usec_timer_elapsed(&encode_timer);
+    if (loop_count > 0) {
+      cpi->recode_stats.extra_encode_us +=
+          vpx_usec_timer_elapsed(&encode_timer);
+    }
+
     vpx_clear_system_state();
 
     /* Test to see if the stats generated for this frame indicate that
@@ -3974,7 +4060,7 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
      */
 
     if (cpi->pass != 2 && cpi->oxcf.auto_key && cm->frame_type != KEY_FRAME &&
-        cpi->compressor_speed != 2) {
+        cpi->compressor_speed != 2 && !cpi->reuse_mb_modes) {
 #if !CONFIG_REALTIME_ONLY
       if (decide_key_frame(cpi)) {
         /* Reset all our sizing numbers and recode */
@@ -4004,6 +4090,7 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
         q_high = cpi->active_worst_quality;
 
         loop_count++;
+        cpi->recode_stats.recodes++;
         Loop = 1;
 
         continue;
@@ -4046,8 +4133,12 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
 #if CONFIG_REALTIME_ONLY
     Loop = 0;
 #else
+    /* The recode-free rate control keeps the second encode of a frame. */
+    if (cpi->reuse_mb_modes) {
+      Loop = 0;
+    }
     /* Special case handling for forced key frames */
-    if ((cm->frame_type == KEY_FRAME) && cpi->this_key_frame_forced) {
+    else if ((cm->frame_type == KEY_FRAME) && cpi->this_key_frame_forced) {
       int last_q = Q;
       int kf_err = vp8_calc_ss_err(cpi->Source, &cm->yv12_fb[cm->new_fb_idx]);
 
@@ -4083,7 +4174,35 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
      */
     else if (recode_loop_test(cpi, frame_over_shoot_limit,
                               frame_under_shoot_limit, Q, top_index,
-                              bottom_index)) {
+                              bottom_index) &&
+             cpi->oxcf.recode_free_rc) {
+      int last_q = Q;
+
+      if (!active_worst_qchanged) vp8_update_rate_correction_factors(cpi, 0);
+
+      /* Predict the size at other Q from this encode, and search on the
+       * side of Q that moves it toward the target.
+       */
+      if (cpi->projected_frame_size > cpi->this_frame_target) {
+        Q = vp8_requantize_q(cpi, Q, rc_fixed_bits, rc_coef_bits,
+                             (Q < top_index) ? Q + 1 : top_index, top_index);
+      } else {
+        const int q_floor = (Q > bottom_index) ? Q - 1 : Q;
+
+        /* Blocks with no coefficients at Q may gain some at a lower Q,
+         * which the coefficient model cannot see, so do not step further
+         * than the frame level model would.
+         */
+        Q = vp8_requantize_q(cpi, Q, rc_fixed_bits, rc_coef_bits,
+                             bottom_index, q_floor);
+        Q = VPXMAX(Q, VPXMIN(vp8_regulate_q(cpi, cpi->this_frame_target),
+                             q_floor));
+      }
+
+      Loop = Q != last_q;
+    } else if (recode_loop_test(cpi, frame_over_shoot_limit,
+                                frame_under_shoot_limit, Q, top_index,
+                                bottom_index)) {
       int last_q = Q;
       int Retries = 0;
 
@@ -4227,15 +4346,33 @@ static void encode_frame_to_data_rate(VP8_COMP *cpi, size_t *size,
 
     if (cpi->is_src_frame_alt_ref) Loop = 0;
 
+#if !CONFIG_REALTIME_ONLY
+    /* Code the frame once more with the modes of the first encode. A forced
+     * key frame searches its Q with full encodes instead.
+     */
+    if (Loop == 1 && cpi->oxcf.recode_free_rc &&
+        !(cm->frame_type == KEY_FRAME && cpi->this_key_frame_forced)) {
+      cpi->reuse_mb_modes = 1;
+    }
+#endif
+
     if (Loop == 1) {
       vp8_restore_coding_context(cpi);
       loop_count++;
+      if (cpi->reuse_mb_modes) {
+        cpi->recode_stats.requantizations++;
+      } else {
+        cpi->recode_stats.recodes++;
+      }
 #if CONFIG_INTERNAL_STATS
       cpi->tot_recode_hits++;
 #endif
     }
   } while (Loop == 1);
 
+  cpi->reuse_mb_modes = 0;
+  cpi->recode_stats.frames++;
+
 #if defined(DROP_UNCODED_FRAMES)
   /* if there are no coded macroblocks at all drop this frame */
   if (cpi->common.MBs == cpi->mb.skip_true_count &&
@@ -4906,6 +5043,13 @@ int vp8_get_compressed_data(VP8_COMP *cpi, unsigned int *frame_flags,
     cpi->last_end_time_stamp_seen = cpi->source->ts_start;
   }
 
+#if CONFIG_MULTI_RES_ENCODING
+  /* The lower resolutions may be encoded on other threads; their frame info
+   * is needed from here on.
+   */
+  if (cpi->oxcf.mr_total_resolutions > 1) vp8_mr_wait_frame_info(cpi);
+#endif
+
   /* adjust frame rates based on timestamps given */
   if (cm->show_frame) {
     int64_t this_duration;
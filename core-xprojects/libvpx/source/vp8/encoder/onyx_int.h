@@ -191,6 +191,14 @@ typedef struct {
   TOKENEXTRA *stop;
 } TOKENLIST;
 
+/* What the first encode of a frame records of each MB for the recode-free
+ * rate control (VP8E_SET_RECODE_FREE_RC).
+ */
+typedef struct {
+  int coef_cost; /* cost of the coefficient tokens, in 1/256 bit */
+  int skip;      /* residual skipped by the mode decision */
+} MB_RC_STATS;
+
 typedef struct {
   int ithread;
   void *ptr1;
@@ -633,6 +641,20 @@ typedef struct VP8_COMP {
   unsigned int activity_avg;
   unsigned int *mb_activity_map;
 
+  /* Recode-free rate control: stats of the first encode of the frame,
+   * indexed like the mode info, and set while the frame is quantized again
+   * with the modes of that encode.
+   */
+  MB_RC_STATS *mb_rc_stats;
+  int reuse_mb_modes;
+  struct {
+    uint64_t frames;
+    uint64_t recodes;
+    uint64_t requantizations;
+    uint64_t encode_us;
+    uint64_t extra_encode_us;
+  } recode_stats;
+
   /* Record of which MBs still refer to last golden frame either
    * directly or through 0,0
    */
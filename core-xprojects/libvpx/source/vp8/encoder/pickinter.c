@@ -32,6 +32,9 @@
 #if CONFIG_TEMPORAL_DENOISING
 #include "denoising.h"
 #endif
+#if CONFIG_MULTI_RES_ENCODING
+#include "mr_dissim.h"
+#endif
 
 #ifdef SPEEDSTATS
 extern unsigned int cnt_pm;
@@ -395,8 +398,10 @@ static void get_lower_res_motion_info(VP8_COMP *cpi, MACROBLOCKD *xd,
                                       MB_PREDICTION_MODE *parent_mode,
                                       int_mv *parent_ref_mv, int mb_row,
                                       int mb_col) {
-  LOWER_RES_MB_INFO *store_mode_info =
-      ((LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info)->mb_info;
+  const LOWER_RES_FRAME_INFO *low_res_frame_info =
+      (const LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info;
+  const LOWER_RES_MB_INFO *store_mode_info =
+      low_res_frame_info->level_info[cpi->oxcf.mr_encoder_id - 1].mb_info;
   unsigned int parent_mb_index;
 
   /* Consider different down_sampling_factor.  */
@@ -412,6 +417,9 @@ static void get_lower_res_motion_info(VP8_COMP *cpi, MACROBLOCKD *xd,
     parent_mb_col = mb_col * cpi->oxcf.mr_down_sampling_factor.den /
                     cpi->oxcf.mr_down_sampling_factor.num;
     parent_mb_index = parent_mb_row * cpi->mr_low_res_mb_cols + parent_mb_col;
+
+    /* The lower resolution may still be encoding this frame. */
+    vp8_mr_wait_rows(cpi, parent_mb_row + 1);
   }
 
   /* Read lower-resolution mode & motion result from memory.*/
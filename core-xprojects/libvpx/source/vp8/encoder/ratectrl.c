@@ -23,6 +23,9 @@
 #include "encodemv.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 #include "vpx_ports/system_state.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "mr_dissim.h"
+#endif
 
 #define MIN_BPB_FACTOR 0.01
 #define MAX_BPB_FACTOR 50
@@ -1285,6 +1288,31 @@ int vp8_regulate_q(VP8_COMP *cpi, int target_bits_per_frame) {
   return Q;
 }
 
+int vp8_requantize_q(VP8_COMP *cpi, int Q, int fixed_bits, int coef_bits,
+                     int q_low, int q_high) {
+  const int frame_type = cpi->common.frame_type;
+  int best_q = Q;
+  int best_error = INT_MAX;
+  int i;
+
+  /* Keep the modes, motion vectors and side information of the encode at Q
+   * and scale the bits of its coefficient tokens with the quantizer.
+   */
+  for (i = q_low; i <= q_high; ++i) {
+    const int bits =
+        fixed_bits + (int)((int64_t)coef_bits * vp8_bits_per_mb[frame_type][i] /
+                           vp8_bits_per_mb[frame_type][Q]);
+    const int error = abs(bits - cpi->this_frame_target);
+
+    if (error < best_error) {
+      best_error = error;
+      best_q = i;
+    }
+  }
+
+  return best_q;
+}
+
 static int estimate_keyframe_frequency(VP8_COMP *cpi) {
   int i;
 
@@ -1477,6 +1505,9 @@ int vp8_drop_encodedframe_overshoot(VP8_COMP *cpi, int Q) {
   LOWER_RES_FRAME_INFO *low_res_frame_info =
       (LOWER_RES_FRAME_INFO *)cpi->oxcf.mr_low_res_mode_info;
   if (cpi->oxcf.mr_total_resolutions > 1 && cpi->oxcf.mr_encoder_id > 0) {
+    // The lower streams may still be encoding on other threads; the flag is
+    // final once they are done.
+    vp8_mr_wait_lower_resolutions(cpi, cpi->oxcf.mr_encoder_id);
     force_drop_overshoot = low_res_frame_info->is_frame_dropped_overshoot_maxqp;
     if (!force_drop_overshoot) {
       cpi->force_maxqp = 0;
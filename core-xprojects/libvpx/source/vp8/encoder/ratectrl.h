@@ -23,6 +23,12 @@ extern void vp8_restore_coding_context(VP8_COMP *cpi);
 extern void vp8_setup_key_frame(VP8_COMP *cpi);
 extern void vp8_update_rate_correction_factors(VP8_COMP *cpi, int damp_var);
 extern int vp8_regulate_q(VP8_COMP *cpi, int target_bits_per_frame);
+/* Returns the Q in [q_low, q_high] whose predicted size, from a frame encoded
+ * at Q with fixed_bits of side information and coef_bits of coefficients, is
+ * closest to the frame target.
+ */
+extern int vp8_requantize_q(VP8_COMP *cpi, int Q, int fixed_bits,
+                            int coef_bits, int q_low, int q_high);
 extern void vp8_adjust_key_frame_context(VP8_COMP *cpi);
 extern void vp8_compute_frame_size_bounds(VP8_COMP *cpi,
                                           int *frame_under_shoot_limit,
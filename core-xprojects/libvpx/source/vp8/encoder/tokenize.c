@@ -466,3 +466,37 @@ void vp8_fix_contexts(MACROBLOCKD *x) {
     memset(x->left_context, 0, sizeof(ENTROPY_CONTEXT_PLANES) - 1);
   }
 }
+
+int vp8_tokens_cost(const TOKENEXTRA *p, const TOKENEXTRA *stop) {
+  int cost = 0;
+
+  for (; p < stop; ++p) {
+    const vp8_token *const a = vp8_coef_encodings + p->Token;
+    const vp8_extra_bit_struct *const b = vp8_extra_bits + p->Token;
+    const vp8_prob *const pp = p->context_tree;
+    int i = 0;
+    int n = a->Len;
+
+    /* Same walk as vp8_pack_tokens(), which starts past the EOB node when
+     * the token cannot be an EOB. */
+    if (p->skip_eob_node) {
+      n--;
+      i = 2;
+    }
+
+    do {
+      const int bb = (a->value >> --n) & 1;
+      cost += vp8_cost_bit(pp[i >> 1], bb);
+      i = vp8_coef_tree[i + bb];
+    } while (n);
+
+    if (b->base_val) {
+      if (b->Len) {
+        cost += vp8_treed_cost(b->tree, b->prob, p->Extra >> 1, b->Len);
+      }
+      cost += vp8_cost_bit(128, p->Extra & 1);
+    }
+  }
+
+  return cost;
+}
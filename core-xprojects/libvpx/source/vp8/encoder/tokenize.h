@@ -34,6 +34,11 @@ typedef struct {
 
 int rd_cost_mby(MACROBLOCKD *);
 
+/* Returns the cost of the tokens [p, stop) with the probabilities they were
+ * tokenized with, in 1/256 bit.
+ */
+int vp8_tokens_cost(const TOKENEXTRA *p, const TOKENEXTRA *stop);
+
 extern const short *const vp8_dct_value_cost_ptr;
 /* TODO: The Token field should be broken out into a separate char array to
  *  improve cache locality, since it's needed for costing when the rest of the
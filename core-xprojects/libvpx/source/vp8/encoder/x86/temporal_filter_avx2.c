@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp8_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+/* Filter 16 pixels: src and pred hold them as 16-bit values. */
+static INLINE void filter_16(const __m256i src, const __m256i pred,
+                             const __m128i strength, const __m256i rounding,
+                             const __m256i weight, unsigned int *accumulator,
+                             unsigned short *count) {
+  const __m256i sixteen = _mm256_set1_epi16(16);
+  const __m256i diff = _mm256_sub_epi16(src, pred);
+  /* diff * diff is at most 255 * 255 and fits in 16 bits unsigned. Saturating
+   * the sums only affects values that are clamped to 16 anyway, as the
+   * strength is at most 6. */
+  const __m256i sq = _mm256_mullo_epi16(diff, diff);
+  __m256i modifier = _mm256_adds_epu16(_mm256_adds_epu16(sq, sq), sq);
+  __m256i weighted;
+
+  modifier = _mm256_adds_epu16(modifier, rounding);
+  modifier = _mm256_srl_epi16(modifier, strength);
+  modifier = _mm256_min_epu16(modifier, sixteen);
+  modifier = _mm256_sub_epi16(sixteen, modifier);
+  modifier = _mm256_mullo_epi16(modifier, weight);
+
+  _mm256_storeu_si256(
+      (__m256i *)count,
+      _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)count), modifier));
+
+  weighted = _mm256_mullo_epi16(modifier, pred);
+  _mm256_storeu_si256(
+      (__m256i *)accumulator,
+      _mm256_add_epi32(
+          _mm256_loadu_si256((const __m256i *)accumulator),
+          _mm256_cvtepu16_epi32(_mm256_castsi256_si128(weighted))));
+  _mm256_storeu_si256(
+      (__m256i *)(accumulator + 8),
+      _mm256_add_epi32(
+          _mm256_loadu_si256((const __m256i *)(accumulator + 8)),
+          _mm256_cvtepu16_epi32(_mm256_extracti128_si256(weighted, 1))));
+}
+
+void vp8_temporal_filter_apply_avx2(unsigned char *frame1, unsigned int stride,
+                                    unsigned char *frame2,
+                                    unsigned int block_size, int strength,
+                                    int filter_weight,
+                                    unsigned int *accumulator,
+                                    unsigned short *count) {
+  const __m128i strength_u128 = _mm_cvtsi32_si128(strength);
+  const __m256i rounding =
+      _mm256_set1_epi16(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m256i weight = _mm256_set1_epi16(filter_weight);
+  unsigned int i;
+
+  assert(block_size == 16 || block_size == 8);
+  assert(strength >= 0 && strength <= 6);
+  assert(filter_weight >= 0 && filter_weight <= 2);
+
+  if (block_size == 16) {
+    for (i = 0; i < 16; ++i) {
+      const __m256i src =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)frame1));
+      const __m256i pred =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)frame2));
+      filter_16(src, pred, strength_u128, rounding, weight, accumulator,
+                count);
+      frame1 += stride;
+      frame2 += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  } else {
+    /* 2 rows of 8 at a time. The predictor rows are contiguous. */
+    for (i = 0; i < 8; i += 2) {
+      const __m256i src = _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(
+          _mm_loadl_epi64((const __m128i *)frame1),
+          _mm_loadl_epi64((const __m128i *)(frame1 + stride))));
+      const __m256i pred =
+          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)frame2));
+      filter_16(src, pred, strength_u128, rounding, weight, accumulator,
+                count);
+      frame1 += 2 * stride;
+      frame2 += 16;
+      accumulator += 16;
+      count += 16;
+    }
+  }
+}
@@ -19,8 +19,12 @@
 #include "vpx_ports/static_assert.h"
 #include "vpx_ports/system_state.h"
 #include "vpx_ports/vpx_once.h"
+#include "vpx_util/vpx_thread.h"
 #include "vpx_util/vpx_timestamp.h"
 #include "vp8/encoder/onyx_int.h"
+#if CONFIG_MULTI_RES_ENCODING
+#include "vp8/encoder/mr_dissim.h"
+#endif
 #include "vpx/vp8cx.h"
 #include "vp8/encoder/firstpass.h"
 #include "vp8/common/onyx.h"
@@ -45,6 +49,7 @@ struct vp8_extracfg {
   unsigned int rc_max_intra_bitrate_pct;
   unsigned int gf_cbr_boost_pct;
   unsigned int screen_content_mode;
+  unsigned int recode_free_rc;
 };
 
 static struct vp8_extracfg default_extracfg = {
@@ -71,6 +76,7 @@ static struct vp8_extracfg default_extracfg = {
   0,  /* rc_max_intra_bitrate_pct */
   0,  /* gf_cbr_boost_pct */
   0,  /* screen_content_mode */
+  0,  /* recode_free_rc */
 };
 
 struct vpx_codec_alg_priv {
@@ -91,6 +97,18 @@ struct vpx_codec_alg_priv {
   vpx_codec_pkt_list_decl(64) pkt_list;
   unsigned int fixed_kf_cntr;
   vpx_enc_frame_flags_t control_frame_flags;
+#if CONFIG_MULTI_RES_ENCODING
+  /* Encodes a lower resolution concurrently with the higher ones when
+   * mr_pipeline is set. The arguments of the pending encode call follow.
+   */
+  VPxWorker mr_worker;
+  unsigned int mr_pipeline;
+  const vpx_image_t *mr_img;
+  vpx_codec_pts_t mr_pts;
+  unsigned long mr_duration;
+  vpx_enc_frame_flags_t mr_flags;
+  unsigned long mr_deadline;
+#endif
 };
 
 static vpx_codec_err_t update_error_state(
@@ -204,6 +222,7 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
   RANGE_CHECK(vp8_cfg, arnr_type, 1, 3);
   RANGE_CHECK(vp8_cfg, cq_level, 0, 63);
   RANGE_CHECK_HI(vp8_cfg, screen_content_mode, 2);
+  RANGE_CHECK_HI(vp8_cfg, recode_free_rc, 1);
   if (finalize && (cfg->rc_end_usage == VPX_CQ || cfg->rc_end_usage == VPX_Q))
     RANGE_CHECK(vp8_cfg, cq_level, cfg->rc_min_quantizer,
                 cfg->rc_max_quantizer);
@@ -415,6 +434,8 @@ static vpx_codec_err_t set_vp8e_config(VP8_CONFIG *oxcf,
 
   oxcf->screen_content_mode = vp8_cfg.screen_content_mode;
 
+  oxcf->recode_free_rc = vp8_cfg.recode_free_rc;
+
   /*
       printf("Current VP8 Settings: \n");
       printf("target_bandwidth: %d\n", oxcf->target_bandwidth);
@@ -605,29 +626,44 @@ static vpx_codec_err_t set_screen_content_mode(vpx_codec_alg_priv_t *ctx,
   return update_extracfg(ctx, &extra_cfg);
 }
 
+static vpx_codec_err_t set_recode_free_rc(vpx_codec_alg_priv_t *ctx,
+                                          va_list args) {
+  struct vp8_extracfg extra_cfg = ctx->vp8_cfg;
+  extra_cfg.recode_free_rc = CAST(VP8E_SET_RECODE_FREE_RC, args);
+  return update_extracfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t get_recode_stats(vpx_codec_alg_priv_t *ctx,
+                                        va_list args) {
+  vpx_recode_stats_t *const stats = va_arg(args, vpx_recode_stats_t *);
+  if (stats == NULL) return VPX_CODEC_INVALID_PARAM;
+  stats->frames = ctx->cpi->recode_stats.frames;
+  stats->recodes = ctx->cpi->recode_stats.recodes;
+  stats->requantizations = ctx->cpi->recode_stats.requantizations;
+  stats->encode_us = ctx->cpi->recode_stats.encode_us;
+  stats->extra_encode_us = ctx->cpi->recode_stats.extra_encode_us;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t vp8e_mr_alloc_mem(const vpx_codec_enc_cfg_t *cfg,
                                          void **mem_loc) {
   vpx_codec_err_t res = VPX_CODEC_OK;
 
 #if CONFIG_MULTI_RES_ENCODING
   LOWER_RES_FRAME_INFO *shared_mem_loc;
-  int mb_rows = ((cfg->g_w + 15) >> 4);
-  int mb_cols = ((cfg->g_h + 15) >> 4);
+  int mb_cols = ((cfg->g_w + 15) >> 4);
+  int mb_rows = ((cfg->g_h + 15) >> 4);
 
   shared_mem_loc = calloc(1, sizeof(LOWER_RES_FRAME_INFO));
   if (!shared_mem_loc) {
     return VPX_CODEC_MEM_ERROR;
   }
 
-  shared_mem_loc->mb_info =
-      calloc(mb_rows * mb_cols, sizeof(LOWER_RES_MB_INFO));
-  if (!(shared_mem_loc->mb_info)) {
-    free(shared_mem_loc);
-    res = VPX_CODEC_MEM_ERROR;
-  } else {
-    *mem_loc = (void *)shared_mem_loc;
-    res = VPX_CODEC_OK;
-  }
+  /* The mode info of each lower resolution is allocated by its encoder, at
+   * the size of the highest resolution, which is the one configured here.
+   */
+  shared_mem_loc->mb_info_size = mb_rows * mb_cols;
+  *mem_loc = (void *)shared_mem_loc;
 #else
   (void)cfg;
   (void)mem_loc;
@@ -635,6 +671,10 @@ static vpx_codec_err_t vp8e_mr_alloc_mem(const vpx_codec_enc_cfg_t *cfg,
   return res;
 }
 
+#if CONFIG_MULTI_RES_ENCODING
+static int mr_encode_hook(void *arg1, void *arg2);
+#endif
+
 static vpx_codec_err_t vp8e_init(vpx_codec_ctx_t *ctx,
                                  vpx_codec_priv_enc_mr_cfg_t *mr_cfg) {
   vpx_codec_err_t res = VPX_CODEC_OK;
@@ -696,6 +736,26 @@ static vpx_codec_err_t vp8e_init(vpx_codec_ctx_t *ctx,
       priv->cpi = vp8_create_compressor(&priv->oxcf);
       if (!priv->cpi) res = VPX_CODEC_MEM_ERROR;
     }
+
+#if CONFIG_MULTI_RES_ENCODING
+    if (!res && priv->oxcf.mr_total_resolutions > 1) {
+      const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+      LOWER_RES_FRAME_INFO *shared_mem_loc =
+          (LOWER_RES_FRAME_INFO *)priv->oxcf.mr_low_res_mode_info;
+      const unsigned int id = priv->oxcf.mr_encoder_id;
+
+      if (id < priv->oxcf.mr_total_resolutions - 1) {
+        shared_mem_loc->level_info[id].mb_info =
+            calloc(shared_mem_loc->mb_info_size, sizeof(LOWER_RES_MB_INFO));
+        if (!shared_mem_loc->level_info[id].mb_info)
+          return VPX_CODEC_MEM_ERROR;
+      }
+
+      winterface->init(&priv->mr_worker);
+      priv->mr_worker.hook = mr_encode_hook;
+      priv->mr_worker.data1 = priv;
+    }
+#endif
   }
 
   return res;
@@ -704,11 +764,17 @@ static vpx_codec_err_t vp8e_init(vpx_codec_ctx_t *ctx,
 static vpx_codec_err_t vp8e_destroy(vpx_codec_alg_priv_t *ctx) {
 #if CONFIG_MULTI_RES_ENCODING
   /* Free multi-encoder shared memory */
+  if (ctx->oxcf.mr_total_resolutions > 1)
+    vpx_get_worker_interface()->end(&ctx->mr_worker);
+
   if (ctx->oxcf.mr_total_resolutions > 0 &&
       (ctx->oxcf.mr_encoder_id == ctx->oxcf.mr_total_resolutions - 1)) {
     LOWER_RES_FRAME_INFO *shared_mem_loc =
         (LOWER_RES_FRAME_INFO *)ctx->oxcf.mr_low_res_mode_info;
-    free(shared_mem_loc->mb_info);
+    unsigned int i;
+
+    for (i = 0; i < ctx->oxcf.mr_total_resolutions; ++i)
+      free(shared_mem_loc->level_info[i].mb_info);
     free(ctx->oxcf.mr_low_res_mode_info);
   }
 #endif
@@ -834,11 +900,11 @@ static vpx_codec_err_t set_reference_and_update(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
-static vpx_codec_err_t vp8e_encode(vpx_codec_alg_priv_t *ctx,
-                                   const vpx_image_t *img, vpx_codec_pts_t pts,
-                                   unsigned long duration,
-                                   vpx_enc_frame_flags_t enc_flags,
-                                   unsigned long deadline) {
+static vpx_codec_err_t encode_frame(vpx_codec_alg_priv_t *ctx,
+                                    const vpx_image_t *img, vpx_codec_pts_t pts,
+                                    unsigned long duration,
+                                    vpx_enc_frame_flags_t enc_flags,
+                                    unsigned long deadline) {
   volatile vpx_codec_err_t res = VPX_CODEC_OK;
   // Make a copy as volatile to avoid -Wclobbered with longjmp.
   volatile vpx_enc_frame_flags_t flags = enc_flags;
@@ -851,7 +917,8 @@ static vpx_codec_err_t vp8e_encode(vpx_codec_alg_priv_t *ctx,
       LOWER_RES_FRAME_INFO *low_res_frame_info =
           (LOWER_RES_FRAME_INFO *)ctx->cpi->oxcf.mr_low_res_mode_info;
       if (!low_res_frame_info) return VPX_CODEC_ERROR;
-      low_res_frame_info->skip_encoding_prev_stream = 1;
+      low_res_frame_info->level_info[ctx->cpi->oxcf.mr_encoder_id]
+          .skip_encoding_prev_stream = 1;
       if (ctx->cpi->oxcf.mr_encoder_id == 0)
         low_res_frame_info->skip_encoding_base_stream = 1;
     }
@@ -1043,6 +1110,56 @@ static vpx_codec_err_t vp8e_encode(vpx_codec_alg_priv_t *ctx,
   return res;
 }
 
+#if CONFIG_MULTI_RES_ENCODING
+static int mr_encode_hook(void *arg1, void *arg2) {
+  vpx_codec_alg_priv_t *const ctx = (vpx_codec_alg_priv_t *)arg1;
+  const vpx_codec_err_t res =
+      encode_frame(ctx, ctx->mr_img, ctx->mr_pts, ctx->mr_duration,
+                   ctx->mr_flags, ctx->mr_deadline);
+  (void)arg2;
+
+  vp8_mr_finish_frame(ctx->cpi, res);
+  return res == VPX_CODEC_OK;
+}
+#endif
+
+static vpx_codec_err_t vp8e_encode(vpx_codec_alg_priv_t *ctx,
+                                   const vpx_image_t *img, vpx_codec_pts_t pts,
+                                   unsigned long duration,
+                                   vpx_enc_frame_flags_t enc_flags,
+                                   unsigned long deadline) {
+#if CONFIG_MULTI_RES_ENCODING
+  if (ctx->cpi && ctx->oxcf.mr_total_resolutions > 1) {
+    const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+    const int id = ctx->oxcf.mr_encoder_id;
+    vpx_codec_err_t res, lower_res;
+
+    winterface->sync(&ctx->mr_worker);
+    vp8_mr_start_frame(ctx->cpi);
+
+    /* The lower resolutions are called first. In pipeline mode they are
+     * encoded on their workers and the highest resolution, which runs on
+     * the calling thread, waits for all of them and returns their status.
+     */
+    if (ctx->mr_pipeline && id < (int)ctx->oxcf.mr_total_resolutions - 1) {
+      ctx->mr_img = img;
+      ctx->mr_pts = pts;
+      ctx->mr_duration = duration;
+      ctx->mr_flags = enc_flags;
+      ctx->mr_deadline = deadline;
+      winterface->launch(&ctx->mr_worker);
+      return VPX_CODEC_OK;
+    }
+
+    res = encode_frame(ctx, img, pts, duration, enc_flags, deadline);
+    vp8_mr_finish_frame(ctx->cpi, res);
+    lower_res = vp8_mr_wait_lower_resolutions(ctx->cpi, id);
+    return res != VPX_CODEC_OK ? res : lower_res;
+  }
+#endif
+  return encode_frame(ctx, img, pts, duration, enc_flags, deadline);
+}
+
 static const vpx_codec_cx_pkt_t *vp8e_get_cxdata(vpx_codec_alg_priv_t *ctx,
                                                  vpx_codec_iter_t *iter) {
   return vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
@@ -1218,6 +1335,24 @@ static vpx_codec_err_t vp8e_set_scalemode(vpx_codec_alg_priv_t *ctx,
   }
 }
 
+static vpx_codec_err_t vp8e_set_multi_res_pipeline(vpx_codec_alg_priv_t *ctx,
+                                                   va_list args) {
+#if CONFIG_MULTI_RES_ENCODING
+  const unsigned int pipeline = CAST(VP8E_SET_MULTI_RES_PIPELINE, args);
+
+  if (ctx->oxcf.mr_total_resolutions < 2) return VPX_CODEC_INCAPABLE;
+  vpx_get_worker_interface()->sync(&ctx->mr_worker);
+  if (pipeline && !vpx_get_worker_interface()->reset(&ctx->mr_worker))
+    return VPX_CODEC_ERROR;
+  ctx->mr_pipeline = pipeline;
+  return VPX_CODEC_OK;
+#else
+  (void)ctx;
+  (void)args;
+  return VPX_CODEC_INCAPABLE;
+#endif
+}
+
 static vpx_codec_ctrl_fn_map_t vp8e_ctf_maps[] = {
   { VP8_SET_REFERENCE, vp8e_set_reference },
   { VP8_COPY_REFERENCE, vp8e_get_reference },
@@ -1243,6 +1378,9 @@ static vpx_codec_ctrl_fn_map_t vp8e_ctf_maps[] = {
   { VP8E_SET_MAX_INTRA_BITRATE_PCT, set_rc_max_intra_bitrate_pct },
   { VP8E_SET_SCREEN_CONTENT_MODE, set_screen_content_mode },
   { VP8E_SET_GF_CBR_BOOST_PCT, ctrl_set_rc_gf_cbr_boost_pct },
+  { VP8E_SET_MULTI_RES_PIPELINE, vp8e_set_multi_res_pipeline },
+  { VP8E_SET_RECODE_FREE_RC, set_recode_free_rc },
+  { VP8E_GET_RECODE_STATS, get_recode_stats },
   { -1, NULL },
 };
 
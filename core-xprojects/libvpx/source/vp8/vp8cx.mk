@@ -97,10 +97,12 @@ endif
 
 VP8_CX_SRCS-$(HAVE_SSE2) += encoder/x86/block_error_sse2.asm
 VP8_CX_SRCS-$(HAVE_SSE2) += encoder/x86/temporal_filter_apply_sse2.asm
+VP8_CX_SRCS-$(HAVE_AVX2) += encoder/x86/temporal_filter_avx2.c
 VP8_CX_SRCS-$(HAVE_SSE2) += encoder/x86/vp8_enc_stubs_sse2.c
 
 ifeq ($(CONFIG_REALTIME_ONLY),yes)
 VP8_CX_SRCS_REMOVE-$(HAVE_SSE2) += encoder/x86/temporal_filter_apply_sse2.asm
+VP8_CX_SRCS_REMOVE-$(HAVE_AVX2) += encoder/x86/temporal_filter_avx2.c
 endif
 
 VP8_CX_SRCS-$(HAVE_NEON) += encoder/arm/neon/denoising_neon.c
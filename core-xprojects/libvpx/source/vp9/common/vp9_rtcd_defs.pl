@@ -161,7 +161,7 @@ add_proto qw/void vp9_fwht4x4/, "const int16_t *input, tran_low_t *output, int s
 # is off.
 specialize qw/vp9_fht4x4 sse2/;
 specialize qw/vp9_fht8x8 sse2/;
-specialize qw/vp9_fht16x16 sse2/;
+specialize qw/vp9_fht16x16 sse2 avx2/;
 specialize qw/vp9_fwht4x4 sse2/;
 if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") ne "yes") {
   # Note that these specializations are appended to the above ones.
@@ -182,11 +182,11 @@ specialize qw/vp9_diamond_search_sad avx/;
 #
 if (vpx_config("CONFIG_REALTIME_ONLY") ne "yes") {
 add_proto qw/void vp9_apply_temporal_filter/, "const uint8_t *y_src, int y_src_stride, const uint8_t *y_pre, int y_pre_stride, const uint8_t *u_src, const uint8_t *v_src, int uv_src_stride, const uint8_t *u_pre, const uint8_t *v_pre, int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, int strength, const int *const blk_fw, int use_32x32, uint32_t *y_accumulator, uint16_t *y_count, uint32_t *u_accumulator, uint16_t *u_count, uint32_t *v_accumulator, uint16_t *v_count";
-specialize qw/vp9_apply_temporal_filter sse4_1/;
+specialize qw/vp9_apply_temporal_filter sse4_1 avx2/;
 
   if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
     add_proto qw/void vp9_highbd_apply_temporal_filter/, "const uint16_t *y_src, int y_src_stride, const uint16_t *y_pre, int y_pre_stride, const uint16_t *u_src, const uint16_t *v_src, int uv_src_stride, const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, int strength, const int *const blk_fw, int use_32x32, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count";
-    specialize qw/vp9_highbd_apply_temporal_filter sse4_1/;
+    specialize qw/vp9_highbd_apply_temporal_filter sse4_1 avx2/;
   }
 }
 
@@ -201,10 +201,13 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
 
   # fdct functions
   add_proto qw/void vp9_highbd_fht4x4/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
+  specialize qw/vp9_highbd_fht4x4 avx2/;
 
   add_proto qw/void vp9_highbd_fht8x8/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
+  specialize qw/vp9_highbd_fht8x8 avx2/;
 
   add_proto qw/void vp9_highbd_fht16x16/, "const int16_t *input, tran_low_t *output, int stride, int tx_type";
+  specialize qw/vp9_highbd_fht16x16 avx2/;
 
   add_proto qw/void vp9_highbd_fwht4x4/, "const int16_t *input, tran_low_t *output, int stride";
 
@@ -219,6 +222,24 @@ if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
 add_proto qw/void vp9_scale_and_extend_frame/, "const struct yv12_buffer_config *src, struct yv12_buffer_config *dst, INTERP_FILTER filter_type, int phase_scaler";
 specialize qw/vp9_scale_and_extend_frame neon ssse3/;
 
+#
+# non-normative resize
+#
+# Only SSE2 versions exist so far; other targets, NEON included, use the C.
+add_proto qw/void vp9_resize_horz_8tap/, "const uint8_t *src, uint8_t *dst, int w, int64_t pos, int64_t step, const int16_t *filters";
+specialize qw/vp9_resize_horz_8tap sse2/;
+
+add_proto qw/void vp9_resize_vert_8tap/, "const uint8_t *const *src, uint8_t *dst, int w, const int16_t *filter";
+specialize qw/vp9_resize_vert_8tap sse2/;
+
+if (vpx_config("CONFIG_VP9_HIGHBITDEPTH") eq "yes") {
+  add_proto qw/void vp9_highbd_resize_horz_8tap/, "const uint16_t *src, uint16_t *dst, int w, int64_t pos, int64_t step, const int16_t *filters, int bd";
+  specialize qw/vp9_highbd_resize_horz_8tap sse2/;
+
+  add_proto qw/void vp9_highbd_resize_vert_8tap/, "const uint16_t *const *src, uint16_t *dst, int w, const int16_t *filter, int bd";
+  specialize qw/vp9_highbd_resize_vert_8tap sse2/;
+}
+
 }
 # end encoder functions
 1;
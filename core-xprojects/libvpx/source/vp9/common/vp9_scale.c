@@ -137,35 +137,40 @@ void vp9_setup_scale_factors_for_frame(struct scale_factors *sf, int other_w,
         sf->highbd_predict[1][0][1] = vpx_highbd_convolve8_avg_horiz;
       } else {
         // No scaling in x direction. Must always scale in the y direction.
-        sf->highbd_predict[0][0][0] = vpx_highbd_convolve8_vert;
-        sf->highbd_predict[0][0][1] = vpx_highbd_convolve8_avg_vert;
-        sf->highbd_predict[0][1][0] = vpx_highbd_convolve8_vert;
-        sf->highbd_predict[0][1][1] = vpx_highbd_convolve8_avg_vert;
-        sf->highbd_predict[1][0][0] = vpx_highbd_convolve8;
-        sf->highbd_predict[1][0][1] = vpx_highbd_convolve8_avg;
+        sf->highbd_predict[0][0][0] = vpx_highbd_scaled_vert;
+        sf->highbd_predict[0][0][1] = vpx_highbd_scaled_avg_vert;
+        sf->highbd_predict[0][1][0] = vpx_highbd_scaled_vert;
+        sf->highbd_predict[0][1][1] = vpx_highbd_scaled_avg_vert;
+        sf->highbd_predict[1][0][0] = vpx_highbd_scaled_2d;
+        sf->highbd_predict[1][0][1] = vpx_highbd_scaled_avg_2d;
       }
     } else {
       if (sf->y_step_q4 == 16) {
         // No scaling in the y direction. Must always scale in the x direction.
-        sf->highbd_predict[0][0][0] = vpx_highbd_convolve8_horiz;
-        sf->highbd_predict[0][0][1] = vpx_highbd_convolve8_avg_horiz;
-        sf->highbd_predict[0][1][0] = vpx_highbd_convolve8;
-        sf->highbd_predict[0][1][1] = vpx_highbd_convolve8_avg;
-        sf->highbd_predict[1][0][0] = vpx_highbd_convolve8_horiz;
-        sf->highbd_predict[1][0][1] = vpx_highbd_convolve8_avg_horiz;
+        sf->highbd_predict[0][0][0] = vpx_highbd_scaled_horiz;
+        sf->highbd_predict[0][0][1] = vpx_highbd_scaled_avg_horiz;
+        sf->highbd_predict[0][1][0] = vpx_highbd_scaled_2d;
+        sf->highbd_predict[0][1][1] = vpx_highbd_scaled_avg_2d;
+        sf->highbd_predict[1][0][0] = vpx_highbd_scaled_horiz;
+        sf->highbd_predict[1][0][1] = vpx_highbd_scaled_avg_horiz;
       } else {
         // Must always scale in both directions.
-        sf->highbd_predict[0][0][0] = vpx_highbd_convolve8;
-        sf->highbd_predict[0][0][1] = vpx_highbd_convolve8_avg;
-        sf->highbd_predict[0][1][0] = vpx_highbd_convolve8;
-        sf->highbd_predict[0][1][1] = vpx_highbd_convolve8_avg;
-        sf->highbd_predict[1][0][0] = vpx_highbd_convolve8;
-        sf->highbd_predict[1][0][1] = vpx_highbd_convolve8_avg;
+        sf->highbd_predict[0][0][0] = vpx_highbd_scaled_2d;
+        sf->highbd_predict[0][0][1] = vpx_highbd_scaled_avg_2d;
+        sf->highbd_predict[0][1][0] = vpx_highbd_scaled_2d;
+        sf->highbd_predict[0][1][1] = vpx_highbd_scaled_avg_2d;
+        sf->highbd_predict[1][0][0] = vpx_highbd_scaled_2d;
+        sf->highbd_predict[1][0][1] = vpx_highbd_scaled_avg_2d;
       }
     }
     // 2D subpel motion always gets filtered in both directions.
-    sf->highbd_predict[1][1][0] = vpx_highbd_convolve8;
-    sf->highbd_predict[1][1][1] = vpx_highbd_convolve8_avg;
+    if ((sf->x_step_q4 != 16) || (sf->y_step_q4 != 16)) {
+      sf->highbd_predict[1][1][0] = vpx_highbd_scaled_2d;
+      sf->highbd_predict[1][1][1] = vpx_highbd_scaled_avg_2d;
+    } else {
+      sf->highbd_predict[1][1][0] = vpx_highbd_convolve8;
+      sf->highbd_predict[1][1][1] = vpx_highbd_convolve8_avg;
+    }
   }
 #endif
 }
@@ -165,6 +165,22 @@ static void read_mv_probs(nmv_context *ctx, int allow_hp, vpx_reader *r) {
   }
 }
 
+// Zeroes the coefficients written by vp9_decode_block_tokens() so the buffer
+// can be reused for the next transform block.
+static INLINE void clear_dqcoeff(tran_low_t *dqcoeff, TX_TYPE tx_type,
+                                 TX_SIZE tx_size, int eob) {
+  if (eob == 1) {
+    dqcoeff[0] = 0;
+  } else {
+    if (tx_type == DCT_DCT && tx_size <= TX_16X16 && eob <= 10)
+      memset(dqcoeff, 0, 4 * (4 << tx_size) * sizeof(dqcoeff[0]));
+    else if (tx_size == TX_32X32 && eob <= 34)
+      memset(dqcoeff, 0, 256 * sizeof(dqcoeff[0]));
+    else
+      memset(dqcoeff, 0, (16 << (tx_size << 1)) * sizeof(dqcoeff[0]));
+  }
+}
+
 static void inverse_transform_block_inter(MACROBLOCKD *xd, int plane,
                                           const TX_SIZE tx_size, uint8_t *dst,
                                           int stride, int eob) {
@@ -220,16 +236,7 @@ static void inverse_transform_block_inter(MACROBLOCKD *xd, int plane,
   }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
-  if (eob == 1) {
-    dqcoeff[0] = 0;
-  } else {
-    if (tx_size <= TX_16X16 && eob <= 10)
-      memset(dqcoeff, 0, 4 * (4 << tx_size) * sizeof(dqcoeff[0]));
-    else if (tx_size == TX_32X32 && eob <= 34)
-      memset(dqcoeff, 0, 256 * sizeof(dqcoeff[0]));
-    else
-      memset(dqcoeff, 0, (16 << (tx_size << 1)) * sizeof(dqcoeff[0]));
-  }
+  clear_dqcoeff(dqcoeff, DCT_DCT, tx_size, eob);
 }
 
 static void inverse_transform_block_intra(MACROBLOCKD *xd, int plane,
@@ -292,16 +299,7 @@ static void inverse_transform_block_intra(MACROBLOCKD *xd, int plane,
   }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
-  if (eob == 1) {
-    dqcoeff[0] = 0;
-  } else {
-    if (tx_type == DCT_DCT && tx_size <= TX_16X16 && eob <= 10)
-      memset(dqcoeff, 0, 4 * (4 << tx_size) * sizeof(dqcoeff[0]));
-    else if (tx_size == TX_32X32 && eob <= 34)
-      memset(dqcoeff, 0, 256 * sizeof(dqcoeff[0]));
-    else
-      memset(dqcoeff, 0, (16 << (tx_size << 1)) * sizeof(dqcoeff[0]));
-  }
+  clear_dqcoeff(dqcoeff, tx_type, tx_size, eob);
 }
 
 static void predict_and_reconstruct_intra_block(TileWorkerData *twd,
@@ -453,6 +451,40 @@ static int reconstruct_inter_block_row_mt(TileWorkerData *twd,
   return eob;
 }
 
+// Parse-only counterparts of the functions above, used for frames that are
+// not reconstructed: the tokens are read for the entropy counts and dropped.
+static void parse_intra_block_no_recon(TileWorkerData *twd,
+                                       MODE_INFO *const mi, int plane, int row,
+                                       int col, TX_SIZE tx_size) {
+  MACROBLOCKD *const xd = &twd->xd;
+  PREDICTION_MODE mode = (plane == 0) ? mi->mode : mi->uv_mode;
+
+  if (mi->sb_type < BLOCK_8X8)
+    if (plane == 0) mode = xd->mi[0]->bmi[(row << 1) + col].as_mode;
+
+  if (!mi->skip) {
+    const TX_TYPE tx_type =
+        (plane || xd->lossless) ? DCT_DCT : intra_mode_to_tx_type_lookup[mode];
+    const scan_order *sc = (plane || xd->lossless)
+                               ? &vp9_default_scan_orders[tx_size]
+                               : &vp9_scan_orders[tx_size][tx_type];
+    const int eob = vp9_decode_block_tokens(twd, plane, sc, col, row, tx_size,
+                                            mi->segment_id);
+    if (eob > 0) clear_dqcoeff(xd->plane[plane].dqcoeff, tx_type, tx_size, eob);
+  }
+}
+
+static int parse_inter_block_no_recon(TileWorkerData *twd, MODE_INFO *const mi,
+                                      int plane, int row, int col,
+                                      TX_SIZE tx_size) {
+  MACROBLOCKD *const xd = &twd->xd;
+  const scan_order *sc = &vp9_default_scan_orders[tx_size];
+  const int eob = vp9_decode_block_tokens(twd, plane, sc, col, row, tx_size,
+                                          mi->segment_id);
+  if (eob > 0) clear_dqcoeff(xd->plane[plane].dqcoeff, DCT_DCT, tx_size, eob);
+  return eob;
+}
+
 static void build_mc_border(const uint8_t *src, int src_stride, uint8_t *dst,
                             int dst_stride, int x, int y, int b_w, int b_h,
                             int w, int h) {
@@ -936,6 +968,18 @@ static void decode_block(TileWorkerData *twd, VP9Decoder *const pbi, int mi_row,
     dec_reset_skip_context(xd);
   }
 
+  if (pbi->skip_recon) {
+    if (!is_inter_block(mi)) {
+      predict_recon_intra(xd, mi, twd, parse_intra_block_no_recon);
+    } else if (!mi->skip) {
+      const int eobtotal =
+          predict_recon_inter(xd, mi, twd, parse_inter_block_no_recon);
+      if (!less8x8 && eobtotal == 0) mi->skip = 1;
+    }
+    xd->corrupted |= vpx_reader_has_error(r);
+    return;
+  }
+
   if (!is_inter_block(mi)) {
     int plane;
     for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
@@ -2022,9 +2066,10 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
   int tile_row, tile_col;
   int mi_row, mi_col;
   TileWorkerData *tile_data = NULL;
+  const int do_loop_filter =
+      cm->lf.filter_level && !cm->skip_loop_filter && !pbi->skip_recon;
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter &&
-      pbi->lf_worker.data1 == NULL) {
+  if (do_loop_filter && pbi->lf_worker.data1 == NULL) {
     CHECK_MEM_ERROR(cm, pbi->lf_worker.data1,
                     vpx_memalign(32, sizeof(LFWorkerData)));
     pbi->lf_worker.hook = vp9_loop_filter_worker;
@@ -2034,7 +2079,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
     }
   }
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
+  if (do_loop_filter) {
     LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
     // Be sure to sync as we might be resuming after a failed frame decode.
     winterface->sync(&pbi->lf_worker);
@@ -2089,7 +2134,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
         vp9_zero(tile_data->xd.left_seg_context);
         for (mi_col = tile.mi_col_start; mi_col < tile.mi_col_end;
              mi_col += MI_BLOCK_SIZE) {
-          if (pbi->row_mt == 1) {
+          if (pbi->row_mt == 1 && !pbi->skip_recon) {
             int plane;
             RowMTWorkerData *const row_mt_worker_data = pbi->row_mt_worker_data;
             for (plane = 0; plane < MAX_MB_PLANE; ++plane) {
@@ -2119,7 +2164,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
                              "Failed to decode tile data");
       }
       // Loopfilter one row.
-      if (cm->lf.filter_level && !cm->skip_loop_filter) {
+      if (do_loop_filter) {
         const int lf_start = mi_row - MI_BLOCK_SIZE;
         LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
 
@@ -2142,7 +2187,7 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi, const uint8_t *data,
   }
 
   // Loopfilter remaining rows in the frame.
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
+  if (do_loop_filter) {
     LFWorkerData *const lf_data = (LFWorkerData *)pbi->lf_worker.data1;
     winterface->sync(&pbi->lf_worker);
     lf_data->start = lf_data->stop;
@@ -2964,6 +3009,12 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
 #endif
   xd->cur_buf = new_fb;
 
+  // A frame that updates no reference buffer is never predicted from, so only
+  // the state carried to the next frame (entropy contexts, motion vectors and
+  // the segmentation map) has to be decoded.
+  pbi->skip_recon = pbi->skip_non_ref_frames && first_partition_size != 0 &&
+                    pbi->refresh_frame_flags == 0;
+
   if (!first_partition_size) {
     // showing a frame directly
     *p_data_end = data + (cm->profile <= PROFILE_2 ? 1 : 2);
@@ -2993,7 +3044,7 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
     vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
                        "Decode failed. Frame data header is corrupted.");
 
-  if (cm->lf.filter_level && !cm->skip_loop_filter) {
+  if (cm->lf.filter_level && !cm->skip_loop_filter && !pbi->skip_recon) {
     vp9_loop_filter_frame_init(cm, cm->lf.filter_level);
   }
 
@@ -3010,8 +3061,12 @@ void vp9_decode_frame(VP9Decoder *pbi, const uint8_t *data,
     pbi->total_tiles = tile_rows * tile_cols;
   }
 
-  if (pbi->max_threads > 1 && tile_rows == 1 &&
-      (tile_cols > 1 || pbi->row_mt == 1)) {
+  if (pbi->skip_recon) {
+    // Parsing alone is cheap; keep skipped frames on the single threaded path
+    // rather than setting up the tile and loop filter workers.
+    *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
+  } else if (pbi->max_threads > 1 && tile_rows == 1 &&
+             (tile_cols > 1 || pbi->row_mt == 1)) {
     if (pbi->row_mt == 1) {
       *p_data_end =
           decode_tiles_row_wise_mt(pbi, data + first_partition_size, data_end);
@@ -470,6 +470,9 @@ int vp9_receive_compressed_data(VP9Decoder *pbi, size_t size,
 
   swap_frame_buffers(pbi);
 
+  // A frame decoded without reconstruction has no image to output.
+  if (pbi->skip_recon) pbi->ready_for_new_data = 1;
+
   vpx_clear_system_state();
 
   if (!cm->show_existing_frame) {
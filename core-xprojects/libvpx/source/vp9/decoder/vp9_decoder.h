@@ -124,6 +124,12 @@ typedef struct VP9Decoder {
   int row_mt;
   int lpf_mt_opt;
   RowMTWorkerData *row_mt_worker_data;
+
+  // When set, frames with refresh_frame_flags == 0 are parsed but not
+  // reconstructed, loop filtered or output. skip_recon is the per-frame
+  // decision.
+  int skip_non_ref_frames;
+  int skip_recon;
 } VP9Decoder;
 
 int vp9_receive_compressed_data(struct VP9Decoder *pbi, size_t size,
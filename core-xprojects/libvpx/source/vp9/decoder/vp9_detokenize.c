@@ -10,6 +10,7 @@
 
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
+#include "vpx_util/endian_inl.h"
 
 #include "vp9/common/vp9_blockd.h"
 #include "vp9/common/vp9_common.h"
@@ -29,8 +30,41 @@
     if (counts) ++coef_counts[band][ctx][token]; \
   } while (0)
 
-static INLINE int read_bool(vpx_reader *r, int prob, BD_VALUE *value,
-                            int *count, unsigned int *range) {
+#if SIZE_MAX == 0xffffffffffffffffULL
+// Every bool consumes at most 7 bits of the window. With a 64-bit BD_VALUE a
+// single refill check per token covers its EOB, ZERO and ONE nodes, which
+// are then read without per-bool refill checks.
+#define TOKEN_FAST_PATH_BITS (2 * 7)
+#endif
+
+static INLINE void refill(vpx_reader *r, BD_VALUE *value, int *count) {
+#if SIZE_MAX == 0xffffffffffffffffULL
+  // While more than a window of data is left, refill with a single unaligned
+  // load in place. The buffer tail and decryption go through vpx_reader_fill().
+  if (!r->decrypt_cb &&
+      r->buffer_end - r->buffer > (ptrdiff_t)sizeof(BD_VALUE)) {
+    const int shift = BD_VALUE_SIZE - CHAR_BIT - (*count + CHAR_BIT);
+    const int bits = (shift & 0xfffffff8) + CHAR_BIT;
+    BD_VALUE big_endian_values;
+    memcpy(&big_endian_values, r->buffer, sizeof(BD_VALUE));
+    big_endian_values = HToBE64(big_endian_values);
+    *value |= (big_endian_values >> (BD_VALUE_SIZE - bits)) << (shift & 0x7);
+    *count += bits;
+    r->buffer += bits >> 3;
+    return;
+  }
+#endif
+  r->value = *value;
+  r->count = *count;
+  vpx_reader_fill(r);
+  *value = r->value;
+  *count = r->count;
+}
+
+// Reads a bool from the locals without checking whether the window needs a
+// refill. The caller guarantees that *count is not negative.
+static INLINE int read_bool_nofill(int prob, BD_VALUE *value, int *count,
+                                   unsigned int *range) {
   const unsigned int split = (*range * prob + (256 - prob)) >> CHAR_BIT;
   const BD_VALUE bigsplit = (BD_VALUE)split << (BD_VALUE_SIZE - CHAR_BIT);
 #if CONFIG_BITSTREAM_DEBUG
@@ -48,14 +82,6 @@ static INLINE int read_bool(vpx_reader *r, int prob, BD_VALUE *value,
   }
 #endif
 
-  if (*count < 0) {
-    r->value = *value;
-    r->count = *count;
-    vpx_reader_fill(r);
-    *value = r->value;
-    *count = r->count;
-  }
-
   if (*value >= bigsplit) {
     *range = *range - split;
     *value = *value - bigsplit;
@@ -104,6 +130,34 @@ static INLINE int read_bool(vpx_reader *r, int prob, BD_VALUE *value,
   return 0;
 }
 
+static INLINE int read_bool(vpx_reader *r, int prob, BD_VALUE *value,
+                            int *count, unsigned int *range) {
+  if (*count < 0) refill(r, value, count);
+  return read_bool_nofill(prob, value, count, range);
+}
+
+// Makes sure the window holds enough bits for the common nodes of one token.
+static INLINE void fill_token(vpx_reader *r, BD_VALUE *value, int *count) {
+#if SIZE_MAX == 0xffffffffffffffffULL
+  if (*count < TOKEN_FAST_PATH_BITS) refill(r, value, count);
+#else
+  (void)r;
+  (void)value;
+  (void)count;
+#endif
+}
+
+// Reads one of the nodes covered by fill_token().
+static INLINE int read_token_bool(vpx_reader *r, int prob, BD_VALUE *value,
+                                  int *count, unsigned int *range) {
+#if SIZE_MAX == 0xffffffffffffffffULL
+  (void)r;
+  return read_bool_nofill(prob, value, count, range);
+#else
+  return read_bool(r, prob, value, count, range);
+#endif
+}
+
 static INLINE int read_coeff(vpx_reader *r, const vpx_prob *probs, int n,
                              BD_VALUE *value, int *count, unsigned int *range) {
   int i, val = 0;
@@ -160,12 +214,14 @@ static int decode_coefs(const MACROBLOCKD *xd, PLANE_TYPE type,
     band = *band_translate++;
     prob = coef_probs[band][ctx];
     if (counts) ++eob_branch_count[band][ctx];
-    if (!read_bool(r, prob[EOB_CONTEXT_NODE], &value, &count, &range)) {
+    fill_token(r, &value, &count);
+    if (!read_token_bool(r, prob[EOB_CONTEXT_NODE], &value, &count, &range)) {
       INCREMENT_COUNT(EOB_MODEL_TOKEN);
       break;
     }
 
-    while (!read_bool(r, prob[ZERO_CONTEXT_NODE], &value, &count, &range)) {
+    while (!read_token_bool(r, prob[ZERO_CONTEXT_NODE], &value, &count,
+                            &range)) {
       INCREMENT_COUNT(ZERO_TOKEN);
       dqv = dq[1];
       token_cache[scan[c]] = 0;
@@ -179,9 +235,10 @@ static int decode_coefs(const MACROBLOCKD *xd, PLANE_TYPE type,
       ctx = get_coef_context(nb, token_cache, c);
       band = *band_translate++;
       prob = coef_probs[band][ctx];
+      fill_token(r, &value, &count);
     }
 
-    if (read_bool(r, prob[ONE_CONTEXT_NODE], &value, &count, &range)) {
+    if (read_token_bool(r, prob[ONE_CONTEXT_NODE], &value, &count, &range)) {
       const vpx_prob *p = vp9_pareto8_full[prob[PIVOT_NODE] - 1];
       INCREMENT_COUNT(TWO_TOKEN);
       if (read_bool(r, p[0], &value, &count, &range)) {
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vp9/encoder/vp9_arena.h"
+
+// Smallest block requested from the heap.
+#define ARENA_MIN_BLOCK_SIZE (64 * 1024)
+
+static uint8_t *block_data(VP9ArenaBlock *block) {
+  return (uint8_t *)(block + 1);
+}
+
+static VP9ArenaBlock *new_block(VP9Arena *arena, size_t size) {
+  VP9ArenaBlock *const block =
+      (VP9ArenaBlock *)vpx_malloc(sizeof(*block) + size);
+  if (block == NULL) return NULL;
+  ++arena->stats.heap_allocs;
+  arena->stats.heap_bytes += sizeof(*block) + size;
+  block->next = arena->blocks;
+  block->size = size;
+  block->used = 0;
+  arena->blocks = block;
+  return block;
+}
+
+static void *alloc_from_block(VP9ArenaBlock *block, size_t size,
+                              size_t align) {
+  const uintptr_t base = (uintptr_t)block_data(block);
+  const uintptr_t start =
+      (base + block->used + align - 1) & ~(uintptr_t)(align - 1);
+  if (start - base > block->size || size > block->size - (start - base))
+    return NULL;
+  block->used = (size_t)(start - base) + size;
+  return (void *)start;
+}
+
+void *vp9_arena_alloc(VP9Arena *arena, size_t size, size_t align) {
+  VP9ArenaBlock *block = arena->blocks;
+  size_t used_before = 0;
+  void *mem = NULL;
+
+  assert(align > 0 && (align & (align - 1)) == 0);
+
+  if (block != NULL) {
+    used_before = block->used;
+    mem = alloc_from_block(block, size, align);
+  }
+  if (mem == NULL) {
+    // The rest of the current block is left unused. Double the block size so
+    // a round that outgrows the arena only needs a few blocks.
+    if (block != NULL) arena->block_size *= 2;
+    arena->block_size = VPXMAX(arena->block_size, ARENA_MIN_BLOCK_SIZE);
+    block = new_block(arena, VPXMAX(arena->block_size, size + align - 1));
+    if (block == NULL) return NULL;
+    used_before = 0;
+    mem = alloc_from_block(block, size, align);
+    assert(mem != NULL);
+  }
+
+  arena->used += block->used - used_before;
+  ++arena->stats.allocs;
+  arena->stats.bytes += size;
+  return mem;
+}
+
+void *vp9_arena_calloc(VP9Arena *arena, size_t num, size_t size,
+                       size_t align) {
+  void *mem;
+  if (size != 0 && num > (size_t)-1 / size) return NULL;
+  mem = vp9_arena_alloc(arena, num * size, align);
+  if (mem != NULL) memset(mem, 0, num * size);
+  return mem;
+}
+
+static uint8_t *region_data(VP9ArenaRegion *region, size_t align) {
+  const uintptr_t base = (uintptr_t)(region + 1);
+  return (uint8_t *)((base + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+void *vp9_arena_region_alloc(VP9Arena *arena, VP9ArenaRegion **region,
+                             size_t size, size_t align) {
+  VP9ArenaRegion *old = *region;
+
+  assert(align > 0 && (align & (align - 1)) == 0);
+  if (size > (size_t)-1 - sizeof(*old) - align) return NULL;
+
+  if (old == NULL || size + align - 1 > old->size) {
+    const size_t region_size = size + align - 1;
+    VP9ArenaRegion *const new_region =
+        (VP9ArenaRegion *)vpx_malloc(sizeof(*new_region) + region_size);
+    VP9ArenaRegion **link = &arena->regions;
+    if (new_region == NULL) return NULL;
+    ++arena->stats.heap_allocs;
+    arena->stats.heap_bytes += sizeof(*new_region) + region_size;
+    new_region->size = region_size;
+
+    // Take the place of the old region in the list, and free it.
+    while (*link != NULL && *link != old) link = &(*link)->next;
+    new_region->next = *link != NULL ? old->next : NULL;
+    *link = new_region;
+    vpx_free(old);
+    *region = new_region;
+  }
+
+  ++arena->stats.allocs;
+  arena->stats.bytes += size;
+  return region_data(*region, align);
+}
+
+void *vp9_arena_region_calloc(VP9Arena *arena, VP9ArenaRegion **region,
+                              size_t num, size_t size, size_t align) {
+  void *mem;
+  if (size != 0 && num > (size_t)-1 / size) return NULL;
+  mem = vp9_arena_region_alloc(arena, region, num * size, align);
+  if (mem != NULL) memset(mem, 0, num * size);
+  return mem;
+}
+
+static void free_blocks(VP9Arena *arena) {
+  VP9ArenaBlock *block = arena->blocks;
+  while (block != NULL) {
+    VP9ArenaBlock *const next = block->next;
+    vpx_free(block);
+    block = next;
+  }
+  arena->blocks = NULL;
+  arena->used = 0;
+}
+
+void vp9_arena_reset(VP9Arena *arena) {
+  if (arena->blocks != NULL && arena->blocks->next != NULL) {
+    // Size the next block for the whole round, with some room for the
+    // alignment padding to differ.
+    const size_t used = arena->used;
+    free_blocks(arena);
+    arena->block_size = used + used / 16;
+  } else if (arena->blocks != NULL) {
+    arena->blocks->used = 0;
+  }
+  arena->used = 0;
+}
+
+void vp9_arena_free(VP9Arena *arena) {
+  free_blocks(arena);
+  while (arena->regions != NULL) {
+    VP9ArenaRegion *const next = arena->regions->next;
+    vpx_free(arena->regions);
+    arena->regions = next;
+  }
+}
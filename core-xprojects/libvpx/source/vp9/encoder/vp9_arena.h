@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_ARENA_H_
+#define VPX_VP9_ENCODER_VP9_ARENA_H_
+
+#include <stddef.h>
+
+#include "vpx/vpx_integer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bump allocator for encoder buffers that share a lifetime. Memory is handed
+// out from large blocks and only returned all at once by vp9_arena_reset(),
+// which keeps the blocks for the next round. Once a region has seen its
+// largest round, it serves every later round without touching the heap.
+//
+// Buffers that are sized again on their own schedule, rather than once per
+// round, each take a high-water region instead. It only grows, and growing
+// it frees the old memory at once rather than leaving it in a block.
+
+typedef struct VP9ArenaBlock {
+  struct VP9ArenaBlock *next;
+  size_t size;
+  size_t used;
+} VP9ArenaBlock;
+
+typedef struct VP9ArenaRegion {
+  struct VP9ArenaRegion *next;
+  // Bytes after the header, including room for the alignment.
+  size_t size;
+} VP9ArenaRegion;
+
+typedef struct VP9ArenaStats {
+  // Calls to the heap and bytes requested from it.
+  uint64_t heap_allocs;
+  uint64_t heap_bytes;
+  // Allocations served by the arena and their size.
+  uint64_t allocs;
+  uint64_t bytes;
+} VP9ArenaStats;
+
+typedef struct VP9Arena {
+  // Blocks in use, the current one first.
+  VP9ArenaBlock *blocks;
+  // Size of the next block. Grows with the peak usage.
+  size_t block_size;
+  // Bytes handed out since the last reset, including alignment padding.
+  size_t used;
+  // High-water regions. They are kept across resets.
+  VP9ArenaRegion *regions;
+  VP9ArenaStats stats;
+} VP9Arena;
+
+// Returns |size| bytes aligned to |align|, a power of two, or NULL if the
+// heap is exhausted. The memory is not initialized.
+void *vp9_arena_alloc(VP9Arena *arena, size_t size, size_t align);
+
+// Same as vp9_arena_alloc() with the memory cleared.
+void *vp9_arena_calloc(VP9Arena *arena, size_t num, size_t size,
+                       size_t align);
+
+// Returns |size| bytes aligned to |align| from |*region|, which is created
+// on first use. The region grows to the largest size it is asked for, and
+// its contents are not kept when it grows. The memory is not initialized.
+void *vp9_arena_region_alloc(VP9Arena *arena, VP9ArenaRegion **region,
+                             size_t size, size_t align);
+
+// Same as vp9_arena_region_alloc() with the memory cleared.
+void *vp9_arena_region_calloc(VP9Arena *arena, VP9ArenaRegion **region,
+                              size_t num, size_t size, size_t align);
+
+// Releases every allocation but the regions. If the last round needed more
+// than one block, they are replaced with a single block that holds all of it.
+void vp9_arena_reset(VP9Arena *arena);
+
+// Returns the memory of the arena, regions included, to the heap. The
+// statistics are kept.
+void vp9_arena_free(VP9Arena *arena);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_ARENA_H_
@@ -943,67 +943,134 @@ static int encode_tile_worker(void *arg1, void *arg2) {
   VP9_COMP *cpi = (VP9_COMP *)arg1;
   VP9BitstreamWorkerData *data = (VP9BitstreamWorkerData *)arg2;
   MACROBLOCKD *const xd = &data->xd;
-  const int tile_row = 0;
+  const int tile_cols = 1 << cpi->common.log2_tile_cols;
+  const int tile_row = data->tile_idx / tile_cols;
+  const int tile_col = data->tile_idx % tile_cols;
   vpx_start_encode(&data->bit_writer, data->dest);
   write_modes(cpi, xd, &cpi->tile_data[data->tile_idx].tile_info,
-              &data->bit_writer, tile_row, data->tile_idx,
-              &data->max_mv_magnitude, data->interp_filter_selected);
+              &data->bit_writer, tile_row, tile_col, &data->max_mv_magnitude,
+              data->interp_filter_selected);
   vpx_stop_encode(&data->bit_writer);
   return 1;
 }
 
+// The worker data and the tile buffers are held by regions of the sequence
+// arena, which keep them for the next allocation.
 void vp9_bitstream_encode_tiles_buffer_dealloc(VP9_COMP *const cpi) {
-  if (cpi->vp9_bitstream_worker_data) {
-    int i;
-    for (i = 1; i < cpi->num_workers; ++i) {
-      vpx_free(cpi->vp9_bitstream_worker_data[i].dest);
-    }
-    vpx_free(cpi->vp9_bitstream_worker_data);
-    cpi->vp9_bitstream_worker_data = NULL;
-  }
+  cpi->vp9_bitstream_worker_data = NULL;
 }
 
 static int encode_tiles_buffer_alloc(VP9_COMP *const cpi) {
+  const int dest_size = cpi->oxcf.width * cpi->oxcf.height;
+  uint8_t *dest;
   int i;
-  const size_t worker_data_size =
-      cpi->num_workers * sizeof(*cpi->vp9_bitstream_worker_data);
-  cpi->vp9_bitstream_worker_data = vpx_memalign(16, worker_data_size);
-  memset(cpi->vp9_bitstream_worker_data, 0, worker_data_size);
+  cpi->vp9_bitstream_worker_data = vp9_arena_region_calloc(
+      &cpi->seq_arena, &cpi->bitstream_worker_region, cpi->num_workers,
+      sizeof(*cpi->vp9_bitstream_worker_data), 16);
   if (!cpi->vp9_bitstream_worker_data) return 1;
+  dest = vp9_arena_region_alloc(&cpi->seq_arena, &cpi->bitstream_dest_region,
+                                (size_t)(cpi->num_workers - 1) * dest_size,
+                                16);
+  if (!dest) {
+    cpi->vp9_bitstream_worker_data = NULL;
+    return 1;
+  }
   for (i = 1; i < cpi->num_workers; ++i) {
-    cpi->vp9_bitstream_worker_data[i].dest_size =
-        cpi->oxcf.width * cpi->oxcf.height;
-    cpi->vp9_bitstream_worker_data[i].dest =
-        vpx_malloc(cpi->vp9_bitstream_worker_data[i].dest_size);
-    if (!cpi->vp9_bitstream_worker_data[i].dest) return 1;
+    cpi->vp9_bitstream_worker_data[i].dest_size = dest_size;
+    cpi->vp9_bitstream_worker_data[i].dest = dest + (size_t)(i - 1) * dest_size;
   }
   return 0;
 }
 
+// Replays the partition context updates of write_modes_sb() without writing
+// anything.
+static void replay_partition_context(const VP9_COMMON *const cm,
+                                     MACROBLOCKD *const xd, int mi_row,
+                                     int mi_col, BLOCK_SIZE bsize) {
+  const int bsl = b_width_log2_lookup[bsize];
+  const int bs = (1 << bsl) / 4;
+  PARTITION_TYPE partition;
+  BLOCK_SIZE subsize;
+
+  if (mi_row >= cm->mi_rows || mi_col >= cm->mi_cols) return;
+
+  partition =
+      partition_lookup[bsl]
+                      [cm->mi_grid_visible[mi_row * cm->mi_stride + mi_col]
+                           ->sb_type];
+  subsize = get_subsize(bsize, partition);
+  if (subsize >= BLOCK_8X8 && partition == PARTITION_SPLIT) {
+    replay_partition_context(cm, xd, mi_row, mi_col, subsize);
+    replay_partition_context(cm, xd, mi_row, mi_col + bs, subsize);
+    replay_partition_context(cm, xd, mi_row + bs, mi_col, subsize);
+    replay_partition_context(cm, xd, mi_row + bs, mi_col + bs, subsize);
+  } else {
+    update_partition_context(xd, mi_row, mi_col, subsize, bsize);
+  }
+}
+
+// Sets up the above partition context to pack |tile| independently of the
+// tiles before it. The context is only cleared once per frame, so a tile
+// below the first tile row starts from the context left by the tile above.
+// Each superblock row overwrites the context of every column it covers, so
+// the last superblock row of the tile above is enough to rebuild it.
+static void init_tile_partition_context(const VP9_COMMON *const cm,
+                                        MACROBLOCKD *const xd,
+                                        const TileInfo *const tile) {
+  const int mi_col_end = mi_cols_aligned_to_sb(tile->mi_col_end);
+  int mi_col;
+
+  memset(xd->above_seg_context + tile->mi_col_start, 0,
+         sizeof(*xd->above_seg_context) * (mi_col_end - tile->mi_col_start));
+  if (tile->mi_row_start == 0) return;
+
+  for (mi_col = tile->mi_col_start; mi_col < tile->mi_col_end;
+       mi_col += MI_BLOCK_SIZE)
+    replay_partition_context(cm, xd, tile->mi_row_start - MI_BLOCK_SIZE,
+                             mi_col, BLOCK_64X64);
+}
+
 static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
   const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
   VP9_COMMON *const cm = &cpi->common;
-  const int tile_cols = 1 << cm->log2_tile_cols;
+  const int num_tiles = (1 << cm->log2_tile_cols) << cm->log2_tile_rows;
   const int num_workers = cpi->num_workers;
+  const int aligned_mi_cols = mi_cols_aligned_to_sb(cm->mi_cols);
   size_t total_size = 0;
-  int tile_col = 0;
+  int tile_idx = 0;
+  int i;
 
+  // The tile buffers of the workers hold a whole frame. Reallocate them when
+  // the frame has outgrown them; a smaller frame fits in the ones it has.
   if (!cpi->vp9_bitstream_worker_data ||
-      cpi->vp9_bitstream_worker_data[1].dest_size >
+      cpi->vp9_bitstream_worker_data[1].dest_size <
           (cpi->oxcf.width * cpi->oxcf.height)) {
     vp9_bitstream_encode_tiles_buffer_dealloc(cpi);
     if (encode_tiles_buffer_alloc(cpi)) return 0;
   }
 
-  while (tile_col < tile_cols) {
-    int i, j;
-    for (i = 0; i < num_workers && tile_col < tile_cols; ++i) {
+  // Each worker keeps its own above partition context so that tiles in
+  // different tile rows can be packed at the same time.
+  for (i = 0; i < num_workers; ++i) {
+    VP9BitstreamWorkerData *const data = &cpi->vp9_bitstream_worker_data[i];
+    data->above_seg_context = (PARTITION_CONTEXT *)vp9_arena_alloc(
+        &cpi->frame_arena, aligned_mi_cols * sizeof(*data->above_seg_context),
+        16);
+    if (!data->above_seg_context) return 0;
+  }
+
+  while (tile_idx < num_tiles) {
+    int j;
+    for (i = 0; i < num_workers && tile_idx < num_tiles; ++i) {
       VPxWorker *const worker = &cpi->workers[i];
       VP9BitstreamWorkerData *const data = &cpi->vp9_bitstream_worker_data[i];
 
       // Populate the worker data.
       data->xd = cpi->td.mb.e_mbd;
-      data->tile_idx = tile_col;
+      data->xd.above_seg_context = data->above_seg_context;
+      init_tile_partition_context(cm, &data->xd,
+                                  &cpi->tile_data[tile_idx].tile_info);
+      data->tile_idx = tile_idx;
       data->max_mv_magnitude = cpi->max_mv_magnitude;
       memset(data->interp_filter_selected, 0,
              sizeof(data->interp_filter_selected[0][0]) * SWITCHABLE);
@@ -1013,7 +1080,7 @@ static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
         // If this worker happens to be for the last tile, then do not offset it
         // by 4 for the tile size.
         data->dest =
-            data_ptr + total_size + (tile_col == tile_cols - 1 ? 0 : 4);
+            data_ptr + total_size + (tile_idx == num_tiles - 1 ? 0 : 4);
       }
       worker->data1 = cpi;
       worker->data2 = data;
@@ -1025,7 +1092,7 @@ static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
       } else {
         winterface->execute(worker);
       }
-      ++tile_col;
+      ++tile_idx;
     }
     for (j = 0; j < i; ++j) {
       VPxWorker *const worker = &cpi->workers[j];
@@ -1045,7 +1112,7 @@ static size_t encode_tiles_mt(VP9_COMP *cpi, uint8_t *data_ptr) {
       }
 
       // Prefix the size of the tile on all but the last.
-      if (tile_col != tile_cols || j < i - 1) {
+      if (tile_idx != num_tiles || j < i - 1) {
         mem_put_be32(data_ptr + total_size, tile_size);
         total_size += 4;
       }
@@ -1073,8 +1140,8 @@ static size_t encode_tiles(VP9_COMP *cpi, uint8_t *data_ptr) {
   // Encoding tiles in parallel is done only for realtime mode now. In other
   // modes the speed up is insignificant and requires further testing to ensure
   // that it does not make the overall process worse in any case.
-  if (cpi->oxcf.mode == REALTIME && cpi->num_workers > 1 && tile_rows == 1 &&
-      tile_cols > 1) {
+  if (cpi->oxcf.mode == REALTIME && cpi->num_workers > 1 &&
+      tile_rows * tile_cols > 1) {
     return encode_tiles_mt(cpi, data_ptr);
   }
 
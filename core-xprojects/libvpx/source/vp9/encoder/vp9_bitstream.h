@@ -28,6 +28,8 @@ typedef struct VP9BitstreamWorkerData {
   // is increment the very first index (index 0) for the first dimension. Hence
   // this is sufficient.
   int interp_filter_selected[1][SWITCHABLE];
+  // Above partition context of the tile being packed.
+  PARTITION_CONTEXT *above_seg_context;
   DECLARE_ALIGNED(16, MACROBLOCKD, xd);
 } VP9BitstreamWorkerData;
 
@@ -184,6 +184,61 @@ static uint8_t *block_start(uint8_t *framebuf, int stride, int mi_row,
   return framebuf + (stride * mi_row << 3) + (mi_col << 3);
 }
 
+// Sets the entries of the mi_rows x mi_cols map covered by a bs block at
+// (mi_row, mi_col).
+static void mark_blocks(uint8_t *map, int mi_rows, int mi_cols, int mi_row,
+                        int mi_col, BLOCK_SIZE bs) {
+  const int bw = VPXMIN(num_8x8_blocks_wide_lookup[bs], mi_cols - mi_col);
+  const int bh = VPXMIN(num_8x8_blocks_high_lookup[bs], mi_rows - mi_row);
+  int r;
+  for (r = 0; r < bh; ++r)
+    if (bw > 0) memset(map + (mi_row + r) * mi_cols + mi_col, 1, bw);
+}
+
+// Copies the 8x8 blocks not marked in the mi_rows x mi_cols map from src to
+// dst and returns the number of bytes copied.
+static int64_t copy_unmarked_blocks(uint8_t *dst, int dst_stride,
+                                    const uint8_t *src, int src_stride,
+                                    const uint8_t *map, int mi_rows,
+                                    int mi_cols) {
+  int64_t bytes = 0;
+  int mi_row, mi_col, r;
+  for (mi_row = 0; mi_row < mi_rows; ++mi_row) {
+    const uint8_t *const row_map = map + mi_row * mi_cols;
+    mi_col = 0;
+    while (mi_col < mi_cols) {
+      int end = mi_col;
+      while (end < mi_cols && !row_map[end]) ++end;
+      if (end > mi_col) {
+        const int width = (end - mi_col) << 3;
+        for (r = 0; r < 8; ++r) {
+          memcpy(dst + ((mi_row << 3) + r) * dst_stride + (mi_col << 3),
+                 src + ((mi_row << 3) + r) * src_stride + (mi_col << 3),
+                 width);
+        }
+        bytes += width << 3;
+      }
+      mi_col = end + 1;
+    }
+  }
+  return bytes;
+}
+
+// Saves the source block about to be replaced by its denoised version to
+// last_source, which refers to the source frame.
+static void save_last_source_block(VP9_DENOISER *denoiser, const uint8_t *src,
+                                   int src_stride, int mi_row, int mi_col,
+                                   BLOCK_SIZE bs) {
+  YV12_BUFFER_CONFIG *const last = &denoiser->last_source;
+  vpx_convolve_copy(src, src_stride,
+                    block_start(last->y_buffer, last->y_stride, mi_row, mi_col),
+                    last->y_stride, NULL, 0, 0, 0, 0,
+                    num_4x4_blocks_wide_lookup[bs] << 2,
+                    num_4x4_blocks_high_lookup[bs] << 2);
+  mark_blocks(denoiser->last_source_saved, last->y_height >> 3,
+              last->y_width >> 3, mi_row, mi_col, bs);
+}
+
 static VP9_DENOISER_DECISION perform_motion_compensation(
     VP9_COMMON *const cm, VP9_DENOISER *denoiser, MACROBLOCK *mb, BLOCK_SIZE bs,
     int increase_denoising, int mi_row, int mi_col, PICK_MODE_CONTEXT *ctx,
@@ -423,6 +478,8 @@ void vp9_denoiser_denoise(VP9_COMP *cpi, MACROBLOCK *mb, int mi_row, int mi_col,
   }
 
   if (decision == FILTER_BLOCK) {
+    if (cpi->Source->y_buffer == denoiser->last_source_alias)
+      save_last_source_block(denoiser, src.buf, src.stride, mi_row, mi_col, bs);
     vpx_convolve_copy(avg_start, avg.y_stride, src.buf, src.stride, NULL, 0, 0,
                       0, 0, num_4x4_blocks_wide_lookup[bs] << 2,
                       num_4x4_blocks_high_lookup[bs] << 2);
@@ -431,6 +488,10 @@ void vp9_denoiser_denoise(VP9_COMP *cpi, MACROBLOCK *mb, int mi_row, int mi_col,
                       0, 0, num_4x4_blocks_wide_lookup[bs] << 2,
                       num_4x4_blocks_high_lookup[bs] << 2);
   }
+  if (denoiser->intra_cow_src[shift != 0] != NULL) {
+    mark_blocks(denoiser->intra_written[shift != 0], avg.y_height >> 3,
+                avg.y_width >> 3, mi_row, mi_col, bs);
+  }
   *denoiser_decision = decision;
   if (decision == FILTER_BLOCK && zeromv_filter == 1)
     *denoiser_decision = FILTER_ZEROMV_BLOCK;
@@ -461,22 +522,156 @@ static void swap_frame_buffer(YV12_BUFFER_CONFIG *const dest,
   src->y_buffer = tmp_buf;
 }
 
+static int find_plane(const VP9_DENOISER *denoiser, const uint8_t *y_buffer) {
+  int i;
+  if (y_buffer == NULL) return -1;
+  for (i = 0; i < denoiser->num_ref_frames * denoiser->num_layers; ++i) {
+    if (denoiser->y_planes[i] == y_buffer) return i;
+  }
+  return -1;
+}
+
+// Points dest at the luma plane of src instead of copying it.
+static void share_frame_buffer(VP9_DENOISER *denoiser,
+                               YV12_BUFFER_CONFIG *const dest,
+                               const YV12_BUFFER_CONFIG *const src) {
+  const int dest_plane = find_plane(denoiser, dest->y_buffer);
+  const int src_plane = find_plane(denoiser, src->y_buffer);
+  assert(dest->y_stride == src->y_stride);
+  assert(dest->y_height == src->y_height);
+  assert(src_plane >= 0);
+  if (dest_plane == src_plane) return;
+  if (dest_plane >= 0) --denoiser->y_plane_refs[dest_plane];
+  ++denoiser->y_plane_refs[src_plane];
+  dest->y_buffer = src->y_buffer;
+}
+
+// Gives buf a luma plane of its own from the free planes of the layer starting
+// at shift. The content of the new plane is stale. Returns the plane buf was
+// sharing, or NULL if it already had one to itself.
+static uint8_t *unshare_frame_buffer(VP9_DENOISER *denoiser, int shift,
+                                     YV12_BUFFER_CONFIG *const buf) {
+  const int plane = find_plane(denoiser, buf->y_buffer);
+  int i;
+  if (plane < 0 || denoiser->y_plane_refs[plane] <= 1) return NULL;
+  // The buffers of a layer all have the same size, and there are as many
+  // planes as buffers, so a shared plane leaves at least one free.
+  for (i = shift; i < shift + denoiser->num_ref_frames; ++i) {
+    if (denoiser->y_planes[i] != NULL && denoiser->y_plane_refs[i] == 0 &&
+        denoiser->running_avg_y[i].y_stride == buf->y_stride &&
+        denoiser->running_avg_y[i].y_height == buf->y_height) {
+      --denoiser->y_plane_refs[plane];
+      denoiser->y_plane_refs[i] = 1;
+      buf->y_buffer = denoiser->y_planes[i];
+      return denoiser->y_planes[plane];
+    }
+  }
+  assert(0 && "No free denoiser plane");
+  return NULL;
+}
+
+// The denoiser overwrites the INTRA_FRAME buffer block by block, so it must
+// not share its plane. Rather than copying the shared plane, only the blocks
+// that are still not denoised at the next update are copied, by
+// fill_intra_frame().
+static void unshare_intra_frame(VP9_DENOISER *denoiser, int layer, int shift) {
+  YV12_BUFFER_CONFIG *const intra =
+      &denoiser->running_avg_y[INTRA_FRAME + shift];
+  uint8_t *const shared = unshare_frame_buffer(denoiser, shift, intra);
+  if (shared != NULL) {
+    denoiser->intra_cow_src[layer] = shared;
+    memset(denoiser->intra_written[layer], 0,
+           (intra->y_height >> 3) * (intra->y_width >> 3));
+  }
+}
+
+static void fill_intra_frame(VP9_DENOISER *denoiser, int layer, int shift) {
+  YV12_BUFFER_CONFIG *const intra =
+      &denoiser->running_avg_y[INTRA_FRAME + shift];
+  if (denoiser->intra_cow_src[layer] == NULL) return;
+  denoiser->frame_copy_bytes += copy_unmarked_blocks(
+      intra->y_buffer, intra->y_stride, denoiser->intra_cow_src[layer],
+      intra->y_stride, denoiser->intra_written[layer], intra->y_height >> 3,
+      intra->y_width >> 3);
+  denoiser->intra_cow_src[layer] = NULL;
+}
+
+// Planes are only shared between buffers of the same size. That is not the
+// case when SVC allocates a buffer of a layer at another spatial layer's
+// resolution; such a layer keeps copying.
+static int can_share_planes(const VP9_DENOISER *denoiser, int shift) {
+  const YV12_BUFFER_CONFIG *const intra =
+      &denoiser->running_avg_y[INTRA_FRAME + shift];
+  int i;
+  for (i = shift + 1; i < shift + denoiser->num_ref_frames; ++i) {
+    const YV12_BUFFER_CONFIG *const buf = &denoiser->running_avg_y[i];
+    if (buf->buffer_alloc != NULL &&
+        (buf->y_width != intra->y_width || buf->y_height != intra->y_height ||
+         buf->y_stride != intra->y_stride))
+      return 0;
+  }
+  return 1;
+}
+
+// Gives every buffer of the layer starting at shift a plane of its own again.
+static void unshare_layer(VP9_DENOISER *denoiser, int shift) {
+  int i;
+  for (i = shift; i < shift + denoiser->num_ref_frames; ++i) {
+    YV12_BUFFER_CONFIG *const buf = &denoiser->running_avg_y[i];
+    YV12_BUFFER_CONFIG shared = *buf;
+    shared.y_buffer = unshare_frame_buffer(denoiser, shift, buf);
+    if (shared.y_buffer != NULL) {
+      copy_frame(buf, &shared);
+      denoiser->frame_copy_bytes += (int64_t)buf->y_width * buf->y_height;
+    }
+  }
+}
+
+// Makes dest hold the content of src, sharing its plane if possible.
+static void update_frame_buffer(VP9_DENOISER *denoiser,
+                                YV12_BUFFER_CONFIG *const dest,
+                                YV12_BUFFER_CONFIG *const src,
+                                int share_planes) {
+  if (share_planes) {
+    share_frame_buffer(denoiser, dest, src);
+  } else {
+    copy_frame(dest, src);
+    denoiser->frame_copy_bytes += (int64_t)dest->y_width * dest->y_height;
+  }
+}
+
 void vp9_denoiser_update_frame_info(
     VP9_DENOISER *denoiser, YV12_BUFFER_CONFIG src, struct SVC *svc,
     FRAME_TYPE frame_type, int refresh_alt_ref_frame, int refresh_golden_frame,
     int refresh_last_frame, int alt_fb_idx, int gld_fb_idx, int lst_fb_idx,
     int resized, int svc_refresh_denoiser_buffers, int second_spatial_layer) {
+  const int layer = second_spatial_layer ? 1 : 0;
   const int shift = second_spatial_layer ? denoiser->num_ref_frames : 0;
+  YV12_BUFFER_CONFIG *const intra =
+      &denoiser->running_avg_y[INTRA_FRAME + shift];
+  const int share_planes = can_share_planes(denoiser, shift);
+  fill_intra_frame(denoiser, layer, shift);
+  if (!share_planes) unshare_layer(denoiser, shift);
   // Copy source into denoised reference buffers on KEY_FRAME or
   // if the just encoded frame was resized. For SVC, copy source if the base
   // spatial layer was key frame.
   if (frame_type == KEY_FRAME || resized != 0 || denoiser->reset ||
       svc_refresh_denoiser_buffers) {
+    YV12_BUFFER_CONFIG *first = NULL;
     int i;
-    // Start at 1 so as not to overwrite the INTRA_FRAME
+    // Start at 1 so as not to overwrite the INTRA_FRAME. The source is copied
+    // once and the other buffers share the copy.
     for (i = 1; i < denoiser->num_ref_frames; ++i) {
-      if (denoiser->running_avg_y[i + shift].buffer_alloc != NULL)
-        copy_frame(&denoiser->running_avg_y[i + shift], &src);
+      YV12_BUFFER_CONFIG *const buf = &denoiser->running_avg_y[i + shift];
+      if (buf->buffer_alloc == NULL) continue;
+      if (first == NULL) {
+        first = buf;
+        unshare_frame_buffer(denoiser, shift, first);
+        update_frame_buffer(denoiser, first, &src, 0);
+      } else {
+        update_frame_buffer(denoiser, buf, share_planes ? first : &src,
+                            share_planes);
+      }
     }
     denoiser->reset = 0;
     return;
@@ -487,40 +682,45 @@ void vp9_denoiser_update_frame_info(
     int i;
     for (i = 0; i < REF_FRAMES; i++) {
       if (svc->update_buffer_slot[svc->spatial_layer_id] & (1 << i))
-        copy_frame(&denoiser->running_avg_y[i + 1 + shift],
-                   &denoiser->running_avg_y[INTRA_FRAME + shift]);
+        update_frame_buffer(denoiser, &denoiser->running_avg_y[i + 1 + shift],
+                            intra, share_planes);
     }
   } else {
-    // If more than one refresh occurs, must copy frame buffer.
+    // If more than one refresh occurs, must copy frame buffer, or share its
+    // plane.
     if ((refresh_alt_ref_frame + refresh_golden_frame + refresh_last_frame) >
         1) {
       if (refresh_alt_ref_frame) {
-        copy_frame(&denoiser->running_avg_y[alt_fb_idx + 1 + shift],
-                   &denoiser->running_avg_y[INTRA_FRAME + shift]);
+        update_frame_buffer(denoiser,
+                            &denoiser->running_avg_y[alt_fb_idx + 1 + shift],
+                            intra, share_planes);
       }
       if (refresh_golden_frame) {
-        copy_frame(&denoiser->running_avg_y[gld_fb_idx + 1 + shift],
-                   &denoiser->running_avg_y[INTRA_FRAME + shift]);
+        update_frame_buffer(denoiser,
+                            &denoiser->running_avg_y[gld_fb_idx + 1 + shift],
+                            intra, share_planes);
       }
       if (refresh_last_frame) {
-        copy_frame(&denoiser->running_avg_y[lst_fb_idx + 1 + shift],
-                   &denoiser->running_avg_y[INTRA_FRAME + shift]);
+        update_frame_buffer(denoiser,
+                            &denoiser->running_avg_y[lst_fb_idx + 1 + shift],
+                            intra, share_planes);
       }
     } else {
       if (refresh_alt_ref_frame) {
         swap_frame_buffer(&denoiser->running_avg_y[alt_fb_idx + 1 + shift],
-                          &denoiser->running_avg_y[INTRA_FRAME + shift]);
+                          intra);
       }
       if (refresh_golden_frame) {
         swap_frame_buffer(&denoiser->running_avg_y[gld_fb_idx + 1 + shift],
-                          &denoiser->running_avg_y[INTRA_FRAME + shift]);
+                          intra);
       }
       if (refresh_last_frame) {
         swap_frame_buffer(&denoiser->running_avg_y[lst_fb_idx + 1 + shift],
-                          &denoiser->running_avg_y[INTRA_FRAME + shift]);
+                          intra);
       }
     }
   }
+  if (share_planes) unshare_intra_frame(denoiser, layer, shift);
 }
 
 void vp9_denoiser_reset_frame_stats(PICK_MODE_CONTEXT *ctx) {
@@ -562,6 +762,8 @@ static int vp9_denoiser_realloc_svc_helper(VP9_COMMON *cm,
       vp9_denoiser_free(denoiser);
       return 1;
     }
+    denoiser->y_planes[fb_idx] = denoiser->running_avg_y[fb_idx].y_buffer;
+    denoiser->y_plane_refs[fb_idx] = 1;
   }
   return 0;
 }
@@ -640,6 +842,12 @@ int vp9_denoiser_alloc(VP9_COMMON *cm, struct SVC *svc, VP9_DENOISER *denoiser,
   CHECK_MEM_ERROR(
       cm, denoiser->mc_running_avg_y,
       vpx_calloc(num_layers, sizeof(denoiser->mc_running_avg_y[0])));
+  CHECK_MEM_ERROR(cm, denoiser->y_planes,
+                  vpx_calloc(denoiser->num_ref_frames * num_layers,
+                             sizeof(denoiser->y_planes[0])));
+  CHECK_MEM_ERROR(cm, denoiser->y_plane_refs,
+                  vpx_calloc(denoiser->num_ref_frames * num_layers,
+                             sizeof(denoiser->y_plane_refs[0])));
 
   for (layer = 0; layer < num_layers; ++layer) {
     const int denoise_width = (layer == 0) ? width : scaled_width;
@@ -656,10 +864,18 @@ int vp9_denoiser_alloc(VP9_COMMON *cm, struct SVC *svc, VP9_DENOISER *denoiser,
         vp9_denoiser_free(denoiser);
         return 1;
       }
+      denoiser->y_planes[i + denoiser->num_ref_frames * layer] =
+          denoiser->running_avg_y[i + denoiser->num_ref_frames * layer]
+              .y_buffer;
+      denoiser->y_plane_refs[i + denoiser->num_ref_frames * layer] = 1;
 #ifdef OUTPUT_YUV_DENOISED
       make_grayscale(&denoiser->running_avg_y[i]);
 #endif
     }
+    CHECK_MEM_ERROR(cm, denoiser->intra_written[layer],
+                    vpx_calloc(((denoise_height + 7) >> 3) *
+                                   ((denoise_width + 7) >> 3),
+                               sizeof(*denoiser->intra_written[layer])));
 
     fail = vpx_alloc_frame_buffer(&denoiser->mc_running_avg_y[layer],
                                   denoise_width, denoise_height, ssx, ssy,
@@ -684,6 +900,10 @@ int vp9_denoiser_alloc(VP9_COMMON *cm, struct SVC *svc, VP9_DENOISER *denoiser,
     vp9_denoiser_free(denoiser);
     return 1;
   }
+  CHECK_MEM_ERROR(
+      cm, denoiser->last_source_saved,
+      vpx_calloc(((height + 7) >> 3) * ((width + 7) >> 3),
+                 sizeof(*denoiser->last_source_saved)));
 #ifdef OUTPUT_YUV_DENOISED
   make_grayscale(&denoiser->running_avg_y[i]);
 #endif
@@ -714,6 +934,19 @@ void vp9_denoiser_free(VP9_DENOISER *denoiser) {
   vpx_free(denoiser->mc_running_avg_y);
   denoiser->mc_running_avg_y = NULL;
   vpx_free_frame_buffer(&denoiser->last_source);
+
+  vpx_free(denoiser->y_planes);
+  denoiser->y_planes = NULL;
+  vpx_free(denoiser->y_plane_refs);
+  denoiser->y_plane_refs = NULL;
+  for (i = 0; i < 2; ++i) {
+    vpx_free(denoiser->intra_written[i]);
+    denoiser->intra_written[i] = NULL;
+    denoiser->intra_cow_src[i] = NULL;
+  }
+  vpx_free(denoiser->last_source_saved);
+  denoiser->last_source_saved = NULL;
+  denoiser->last_source_alias = NULL;
 }
 
 static void force_refresh_longterm_ref(VP9_COMP *const cpi) {
@@ -818,6 +1051,110 @@ void vp9_denoiser_update_ref_frame(VP9_COMP *const cpi) {
         cpi->lst_fb_idx, cpi->resize_pending, svc_refresh_denoiser_buffers,
         denoise_svc_second_layer);
   }
+
+  if (cpi->oxcf.noise_sensitivity > 0) {
+    VP9_DENOISER *const denoiser = &cpi->denoiser;
+    // Account for the source blocks saved before they were denoised in place.
+    if (denoiser->last_source_alias != NULL &&
+        !denoiser->last_source_saved_counted) {
+      const YV12_BUFFER_CONFIG *const last = &denoiser->last_source;
+      const int num_blocks = (last->y_height >> 3) * (last->y_width >> 3);
+      int i;
+      for (i = 0; i < num_blocks; ++i)
+        denoiser->frame_copy_bytes += denoiser->last_source_saved[i] << 6;
+      denoiser->last_source_saved_counted = 1;
+    }
+    denoiser->total_copy_bytes += denoiser->frame_copy_bytes;
+    denoiser->max_frame_copy_bytes =
+        VPXMAX(denoiser->max_frame_copy_bytes, denoiser->frame_copy_bytes);
+    denoiser->frame_copy_bytes = 0;
+  }
+}
+
+void vp9_denoiser_set_last_source(VP9_COMP *const cpi,
+                                  unsigned int frame_counter) {
+  VP9_DENOISER *const denoiser = &cpi->denoiser;
+  YV12_BUFFER_CONFIG *const src = cpi->Source;
+  YV12_BUFFER_CONFIG *const last = &denoiser->last_source;
+  // The unscaled source stays in the lookahead until the next frame has been
+  // encoded, so it is referred to rather than copied. A scaled source is
+  // overwritten by the next frame.
+  if (src == cpi->un_scaled_source && src->y_width == last->y_width &&
+      src->y_height == last->y_height) {
+    denoiser->last_source_alias = src->y_buffer;
+    denoiser->last_source_alias_stride = src->y_stride;
+    memset(denoiser->last_source_saved, 0,
+           (last->y_height >> 3) * (last->y_width >> 3));
+    denoiser->last_source_saved_counted = 0;
+  } else {
+    denoiser->last_source_alias = NULL;
+    copy_frame(last, src);
+    denoiser->frame_copy_bytes += (int64_t)last->y_width * last->y_height;
+  }
+  denoiser->last_source_frame = frame_counter;
+}
+
+YV12_BUFFER_CONFIG *vp9_denoiser_get_last_source(VP9_COMP *const cpi,
+                                                 unsigned int frame_counter) {
+  VP9_DENOISER *const denoiser = &cpi->denoiser;
+  // The lookahead buffer the source was referred to in may have been reused
+  // if a frame went by without setting last_source.
+  if (denoiser->last_source_alias != NULL &&
+      (frame_counter != denoiser->last_source_frame + 1 ||
+       cpi->unscaled_last_source == NULL ||
+       cpi->unscaled_last_source->y_buffer != denoiser->last_source_alias))
+    return NULL;
+  return &denoiser->last_source;
+}
+
+void vp9_denoiser_keep_last_source(VP9_COMP *const cpi,
+                                   unsigned int frame_counter) {
+  VP9_DENOISER *const denoiser = &cpi->denoiser;
+  YV12_BUFFER_CONFIG *const last = &denoiser->last_source;
+  if (denoiser->last_source_alias == NULL ||
+      vp9_denoiser_get_last_source(cpi, frame_counter) == NULL)
+    return;
+  denoiser->frame_copy_bytes += copy_unmarked_blocks(
+      last->y_buffer, last->y_stride, denoiser->last_source_alias,
+      denoiser->last_source_alias_stride, denoiser->last_source_saved,
+      last->y_height >> 3, last->y_width >> 3);
+  denoiser->last_source_alias = NULL;
+}
+
+const uint8_t *vp9_denoiser_last_source_block(const VP9_DENOISER *denoiser,
+                                              int mi_row, int mi_col,
+                                              uint8_t *tmp, int *stride) {
+  const YV12_BUFFER_CONFIG *const last = &denoiser->last_source;
+  const int mi_cols = last->y_width >> 3;
+  const uint8_t *const saved =
+      denoiser->last_source_saved + mi_row * mi_cols + mi_col;
+  const int num_saved =
+      saved[0] + saved[1] + saved[mi_cols] + saved[mi_cols + 1];
+  int i;
+  if (denoiser->last_source_alias == NULL || num_saved == 4) {
+    *stride = last->y_stride;
+    return block_start(last->y_buffer, last->y_stride, mi_row, mi_col);
+  }
+  if (num_saved == 0) {
+    *stride = denoiser->last_source_alias_stride;
+    return block_start(denoiser->last_source_alias,
+                       denoiser->last_source_alias_stride, mi_row, mi_col);
+  }
+  // Some of the 8x8 blocks have been denoised in the source since.
+  for (i = 0; i < 4; ++i) {
+    const int r = i >> 1;
+    const int c = i & 1;
+    const int from_last = saved[r * mi_cols + c];
+    uint8_t *const buf =
+        from_last ? last->y_buffer : denoiser->last_source_alias;
+    const int buf_stride =
+        from_last ? last->y_stride : denoiser->last_source_alias_stride;
+    vpx_convolve_copy(block_start(buf, buf_stride, mi_row + r, mi_col + c),
+                      buf_stride, tmp + (r << 3) * 16 + (c << 3), 16, NULL, 0,
+                      0, 0, 0, 8, 8);
+  }
+  *stride = 16;
+  return tmp;
 }
 
 #ifdef OUTPUT_YUV_DENOISED
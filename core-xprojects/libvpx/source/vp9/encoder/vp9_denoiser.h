@@ -46,6 +46,31 @@ typedef struct vp9_denoiser {
   YV12_BUFFER_CONFIG *running_avg_y;
   YV12_BUFFER_CONFIG *mc_running_avg_y;
   YV12_BUFFER_CONFIG last_source;
+  // The luma planes of running_avg_y are reference counted so that buffers
+  // holding the same content share a plane instead of each keeping a copy.
+  // y_planes[i] is the plane allocated with running_avg_y[i] and
+  // y_plane_refs[i] the number of running_avg_y entries pointing at it.
+  uint8_t **y_planes;
+  int *y_plane_refs;
+  // When the INTRA_FRAME buffer of a layer has to give up a shared plane, it
+  // takes a free one without copying. The blocks that are not denoised before
+  // the next update are then filled from intra_cow_src[layer];
+  // intra_written[layer] marks the 8x8 blocks already overwritten.
+  uint8_t *intra_cow_src[2];
+  uint8_t *intra_written[2];
+  // While last_source_alias is set, last_source refers to the source frame
+  // with that luma plane instead of a copy of it. Blocks the denoiser filters
+  // in place are saved to last_source first and marked in last_source_saved.
+  uint8_t *last_source_alias;
+  int last_source_alias_stride;
+  unsigned int last_source_frame;
+  uint8_t *last_source_saved;
+  int last_source_saved_counted;
+  // Luma bytes copied by the denoiser: for the frame being encoded, in total
+  // and the most for a single frame.
+  int64_t frame_copy_bytes;
+  int64_t total_copy_bytes;
+  int64_t max_frame_copy_bytes;
   int frame_buffer_initialized;
   int reset;
   int num_ref_frames;
@@ -125,6 +150,27 @@ int64_t vp9_scale_acskip_thresh(int64_t threshold,
 
 void vp9_denoiser_update_ref_frame(struct VP9_COMP *const cpi);
 
+// Makes last_source refer to the current source frame for the noise estimate
+// of the next frame, frame_counter + 1.
+void vp9_denoiser_set_last_source(struct VP9_COMP *const cpi,
+                                  unsigned int frame_counter);
+
+// Copies the parts of the source frame last_source refers to that are not
+// saved yet, so that it no longer depends on the frame staying unmodified.
+void vp9_denoiser_keep_last_source(struct VP9_COMP *const cpi,
+                                   unsigned int frame_counter);
+
+// Returns last_source if it still holds the source of frame_counter - 1, NULL
+// otherwise.
+YV12_BUFFER_CONFIG *vp9_denoiser_get_last_source(struct VP9_COMP *const cpi,
+                                                 unsigned int frame_counter);
+
+// Returns the 16x16 luma block of last_source at (mi_row, mi_col). tmp, of
+// 16 * 16 bytes, is used when the block has to be put together.
+const uint8_t *vp9_denoiser_last_source_block(const VP9_DENOISER *denoiser,
+                                              int mi_row, int mi_col,
+                                              uint8_t *tmp, int *stride);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
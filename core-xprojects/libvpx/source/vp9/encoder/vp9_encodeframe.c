@@ -1257,9 +1257,11 @@ static uint64_t avg_source_sad(VP9_COMP *cpi, MACROBLOCK *x, int shift,
 
 // This function chooses partitioning based on the variance between source and
 // reconstructed last, where variance is computed for down-sampled inputs.
-static int choose_partitioning(VP9_COMP *cpi, const TileInfo *const tile,
-                               MACROBLOCK *x, int mi_row, int mi_col) {
+static int choose_partitioning(VP9_COMP *cpi, ThreadData *td,
+                               const TileInfo *const tile, int mi_row,
+                               int mi_col) {
   VP9_COMMON *const cm = &cpi->common;
+  MACROBLOCK *const x = &td->mb;
   MACROBLOCKD *xd = &x->e_mbd;
   int i, j, k, m;
   v64x64 vt;
@@ -1544,8 +1546,10 @@ static int choose_partitioning(VP9_COMP *cpi, const TileInfo *const tile,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   }
 
-  if (low_res && threshold_4x4avg < INT64_MAX)
-    CHECK_MEM_ERROR(cm, vt2, vpx_calloc(16, sizeof(*vt2)));
+  if (low_res && threshold_4x4avg < INT64_MAX) {
+    vt2 = (v16x16 *)td->var_tree_scratch;
+    memset(vt2, 0, 16 * sizeof(*vt2));
+  }
   // Fill in the entire tree of 8x8 (or 4x4 under some conditions) variances
   // for splits.
   for (i = 0; i < 4; i++) {
@@ -1753,10 +1757,14 @@ static int choose_partitioning(VP9_COMP *cpi, const TileInfo *const tile,
   }
 
   chroma_check(cpi, x, bsize, y_sad, is_key_frame, scene_change_detected);
-  if (vt2) vpx_free(vt2);
   return 0;
 }
 
+void vp9_alloc_thread_frame_scratch(VP9_COMP *cpi, ThreadData *td) {
+  CHECK_MEM_ERROR(&cpi->common, td->var_tree_scratch,
+                  vp9_arena_alloc(&cpi->frame_arena, 16 * sizeof(v16x16), 32));
+}
+
 #if !CONFIG_REALTIME_ONLY
 static void update_state(VP9_COMP *cpi, ThreadData *td, PICK_MODE_CONTEXT *ctx,
                          int mi_row, int mi_col, BLOCK_SIZE bsize,
@@ -4505,7 +4513,7 @@ static void encode_rd_sb_row(VP9_COMP *cpi, ThreadData *td,
                        &dummy_rate, &dummy_dist, 1, td->pc_root);
     } else if (sf->partition_search_type == VAR_BASED_PARTITION &&
                cm->frame_type != KEY_FRAME) {
-      choose_partitioning(cpi, tile_info, x, mi_row, mi_col);
+      choose_partitioning(cpi, td, tile_info, mi_row, mi_col);
       rd_use_partition(cpi, td, tile_data, mi, tp, mi_row, mi_col, BLOCK_64X64,
                        &dummy_rate, &dummy_dist, 1, td->pc_root);
     } else {
@@ -5541,7 +5549,7 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, ThreadData *td,
         // support both intra and inter sub8x8 block coding for RTC mode.
         // Tune the thresholds accordingly to use sub8x8 block coding for
         // coding performance improvement.
-        choose_partitioning(cpi, tile_info, x, mi_row, mi_col);
+        choose_partitioning(cpi, td, tile_info, mi_row, mi_col);
         nonrd_use_partition(cpi, td, tile_data, mi, tp, mi_row, mi_col,
                             BLOCK_64X64, 1, &dummy_rdc, td->pc_root);
         break;
@@ -5585,7 +5593,7 @@ static void encode_nonrd_sb_row(VP9_COMP *cpi, ThreadData *td,
                                BLOCK_64X64, &dummy_rdc, 1, INT64_MAX,
                                td->pc_root);
         } else {
-          choose_partitioning(cpi, tile_info, x, mi_row, mi_col);
+          choose_partitioning(cpi, td, tile_info, mi_row, mi_col);
           // TODO(marpan): Seems like nonrd_select_partition does not support
           // 4x4 partition. Since 4x4 is used on key frame, use this switch
           // for now.
@@ -5986,6 +5994,7 @@ static void encode_frame_internal(VP9_COMP *cpi) {
   xd->mi[0] = cm->mi;
   vp9_zero(*td->counts);
   vp9_zero(cpi->td.rd_counts);
+  vp9_alloc_thread_frame_scratch(cpi, td);
 
   xd->lossless = cm->base_qindex == 0 && cm->y_dc_delta_q == 0 &&
                  cm->uv_dc_delta_q == 0 && cm->uv_ac_delta_q == 0;
@@ -6075,6 +6084,8 @@ static void encode_frame_internal(VP9_COMP *cpi) {
   // Frame segmentation
   if (cpi->oxcf.aq_mode == PERCEPTUAL_AQ) build_kmeans_segmentation(cpi);
 
+  vp9_pyramid_me(cpi);
+
   {
     struct vpx_usec_timer emr_timer;
     vpx_usec_timer_start(&emr_timer);
@@ -42,6 +42,11 @@ void vp9_encode_tile(struct VP9_COMP *cpi, struct ThreadData *td, int tile_row,
 void vp9_encode_sb_row(struct VP9_COMP *cpi, struct ThreadData *td,
                        int tile_row, int tile_col, int mi_row);
 
+// Gives |td| its per-frame scratch buffers from the frame arena. Must be
+// called from the main thread before |td| encodes a frame.
+void vp9_alloc_thread_frame_scratch(struct VP9_COMP *cpi,
+                                    struct ThreadData *td);
+
 void vp9_set_variance_partition_thresholds(struct VP9_COMP *cpi, int q,
                                            int content_state);
 
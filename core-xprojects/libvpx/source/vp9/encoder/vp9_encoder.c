@@ -1051,6 +1051,7 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
 #endif
 
   vp9_lookahead_destroy(cpi->lookahead);
+  vp9_pyramid_me_free(&cpi->pyramid_me);
 
   vpx_free(cpi->tile_tok[0][0]);
   cpi->tile_tok[0][0] = 0;
@@ -1058,6 +1059,9 @@ static void dealloc_compressor_data(VP9_COMP *cpi) {
   vpx_free(cpi->tplist[0][0]);
   cpi->tplist[0][0] = NULL;
 
+  vp9_arena_free(&cpi->seq_arena);
+  vp9_arena_free(&cpi->frame_arena);
+
   vp9_free_pc_tree(&cpi->td);
 
   for (i = 0; i < cpi->svc.number_spatial_layers; ++i) {
@@ -1393,9 +1397,27 @@ static int alloc_context_buffers_ext(VP9_COMP *cpi) {
   return 0;
 }
 
+// Drops the buffers of the sequence arena so it can be reset. They are all
+// allocated again right after, at the new size. The TPL stats, the row-mt
+// job queue and the bitstream tile buffers are in regions of the arena,
+// which are kept across the reset and grow when they are next allocated.
+static void release_sequence_buffers(VP9_COMP *cpi) {
+  size_t i;
+
+  for (i = 0; i < sizeof(cpi->mbgraph_stats) / sizeof(cpi->mbgraph_stats[0]);
+       ++i) {
+    cpi->mbgraph_stats[i].mb_stats = NULL;
+  }
+
+  vp9_arena_reset(&cpi->seq_arena);
+}
+
 static void alloc_compressor_data(VP9_COMP *cpi) {
   VP9_COMMON *cm = &cpi->common;
   int sb_rows;
+  size_t i;
+
+  release_sequence_buffers(cpi);
 
   vp9_alloc_context_buffers(cm, cm->width, cm->height);
 
@@ -1415,6 +1437,14 @@ static void alloc_compressor_data(VP9_COMP *cpi) {
       cm, cpi->tplist[0][0],
       vpx_calloc(sb_rows * 4 * (1 << 6), sizeof(*cpi->tplist[0][0])));
 
+  for (i = 0; i < sizeof(cpi->mbgraph_stats) / sizeof(cpi->mbgraph_stats[0]);
+       i++) {
+    CHECK_MEM_ERROR(cm, cpi->mbgraph_stats[i].mb_stats,
+                    vp9_arena_calloc(&cpi->seq_arena, cm->MBs,
+                                     sizeof(*cpi->mbgraph_stats[i].mb_stats),
+                                     16));
+  }
+
   vp9_setup_pc_tree(&cpi->common, &cpi->td);
 }
 
@@ -1445,13 +1475,34 @@ static void set_tile_limits(VP9_COMP *cpi) {
 static void update_frame_size(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   MACROBLOCKD *const xd = &cpi->td.mb.e_mbd;
+  const int last_mi_rows = cm->mi_rows;
+  const int last_mi_cols = cm->mi_cols;
+  int same_layout;
 
   vp9_set_mb_mi(cm, cm->width, cm->height);
-  vp9_init_context_buffers(cm);
+  // prev_mi is NULL while the last frame's mode info cannot be used.
+  // vp9_encode_frame() points it back into prev_mip before coding.
+  same_layout = cm->mip != NULL && cm->prev_mip != NULL &&
+                cm->mi_rows == last_mi_rows && cm->mi_cols == last_mi_cols &&
+                cm->mi == cm->mip + cm->mi_stride + 1 &&
+                (cm->prev_mi == NULL ||
+                 cm->prev_mi == cm->prev_mip + cm->mi_stride + 1) &&
+                cm->mi_grid_visible == cm->mi_grid_base + cm->mi_stride + 1 &&
+                cm->prev_mi_grid_visible ==
+                    cm->prev_mi_grid_base + cm->mi_stride + 1;
+  // This is called for every layer frame in SVC and for every scaling mode
+  // update. The mode info of each block is rewritten as the frame is coded,
+  // so it only needs to be cleared when its layout changes.
+  if (same_layout) {
+    if (cm->last_frame_seg_map)
+      memset(cm->last_frame_seg_map, 0, cm->mi_rows * cm->mi_cols);
+  } else {
+    vp9_init_context_buffers(cm);
+    memset(cpi->mbmi_ext_base, 0,
+           cm->mi_rows * cm->mi_cols * sizeof(*cpi->mbmi_ext_base));
+  }
   vp9_init_macroblockd(cm, xd, NULL);
   cpi->td.mb.mbmi_ext_base = cpi->mbmi_ext_base;
-  memset(cpi->mbmi_ext_base, 0,
-         cm->mi_rows * cm->mi_cols * sizeof(*cpi->mbmi_ext_base));
 
   set_tile_limits(cpi);
 }
@@ -1581,7 +1632,8 @@ void vp9_set_rc_buffer_sizes(VP9_COMP *cpi) {
   cpi->fn_ptr[BT].svf = SVF;                             \
   cpi->fn_ptr[BT].svaf = SVAF;                           \
   cpi->fn_ptr[BT].sdx4df = SDX4DF;                       \
-  cpi->fn_ptr[BT].sdx8f = NULL;
+  cpi->fn_ptr[BT].sdx8f = NULL;                          \
+  cpi->fn_ptr[BT].sdx8df = NULL;
 
 #define MAKE_BFP_SAD_WRAPPER(fnname)                                           \
   static unsigned int fnname##_bits8(const uint8_t *src_ptr,                   \
@@ -2003,6 +2055,7 @@ void vp9_change_config(struct VP9_COMP *cpi, const VP9EncoderConfig *oxcf) {
 #if CONFIG_VP9_HIGHBITDEPTH
   cpi->td.mb.e_mbd.bd = (int)cm->bit_depth;
 #endif  // CONFIG_VP9_HIGHBITDEPTH
+  vp9_init_deadline_control(cpi);
 
   if ((oxcf->pass == 0) && (oxcf->rc_mode == VPX_Q)) {
     rc->baseline_gf_interval = FIXED_GF_INTERVAL;
@@ -2361,13 +2414,6 @@ VP9_COMP *vp9_create_compressor(const VP9EncoderConfig *oxcf,
   CHECK_MEM_ERROR(cm, cpi->nmvsadcosts_hp[1],
                   vpx_calloc(MV_VALS, sizeof(*cpi->nmvsadcosts_hp[1])));
 
-  for (i = 0; i < (sizeof(cpi->mbgraph_stats) / sizeof(cpi->mbgraph_stats[0]));
-       i++) {
-    CHECK_MEM_ERROR(
-        cm, cpi->mbgraph_stats[i].mb_stats,
-        vpx_calloc(cm->MBs * sizeof(*cpi->mbgraph_stats[i].mb_stats), 1));
-  }
-
   cpi->refresh_alt_ref_frame = 0;
   cpi->b_calculate_psnr = CONFIG_INTERNAL_STATS;
 
@@ -2563,67 +2609,68 @@ VP9_COMP *vp9_create_compressor(const VP9EncoderConfig *oxcf,
   CHECK_MEM_ERROR(cm, cpi->source_diff_var, vpx_calloc(cm->MBs, sizeof(diff)));
   cpi->source_var_thresh = 0;
   cpi->frames_till_next_var_check = 0;
-#define BFP(BT, SDF, SDAF, VF, SVF, SVAF, SDX4DF, SDX8F) \
-  cpi->fn_ptr[BT].sdf = SDF;                             \
-  cpi->fn_ptr[BT].sdaf = SDAF;                           \
-  cpi->fn_ptr[BT].vf = VF;                               \
-  cpi->fn_ptr[BT].svf = SVF;                             \
-  cpi->fn_ptr[BT].svaf = SVAF;                           \
-  cpi->fn_ptr[BT].sdx4df = SDX4DF;                       \
-  cpi->fn_ptr[BT].sdx8f = SDX8F;
+#define BFP(BT, SDF, SDAF, VF, SVF, SVAF, SDX4DF, SDX8F, SDX8DF) \
+  cpi->fn_ptr[BT].sdf = SDF;                                     \
+  cpi->fn_ptr[BT].sdaf = SDAF;                                   \
+  cpi->fn_ptr[BT].vf = VF;                                       \
+  cpi->fn_ptr[BT].svf = SVF;                                     \
+  cpi->fn_ptr[BT].svaf = SVAF;                                   \
+  cpi->fn_ptr[BT].sdx4df = SDX4DF;                               \
+  cpi->fn_ptr[BT].sdx8f = SDX8F;                                 \
+  cpi->fn_ptr[BT].sdx8df = SDX8DF;
 
   // TODO(angiebird): make sdx8f available for every block size
   BFP(BLOCK_32X16, vpx_sad32x16, vpx_sad32x16_avg, vpx_variance32x16,
       vpx_sub_pixel_variance32x16, vpx_sub_pixel_avg_variance32x16,
-      vpx_sad32x16x4d, NULL)
+      vpx_sad32x16x4d, NULL, vpx_sad32x16x8d)
 
   BFP(BLOCK_16X32, vpx_sad16x32, vpx_sad16x32_avg, vpx_variance16x32,
       vpx_sub_pixel_variance16x32, vpx_sub_pixel_avg_variance16x32,
-      vpx_sad16x32x4d, NULL)
+      vpx_sad16x32x4d, NULL, vpx_sad16x32x8d)
 
   BFP(BLOCK_64X32, vpx_sad64x32, vpx_sad64x32_avg, vpx_variance64x32,
       vpx_sub_pixel_variance64x32, vpx_sub_pixel_avg_variance64x32,
-      vpx_sad64x32x4d, NULL)
+      vpx_sad64x32x4d, NULL, vpx_sad64x32x8d)
 
   BFP(BLOCK_32X64, vpx_sad32x64, vpx_sad32x64_avg, vpx_variance32x64,
       vpx_sub_pixel_variance32x64, vpx_sub_pixel_avg_variance32x64,
-      vpx_sad32x64x4d, NULL)
+      vpx_sad32x64x4d, NULL, vpx_sad32x64x8d)
 
   BFP(BLOCK_32X32, vpx_sad32x32, vpx_sad32x32_avg, vpx_variance32x32,
       vpx_sub_pixel_variance32x32, vpx_sub_pixel_avg_variance32x32,
-      vpx_sad32x32x4d, vpx_sad32x32x8)
+      vpx_sad32x32x4d, vpx_sad32x32x8, vpx_sad32x32x8d)
 
   BFP(BLOCK_64X64, vpx_sad64x64, vpx_sad64x64_avg, vpx_variance64x64,
       vpx_sub_pixel_variance64x64, vpx_sub_pixel_avg_variance64x64,
-      vpx_sad64x64x4d, NULL)
+      vpx_sad64x64x4d, NULL, vpx_sad64x64x8d)
 
   BFP(BLOCK_16X16, vpx_sad16x16, vpx_sad16x16_avg, vpx_variance16x16,
       vpx_sub_pixel_variance16x16, vpx_sub_pixel_avg_variance16x16,
-      vpx_sad16x16x4d, vpx_sad16x16x8)
+      vpx_sad16x16x4d, vpx_sad16x16x8, vpx_sad16x16x8d)
 
   BFP(BLOCK_16X8, vpx_sad16x8, vpx_sad16x8_avg, vpx_variance16x8,
       vpx_sub_pixel_variance16x8, vpx_sub_pixel_avg_variance16x8,
-      vpx_sad16x8x4d, vpx_sad16x8x8)
+      vpx_sad16x8x4d, vpx_sad16x8x8, vpx_sad16x8x8d)
 
   BFP(BLOCK_8X16, vpx_sad8x16, vpx_sad8x16_avg, vpx_variance8x16,
       vpx_sub_pixel_variance8x16, vpx_sub_pixel_avg_variance8x16,
-      vpx_sad8x16x4d, vpx_sad8x16x8)
+      vpx_sad8x16x4d, vpx_sad8x16x8, vpx_sad8x16x8d)
 
   BFP(BLOCK_8X8, vpx_sad8x8, vpx_sad8x8_avg, vpx_variance8x8,
       vpx_sub_pixel_variance8x8, vpx_sub_pixel_avg_variance8x8, vpx_sad8x8x4d,
-      vpx_sad8x8x8)
+      vpx_sad8x8x8, vpx_sad8x8x8d)
 
   BFP(BLOCK_8X4, vpx_sad8x4, vpx_sad8x4_avg, vpx_variance8x4,
       vpx_sub_pixel_variance8x4, vpx_sub_pixel_avg_variance8x4, vpx_sad8x4x4d,
-      NULL)
+      NULL, vpx_sad8x4x8d)
 
   BFP(BLOCK_4X8, vpx_sad4x8, vpx_sad4x8_avg, vpx_variance4x8,
       vpx_sub_pixel_variance4x8, vpx_sub_pixel_avg_variance4x8, vpx_sad4x8x4d,
-      NULL)
+      NULL, vpx_sad4x8x8d)
 
   BFP(BLOCK_4X4, vpx_sad4x4, vpx_sad4x4_avg, vpx_variance4x4,
       vpx_sub_pixel_variance4x4, vpx_sub_pixel_avg_variance4x4, vpx_sad4x4x4d,
-      vpx_sad4x4x8)
+      vpx_sad4x4x8, vpx_sad4x4x8d)
 
 #if CONFIG_VP9_HIGHBITDEPTH
   highbd_set_var_fns(cpi);
@@ -2673,9 +2720,153 @@ VP9_COMP *vp9_create_compressor(const VP9EncoderConfig *oxcf,
 
 static void free_tpl_buffer(VP9_COMP *cpi);
 
+static void calc_psnr(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *a,
+                      const YV12_BUFFER_CONFIG *b, PSNR_STATS *psnr) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  const uint32_t bit_depth = cpi->td.mb.e_mbd.bd;
+#else
+  const uint32_t bit_depth = 8;
+#endif
+  if (cpi->num_workers > 1) {
+    vp9_calc_psnr_mt(cpi, a, b, bit_depth, cpi->oxcf.input_bit_depth, psnr);
+    return;
+  }
+#if CONFIG_VP9_HIGHBITDEPTH
+  vpx_calc_highbd_psnr(a, b, psnr, bit_depth, cpi->oxcf.input_bit_depth);
+#else
+  (void)bit_depth;
+  vpx_calc_psnr(a, b, psnr);
+#endif
+}
+
+static int async_psnr_worker_hook(void *arg1, void *arg2) {
+  ASYNC_PSNR *const job = (ASYNC_PSNR *)arg1;
+  const YV12_BUFFER_CONFIG *const recon = (const YV12_BUFFER_CONFIG *)arg2;
+#if CONFIG_VP9_HIGHBITDEPTH
+  vpx_calc_highbd_plane_sse(&job->source, recon, 0, 1, job->bit_depth,
+                            job->input_bit_depth, job->sse);
+#else
+  vpx_calc_plane_sse(&job->source, recon, 0, 1, job->sse);
+#endif
+  return 1;
+}
+
+// Copies the visible area of src to dst, which has the same size and format.
+static void copy_visible_frame(const YV12_BUFFER_CONFIG *src,
+                               YV12_BUFFER_CONFIG *dst) {
+  const int widths[3] = { src->y_crop_width, src->uv_crop_width,
+                          src->uv_crop_width };
+  const int heights[3] = { src->y_crop_height, src->uv_crop_height,
+                           src->uv_crop_height };
+  const uint8_t *src_planes[3] = { src->y_buffer, src->u_buffer,
+                                   src->v_buffer };
+  const int src_strides[3] = { src->y_stride, src->uv_stride, src->uv_stride };
+  uint8_t *dst_planes[3] = { dst->y_buffer, dst->u_buffer, dst->v_buffer };
+  const int dst_strides[3] = { dst->y_stride, dst->uv_stride, dst->uv_stride };
+  int bytes_per_sample = 1;
+  int i, row;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
+    bytes_per_sample = 2;
+    for (i = 0; i < 3; ++i) {
+      src_planes[i] = (const uint8_t *)CONVERT_TO_SHORTPTR(src_planes[i]);
+      dst_planes[i] = (uint8_t *)CONVERT_TO_SHORTPTR(dst_planes[i]);
+    }
+  }
+#endif
+  for (i = 0; i < 3; ++i) {
+    for (row = 0; row < heights[i]; ++row) {
+      memcpy(dst_planes[i] + row * dst_strides[i] * bytes_per_sample,
+             src_planes[i] + row * src_strides[i] * bytes_per_sample,
+             widths[i] * bytes_per_sample);
+    }
+  }
+}
+
+// Waits for the computation in flight, if any, and releases the frame buffer
+// it held. The result stays available to take_async_psnr().
+static void sync_async_psnr(VP9_COMP *cpi) {
+  ASYNC_PSNR *const job = &cpi->async_psnr;
+  if (!job->pending) return;
+  vpx_get_worker_interface()->sync(&job->worker);
+  --cpi->common.buffer_pool->frame_bufs[job->recon_fb_idx].ref_count;
+  job->pending = 0;
+  job->ready = 1;
+}
+
+static int take_async_psnr(VP9_COMP *cpi, PSNR_STATS *psnr) {
+  ASYNC_PSNR *const job = &cpi->async_psnr;
+  sync_async_psnr(cpi);
+  if (!job->ready) return 0;
+  vpx_sse_to_psnr_stats(&job->source, job->sse,
+                        (double)((1 << job->input_bit_depth) - 1), psnr);
+  job->ready = 0;
+  return 1;
+}
+
+// Starts computing the PSNR of the frame just coded in the background. The
+// source is copied, as its buffer may be reused by the next frame, and the
+// frame buffer of the reconstruction is held until the computation is done.
+static void start_async_psnr(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  BufferPool *const pool = cm->buffer_pool;
+  ASYNC_PSNR *const job = &cpi->async_psnr;
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  const YV12_BUFFER_CONFIG *const src = cpi->raw_source_frame;
+  int i;
+
+  if (!job->worker_ready) {
+    winterface->init(&job->worker);
+    if (!winterface->reset(&job->worker))
+      vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
+                         "Failed to create the PSNR worker");
+    job->worker_ready = 1;
+  }
+  if (vpx_realloc_frame_buffer(&job->source, src->y_crop_width,
+                               src->y_crop_height, src->subsampling_x,
+                               src->subsampling_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                               (src->flags & YV12_FLAG_HIGHBITDEPTH) != 0,
+#endif
+                               0, cm->byte_alignment, NULL, NULL, NULL))
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to allocate PSNR source buffer");
+  copy_visible_frame(src, &job->source);
+#if CONFIG_VP9_HIGHBITDEPTH
+  job->bit_depth = cpi->td.mb.e_mbd.bd;
+#else
+  job->bit_depth = 8;
+#endif
+  job->input_bit_depth = cpi->oxcf.input_bit_depth;
+  job->worker.hook = async_psnr_worker_hook;
+  job->worker.data1 = job;
+  job->worker.data2 = cm->frame_to_show;
+
+  for (i = 0; i < FRAME_BUFFERS; ++i) {
+    if (&pool->frame_bufs[i].buf == cm->frame_to_show) break;
+  }
+  if (i == FRAME_BUFFERS) {
+    // The reconstruction cannot be held, so compute the PSNR now.
+    winterface->execute(&job->worker);
+    job->ready = 1;
+    return;
+  }
+  job->recon_fb_idx = i;
+  ++pool->frame_bufs[i].ref_count;
+  job->pending = 1;
+  winterface->launch(&job->worker);
+}
+
+static void free_async_psnr(VP9_COMP *cpi) {
+  ASYNC_PSNR *const job = &cpi->async_psnr;
+  sync_async_psnr(cpi);
+  if (job->worker_ready) vpx_get_worker_interface()->end(&job->worker);
+  vpx_free_frame_buffer(&job->source);
+}
+
 void vp9_remove_compressor(VP9_COMP *cpi) {
   VP9_COMMON *cm;
-  unsigned int i;
   int t;
 
   if (!cpi) return;
@@ -2748,6 +2939,17 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
           SNPRINT2(results, "\t%7.3f", cpi->worst_consistency);
         }
 
+#if CONFIG_VP9_TEMPORAL_DENOISING
+        if (cpi->oxcf.noise_sensitivity > 0) {
+          // Luma bytes copied by the denoiser, per frame and at most.
+          SNPRINT(headings, "\tDenCopy\tDenCpMx");
+          SNPRINT2(results, "\t%7.0f",
+                   (double)cpi->denoiser.total_copy_bytes / cpi->count);
+          SNPRINT2(results, "\t%7.0f",
+                   (double)cpi->denoiser.max_frame_copy_bytes);
+        }
+#endif
+
         SNPRINT(headings, "\t    Time\tRcErr\tAbsErr");
         SNPRINT2(results, "\t%8.0f", total_encode_time);
         SNPRINT2(results, "\t%7.2f", rate_err);
@@ -2788,6 +2990,7 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
   }
 
   free_tpl_buffer(cpi);
+  free_async_psnr(cpi);
 
   for (t = 0; t < cpi->num_workers; ++t) {
     VPxWorker *const worker = &cpi->workers[t];
@@ -2818,11 +3021,6 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
 
   dealloc_compressor_data(cpi);
 
-  for (i = 0; i < sizeof(cpi->mbgraph_stats) / sizeof(cpi->mbgraph_stats[0]);
-       ++i) {
-    vpx_free(cpi->mbgraph_stats[i].mb_stats);
-  }
-
   vp9_extrc_delete(&cpi->ext_ratectrl);
 
   vp9_remove_common(cm);
@@ -2863,14 +3061,18 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
 #endif
 }
 
-int vp9_get_psnr(const VP9_COMP *cpi, PSNR_STATS *psnr) {
+int vp9_get_psnr(VP9_COMP *cpi, PSNR_STATS *psnr) {
   if (is_psnr_calc_enabled(cpi)) {
-#if CONFIG_VP9_HIGHBITDEPTH
-    vpx_calc_highbd_psnr(cpi->raw_source_frame, cpi->common.frame_to_show, psnr,
-                         cpi->td.mb.e_mbd.bd, cpi->oxcf.input_bit_depth);
-#else
-    vpx_calc_psnr(cpi->raw_source_frame, cpi->common.frame_to_show, psnr);
-#endif
+    if (cpi->oxcf.async_psnr) {
+      const int have_prev = take_async_psnr(cpi, psnr);
+      start_async_psnr(cpi);
+      if (!have_prev) vp9_zero(*psnr);
+      return have_prev;
+    }
+    // The job started before oxcf.async_psnr was turned off no longer needs
+    // the frame buffer. Its result is left to vp9_flush_psnr().
+    sync_async_psnr(cpi);
+    calc_psnr(cpi, cpi->raw_source_frame, cpi->common.frame_to_show, psnr);
     return 1;
   } else {
     vp9_zero(*psnr);
@@ -2878,6 +3080,12 @@ int vp9_get_psnr(const VP9_COMP *cpi, PSNR_STATS *psnr) {
   }
 }
 
+int vp9_flush_psnr(VP9_COMP *cpi, PSNR_STATS *psnr) {
+  if (take_async_psnr(cpi, psnr)) return 1;
+  vp9_zero(*psnr);
+  return 0;
+}
+
 int vp9_use_as_reference(VP9_COMP *cpi, int ref_frame_flags) {
   if (ref_frame_flags > 7) return -1;
 
@@ -2995,11 +3203,13 @@ void vp9_write_yuv_rec_frame(VP9_COMMON *cm) {
 #endif
 
 #if CONFIG_VP9_HIGHBITDEPTH
-static void scale_and_extend_frame_nonnormative(const YV12_BUFFER_CONFIG *src,
+static void scale_and_extend_frame_nonnormative(VP9_COMP *cpi,
+                                                const YV12_BUFFER_CONFIG *src,
                                                 YV12_BUFFER_CONFIG *dst,
                                                 int bd) {
 #else
-static void scale_and_extend_frame_nonnormative(const YV12_BUFFER_CONFIG *src,
+static void scale_and_extend_frame_nonnormative(VP9_COMP *cpi,
+                                                const YV12_BUFFER_CONFIG *src,
                                                 YV12_BUFFER_CONFIG *dst) {
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   // TODO(dkovalev): replace YV12_BUFFER_CONFIG with vpx_image_t
@@ -3017,20 +3227,26 @@ static void scale_and_extend_frame_nonnormative(const YV12_BUFFER_CONFIG *src,
                               dst->uv_crop_width };
   const int dst_heights[3] = { dst->y_crop_height, dst->uv_crop_height,
                                dst->uv_crop_height };
+  // The encoder workers are idle between frames, so lend them to the resize.
+  VPxWorker *const workers = cpi->num_workers > 1 ? cpi->workers : NULL;
 
   for (i = 0; i < MAX_MB_PLANE; ++i) {
 #if CONFIG_VP9_HIGHBITDEPTH
     if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
-      vp9_highbd_resize_plane(srcs[i], src_heights[i], src_widths[i],
-                              src_strides[i], dsts[i], dst_heights[i],
-                              dst_widths[i], dst_strides[i], bd);
+      vp9_highbd_resize_plane_mt(srcs[i], src_heights[i], src_widths[i],
+                                 src_strides[i], dsts[i], dst_heights[i],
+                                 dst_widths[i], dst_strides[i], bd, workers,
+                                 cpi->num_workers);
     } else {
-      vp9_resize_plane(srcs[i], src_heights[i], src_widths[i], src_strides[i],
-                       dsts[i], dst_heights[i], dst_widths[i], dst_strides[i]);
+      vp9_resize_plane_mt(srcs[i], src_heights[i], src_widths[i],
+                          src_strides[i], dsts[i], dst_heights[i],
+                          dst_widths[i], dst_strides[i], workers,
+                          cpi->num_workers);
     }
 #else
-    vp9_resize_plane(srcs[i], src_heights[i], src_widths[i], src_strides[i],
-                     dsts[i], dst_heights[i], dst_widths[i], dst_strides[i]);
+    vp9_resize_plane_mt(srcs[i], src_heights[i], src_widths[i], src_strides[i],
+                        dsts[i], dst_heights[i], dst_widths[i], dst_strides[i],
+                        workers, cpi->num_workers);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   }
   vpx_extend_frame_borders(dst);
@@ -3865,7 +4081,7 @@ static INLINE void set_raw_source_frame(VP9_COMP *cpi) {
 #ifdef ENABLE_KF_DENOISE
   if (is_spatial_denoise_enabled(cpi)) {
     cpi->raw_source_frame = vp9_scale_if_required(
-        cm, &cpi->raw_unscaled_source, &cpi->raw_scaled_source,
+        cpi, &cpi->raw_unscaled_source, &cpi->raw_scaled_source,
         (oxcf->pass == 0), EIGHTTAP, 0);
   } else {
     cpi->raw_source_frame = cpi->Source;
@@ -3931,7 +4147,7 @@ static int encode_without_recode_loop(VP9_COMP *cpi, size_t *size,
     svc->scaled_one_half = 0;
   } else {
     cpi->Source = vp9_scale_if_required(
-        cm, cpi->un_scaled_source, &cpi->scaled_source, (cpi->oxcf.pass == 0),
+        cpi, cpi->un_scaled_source, &cpi->scaled_source, (cpi->oxcf.pass == 0),
         filter_scaler, phase_scaler);
   }
 #ifdef OUTPUT_YUV_SVC_SRC
@@ -3946,7 +4162,7 @@ static int encode_without_recode_loop(VP9_COMP *cpi, size_t *size,
 #ifdef ENABLE_KF_DENOISE
     if (is_spatial_denoise_enabled(cpi)) {
       cpi->raw_source_frame = vp9_scale_if_required(
-          cm, &cpi->raw_unscaled_source, &cpi->raw_scaled_source,
+          cpi, &cpi->raw_unscaled_source, &cpi->raw_scaled_source,
           (cpi->oxcf.pass == 0), EIGHTTAP, phase_scaler);
     } else {
       cpi->raw_source_frame = cpi->Source;
@@ -3981,7 +4197,7 @@ static int encode_without_recode_loop(VP9_COMP *cpi, size_t *size,
        (cpi->noise_estimate.enabled && !cpi->oxcf.noise_sensitivity) ||
        cpi->compute_source_sad_onepass))
     cpi->Last_Source = vp9_scale_if_required(
-        cm, cpi->unscaled_last_source, &cpi->scaled_last_source,
+        cpi, cpi->unscaled_last_source, &cpi->scaled_last_source,
         (cpi->oxcf.pass == 0), EIGHTTAP, 0);
 
   if (cpi->Last_Source == NULL ||
@@ -4461,7 +4677,7 @@ static void encode_with_recode_loop(VP9_COMP *cpi, size_t *size, uint8_t *dest
     }
 
     cpi->Source =
-        vp9_scale_if_required(cm, cpi->un_scaled_source, &cpi->scaled_source,
+        vp9_scale_if_required(cpi, cpi->un_scaled_source, &cpi->scaled_source,
                               (oxcf->pass == 0), EIGHTTAP, 0);
 
     // Unfiltered raw source used in metrics calculation if the source
@@ -4470,7 +4686,7 @@ static void encode_with_recode_loop(VP9_COMP *cpi, size_t *size, uint8_t *dest
 #ifdef ENABLE_KF_DENOISE
       if (is_spatial_denoise_enabled(cpi)) {
         cpi->raw_source_frame = vp9_scale_if_required(
-            cm, &cpi->raw_unscaled_source, &cpi->raw_scaled_source,
+            cpi, &cpi->raw_unscaled_source, &cpi->raw_scaled_source,
             (oxcf->pass == 0), EIGHTTAP, 0);
       } else {
         cpi->raw_source_frame = cpi->Source;
@@ -4481,9 +4697,9 @@ static void encode_with_recode_loop(VP9_COMP *cpi, size_t *size, uint8_t *dest
     }
 
     if (cpi->unscaled_last_source != NULL)
-      cpi->Last_Source = vp9_scale_if_required(cm, cpi->unscaled_last_source,
-                                               &cpi->scaled_last_source,
-                                               (oxcf->pass == 0), EIGHTTAP, 0);
+      cpi->Last_Source = vp9_scale_if_required(
+          cpi, cpi->unscaled_last_source, &cpi->scaled_last_source,
+          (oxcf->pass == 0), EIGHTTAP, 0);
 
     if (frame_is_intra_only(cm) == 0) {
       if (loop_count > 0) {
@@ -4902,8 +5118,9 @@ YV12_BUFFER_CONFIG *vp9_svc_twostage_scale(
 }
 
 YV12_BUFFER_CONFIG *vp9_scale_if_required(
-    VP9_COMMON *cm, YV12_BUFFER_CONFIG *unscaled, YV12_BUFFER_CONFIG *scaled,
+    VP9_COMP *cpi, YV12_BUFFER_CONFIG *unscaled, YV12_BUFFER_CONFIG *scaled,
     int use_normative_scaler, INTERP_FILTER filter_type, int phase_scaler) {
+  VP9_COMMON *const cm = &cpi->common;
   if (cm->mi_cols * MI_SIZE != unscaled->y_width ||
       cm->mi_rows * MI_SIZE != unscaled->y_height) {
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -4915,13 +5132,14 @@ YV12_BUFFER_CONFIG *vp9_scale_if_required(
         scale_and_extend_frame(unscaled, scaled, (int)cm->bit_depth,
                                filter_type, phase_scaler);
     else
-      scale_and_extend_frame_nonnormative(unscaled, scaled, (int)cm->bit_depth);
+      scale_and_extend_frame_nonnormative(cpi, unscaled, scaled,
+                                          (int)cm->bit_depth);
 #else
     if (use_normative_scaler && unscaled->y_width <= (scaled->y_width << 1) &&
         unscaled->y_height <= (scaled->y_height << 1))
       vp9_scale_and_extend_frame(unscaled, scaled, filter_type, phase_scaler);
     else
-      scale_and_extend_frame_nonnormative(unscaled, scaled);
+      scale_and_extend_frame_nonnormative(cpi, unscaled, scaled);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
     return scaled;
   } else {
@@ -5810,9 +6028,12 @@ static void Pass0Encode(VP9_COMP *cpi, size_t *size, uint8_t *dest,
 }
 
 #if !CONFIG_REALTIME_ONLY
+// gop_tpl_stats is set when the temporal dependency model has just run on
+// the group of pictures.
 static void Pass2Encode(VP9_COMP *cpi, size_t *size, uint8_t *dest,
                         unsigned int *frame_flags,
-                        ENCODE_FRAME_RESULT *encode_frame_result) {
+                        ENCODE_FRAME_RESULT *encode_frame_result,
+                        const TplDepFrame *gop_tpl_stats) {
   cpi->allow_encode_breakout = ENCODE_BREAKOUT_ENABLED;
 
   if (cpi->common.current_frame_coding_index == 0) {
@@ -5824,6 +6045,18 @@ static void Pass2Encode(VP9_COMP *cpi, size_t *size, uint8_t *dest,
                          "vp9_extrc_send_firstpass_stats() failed");
     }
   }
+  if (cpi->ext_ratectrl.ready &&
+      cpi->ext_ratectrl.funcs.get_gop_decisions != NULL) {
+    VP9_COMMON *cm = &cpi->common;
+    const vpx_codec_err_t codec_status = vp9_extrc_request_gop_decisions(
+        &cpi->ext_ratectrl, &cpi->twopass.gf_group,
+        cm->current_frame_coding_index, gop_tpl_stats, cm->mi_rows,
+        cm->mi_cols);
+    if (codec_status != VPX_CODEC_OK) {
+      vpx_internal_error(&cm->error, codec_status,
+                         "vp9_extrc_request_gop_decisions() failed");
+    }
+  }
 #if CONFIG_MISMATCH_DEBUG
   mismatch_move_frame_idx_w();
 #endif
@@ -7478,10 +7711,13 @@ static void init_tpl_buffer(VP9_COMP *cpi) {
                      sizeof(*cpi->tpl_stats[frame].rd_diff_arr[rf_idx])));
     }
 #endif
-    vpx_free(cpi->tpl_stats[frame].tpl_stats_ptr);
-    CHECK_MEM_ERROR(cm, cpi->tpl_stats[frame].tpl_stats_ptr,
-                    vpx_calloc(mi_rows * mi_cols,
-                               sizeof(*cpi->tpl_stats[frame].tpl_stats_ptr)));
+    CHECK_MEM_ERROR(
+        cm, cpi->tpl_stats[frame].tpl_stats_ptr,
+        vp9_arena_region_calloc(&cpi->seq_arena,
+                                &cpi->tpl_stats[frame].tpl_stats_region,
+                                mi_rows * mi_cols,
+                                sizeof(*cpi->tpl_stats[frame].tpl_stats_ptr),
+                                16));
     cpi->tpl_stats[frame].is_valid = 0;
     cpi->tpl_stats[frame].width = mi_cols;
     cpi->tpl_stats[frame].height = mi_rows;
@@ -7510,7 +7746,8 @@ static void free_tpl_buffer(VP9_COMP *cpi) {
       vpx_free(cpi->tpl_stats[frame].rd_diff_arr[rf_idx]);
     }
 #endif
-    vpx_free(cpi->tpl_stats[frame].tpl_stats_ptr);
+    // The stats are owned by their region of the sequence arena.
+    cpi->tpl_stats[frame].tpl_stats_ptr = NULL;
     cpi->tpl_stats[frame].is_valid = 0;
   }
 }
@@ -7635,14 +7872,21 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   struct lookahead_entry *source = NULL;
   int arf_src_index;
   const int gf_group_index = cpi->twopass.gf_group.index;
+  const TplDepFrame *gop_tpl_stats = NULL;
   int i;
 
   if (is_one_pass_cbr_svc(cpi)) {
     vp9_one_pass_cbr_svc_start_layer(cpi);
   }
 
+  // The speed features of this frame are picked with the speed chosen by the
+  // deadline control. vp9_change_config() restores the configured speed.
+  if (vp9_deadline_control_active(cpi)) cpi->oxcf.speed = cpi->deadline.speed;
+
   vpx_usec_timer_start(&cmptimer);
 
+  vp9_arena_reset(&cpi->frame_arena);
+
   vp9_set_high_precision_mv(cpi, ALTREF_HIGH_PRECISION_MV);
 
   // Is multi-arf enabled.
@@ -7863,6 +8107,7 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     init_tpl_buffer(cpi);
     vp9_estimate_qp_gop(cpi);
     setup_tpl_stats(cpi);
+    gop_tpl_stats = cpi->tpl_stats;
   }
 
 #if CONFIG_BITSTREAM_DEBUG
@@ -7877,6 +8122,7 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   cpi->td.mb.fp_src_pred = 0;
 #if CONFIG_REALTIME_ONLY
   (void)encode_frame_result;
+  (void)gop_tpl_stats;
   if (cpi->use_svc) {
     SvcEncode(cpi, size, dest, frame_flags);
   } else {
@@ -7900,7 +8146,8 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     cpi->td.mb.inv_txfm_add = lossless ? vp9_iwht4x4_add : vp9_idct4x4_add;
     vp9_first_pass(cpi, source);
   } else if (oxcf->pass == 2 && !cpi->use_svc) {
-    Pass2Encode(cpi, size, dest, frame_flags, encode_frame_result);
+    Pass2Encode(cpi, size, dest, frame_flags, encode_frame_result,
+                gop_tpl_stats);
     vp9_twopass_postencode_update(cpi);
   } else if (cpi->use_svc) {
     SvcEncode(cpi, size, dest, frame_flags);
@@ -7934,6 +8181,10 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
   vpx_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += vpx_usec_timer_elapsed(&cmptimer);
 
+  if (*size > 0)
+    vp9_update_deadline_control(cpi, vpx_usec_timer_elapsed(&cmptimer),
+                                frame_is_intra_only(cm));
+
   if (cpi->keep_level_stats && oxcf->pass != 1)
     update_level_info(cpi, size, arf_src_index);
 
@@ -7976,13 +8227,16 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
           PSNR_STATS psnr2;
           double frame_ssim2 = 0, weight = 0;
 #if CONFIG_VP9_POSTPROC
-          if (vpx_alloc_frame_buffer(
+          // Keep the buffer from frame to frame; it is only reallocated when
+          // the frame outgrows it.
+          if (vpx_realloc_frame_buffer(
                   pp, recon->y_crop_width, recon->y_crop_height,
                   cm->subsampling_x, cm->subsampling_y,
 #if CONFIG_VP9_HIGHBITDEPTH
                   cm->use_highbitdepth,
 #endif
-                  VP9_ENC_BORDER_IN_PIXELS, cm->byte_alignment) < 0) {
+                  VP9_ENC_BORDER_IN_PIXELS, cm->byte_alignment, NULL, NULL,
+                  NULL) < 0) {
             vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
                                "Failed to allocate post processing buffer");
           }
@@ -36,6 +36,7 @@
 #include "vp9/encoder/vp9_alt_ref_aq.h"
 #endif
 #include "vp9/encoder/vp9_aq_cyclicrefresh.h"
+#include "vp9/encoder/vp9_arena.h"
 #include "vp9/encoder/vp9_context_tree.h"
 #include "vp9/encoder/vp9_encodemb.h"
 #include "vp9/encoder/vp9_ethread.h"
@@ -46,6 +47,7 @@
 #include "vp9/encoder/vp9_mbgraph.h"
 #include "vp9/encoder/vp9_mcomp.h"
 #include "vp9/encoder/vp9_noise_estimate.h"
+#include "vp9/encoder/vp9_pyramid_me.h"
 #include "vp9/encoder/vp9_quantize.h"
 #include "vp9/encoder/vp9_ratectrl.h"
 #include "vp9/encoder/vp9_rd.h"
@@ -267,6 +269,20 @@ typedef struct VP9EncoderConfig {
 
   int enable_tpl_model;
 
+  // Seed motion searches from a frame level pyramid motion search.
+  int pyramid_me;
+
+  // Target encode time per frame in microseconds for real-time mode, 0 to
+  // keep the speed fixed.
+  unsigned int frame_time_budget;
+
+  // Code scene cuts found in one pass CBR mode as key frames.
+  int scene_cut_key_frame;
+
+  // Compute the PSNR of each shown frame on a thread of its own while the
+  // next frame is coded. The PSNR is returned one frame late.
+  int async_psnr;
+
   int max_threads;
 
   unsigned int target_level;
@@ -317,6 +333,8 @@ typedef struct TplDepStats {
 typedef struct TplDepFrame {
   uint8_t is_valid;
   TplDepStats *tpl_stats_ptr;
+  // Region of the sequence arena that holds tpl_stats_ptr.
+  VP9ArenaRegion *tpl_stats_region;
   int stride;
   int width;
   int height;
@@ -370,6 +388,8 @@ typedef struct MultiThreadHandle {
 
   // Job Queue structure and handles
   JobQueue *job_queue;
+  // Region of the sequence arena that holds the job queue.
+  VP9ArenaRegion *job_queue_region;
 
   int jobs_per_tile_col;
 
@@ -391,6 +411,9 @@ typedef struct ThreadData {
   PICK_MODE_CONTEXT *leaf_tree;
   PC_TREE *pc_tree;
   PC_TREE *pc_root;
+
+  // Scratch space of choose_partitioning(), taken from the frame arena.
+  void *var_tree_scratch;
 } ThreadData;
 
 struct EncWorkerData;
@@ -659,6 +682,25 @@ static INLINE int get_num_unit_4x4(int size) { return (size + 3) >> 2; }
 static INLINE int get_num_unit_16x16(int size) { return (size + 15) >> 4; }
 #endif  // CONFIG_RATE_CTRL
 
+// The PSNR of a shown frame, computed on a thread of its own while the next
+// frame is coded (oxcf.async_psnr).
+typedef struct ASYNC_PSNR {
+  VPxWorker worker;
+  int worker_ready;
+  // A computation is running.
+  int pending;
+  // The result of a computation has not been returned yet.
+  int ready;
+  // A copy of the source frame, and the frame buffer of the reconstruction,
+  // which is held until the computation is done.
+  YV12_BUFFER_CONFIG source;
+  int recon_fb_idx;
+  uint32_t bit_depth;
+  uint32_t input_bit_depth;
+  // The sums of squared errors of the planes.
+  uint64_t sse[3];
+} ASYNC_PSNR;
+
 typedef struct VP9_COMP {
   FRAME_INFO frame_info;
   QUANTS quants;
@@ -848,6 +890,7 @@ typedef struct VP9_COMP {
   Metrics metrics;
 #endif
   int b_calculate_psnr;
+  ASYNC_PSNR async_psnr;
 
   int droppable;
 
@@ -919,6 +962,10 @@ typedef struct VP9_COMP {
   struct EncWorkerData *tile_thr_data;
   VP9LfSync lf_row_sync;
   struct VP9BitstreamWorkerData *vp9_bitstream_worker_data;
+  // Regions of the sequence arena that hold the bitstream worker data and
+  // the tile buffers of the workers.
+  VP9ArenaRegion *bitstream_worker_region;
+  VP9ArenaRegion *bitstream_dest_region;
 
   int keep_level_stats;
   Vp9LevelInfo level_info;
@@ -926,6 +973,16 @@ typedef struct VP9_COMP {
   void (*row_mt_sync_read_ptr)(VP9RowMTSync *const, int, int);
   void (*row_mt_sync_write_ptr)(VP9RowMTSync *const, int, int, const int);
   ARNRFilterData arnr_filter_data;
+  PyramidME pyramid_me;
+  DEADLINE_CONTROL deadline;
+
+  // Buffers sized from the frame dimensions. The mbgraph stats are released
+  // together when the frame buffers are reallocated for a larger size. The
+  // TPL stats, the row-mt job queue and the bitstream worker buffers grow on
+  // their own, each in a high-water region.
+  VP9Arena seq_arena;
+  // Scratch buffers that only live for the encode of one frame.
+  VP9Arena frame_arena;
 
   int row_mt;
   unsigned int row_mt_bit_exact;
@@ -1293,7 +1350,7 @@ YV12_BUFFER_CONFIG *vp9_svc_twostage_scale(
     int phase_scaler, INTERP_FILTER filter_type2, int phase_scaler2);
 
 YV12_BUFFER_CONFIG *vp9_scale_if_required(
-    VP9_COMMON *cm, YV12_BUFFER_CONFIG *unscaled, YV12_BUFFER_CONFIG *scaled,
+    VP9_COMP *cpi, YV12_BUFFER_CONFIG *unscaled, YV12_BUFFER_CONFIG *scaled,
     int use_normative_scaler, INTERP_FILTER filter_type, int phase_scaler);
 
 void vp9_apply_encoding_flags(VP9_COMP *cpi, vpx_enc_frame_flags_t flags);
@@ -1379,7 +1436,15 @@ void vp9_new_framerate(VP9_COMP *cpi, double framerate);
 
 void vp9_set_row_mt(VP9_COMP *cpi);
 
-int vp9_get_psnr(const VP9_COMP *cpi, PSNR_STATS *psnr);
+// Returns the PSNR of the frame just coded in psnr, or with
+// oxcf.async_psnr that of the previous shown frame, whose computation
+// overlapped the coding of this one. Returns 0 if there is none.
+int vp9_get_psnr(VP9_COMP *cpi, PSNR_STATS *psnr);
+
+// Waits for the PSNR of the last shown frame with oxcf.async_psnr, or
+// returns that of the frame before oxcf.async_psnr was turned off. Returns 0
+// if there is none left to return.
+int vp9_flush_psnr(VP9_COMP *cpi, PSNR_STATS *psnr);
 
 #define LAYER_IDS_TO_IDX(sl, tl, num_tl) ((sl) * (num_tl) + (tl))
 
@@ -13,7 +13,9 @@
 #include "vp9/encoder/vp9_ethread.h"
 #include "vp9/encoder/vp9_firstpass.h"
 #include "vp9/encoder/vp9_multi_thread.h"
+#include "vp9/encoder/vp9_pyramid_me.h"
 #include "vp9/encoder/vp9_temporal_filter.h"
+#include "vpx_dsp/psnr.h"
 #include "vpx_dsp/vpx_dsp_common.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
@@ -169,6 +171,63 @@ static void launch_enc_workers(VP9_COMP *cpi, VPxWorkerHook hook, void *data2,
   }
 }
 
+// Below this many sets of counters, adding them on the main thread is cheaper
+// than launching the workers.
+#define MIN_PARALLEL_COUNT_REDUCTION 4
+
+typedef struct CountReduction {
+  ThreadData *td[MAX_NUM_THREADS + 1];
+  int num;
+  int stride;
+} CountReduction;
+
+static void accumulate_counts(ThreadData *td, ThreadData *td_t) {
+  vp9_accumulate_frame_counts(td->counts, td_t->counts, 0);
+  accumulate_rd_opt(td, td_t);
+}
+
+static int accumulate_counts_worker_hook(void *arg1, void *arg2) {
+  const EncWorkerData *const thread_data = (const EncWorkerData *)arg1;
+  const CountReduction *const reduction = (const CountReduction *)arg2;
+  const int dst = thread_data->start * 2 * reduction->stride;
+  const int src = dst + reduction->stride;
+
+  if (src < reduction->num)
+    accumulate_counts(reduction->td[dst], reduction->td[src]);
+  return 1;
+}
+
+// Adds the counters of the workers used for the frame to the frame counters
+// and cpi->td. With enough workers the sum is a tree reduction run on the
+// workers: every round adds pairs of counters in parallel, which takes
+// log2(num) rounds instead of num - 1 additions on the main thread.
+static void accumulate_worker_counts(VP9_COMP *cpi, int num_workers) {
+  CountReduction reduction;
+  int i;
+
+  reduction.td[0] = &cpi->td;
+  reduction.num = 1;
+  for (i = 0; i < num_workers; ++i) {
+    if (i < cpi->num_workers - 1)
+      reduction.td[reduction.num++] = cpi->tile_thr_data[i].td;
+  }
+
+  if (reduction.num < MIN_PARALLEL_COUNT_REDUCTION) {
+    for (i = 1; i < reduction.num; ++i)
+      accumulate_counts(&cpi->td, reduction.td[i]);
+    return;
+  }
+
+  for (reduction.stride = 1; reduction.stride < reduction.num;
+       reduction.stride <<= 1) {
+    const int pair_dist = 2 * reduction.stride;
+    const int num_jobs =
+        (reduction.num - reduction.stride + pair_dist - 1) / pair_dist;
+    launch_enc_workers(cpi, accumulate_counts_worker_hook, &reduction,
+                       num_jobs);
+  }
+}
+
 void vp9_encode_tiles_mt(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   const int tile_cols = 1 << cm->log2_tile_cols;
@@ -187,6 +246,7 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
       thread_data->td->rd_counts = cpi->td.rd_counts;
+      vp9_alloc_thread_frame_scratch(cpi, thread_data->td);
     }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
@@ -213,16 +273,7 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
 
   launch_enc_workers(cpi, enc_worker_hook, NULL, num_workers);
 
-  for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    EncWorkerData *const thread_data = (EncWorkerData *)worker->data1;
-
-    // Accumulate counters.
-    if (i < cpi->num_workers - 1) {
-      vp9_accumulate_frame_counts(&cm->counts, thread_data->td->counts, 0);
-      accumulate_rd_opt(&cpi->td, thread_data->td);
-    }
-  }
+  accumulate_worker_counts(cpi, num_workers);
 }
 
 #if !CONFIG_REALTIME_ONLY
@@ -560,6 +611,65 @@ void vp9_temporal_filter_row_mt(VP9_COMP *cpi) {
 }
 #endif  // !CONFIG_REALTIME_ONLY
 
+static int pyramid_me_worker_hook(void *arg1, void *unused) {
+  EncWorkerData *const thread_data = (EncWorkerData *)arg1;
+  VP9_COMP *const cpi = thread_data->cpi;
+
+  (void)unused;
+
+  vp9_pyramid_me_search_rows(cpi, thread_data->start, cpi->num_workers);
+  return 0;
+}
+
+void vp9_pyramid_me_mt(VP9_COMP *cpi) {
+  launch_enc_workers(cpi, pyramid_me_worker_hook, NULL, cpi->num_workers);
+}
+
+typedef struct PsnrBands {
+  const YV12_BUFFER_CONFIG *a;
+  const YV12_BUFFER_CONFIG *b;
+  uint32_t bit_depth;
+  uint32_t input_bit_depth;
+  uint64_t sse[MAX_NUM_THREADS][3];
+} PsnrBands;
+
+static int psnr_worker_hook(void *arg1, void *arg2) {
+  const EncWorkerData *const thread_data = (const EncWorkerData *)arg1;
+  PsnrBands *const bands = (PsnrBands *)arg2;
+  const int band = thread_data->start;
+  const int num_bands = thread_data->cpi->num_workers;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  vpx_calc_highbd_plane_sse(bands->a, bands->b, band, num_bands,
+                            bands->bit_depth, bands->input_bit_depth,
+                            bands->sse[band]);
+#else
+  vpx_calc_plane_sse(bands->a, bands->b, band, num_bands, bands->sse[band]);
+#endif
+  return 1;
+}
+
+void vp9_calc_psnr_mt(VP9_COMP *cpi, const YV12_BUFFER_CONFIG *a,
+                      const YV12_BUFFER_CONFIG *b, uint32_t bit_depth,
+                      uint32_t input_bit_depth, PSNR_STATS *psnr) {
+  PsnrBands bands;
+  uint64_t sse[3] = { 0, 0, 0 };
+  int i, j;
+
+  bands.a = a;
+  bands.b = b;
+  bands.bit_depth = bit_depth;
+  bands.input_bit_depth = input_bit_depth;
+  launch_enc_workers(cpi, psnr_worker_hook, &bands, cpi->num_workers);
+
+  // The sums of the bands are integers, so the result does not depend on the
+  // number of workers.
+  for (i = 0; i < cpi->num_workers; ++i) {
+    for (j = 0; j < 3; ++j) sse[j] += bands.sse[i][j];
+  }
+  vpx_sse_to_psnr_stats(a, sse, (double)((1 << input_bit_depth) - 1), psnr);
+}
+
 static int enc_row_mt_worker_hook(void *arg1, void *arg2) {
   EncWorkerData *const thread_data = (EncWorkerData *)arg1;
   MultiThreadHandle *multi_thread_ctxt = (MultiThreadHandle *)arg2;
@@ -627,6 +737,7 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
       thread_data->td->rd_counts = cpi->td.rd_counts;
+      vp9_alloc_thread_frame_scratch(cpi, thread_data->td);
     }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
@@ -654,14 +765,5 @@ void vp9_encode_tiles_row_mt(VP9_COMP *cpi) {
   launch_enc_workers(cpi, enc_row_mt_worker_hook, multi_thread_ctxt,
                      num_workers);
 
-  for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    EncWorkerData *const thread_data = (EncWorkerData *)worker->data1;
-
-    // Accumulate counters.
-    if (i < cpi->num_workers - 1) {
-      vp9_accumulate_frame_counts(&cm->counts, thread_data->td->counts, 0);
-      accumulate_rd_opt(&cpi->td, thread_data->td);
-    }
-  }
+  accumulate_worker_counts(cpi, num_workers);
 }
@@ -11,6 +11,9 @@
 #ifndef VPX_VP9_ENCODER_VP9_ETHREAD_H_
 #define VPX_VP9_ENCODER_VP9_ETHREAD_H_
 
+#include "vpx_dsp/psnr.h"
+#include "vpx_scale/yv12config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -65,6 +68,15 @@ void vp9_row_mt_sync_mem_dealloc(VP9RowMTSync *row_mt_sync);
 
 void vp9_temporal_filter_row_mt(struct VP9_COMP *cpi);
 
+void vp9_pyramid_me_mt(struct VP9_COMP *cpi);
+
+// Computes the PSNR of b against a with the rows of the planes split across
+// the encoder workers. The result matches vpx_calc_psnr() and
+// vpx_calc_highbd_psnr().
+void vp9_calc_psnr_mt(struct VP9_COMP *cpi, const YV12_BUFFER_CONFIG *a,
+                      const YV12_BUFFER_CONFIG *b, uint32_t bit_depth,
+                      uint32_t input_bit_depth, PSNR_STATS *psnr);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -8,10 +8,14 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <limits.h>
+#include <string.h>
+
 #include "vp9/encoder/vp9_ext_ratectrl.h"
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/common/vp9_common.h"
 #include "vpx_dsp/psnr.h"
+#include "vpx_dsp/vpx_dsp_common.h"
 
 vpx_codec_err_t vp9_extrc_init(EXT_RATECTRL *ext_ratectrl) {
   if (ext_ratectrl == NULL) {
@@ -47,6 +51,30 @@ vpx_codec_err_t vp9_extrc_create(vpx_rc_funcs_t funcs,
     return VPX_CODEC_MEM_ERROR;
   }
   ext_ratectrl->ready = 1;
+  if (funcs.get_gop_decisions != NULL) {
+    const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+    winterface->init(&ext_ratectrl->worker);
+    if (funcs.async_gop_decisions &&
+        !winterface->reset(&ext_ratectrl->worker)) {
+      return VPX_CODEC_MEM_ERROR;
+    }
+  }
+  return VPX_CODEC_OK;
+}
+
+// Waits for the pending get_gop_decisions() call, if any.
+static vpx_codec_err_t extrc_sync_gop_decisions(EXT_RATECTRL *ext_ratectrl) {
+  if (!ext_ratectrl->gop_pending) return VPX_CODEC_OK;
+  if (ext_ratectrl->funcs.async_gop_decisions) {
+    vpx_get_worker_interface()->sync(&ext_ratectrl->worker);
+  }
+  ext_ratectrl->gop_pending = 0;
+  // The model has taken the results sent with the call.
+  ext_ratectrl->num_results = 0;
+  if (ext_ratectrl->gop_status == VPX_RC_ERROR) {
+    ext_ratectrl->gop_num_frames = 0;
+    return VPX_CODEC_ERROR;
+  }
   return VPX_CODEC_OK;
 }
 
@@ -55,8 +83,23 @@ vpx_codec_err_t vp9_extrc_delete(EXT_RATECTRL *ext_ratectrl) {
     return VPX_CODEC_INVALID_PARAM;
   }
   if (ext_ratectrl->ready) {
-    vpx_rc_status_t rc_status =
-        ext_ratectrl->funcs.delete_model(ext_ratectrl->model);
+    vpx_rc_status_t rc_status = VPX_RC_OK;
+    if (ext_ratectrl->funcs.get_gop_decisions != NULL) {
+      int i;
+      extrc_sync_gop_decisions(ext_ratectrl);
+      vpx_get_worker_interface()->end(&ext_ratectrl->worker);
+      if (ext_ratectrl->funcs.update_encodeframe_result != NULL) {
+        for (i = 0; i < ext_ratectrl->num_results && rc_status == VPX_RC_OK;
+             ++i) {
+          rc_status = ext_ratectrl->funcs.update_encodeframe_result(
+              ext_ratectrl->model, &ext_ratectrl->results[i]);
+        }
+      }
+    }
+    if (ext_ratectrl->funcs.delete_model(ext_ratectrl->model) ==
+        VPX_RC_ERROR) {
+      rc_status = VPX_RC_ERROR;
+    }
     if (rc_status == VPX_RC_ERROR) {
       return VPX_CODEC_ERROR;
     }
@@ -135,6 +178,114 @@ static int extrc_get_frame_type(FRAME_UPDATE_TYPE update_type) {
   }
 }
 
+static int extrc_gop_decisions_hook(void *arg1, void *arg2) {
+  EXT_RATECTRL *const ext_ratectrl = (EXT_RATECTRL *)arg1;
+  (void)arg2;
+  ext_ratectrl->gop_status = ext_ratectrl->funcs.get_gop_decisions(
+      ext_ratectrl->model, &ext_ratectrl->gop_info,
+      ext_ratectrl->gop_decisions);
+  return 1;
+}
+
+static void extrc_sum_tpl_stats(const TplDepFrame *tpl_frame, int mi_rows,
+                                int mi_cols,
+                                vpx_rc_tpl_frame_stats_t *tpl_stats) {
+  int row, col;
+  vp9_zero(*tpl_stats);
+  if (!tpl_frame->is_valid) return;
+  for (row = 0; row < mi_rows; ++row) {
+    const TplDepStats *this_stats =
+        &tpl_frame->tpl_stats_ptr[row * tpl_frame->stride];
+    for (col = 0; col < mi_cols; ++col) {
+      tpl_stats->intra_cost += this_stats[col].intra_cost;
+      tpl_stats->inter_cost += this_stats[col].inter_cost;
+      tpl_stats->mc_dep_cost += this_stats[col].mc_dep_cost;
+    }
+  }
+  tpl_stats->valid = 1;
+}
+
+vpx_codec_err_t vp9_extrc_request_gop_decisions(
+    EXT_RATECTRL *ext_ratectrl, const GF_GROUP *gf_group, int coding_index,
+    const struct TplDepFrame *tpl_frames, int mi_rows, int mi_cols) {
+  const int first_index = gf_group->index;
+  const int num_frames = gf_group->gf_group_size - first_index;
+  const vpx_rc_firstpass_stats_t *rc_firstpass_stats;
+  vpx_rc_gop_info_t *gop_info;
+  vpx_codec_err_t codec_status;
+  int min_show_index = INT_MAX;
+  int max_show_index = -1;
+  int i;
+  if (ext_ratectrl == NULL || gf_group == NULL) {
+    return VPX_CODEC_INVALID_PARAM;
+  }
+  if (!ext_ratectrl->ready || ext_ratectrl->funcs.get_gop_decisions == NULL ||
+      num_frames <= 0) {
+    return VPX_CODEC_OK;
+  }
+  codec_status = extrc_sync_gop_decisions(ext_ratectrl);
+  if (codec_status != VPX_CODEC_OK) return codec_status;
+  if (tpl_frames == NULL &&
+      ext_ratectrl->gop_frame_start == (int)gf_group->frame_start &&
+      first_index >= ext_ratectrl->gop_first_index &&
+      first_index <
+          ext_ratectrl->gop_first_index + ext_ratectrl->gop_num_frames) {
+    return VPX_CODEC_OK;
+  }
+  assert(num_frames <= EXTRC_MAX_GOP_FRAMES);
+
+  for (i = 0; i < num_frames; ++i) {
+    const int gop_index = first_index + i;
+    vpx_rc_encodeframe_info_t *frame_info = &ext_ratectrl->gop_frame_info[i];
+    frame_info->frame_type =
+        extrc_get_frame_type(gf_group->update_type[gop_index]);
+    // The frame at gf_group index 0 is the one the group starts with.
+    frame_info->show_index =
+        gf_group->frame_start +
+        (gop_index == 0 ? 0 : gf_group->frame_gop_index[gop_index]);
+    frame_info->coding_index = coding_index + i;
+    frame_info->gop_index = gop_index;
+    memset(frame_info->ref_frame_coding_indexes, -1,
+           sizeof(frame_info->ref_frame_coding_indexes));
+    memset(frame_info->ref_frame_valid_list, 0,
+           sizeof(frame_info->ref_frame_valid_list));
+    min_show_index = VPXMIN(min_show_index, frame_info->show_index);
+    max_show_index = VPXMAX(max_show_index, frame_info->show_index);
+
+    if (tpl_frames != NULL && gop_index < MAX_ARF_GOP_SIZE) {
+      extrc_sum_tpl_stats(&tpl_frames[gop_index], mi_rows, mi_cols,
+                          &ext_ratectrl->gop_tpl_stats[i]);
+    } else {
+      vp9_zero(ext_ratectrl->gop_tpl_stats[i]);
+    }
+  }
+
+  gop_info = &ext_ratectrl->gop_info;
+  rc_firstpass_stats = &ext_ratectrl->rc_firstpass_stats;
+  gop_info->num_frames = num_frames;
+  gop_info->frame_info = ext_ratectrl->gop_frame_info;
+  gop_info->tpl_stats = ext_ratectrl->gop_tpl_stats;
+  max_show_index = VPXMIN(max_show_index, rc_firstpass_stats->num_frames - 1);
+  gop_info->frame_stats = rc_firstpass_stats->frame_stats + min_show_index;
+  gop_info->num_frame_stats = VPXMAX(max_show_index - min_show_index + 1, 0);
+  gop_info->results = ext_ratectrl->results;
+  gop_info->num_results = ext_ratectrl->num_results;
+
+  ext_ratectrl->gop_frame_start = gf_group->frame_start;
+  ext_ratectrl->gop_first_index = first_index;
+  ext_ratectrl->gop_num_frames = num_frames;
+  ext_ratectrl->gop_pending = 1;
+  ext_ratectrl->worker.hook = extrc_gop_decisions_hook;
+  ext_ratectrl->worker.data1 = ext_ratectrl;
+  ext_ratectrl->worker.data2 = NULL;
+  if (ext_ratectrl->funcs.async_gop_decisions) {
+    vpx_get_worker_interface()->launch(&ext_ratectrl->worker);
+  } else {
+    vpx_get_worker_interface()->execute(&ext_ratectrl->worker);
+  }
+  return VPX_CODEC_OK;
+}
+
 vpx_codec_err_t vp9_extrc_get_encodeframe_decision(
     EXT_RATECTRL *ext_ratectrl, int show_index, int coding_index, int gop_index,
     FRAME_UPDATE_TYPE update_type,
@@ -143,7 +294,17 @@ vpx_codec_err_t vp9_extrc_get_encodeframe_decision(
   if (ext_ratectrl == NULL) {
     return VPX_CODEC_INVALID_PARAM;
   }
-  if (ext_ratectrl->ready) {
+  if (ext_ratectrl->ready && ext_ratectrl->funcs.get_gop_decisions != NULL) {
+    const int i = gop_index - ext_ratectrl->gop_first_index;
+    const vpx_codec_err_t codec_status =
+        extrc_sync_gop_decisions(ext_ratectrl);
+    if (codec_status != VPX_CODEC_OK) return codec_status;
+    if (i < 0 || i >= ext_ratectrl->gop_num_frames ||
+        ext_ratectrl->gop_frame_info[i].coding_index != coding_index) {
+      return VPX_CODEC_ERROR;
+    }
+    *encode_frame_decision = ext_ratectrl->gop_decisions[i];
+  } else if (ext_ratectrl->ready) {
     vpx_rc_status_t rc_status;
     vpx_rc_encodeframe_info_t encode_frame_info;
     encode_frame_info.show_index = show_index;
@@ -176,6 +337,14 @@ vpx_codec_err_t vp9_extrc_update_encodeframe_result(
     PSNR_STATS psnr;
     vpx_rc_status_t rc_status;
     vpx_rc_encodeframe_result_t encode_frame_result;
+    if (ext_ratectrl->funcs.get_gop_decisions != NULL) {
+      const vpx_codec_err_t codec_status =
+          extrc_sync_gop_decisions(ext_ratectrl);
+      if (codec_status != VPX_CODEC_OK) return codec_status;
+      if (ext_ratectrl->num_results == EXTRC_MAX_GOP_FRAMES) {
+        return VPX_CODEC_ERROR;
+      }
+    }
     encode_frame_result.bit_count = bit_count;
     encode_frame_result.pixel_count =
         source_frame->y_crop_width * source_frame->y_crop_height +
@@ -190,6 +359,11 @@ vpx_codec_err_t vp9_extrc_update_encodeframe_result(
     vpx_calc_psnr(source_frame, coded_frame, &psnr);
 #endif
     encode_frame_result.sse = psnr.sse[0];
+    if (ext_ratectrl->funcs.get_gop_decisions != NULL) {
+      // Sent with the next get_gop_decisions() call.
+      ext_ratectrl->results[ext_ratectrl->num_results++] = encode_frame_result;
+      return VPX_CODEC_OK;
+    }
     rc_status = ext_ratectrl->funcs.update_encodeframe_result(
         ext_ratectrl->model, &encode_frame_result);
     if (rc_status == VPX_RC_ERROR) {
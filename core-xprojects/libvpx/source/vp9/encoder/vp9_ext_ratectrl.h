@@ -12,14 +12,38 @@
 #define VPX_VP9_ENCODER_VP9_EXT_RATECTRL_H_
 
 #include "vpx/vpx_ext_ratectrl.h"
+#include "vpx_util/vpx_thread.h"
 #include "vp9/encoder/vp9_firstpass.h"
 
+#define EXTRC_MAX_GOP_FRAMES (MAX_STATIC_GF_GROUP_LENGTH + 2)
+
+struct TplDepFrame;
+
 typedef struct EXT_RATECTRL {
   int ready;
   vpx_rc_model_t model;
   vpx_rc_funcs_t funcs;
   vpx_rc_config_t ratectrl_config;
   vpx_rc_firstpass_stats_t rc_firstpass_stats;
+
+  // The decisions of the group of pictures starting at show frame
+  // gop_frame_start, for its frames from gf_group index gop_first_index on.
+  // Only used when funcs.get_gop_decisions is set.
+  int gop_frame_start;
+  int gop_first_index;
+  int gop_num_frames;
+  vpx_rc_gop_info_t gop_info;
+  vpx_rc_encodeframe_info_t gop_frame_info[EXTRC_MAX_GOP_FRAMES];
+  vpx_rc_tpl_frame_stats_t gop_tpl_stats[EXTRC_MAX_GOP_FRAMES];
+  vpx_rc_encodeframe_decision_t gop_decisions[EXTRC_MAX_GOP_FRAMES];
+  // Results of the frames coded since the last get_gop_decisions() call.
+  vpx_rc_encodeframe_result_t results[EXTRC_MAX_GOP_FRAMES];
+  int num_results;
+  // Runs get_gop_decisions(), on a thread of its own if
+  // funcs.async_gop_decisions is set.
+  VPxWorker worker;
+  int gop_pending;
+  vpx_rc_status_t gop_status;
 } EXT_RATECTRL;
 
 vpx_codec_err_t vp9_extrc_init(EXT_RATECTRL *ext_ratectrl);
@@ -33,6 +57,14 @@ vpx_codec_err_t vp9_extrc_delete(EXT_RATECTRL *ext_ratectrl);
 vpx_codec_err_t vp9_extrc_send_firstpass_stats(
     EXT_RATECTRL *ext_ratectrl, const FIRST_PASS_INFO *first_pass_info);
 
+// Asks the model for the decisions of the frames of the group of pictures
+// from gf_group->index on, unless they are cached already. Pass the
+// temporal dependency stats when the model has just run on the group, to
+// have the decisions made again with them.
+vpx_codec_err_t vp9_extrc_request_gop_decisions(
+    EXT_RATECTRL *ext_ratectrl, const GF_GROUP *gf_group, int coding_index,
+    const struct TplDepFrame *tpl_frames, int mi_rows, int mi_cols);
+
 vpx_codec_err_t vp9_extrc_get_encodeframe_decision(
     EXT_RATECTRL *ext_ratectrl, int show_index, int coding_index, int gop_index,
     FRAME_UPDATE_TYPE update_type,
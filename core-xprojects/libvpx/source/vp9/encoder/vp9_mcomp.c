@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "./vpx_config.h"
 #include "./vpx_dsp_rtcd.h"
@@ -945,6 +946,44 @@ static INLINE int is_mv_in(const MvLimits *mv_limits, const MV *mv) {
          (mv->row >= mv_limits->row_min) && (mv->row <= mv_limits->row_max);
 }
 
+// Computes the sads of |num| full pel candidates, all within the mv limits.
+// Candidates are submitted 8 or 4 at a time to the multi-block sad functions,
+// which load each source row once for the whole batch; the results are the
+// same as calling sdf() on each candidate.
+static void get_mv_sads(const struct buf_2d *what,
+                        const struct buf_2d *in_what,
+                        const vp9_variance_fn_ptr_t *fn_ptr, const MV *mvs,
+                        int num, uint32_t *sads) {
+  const uint8_t *addrs[8];
+  uint32_t batch_sads[8];
+  int i = 0, j;
+
+  // A partial batch of 8 is padded with the last candidate; a batch of 8 is
+  // still cheaper than 4 + sdf() calls.
+  if (fn_ptr->sdx8df != NULL) {
+    for (; num - i > 4; i += 8) {
+      const int n = VPXMIN(num - i, 8);
+      for (j = 0; j < 8; ++j)
+        addrs[j] = get_buf_from_mv(in_what, &mvs[i + VPXMIN(j, n - 1)]);
+      fn_ptr->sdx8df(what->buf, what->stride, addrs, in_what->stride,
+                     batch_sads);
+      memcpy(sads + i, batch_sads, n * sizeof(*sads));
+    }
+  }
+  for (; num - i > 1; i += 4) {
+    const int n = VPXMIN(num - i, 4);
+    for (j = 0; j < 4; ++j)
+      addrs[j] = get_buf_from_mv(in_what, &mvs[i + VPXMIN(j, n - 1)]);
+    fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride,
+                   batch_sads);
+    memcpy(sads + i, batch_sads, n * sizeof(*sads));
+  }
+  if (i < num) {
+    sads[i] = fn_ptr->sdf(what->buf, what->stride,
+                          get_buf_from_mv(in_what, &mvs[i]), in_what->stride);
+  }
+}
+
 #define CHECK_BETTER                                                      \
   {                                                                       \
     if (thissad < bestsad) {                                              \
@@ -1050,12 +1089,16 @@ static int vp9_pattern_search(
     for (t = 0; t <= s; ++t) {
       int best_site = -1;
       if (check_bounds(&x->mv_limits, br, bc, 1 << t)) {
+        MV mvs[MAX_PATTERN_CANDIDATES];
+        uint32_t sads[MAX_PATTERN_CANDIDATES];
         for (i = 0; i < num_candidates[t]; i++) {
-          const MV this_mv = { br + candidates[t][i].row,
-                               bc + candidates[t][i].col };
-          thissad =
-              vfp->sdf(what->buf, what->stride,
-                       get_buf_from_mv(in_what, &this_mv), in_what->stride);
+          mvs[i].row = br + candidates[t][i].row;
+          mvs[i].col = bc + candidates[t][i].col;
+        }
+        get_mv_sads(what, in_what, vfp, mvs, num_candidates[t], sads);
+        for (i = 0; i < num_candidates[t]; i++) {
+          const MV this_mv = mvs[i];
+          thissad = sads[i];
           CHECK_BETTER
         }
       } else {
@@ -1092,12 +1135,16 @@ static int vp9_pattern_search(
       // No need to search all 6 points the 1st time if initial search was used
       if (!do_init_search || s != best_init_s) {
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
+          MV mvs[MAX_PATTERN_CANDIDATES];
+          uint32_t sads[MAX_PATTERN_CANDIDATES];
           for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
+            mvs[i].row = br + candidates[s][i].row;
+            mvs[i].col = bc + candidates[s][i].col;
+          }
+          get_mv_sads(what, in_what, vfp, mvs, num_candidates[s], sads);
+          for (i = 0; i < num_candidates[s]; i++) {
+            const MV this_mv = mvs[i];
+            thissad = sads[i];
             CHECK_BETTER
           }
         } else {
@@ -1129,14 +1176,16 @@ static int vp9_pattern_search(
         next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
 
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
+          MV mvs[MAX_PATTERN_CANDIDATES];
+          uint32_t sads[MAX_PATTERN_CANDIDATES];
           for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
+            mvs[i].row = br + candidates[s][next_chkpts_indices[i]].row;
+            mvs[i].col = bc + candidates[s][next_chkpts_indices[i]].col;
+          }
+          get_mv_sads(what, in_what, vfp, mvs, PATTERN_CANDIDATES_REF, sads);
+          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
+            const MV this_mv = mvs[i];
+            thissad = sads[i];
             CHECK_BETTER
           }
         } else {
@@ -1224,12 +1273,16 @@ static int vp9_pattern_search_sad(
     for (t = 0; t <= s; ++t) {
       int best_site = -1;
       if (check_bounds(&x->mv_limits, br, bc, 1 << t)) {
+        MV mvs[MAX_PATTERN_CANDIDATES];
+        uint32_t sads[MAX_PATTERN_CANDIDATES];
         for (i = 0; i < num_candidates[t]; i++) {
-          const MV this_mv = { br + candidates[t][i].row,
-                               bc + candidates[t][i].col };
-          thissad =
-              vfp->sdf(what->buf, what->stride,
-                       get_buf_from_mv(in_what, &this_mv), in_what->stride);
+          mvs[i].row = br + candidates[t][i].row;
+          mvs[i].col = bc + candidates[t][i].col;
+        }
+        get_mv_sads(what, in_what, vfp, mvs, num_candidates[t], sads);
+        for (i = 0; i < num_candidates[t]; i++) {
+          const MV this_mv = mvs[i];
+          thissad = sads[i];
           CHECK_BETTER
         }
       } else {
@@ -1266,12 +1319,16 @@ static int vp9_pattern_search_sad(
     for (; s >= do_sad; s--) {
       if (!do_init_search || s != best_init_s) {
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
+          MV mvs[MAX_PATTERN_CANDIDATES];
+          uint32_t sads[MAX_PATTERN_CANDIDATES];
           for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
+            mvs[i].row = br + candidates[s][i].row;
+            mvs[i].col = bc + candidates[s][i].col;
+          }
+          get_mv_sads(what, in_what, vfp, mvs, num_candidates[s], sads);
+          for (i = 0; i < num_candidates[s]; i++) {
+            const MV this_mv = mvs[i];
+            thissad = sads[i];
             CHECK_BETTER
           }
         } else {
@@ -1303,14 +1360,16 @@ static int vp9_pattern_search_sad(
         next_chkpts_indices[2] = (k == num_candidates[s] - 1) ? 0 : k + 1;
 
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
+          MV mvs[MAX_PATTERN_CANDIDATES];
+          uint32_t sads[MAX_PATTERN_CANDIDATES];
           for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
+            mvs[i].row = br + candidates[s][next_chkpts_indices[i]].row;
+            mvs[i].col = bc + candidates[s][next_chkpts_indices[i]].col;
+          }
+          get_mv_sads(what, in_what, vfp, mvs, PATTERN_CANDIDATES_REF, sads);
+          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
+            const MV this_mv = mvs[i];
+            thissad = sads[i];
             CHECK_BETTER
           }
         } else {
@@ -1340,12 +1399,16 @@ static int vp9_pattern_search_sad(
       cost_list[0] = bestsad;
       if (!do_init_search || s != best_init_s) {
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
+          MV mvs[MAX_PATTERN_CANDIDATES];
+          uint32_t sads[MAX_PATTERN_CANDIDATES];
           for (i = 0; i < num_candidates[s]; i++) {
-            const MV this_mv = { br + candidates[s][i].row,
-                                 bc + candidates[s][i].col };
-            cost_list[i + 1] = thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
+            mvs[i].row = br + candidates[s][i].row;
+            mvs[i].col = bc + candidates[s][i].col;
+          }
+          get_mv_sads(what, in_what, vfp, mvs, num_candidates[s], sads);
+          for (i = 0; i < num_candidates[s]; i++) {
+            const MV this_mv = mvs[i];
+            cost_list[i + 1] = thissad = sads[i];
             CHECK_BETTER
           }
         } else {
@@ -1377,14 +1440,16 @@ static int vp9_pattern_search_sad(
         cost_list[0] = bestsad;
 
         if (check_bounds(&x->mv_limits, br, bc, 1 << s)) {
+          MV mvs[MAX_PATTERN_CANDIDATES];
+          uint32_t sads[MAX_PATTERN_CANDIDATES];
           for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
-            const MV this_mv = {
-              br + candidates[s][next_chkpts_indices[i]].row,
-              bc + candidates[s][next_chkpts_indices[i]].col
-            };
-            cost_list[next_chkpts_indices[i] + 1] = thissad =
-                vfp->sdf(what->buf, what->stride,
-                         get_buf_from_mv(in_what, &this_mv), in_what->stride);
+            mvs[i].row = br + candidates[s][next_chkpts_indices[i]].row;
+            mvs[i].col = bc + candidates[s][next_chkpts_indices[i]].col;
+          }
+          get_mv_sads(what, in_what, vfp, mvs, PATTERN_CANDIDATES_REF, sads);
+          for (i = 0; i < PATTERN_CANDIDATES_REF; i++) {
+            const MV this_mv = mvs[i];
+            cost_list[next_chkpts_indices[i] + 1] = thissad = sads[i];
             CHECK_BETTER
           }
         } else {
@@ -1652,7 +1717,6 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
   unsigned int best_sad = INT_MAX;
   int r, c, i;
   int start_col, end_col, start_row, end_row;
-  int col_step = (step > 1) ? step : 4;
 
   assert(step >= 1);
 
@@ -1669,9 +1733,36 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
   end_col = VPXMIN(range, x->mv_limits.col_max - fcenter_mv.col);
 
   for (r = start_row; r <= end_row; r += step) {
-    for (c = start_col; c <= end_col; c += col_step) {
-      // Step > 1 means we are not checking every location in this pass.
-      if (step > 1) {
+    c = start_col;
+    // Step > 1 means we are not checking every location in this pass.
+    if (step > 1) {
+      // 8 sads in a single call while 8 locations of the row remain.
+      if (fn_ptr->sdx8df != NULL) {
+        while (c + 7 * step <= end_col) {
+          unsigned int sads[8];
+          const uint8_t *addrs[8];
+          for (i = 0; i < 8; ++i) {
+            const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i * step };
+            addrs[i] = get_buf_from_mv(in_what, &mv);
+          }
+          fn_ptr->sdx8df(what->buf, what->stride, addrs, in_what->stride, sads);
+
+          for (i = 0; i < 8; ++i) {
+            if (sads[i] < best_sad) {
+              const MV mv = { fcenter_mv.row + r,
+                              fcenter_mv.col + c + i * step };
+              const unsigned int sad =
+                  sads[i] + mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
+              if (sad < best_sad) {
+                best_sad = sad;
+                *best_mv = mv;
+              }
+            }
+          }
+          c += 8 * step;
+        }
+      }
+      for (; c <= end_col; c += step) {
         const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c };
         unsigned int sad =
             fn_ptr->sdf(what->buf, what->stride, get_buf_from_mv(in_what, &mv),
@@ -1683,18 +1774,20 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
             *best_mv = mv;
           }
         }
-      } else {
-        // 4 sads in a single call if we are checking every location
-        if (c + 3 <= end_col) {
-          unsigned int sads[4];
-          const uint8_t *addrs[4];
-          for (i = 0; i < 4; ++i) {
+      }
+    } else {
+      // 8 or 4 sads in a single call if we are checking every location
+      if (fn_ptr->sdx8df != NULL) {
+        while (c + 7 <= end_col) {
+          unsigned int sads[8];
+          const uint8_t *addrs[8];
+          for (i = 0; i < 8; ++i) {
             const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
             addrs[i] = get_buf_from_mv(in_what, &mv);
           }
-          fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
+          fn_ptr->sdx8df(what->buf, what->stride, addrs, in_what->stride, sads);
 
-          for (i = 0; i < 4; ++i) {
+          for (i = 0; i < 8; ++i) {
             if (sads[i] < best_sad) {
               const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
               const unsigned int sad =
@@ -1705,21 +1798,43 @@ static int exhaustive_mesh_search(const MACROBLOCK *x, MV *ref_mv, MV *best_mv,
               }
             }
           }
-        } else {
-          for (i = 0; i < end_col - c; ++i) {
+          c += 8;
+        }
+      }
+      while (c + 3 <= end_col) {
+        unsigned int sads[4];
+        const uint8_t *addrs[4];
+        for (i = 0; i < 4; ++i) {
+          const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
+          addrs[i] = get_buf_from_mv(in_what, &mv);
+        }
+        fn_ptr->sdx4df(what->buf, what->stride, addrs, in_what->stride, sads);
+
+        for (i = 0; i < 4; ++i) {
+          if (sads[i] < best_sad) {
             const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
-            unsigned int sad =
-                fn_ptr->sdf(what->buf, what->stride,
-                            get_buf_from_mv(in_what, &mv), in_what->stride);
+            const unsigned int sad =
+                sads[i] + mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
             if (sad < best_sad) {
-              sad += mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
-              if (sad < best_sad) {
-                best_sad = sad;
-                *best_mv = mv;
-              }
+              best_sad = sad;
+              *best_mv = mv;
             }
           }
         }
+        c += 4;
+      }
+      for (i = 0; i < end_col - c; ++i) {
+        const MV mv = { fcenter_mv.row + r, fcenter_mv.col + c + i };
+        unsigned int sad =
+            fn_ptr->sdf(what->buf, what->stride, get_buf_from_mv(in_what, &mv),
+                        in_what->stride);
+        if (sad < best_sad) {
+          sad += mvsad_err_cost(x, &mv, ref_mv, sad_per_bit);
+          if (sad < best_sad) {
+            best_sad = sad;
+            *best_mv = mv;
+          }
+        }
       }
     }
   }
@@ -1993,17 +2108,26 @@ static int64_t diamond_search_sad_new(const MACROBLOCK *x,
     // search point is valid in this loop,  otherwise we check each point
     // for validity..
     if (all_in) {
-      unsigned int sad_array[4];
+      unsigned int sad_array[8];
+      // See vp9_diamond_search_sad_c().
+      const int batch =
+          (fn_ptr->sdx8df != NULL && !(cfg->searches_per_step & 7)) ? 8 : 4;
 
-      for (j = 0; j < cfg->searches_per_step; j += 4) {
-        unsigned char const *block_offset[4];
+      for (j = 0; j < cfg->searches_per_step; j += batch) {
+        unsigned char const *block_offset[8];
 
-        for (t = 0; t < 4; t++) block_offset[t] = ss_os[i + t] + best_address;
+        for (t = 0; t < batch; t++)
+          block_offset[t] = ss_os[i + t] + best_address;
 
-        fn_ptr->sdx4df(what, what_stride, block_offset, in_what_stride,
-                       sad_array);
+        if (batch == 8) {
+          fn_ptr->sdx8df(what, what_stride, block_offset, in_what_stride,
+                         sad_array);
+        } else {
+          fn_ptr->sdx4df(what, what_stride, block_offset, in_what_stride,
+                         sad_array);
+        }
 
-        for (t = 0; t < 4; t++, i++) {
+        for (t = 0; t < batch; t++, i++) {
           const int64_t mv_dist = (int64_t)sad_array[t] << LOG2_PRECISION;
           if (mv_dist < bestsad) {
             const MV this_mv = { best_full_mv->row + ss_mv[i].row,
@@ -2146,17 +2270,27 @@ int vp9_diamond_search_sad_c(const MACROBLOCK *x, const search_site_config *cfg,
     // search point is valid in this loop,  otherwise we check each point
     // for validity..
     if (all_in) {
-      unsigned int sad_array[4];
+      unsigned int sad_array[8];
+      // Submit the sites of a step 8 at a time when the step has a multiple of
+      // 8 sites (the 3-step pattern) and the block size has an x8d function.
+      const int batch =
+          (fn_ptr->sdx8df != NULL && !(cfg->searches_per_step & 7)) ? 8 : 4;
 
-      for (j = 0; j < cfg->searches_per_step; j += 4) {
-        unsigned char const *block_offset[4];
+      for (j = 0; j < cfg->searches_per_step; j += batch) {
+        unsigned char const *block_offset[8];
 
-        for (t = 0; t < 4; t++) block_offset[t] = ss_os[i + t] + best_address;
+        for (t = 0; t < batch; t++)
+          block_offset[t] = ss_os[i + t] + best_address;
 
-        fn_ptr->sdx4df(what, what_stride, block_offset, in_what_stride,
-                       sad_array);
+        if (batch == 8) {
+          fn_ptr->sdx8df(what, what_stride, block_offset, in_what_stride,
+                         sad_array);
+        } else {
+          fn_ptr->sdx4df(what, what_stride, block_offset, in_what_stride,
+                         sad_array);
+        }
 
-        for (t = 0; t < 4; t++, i++) {
+        for (t = 0; t < batch; t++, i++) {
           if (sad_array[t] < bestsad) {
             const MV this_mv = { best_mv->row + ss_mv[i].row,
                                  best_mv->col + ss_mv[i].col };
@@ -84,8 +84,11 @@ void vp9_row_mt_mem_alloc(VP9_COMP *cpi) {
   multi_thread_ctxt->allocated_tile_rows = tile_rows;
   multi_thread_ctxt->allocated_vert_unit_rows = jobs_per_tile_col;
 
-  multi_thread_ctxt->job_queue =
-      (JobQueue *)vpx_memalign(32, total_jobs * sizeof(JobQueue));
+  // The job queue is held by a region of the sequence arena, so a queue that
+  // is no larger than before does not touch the heap.
+  multi_thread_ctxt->job_queue = (JobQueue *)vp9_arena_region_alloc(
+      &cpi->seq_arena, &multi_thread_ctxt->job_queue_region,
+      total_jobs * sizeof(JobQueue), 32);
 
 #if CONFIG_MULTITHREAD
   // Create mutex for each tile
@@ -133,8 +136,8 @@ void vp9_row_mt_mem_dealloc(VP9_COMP *cpi) {
   int tile_row;
 #endif
 
-  // Deallocate memory for job queue
-  if (multi_thread_ctxt->job_queue) vpx_free(multi_thread_ctxt->job_queue);
+  // The job queue is owned by its region of the sequence arena.
+  multi_thread_ctxt->job_queue = NULL;
 
 #if CONFIG_MULTITHREAD
   // Destroy mutex for each tile
@@ -73,24 +73,6 @@ static int enable_noise_estimation(VP9_COMP *const cpi) {
     return 0;
 }
 
-#if CONFIG_VP9_TEMPORAL_DENOISING
-static void copy_frame(YV12_BUFFER_CONFIG *const dest,
-                       const YV12_BUFFER_CONFIG *const src) {
-  int r;
-  const uint8_t *srcbuf = src->y_buffer;
-  uint8_t *destbuf = dest->y_buffer;
-
-  assert(dest->y_width == src->y_width);
-  assert(dest->y_height == src->y_height);
-
-  for (r = 0; r < dest->y_height; ++r) {
-    memcpy(destbuf, srcbuf, dest->y_width);
-    destbuf += dest->y_stride;
-    srcbuf += src->y_stride;
-  }
-}
-#endif  // CONFIG_VP9_TEMPORAL_DENOISING
-
 NOISE_LEVEL vp9_noise_estimate_extract_level(NOISE_ESTIMATE *const ne) {
   int noise_level = kLowLow;
   if (ne->value > (ne->thresh << 1)) {
@@ -116,9 +98,15 @@ void vp9_update_noise_estimate(VP9_COMP *const cpi) {
   int frame_counter = cm->current_video_frame;
   // Estimate is between current source and last source.
   YV12_BUFFER_CONFIG *last_source = cpi->Last_Source;
+#if CONFIG_VP9_TEMPORAL_DENOISING
+  int denoiser_last_source = 0;
+#endif
+  if (cpi->svc.number_spatial_layers > 1)
+    frame_counter = cpi->svc.current_superframe;
 #if CONFIG_VP9_TEMPORAL_DENOISING
   if (cpi->oxcf.noise_sensitivity > 0 && noise_est_svc(cpi)) {
-    last_source = &cpi->denoiser.last_source;
+    last_source = vp9_denoiser_get_last_source(cpi, frame_counter);
+    denoiser_last_source = 1;
     // Tune these thresholds for different resolutions when denoising is
     // enabled.
     if (cm->width > 640 && cm->width <= 1920) {
@@ -127,15 +115,12 @@ void vp9_update_noise_estimate(VP9_COMP *const cpi) {
   }
 #endif
   ne->enabled = enable_noise_estimation(cpi);
-  if (cpi->svc.number_spatial_layers > 1)
-    frame_counter = cpi->svc.current_superframe;
   if (!ne->enabled || frame_counter % frame_period != 0 ||
       last_source == NULL ||
       (cpi->svc.number_spatial_layers == 1 &&
        (ne->last_w != cm->width || ne->last_h != cm->height))) {
 #if CONFIG_VP9_TEMPORAL_DENOISING
-    if (cpi->oxcf.noise_sensitivity > 0 && noise_est_svc(cpi))
-      copy_frame(&cpi->denoiser.last_source, cpi->Source);
+    if (denoiser_last_source) vp9_denoiser_set_last_source(cpi, frame_counter);
 #endif
     if (last_source != NULL) {
       ne->last_w = cm->width;
@@ -151,10 +136,11 @@ void vp9_update_noise_estimate(VP9_COMP *const cpi) {
     ne->count = 0;
     ne->num_frames_estimate = 10;
 #if CONFIG_VP9_TEMPORAL_DENOISING
-    if (cpi->oxcf.noise_sensitivity > 0 && noise_est_svc(cpi) &&
-        cpi->svc.current_superframe > 1) {
+    if (denoiser_last_source && cpi->svc.current_superframe > 1) {
       vp9_denoiser_set_noise_level(cpi, ne->level);
-      copy_frame(&cpi->denoiser.last_source, cpi->Source);
+      vp9_denoiser_set_last_source(cpi, frame_counter);
+    } else if (denoiser_last_source) {
+      vp9_denoiser_keep_last_source(cpi, frame_counter);
     }
 #endif
     return;
@@ -218,11 +204,23 @@ void vp9_update_noise_estimate(VP9_COMP *const cpi) {
             }
             if (!is_skin) {
               unsigned int sse;
+              unsigned int variance;
+              unsigned int hist_index;
+              const uint8_t *last_block = last_src_y;
+              int last_block_stride = last_src_ystride;
+#if CONFIG_VP9_TEMPORAL_DENOISING
+              DECLARE_ALIGNED(16, uint8_t, last_block_buf[16 * 16]);
+              if (denoiser_last_source) {
+                last_block = vp9_denoiser_last_source_block(
+                    &cpi->denoiser, mi_row, mi_col, last_block_buf,
+                    &last_block_stride);
+              }
+#endif
               // Compute variance between co-located blocks from current and
               // last input frames.
-              unsigned int variance = cpi->fn_ptr[bsize].vf(
-                  src_y, src_ystride, last_src_y, last_src_ystride, &sse);
-              unsigned int hist_index = variance / bin_size;
+              variance = cpi->fn_ptr[bsize].vf(src_y, src_ystride, last_block,
+                                               last_block_stride, &sse);
+              hist_index = variance / bin_size;
               if (hist_index < MAX_VAR_HIST_BINS)
                 hist[hist_index]++;
               else if (hist_index < 3 * (MAX_VAR_HIST_BINS >> 1))
@@ -296,7 +294,6 @@ void vp9_update_noise_estimate(VP9_COMP *const cpi) {
     }
   }
 #if CONFIG_VP9_TEMPORAL_DENOISING
-  if (cpi->oxcf.noise_sensitivity > 0 && noise_est_svc(cpi))
-    copy_frame(&cpi->denoiser.last_source, cpi->Source);
+  if (denoiser_last_source) vp9_denoiser_set_last_source(cpi, frame_counter);
 #endif
 }
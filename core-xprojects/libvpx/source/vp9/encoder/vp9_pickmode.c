@@ -208,9 +208,25 @@ static int combined_motion_search(VP9_COMP *cpi, MACROBLOCK *x,
     tmp_mv->as_mv.row = x->sb_mvrow_part >> 3;
     tmp_mv->as_mv.col = x->sb_mvcol_part >> 3;
   } else {
-    vp9_full_pixel_search(
+    const int var = vp9_full_pixel_search(
         cpi, x, bsize, &mvp_full, step_param, cpi->sf.mv.search_method, sadpb,
         cond_cost_list(cpi, cost_list), &center_mv, &tmp_mv->as_mv, INT_MAX, 0);
+    MV pyramid_mv;
+    if (vp9_pyramid_me_get_mv(cpi, bsize, mi_row, mi_col, ref, &pyramid_mv) &&
+        (pyramid_mv.row != tmp_mv->as_mv.row ||
+         pyramid_mv.col != tmp_mv->as_mv.col)) {
+      int pyramid_cost_list[5];
+      MV this_mv;
+      const int this_var = vp9_full_pixel_search(
+          cpi, x, bsize, &pyramid_mv, VPXMAX(step_param, PYRAMID_ME_STEP_PARAM),
+          cpi->sf.mv.search_method, sadpb,
+          cond_cost_list(cpi, pyramid_cost_list), &center_mv, &this_mv,
+          INT_MAX, 0);
+      if (this_var < var) {
+        tmp_mv->as_mv = this_mv;
+        memcpy(cost_list, pyramid_cost_list, sizeof(cost_list));
+      }
+    }
   }
 
   x->mv_limits = tmp_mv_limits;
@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_ethread.h"
+#include "vp9/encoder/vp9_pyramid_me.h"
+#include "vp9/encoder/vp9_resize.h"
+
+void vp9_pyramid_me_free(PyramidME *pme) {
+  int i;
+  for (i = 0; i < PYRAMID_ME_LEVELS; ++i) {
+    vpx_free(pme->level[i].src);
+    vpx_free(pme->level[i].ref);
+  }
+  vpx_free(pme->mvs);
+  memset(pme, 0, sizeof(*pme));
+}
+
+static void pyramid_me_alloc(VP9_COMP *cpi, int width, int height) {
+  VP9_COMMON *const cm = &cpi->common;
+  PyramidME *const pme = &cpi->pyramid_me;
+  int i;
+
+  vp9_pyramid_me_free(pme);
+  pme->frame_width = width;
+  pme->frame_height = height;
+  pme->mv_cols = (width + (1 << PYRAMID_ME_BLOCK_LOG2) - 1) >>
+                 PYRAMID_ME_BLOCK_LOG2;
+  pme->mv_rows = (height + (1 << PYRAMID_ME_BLOCK_LOG2) - 1) >>
+                 PYRAMID_ME_BLOCK_LOG2;
+  CHECK_MEM_ERROR(cm, pme->mvs,
+                  vpx_calloc(pme->mv_rows * pme->mv_cols, sizeof(*pme->mvs)));
+
+  for (i = 0; i < PYRAMID_ME_LEVELS; ++i) {
+    PyramidMELevel *const lvl = &pme->level[i];
+    const int bs_log2 = PYRAMID_ME_BLOCK_LOG2 - 1 - i;
+    const int size = (pme->mv_cols << bs_log2) * (pme->mv_rows << bs_log2);
+    lvl->width = (i ? pme->level[i - 1].width + 1 : width + 1) >> 1;
+    lvl->height = (i ? pme->level[i - 1].height + 1 : height + 1) >> 1;
+    // The planes cover whole blocks of the motion field; the area past the
+    // downsampled frame is filled by edge replication.
+    lvl->stride = pme->mv_cols << bs_log2;
+    lvl->padded_height = pme->mv_rows << bs_log2;
+    CHECK_MEM_ERROR(cm, lvl->src, vpx_malloc(size));
+    CHECK_MEM_ERROR(cm, lvl->ref, vpx_malloc(size));
+  }
+}
+
+static void extend_plane(uint8_t *buf, int width, int height, int stride,
+                         int padded_height) {
+  int r;
+  for (r = 0; r < padded_height; ++r) {
+    uint8_t *const row = buf + r * stride;
+    if (r >= height) memcpy(row, buf + (height - 1) * stride, width);
+    memset(row + width, row[width - 1], stride - width);
+  }
+}
+
+static void build_level(PyramidME *pme, int i, const uint8_t *src,
+                        int src_stride, const uint8_t *ref, int ref_stride) {
+  PyramidMELevel *const lvl = &pme->level[i];
+  const int in_w = i ? pme->level[i - 1].width : pme->frame_width;
+  const int in_h = i ? pme->level[i - 1].height : pme->frame_height;
+
+  vp9_resize_plane(src, in_h, in_w, src_stride, lvl->src, lvl->height,
+                   lvl->width, lvl->stride);
+  vp9_resize_plane(ref, in_h, in_w, ref_stride, lvl->ref, lvl->height,
+                   lvl->width, lvl->stride);
+  extend_plane(lvl->src, lvl->width, lvl->height, lvl->stride,
+               lvl->padded_height);
+  extend_plane(lvl->ref, lvl->width, lvl->height, lvl->stride,
+               lvl->padded_height);
+}
+
+// Full search of the block at (|row|, |col|) of |lvl| over displacements
+// within |range| of |center|. Ties go to the shortest vector so that flat
+// areas do not pick up random motion.
+static MV search_level(const PyramidMELevel *lvl, int bs, int row, int col,
+                       MV center, int range) {
+  const uint8_t *const src = lvl->src + row * lvl->stride + col;
+  const int max_row = lvl->padded_height - bs;
+  const int max_col = lvl->stride - bs;
+  const int r0 = VPXMAX(row + center.row - range, 0);
+  const int c0 = VPXMAX(col + center.col - range, 0);
+  const int r1 = VPXMIN(row + center.row + range, max_row);
+  const int c1 = VPXMIN(col + center.col + range, max_col);
+  unsigned int best_cost = UINT_MAX;
+  MV best = { 0, 0 };
+  int r, c;
+
+  for (r = r0; r <= r1; ++r) {
+    const uint8_t *ref = lvl->ref + r * lvl->stride;
+    for (c = c0; c <= c1; ++c) {
+      const unsigned int sad =
+          bs == 8 ? vpx_sad8x8(src, lvl->stride, ref + c, lvl->stride)
+                  : vpx_sad16x16(src, lvl->stride, ref + c, lvl->stride);
+      const unsigned int cost = sad + abs(r - row) + abs(c - col);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best.row = r - row;
+        best.col = c - col;
+      }
+    }
+  }
+  return best;
+}
+
+void vp9_pyramid_me_search_rows(VP9_COMP *cpi, int start, int step) {
+  PyramidME *const pme = &cpi->pyramid_me;
+  const PyramidMELevel *const coarse = &pme->level[PYRAMID_ME_LEVELS - 1];
+  const PyramidMELevel *const fine = &pme->level[0];
+  const int coarse_bs = 1 << (PYRAMID_ME_BLOCK_LOG2 - PYRAMID_ME_LEVELS);
+  const int fine_bs = 1 << (PYRAMID_ME_BLOCK_LOG2 - 1);
+  const MV zero_mv = { 0, 0 };
+  int r, c;
+
+  for (r = start; r < pme->mv_rows; r += step) {
+    for (c = 0; c < pme->mv_cols; ++c) {
+      MV mv = search_level(coarse, coarse_bs, r * coarse_bs, c * coarse_bs,
+                           zero_mv, PYRAMID_ME_COARSE_RANGE);
+      mv.row *= 2;
+      mv.col *= 2;
+      mv = search_level(fine, fine_bs, r * fine_bs, c * fine_bs, mv, 2);
+      pme->mvs[r * pme->mv_cols + c].row = mv.row * 2;
+      pme->mvs[r * pme->mv_cols + c].col = mv.col * 2;
+    }
+  }
+}
+
+void vp9_pyramid_me(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  PyramidME *const pme = &cpi->pyramid_me;
+  const YV12_BUFFER_CONFIG *const src = cpi->Source;
+  const YV12_BUFFER_CONFIG *ref;
+
+  // Alt-ref frames are sources from the future, too far from LAST_FRAME for
+  // the search range of the pyramid.
+  if (!cpi->oxcf.pyramid_me || frame_is_intra_only(cm) ||
+      cpi->refresh_alt_ref_frame || !(cpi->ref_frame_flags & VP9_LAST_FLAG)) {
+    pme->valid = 0;
+    return;
+  }
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (cm->use_highbitdepth) {
+    pme->valid = 0;
+    return;
+  }
+#endif
+  ref = get_ref_frame_buffer(cpi, LAST_FRAME);
+  // Scaled references go through a different search setup; skip them.
+  if (ref == NULL || ref->y_crop_width != cm->width ||
+      ref->y_crop_height != cm->height) {
+    pme->valid = 0;
+    return;
+  }
+
+  // The field only depends on the source and LAST_FRAME, which stay the same
+  // across the recode iterations of a frame.
+  if (pme->valid && pme->frame_index == cm->current_video_frame &&
+      pme->src_buffer == src->y_buffer && pme->ref_buffer == ref->y_buffer &&
+      pme->frame_width == cm->width && pme->frame_height == cm->height)
+    return;
+
+  pme->valid = 0;
+  if (pme->frame_width != cm->width || pme->frame_height != cm->height)
+    pyramid_me_alloc(cpi, cm->width, cm->height);
+
+  build_level(pme, 0, src->y_buffer, src->y_stride, ref->y_buffer,
+              ref->y_stride);
+  build_level(pme, 1, pme->level[0].src, pme->level[0].stride,
+              pme->level[0].ref, pme->level[0].stride);
+
+  if (cpi->num_workers > 1)
+    vp9_pyramid_me_mt(cpi);
+  else
+    vp9_pyramid_me_search_rows(cpi, 0, 1);
+  pme->frame_index = cm->current_video_frame;
+  pme->src_buffer = src->y_buffer;
+  pme->ref_buffer = ref->y_buffer;
+  pme->valid = 1;
+}
+
+int vp9_pyramid_me_get_mv(const VP9_COMP *cpi, BLOCK_SIZE bsize, int mi_row,
+                          int mi_col, MV_REFERENCE_FRAME ref, MV *mv) {
+  const PyramidME *const pme = &cpi->pyramid_me;
+  int r, c;
+
+  if (!pme->valid || ref != LAST_FRAME) return 0;
+
+  // Use the vector of the field block covering the center of the block.
+  r = (mi_row * MI_SIZE + num_4x4_blocks_high_lookup[bsize] * 2) >>
+      PYRAMID_ME_BLOCK_LOG2;
+  c = (mi_col * MI_SIZE + num_4x4_blocks_wide_lookup[bsize] * 2) >>
+      PYRAMID_ME_BLOCK_LOG2;
+  *mv = pme->mvs[VPXMIN(r, pme->mv_rows - 1) * pme->mv_cols +
+                 VPXMIN(c, pme->mv_cols - 1)];
+  return 1;
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VP9_ENCODER_VP9_PYRAMID_ME_H_
+#define VPX_VP9_ENCODER_VP9_PYRAMID_ME_H_
+
+#include "vp9/common/vp9_blockd.h"
+#include "vpx/vpx_integer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame level hierarchical motion estimation. The source and LAST_FRAME are
+// downsampled by 2 and 4, an exhaustive search at 1/4 resolution is refined
+// at 1/2 resolution, and the resulting full-pel motion field (one vector per
+// 32x32 block) seeds an extra per-block full-pel search against LAST_FRAME.
+
+#define PYRAMID_ME_LEVELS 2
+// log2 of the size of the blocks of the motion field, in pixels.
+#define PYRAMID_ME_BLOCK_LOG2 5
+// Search range of the coarsest level, in pixels of that level.
+#define PYRAMID_ME_COARSE_RANGE 16
+// step_param of the full-pel search started from a pyramid vector: the
+// vector is accurate to a couple of pixels, so start with 4 pixel steps.
+#define PYRAMID_ME_STEP_PARAM 8
+
+typedef struct PyramidMELevel {
+  uint8_t *src;
+  uint8_t *ref;
+  int width;
+  int height;
+  int stride;
+  // Rows allocated; a multiple of the block size of the level.
+  int padded_height;
+} PyramidMELevel;
+
+typedef struct PyramidME {
+  // Level 0 is 1/2 resolution, level 1 is 1/4 resolution.
+  PyramidMELevel level[PYRAMID_ME_LEVELS];
+  MV *mvs;
+  int mv_rows;
+  int mv_cols;
+  int frame_width;
+  int frame_height;
+  // Set when |mvs| holds the motion field of the current frame.
+  int valid;
+  // The frame the field was built for, so that recode iterations of the
+  // same frame reuse it.
+  unsigned int frame_index;
+  const uint8_t *src_buffer;
+  const uint8_t *ref_buffer;
+} PyramidME;
+
+struct VP9_COMP;
+
+void vp9_pyramid_me_free(PyramidME *pme);
+
+// Builds the motion field of the current frame against LAST_FRAME, unless
+// it was already built for this frame. Clears |valid| if the stage is
+// disabled or cannot be used for this frame.
+void vp9_pyramid_me(struct VP9_COMP *cpi);
+
+// Searches rows |start|, |start| + |step|, ... of the motion field.
+void vp9_pyramid_me_search_rows(struct VP9_COMP *cpi, int start, int step);
+
+// Gets the pyramid vector, in full pels, of the block at (|mi_row|, |mi_col|).
+// Returns 0 if there is none for this block and reference.
+int vp9_pyramid_me_get_mv(const struct VP9_COMP *cpi, BLOCK_SIZE bsize,
+                          int mi_row, int mi_col, MV_REFERENCE_FRAME ref,
+                          MV *mv);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VP9_ENCODER_VP9_PYRAMID_ME_H_
@@ -385,6 +385,7 @@ void vp9_rc_init(const VP9EncoderConfig *oxcf, int pass, RATE_CONTROL *rc) {
   rc->total_target_vs_actual = 0;
   rc->avg_frame_low_motion = 0;
   rc->count_last_scene_change = 0;
+  rc->scene_cut_avg_sad = 0;
   rc->af_ratio_onepass_vbr = 10;
   rc->prev_avg_source_sad_lag = 0;
   rc->high_source_sad = 0;
@@ -2435,12 +2436,73 @@ void vp9_rc_get_svc_params(VP9_COMP *cpi) {
   }
 }
 
+// Checks whether the current source starts a new scene, before the frame
+// type is chosen. This runs ahead of vp9_scene_detection_onepass() and is kept
+// cheap: the SAD against the previous source is taken on every other row of
+// a checker-board of superblocks. A scene cut is a jump well above the recent
+// average that covers most of the sampled superblocks, so that fast motion in
+// part of the picture does not trigger it.
+static int detect_scene_cut_one_pass_cbr(VP9_COMP *cpi) {
+  RATE_CONTROL *const rc = &cpi->rc;
+  const YV12_BUFFER_CONFIG *const src = cpi->un_scaled_source;
+  const YV12_BUFFER_CONFIG *const last_src = cpi->unscaled_last_source;
+  const int min_kf_dist = VPXMAX(4, (int)(cpi->framerate / 2));
+  // Per 64x64 block: a change of about 4 per pixel marks the block as
+  // changed, and the average must exceed the key frame threshold of
+  // vp9_scene_detection_onepass().
+  const uint64_t changed_thresh = 64 * 64 * 4;
+  const uint64_t min_thresh = 140000;
+  uint64_t avg_sad = 0;
+  int num_samples = 0;
+  int num_changed = 0;
+  int sb_rows, sb_cols, sb_row, sb_col;
+  int scene_cut;
+
+  if (src == NULL || last_src == NULL ||
+      src->y_crop_width != last_src->y_crop_width ||
+      src->y_crop_height != last_src->y_crop_height)
+    return 0;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (cpi->common.use_highbitdepth) return 0;
+#endif
+
+  sb_rows = src->y_crop_height >> 6;
+  sb_cols = src->y_crop_width >> 6;
+  for (sb_row = 0; sb_row < sb_rows; ++sb_row) {
+    for (sb_col = sb_row & 1; sb_col < sb_cols; sb_col += 2) {
+      const uint8_t *const src_y =
+          src->y_buffer + (sb_row << 6) * src->y_stride + (sb_col << 6);
+      const uint8_t *const last_src_y = last_src->y_buffer +
+                                        (sb_row << 6) * last_src->y_stride +
+                                        (sb_col << 6);
+      // The even rows of the 64x64 block, scaled to the full block.
+      const uint64_t sad =
+          (uint64_t)cpi->fn_ptr[BLOCK_64X32].sdf(src_y, src->y_stride << 1,
+                                                 last_src_y,
+                                                 last_src->y_stride << 1)
+          << 1;
+      avg_sad += sad;
+      if (sad > changed_thresh) ++num_changed;
+      ++num_samples;
+    }
+  }
+  if (num_samples == 0) return 0;
+  avg_sad /= num_samples;
+
+  scene_cut = rc->frames_since_key >= min_kf_dist &&
+              avg_sad > VPXMAX(min_thresh, rc->scene_cut_avg_sad * 4) &&
+              num_changed > (num_samples >> 1);
+  rc->scene_cut_avg_sad = (3 * rc->scene_cut_avg_sad + avg_sad) >> 2;
+  return scene_cut;
+}
+
 void vp9_rc_get_one_pass_cbr_params(VP9_COMP *cpi) {
   VP9_COMMON *const cm = &cpi->common;
   RATE_CONTROL *const rc = &cpi->rc;
   int target;
   if ((cm->current_video_frame == 0) || (cpi->frame_flags & FRAMEFLAGS_KEY) ||
-      (cpi->oxcf.auto_key && rc->frames_to_key == 0)) {
+      (cpi->oxcf.auto_key && rc->frames_to_key == 0) ||
+      (cpi->oxcf.scene_cut_key_frame && detect_scene_cut_one_pass_cbr(cpi))) {
     cm->frame_type = KEY_FRAME;
     rc->frames_to_key = cpi->oxcf.key_freq;
     rc->kf_boost = DEFAULT_KF_BOOST;
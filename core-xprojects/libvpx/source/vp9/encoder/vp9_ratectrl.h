@@ -183,6 +183,9 @@ typedef struct {
   int last_frame_is_src_altref;
   int high_source_sad;
   int count_last_scene_change;
+  // Recent average of the subsampled source SAD used for scene cut key
+  // frames in one pass CBR.
+  uint64_t scene_cut_avg_sad;
   int hybrid_intra_scene_change;
   int re_encode_maxq_scene_change;
   int avg_frame_low_motion;
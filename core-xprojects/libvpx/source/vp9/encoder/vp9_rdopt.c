@@ -2632,6 +2632,26 @@ static void single_motion_search(VP9_COMP *cpi, MACROBLOCK *x, BLOCK_SIZE bsize,
     }
   }
 
+#if !CONFIG_NON_GREEDY_MV
+  // Search again around the vector of the frame level pyramid search, which
+  // catches motion the predictors above are too far off for.
+  if (vp9_pyramid_me_get_mv(cpi, bsize, mi_row, mi_col, ref, &mvp_full) &&
+      (mvp_full.row != tmp_mv->as_mv.row ||
+       mvp_full.col != tmp_mv->as_mv.col)) {
+    int pyramid_cost_list[5];
+    MV this_mv;
+    const int this_me = vp9_full_pixel_search(
+        cpi, x, bsize, &mvp_full, VPXMAX(step_param, PYRAMID_ME_STEP_PARAM),
+        cpi->sf.mv.search_method, sadpb, cond_cost_list(cpi, pyramid_cost_list),
+        &ref_mv, &this_mv, INT_MAX, 1);
+    if (this_me < bestsme) {
+      tmp_mv->as_mv = this_mv;
+      bestsme = this_me;
+      memcpy(cost_list, pyramid_cost_list, sizeof(cost_list));
+    }
+  }
+#endif  // !CONFIG_NON_GREEDY_MV
+
   x->mv_limits = tmp_mv_limits;
 
   if (bestsme < INT_MAX) {
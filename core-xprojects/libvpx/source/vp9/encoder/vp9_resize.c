@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "./vp9_rtcd.h"
 #include "./vpx_config.h"
 #if CONFIG_VP9_HIGHBITDEPTH
 #include "vpx_dsp/vpx_dsp_common.h"
@@ -26,10 +27,16 @@
 #define FILTER_BITS 7
 
 #define INTERP_TAPS 8
+// The resize filters have 32 phases, not the 16 of vpx_filter.h.
+#undef SUBPEL_BITS
+#undef SUBPEL_MASK
 #define SUBPEL_BITS 5
 #define SUBPEL_MASK ((1 << SUBPEL_BITS) - 1)
 #define INTERP_PRECISION_BITS 32
 
+// Most workers a plane is resized with.
+#define MAX_RESIZE_WORKERS 64
+
 typedef int16_t interp_kernel[INTERP_TAPS];
 
 // Filters for interpolation (0.5-band) - note this also filters integer pels.
@@ -136,6 +143,16 @@ static const interp_kernel filteredinterp_filters1000[(1 << SUBPEL_BITS)] = {
 static const int16_t vp9_down2_symeven_half_filter[] = { 56, 12, -3, -1 };
 static const int16_t vp9_down2_symodd_half_filter[] = { 64, 35, 0, -3 };
 
+// The same filters as 8-tap kernels, whose taps start 3 pels before the
+// integer position. The odd one is placed a pel early so that it does not
+// read past its last tap.
+static const int16_t vp9_down2_symeven_filter[INTERP_TAPS] = {
+  -1, -3, 12, 56, 56, 12, -3, -1
+};
+static const int16_t vp9_down2_symodd_filter[INTERP_TAPS] = {
+  0, -3, 0, 35, 64, 35, 0, -3
+};
+
 static const interp_kernel *choose_interp_filter(int inlength, int outlength) {
   int outlength16 = outlength * 16;
   if (outlength16 >= inlength * 16)
@@ -150,6 +167,33 @@ static const interp_kernel *choose_interp_filter(int inlength, int outlength) {
     return filteredinterp_filters500;
 }
 
+void vp9_resize_horz_8tap_c(const uint8_t *src, uint8_t *dst, int w,
+                            int64_t pos, int64_t step,
+                            const int16_t *filters) {
+  int x, k;
+  for (x = 0; x < w; ++x, pos += step) {
+    const uint8_t *const s =
+        src + (pos >> INTERP_PRECISION_BITS) - INTERP_TAPS / 2 + 1;
+    const int16_t *const filter =
+        filters +
+        ((pos >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK) *
+            INTERP_TAPS;
+    int sum = 0;
+    for (k = 0; k < INTERP_TAPS; ++k) sum += filter[k] * s[k];
+    dst[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+  }
+}
+
+void vp9_resize_vert_8tap_c(const uint8_t *const *src, uint8_t *dst, int w,
+                            const int16_t *filter) {
+  int x, k;
+  for (x = 0; x < w; ++x) {
+    int sum = 0;
+    for (k = 0; k < INTERP_TAPS; ++k) sum += filter[k] * src[k][x];
+    dst[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+  }
+}
+
 static void interpolate(const uint8_t *const input, int inlength,
                         uint8_t *output, int outlength) {
   const int64_t delta =
@@ -211,16 +255,11 @@ static void interpolate(const uint8_t *const input, int inlength,
       *optr++ = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
     }
     // Middle part.
-    for (; x <= x2; ++x, y += delta) {
-      const int16_t *filter;
-      int_pel = y >> INTERP_PRECISION_BITS;
-      sub_pel = (y >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK;
-      filter = interp_filters[sub_pel];
-      sum = 0;
-      for (k = 0; k < INTERP_TAPS; ++k)
-        sum += filter[k] * input[int_pel - INTERP_TAPS / 2 + 1 + k];
-      *optr++ = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
-    }
+    vp9_resize_horz_8tap(input, optr, x2 - x1 + 1, y, delta,
+                         interp_filters[0]);
+    optr += x2 - x1 + 1;
+    y += delta * (x2 - x1 + 1);
+    x = x2 + 1;
     // End part.
     for (; x < outlength; ++x, y += delta) {
       const int16_t *filter;
@@ -271,14 +310,12 @@ static void down2_symeven(const uint8_t *const input, int length,
       *optr++ = clip_pixel(sum);
     }
     // Middle part.
-    for (; i < l2; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1));
-      for (j = 0; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[i + 1 + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
+    vp9_resize_horz_8tap(input, optr, (l2 - i) / 2,
+                         (int64_t)i << INTERP_PRECISION_BITS,
+                         (int64_t)2 << INTERP_PRECISION_BITS,
+                         vp9_down2_symeven_filter);
+    optr += (l2 - i) / 2;
+    i = l2;
     // End part.
     for (; i < length; i += 2) {
       int sum = (1 << (FILTER_BITS - 1));
@@ -327,14 +364,12 @@ static void down2_symodd(const uint8_t *const input, int length,
       *optr++ = clip_pixel(sum);
     }
     // Middle part.
-    for (; i < l2; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
-      for (j = 1; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[i + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
+    vp9_resize_horz_8tap(input, optr, (l2 - i) / 2,
+                         (int64_t)(i - 1) << INTERP_PRECISION_BITS,
+                         (int64_t)2 << INTERP_PRECISION_BITS,
+                         vp9_down2_symodd_filter);
+    optr += (l2 - i) / 2;
+    i = l2;
     // End part.
     for (; i < length; i += 2) {
       int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
@@ -402,56 +437,133 @@ static void resize_multistep(const uint8_t *const input, int length,
   }
 }
 
-static void fill_col_to_arr(uint8_t *img, int stride, int len, uint8_t *arr) {
-  int i;
-  uint8_t *iptr = img;
-  uint8_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *aptr++ = *iptr;
+// The vertical pass works on rows of |cols| pels at a time, so that each
+// output row is one call to vp9_resize_vert_8tap().
+static void interpolate_vert(const uint8_t *const input, int in_stride,
+                             int inlength, uint8_t *output, int out_stride,
+                             int outlength, int cols) {
+  const int64_t delta =
+      (((uint64_t)inlength << 32) + outlength / 2) / outlength;
+  const int64_t offset =
+      inlength > outlength
+          ? (((int64_t)(inlength - outlength) << 31) + outlength / 2) /
+                outlength
+          : -(((int64_t)(outlength - inlength) << 31) + outlength / 2) /
+                outlength;
+  const interp_kernel *interp_filters =
+      choose_interp_filter(inlength, outlength);
+  const uint8_t *rows[INTERP_TAPS];
+  int x, k;
+  int64_t y;
+
+  for (x = 0, y = offset; x < outlength; ++x, y += delta) {
+    const int int_pel = (int)(y >> INTERP_PRECISION_BITS);
+    const int sub_pel =
+        (int)((y >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK);
+    for (k = 0; k < INTERP_TAPS; ++k) {
+      const int pk = int_pel - INTERP_TAPS / 2 + 1 + k;
+      rows[k] = input + (pk < 0 ? 0 : (pk >= inlength ? inlength - 1 : pk)) *
+                            in_stride;
+    }
+    vp9_resize_vert_8tap(rows, output + x * out_stride, cols,
+                         interp_filters[sub_pel]);
   }
 }
 
-static void fill_arr_to_col(uint8_t *img, int stride, int len, uint8_t *arr) {
-  int i;
-  uint8_t *iptr = img;
-  uint8_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *iptr = *aptr++;
+static void down2_vert(const uint8_t *const input, int in_stride, int length,
+                       uint8_t *output, int out_stride, int cols) {
+  const int16_t *const filter =
+      (length & 1) ? vp9_down2_symodd_filter : vp9_down2_symeven_filter;
+  const int first = (length & 1) ? -INTERP_TAPS / 2 : -INTERP_TAPS / 2 + 1;
+  const uint8_t *rows[INTERP_TAPS];
+  int i, k;
+
+  for (i = 0; i < length; i += 2, output += out_stride) {
+    for (k = 0; k < INTERP_TAPS; ++k) {
+      const int pk = i + first + k;
+      rows[k] =
+          input + (pk < 0 ? 0 : (pk >= length ? length - 1 : pk)) * in_stride;
+    }
+    vp9_resize_vert_8tap(rows, output, cols, filter);
   }
 }
 
-void vp9_resize_plane(const uint8_t *const input, int height, int width,
-                      int in_stride, uint8_t *output, int height2, int width2,
-                      int out_stride) {
-  int i;
-  uint8_t *intbuf = (uint8_t *)calloc(width2 * height, sizeof(*intbuf));
-  uint8_t *tmpbuf =
-      (uint8_t *)calloc(width < height ? height : width, sizeof(*tmpbuf));
-  uint8_t *arrbuf = (uint8_t *)calloc(height, sizeof(*arrbuf));
-  uint8_t *arrbuf2 = (uint8_t *)calloc(height2, sizeof(*arrbuf2));
-  if (intbuf == NULL || tmpbuf == NULL || arrbuf == NULL || arrbuf2 == NULL)
-    goto Error;
-  assert(width > 0);
-  assert(height > 0);
-  assert(width2 > 0);
-  assert(height2 > 0);
-  for (i = 0; i < height; ++i)
-    resize_multistep(input + in_stride * i, width, intbuf + width2 * i, width2,
-                     tmpbuf);
-  for (i = 0; i < width2; ++i) {
-    fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-    resize_multistep(arrbuf, height, arrbuf2, height2, tmpbuf);
-    fill_arr_to_col(output + i, out_stride, height2, arrbuf2);
+// Same as resize_multistep(), down the columns. |otmp| holds |length| + 1
+// rows of |cols| pels.
+static void resize_multistep_vert(const uint8_t *const input, int in_stride,
+                                  int length, uint8_t *output, int out_stride,
+                                  int olength, int cols, uint8_t *otmp) {
+  int steps;
+  if (length == olength) {
+    int i;
+    for (i = 0; i < length; ++i) {
+      memcpy(output + i * out_stride, input + i * in_stride,
+             sizeof(output[0]) * cols);
+    }
+    return;
   }
+  steps = get_down2_steps(length, olength);
 
-Error:
-  free(intbuf);
-  free(tmpbuf);
-  free(arrbuf);
-  free(arrbuf2);
+  if (steps > 0) {
+    int s;
+    uint8_t *out = NULL;
+    int out_stride2 = cols;
+    uint8_t *otmp2;
+    int filteredlength = length;
+
+    assert(otmp != NULL);
+    otmp2 = otmp + get_down2_length(length, 1) * cols;
+    for (s = 0; s < steps; ++s) {
+      const int proj_filteredlength = get_down2_length(filteredlength, 1);
+      const uint8_t *const in = (s == 0 ? input : out);
+      const int in_stride2 = (s == 0 ? in_stride : out_stride2);
+      if (s == steps - 1 && proj_filteredlength == olength) {
+        out = output;
+        out_stride2 = out_stride;
+      } else {
+        out = (s & 1 ? otmp2 : otmp);
+      }
+      down2_vert(in, in_stride2, filteredlength, out, out_stride2, cols);
+      filteredlength = proj_filteredlength;
+    }
+    if (filteredlength != olength) {
+      interpolate_vert(out, out_stride2, filteredlength, output, out_stride,
+                       olength, cols);
+    }
+  } else {
+    interpolate_vert(input, in_stride, length, output, out_stride, olength,
+                     cols);
+  }
 }
 
 #if CONFIG_VP9_HIGHBITDEPTH
+void vp9_highbd_resize_horz_8tap_c(const uint16_t *src, uint16_t *dst, int w,
+                                   int64_t pos, int64_t step,
+                                   const int16_t *filters, int bd) {
+  int x, k;
+  for (x = 0; x < w; ++x, pos += step) {
+    const uint16_t *const s =
+        src + (pos >> INTERP_PRECISION_BITS) - INTERP_TAPS / 2 + 1;
+    const int16_t *const filter =
+        filters +
+        ((pos >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK) *
+            INTERP_TAPS;
+    int sum = 0;
+    for (k = 0; k < INTERP_TAPS; ++k) sum += filter[k] * s[k];
+    dst[x] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
+  }
+}
+
+void vp9_highbd_resize_vert_8tap_c(const uint16_t *const *src, uint16_t *dst,
+                                   int w, const int16_t *filter, int bd) {
+  int x, k;
+  for (x = 0; x < w; ++x) {
+    int sum = 0;
+    for (k = 0; k < INTERP_TAPS; ++k) sum += filter[k] * src[k][x];
+    dst[x] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
+  }
+}
+
 static void highbd_interpolate(const uint16_t *const input, int inlength,
                                uint16_t *output, int outlength, int bd) {
   const int64_t delta =
@@ -515,16 +627,11 @@ static void highbd_interpolate(const uint16_t *const input, int inlength,
       *optr++ = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
     }
     // Middle part.
-    for (; x <= x2; ++x, y += delta) {
-      const int16_t *filter;
-      int_pel = y >> INTERP_PRECISION_BITS;
-      sub_pel = (y >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK;
-      filter = interp_filters[sub_pel];
-      sum = 0;
-      for (k = 0; k < INTERP_TAPS; ++k)
-        sum += filter[k] * input[int_pel - INTERP_TAPS / 2 + 1 + k];
-      *optr++ = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
-    }
+    vp9_highbd_resize_horz_8tap(input, optr, x2 - x1 + 1, y, delta,
+                                interp_filters[0], bd);
+    optr += x2 - x1 + 1;
+    y += delta * (x2 - x1 + 1);
+    x = x2 + 1;
     // End part.
     for (; x < outlength; ++x, y += delta) {
       const int16_t *filter;
@@ -575,14 +682,12 @@ static void highbd_down2_symeven(const uint16_t *const input, int length,
       *optr++ = clip_pixel_highbd(sum, bd);
     }
     // Middle part.
-    for (; i < l2; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1));
-      for (j = 0; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[i + 1 + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel_highbd(sum, bd);
-    }
+    vp9_highbd_resize_horz_8tap(input, optr, (l2 - i) / 2,
+                                (int64_t)i << INTERP_PRECISION_BITS,
+                                (int64_t)2 << INTERP_PRECISION_BITS,
+                                vp9_down2_symeven_filter, bd);
+    optr += (l2 - i) / 2;
+    i = l2;
     // End part.
     for (; i < length; i += 2) {
       int sum = (1 << (FILTER_BITS - 1));
@@ -631,14 +736,12 @@ static void highbd_down2_symodd(const uint16_t *const input, int length,
       *optr++ = clip_pixel_highbd(sum, bd);
     }
     // Middle part.
-    for (; i < l2; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
-      for (j = 1; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[i + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel_highbd(sum, bd);
-    }
+    vp9_highbd_resize_horz_8tap(input, optr, (l2 - i) / 2,
+                                (int64_t)(i - 1) << INTERP_PRECISION_BITS,
+                                (int64_t)2 << INTERP_PRECISION_BITS,
+                                vp9_down2_symodd_filter, bd);
+    optr += (l2 - i) / 2;
+    i = l2;
     // End part.
     for (; i < length; i += 2) {
       int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
@@ -691,57 +794,311 @@ static void highbd_resize_multistep(const uint16_t *const input, int length,
   }
 }
 
-static void highbd_fill_col_to_arr(uint16_t *img, int stride, int len,
-                                   uint16_t *arr) {
-  int i;
-  uint16_t *iptr = img;
-  uint16_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *aptr++ = *iptr;
+static void highbd_interpolate_vert(const uint16_t *const input,
+                                    int in_stride, int inlength,
+                                    uint16_t *output, int out_stride,
+                                    int outlength, int cols, int bd) {
+  const int64_t delta =
+      (((uint64_t)inlength << 32) + outlength / 2) / outlength;
+  const int64_t offset =
+      inlength > outlength
+          ? (((int64_t)(inlength - outlength) << 31) + outlength / 2) /
+                outlength
+          : -(((int64_t)(outlength - inlength) << 31) + outlength / 2) /
+                outlength;
+  const interp_kernel *interp_filters =
+      choose_interp_filter(inlength, outlength);
+  const uint16_t *rows[INTERP_TAPS];
+  int x, k;
+  int64_t y;
+
+  for (x = 0, y = offset; x < outlength; ++x, y += delta) {
+    const int int_pel = (int)(y >> INTERP_PRECISION_BITS);
+    const int sub_pel =
+        (int)((y >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK);
+    for (k = 0; k < INTERP_TAPS; ++k) {
+      const int pk = int_pel - INTERP_TAPS / 2 + 1 + k;
+      rows[k] = input + (pk < 0 ? 0 : (pk >= inlength ? inlength - 1 : pk)) *
+                            in_stride;
+    }
+    vp9_highbd_resize_vert_8tap(rows, output + x * out_stride, cols,
+                                interp_filters[sub_pel], bd);
+  }
+}
+
+static void highbd_down2_vert(const uint16_t *const input, int in_stride,
+                              int length, uint16_t *output, int out_stride,
+                              int cols, int bd) {
+  const int16_t *const filter =
+      (length & 1) ? vp9_down2_symodd_filter : vp9_down2_symeven_filter;
+  const int first = (length & 1) ? -INTERP_TAPS / 2 : -INTERP_TAPS / 2 + 1;
+  const uint16_t *rows[INTERP_TAPS];
+  int i, k;
+
+  for (i = 0; i < length; i += 2, output += out_stride) {
+    for (k = 0; k < INTERP_TAPS; ++k) {
+      const int pk = i + first + k;
+      rows[k] =
+          input + (pk < 0 ? 0 : (pk >= length ? length - 1 : pk)) * in_stride;
+    }
+    vp9_highbd_resize_vert_8tap(rows, output, cols, filter, bd);
+  }
+}
+
+static void highbd_resize_multistep_vert(const uint16_t *const input,
+                                         int in_stride, int length,
+                                         uint16_t *output, int out_stride,
+                                         int olength, int cols,
+                                         uint16_t *otmp, int bd) {
+  int steps;
+  if (length == olength) {
+    int i;
+    for (i = 0; i < length; ++i) {
+      memcpy(output + i * out_stride, input + i * in_stride,
+             sizeof(output[0]) * cols);
+    }
+    return;
+  }
+  steps = get_down2_steps(length, olength);
+
+  if (steps > 0) {
+    int s;
+    uint16_t *out = NULL;
+    int out_stride2 = cols;
+    uint16_t *otmp2;
+    int filteredlength = length;
+
+    assert(otmp != NULL);
+    otmp2 = otmp + get_down2_length(length, 1) * cols;
+    for (s = 0; s < steps; ++s) {
+      const int proj_filteredlength = get_down2_length(filteredlength, 1);
+      const uint16_t *const in = (s == 0 ? input : out);
+      const int in_stride2 = (s == 0 ? in_stride : out_stride2);
+      if (s == steps - 1 && proj_filteredlength == olength) {
+        out = output;
+        out_stride2 = out_stride;
+      } else {
+        out = (s & 1 ? otmp2 : otmp);
+      }
+      highbd_down2_vert(in, in_stride2, filteredlength, out, out_stride2, cols,
+                        bd);
+      filteredlength = proj_filteredlength;
+    }
+    if (filteredlength != olength) {
+      highbd_interpolate_vert(out, out_stride2, filteredlength, output,
+                              out_stride, olength, cols, bd);
+    }
+  } else {
+    highbd_interpolate_vert(input, in_stride, length, output, out_stride,
+                            olength, cols, bd);
   }
 }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+// A share of the work of resizing a plane: rows [start, end) of the
+// horizontal pass, or columns [start, end) of the vertical pass.
+typedef struct {
+  const uint8_t *input;
+  int in_stride;
+  int width;
+  int height;
+  // Output of the horizontal pass, width2 x height pels.
+  uint8_t *intbuf;
+  uint8_t *output;
+  int out_stride;
+  int width2;
+  int height2;
+  int bd;  // 0 for 8-bit planes
+  int start;
+  int end;
+  int ok;
+} ResizeJob;
 
-static void highbd_fill_arr_to_col(uint16_t *img, int stride, int len,
-                                   uint16_t *arr) {
+// The hooks report failures in the job, so that the workers stay usable.
+static int resize_rows_hook(void *arg1, void *unused) {
+  ResizeJob *const job = (ResizeJob *)arg1;
   int i;
-  uint16_t *iptr = img;
-  uint16_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *iptr = *aptr++;
+  (void)unused;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (job->bd) {
+    uint16_t *const tmpbuf =
+        (uint16_t *)malloc(sizeof(*tmpbuf) * job->width);
+    uint16_t *const intbuf = (uint16_t *)job->intbuf;
+    job->ok = tmpbuf != NULL;
+    for (i = job->start; i < job->end && job->ok; ++i) {
+      highbd_resize_multistep(
+          CONVERT_TO_SHORTPTR(job->input + job->in_stride * i), job->width,
+          intbuf + job->width2 * i, job->width2, tmpbuf, job->bd);
+    }
+    free(tmpbuf);
+    return 1;
   }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  {
+    uint8_t *const tmpbuf = (uint8_t *)malloc(sizeof(*tmpbuf) * job->width);
+    job->ok = tmpbuf != NULL;
+    for (i = job->start; i < job->end && job->ok; ++i) {
+      resize_multistep(job->input + job->in_stride * i, job->width,
+                       job->intbuf + job->width2 * i, job->width2, tmpbuf);
+    }
+    free(tmpbuf);
+  }
+  return 1;
 }
 
-void vp9_highbd_resize_plane(const uint8_t *const input, int height, int width,
-                             int in_stride, uint8_t *output, int height2,
-                             int width2, int out_stride, int bd) {
+static int resize_cols_hook(void *arg1, void *unused) {
+  ResizeJob *const job = (ResizeJob *)arg1;
+  const int cols = job->end - job->start;
+  (void)unused;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (job->bd) {
+    uint16_t *const tmpbuf =
+        (uint16_t *)malloc(sizeof(*tmpbuf) * (job->height + 1) * cols);
+    job->ok = tmpbuf != NULL;
+    if (job->ok) {
+      highbd_resize_multistep_vert(
+          (uint16_t *)job->intbuf + job->start, job->width2, job->height,
+          CONVERT_TO_SHORTPTR(job->output) + job->start, job->out_stride,
+          job->height2, cols, tmpbuf, job->bd);
+    }
+    free(tmpbuf);
+    return 1;
+  }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  {
+    uint8_t *const tmpbuf =
+        (uint8_t *)malloc(sizeof(*tmpbuf) * (job->height + 1) * cols);
+    job->ok = tmpbuf != NULL;
+    if (job->ok) {
+      resize_multistep_vert(job->intbuf + job->start, job->width2,
+                            job->height, job->output + job->start,
+                            job->out_stride, job->height2, cols, tmpbuf);
+    }
+    free(tmpbuf);
+  }
+  return 1;
+}
+
+// Runs |hook| on the first |num_jobs| jobs, one per worker, with the last
+// one on the calling thread. Returns 0 if a job failed.
+static int run_resize_jobs(VPxWorkerHook hook, ResizeJob *jobs, int num_jobs,
+                           VPxWorker *workers) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  int i, ok = 1;
+
+  if (num_jobs == 1) {
+    hook(&jobs[0], NULL);
+    return jobs[0].ok;
+  }
+  for (i = 0; i < num_jobs; ++i) {
+    VPxWorker *const worker = &workers[i];
+    worker->hook = hook;
+    worker->data1 = &jobs[i];
+    worker->data2 = NULL;
+    if (i == num_jobs - 1) {
+      winterface->execute(worker);
+    } else {
+      winterface->launch(worker);
+    }
+  }
+  for (i = 0; i < num_jobs; ++i) {
+    winterface->sync(&workers[i]);
+    ok &= jobs[i].ok;
+  }
+  return ok;
+}
+
+// Splits [0, length) into at most |num_workers| ranges of at least
+// |min_size|, with all but the last a multiple of |align|. Returns the number
+// of ranges.
+static int split_resize_jobs(ResizeJob *jobs, int num_workers, int length,
+                             int min_size, int align) {
+  const int num_jobs =
+      VPXMAX(1, VPXMIN(num_workers, length / VPXMAX(min_size, 1)));
   int i;
-  uint16_t *intbuf = (uint16_t *)malloc(sizeof(uint16_t) * width2 * height);
-  uint16_t *tmpbuf =
-      (uint16_t *)malloc(sizeof(uint16_t) * (width < height ? height : width));
-  uint16_t *arrbuf = (uint16_t *)malloc(sizeof(uint16_t) * height);
-  uint16_t *arrbuf2 = (uint16_t *)malloc(sizeof(uint16_t) * height2);
-  if (intbuf == NULL || tmpbuf == NULL || arrbuf == NULL || arrbuf2 == NULL)
-    goto Error;
+  for (i = 0; i < num_jobs; ++i) {
+    jobs[i].start = i == 0 ? 0 : jobs[i - 1].end;
+    jobs[i].end =
+        i == num_jobs - 1
+            ? length
+            : (int)((int64_t)length * (i + 1) / num_jobs / align * align);
+  }
+  return num_jobs;
+}
+
+static void resize_plane(const uint8_t *const input, int height, int width,
+                         int in_stride, uint8_t *output, int height2,
+                         int width2, int out_stride, int bd,
+                         VPxWorker *workers, int num_workers) {
+  ResizeJob jobs[MAX_RESIZE_WORKERS];
+  const size_t pel_size = bd ? sizeof(uint16_t) : sizeof(uint8_t);
+  uint8_t *const intbuf = (uint8_t *)malloc(pel_size * width2 * height);
+  int num_jobs, i;
+
   assert(width > 0);
   assert(height > 0);
   assert(width2 > 0);
   assert(height2 > 0);
-  for (i = 0; i < height; ++i) {
-    highbd_resize_multistep(CONVERT_TO_SHORTPTR(input + in_stride * i), width,
-                            intbuf + width2 * i, width2, tmpbuf, bd);
+  if (intbuf == NULL) return;
+
+  if (workers == NULL) num_workers = 1;
+  num_workers = VPXMIN(num_workers, MAX_RESIZE_WORKERS);
+  for (i = 0; i < num_workers; ++i) {
+    ResizeJob *const job = &jobs[i];
+    job->input = input;
+    job->in_stride = in_stride;
+    job->width = width;
+    job->height = height;
+    job->intbuf = intbuf;
+    job->output = output;
+    job->out_stride = out_stride;
+    job->width2 = width2;
+    job->height2 = height2;
+    job->bd = bd;
   }
-  for (i = 0; i < width2; ++i) {
-    highbd_fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-    highbd_resize_multistep(arrbuf, height, arrbuf2, height2, tmpbuf, bd);
-    highbd_fill_arr_to_col(CONVERT_TO_SHORTPTR(output + i), out_stride, height2,
-                           arrbuf2);
+
+  // Every row of the horizontal pass is needed before the vertical pass can
+  // start, but each pass divides freely among the workers.
+  num_jobs = split_resize_jobs(jobs, num_workers, height, 16, 1);
+  if (run_resize_jobs(resize_rows_hook, jobs, num_jobs, workers)) {
+    num_jobs = split_resize_jobs(jobs, num_workers, width2, 32, 16);
+    run_resize_jobs(resize_cols_hook, jobs, num_jobs, workers);
   }
 
-Error:
   free(intbuf);
-  free(tmpbuf);
-  free(arrbuf);
-  free(arrbuf2);
+}
+
+void vp9_resize_plane_mt(const uint8_t *const input, int height, int width,
+                         int in_stride, uint8_t *output, int height2,
+                         int width2, int out_stride, VPxWorker *workers,
+                         int num_workers) {
+  resize_plane(input, height, width, in_stride, output, height2, width2,
+               out_stride, 0, workers, num_workers);
+}
+
+void vp9_resize_plane(const uint8_t *const input, int height, int width,
+                      int in_stride, uint8_t *output, int height2, int width2,
+                      int out_stride) {
+  resize_plane(input, height, width, in_stride, output, height2, width2,
+               out_stride, 0, NULL, 0);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+void vp9_highbd_resize_plane_mt(const uint8_t *const input, int height,
+                                int width, int in_stride, uint8_t *output,
+                                int height2, int width2, int out_stride,
+                                int bd, VPxWorker *workers, int num_workers) {
+  resize_plane(input, height, width, in_stride, output, height2, width2,
+               out_stride, bd, workers, num_workers);
+}
+
+void vp9_highbd_resize_plane(const uint8_t *const input, int height, int width,
+                             int in_stride, uint8_t *output, int height2,
+                             int width2, int out_stride, int bd) {
+  resize_plane(input, height, width, in_stride, output, height2, width2,
+               out_stride, bd, NULL, 0);
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
@@ -13,14 +13,24 @@
 
 #include <stdio.h>
 #include "vpx/vpx_integer.h"
+#include "vpx_util/vpx_thread.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// The resizers filter through the vp9 rtcd kernels, so vp9_rtcd() must have
+// run first, as it does when a vp9 codec is created.
 void vp9_resize_plane(const uint8_t *const input, int height, int width,
                       int in_stride, uint8_t *output, int height2, int width2,
                       int out_stride);
+// Same as vp9_resize_plane(), with the rows of the horizontal pass and then
+// the columns of the vertical pass divided among up to |num_workers| idle
+// workers. The output is the same for any number of workers.
+void vp9_resize_plane_mt(const uint8_t *const input, int height, int width,
+                         int in_stride, uint8_t *output, int height2,
+                         int width2, int out_stride, VPxWorker *workers,
+                         int num_workers);
 void vp9_resize_frame420(const uint8_t *const y, int y_stride,
                          const uint8_t *const u, const uint8_t *const v,
                          int uv_stride, int height, int width, uint8_t *oy,
@@ -41,6 +51,10 @@ void vp9_resize_frame444(const uint8_t *const y, int y_stride,
 void vp9_highbd_resize_plane(const uint8_t *const input, int height, int width,
                              int in_stride, uint8_t *output, int height2,
                              int width2, int out_stride, int bd);
+void vp9_highbd_resize_plane_mt(const uint8_t *const input, int height,
+                                int width, int in_stride, uint8_t *output,
+                                int height2, int width2, int out_stride,
+                                int bd, VPxWorker *workers, int num_workers);
 void vp9_highbd_resize_frame420(const uint8_t *const y, int y_stride,
                                 const uint8_t *const u, const uint8_t *const v,
                                 int uv_stride, int height, int width,
@@ -1050,3 +1050,53 @@ void vp9_set_speed_features_framesize_independent(VP9_COMP *cpi, int speed) {
       oxcf->max_threads > 1)
     sf->adaptive_rd_thresh = 0;
 }
+
+void vp9_init_deadline_control(VP9_COMP *cpi) {
+  DEADLINE_CONTROL *const dc = &cpi->deadline;
+  const VP9EncoderConfig *const oxcf = &cpi->oxcf;
+
+  if (dc->budget_us == (int64_t)oxcf->frame_time_budget &&
+      dc->base_speed == oxcf->speed)
+    return;
+
+  dc->budget_us = oxcf->frame_time_budget;
+  dc->avg_time_us = 0;
+  dc->base_speed = oxcf->speed;
+  dc->speed = clamp(oxcf->speed, DEADLINE_MIN_SPEED, DEADLINE_MAX_SPEED);
+  dc->hold = 0;
+}
+
+int vp9_deadline_control_active(const VP9_COMP *cpi) {
+  const DEADLINE_CONTROL *const dc = &cpi->deadline;
+  return dc->budget_us > 0 && cpi->oxcf.mode == REALTIME &&
+         cpi->oxcf.pass == 0 && !cpi->use_svc &&
+         dc->base_speed >= DEADLINE_MIN_SPEED;
+}
+
+void vp9_update_deadline_control(VP9_COMP *cpi, int64_t time_us,
+                                 int is_intra_only) {
+  // Intra only frames are not affected much by the speed and would pull the
+  // average up after every key frame.
+  if (!vp9_deadline_control_active(cpi) || is_intra_only) return;
+  vp9_deadline_control_update(&cpi->deadline, time_us);
+}
+
+void vp9_deadline_control_update(DEADLINE_CONTROL *dc, int64_t time_us) {
+  dc->avg_time_us =
+      dc->avg_time_us == 0 ? time_us : (3 * dc->avg_time_us + time_us) / 4;
+
+  if (dc->hold > 0) {
+    --dc->hold;
+    return;
+  }
+
+  if (dc->avg_time_us > dc->budget_us && dc->speed < DEADLINE_MAX_SPEED) {
+    ++dc->speed;
+    dc->hold = DEADLINE_HOLD_UP;
+  } else if (3 * dc->avg_time_us < 2 * dc->budget_us &&
+             dc->speed > DEADLINE_MIN_SPEED) {
+    // Only give back speed when one step slower is still likely to fit.
+    --dc->speed;
+    dc->hold = DEADLINE_HOLD_DOWN;
+  }
+}
@@ -11,6 +11,7 @@
 #ifndef VPX_VP9_ENCODER_VP9_SPEED_FEATURES_H_
 #define VPX_VP9_ENCODER_VP9_SPEED_FEATURES_H_
 
+#include "vpx/vpx_integer.h"
 #include "vp9/common/vp9_enums.h"
 
 #ifdef __cplusplus
@@ -617,6 +618,33 @@ typedef struct SPEED_FEATURES {
   int allow_skip_txfm_ac_dc;
 } SPEED_FEATURES;
 
+// The deadline control moves between the non-rd real-time speeds only, the
+// encoder makes allocation and mode decision choices that assume the pick
+// mode does not change between rd and non-rd from frame to frame.
+#define DEADLINE_MIN_SPEED 5
+#define DEADLINE_MAX_SPEED 9
+// Frames to wait after a speed change for the average to follow. Lowering the
+// speed waits longer as it is the change that can cause a missed deadline.
+#define DEADLINE_HOLD_UP 3
+#define DEADLINE_HOLD_DOWN 8
+
+// Closed-loop speed control for one pass real-time encoding. When a per-frame
+// encode time budget is set, the speed the features are picked with is raised
+// while frames take longer than the budget and lowered again when there is
+// enough slack.
+typedef struct DEADLINE_CONTROL {
+  // Target encode time per frame in microseconds, 0 when disabled.
+  int64_t budget_us;
+  // Moving average of the encode time of inter frames.
+  int64_t avg_time_us;
+  // The speed set with VP8E_SET_CPUUSED.
+  int base_speed;
+  // The speed currently in use.
+  int speed;
+  // Number of frames to wait before the next speed change.
+  int hold;
+} DEADLINE_CONTROL;
+
 struct VP9_COMP;
 
 void vp9_set_speed_features_framesize_independent(struct VP9_COMP *cpi,
@@ -624,6 +652,18 @@ void vp9_set_speed_features_framesize_independent(struct VP9_COMP *cpi,
 void vp9_set_speed_features_framesize_dependent(struct VP9_COMP *cpi,
                                                 int speed);
 
+// Resets the deadline control when the budget or the base speed changed.
+void vp9_init_deadline_control(struct VP9_COMP *cpi);
+// Returns 1 if the speed is driven by the deadline control.
+int vp9_deadline_control_active(const struct VP9_COMP *cpi);
+// Feeds the encode time of a frame to the deadline control.
+void vp9_update_deadline_control(struct VP9_COMP *cpi, int64_t time_us,
+                                 int is_intra_only);
+// Adds the encode time of an inter frame to the average of |dc| and moves
+// its speed. Takes the time as an argument so that it can be driven without
+// a clock.
+void vp9_deadline_control_update(DEADLINE_CONTROL *dc, int64_t time_us);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -1170,7 +1170,7 @@ void vp9_temporal_filter(VP9_COMP *cpi, int distance) {
                                "Failed to reallocate alt_ref_buffer");
           }
           frames[frame] = vp9_scale_if_required(
-              cm, frames[frame], &cpi->svc.scaled_frames[frame_used], 0,
+              cpi, frames[frame], &cpi->svc.scaled_frames[frame_used], 0,
               EIGHTTAP, 0);
           ++frame_used;
         }
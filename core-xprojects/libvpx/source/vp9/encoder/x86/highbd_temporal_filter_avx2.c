@@ -0,0 +1,478 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_temporal_filter.h"
+#include "vp9/encoder/x86/temporal_filter_constants.h"
+
+// Both the luma and the chroma paths work on 8 pixel wide columns with a row
+// of 32-bit values in one register.
+
+static INLINE __m256i load_neighbors_8(const uint32_t *first,
+                                       const uint32_t *second) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_load_si128((const __m128i *)first)),
+      _mm_load_si128((const __m128i *)second), 1);
+}
+
+// Compute (a - b)**2 for 8 pixels and store them as 32-bit to dst.
+static INLINE void highbd_store_dist_8(const uint16_t *a, const uint16_t *b,
+                                       uint32_t *dst) {
+  const __m256i a_u32 =
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)a));
+  const __m256i b_u32 =
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)b));
+  const __m256i diff = _mm256_sub_epi32(a_u32, b_u32);
+
+  _mm256_storeu_si256((__m256i *)dst, _mm256_mullo_epi32(diff, diff));
+}
+
+// For each of 8 pixels i, compute dist[i - 1] + dist[i] + dist[i + 1]. The
+// maximum is 9 * 2**24 so no saturation is needed.
+static INLINE __m256i highbd_get_sum_8(const uint32_t *dist) {
+  const __m256i left = _mm256_loadu_si256((const __m256i *)(dist - 1));
+  const __m256i center = _mm256_loadu_si256((const __m256i *)dist);
+  const __m256i right = _mm256_loadu_si256((const __m256i *)(dist + 1));
+
+  return _mm256_add_epi32(_mm256_add_epi32(left, center), right);
+}
+
+// Read the chroma distortion of a row of 8 luma pixels.
+static INLINE void highbd_read_chroma_dist_row_8(int ss_x,
+                                                 const uint32_t *u_dist,
+                                                 const uint32_t *v_dist,
+                                                 __m256i *u_reg,
+                                                 __m256i *v_reg) {
+  if (!ss_x) {
+    *u_reg = _mm256_loadu_si256((const __m256i *)u_dist);
+    *v_reg = _mm256_loadu_si256((const __m256i *)v_dist);
+  } else {
+    // Each of the 4 chroma values is used by 2 luma pixels.
+    const __m256i u_u64 =
+        _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *)u_dist));
+    const __m256i v_u64 =
+        _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *)v_dist));
+    *u_reg = _mm256_or_si256(u_u64, _mm256_slli_epi64(u_u64, 32));
+    *v_reg = _mm256_or_si256(v_u64, _mm256_slli_epi64(v_u64, 32));
+  }
+}
+
+// Sum the luma distortion of the pixels covered by 8 chroma pixels and add it
+// to u_mod and v_mod.
+static INLINE void highbd_add_luma_dist_to_8_chroma_mod(const uint32_t *y_dist,
+                                                        int ss_x, int ss_y,
+                                                        __m256i *u_mod,
+                                                        __m256i *v_mod) {
+  __m256i y_reg;
+
+  if (!ss_x) {
+    y_reg = _mm256_loadu_si256((const __m256i *)y_dist);
+    if (ss_y) {
+      y_reg = _mm256_add_epi32(
+          y_reg, _mm256_loadu_si256((const __m256i *)(y_dist + DIST_STRIDE)));
+    }
+  } else {
+    __m256i y_first = _mm256_loadu_si256((const __m256i *)y_dist);
+    __m256i y_second = _mm256_loadu_si256((const __m256i *)(y_dist + 8));
+    if (ss_y) {
+      y_first = _mm256_add_epi32(
+          y_first, _mm256_loadu_si256((const __m256i *)(y_dist + DIST_STRIDE)));
+      y_second = _mm256_add_epi32(
+          y_second,
+          _mm256_loadu_si256((const __m256i *)(y_dist + DIST_STRIDE + 8)));
+    }
+    // The horizontal add interleaves the 64-bit halves of the two inputs.
+    y_reg = _mm256_permute4x64_epi64(_mm256_hadd_epi32(y_first, y_second),
+                                     0xd8);
+  }
+
+  *u_mod = _mm256_add_epi32(*u_mod, y_reg);
+  *v_mod = _mm256_add_epi32(*v_mod, y_reg);
+}
+
+// Average the value based on the number of values summed. Add in the rounding
+// factor and shift, clamp to 16, invert and multiply by weight.
+static INLINE __m256i highbd_average_8(const __m256i sum,
+                                       const __m256i *mul_constants,
+                                       const __m128i strength,
+                                       const __m256i rounding,
+                                       const __m256i *weight) {
+  const __m256i sixteen = _mm256_set1_epi32(16);
+  const __m256i high_mask = _mm256_set1_epi64x((int64_t)0xffffffff00000000ULL);
+
+  // modifier * 3 / index: the high 32 bits of the 64-bit products.
+  const __m256i mul_even = _mm256_mul_epu32(sum, *mul_constants);
+  const __m256i mul_odd = _mm256_mul_epu32(
+      _mm256_srli_epi64(sum, 32), _mm256_srli_epi64(*mul_constants, 32));
+  __m256i mod = _mm256_or_si256(_mm256_srli_epi64(mul_even, 32),
+                                _mm256_and_si256(mul_odd, high_mask));
+
+  mod = _mm256_add_epi32(mod, rounding);
+  mod = _mm256_srl_epi32(mod, strength);
+  mod = _mm256_min_epu32(mod, sixteen);
+  mod = _mm256_sub_epi32(sixteen, mod);
+
+  return _mm256_mullo_epi32(mod, *weight);
+}
+
+// Add the 8 modifiers to count. Multiply them by pred and add to accum.
+static INLINE void highbd_accumulate_and_store_8(const __m256i sum_u32,
+                                                 const uint16_t *pred,
+                                                 uint16_t *count,
+                                                 uint32_t *accum) {
+  const __m256i pred_u32 =
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)pred));
+  const __m128i sum_u16 = _mm_packus_epi32(
+      _mm256_castsi256_si128(sum_u32), _mm256_extracti128_si256(sum_u32, 1));
+
+  _mm_storeu_si128(
+      (__m128i *)count,
+      _mm_adds_epu16(_mm_loadu_si128((const __m128i *)count), sum_u16));
+  _mm256_storeu_si256(
+      (__m256i *)accum,
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)accum),
+                       _mm256_mullo_epi32(sum_u32, pred_u32)));
+}
+
+// Filter an 8 pixel wide column of luma. The top and bottom half of the
+// column use top_weight and bottom_weight.
+static void highbd_apply_temporal_filter_luma_8(
+    const uint16_t *y_pre, int y_pre_stride, unsigned int block_height,
+    int ss_x, int ss_y, int strength, const __m256i *top_weight,
+    const __m256i *bottom_weight, uint32_t *y_accum, uint16_t *y_count,
+    const uint32_t *y_dist, const uint32_t *u_dist, const uint32_t *v_dist,
+    const uint32_t *const *neighbors_first,
+    const uint32_t *const *neighbors_second) {
+  const __m128i strength_u128 = _mm_set_epi32(0, 0, 0, strength);
+  const __m256i rounding = _mm256_set1_epi32((1 << strength) >> 1);
+  const __m256i *weight = top_weight;
+  __m256i mul, sum_row_1, sum_row_2, sum_row_3, sum_row, u_reg, v_reg;
+  unsigned int h;
+
+  // First row
+  mul = load_neighbors_8(neighbors_first[0], neighbors_second[0]);
+
+  sum_row_2 = highbd_get_sum_8(y_dist);
+  sum_row_3 = highbd_get_sum_8(y_dist + DIST_STRIDE);
+  sum_row = _mm256_add_epi32(sum_row_2, sum_row_3);
+
+  highbd_read_chroma_dist_row_8(ss_x, u_dist, v_dist, &u_reg, &v_reg);
+  sum_row = _mm256_add_epi32(sum_row, u_reg);
+  sum_row = _mm256_add_epi32(sum_row, v_reg);
+
+  sum_row = highbd_average_8(sum_row, &mul, strength_u128, rounding, weight);
+  highbd_accumulate_and_store_8(sum_row, y_pre, y_count, y_accum);
+
+  y_pre += y_pre_stride;
+  y_count += y_pre_stride;
+  y_accum += y_pre_stride;
+  y_dist += DIST_STRIDE;
+  u_dist += DIST_STRIDE;
+  v_dist += DIST_STRIDE;
+
+  // Then all the rows except the last one
+  mul = load_neighbors_8(neighbors_first[1], neighbors_second[1]);
+
+  for (h = 1; h < block_height - 1; ++h) {
+    if (h == block_height / 2) weight = bottom_weight;
+
+    sum_row_1 = sum_row_2;
+    sum_row_2 = sum_row_3;
+    sum_row_3 = highbd_get_sum_8(y_dist + DIST_STRIDE);
+    sum_row = _mm256_add_epi32(sum_row_1, sum_row_2);
+    sum_row = _mm256_add_epi32(sum_row, sum_row_3);
+
+    // Only read the chroma distortion again at a new chroma row.
+    if (ss_y == 0 || h % 2 == 0) {
+      highbd_read_chroma_dist_row_8(ss_x, u_dist, v_dist, &u_reg, &v_reg);
+      u_dist += DIST_STRIDE;
+      v_dist += DIST_STRIDE;
+    }
+    sum_row = _mm256_add_epi32(sum_row, u_reg);
+    sum_row = _mm256_add_epi32(sum_row, v_reg);
+
+    sum_row = highbd_average_8(sum_row, &mul, strength_u128, rounding, weight);
+    highbd_accumulate_and_store_8(sum_row, y_pre, y_count, y_accum);
+
+    y_pre += y_pre_stride;
+    y_count += y_pre_stride;
+    y_accum += y_pre_stride;
+    y_dist += DIST_STRIDE;
+  }
+
+  // The last row
+  mul = load_neighbors_8(neighbors_first[0], neighbors_second[0]);
+
+  sum_row = _mm256_add_epi32(sum_row_2, sum_row_3);
+
+  if (ss_y == 0) {
+    highbd_read_chroma_dist_row_8(ss_x, u_dist, v_dist, &u_reg, &v_reg);
+  }
+  sum_row = _mm256_add_epi32(sum_row, u_reg);
+  sum_row = _mm256_add_epi32(sum_row, v_reg);
+
+  sum_row = highbd_average_8(sum_row, &mul, strength_u128, rounding, weight);
+  highbd_accumulate_and_store_8(sum_row, y_pre, y_count, y_accum);
+}
+
+// Filter an 8 pixel wide column of both chroma planes.
+static void highbd_apply_temporal_filter_chroma_8(
+    const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride,
+    unsigned int uv_block_height, int ss_x, int ss_y, int strength,
+    const __m256i *top_weight, const __m256i *bottom_weight,
+    uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum,
+    uint16_t *v_count, const uint32_t *y_dist, const uint32_t *u_dist,
+    const uint32_t *v_dist, const uint32_t *const *neighbors_first,
+    const uint32_t *const *neighbors_second) {
+  const __m128i strength_u128 = _mm_set_epi32(0, 0, 0, strength);
+  const __m256i rounding = _mm256_set1_epi32((1 << strength) >> 1);
+  const __m256i *weight = top_weight;
+  __m256i mul;
+  __m256i u_sum_row_1, u_sum_row_2, u_sum_row_3, u_sum_row;
+  __m256i v_sum_row_1, v_sum_row_2, v_sum_row_3, v_sum_row;
+  unsigned int h;
+
+  // First row
+  mul = load_neighbors_8(neighbors_first[0], neighbors_second[0]);
+
+  u_sum_row_2 = highbd_get_sum_8(u_dist);
+  u_sum_row_3 = highbd_get_sum_8(u_dist + DIST_STRIDE);
+  u_sum_row = _mm256_add_epi32(u_sum_row_2, u_sum_row_3);
+  v_sum_row_2 = highbd_get_sum_8(v_dist);
+  v_sum_row_3 = highbd_get_sum_8(v_dist + DIST_STRIDE);
+  v_sum_row = _mm256_add_epi32(v_sum_row_2, v_sum_row_3);
+  highbd_add_luma_dist_to_8_chroma_mod(y_dist, ss_x, ss_y, &u_sum_row,
+                                       &v_sum_row);
+
+  u_sum_row =
+      highbd_average_8(u_sum_row, &mul, strength_u128, rounding, weight);
+  v_sum_row =
+      highbd_average_8(v_sum_row, &mul, strength_u128, rounding, weight);
+  highbd_accumulate_and_store_8(u_sum_row, u_pre, u_count, u_accum);
+  highbd_accumulate_and_store_8(v_sum_row, v_pre, v_count, v_accum);
+
+  u_pre += uv_pre_stride;
+  v_pre += uv_pre_stride;
+  u_dist += DIST_STRIDE;
+  v_dist += DIST_STRIDE;
+  u_count += uv_pre_stride;
+  u_accum += uv_pre_stride;
+  v_count += uv_pre_stride;
+  v_accum += uv_pre_stride;
+  y_dist += DIST_STRIDE * (1 + ss_y);
+
+  // Then all the rows except the last one
+  mul = load_neighbors_8(neighbors_first[1], neighbors_second[1]);
+
+  for (h = 1; h < uv_block_height - 1; ++h) {
+    if (h == uv_block_height / 2) weight = bottom_weight;
+
+    u_sum_row_1 = u_sum_row_2;
+    u_sum_row_2 = u_sum_row_3;
+    u_sum_row_3 = highbd_get_sum_8(u_dist + DIST_STRIDE);
+    u_sum_row = _mm256_add_epi32(u_sum_row_1, u_sum_row_2);
+    u_sum_row = _mm256_add_epi32(u_sum_row, u_sum_row_3);
+
+    v_sum_row_1 = v_sum_row_2;
+    v_sum_row_2 = v_sum_row_3;
+    v_sum_row_3 = highbd_get_sum_8(v_dist + DIST_STRIDE);
+    v_sum_row = _mm256_add_epi32(v_sum_row_1, v_sum_row_2);
+    v_sum_row = _mm256_add_epi32(v_sum_row, v_sum_row_3);
+
+    highbd_add_luma_dist_to_8_chroma_mod(y_dist, ss_x, ss_y, &u_sum_row,
+                                         &v_sum_row);
+
+    u_sum_row =
+        highbd_average_8(u_sum_row, &mul, strength_u128, rounding, weight);
+    v_sum_row =
+        highbd_average_8(v_sum_row, &mul, strength_u128, rounding, weight);
+    highbd_accumulate_and_store_8(u_sum_row, u_pre, u_count, u_accum);
+    highbd_accumulate_and_store_8(v_sum_row, v_pre, v_count, v_accum);
+
+    u_pre += uv_pre_stride;
+    v_pre += uv_pre_stride;
+    u_dist += DIST_STRIDE;
+    v_dist += DIST_STRIDE;
+    u_count += uv_pre_stride;
+    u_accum += uv_pre_stride;
+    v_count += uv_pre_stride;
+    v_accum += uv_pre_stride;
+    y_dist += DIST_STRIDE * (1 + ss_y);
+  }
+
+  // The last row
+  mul = load_neighbors_8(neighbors_first[0], neighbors_second[0]);
+
+  u_sum_row = _mm256_add_epi32(u_sum_row_2, u_sum_row_3);
+  v_sum_row = _mm256_add_epi32(v_sum_row_2, v_sum_row_3);
+  highbd_add_luma_dist_to_8_chroma_mod(y_dist, ss_x, ss_y, &u_sum_row,
+                                       &v_sum_row);
+
+  u_sum_row =
+      highbd_average_8(u_sum_row, &mul, strength_u128, rounding, weight);
+  v_sum_row =
+      highbd_average_8(v_sum_row, &mul, strength_u128, rounding, weight);
+  highbd_accumulate_and_store_8(u_sum_row, u_pre, u_count, u_accum);
+  highbd_accumulate_and_store_8(v_sum_row, v_pre, v_count, v_accum);
+}
+
+// Returns the weights of an 8 pixel wide column starting at col of a
+// block_width wide block. Unless the column is the whole block it lies in one
+// horizontal half of the block.
+static INLINE void highbd_get_column_weights(const int *blk_fw,
+                                             int use_whole_blk,
+                                             unsigned int col,
+                                             unsigned int block_width,
+                                             __m256i *top_weight,
+                                             __m256i *bottom_weight) {
+  if (use_whole_blk) {
+    *top_weight = *bottom_weight = _mm256_set1_epi32(blk_fw[0]);
+  } else if (block_width == 8) {
+    *top_weight = _mm256_setr_epi32(blk_fw[0], blk_fw[0], blk_fw[0], blk_fw[0],
+                                    blk_fw[1], blk_fw[1], blk_fw[1], blk_fw[1]);
+    *bottom_weight =
+        _mm256_setr_epi32(blk_fw[2], blk_fw[2], blk_fw[2], blk_fw[2],
+                          blk_fw[3], blk_fw[3], blk_fw[3], blk_fw[3]);
+  } else {
+    const int right = col >= block_width / 2;
+    *top_weight = _mm256_set1_epi32(blk_fw[right]);
+    *bottom_weight = _mm256_set1_epi32(blk_fw[2 + right]);
+  }
+}
+
+void vp9_highbd_apply_temporal_filter_avx2(
+    const uint16_t *y_src, int y_src_stride, const uint16_t *y_pre,
+    int y_pre_stride, const uint16_t *u_src, const uint16_t *v_src,
+    int uv_src_stride, const uint16_t *u_pre, const uint16_t *v_pre,
+    int uv_pre_stride, unsigned int block_width, unsigned int block_height,
+    int ss_x, int ss_y, int strength, const int *const blk_fw,
+    int use_whole_blk, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count) {
+  const unsigned int chroma_height = block_height >> ss_y,
+                     chroma_width = block_width >> ss_x;
+
+  DECLARE_ALIGNED(32, uint32_t, y_dist[BH * DIST_STRIDE]) = { 0 };
+  DECLARE_ALIGNED(32, uint32_t, u_dist[BH * DIST_STRIDE]) = { 0 };
+  DECLARE_ALIGNED(32, uint32_t, v_dist[BH * DIST_STRIDE]) = { 0 };
+
+  uint32_t *y_dist_ptr = y_dist + 1, *u_dist_ptr = u_dist + 1,
+           *v_dist_ptr = v_dist + 1;
+  const uint16_t *y_src_ptr = y_src, *u_src_ptr = u_src, *v_src_ptr = v_src;
+  const uint16_t *y_pre_ptr = y_pre, *u_pre_ptr = u_pre, *v_pre_ptr = v_pre;
+  const uint32_t *const *neighbors_first;
+  const uint32_t *const *neighbors_second;
+  const uint32_t *const *left_neighbors;
+  const uint32_t *const *middle_neighbors;
+  const uint32_t *const *right_neighbors;
+  __m256i top_weight, bottom_weight;
+
+  // Loop variables
+  unsigned int row, blk_col, uv_blk_col;
+
+  assert(block_width <= BW && "block width too large");
+  assert(block_height <= BH && "block height too large");
+  assert(block_width % 16 == 0 && "block width must be multiple of 16");
+  assert(block_height % 2 == 0 && "block height must be even");
+  assert((ss_x == 0 || ss_x == 1) && (ss_y == 0 || ss_y == 1) &&
+         "invalid chroma subsampling");
+  assert(strength >= 4 && strength <= 14 &&
+         "invalid adjusted temporal filter strength");
+  assert(blk_fw[0] >= 0 && "filter weight must be positive");
+  assert(
+      (use_whole_blk || (blk_fw[1] >= 0 && blk_fw[2] >= 0 && blk_fw[3] >= 0)) &&
+      "subblock filter weight must be positive");
+  assert(blk_fw[0] <= 2 && "sublock filter weight must be less than 2");
+  assert(
+      (use_whole_blk || (blk_fw[1] <= 2 && blk_fw[2] <= 2 && blk_fw[3] <= 2)) &&
+      "subblock filter weight must be less than 2");
+
+  // Precompute the difference squared
+  for (row = 0; row < block_height; row++) {
+    for (blk_col = 0; blk_col < block_width; blk_col += 8) {
+      highbd_store_dist_8(y_src_ptr + blk_col, y_pre_ptr + blk_col,
+                          y_dist_ptr + blk_col);
+    }
+    y_src_ptr += y_src_stride;
+    y_pre_ptr += y_pre_stride;
+    y_dist_ptr += DIST_STRIDE;
+  }
+
+  for (row = 0; row < chroma_height; row++) {
+    for (blk_col = 0; blk_col < chroma_width; blk_col += 8) {
+      highbd_store_dist_8(u_src_ptr + blk_col, u_pre_ptr + blk_col,
+                          u_dist_ptr + blk_col);
+      highbd_store_dist_8(v_src_ptr + blk_col, v_pre_ptr + blk_col,
+                          v_dist_ptr + blk_col);
+    }
+    u_src_ptr += uv_src_stride;
+    u_pre_ptr += uv_pre_stride;
+    u_dist_ptr += DIST_STRIDE;
+    v_src_ptr += uv_src_stride;
+    v_pre_ptr += uv_pre_stride;
+    v_dist_ptr += DIST_STRIDE;
+  }
+
+  y_dist_ptr = y_dist + 1;
+  u_dist_ptr = u_dist + 1;
+  v_dist_ptr = v_dist + 1;
+
+  // Luma, in columns of 8
+  for (blk_col = 0; blk_col < block_width; blk_col += 8) {
+    const unsigned int uv_col = blk_col >> ss_x;
+    neighbors_first = blk_col == 0 ? HIGHBD_LUMA_LEFT_COLUMN_NEIGHBORS
+                                   : HIGHBD_LUMA_MIDDLE_COLUMN_NEIGHBORS;
+    neighbors_second = blk_col + 8 == block_width
+                           ? HIGHBD_LUMA_RIGHT_COLUMN_NEIGHBORS
+                           : HIGHBD_LUMA_MIDDLE_COLUMN_NEIGHBORS;
+    highbd_get_column_weights(blk_fw, use_whole_blk, blk_col, block_width,
+                              &top_weight, &bottom_weight);
+    highbd_apply_temporal_filter_luma_8(
+        y_pre + blk_col, y_pre_stride, block_height, ss_x, ss_y, strength,
+        &top_weight, &bottom_weight, y_accum + blk_col, y_count + blk_col,
+        y_dist_ptr + blk_col, u_dist_ptr + uv_col, v_dist_ptr + uv_col,
+        neighbors_first, neighbors_second);
+  }
+
+  // Chroma, in columns of 8
+  if (ss_x && ss_y) {
+    left_neighbors = HIGHBD_CHROMA_DOUBLE_SS_LEFT_COLUMN_NEIGHBORS;
+    middle_neighbors = HIGHBD_CHROMA_DOUBLE_SS_MIDDLE_COLUMN_NEIGHBORS;
+    right_neighbors = HIGHBD_CHROMA_DOUBLE_SS_RIGHT_COLUMN_NEIGHBORS;
+  } else if (ss_x || ss_y) {
+    left_neighbors = HIGHBD_CHROMA_SINGLE_SS_LEFT_COLUMN_NEIGHBORS;
+    middle_neighbors = HIGHBD_CHROMA_SINGLE_SS_MIDDLE_COLUMN_NEIGHBORS;
+    right_neighbors = HIGHBD_CHROMA_SINGLE_SS_RIGHT_COLUMN_NEIGHBORS;
+  } else {
+    left_neighbors = HIGHBD_CHROMA_NO_SS_LEFT_COLUMN_NEIGHBORS;
+    middle_neighbors = HIGHBD_CHROMA_NO_SS_MIDDLE_COLUMN_NEIGHBORS;
+    right_neighbors = HIGHBD_CHROMA_NO_SS_RIGHT_COLUMN_NEIGHBORS;
+  }
+
+  for (uv_blk_col = 0; uv_blk_col < chroma_width; uv_blk_col += 8) {
+    blk_col = uv_blk_col << ss_x;
+    neighbors_first = uv_blk_col == 0 ? left_neighbors : middle_neighbors;
+    neighbors_second =
+        uv_blk_col + 8 == chroma_width ? right_neighbors : middle_neighbors;
+    highbd_get_column_weights(blk_fw, use_whole_blk, uv_blk_col, chroma_width,
+                              &top_weight, &bottom_weight);
+    highbd_apply_temporal_filter_chroma_8(
+        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, chroma_height,
+        ss_x, ss_y, strength, &top_weight, &bottom_weight,
+        u_accum + uv_blk_col, u_count + uv_blk_col, v_accum + uv_blk_col,
+        v_count + uv_blk_col, y_dist_ptr + blk_col, u_dist_ptr + uv_blk_col,
+        v_dist_ptr + uv_blk_col, neighbors_first, neighbors_second);
+  }
+}
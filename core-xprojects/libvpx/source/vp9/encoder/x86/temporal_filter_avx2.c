@@ -0,0 +1,515 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vp9/encoder/vp9_encoder.h"
+#include "vp9/encoder/vp9_temporal_filter.h"
+#include "vp9/encoder/x86/temporal_filter_constants.h"
+
+// The luma path works on 16 pixel wide columns with a row in one register.
+// The chroma path works on 8 pixel wide columns with the u row in the low and
+// the v row in the high 128 bits of a register.
+
+static INLINE __m256i mm256_set_m128i(const __m128i hi, const __m128i lo) {
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+static INLINE __m256i load_u16_8x2(const uint16_t *lo, const uint16_t *hi) {
+  return mm256_set_m128i(_mm_loadu_si128((const __m128i *)hi),
+                         _mm_loadu_si128((const __m128i *)lo));
+}
+
+// Compute (a - b)**2 for 16 pixels and store them as 16-bit to dst.
+static INLINE void store_dist_16(const uint8_t *a, const uint8_t *b,
+                                 uint16_t *dst) {
+  const __m256i a_u16 =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)a));
+  const __m256i b_u16 =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)b));
+  const __m256i diff = _mm256_sub_epi16(a_u16, b_u16);
+
+  _mm256_storeu_si256((__m256i *)dst, _mm256_mullo_epi16(diff, diff));
+}
+
+// Compute (a - b)**2 for 8 u and 8 v pixels.
+static INLINE void store_dist_8x2(const uint8_t *u_a, const uint8_t *u_b,
+                                  const uint8_t *v_a, const uint8_t *v_b,
+                                  uint16_t *u_dst, uint16_t *v_dst) {
+  const __m256i a_u16 = _mm256_cvtepu8_epi16(
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)u_a),
+                         _mm_loadl_epi64((const __m128i *)v_a)));
+  const __m256i b_u16 = _mm256_cvtepu8_epi16(
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)u_b),
+                         _mm_loadl_epi64((const __m128i *)v_b)));
+  const __m256i diff = _mm256_sub_epi16(a_u16, b_u16);
+  const __m256i dist = _mm256_mullo_epi16(diff, diff);
+
+  _mm_storeu_si128((__m128i *)u_dst, _mm256_castsi256_si128(dist));
+  _mm_storeu_si128((__m128i *)v_dst, _mm256_extracti128_si256(dist, 1));
+}
+
+// For each of 16 pixels i, compute dist[i - 1] + dist[i] + dist[i + 1].
+static INLINE __m256i get_sum_16(const uint16_t *dist) {
+  const __m256i left = _mm256_loadu_si256((const __m256i *)(dist - 1));
+  const __m256i center = _mm256_loadu_si256((const __m256i *)dist);
+  const __m256i right = _mm256_loadu_si256((const __m256i *)(dist + 1));
+
+  return _mm256_adds_epu16(_mm256_adds_epu16(left, center), right);
+}
+
+// The same as get_sum_16() for 8 u and 8 v pixels.
+static INLINE __m256i get_sum_8x2(const uint16_t *u_dist,
+                                  const uint16_t *v_dist) {
+  const __m256i left = load_u16_8x2(u_dist - 1, v_dist - 1);
+  const __m256i center = load_u16_8x2(u_dist, v_dist);
+  const __m256i right = load_u16_8x2(u_dist + 1, v_dist + 1);
+
+  return _mm256_adds_epu16(_mm256_adds_epu16(left, center), right);
+}
+
+// Read the chroma distortion of a row of 16 luma pixels.
+static INLINE void read_chroma_dist_row_16(int ss_x, const uint16_t *u_dist,
+                                           const uint16_t *v_dist,
+                                           __m256i *u_reg, __m256i *v_reg) {
+  if (!ss_x) {
+    *u_reg = _mm256_loadu_si256((const __m256i *)u_dist);
+    *v_reg = _mm256_loadu_si256((const __m256i *)v_dist);
+  } else {
+    // Each of the 8 chroma values is used by 2 luma pixels.
+    const __m256i u_u32 =
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)u_dist));
+    const __m256i v_u32 =
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)v_dist));
+    *u_reg = _mm256_or_si256(u_u32, _mm256_slli_epi32(u_u32, 16));
+    *v_reg = _mm256_or_si256(v_u32, _mm256_slli_epi32(v_u32, 16));
+  }
+}
+
+// Sum the luma distortion of the pixels covered by 8 chroma pixels and add it
+// to both halves of uv_mod.
+static INLINE __m256i add_luma_dist_to_8_chroma_mod(const uint16_t *y_dist,
+                                                    int ss_x, int ss_y,
+                                                    __m256i uv_mod) {
+  __m128i y_reg;
+
+  if (!ss_x) {
+    y_reg = _mm_loadu_si128((const __m128i *)y_dist);
+    if (ss_y) {
+      y_reg = _mm_adds_epu16(
+          y_reg, _mm_loadu_si128((const __m128i *)(y_dist + DIST_STRIDE)));
+    }
+  } else {
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    __m256i y_16 = _mm256_loadu_si256((const __m256i *)y_dist);
+    __m256i y_sum;
+    if (ss_y) {
+      y_16 = _mm256_adds_epu16(
+          y_16, _mm256_loadu_si256((const __m256i *)(y_dist + DIST_STRIDE)));
+    }
+    y_sum = _mm256_add_epi32(_mm256_and_si256(y_16, mask),
+                             _mm256_srli_epi32(y_16, 16));
+    y_reg = _mm_packus_epi32(_mm256_castsi256_si128(y_sum),
+                             _mm256_extracti128_si256(y_sum, 1));
+  }
+
+  return _mm256_adds_epu16(uv_mod, mm256_set_m128i(y_reg, y_reg));
+}
+
+// Average the value based on the number of values summed. Add in the rounding
+// factor and shift, clamp to 16, invert and multiply by weight.
+static INLINE __m256i average_16(__m256i sum, const __m256i *mul_constants,
+                                 const __m128i strength, const __m256i rounding,
+                                 const __m256i *weight) {
+  const __m256i sixteen = _mm256_set1_epi16(16);
+
+  // modifier * 3 / index;
+  sum = _mm256_mulhi_epu16(sum, *mul_constants);
+
+  sum = _mm256_adds_epu16(sum, rounding);
+  sum = _mm256_srl_epi16(sum, strength);
+  sum = _mm256_min_epu16(sum, sixteen);
+  sum = _mm256_sub_epi16(sixteen, sum);
+
+  return _mm256_mullo_epi16(sum, *weight);
+}
+
+// Add the 8 16-bit values of weighted to the 32-bit accum.
+static INLINE void accumulate_8(const __m128i weighted, uint32_t *accum) {
+  _mm256_storeu_si256(
+      (__m256i *)accum,
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)accum),
+                       _mm256_cvtepu16_epi32(weighted)));
+}
+
+// Add the 16 modifiers to count. Multiply them by pred and add to accum.
+static INLINE void accumulate_and_store_luma_16(const __m256i sum_u16,
+                                                const uint8_t *pred,
+                                                uint16_t *count,
+                                                uint32_t *accum) {
+  const __m256i pred_u16 =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)pred));
+  const __m256i weighted = _mm256_mullo_epi16(sum_u16, pred_u16);
+
+  _mm256_storeu_si256(
+      (__m256i *)count,
+      _mm256_adds_epu16(_mm256_loadu_si256((const __m256i *)count), sum_u16));
+  accumulate_8(_mm256_castsi256_si128(weighted), accum);
+  accumulate_8(_mm256_extracti128_si256(weighted, 1), accum + 8);
+}
+
+// The same as accumulate_and_store_luma_16() for 8 u and 8 v modifiers.
+static INLINE void accumulate_and_store_chroma_8x2(
+    const __m256i sum_u16, const uint8_t *u_pred, const uint8_t *v_pred,
+    uint16_t *u_count, uint16_t *v_count, uint32_t *u_accum,
+    uint32_t *v_accum) {
+  const __m256i pred_u16 = _mm256_cvtepu8_epi16(
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)u_pred),
+                         _mm_loadl_epi64((const __m128i *)v_pred)));
+  const __m256i weighted = _mm256_mullo_epi16(sum_u16, pred_u16);
+
+  _mm_storeu_si128((__m128i *)u_count,
+                   _mm_adds_epu16(_mm_loadu_si128((const __m128i *)u_count),
+                                  _mm256_castsi256_si128(sum_u16)));
+  _mm_storeu_si128((__m128i *)v_count,
+                   _mm_adds_epu16(_mm_loadu_si128((const __m128i *)v_count),
+                                  _mm256_extracti128_si256(sum_u16, 1)));
+  accumulate_8(_mm256_castsi256_si128(weighted), u_accum);
+  accumulate_8(_mm256_extracti128_si256(weighted, 1), v_accum);
+}
+
+// Filter a 16 pixel wide column of luma. The top and bottom half of the
+// column use top_weight and bottom_weight.
+static void apply_temporal_filter_luma_16(
+    const uint8_t *y_pre, int y_pre_stride, unsigned int block_height,
+    int ss_x, int ss_y, int strength, const __m256i *top_weight,
+    const __m256i *bottom_weight, uint32_t *y_accum, uint16_t *y_count,
+    const uint16_t *y_dist, const uint16_t *u_dist, const uint16_t *v_dist,
+    const int16_t *const *neighbors_first,
+    const int16_t *const *neighbors_second) {
+  const __m128i strength_u128 = _mm_set_epi32(0, 0, 0, strength);
+  const __m256i rounding = _mm256_set1_epi16((1 << strength) >> 1);
+  const __m256i *weight = top_weight;
+  __m256i mul, sum_row_1, sum_row_2, sum_row_3, sum_row, u_reg, v_reg;
+  unsigned int h;
+
+  // First row
+  mul = mm256_set_m128i(_mm_load_si128((const __m128i *)neighbors_second[0]),
+                        _mm_load_si128((const __m128i *)neighbors_first[0]));
+
+  sum_row_2 = get_sum_16(y_dist);
+  sum_row_3 = get_sum_16(y_dist + DIST_STRIDE);
+  sum_row = _mm256_adds_epu16(sum_row_2, sum_row_3);
+
+  read_chroma_dist_row_16(ss_x, u_dist, v_dist, &u_reg, &v_reg);
+  sum_row = _mm256_adds_epu16(sum_row, u_reg);
+  sum_row = _mm256_adds_epu16(sum_row, v_reg);
+
+  sum_row = average_16(sum_row, &mul, strength_u128, rounding, weight);
+  accumulate_and_store_luma_16(sum_row, y_pre, y_count, y_accum);
+
+  y_pre += y_pre_stride;
+  y_count += y_pre_stride;
+  y_accum += y_pre_stride;
+  y_dist += DIST_STRIDE;
+  u_dist += DIST_STRIDE;
+  v_dist += DIST_STRIDE;
+
+  // Then all the rows except the last one
+  mul = mm256_set_m128i(_mm_load_si128((const __m128i *)neighbors_second[1]),
+                        _mm_load_si128((const __m128i *)neighbors_first[1]));
+
+  for (h = 1; h < block_height - 1; ++h) {
+    if (h == block_height / 2) weight = bottom_weight;
+
+    sum_row_1 = sum_row_2;
+    sum_row_2 = sum_row_3;
+    sum_row_3 = get_sum_16(y_dist + DIST_STRIDE);
+    sum_row = _mm256_adds_epu16(sum_row_1, sum_row_2);
+    sum_row = _mm256_adds_epu16(sum_row, sum_row_3);
+
+    // Only read the chroma distortion again at a new chroma row.
+    if (ss_y == 0 || h % 2 == 0) {
+      read_chroma_dist_row_16(ss_x, u_dist, v_dist, &u_reg, &v_reg);
+      u_dist += DIST_STRIDE;
+      v_dist += DIST_STRIDE;
+    }
+    sum_row = _mm256_adds_epu16(sum_row, u_reg);
+    sum_row = _mm256_adds_epu16(sum_row, v_reg);
+
+    sum_row = average_16(sum_row, &mul, strength_u128, rounding, weight);
+    accumulate_and_store_luma_16(sum_row, y_pre, y_count, y_accum);
+
+    y_pre += y_pre_stride;
+    y_count += y_pre_stride;
+    y_accum += y_pre_stride;
+    y_dist += DIST_STRIDE;
+  }
+
+  // The last row
+  mul = mm256_set_m128i(_mm_load_si128((const __m128i *)neighbors_second[0]),
+                        _mm_load_si128((const __m128i *)neighbors_first[0]));
+
+  sum_row = _mm256_adds_epu16(sum_row_2, sum_row_3);
+
+  if (ss_y == 0) {
+    read_chroma_dist_row_16(ss_x, u_dist, v_dist, &u_reg, &v_reg);
+  }
+  sum_row = _mm256_adds_epu16(sum_row, u_reg);
+  sum_row = _mm256_adds_epu16(sum_row, v_reg);
+
+  sum_row = average_16(sum_row, &mul, strength_u128, rounding, weight);
+  accumulate_and_store_luma_16(sum_row, y_pre, y_count, y_accum);
+}
+
+// Filter an 8 pixel wide column of both chroma planes.
+static void apply_temporal_filter_chroma_8(
+    const uint8_t *u_pre, const uint8_t *v_pre, int uv_pre_stride,
+    unsigned int uv_block_height, int ss_x, int ss_y, int strength,
+    const __m256i *top_weight, const __m256i *bottom_weight,
+    uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum,
+    uint16_t *v_count, const uint16_t *y_dist, const uint16_t *u_dist,
+    const uint16_t *v_dist, const int16_t *const *neighbors) {
+  const __m128i strength_u128 = _mm_set_epi32(0, 0, 0, strength);
+  const __m256i rounding = _mm256_set1_epi16((1 << strength) >> 1);
+  const __m256i *weight = top_weight;
+  __m256i mul, sum_row_1, sum_row_2, sum_row_3, sum_row;
+  unsigned int h;
+
+  // First row
+  mul = mm256_set_m128i(_mm_load_si128((const __m128i *)neighbors[0]),
+                        _mm_load_si128((const __m128i *)neighbors[0]));
+
+  sum_row_2 = get_sum_8x2(u_dist, v_dist);
+  sum_row_3 = get_sum_8x2(u_dist + DIST_STRIDE, v_dist + DIST_STRIDE);
+  sum_row = _mm256_adds_epu16(sum_row_2, sum_row_3);
+  sum_row = add_luma_dist_to_8_chroma_mod(y_dist, ss_x, ss_y, sum_row);
+
+  sum_row = average_16(sum_row, &mul, strength_u128, rounding, weight);
+  accumulate_and_store_chroma_8x2(sum_row, u_pre, v_pre, u_count, v_count,
+                                  u_accum, v_accum);
+
+  u_pre += uv_pre_stride;
+  v_pre += uv_pre_stride;
+  u_dist += DIST_STRIDE;
+  v_dist += DIST_STRIDE;
+  u_count += uv_pre_stride;
+  u_accum += uv_pre_stride;
+  v_count += uv_pre_stride;
+  v_accum += uv_pre_stride;
+  y_dist += DIST_STRIDE * (1 + ss_y);
+
+  // Then all the rows except the last one
+  mul = mm256_set_m128i(_mm_load_si128((const __m128i *)neighbors[1]),
+                        _mm_load_si128((const __m128i *)neighbors[1]));
+
+  for (h = 1; h < uv_block_height - 1; ++h) {
+    if (h == uv_block_height / 2) weight = bottom_weight;
+
+    sum_row_1 = sum_row_2;
+    sum_row_2 = sum_row_3;
+    sum_row_3 = get_sum_8x2(u_dist + DIST_STRIDE, v_dist + DIST_STRIDE);
+    sum_row = _mm256_adds_epu16(sum_row_1, sum_row_2);
+    sum_row = _mm256_adds_epu16(sum_row, sum_row_3);
+    sum_row = add_luma_dist_to_8_chroma_mod(y_dist, ss_x, ss_y, sum_row);
+
+    sum_row = average_16(sum_row, &mul, strength_u128, rounding, weight);
+    accumulate_and_store_chroma_8x2(sum_row, u_pre, v_pre, u_count, v_count,
+                                    u_accum, v_accum);
+
+    u_pre += uv_pre_stride;
+    v_pre += uv_pre_stride;
+    u_dist += DIST_STRIDE;
+    v_dist += DIST_STRIDE;
+    u_count += uv_pre_stride;
+    u_accum += uv_pre_stride;
+    v_count += uv_pre_stride;
+    v_accum += uv_pre_stride;
+    y_dist += DIST_STRIDE * (1 + ss_y);
+  }
+
+  // The last row
+  mul = mm256_set_m128i(_mm_load_si128((const __m128i *)neighbors[0]),
+                        _mm_load_si128((const __m128i *)neighbors[0]));
+
+  sum_row = _mm256_adds_epu16(sum_row_2, sum_row_3);
+  sum_row = add_luma_dist_to_8_chroma_mod(y_dist, ss_x, ss_y, sum_row);
+
+  sum_row = average_16(sum_row, &mul, strength_u128, rounding, weight);
+  accumulate_and_store_chroma_8x2(sum_row, u_pre, v_pre, u_count, v_count,
+                                  u_accum, v_accum);
+}
+
+// Returns the weights of a column of width pixels starting at col of a
+// block_width wide block. The column lies in one horizontal half of the block
+// unless it is the whole block. A 16-bit weight is used for each pixel of the
+// column, for both chroma planes when width is 8.
+static INLINE void get_column_weights(const int *blk_fw, int use_whole_blk,
+                                      unsigned int col, unsigned int width,
+                                      unsigned int block_width,
+                                      __m256i *top_weight,
+                                      __m256i *bottom_weight) {
+  int left, right;
+  __m128i top, bottom;
+
+  if (use_whole_blk) {
+    *top_weight = *bottom_weight = _mm256_set1_epi16(blk_fw[0]);
+    return;
+  }
+  if (width == block_width) {
+    left = 0;
+    right = 1;
+  } else {
+    left = right = col >= block_width / 2;
+  }
+
+  if (width == 16) {
+    *top_weight = mm256_set_m128i(_mm_set1_epi16(blk_fw[right]),
+                                  _mm_set1_epi16(blk_fw[left]));
+    *bottom_weight = mm256_set_m128i(_mm_set1_epi16(blk_fw[2 + right]),
+                                     _mm_set1_epi16(blk_fw[2 + left]));
+  } else {
+    assert(width == 8);
+    top = _mm_setr_epi16(blk_fw[left], blk_fw[left], blk_fw[left], blk_fw[left],
+                         blk_fw[right], blk_fw[right], blk_fw[right],
+                         blk_fw[right]);
+    bottom = _mm_setr_epi16(blk_fw[2 + left], blk_fw[2 + left],
+                            blk_fw[2 + left], blk_fw[2 + left],
+                            blk_fw[2 + right], blk_fw[2 + right],
+                            blk_fw[2 + right], blk_fw[2 + right]);
+    *top_weight = mm256_set_m128i(top, top);
+    *bottom_weight = mm256_set_m128i(bottom, bottom);
+  }
+}
+
+void vp9_apply_temporal_filter_avx2(
+    const uint8_t *y_src, int y_src_stride, const uint8_t *y_pre,
+    int y_pre_stride, const uint8_t *u_src, const uint8_t *v_src,
+    int uv_src_stride, const uint8_t *u_pre, const uint8_t *v_pre,
+    int uv_pre_stride, unsigned int block_width, unsigned int block_height,
+    int ss_x, int ss_y, int strength, const int *const blk_fw,
+    int use_whole_blk, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
+    uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count) {
+  const unsigned int chroma_height = block_height >> ss_y,
+                     chroma_width = block_width >> ss_x;
+
+  DECLARE_ALIGNED(32, uint16_t, y_dist[BH * DIST_STRIDE]) = { 0 };
+  DECLARE_ALIGNED(32, uint16_t, u_dist[BH * DIST_STRIDE]) = { 0 };
+  DECLARE_ALIGNED(32, uint16_t, v_dist[BH * DIST_STRIDE]) = { 0 };
+
+  uint16_t *y_dist_ptr = y_dist + 1, *u_dist_ptr = u_dist + 1,
+           *v_dist_ptr = v_dist + 1;
+  const uint8_t *y_src_ptr = y_src, *u_src_ptr = u_src, *v_src_ptr = v_src;
+  const uint8_t *y_pre_ptr = y_pre, *u_pre_ptr = u_pre, *v_pre_ptr = v_pre;
+  const int16_t *const *neighbors_first;
+  const int16_t *const *neighbors_second;
+  const int16_t *const *neighbors;
+  __m256i top_weight, bottom_weight;
+
+  // Loop variables
+  unsigned int row, blk_col, uv_blk_col;
+
+  assert(block_width <= BW && "block width too large");
+  assert(block_height <= BH && "block height too large");
+  assert(block_width % 16 == 0 && "block width must be multiple of 16");
+  assert(block_height % 2 == 0 && "block height must be even");
+  assert((ss_x == 0 || ss_x == 1) && (ss_y == 0 || ss_y == 1) &&
+         "invalid chroma subsampling");
+  assert(strength >= 0 && strength <= 6 && "invalid temporal filter strength");
+  assert(blk_fw[0] >= 0 && "filter weight must be positive");
+  assert(
+      (use_whole_blk || (blk_fw[1] >= 0 && blk_fw[2] >= 0 && blk_fw[3] >= 0)) &&
+      "subblock filter weight must be positive");
+  assert(blk_fw[0] <= 2 && "sublock filter weight must be less than 2");
+  assert(
+      (use_whole_blk || (blk_fw[1] <= 2 && blk_fw[2] <= 2 && blk_fw[3] <= 2)) &&
+      "subblock filter weight must be less than 2");
+
+  // Precompute the difference squared
+  for (row = 0; row < block_height; row++) {
+    for (blk_col = 0; blk_col < block_width; blk_col += 16) {
+      store_dist_16(y_src_ptr + blk_col, y_pre_ptr + blk_col,
+                    y_dist_ptr + blk_col);
+    }
+    y_src_ptr += y_src_stride;
+    y_pre_ptr += y_pre_stride;
+    y_dist_ptr += DIST_STRIDE;
+  }
+
+  for (row = 0; row < chroma_height; row++) {
+    for (blk_col = 0; blk_col < chroma_width; blk_col += 8) {
+      store_dist_8x2(u_src_ptr + blk_col, u_pre_ptr + blk_col,
+                     v_src_ptr + blk_col, v_pre_ptr + blk_col,
+                     u_dist_ptr + blk_col, v_dist_ptr + blk_col);
+    }
+    u_src_ptr += uv_src_stride;
+    u_pre_ptr += uv_pre_stride;
+    u_dist_ptr += DIST_STRIDE;
+    v_src_ptr += uv_src_stride;
+    v_pre_ptr += uv_pre_stride;
+    v_dist_ptr += DIST_STRIDE;
+  }
+
+  y_dist_ptr = y_dist + 1;
+  u_dist_ptr = u_dist + 1;
+  v_dist_ptr = v_dist + 1;
+
+  // Luma, in columns of 16
+  for (blk_col = 0; blk_col < block_width; blk_col += 16) {
+    const unsigned int uv_col = blk_col >> ss_x;
+    neighbors_first = blk_col == 0 ? LUMA_LEFT_COLUMN_NEIGHBORS
+                                   : LUMA_MIDDLE_COLUMN_NEIGHBORS;
+    neighbors_second = blk_col + 16 == block_width
+                           ? LUMA_RIGHT_COLUMN_NEIGHBORS
+                           : LUMA_MIDDLE_COLUMN_NEIGHBORS;
+    get_column_weights(blk_fw, use_whole_blk, blk_col, 16, block_width,
+                       &top_weight, &bottom_weight);
+    apply_temporal_filter_luma_16(
+        y_pre + blk_col, y_pre_stride, block_height, ss_x, ss_y, strength,
+        &top_weight, &bottom_weight, y_accum + blk_col, y_count + blk_col,
+        y_dist_ptr + blk_col, u_dist_ptr + uv_col, v_dist_ptr + uv_col,
+        neighbors_first, neighbors_second);
+  }
+
+  // Chroma, in columns of 8
+  for (uv_blk_col = 0; uv_blk_col < chroma_width; uv_blk_col += 8) {
+    blk_col = uv_blk_col << ss_x;
+    if (chroma_width == 8) {
+      // A 16x16 block subsampled in x: a single column.
+      assert(ss_x);
+      neighbors = ss_y ? CHROMA_DOUBLE_SS_SINGLE_COLUMN_NEIGHBORS
+                       : CHROMA_SINGLE_SS_SINGLE_COLUMN_NEIGHBORS;
+    } else if (uv_blk_col == 0) {
+      neighbors = (ss_x && ss_y)   ? CHROMA_DOUBLE_SS_LEFT_COLUMN_NEIGHBORS
+                  : (ss_x || ss_y) ? CHROMA_SINGLE_SS_LEFT_COLUMN_NEIGHBORS
+                                   : CHROMA_NO_SS_LEFT_COLUMN_NEIGHBORS;
+    } else if (uv_blk_col + 8 == chroma_width) {
+      neighbors = (ss_x && ss_y)   ? CHROMA_DOUBLE_SS_RIGHT_COLUMN_NEIGHBORS
+                  : (ss_x || ss_y) ? CHROMA_SINGLE_SS_RIGHT_COLUMN_NEIGHBORS
+                                   : CHROMA_NO_SS_RIGHT_COLUMN_NEIGHBORS;
+    } else {
+      neighbors = (ss_x && ss_y)   ? CHROMA_DOUBLE_SS_MIDDLE_COLUMN_NEIGHBORS
+                  : (ss_x || ss_y) ? CHROMA_SINGLE_SS_MIDDLE_COLUMN_NEIGHBORS
+                                   : CHROMA_NO_SS_MIDDLE_COLUMN_NEIGHBORS;
+    }
+    get_column_weights(blk_fw, use_whole_blk, uv_blk_col, 8, chroma_width,
+                       &top_weight, &bottom_weight);
+    apply_temporal_filter_chroma_8(
+        u_pre + uv_blk_col, v_pre + uv_blk_col, uv_pre_stride, chroma_height,
+        ss_x, ss_y, strength, &top_weight, &bottom_weight,
+        u_accum + uv_blk_col, u_count + uv_blk_col, v_accum + uv_blk_col,
+        v_count + uv_blk_col, y_dist_ptr + blk_col, u_dist_ptr + uv_blk_col,
+        v_dist_ptr + uv_blk_col, neighbors);
+  }
+}
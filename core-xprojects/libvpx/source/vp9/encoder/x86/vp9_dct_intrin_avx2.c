@@ -0,0 +1,1495 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+#include <string.h>
+
+#include "./vp9_rtcd.h"
+#include "./vpx_dsp_rtcd.h"
+#include "vp9/common/vp9_enums.h"
+#include "vpx_dsp/txfm_common.h"
+#include "vpx_ports/mem.h"
+
+#define pair256_set_epi16(a, b)                                            \
+  _mm256_set_epi16((int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a), \
+                   (int16_t)(b), (int16_t)(a), (int16_t)(b), (int16_t)(a))
+
+// Each register holds one row of 16 coefficients. All of the arithmetic in the
+// 1-D transforms stays within 128-bit lanes, so they are the SSE2 8 column
+// versions widened to cover the whole block in one pass.
+static INLINE void load_buffer_16x16(const int16_t *input, __m256i *in,
+                                     int stride) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    in[i] = _mm256_loadu_si256((const __m256i *)(input + i * stride));
+    in[i] = _mm256_slli_epi16(in[i], 2);
+  }
+}
+
+static INLINE void write_buffer_16x16(tran_low_t *output, const __m256i *in) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(in[i]));
+    const __m256i hi =
+        _mm256_cvtepi16_epi32(_mm256_extracti128_si256(in[i], 1));
+    _mm256_storeu_si256((__m256i *)(output + i * 16), lo);
+    _mm256_storeu_si256((__m256i *)(output + i * 16 + 8), hi);
+#else
+    _mm256_storeu_si256((__m256i *)(output + i * 16), in[i]);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  }
+}
+
+// (x + 1 + (x < 0)) >> 2, the rounding between the column and row passes.
+static INLINE void right_shift_16x16(__m256i *in) {
+  const __m256i one = _mm256_set1_epi16(1);
+  int i;
+  for (i = 0; i < 16; ++i) {
+    const __m256i sign = _mm256_srai_epi16(in[i], 15);
+    in[i] = _mm256_sub_epi16(_mm256_add_epi16(in[i], one), sign);
+    in[i] = _mm256_srai_epi16(in[i], 2);
+  }
+}
+
+// Transposes the four 8x8 quadrants within their 128-bit lanes.
+static INLINE void transpose_16bit_8x8_x2(__m256i *in) {
+  __m256i a[8], b[8];
+  a[0] = _mm256_unpacklo_epi16(in[0], in[1]);
+  a[1] = _mm256_unpacklo_epi16(in[2], in[3]);
+  a[2] = _mm256_unpacklo_epi16(in[4], in[5]);
+  a[3] = _mm256_unpacklo_epi16(in[6], in[7]);
+  a[4] = _mm256_unpackhi_epi16(in[0], in[1]);
+  a[5] = _mm256_unpackhi_epi16(in[2], in[3]);
+  a[6] = _mm256_unpackhi_epi16(in[4], in[5]);
+  a[7] = _mm256_unpackhi_epi16(in[6], in[7]);
+
+  b[0] = _mm256_unpacklo_epi32(a[0], a[1]);
+  b[1] = _mm256_unpacklo_epi32(a[2], a[3]);
+  b[2] = _mm256_unpackhi_epi32(a[0], a[1]);
+  b[3] = _mm256_unpackhi_epi32(a[2], a[3]);
+  b[4] = _mm256_unpacklo_epi32(a[4], a[5]);
+  b[5] = _mm256_unpacklo_epi32(a[6], a[7]);
+  b[6] = _mm256_unpackhi_epi32(a[4], a[5]);
+  b[7] = _mm256_unpackhi_epi32(a[6], a[7]);
+
+  in[0] = _mm256_unpacklo_epi64(b[0], b[1]);
+  in[1] = _mm256_unpackhi_epi64(b[0], b[1]);
+  in[2] = _mm256_unpacklo_epi64(b[2], b[3]);
+  in[3] = _mm256_unpackhi_epi64(b[2], b[3]);
+  in[4] = _mm256_unpacklo_epi64(b[4], b[5]);
+  in[5] = _mm256_unpackhi_epi64(b[4], b[5]);
+  in[6] = _mm256_unpacklo_epi64(b[6], b[7]);
+  in[7] = _mm256_unpackhi_epi64(b[6], b[7]);
+}
+
+static INLINE void transpose_16bit_16x16_avx2(__m256i *in) {
+  __m256i left[8], right[8];
+  int i;
+  // Gather the left and right 8 columns of rows i and i + 8 so that the
+  // in-lane transposes produce whole output rows.
+  for (i = 0; i < 8; ++i) {
+    left[i] = _mm256_permute2x128_si256(in[i], in[i + 8], 0x20);
+    right[i] = _mm256_permute2x128_si256(in[i], in[i + 8], 0x31);
+  }
+  transpose_16bit_8x8_x2(left);
+  transpose_16bit_8x8_x2(right);
+  for (i = 0; i < 8; ++i) {
+    in[i] = left[i];
+    in[i + 8] = right[i];
+  }
+}
+
+static void fdct16_16col(__m256i *in) {
+  // perform 16x16 1-D DCT for 16 columns
+  __m256i i[8], s[8], p[8], t[8], u[16], v[16];
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16(cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i k__cospi_p24_p08 = pair256_set_epi16(cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_p08_m24 = pair256_set_epi16(cospi_8_64, -cospi_24_64);
+  const __m256i k__cospi_m08_p24 = pair256_set_epi16(-cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p28_p04 = pair256_set_epi16(cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m04_p28 = pair256_set_epi16(-cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p12_p20 = pair256_set_epi16(cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_m20_p12 = pair256_set_epi16(-cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p30_p02 = pair256_set_epi16(cospi_30_64, cospi_2_64);
+  const __m256i k__cospi_p14_p18 = pair256_set_epi16(cospi_14_64, cospi_18_64);
+  const __m256i k__cospi_m02_p30 = pair256_set_epi16(-cospi_2_64, cospi_30_64);
+  const __m256i k__cospi_m18_p14 = pair256_set_epi16(-cospi_18_64, cospi_14_64);
+  const __m256i k__cospi_p22_p10 = pair256_set_epi16(cospi_22_64, cospi_10_64);
+  const __m256i k__cospi_p06_p26 = pair256_set_epi16(cospi_6_64, cospi_26_64);
+  const __m256i k__cospi_m10_p22 = pair256_set_epi16(-cospi_10_64, cospi_22_64);
+  const __m256i k__cospi_m26_p06 = pair256_set_epi16(-cospi_26_64, cospi_6_64);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+
+  // stage 1
+  i[0] = _mm256_add_epi16(in[0], in[15]);
+  i[1] = _mm256_add_epi16(in[1], in[14]);
+  i[2] = _mm256_add_epi16(in[2], in[13]);
+  i[3] = _mm256_add_epi16(in[3], in[12]);
+  i[4] = _mm256_add_epi16(in[4], in[11]);
+  i[5] = _mm256_add_epi16(in[5], in[10]);
+  i[6] = _mm256_add_epi16(in[6], in[9]);
+  i[7] = _mm256_add_epi16(in[7], in[8]);
+
+  s[0] = _mm256_sub_epi16(in[7], in[8]);
+  s[1] = _mm256_sub_epi16(in[6], in[9]);
+  s[2] = _mm256_sub_epi16(in[5], in[10]);
+  s[3] = _mm256_sub_epi16(in[4], in[11]);
+  s[4] = _mm256_sub_epi16(in[3], in[12]);
+  s[5] = _mm256_sub_epi16(in[2], in[13]);
+  s[6] = _mm256_sub_epi16(in[1], in[14]);
+  s[7] = _mm256_sub_epi16(in[0], in[15]);
+
+  p[0] = _mm256_add_epi16(i[0], i[7]);
+  p[1] = _mm256_add_epi16(i[1], i[6]);
+  p[2] = _mm256_add_epi16(i[2], i[5]);
+  p[3] = _mm256_add_epi16(i[3], i[4]);
+  p[4] = _mm256_sub_epi16(i[3], i[4]);
+  p[5] = _mm256_sub_epi16(i[2], i[5]);
+  p[6] = _mm256_sub_epi16(i[1], i[6]);
+  p[7] = _mm256_sub_epi16(i[0], i[7]);
+
+  u[0] = _mm256_add_epi16(p[0], p[3]);
+  u[1] = _mm256_add_epi16(p[1], p[2]);
+  u[2] = _mm256_sub_epi16(p[1], p[2]);
+  u[3] = _mm256_sub_epi16(p[0], p[3]);
+
+  v[0] = _mm256_unpacklo_epi16(u[0], u[1]);
+  v[1] = _mm256_unpackhi_epi16(u[0], u[1]);
+  v[2] = _mm256_unpacklo_epi16(u[2], u[3]);
+  v[3] = _mm256_unpackhi_epi16(u[2], u[3]);
+
+  u[0] = _mm256_madd_epi16(v[0], k__cospi_p16_p16);
+  u[1] = _mm256_madd_epi16(v[1], k__cospi_p16_p16);
+  u[2] = _mm256_madd_epi16(v[0], k__cospi_p16_m16);
+  u[3] = _mm256_madd_epi16(v[1], k__cospi_p16_m16);
+  u[4] = _mm256_madd_epi16(v[2], k__cospi_p24_p08);
+  u[5] = _mm256_madd_epi16(v[3], k__cospi_p24_p08);
+  u[6] = _mm256_madd_epi16(v[2], k__cospi_m08_p24);
+  u[7] = _mm256_madd_epi16(v[3], k__cospi_m08_p24);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+
+  in[0] = _mm256_packs_epi32(u[0], u[1]);
+  in[4] = _mm256_packs_epi32(u[4], u[5]);
+  in[8] = _mm256_packs_epi32(u[2], u[3]);
+  in[12] = _mm256_packs_epi32(u[6], u[7]);
+
+  u[0] = _mm256_unpacklo_epi16(p[5], p[6]);
+  u[1] = _mm256_unpackhi_epi16(p[5], p[6]);
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_p16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_p16);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p16_p16);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p16_p16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+
+  u[0] = _mm256_packs_epi32(v[0], v[1]);
+  u[1] = _mm256_packs_epi32(v[2], v[3]);
+
+  t[0] = _mm256_add_epi16(p[4], u[0]);
+  t[1] = _mm256_sub_epi16(p[4], u[0]);
+  t[2] = _mm256_sub_epi16(p[7], u[1]);
+  t[3] = _mm256_add_epi16(p[7], u[1]);
+
+  u[0] = _mm256_unpacklo_epi16(t[0], t[3]);
+  u[1] = _mm256_unpackhi_epi16(t[0], t[3]);
+  u[2] = _mm256_unpacklo_epi16(t[1], t[2]);
+  u[3] = _mm256_unpackhi_epi16(t[1], t[2]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p28_p04);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p28_p04);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p12_p20);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p12_p20);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_m20_p12);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_m20_p12);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_m04_p28);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_m04_p28);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  in[2] = _mm256_packs_epi32(v[0], v[1]);
+  in[6] = _mm256_packs_epi32(v[4], v[5]);
+  in[10] = _mm256_packs_epi32(v[2], v[3]);
+  in[14] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 2
+  u[0] = _mm256_unpacklo_epi16(s[2], s[5]);
+  u[1] = _mm256_unpackhi_epi16(s[2], s[5]);
+  u[2] = _mm256_unpacklo_epi16(s[3], s[4]);
+  u[3] = _mm256_unpackhi_epi16(s[3], s[4]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_p16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_p16);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_m16_p16);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_m16_p16);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p16_p16);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p16_p16);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_p16_p16);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_p16_p16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  t[2] = _mm256_packs_epi32(v[0], v[1]);
+  t[3] = _mm256_packs_epi32(v[2], v[3]);
+  t[4] = _mm256_packs_epi32(v[4], v[5]);
+  t[5] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 3
+  p[0] = _mm256_add_epi16(s[0], t[3]);
+  p[1] = _mm256_add_epi16(s[1], t[2]);
+  p[2] = _mm256_sub_epi16(s[1], t[2]);
+  p[3] = _mm256_sub_epi16(s[0], t[3]);
+  p[4] = _mm256_sub_epi16(s[7], t[4]);
+  p[5] = _mm256_sub_epi16(s[6], t[5]);
+  p[6] = _mm256_add_epi16(s[6], t[5]);
+  p[7] = _mm256_add_epi16(s[7], t[4]);
+
+  // stage 4
+  u[0] = _mm256_unpacklo_epi16(p[1], p[6]);
+  u[1] = _mm256_unpackhi_epi16(p[1], p[6]);
+  u[2] = _mm256_unpacklo_epi16(p[2], p[5]);
+  u[3] = _mm256_unpackhi_epi16(p[2], p[5]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m08_p24);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m08_p24);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p24_p08);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p24_p08);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p08_m24);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p08_m24);
+  v[6] = _mm256_madd_epi16(u[0], k__cospi_p24_p08);
+  v[7] = _mm256_madd_epi16(u[1], k__cospi_p24_p08);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+
+  t[1] = _mm256_packs_epi32(v[0], v[1]);
+  t[2] = _mm256_packs_epi32(v[2], v[3]);
+  t[5] = _mm256_packs_epi32(v[4], v[5]);
+  t[6] = _mm256_packs_epi32(v[6], v[7]);
+
+  // stage 5
+  s[0] = _mm256_add_epi16(p[0], t[1]);
+  s[1] = _mm256_sub_epi16(p[0], t[1]);
+  s[2] = _mm256_add_epi16(p[3], t[2]);
+  s[3] = _mm256_sub_epi16(p[3], t[2]);
+  s[4] = _mm256_sub_epi16(p[4], t[5]);
+  s[5] = _mm256_add_epi16(p[4], t[5]);
+  s[6] = _mm256_sub_epi16(p[7], t[6]);
+  s[7] = _mm256_add_epi16(p[7], t[6]);
+
+  // stage 6
+  u[0] = _mm256_unpacklo_epi16(s[0], s[7]);
+  u[1] = _mm256_unpackhi_epi16(s[0], s[7]);
+  u[2] = _mm256_unpacklo_epi16(s[1], s[6]);
+  u[3] = _mm256_unpackhi_epi16(s[1], s[6]);
+  u[4] = _mm256_unpacklo_epi16(s[2], s[5]);
+  u[5] = _mm256_unpackhi_epi16(s[2], s[5]);
+  u[6] = _mm256_unpacklo_epi16(s[3], s[4]);
+  u[7] = _mm256_unpackhi_epi16(s[3], s[4]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p30_p02);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p30_p02);
+  v[2] = _mm256_madd_epi16(u[2], k__cospi_p14_p18);
+  v[3] = _mm256_madd_epi16(u[3], k__cospi_p14_p18);
+  v[4] = _mm256_madd_epi16(u[4], k__cospi_p22_p10);
+  v[5] = _mm256_madd_epi16(u[5], k__cospi_p22_p10);
+  v[6] = _mm256_madd_epi16(u[6], k__cospi_p06_p26);
+  v[7] = _mm256_madd_epi16(u[7], k__cospi_p06_p26);
+  v[8] = _mm256_madd_epi16(u[6], k__cospi_m26_p06);
+  v[9] = _mm256_madd_epi16(u[7], k__cospi_m26_p06);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_m10_p22);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_m10_p22);
+  v[12] = _mm256_madd_epi16(u[2], k__cospi_m18_p14);
+  v[13] = _mm256_madd_epi16(u[3], k__cospi_m18_p14);
+  v[14] = _mm256_madd_epi16(u[0], k__cospi_m02_p30);
+  v[15] = _mm256_madd_epi16(u[1], k__cospi_m02_p30);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(v[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(v[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(v[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(v[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(v[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(v[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(v[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(v[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  in[1] = _mm256_packs_epi32(v[0], v[1]);
+  in[9] = _mm256_packs_epi32(v[2], v[3]);
+  in[5] = _mm256_packs_epi32(v[4], v[5]);
+  in[13] = _mm256_packs_epi32(v[6], v[7]);
+  in[3] = _mm256_packs_epi32(v[8], v[9]);
+  in[11] = _mm256_packs_epi32(v[10], v[11]);
+  in[7] = _mm256_packs_epi32(v[12], v[13]);
+  in[15] = _mm256_packs_epi32(v[14], v[15]);
+}
+
+static void fadst16_16col(__m256i *in) {
+  // perform 16x16 1-D ADST for 16 columns
+  __m256i s[16], x[16], u[32], v[32];
+  const __m256i k__cospi_p01_p31 = pair256_set_epi16(cospi_1_64, cospi_31_64);
+  const __m256i k__cospi_p31_m01 = pair256_set_epi16(cospi_31_64, -cospi_1_64);
+  const __m256i k__cospi_p05_p27 = pair256_set_epi16(cospi_5_64, cospi_27_64);
+  const __m256i k__cospi_p27_m05 = pair256_set_epi16(cospi_27_64, -cospi_5_64);
+  const __m256i k__cospi_p09_p23 = pair256_set_epi16(cospi_9_64, cospi_23_64);
+  const __m256i k__cospi_p23_m09 = pair256_set_epi16(cospi_23_64, -cospi_9_64);
+  const __m256i k__cospi_p13_p19 = pair256_set_epi16(cospi_13_64, cospi_19_64);
+  const __m256i k__cospi_p19_m13 = pair256_set_epi16(cospi_19_64, -cospi_13_64);
+  const __m256i k__cospi_p17_p15 = pair256_set_epi16(cospi_17_64, cospi_15_64);
+  const __m256i k__cospi_p15_m17 = pair256_set_epi16(cospi_15_64, -cospi_17_64);
+  const __m256i k__cospi_p21_p11 = pair256_set_epi16(cospi_21_64, cospi_11_64);
+  const __m256i k__cospi_p11_m21 = pair256_set_epi16(cospi_11_64, -cospi_21_64);
+  const __m256i k__cospi_p25_p07 = pair256_set_epi16(cospi_25_64, cospi_7_64);
+  const __m256i k__cospi_p07_m25 = pair256_set_epi16(cospi_7_64, -cospi_25_64);
+  const __m256i k__cospi_p29_p03 = pair256_set_epi16(cospi_29_64, cospi_3_64);
+  const __m256i k__cospi_p03_m29 = pair256_set_epi16(cospi_3_64, -cospi_29_64);
+  const __m256i k__cospi_p04_p28 = pair256_set_epi16(cospi_4_64, cospi_28_64);
+  const __m256i k__cospi_p28_m04 = pair256_set_epi16(cospi_28_64, -cospi_4_64);
+  const __m256i k__cospi_p20_p12 = pair256_set_epi16(cospi_20_64, cospi_12_64);
+  const __m256i k__cospi_p12_m20 = pair256_set_epi16(cospi_12_64, -cospi_20_64);
+  const __m256i k__cospi_m28_p04 = pair256_set_epi16(-cospi_28_64, cospi_4_64);
+  const __m256i k__cospi_m12_p20 = pair256_set_epi16(-cospi_12_64, cospi_20_64);
+  const __m256i k__cospi_p08_p24 = pair256_set_epi16(cospi_8_64, cospi_24_64);
+  const __m256i k__cospi_p24_m08 = pair256_set_epi16(cospi_24_64, -cospi_8_64);
+  const __m256i k__cospi_m24_p08 = pair256_set_epi16(-cospi_24_64, cospi_8_64);
+  const __m256i k__cospi_m16_m16 = _mm256_set1_epi16(-cospi_16_64);
+  const __m256i k__cospi_p16_p16 = _mm256_set1_epi16(cospi_16_64);
+  const __m256i k__cospi_p16_m16 = pair256_set_epi16(cospi_16_64, -cospi_16_64);
+  const __m256i k__cospi_m16_p16 = pair256_set_epi16(-cospi_16_64, cospi_16_64);
+  const __m256i k__DCT_CONST_ROUNDING = _mm256_set1_epi32(DCT_CONST_ROUNDING);
+  const __m256i kZero = _mm256_setzero_si256();
+
+  u[0] = _mm256_unpacklo_epi16(in[15], in[0]);
+  u[1] = _mm256_unpackhi_epi16(in[15], in[0]);
+  u[2] = _mm256_unpacklo_epi16(in[13], in[2]);
+  u[3] = _mm256_unpackhi_epi16(in[13], in[2]);
+  u[4] = _mm256_unpacklo_epi16(in[11], in[4]);
+  u[5] = _mm256_unpackhi_epi16(in[11], in[4]);
+  u[6] = _mm256_unpacklo_epi16(in[9], in[6]);
+  u[7] = _mm256_unpackhi_epi16(in[9], in[6]);
+  u[8] = _mm256_unpacklo_epi16(in[7], in[8]);
+  u[9] = _mm256_unpackhi_epi16(in[7], in[8]);
+  u[10] = _mm256_unpacklo_epi16(in[5], in[10]);
+  u[11] = _mm256_unpackhi_epi16(in[5], in[10]);
+  u[12] = _mm256_unpacklo_epi16(in[3], in[12]);
+  u[13] = _mm256_unpackhi_epi16(in[3], in[12]);
+  u[14] = _mm256_unpacklo_epi16(in[1], in[14]);
+  u[15] = _mm256_unpackhi_epi16(in[1], in[14]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p01_p31);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p01_p31);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p31_m01);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p31_m01);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p05_p27);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p05_p27);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p27_m05);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p27_m05);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p09_p23);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p09_p23);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p23_m09);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p23_m09);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_p13_p19);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_p13_p19);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p19_m13);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p19_m13);
+  v[16] = _mm256_madd_epi16(u[8], k__cospi_p17_p15);
+  v[17] = _mm256_madd_epi16(u[9], k__cospi_p17_p15);
+  v[18] = _mm256_madd_epi16(u[8], k__cospi_p15_m17);
+  v[19] = _mm256_madd_epi16(u[9], k__cospi_p15_m17);
+  v[20] = _mm256_madd_epi16(u[10], k__cospi_p21_p11);
+  v[21] = _mm256_madd_epi16(u[11], k__cospi_p21_p11);
+  v[22] = _mm256_madd_epi16(u[10], k__cospi_p11_m21);
+  v[23] = _mm256_madd_epi16(u[11], k__cospi_p11_m21);
+  v[24] = _mm256_madd_epi16(u[12], k__cospi_p25_p07);
+  v[25] = _mm256_madd_epi16(u[13], k__cospi_p25_p07);
+  v[26] = _mm256_madd_epi16(u[12], k__cospi_p07_m25);
+  v[27] = _mm256_madd_epi16(u[13], k__cospi_p07_m25);
+  v[28] = _mm256_madd_epi16(u[14], k__cospi_p29_p03);
+  v[29] = _mm256_madd_epi16(u[15], k__cospi_p29_p03);
+  v[30] = _mm256_madd_epi16(u[14], k__cospi_p03_m29);
+  v[31] = _mm256_madd_epi16(u[15], k__cospi_p03_m29);
+
+  u[0] = _mm256_add_epi32(v[0], v[16]);
+  u[1] = _mm256_add_epi32(v[1], v[17]);
+  u[2] = _mm256_add_epi32(v[2], v[18]);
+  u[3] = _mm256_add_epi32(v[3], v[19]);
+  u[4] = _mm256_add_epi32(v[4], v[20]);
+  u[5] = _mm256_add_epi32(v[5], v[21]);
+  u[6] = _mm256_add_epi32(v[6], v[22]);
+  u[7] = _mm256_add_epi32(v[7], v[23]);
+  u[8] = _mm256_add_epi32(v[8], v[24]);
+  u[9] = _mm256_add_epi32(v[9], v[25]);
+  u[10] = _mm256_add_epi32(v[10], v[26]);
+  u[11] = _mm256_add_epi32(v[11], v[27]);
+  u[12] = _mm256_add_epi32(v[12], v[28]);
+  u[13] = _mm256_add_epi32(v[13], v[29]);
+  u[14] = _mm256_add_epi32(v[14], v[30]);
+  u[15] = _mm256_add_epi32(v[15], v[31]);
+  u[16] = _mm256_sub_epi32(v[0], v[16]);
+  u[17] = _mm256_sub_epi32(v[1], v[17]);
+  u[18] = _mm256_sub_epi32(v[2], v[18]);
+  u[19] = _mm256_sub_epi32(v[3], v[19]);
+  u[20] = _mm256_sub_epi32(v[4], v[20]);
+  u[21] = _mm256_sub_epi32(v[5], v[21]);
+  u[22] = _mm256_sub_epi32(v[6], v[22]);
+  u[23] = _mm256_sub_epi32(v[7], v[23]);
+  u[24] = _mm256_sub_epi32(v[8], v[24]);
+  u[25] = _mm256_sub_epi32(v[9], v[25]);
+  u[26] = _mm256_sub_epi32(v[10], v[26]);
+  u[27] = _mm256_sub_epi32(v[11], v[27]);
+  u[28] = _mm256_sub_epi32(v[12], v[28]);
+  u[29] = _mm256_sub_epi32(v[13], v[29]);
+  u[30] = _mm256_sub_epi32(v[14], v[30]);
+  u[31] = _mm256_sub_epi32(v[15], v[31]);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  v[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  v[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  v[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  v[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  v[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  v[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  v[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  v[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+  v[16] = _mm256_add_epi32(u[16], k__DCT_CONST_ROUNDING);
+  v[17] = _mm256_add_epi32(u[17], k__DCT_CONST_ROUNDING);
+  v[18] = _mm256_add_epi32(u[18], k__DCT_CONST_ROUNDING);
+  v[19] = _mm256_add_epi32(u[19], k__DCT_CONST_ROUNDING);
+  v[20] = _mm256_add_epi32(u[20], k__DCT_CONST_ROUNDING);
+  v[21] = _mm256_add_epi32(u[21], k__DCT_CONST_ROUNDING);
+  v[22] = _mm256_add_epi32(u[22], k__DCT_CONST_ROUNDING);
+  v[23] = _mm256_add_epi32(u[23], k__DCT_CONST_ROUNDING);
+  v[24] = _mm256_add_epi32(u[24], k__DCT_CONST_ROUNDING);
+  v[25] = _mm256_add_epi32(u[25], k__DCT_CONST_ROUNDING);
+  v[26] = _mm256_add_epi32(u[26], k__DCT_CONST_ROUNDING);
+  v[27] = _mm256_add_epi32(u[27], k__DCT_CONST_ROUNDING);
+  v[28] = _mm256_add_epi32(u[28], k__DCT_CONST_ROUNDING);
+  v[29] = _mm256_add_epi32(u[29], k__DCT_CONST_ROUNDING);
+  v[30] = _mm256_add_epi32(u[30], k__DCT_CONST_ROUNDING);
+  v[31] = _mm256_add_epi32(u[31], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+  u[8] = _mm256_srai_epi32(v[8], DCT_CONST_BITS);
+  u[9] = _mm256_srai_epi32(v[9], DCT_CONST_BITS);
+  u[10] = _mm256_srai_epi32(v[10], DCT_CONST_BITS);
+  u[11] = _mm256_srai_epi32(v[11], DCT_CONST_BITS);
+  u[12] = _mm256_srai_epi32(v[12], DCT_CONST_BITS);
+  u[13] = _mm256_srai_epi32(v[13], DCT_CONST_BITS);
+  u[14] = _mm256_srai_epi32(v[14], DCT_CONST_BITS);
+  u[15] = _mm256_srai_epi32(v[15], DCT_CONST_BITS);
+  u[16] = _mm256_srai_epi32(v[16], DCT_CONST_BITS);
+  u[17] = _mm256_srai_epi32(v[17], DCT_CONST_BITS);
+  u[18] = _mm256_srai_epi32(v[18], DCT_CONST_BITS);
+  u[19] = _mm256_srai_epi32(v[19], DCT_CONST_BITS);
+  u[20] = _mm256_srai_epi32(v[20], DCT_CONST_BITS);
+  u[21] = _mm256_srai_epi32(v[21], DCT_CONST_BITS);
+  u[22] = _mm256_srai_epi32(v[22], DCT_CONST_BITS);
+  u[23] = _mm256_srai_epi32(v[23], DCT_CONST_BITS);
+  u[24] = _mm256_srai_epi32(v[24], DCT_CONST_BITS);
+  u[25] = _mm256_srai_epi32(v[25], DCT_CONST_BITS);
+  u[26] = _mm256_srai_epi32(v[26], DCT_CONST_BITS);
+  u[27] = _mm256_srai_epi32(v[27], DCT_CONST_BITS);
+  u[28] = _mm256_srai_epi32(v[28], DCT_CONST_BITS);
+  u[29] = _mm256_srai_epi32(v[29], DCT_CONST_BITS);
+  u[30] = _mm256_srai_epi32(v[30], DCT_CONST_BITS);
+  u[31] = _mm256_srai_epi32(v[31], DCT_CONST_BITS);
+
+  s[0] = _mm256_packs_epi32(u[0], u[1]);
+  s[1] = _mm256_packs_epi32(u[2], u[3]);
+  s[2] = _mm256_packs_epi32(u[4], u[5]);
+  s[3] = _mm256_packs_epi32(u[6], u[7]);
+  s[4] = _mm256_packs_epi32(u[8], u[9]);
+  s[5] = _mm256_packs_epi32(u[10], u[11]);
+  s[6] = _mm256_packs_epi32(u[12], u[13]);
+  s[7] = _mm256_packs_epi32(u[14], u[15]);
+  s[8] = _mm256_packs_epi32(u[16], u[17]);
+  s[9] = _mm256_packs_epi32(u[18], u[19]);
+  s[10] = _mm256_packs_epi32(u[20], u[21]);
+  s[11] = _mm256_packs_epi32(u[22], u[23]);
+  s[12] = _mm256_packs_epi32(u[24], u[25]);
+  s[13] = _mm256_packs_epi32(u[26], u[27]);
+  s[14] = _mm256_packs_epi32(u[28], u[29]);
+  s[15] = _mm256_packs_epi32(u[30], u[31]);
+
+  // stage 2
+  u[0] = _mm256_unpacklo_epi16(s[8], s[9]);
+  u[1] = _mm256_unpackhi_epi16(s[8], s[9]);
+  u[2] = _mm256_unpacklo_epi16(s[10], s[11]);
+  u[3] = _mm256_unpackhi_epi16(s[10], s[11]);
+  u[4] = _mm256_unpacklo_epi16(s[12], s[13]);
+  u[5] = _mm256_unpackhi_epi16(s[12], s[13]);
+  u[6] = _mm256_unpacklo_epi16(s[14], s[15]);
+  u[7] = _mm256_unpackhi_epi16(s[14], s[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p04_p28);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p04_p28);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p28_m04);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p28_m04);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p20_p12);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p20_p12);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p12_m20);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p12_m20);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_m28_p04);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_m28_p04);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p04_p28);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p04_p28);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m12_p20);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m12_p20);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p20_p12);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p20_p12);
+
+  u[0] = _mm256_add_epi32(v[0], v[8]);
+  u[1] = _mm256_add_epi32(v[1], v[9]);
+  u[2] = _mm256_add_epi32(v[2], v[10]);
+  u[3] = _mm256_add_epi32(v[3], v[11]);
+  u[4] = _mm256_add_epi32(v[4], v[12]);
+  u[5] = _mm256_add_epi32(v[5], v[13]);
+  u[6] = _mm256_add_epi32(v[6], v[14]);
+  u[7] = _mm256_add_epi32(v[7], v[15]);
+  u[8] = _mm256_sub_epi32(v[0], v[8]);
+  u[9] = _mm256_sub_epi32(v[1], v[9]);
+  u[10] = _mm256_sub_epi32(v[2], v[10]);
+  u[11] = _mm256_sub_epi32(v[3], v[11]);
+  u[12] = _mm256_sub_epi32(v[4], v[12]);
+  u[13] = _mm256_sub_epi32(v[5], v[13]);
+  u[14] = _mm256_sub_epi32(v[6], v[14]);
+  u[15] = _mm256_sub_epi32(v[7], v[15]);
+
+  v[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  v[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  v[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  v[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  v[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  v[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  v[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  v[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  v[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  v[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  v[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  v[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  v[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  v[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  v[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  v[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+
+  u[0] = _mm256_srai_epi32(v[0], DCT_CONST_BITS);
+  u[1] = _mm256_srai_epi32(v[1], DCT_CONST_BITS);
+  u[2] = _mm256_srai_epi32(v[2], DCT_CONST_BITS);
+  u[3] = _mm256_srai_epi32(v[3], DCT_CONST_BITS);
+  u[4] = _mm256_srai_epi32(v[4], DCT_CONST_BITS);
+  u[5] = _mm256_srai_epi32(v[5], DCT_CONST_BITS);
+  u[6] = _mm256_srai_epi32(v[6], DCT_CONST_BITS);
+  u[7] = _mm256_srai_epi32(v[7], DCT_CONST_BITS);
+  u[8] = _mm256_srai_epi32(v[8], DCT_CONST_BITS);
+  u[9] = _mm256_srai_epi32(v[9], DCT_CONST_BITS);
+  u[10] = _mm256_srai_epi32(v[10], DCT_CONST_BITS);
+  u[11] = _mm256_srai_epi32(v[11], DCT_CONST_BITS);
+  u[12] = _mm256_srai_epi32(v[12], DCT_CONST_BITS);
+  u[13] = _mm256_srai_epi32(v[13], DCT_CONST_BITS);
+  u[14] = _mm256_srai_epi32(v[14], DCT_CONST_BITS);
+  u[15] = _mm256_srai_epi32(v[15], DCT_CONST_BITS);
+
+  x[0] = _mm256_add_epi16(s[0], s[4]);
+  x[1] = _mm256_add_epi16(s[1], s[5]);
+  x[2] = _mm256_add_epi16(s[2], s[6]);
+  x[3] = _mm256_add_epi16(s[3], s[7]);
+  x[4] = _mm256_sub_epi16(s[0], s[4]);
+  x[5] = _mm256_sub_epi16(s[1], s[5]);
+  x[6] = _mm256_sub_epi16(s[2], s[6]);
+  x[7] = _mm256_sub_epi16(s[3], s[7]);
+  x[8] = _mm256_packs_epi32(u[0], u[1]);
+  x[9] = _mm256_packs_epi32(u[2], u[3]);
+  x[10] = _mm256_packs_epi32(u[4], u[5]);
+  x[11] = _mm256_packs_epi32(u[6], u[7]);
+  x[12] = _mm256_packs_epi32(u[8], u[9]);
+  x[13] = _mm256_packs_epi32(u[10], u[11]);
+  x[14] = _mm256_packs_epi32(u[12], u[13]);
+  x[15] = _mm256_packs_epi32(u[14], u[15]);
+
+  // stage 3
+  u[0] = _mm256_unpacklo_epi16(x[4], x[5]);
+  u[1] = _mm256_unpackhi_epi16(x[4], x[5]);
+  u[2] = _mm256_unpacklo_epi16(x[6], x[7]);
+  u[3] = _mm256_unpackhi_epi16(x[6], x[7]);
+  u[4] = _mm256_unpacklo_epi16(x[12], x[13]);
+  u[5] = _mm256_unpackhi_epi16(x[12], x[13]);
+  u[6] = _mm256_unpacklo_epi16(x[14], x[15]);
+  u[7] = _mm256_unpackhi_epi16(x[14], x[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_p08_p24);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_p08_p24);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p24_m08);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p24_m08);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_m24_p08);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_m24_p08);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_p08_p24);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_p08_p24);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p08_p24);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p08_p24);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_p24_m08);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_p24_m08);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m24_p08);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m24_p08);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p08_p24);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p08_p24);
+
+  u[0] = _mm256_add_epi32(v[0], v[4]);
+  u[1] = _mm256_add_epi32(v[1], v[5]);
+  u[2] = _mm256_add_epi32(v[2], v[6]);
+  u[3] = _mm256_add_epi32(v[3], v[7]);
+  u[4] = _mm256_sub_epi32(v[0], v[4]);
+  u[5] = _mm256_sub_epi32(v[1], v[5]);
+  u[6] = _mm256_sub_epi32(v[2], v[6]);
+  u[7] = _mm256_sub_epi32(v[3], v[7]);
+  u[8] = _mm256_add_epi32(v[8], v[12]);
+  u[9] = _mm256_add_epi32(v[9], v[13]);
+  u[10] = _mm256_add_epi32(v[10], v[14]);
+  u[11] = _mm256_add_epi32(v[11], v[15]);
+  u[12] = _mm256_sub_epi32(v[8], v[12]);
+  u[13] = _mm256_sub_epi32(v[9], v[13]);
+  u[14] = _mm256_sub_epi32(v[10], v[14]);
+  u[15] = _mm256_sub_epi32(v[11], v[15]);
+
+  u[0] = _mm256_add_epi32(u[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(u[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(u[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(u[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(u[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(u[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(u[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(u[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(u[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(u[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(u[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(u[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(u[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(u[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(u[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(u[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  s[0] = _mm256_add_epi16(x[0], x[2]);
+  s[1] = _mm256_add_epi16(x[1], x[3]);
+  s[2] = _mm256_sub_epi16(x[0], x[2]);
+  s[3] = _mm256_sub_epi16(x[1], x[3]);
+  s[4] = _mm256_packs_epi32(v[0], v[1]);
+  s[5] = _mm256_packs_epi32(v[2], v[3]);
+  s[6] = _mm256_packs_epi32(v[4], v[5]);
+  s[7] = _mm256_packs_epi32(v[6], v[7]);
+  s[8] = _mm256_add_epi16(x[8], x[10]);
+  s[9] = _mm256_add_epi16(x[9], x[11]);
+  s[10] = _mm256_sub_epi16(x[8], x[10]);
+  s[11] = _mm256_sub_epi16(x[9], x[11]);
+  s[12] = _mm256_packs_epi32(v[8], v[9]);
+  s[13] = _mm256_packs_epi32(v[10], v[11]);
+  s[14] = _mm256_packs_epi32(v[12], v[13]);
+  s[15] = _mm256_packs_epi32(v[14], v[15]);
+
+  // stage 4
+  u[0] = _mm256_unpacklo_epi16(s[2], s[3]);
+  u[1] = _mm256_unpackhi_epi16(s[2], s[3]);
+  u[2] = _mm256_unpacklo_epi16(s[6], s[7]);
+  u[3] = _mm256_unpackhi_epi16(s[6], s[7]);
+  u[4] = _mm256_unpacklo_epi16(s[10], s[11]);
+  u[5] = _mm256_unpackhi_epi16(s[10], s[11]);
+  u[6] = _mm256_unpacklo_epi16(s[14], s[15]);
+  u[7] = _mm256_unpackhi_epi16(s[14], s[15]);
+
+  v[0] = _mm256_madd_epi16(u[0], k__cospi_m16_m16);
+  v[1] = _mm256_madd_epi16(u[1], k__cospi_m16_m16);
+  v[2] = _mm256_madd_epi16(u[0], k__cospi_p16_m16);
+  v[3] = _mm256_madd_epi16(u[1], k__cospi_p16_m16);
+  v[4] = _mm256_madd_epi16(u[2], k__cospi_p16_p16);
+  v[5] = _mm256_madd_epi16(u[3], k__cospi_p16_p16);
+  v[6] = _mm256_madd_epi16(u[2], k__cospi_m16_p16);
+  v[7] = _mm256_madd_epi16(u[3], k__cospi_m16_p16);
+  v[8] = _mm256_madd_epi16(u[4], k__cospi_p16_p16);
+  v[9] = _mm256_madd_epi16(u[5], k__cospi_p16_p16);
+  v[10] = _mm256_madd_epi16(u[4], k__cospi_m16_p16);
+  v[11] = _mm256_madd_epi16(u[5], k__cospi_m16_p16);
+  v[12] = _mm256_madd_epi16(u[6], k__cospi_m16_m16);
+  v[13] = _mm256_madd_epi16(u[7], k__cospi_m16_m16);
+  v[14] = _mm256_madd_epi16(u[6], k__cospi_p16_m16);
+  v[15] = _mm256_madd_epi16(u[7], k__cospi_p16_m16);
+
+  u[0] = _mm256_add_epi32(v[0], k__DCT_CONST_ROUNDING);
+  u[1] = _mm256_add_epi32(v[1], k__DCT_CONST_ROUNDING);
+  u[2] = _mm256_add_epi32(v[2], k__DCT_CONST_ROUNDING);
+  u[3] = _mm256_add_epi32(v[3], k__DCT_CONST_ROUNDING);
+  u[4] = _mm256_add_epi32(v[4], k__DCT_CONST_ROUNDING);
+  u[5] = _mm256_add_epi32(v[5], k__DCT_CONST_ROUNDING);
+  u[6] = _mm256_add_epi32(v[6], k__DCT_CONST_ROUNDING);
+  u[7] = _mm256_add_epi32(v[7], k__DCT_CONST_ROUNDING);
+  u[8] = _mm256_add_epi32(v[8], k__DCT_CONST_ROUNDING);
+  u[9] = _mm256_add_epi32(v[9], k__DCT_CONST_ROUNDING);
+  u[10] = _mm256_add_epi32(v[10], k__DCT_CONST_ROUNDING);
+  u[11] = _mm256_add_epi32(v[11], k__DCT_CONST_ROUNDING);
+  u[12] = _mm256_add_epi32(v[12], k__DCT_CONST_ROUNDING);
+  u[13] = _mm256_add_epi32(v[13], k__DCT_CONST_ROUNDING);
+  u[14] = _mm256_add_epi32(v[14], k__DCT_CONST_ROUNDING);
+  u[15] = _mm256_add_epi32(v[15], k__DCT_CONST_ROUNDING);
+
+  v[0] = _mm256_srai_epi32(u[0], DCT_CONST_BITS);
+  v[1] = _mm256_srai_epi32(u[1], DCT_CONST_BITS);
+  v[2] = _mm256_srai_epi32(u[2], DCT_CONST_BITS);
+  v[3] = _mm256_srai_epi32(u[3], DCT_CONST_BITS);
+  v[4] = _mm256_srai_epi32(u[4], DCT_CONST_BITS);
+  v[5] = _mm256_srai_epi32(u[5], DCT_CONST_BITS);
+  v[6] = _mm256_srai_epi32(u[6], DCT_CONST_BITS);
+  v[7] = _mm256_srai_epi32(u[7], DCT_CONST_BITS);
+  v[8] = _mm256_srai_epi32(u[8], DCT_CONST_BITS);
+  v[9] = _mm256_srai_epi32(u[9], DCT_CONST_BITS);
+  v[10] = _mm256_srai_epi32(u[10], DCT_CONST_BITS);
+  v[11] = _mm256_srai_epi32(u[11], DCT_CONST_BITS);
+  v[12] = _mm256_srai_epi32(u[12], DCT_CONST_BITS);
+  v[13] = _mm256_srai_epi32(u[13], DCT_CONST_BITS);
+  v[14] = _mm256_srai_epi32(u[14], DCT_CONST_BITS);
+  v[15] = _mm256_srai_epi32(u[15], DCT_CONST_BITS);
+
+  in[0] = s[0];
+  in[1] = _mm256_sub_epi16(kZero, s[8]);
+  in[2] = s[12];
+  in[3] = _mm256_sub_epi16(kZero, s[4]);
+  in[4] = _mm256_packs_epi32(v[4], v[5]);
+  in[5] = _mm256_packs_epi32(v[12], v[13]);
+  in[6] = _mm256_packs_epi32(v[8], v[9]);
+  in[7] = _mm256_packs_epi32(v[0], v[1]);
+  in[8] = _mm256_packs_epi32(v[2], v[3]);
+  in[9] = _mm256_packs_epi32(v[10], v[11]);
+  in[10] = _mm256_packs_epi32(v[14], v[15]);
+  in[11] = _mm256_packs_epi32(v[6], v[7]);
+  in[12] = s[5];
+  in[13] = _mm256_sub_epi16(kZero, s[13]);
+  in[14] = s[9];
+  in[15] = _mm256_sub_epi16(kZero, s[1]);
+}
+
+static void fdct16_avx2(__m256i *in) {
+  fdct16_16col(in);
+  transpose_16bit_16x16_avx2(in);
+}
+
+static void fadst16_avx2(__m256i *in) {
+  fadst16_16col(in);
+  transpose_16bit_16x16_avx2(in);
+}
+
+void vp9_fht16x16_avx2(const int16_t *input, tran_low_t *output, int stride,
+                       int tx_type) {
+  __m256i in[16];
+
+  switch (tx_type) {
+    case DCT_DCT: vpx_fdct16x16_sse2(input, output, stride); break;
+    case ADST_DCT:
+      load_buffer_16x16(input, in, stride);
+      fadst16_avx2(in);
+      right_shift_16x16(in);
+      fdct16_avx2(in);
+      write_buffer_16x16(output, in);
+      break;
+    case DCT_ADST:
+      load_buffer_16x16(input, in, stride);
+      fdct16_avx2(in);
+      right_shift_16x16(in);
+      fadst16_avx2(in);
+      write_buffer_16x16(output, in);
+      break;
+    default:
+      assert(tx_type == ADST_ADST);
+      load_buffer_16x16(input, in, stride);
+      fadst16_avx2(in);
+      right_shift_16x16(in);
+      fadst16_avx2(in);
+      write_buffer_16x16(output, in);
+      break;
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The high bitdepth transforms hold one coefficient per 64-bit lane, so each
+// register covers four columns. Products and their sums are formed in full 64
+// bits as tran_high_t is in the C code. Between stages only the low 32 bits of
+// a lane are significant: every rounded value fits in them, and both
+// _mm256_mul_epi32() and the final stores only read those bits.
+typedef struct {
+  void (*cols)(__m256i *in);
+  void (*rows)(__m256i *in);
+} highbd_transform_2d;
+
+static INLINE __m256i highbd_mul(__m256i a, int c) {
+  return _mm256_mul_epi32(a, _mm256_set1_epi64x(c));
+}
+
+// a * c0 + b * c1
+static INLINE __m256i highbd_madd(__m256i a, int c0, __m256i b, int c1) {
+  return _mm256_add_epi64(highbd_mul(a, c0), highbd_mul(b, c1));
+}
+
+// A logical shift leaves the same low 32 bits as fdct_round_shift().
+static INLINE __m256i highbd_round_shift(__m256i a) {
+  const __m256i rounding = _mm256_set1_epi64x(DCT_CONST_ROUNDING);
+  return _mm256_srli_epi64(_mm256_add_epi64(a, rounding), DCT_CONST_BITS);
+}
+
+static INLINE __m256i add64(__m256i a, __m256i b) {
+  return _mm256_add_epi64(a, b);
+}
+
+static INLINE __m256i sub64(__m256i a, __m256i b) {
+  return _mm256_sub_epi64(a, b);
+}
+
+static INLINE __m256i neg64(__m256i a) {
+  return _mm256_sub_epi64(_mm256_setzero_si256(), a);
+}
+
+static void highbd_fdct4(__m256i *in) {
+  const __m256i s0 = add64(in[0], in[3]);
+  const __m256i s1 = add64(in[1], in[2]);
+  const __m256i s2 = sub64(in[1], in[2]);
+  const __m256i s3 = sub64(in[0], in[3]);
+
+  in[0] = highbd_round_shift(highbd_mul(add64(s0, s1), cospi_16_64));
+  in[2] = highbd_round_shift(highbd_mul(sub64(s0, s1), cospi_16_64));
+  in[1] = highbd_round_shift(highbd_madd(s2, cospi_24_64, s3, cospi_8_64));
+  in[3] = highbd_round_shift(highbd_madd(s2, -cospi_8_64, s3, cospi_24_64));
+}
+
+static void highbd_fadst4(__m256i *in) {
+  const __m256i s0 = highbd_mul(in[0], sinpi_1_9);
+  const __m256i s1 = highbd_mul(in[0], sinpi_4_9);
+  const __m256i s2 = highbd_mul(in[1], sinpi_2_9);
+  const __m256i s3 = highbd_mul(in[1], sinpi_1_9);
+  const __m256i s4 = highbd_mul(in[2], sinpi_3_9);
+  const __m256i s5 = highbd_mul(in[3], sinpi_4_9);
+  const __m256i s6 = highbd_mul(in[3], sinpi_2_9);
+  const __m256i s7 = sub64(add64(in[0], in[1]), in[3]);
+
+  const __m256i x0 = add64(add64(s0, s2), s5);
+  const __m256i x1 = highbd_mul(s7, sinpi_3_9);
+  const __m256i x2 = add64(sub64(s1, s3), s6);
+  const __m256i x3 = s4;
+
+  in[0] = highbd_round_shift(add64(x0, x3));
+  in[1] = highbd_round_shift(x1);
+  in[2] = highbd_round_shift(sub64(x2, x3));
+  in[3] = highbd_round_shift(add64(sub64(x2, x0), x3));
+}
+
+static void highbd_fdct8(__m256i *in) {
+  __m256i s[8], x[4], t0, t1;
+
+  // stage 1
+  s[0] = add64(in[0], in[7]);
+  s[1] = add64(in[1], in[6]);
+  s[2] = add64(in[2], in[5]);
+  s[3] = add64(in[3], in[4]);
+  s[4] = sub64(in[3], in[4]);
+  s[5] = sub64(in[2], in[5]);
+  s[6] = sub64(in[1], in[6]);
+  s[7] = sub64(in[0], in[7]);
+
+  // fdct4(step, step);
+  x[0] = add64(s[0], s[3]);
+  x[1] = add64(s[1], s[2]);
+  x[2] = sub64(s[1], s[2]);
+  x[3] = sub64(s[0], s[3]);
+  in[0] = highbd_round_shift(highbd_mul(add64(x[0], x[1]), cospi_16_64));
+  in[4] = highbd_round_shift(highbd_mul(sub64(x[0], x[1]), cospi_16_64));
+  in[2] =
+      highbd_round_shift(highbd_madd(x[2], cospi_24_64, x[3], cospi_8_64));
+  in[6] =
+      highbd_round_shift(highbd_madd(x[2], -cospi_8_64, x[3], cospi_24_64));
+
+  // Stage 2
+  t0 = highbd_round_shift(highbd_mul(sub64(s[6], s[5]), cospi_16_64));
+  t1 = highbd_round_shift(highbd_mul(add64(s[6], s[5]), cospi_16_64));
+
+  // Stage 3
+  x[0] = add64(s[4], t0);
+  x[1] = sub64(s[4], t0);
+  x[2] = sub64(s[7], t1);
+  x[3] = add64(s[7], t1);
+
+  // Stage 4
+  in[1] =
+      highbd_round_shift(highbd_madd(x[0], cospi_28_64, x[3], cospi_4_64));
+  in[5] =
+      highbd_round_shift(highbd_madd(x[1], cospi_12_64, x[2], cospi_20_64));
+  in[3] =
+      highbd_round_shift(highbd_madd(x[2], cospi_12_64, x[1], -cospi_20_64));
+  in[7] =
+      highbd_round_shift(highbd_madd(x[3], cospi_28_64, x[0], -cospi_4_64));
+}
+
+static void highbd_fadst8(__m256i *in) {
+  __m256i s[8], x[8];
+
+  // stage 1
+  s[0] = highbd_madd(in[7], cospi_2_64, in[0], cospi_30_64);
+  s[1] = highbd_madd(in[7], cospi_30_64, in[0], -cospi_2_64);
+  s[2] = highbd_madd(in[5], cospi_10_64, in[2], cospi_22_64);
+  s[3] = highbd_madd(in[5], cospi_22_64, in[2], -cospi_10_64);
+  s[4] = highbd_madd(in[3], cospi_18_64, in[4], cospi_14_64);
+  s[5] = highbd_madd(in[3], cospi_14_64, in[4], -cospi_18_64);
+  s[6] = highbd_madd(in[1], cospi_26_64, in[6], cospi_6_64);
+  s[7] = highbd_madd(in[1], cospi_6_64, in[6], -cospi_26_64);
+
+  x[0] = highbd_round_shift(add64(s[0], s[4]));
+  x[1] = highbd_round_shift(add64(s[1], s[5]));
+  x[2] = highbd_round_shift(add64(s[2], s[6]));
+  x[3] = highbd_round_shift(add64(s[3], s[7]));
+  x[4] = highbd_round_shift(sub64(s[0], s[4]));
+  x[5] = highbd_round_shift(sub64(s[1], s[5]));
+  x[6] = highbd_round_shift(sub64(s[2], s[6]));
+  x[7] = highbd_round_shift(sub64(s[3], s[7]));
+
+  // stage 2
+  s[4] = highbd_madd(x[4], cospi_8_64, x[5], cospi_24_64);
+  s[5] = highbd_madd(x[4], cospi_24_64, x[5], -cospi_8_64);
+  s[6] = highbd_madd(x[6], -cospi_24_64, x[7], cospi_8_64);
+  s[7] = highbd_madd(x[6], cospi_8_64, x[7], cospi_24_64);
+
+  s[0] = add64(x[0], x[2]);
+  s[1] = add64(x[1], x[3]);
+  s[2] = sub64(x[0], x[2]);
+  s[3] = sub64(x[1], x[3]);
+  x[4] = highbd_round_shift(add64(s[4], s[6]));
+  x[5] = highbd_round_shift(add64(s[5], s[7]));
+  x[6] = highbd_round_shift(sub64(s[4], s[6]));
+  x[7] = highbd_round_shift(sub64(s[5], s[7]));
+
+  // stage 3
+  x[2] = highbd_round_shift(highbd_mul(add64(s[2], s[3]), cospi_16_64));
+  x[3] = highbd_round_shift(highbd_mul(sub64(s[2], s[3]), cospi_16_64));
+  s[6] = highbd_round_shift(highbd_mul(add64(x[6], x[7]), cospi_16_64));
+  s[7] = highbd_round_shift(highbd_mul(sub64(x[6], x[7]), cospi_16_64));
+
+  in[0] = s[0];
+  in[1] = neg64(x[4]);
+  in[2] = s[6];
+  in[3] = neg64(x[2]);
+  in[4] = x[3];
+  in[5] = neg64(s[7]);
+  in[6] = x[5];
+  in[7] = neg64(s[1]);
+}
+
+static void highbd_fdct16(__m256i *in) {
+  __m256i input[8], step1[8], step2[8], step3[8], s[8], x[4], t0, t1;
+
+  // step 1
+  input[0] = add64(in[0], in[15]);
+  input[1] = add64(in[1], in[14]);
+  input[2] = add64(in[2], in[13]);
+  input[3] = add64(in[3], in[12]);
+  input[4] = add64(in[4], in[11]);
+  input[5] = add64(in[5], in[10]);
+  input[6] = add64(in[6], in[9]);
+  input[7] = add64(in[7], in[8]);
+
+  step1[0] = sub64(in[7], in[8]);
+  step1[1] = sub64(in[6], in[9]);
+  step1[2] = sub64(in[5], in[10]);
+  step1[3] = sub64(in[4], in[11]);
+  step1[4] = sub64(in[3], in[12]);
+  step1[5] = sub64(in[2], in[13]);
+  step1[6] = sub64(in[1], in[14]);
+  step1[7] = sub64(in[0], in[15]);
+
+  // fdct8(step, step);
+  s[0] = add64(input[0], input[7]);
+  s[1] = add64(input[1], input[6]);
+  s[2] = add64(input[2], input[5]);
+  s[3] = add64(input[3], input[4]);
+  s[4] = sub64(input[3], input[4]);
+  s[5] = sub64(input[2], input[5]);
+  s[6] = sub64(input[1], input[6]);
+  s[7] = sub64(input[0], input[7]);
+
+  x[0] = add64(s[0], s[3]);
+  x[1] = add64(s[1], s[2]);
+  x[2] = sub64(s[1], s[2]);
+  x[3] = sub64(s[0], s[3]);
+  in[0] = highbd_round_shift(highbd_mul(add64(x[0], x[1]), cospi_16_64));
+  in[8] = highbd_round_shift(highbd_mul(sub64(x[0], x[1]), cospi_16_64));
+  in[4] =
+      highbd_round_shift(highbd_madd(x[3], cospi_8_64, x[2], cospi_24_64));
+  in[12] =
+      highbd_round_shift(highbd_madd(x[3], cospi_24_64, x[2], -cospi_8_64));
+
+  t0 = highbd_round_shift(highbd_mul(sub64(s[6], s[5]), cospi_16_64));
+  t1 = highbd_round_shift(highbd_mul(add64(s[6], s[5]), cospi_16_64));
+
+  x[0] = add64(s[4], t0);
+  x[1] = sub64(s[4], t0);
+  x[2] = sub64(s[7], t1);
+  x[3] = add64(s[7], t1);
+
+  in[2] =
+      highbd_round_shift(highbd_madd(x[0], cospi_28_64, x[3], cospi_4_64));
+  in[10] =
+      highbd_round_shift(highbd_madd(x[1], cospi_12_64, x[2], cospi_20_64));
+  in[6] =
+      highbd_round_shift(highbd_madd(x[2], cospi_12_64, x[1], -cospi_20_64));
+  in[14] =
+      highbd_round_shift(highbd_madd(x[3], cospi_28_64, x[0], -cospi_4_64));
+
+  // step 2
+  step2[2] = highbd_round_shift(
+      highbd_mul(sub64(step1[5], step1[2]), cospi_16_64));
+  step2[3] = highbd_round_shift(
+      highbd_mul(sub64(step1[4], step1[3]), cospi_16_64));
+  step2[4] = highbd_round_shift(
+      highbd_mul(add64(step1[4], step1[3]), cospi_16_64));
+  step2[5] = highbd_round_shift(
+      highbd_mul(add64(step1[5], step1[2]), cospi_16_64));
+
+  // step 3
+  step3[0] = add64(step1[0], step2[3]);
+  step3[1] = add64(step1[1], step2[2]);
+  step3[2] = sub64(step1[1], step2[2]);
+  step3[3] = sub64(step1[0], step2[3]);
+  step3[4] = sub64(step1[7], step2[4]);
+  step3[5] = sub64(step1[6], step2[5]);
+  step3[6] = add64(step1[6], step2[5]);
+  step3[7] = add64(step1[7], step2[4]);
+
+  // step 4
+  step2[1] = highbd_round_shift(
+      highbd_madd(step3[1], -cospi_8_64, step3[6], cospi_24_64));
+  step2[2] = highbd_round_shift(
+      highbd_madd(step3[2], cospi_24_64, step3[5], cospi_8_64));
+  step2[5] = highbd_round_shift(
+      highbd_madd(step3[2], cospi_8_64, step3[5], -cospi_24_64));
+  step2[6] = highbd_round_shift(
+      highbd_madd(step3[1], cospi_24_64, step3[6], cospi_8_64));
+
+  // step 5
+  step1[0] = add64(step3[0], step2[1]);
+  step1[1] = sub64(step3[0], step2[1]);
+  step1[2] = add64(step3[3], step2[2]);
+  step1[3] = sub64(step3[3], step2[2]);
+  step1[4] = sub64(step3[4], step2[5]);
+  step1[5] = add64(step3[4], step2[5]);
+  step1[6] = sub64(step3[7], step2[6]);
+  step1[7] = add64(step3[7], step2[6]);
+
+  // step 6
+  in[1] = highbd_round_shift(
+      highbd_madd(step1[0], cospi_30_64, step1[7], cospi_2_64));
+  in[9] = highbd_round_shift(
+      highbd_madd(step1[1], cospi_14_64, step1[6], cospi_18_64));
+  in[5] = highbd_round_shift(
+      highbd_madd(step1[2], cospi_22_64, step1[5], cospi_10_64));
+  in[13] = highbd_round_shift(
+      highbd_madd(step1[3], cospi_6_64, step1[4], cospi_26_64));
+  in[3] = highbd_round_shift(
+      highbd_madd(step1[3], -cospi_26_64, step1[4], cospi_6_64));
+  in[11] = highbd_round_shift(
+      highbd_madd(step1[2], -cospi_10_64, step1[5], cospi_22_64));
+  in[7] = highbd_round_shift(
+      highbd_madd(step1[1], -cospi_18_64, step1[6], cospi_14_64));
+  in[15] = highbd_round_shift(
+      highbd_madd(step1[0], -cospi_2_64, step1[7], cospi_30_64));
+}
+
+static void highbd_fadst16(__m256i *in) {
+  __m256i s[16], x[16], y[16];
+
+  // stage 1
+  s[0] = highbd_madd(in[15], cospi_1_64, in[0], cospi_31_64);
+  s[1] = highbd_madd(in[15], cospi_31_64, in[0], -cospi_1_64);
+  s[2] = highbd_madd(in[13], cospi_5_64, in[2], cospi_27_64);
+  s[3] = highbd_madd(in[13], cospi_27_64, in[2], -cospi_5_64);
+  s[4] = highbd_madd(in[11], cospi_9_64, in[4], cospi_23_64);
+  s[5] = highbd_madd(in[11], cospi_23_64, in[4], -cospi_9_64);
+  s[6] = highbd_madd(in[9], cospi_13_64, in[6], cospi_19_64);
+  s[7] = highbd_madd(in[9], cospi_19_64, in[6], -cospi_13_64);
+  s[8] = highbd_madd(in[7], cospi_17_64, in[8], cospi_15_64);
+  s[9] = highbd_madd(in[7], cospi_15_64, in[8], -cospi_17_64);
+  s[10] = highbd_madd(in[5], cospi_21_64, in[10], cospi_11_64);
+  s[11] = highbd_madd(in[5], cospi_11_64, in[10], -cospi_21_64);
+  s[12] = highbd_madd(in[3], cospi_25_64, in[12], cospi_7_64);
+  s[13] = highbd_madd(in[3], cospi_7_64, in[12], -cospi_25_64);
+  s[14] = highbd_madd(in[1], cospi_29_64, in[14], cospi_3_64);
+  s[15] = highbd_madd(in[1], cospi_3_64, in[14], -cospi_29_64);
+
+  x[0] = highbd_round_shift(add64(s[0], s[8]));
+  x[1] = highbd_round_shift(add64(s[1], s[9]));
+  x[2] = highbd_round_shift(add64(s[2], s[10]));
+  x[3] = highbd_round_shift(add64(s[3], s[11]));
+  x[4] = highbd_round_shift(add64(s[4], s[12]));
+  x[5] = highbd_round_shift(add64(s[5], s[13]));
+  x[6] = highbd_round_shift(add64(s[6], s[14]));
+  x[7] = highbd_round_shift(add64(s[7], s[15]));
+  x[8] = highbd_round_shift(sub64(s[0], s[8]));
+  x[9] = highbd_round_shift(sub64(s[1], s[9]));
+  x[10] = highbd_round_shift(sub64(s[2], s[10]));
+  x[11] = highbd_round_shift(sub64(s[3], s[11]));
+  x[12] = highbd_round_shift(sub64(s[4], s[12]));
+  x[13] = highbd_round_shift(sub64(s[5], s[13]));
+  x[14] = highbd_round_shift(sub64(s[6], s[14]));
+  x[15] = highbd_round_shift(sub64(s[7], s[15]));
+
+  // stage 2
+  s[8] = highbd_madd(x[8], cospi_4_64, x[9], cospi_28_64);
+  s[9] = highbd_madd(x[8], cospi_28_64, x[9], -cospi_4_64);
+  s[10] = highbd_madd(x[10], cospi_20_64, x[11], cospi_12_64);
+  s[11] = highbd_madd(x[10], cospi_12_64, x[11], -cospi_20_64);
+  s[12] = highbd_madd(x[12], -cospi_28_64, x[13], cospi_4_64);
+  s[13] = highbd_madd(x[12], cospi_4_64, x[13], cospi_28_64);
+  s[14] = highbd_madd(x[14], -cospi_12_64, x[15], cospi_20_64);
+  s[15] = highbd_madd(x[14], cospi_20_64, x[15], cospi_12_64);
+
+  y[0] = add64(x[0], x[4]);
+  y[1] = add64(x[1], x[5]);
+  y[2] = add64(x[2], x[6]);
+  y[3] = add64(x[3], x[7]);
+  y[4] = sub64(x[0], x[4]);
+  y[5] = sub64(x[1], x[5]);
+  y[6] = sub64(x[2], x[6]);
+  y[7] = sub64(x[3], x[7]);
+  y[8] = highbd_round_shift(add64(s[8], s[12]));
+  y[9] = highbd_round_shift(add64(s[9], s[13]));
+  y[10] = highbd_round_shift(add64(s[10], s[14]));
+  y[11] = highbd_round_shift(add64(s[11], s[15]));
+  y[12] = highbd_round_shift(sub64(s[8], s[12]));
+  y[13] = highbd_round_shift(sub64(s[9], s[13]));
+  y[14] = highbd_round_shift(sub64(s[10], s[14]));
+  y[15] = highbd_round_shift(sub64(s[11], s[15]));
+
+  // stage 3
+  s[4] = highbd_madd(y[4], cospi_8_64, y[5], cospi_24_64);
+  s[5] = highbd_madd(y[4], cospi_24_64, y[5], -cospi_8_64);
+  s[6] = highbd_madd(y[6], -cospi_24_64, y[7], cospi_8_64);
+  s[7] = highbd_madd(y[6], cospi_8_64, y[7], cospi_24_64);
+  s[12] = highbd_madd(y[12], cospi_8_64, y[13], cospi_24_64);
+  s[13] = highbd_madd(y[12], cospi_24_64, y[13], -cospi_8_64);
+  s[14] = highbd_madd(y[14], -cospi_24_64, y[15], cospi_8_64);
+  s[15] = highbd_madd(y[14], cospi_8_64, y[15], cospi_24_64);
+
+  x[0] = add64(y[0], y[2]);
+  x[1] = add64(y[1], y[3]);
+  x[2] = sub64(y[0], y[2]);
+  x[3] = sub64(y[1], y[3]);
+  x[4] = highbd_round_shift(add64(s[4], s[6]));
+  x[5] = highbd_round_shift(add64(s[5], s[7]));
+  x[6] = highbd_round_shift(sub64(s[4], s[6]));
+  x[7] = highbd_round_shift(sub64(s[5], s[7]));
+  x[8] = add64(y[8], y[10]);
+  x[9] = add64(y[9], y[11]);
+  x[10] = sub64(y[8], y[10]);
+  x[11] = sub64(y[9], y[11]);
+  x[12] = highbd_round_shift(add64(s[12], s[14]));
+  x[13] = highbd_round_shift(add64(s[13], s[15]));
+  x[14] = highbd_round_shift(sub64(s[12], s[14]));
+  x[15] = highbd_round_shift(sub64(s[13], s[15]));
+
+  // stage 4
+  in[0] = x[0];
+  in[1] = neg64(x[8]);
+  in[2] = x[12];
+  in[3] = neg64(x[4]);
+  in[4] = highbd_round_shift(highbd_mul(add64(x[6], x[7]), cospi_16_64));
+  in[5] = highbd_round_shift(highbd_mul(add64(x[14], x[15]), -cospi_16_64));
+  in[6] = highbd_round_shift(highbd_mul(add64(x[10], x[11]), cospi_16_64));
+  in[7] = highbd_round_shift(highbd_mul(add64(x[2], x[3]), -cospi_16_64));
+  in[8] = highbd_round_shift(highbd_mul(sub64(x[2], x[3]), cospi_16_64));
+  in[9] = highbd_round_shift(highbd_mul(sub64(x[11], x[10]), cospi_16_64));
+  in[10] = highbd_round_shift(highbd_mul(sub64(x[14], x[15]), cospi_16_64));
+  in[11] = highbd_round_shift(highbd_mul(sub64(x[7], x[6]), cospi_16_64));
+  in[12] = x[5];
+  in[13] = neg64(x[13]);
+  in[14] = x[9];
+  in[15] = neg64(x[1]);
+}
+
+static INLINE void highbd_load_buffer(const int16_t *input, int stride,
+                                      __m256i *in, int size, int shift) {
+  const int groups = size >> 2;
+  int r, c;
+  for (r = 0; r < size; ++r) {
+    for (c = 0; c < groups; ++c) {
+      const __m128i v =
+          _mm_loadl_epi64((const __m128i *)(input + r * stride + 4 * c));
+      in[r * groups + c] = _mm256_slli_epi64(_mm256_cvtepi16_epi64(v), shift);
+    }
+  }
+}
+
+static INLINE void highbd_write_buffer(tran_low_t *output, const __m256i *in,
+                                       int size) {
+  const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  const int count = size * size >> 2;
+  int i;
+  for (i = 0; i < count; ++i) {
+    const __m256i v = _mm256_permutevar8x32_epi32(in[i], pack);
+    _mm_storeu_si128((__m128i *)(output + 4 * i), _mm256_castsi256_si128(v));
+  }
+}
+
+// Transposes a size x size block stored as rows of size / 4 registers.
+static INLINE void highbd_transpose(__m256i *in, int size) {
+  const int groups = size >> 2;
+  __m256i out[64];
+  int r, c;
+  for (r = 0; r < groups; ++r) {
+    for (c = 0; c < groups; ++c) {
+      const __m256i *const a = in + 4 * r * groups + c;
+      __m256i *const b = out + 4 * c * groups + r;
+      const __m256i t0 = _mm256_unpacklo_epi64(a[0], a[groups]);
+      const __m256i t1 = _mm256_unpackhi_epi64(a[0], a[groups]);
+      const __m256i t2 = _mm256_unpacklo_epi64(a[2 * groups], a[3 * groups]);
+      const __m256i t3 = _mm256_unpackhi_epi64(a[2 * groups], a[3 * groups]);
+      b[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+      b[groups] = _mm256_permute2x128_si256(t1, t3, 0x20);
+      b[2 * groups] = _mm256_permute2x128_si256(t0, t2, 0x31);
+      b[3 * groups] = _mm256_permute2x128_si256(t1, t3, 0x31);
+    }
+  }
+  memcpy(in, out, size * groups * sizeof(*in));
+}
+
+// Applies txfm down each group of four columns, then transposes.
+static INLINE void highbd_fht_pass(__m256i *in, int size,
+                                   void (*txfm)(__m256i *in)) {
+  const int groups = size >> 2;
+  __m256i col[16];
+  int r, c;
+  for (c = 0; c < groups; ++c) {
+    for (r = 0; r < size; ++r) col[r] = in[r * groups + c];
+    txfm(col);
+    for (r = 0; r < size; ++r) in[r * groups + c] = col[r];
+  }
+  highbd_transpose(in, size);
+}
+
+static const highbd_transform_2d HIGHBD_FHT_4[] = {
+  { highbd_fdct4, highbd_fdct4 },   // DCT_DCT  = 0
+  { highbd_fadst4, highbd_fdct4 },  // ADST_DCT = 1
+  { highbd_fdct4, highbd_fadst4 },  // DCT_ADST = 2
+  { highbd_fadst4, highbd_fadst4 }  // ADST_ADST = 3
+};
+
+static const highbd_transform_2d HIGHBD_FHT_8[] = {
+  { highbd_fdct8, highbd_fdct8 },   // DCT_DCT  = 0
+  { highbd_fadst8, highbd_fdct8 },  // ADST_DCT = 1
+  { highbd_fdct8, highbd_fadst8 },  // DCT_ADST = 2
+  { highbd_fadst8, highbd_fadst8 }  // ADST_ADST = 3
+};
+
+static const highbd_transform_2d HIGHBD_FHT_16[] = {
+  { highbd_fdct16, highbd_fdct16 },   // DCT_DCT  = 0
+  { highbd_fadst16, highbd_fdct16 },  // ADST_DCT = 1
+  { highbd_fdct16, highbd_fadst16 },  // DCT_ADST = 2
+  { highbd_fadst16, highbd_fadst16 }  // ADST_ADST = 3
+};
+
+void vp9_highbd_fht4x4_avx2(const int16_t *input, tran_low_t *output,
+                            int stride, int tx_type) {
+  if (tx_type == DCT_DCT) {
+    vpx_highbd_fdct4x4_sse2(input, output, stride);
+  } else {
+    const highbd_transform_2d ht = HIGHBD_FHT_4[tx_type];
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i first = _mm256_setr_epi64x(1, 0, 0, 0);
+    __m256i in[4];
+    int i;
+
+    highbd_load_buffer(input, stride, in, 4, 4);
+    // The C code adds 1 to a nonzero top left input.
+    in[0] = _mm256_add_epi64(
+        in[0], _mm256_andnot_si256(_mm256_cmpeq_epi64(in[0], zero), first));
+    highbd_fht_pass(in, 4, ht.cols);
+    highbd_fht_pass(in, 4, ht.rows);
+    // (x + 1) >> 2
+    for (i = 0; i < 4; ++i)
+      in[i] = _mm256_srai_epi32(_mm256_add_epi32(in[i], one), 2);
+    highbd_write_buffer(output, in, 4);
+  }
+}
+
+void vp9_highbd_fht8x8_avx2(const int16_t *input, tran_low_t *output,
+                            int stride, int tx_type) {
+  if (tx_type == DCT_DCT) {
+    vpx_highbd_fdct8x8_sse2(input, output, stride);
+  } else {
+    const highbd_transform_2d ht = HIGHBD_FHT_8[tx_type];
+    __m256i in[16];
+    int i;
+
+    highbd_load_buffer(input, stride, in, 8, 2);
+    highbd_fht_pass(in, 8, ht.cols);
+    highbd_fht_pass(in, 8, ht.rows);
+    // (x + (x < 0)) >> 1
+    for (i = 0; i < 16; ++i) {
+      const __m256i sign = _mm256_srai_epi32(in[i], 31);
+      in[i] = _mm256_srai_epi32(_mm256_sub_epi32(in[i], sign), 1);
+    }
+    highbd_write_buffer(output, in, 8);
+  }
+}
+
+void vp9_highbd_fht16x16_avx2(const int16_t *input, tran_low_t *output,
+                              int stride, int tx_type) {
+  if (tx_type == DCT_DCT) {
+    vpx_highbd_fdct16x16_sse2(input, output, stride);
+  } else {
+    const highbd_transform_2d ht = HIGHBD_FHT_16[tx_type];
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i in[64];
+    int i;
+
+    highbd_load_buffer(input, stride, in, 16, 2);
+    highbd_fht_pass(in, 16, ht.cols);
+    // (x + 1 + (x < 0)) >> 2
+    for (i = 0; i < 64; ++i) {
+      const __m256i sign = _mm256_srai_epi32(in[i], 31);
+      in[i] = _mm256_sub_epi32(_mm256_add_epi32(in[i], one), sign);
+      in[i] = _mm256_srai_epi32(in[i], 2);
+    }
+    highbd_fht_pass(in, 16, ht.rows);
+    highbd_write_buffer(output, in, 16);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
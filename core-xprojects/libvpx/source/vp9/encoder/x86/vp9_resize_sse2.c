@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+
+#define FILTER_BITS 7
+
+#define INTERP_TAPS 8
+// The resize filters have 32 phases, not the 16 of vpx_filter.h.
+#undef SUBPEL_BITS
+#undef SUBPEL_MASK
+#define SUBPEL_BITS 5
+#define SUBPEL_MASK ((1 << SUBPEL_BITS) - 1)
+#define INTERP_PRECISION_BITS 32
+
+static INLINE const int16_t *get_filter(const int16_t *filters, int64_t pos) {
+  return filters +
+         ((pos >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK) *
+             INTERP_TAPS;
+}
+
+static INLINE int64_t get_offset(int64_t pos) {
+  return (pos >> INTERP_PRECISION_BITS) - INTERP_TAPS / 2 + 1;
+}
+
+// Adds up the four lanes of each of a0..a3 into the lanes of the result.
+static INLINE __m128i hadd_4x4_epi32(const __m128i a0, const __m128i a1,
+                                     const __m128i a2, const __m128i a3) {
+  const __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(a0, a1),
+                                    _mm_unpackhi_epi32(a0, a1));
+  const __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(a2, a3),
+                                    _mm_unpackhi_epi32(a2, a3));
+  return _mm_add_epi32(_mm_unpacklo_epi64(s01, s23),
+                       _mm_unpackhi_epi64(s01, s23));
+}
+
+static INLINE __m128i round_shift_epi32(const __m128i sum) {
+  const __m128i rounding = _mm_set1_epi32(1 << (FILTER_BITS - 1));
+  return _mm_srai_epi32(_mm_add_epi32(sum, rounding), FILTER_BITS);
+}
+
+// The 8-tap dot products of four 16-bit pixel vectors with their filters.
+static INLINE __m128i filter_4x8(const __m128i *const s,
+                                 const int16_t *const *const f) {
+  const __m128i a0 =
+      _mm_madd_epi16(s[0], _mm_loadu_si128((const __m128i *)f[0]));
+  const __m128i a1 =
+      _mm_madd_epi16(s[1], _mm_loadu_si128((const __m128i *)f[1]));
+  const __m128i a2 =
+      _mm_madd_epi16(s[2], _mm_loadu_si128((const __m128i *)f[2]));
+  const __m128i a3 =
+      _mm_madd_epi16(s[3], _mm_loadu_si128((const __m128i *)f[3]));
+  return round_shift_epi32(hadd_4x4_epi32(a0, a1, a2, a3));
+}
+
+static INLINE __m128i madd_rows_lo(const __m128i r0, const __m128i r1,
+                                   const __m128i taps) {
+  return _mm_madd_epi16(_mm_unpacklo_epi16(r0, r1), taps);
+}
+
+static INLINE __m128i madd_rows_hi(const __m128i r0, const __m128i r1,
+                                   const __m128i taps) {
+  return _mm_madd_epi16(_mm_unpackhi_epi16(r0, r1), taps);
+}
+
+// Sums the eight rows of 16-bit pixels r[] with the taps in f, giving the
+// rounded results for pixels 0-3 in *lo and 4-7 in *hi.
+static INLINE void filter_8x8_vert(const __m128i *const r, const __m128i f,
+                                   __m128i *lo, __m128i *hi) {
+  // Each holds the pair of taps 2 * i and 2 * i + 1 in every 32-bit lane.
+  const __m128i t0 = _mm_shuffle_epi32(f, 0x00);
+  const __m128i t1 = _mm_shuffle_epi32(f, 0x55);
+  const __m128i t2 = _mm_shuffle_epi32(f, 0xaa);
+  const __m128i t3 = _mm_shuffle_epi32(f, 0xff);
+  const __m128i lo01 = _mm_add_epi32(madd_rows_lo(r[0], r[1], t0),
+                                     madd_rows_lo(r[2], r[3], t1));
+  const __m128i lo23 = _mm_add_epi32(madd_rows_lo(r[4], r[5], t2),
+                                     madd_rows_lo(r[6], r[7], t3));
+  const __m128i hi01 = _mm_add_epi32(madd_rows_hi(r[0], r[1], t0),
+                                     madd_rows_hi(r[2], r[3], t1));
+  const __m128i hi23 = _mm_add_epi32(madd_rows_hi(r[4], r[5], t2),
+                                     madd_rows_hi(r[6], r[7], t3));
+  *lo = round_shift_epi32(_mm_add_epi32(lo01, lo23));
+  *hi = round_shift_epi32(_mm_add_epi32(hi01, hi23));
+}
+
+void vp9_resize_horz_8tap_sse2(const uint8_t *src, uint8_t *dst, int w,
+                               int64_t pos, int64_t step,
+                               const int16_t *filters) {
+  const __m128i zero = _mm_setzero_si128();
+  int x = 0;
+  for (; x + 4 <= w; x += 4) {
+    __m128i s[4];
+    const int16_t *f[4];
+    __m128i res;
+    int i;
+    for (i = 0; i < 4; ++i, pos += step) {
+      s[i] = _mm_unpacklo_epi8(
+          _mm_loadl_epi64((const __m128i *)(src + get_offset(pos))), zero);
+      f[i] = get_filter(filters, pos);
+    }
+    res = filter_4x8(s, f);
+    res = _mm_packs_epi32(res, res);
+    res = _mm_packus_epi16(res, res);
+    storeu_uint32(dst + x, (uint32_t)_mm_cvtsi128_si32(res));
+  }
+  if (x < w) vp9_resize_horz_8tap_c(src, dst + x, w - x, pos, step, filters);
+}
+
+void vp9_resize_vert_8tap_sse2(const uint8_t *const *src, uint8_t *dst, int w,
+                               const int16_t *filter) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i f = _mm_loadu_si128((const __m128i *)filter);
+  int x = 0;
+  for (; x + 8 <= w; x += 8) {
+    __m128i r[INTERP_TAPS], lo, hi, res;
+    int k;
+    for (k = 0; k < INTERP_TAPS; ++k) {
+      r[k] = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src[k] + x)),
+                               zero);
+    }
+    filter_8x8_vert(r, f, &lo, &hi);
+    res = _mm_packs_epi32(lo, hi);
+    res = _mm_packus_epi16(res, res);
+    _mm_storel_epi64((__m128i *)(dst + x), res);
+  }
+  if (x < w) {
+    const uint8_t *rows[INTERP_TAPS];
+    int k;
+    for (k = 0; k < INTERP_TAPS; ++k) rows[k] = src[k] + x;
+    vp9_resize_vert_8tap_c(rows, dst + x, w - x, filter);
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static INLINE __m128i highbd_clamp_epi16(const __m128i v, const int bd) {
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  return _mm_min_epi16(_mm_max_epi16(v, _mm_setzero_si128()), max);
+}
+
+void vp9_highbd_resize_horz_8tap_sse2(const uint16_t *src, uint16_t *dst,
+                                      int w, int64_t pos, int64_t step,
+                                      const int16_t *filters, int bd) {
+  int x = 0;
+  for (; x + 4 <= w; x += 4) {
+    __m128i s[4];
+    const int16_t *f[4];
+    __m128i res;
+    int i;
+    for (i = 0; i < 4; ++i, pos += step) {
+      s[i] = _mm_loadu_si128((const __m128i *)(src + get_offset(pos)));
+      f[i] = get_filter(filters, pos);
+    }
+    res = filter_4x8(s, f);
+    res = highbd_clamp_epi16(_mm_packs_epi32(res, res), bd);
+    _mm_storel_epi64((__m128i *)(dst + x), res);
+  }
+  if (x < w) {
+    vp9_highbd_resize_horz_8tap_c(src, dst + x, w - x, pos, step, filters,
+                                  bd);
+  }
+}
+
+void vp9_highbd_resize_vert_8tap_sse2(const uint16_t *const *src,
+                                      uint16_t *dst, int w,
+                                      const int16_t *filter, int bd) {
+  const __m128i f = _mm_loadu_si128((const __m128i *)filter);
+  int x = 0;
+  for (; x + 8 <= w; x += 8) {
+    __m128i r[INTERP_TAPS], lo, hi, res;
+    int k;
+    for (k = 0; k < INTERP_TAPS; ++k) {
+      r[k] = _mm_loadu_si128((const __m128i *)(src[k] + x));
+    }
+    filter_8x8_vert(r, f, &lo, &hi);
+    res = highbd_clamp_epi16(_mm_packs_epi32(lo, hi), bd);
+    _mm_storeu_si128((__m128i *)(dst + x), res);
+  }
+  if (x < w) {
+    const uint16_t *rows[INTERP_TAPS];
+    int k;
+    for (k = 0; k < INTERP_TAPS; ++k) rows[k] = src[k] + x;
+    vp9_highbd_resize_vert_8tap_c(rows, dst + x, w - x, filter, bd);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -63,6 +63,10 @@ typedef struct vp9_extracfg {
   unsigned int row_mt;
   unsigned int motion_vector_unit_test;
   int delta_q_uv;
+  unsigned int pyramid_me;
+  unsigned int frame_time_budget;
+  unsigned int scene_cut_key_frame;
+  unsigned int async_psnr;
 } vp9_extracfg;
 
 static struct vp9_extracfg default_extra_cfg = {
@@ -98,6 +102,10 @@ static struct vp9_extracfg default_extra_cfg = {
   0,                     // row_mt
   0,                     // motion_vector_unit_test
   0,                     // delta_q_uv
+  0,                     // pyramid_me
+  0,                     // frame_time_budget
+  0,                     // scene_cut_key_frame
+  0,                     // async_psnr
 };
 
 struct vpx_codec_alg_priv {
@@ -261,6 +269,9 @@ static vpx_codec_err_t validate_config(vpx_codec_alg_priv_t *ctx,
         "or kf_max_dist instead.");
 
   RANGE_CHECK(extra_cfg, row_mt, 0, 1);
+  RANGE_CHECK(extra_cfg, pyramid_me, 0, 1);
+  RANGE_CHECK(extra_cfg, async_psnr, 0, 1);
+  RANGE_CHECK(extra_cfg, scene_cut_key_frame, 0, 1);
   RANGE_CHECK(extra_cfg, motion_vector_unit_test, 0, 2);
   RANGE_CHECK(extra_cfg, enable_auto_alt_ref, 0, MAX_ARF_LAYERS);
   RANGE_CHECK(extra_cfg, cpu_used, -9, 9);
@@ -598,6 +609,10 @@ static vpx_codec_err_t set_encoder_config(
   oxcf->tile_columns = extra_cfg->tile_columns;
 
   oxcf->enable_tpl_model = extra_cfg->enable_tpl_model;
+  oxcf->pyramid_me = extra_cfg->pyramid_me;
+  oxcf->frame_time_budget = extra_cfg->frame_time_budget;
+  oxcf->scene_cut_key_frame = extra_cfg->scene_cut_key_frame;
+  oxcf->async_psnr = extra_cfg->async_psnr;
 
   // TODO(yunqing): The dependencies between row tiles cause error in multi-
   // threaded encoding. For now, tile_rows is forced to be 0 in this case.
@@ -1073,6 +1088,19 @@ static vpx_codec_err_t ctrl_get_level(vpx_codec_alg_priv_t *ctx, va_list args) {
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_get_arena_stats(vpx_codec_alg_priv_t *ctx,
+                                            va_list args) {
+  vpx_arena_stats_t *const stats = va_arg(args, vpx_arena_stats_t *);
+  const VP9ArenaStats *const seq = &ctx->cpi->seq_arena.stats;
+  const VP9ArenaStats *const frame = &ctx->cpi->frame_arena.stats;
+  if (stats == NULL) return VPX_CODEC_INVALID_PARAM;
+  stats->heap_allocs = seq->heap_allocs + frame->heap_allocs;
+  stats->heap_bytes = seq->heap_bytes + frame->heap_bytes;
+  stats->arena_allocs = seq->allocs + frame->allocs;
+  stats->arena_bytes = seq->bytes + frame->bytes;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
                                     vpx_codec_priv_enc_mr_cfg_t *data) {
   vpx_codec_err_t res = VPX_CODEC_OK;
@@ -1427,6 +1455,12 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
           // TODO(angiebird): Figure out while we don't need psnr pkt when
           // use_svc is on
           PSNR_STATS psnr;
+          // The PSNR of the frame before VP9E_SET_ASYNC_PSNR was turned off
+          // comes first.
+          if (!cpi->oxcf.async_psnr && vp9_flush_psnr(cpi, &psnr)) {
+            vpx_codec_cx_pkt_t psnr_pkt = get_psnr_pkt(&psnr);
+            vpx_codec_pkt_list_add(&ctx->pkt_list.head, &psnr_pkt);
+          }
           if (vp9_get_psnr(cpi, &psnr)) {
             vpx_codec_cx_pkt_t psnr_pkt = get_psnr_pkt(&psnr);
             vpx_codec_pkt_list_add(&ctx->pkt_list.head, &psnr_pkt);
@@ -1520,6 +1554,16 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t *ctx,
           }
         }
       }
+
+      // With VP9E_SET_ASYNC_PSNR, the PSNR of the last frame is still
+      // pending when flushing.
+      if (!img && !cpi->use_svc) {
+        PSNR_STATS psnr;
+        if (vp9_flush_psnr(cpi, &psnr)) {
+          vpx_codec_cx_pkt_t psnr_pkt = get_psnr_pkt(&psnr);
+          vpx_codec_pkt_list_add(&ctx->pkt_list.head, &psnr_pkt);
+        }
+      }
     }
   }
 
@@ -1899,6 +1943,34 @@ static vpx_codec_err_t ctrl_set_disable_overshoot_maxq_cbr(
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_pyramid_me(vpx_codec_alg_priv_t *ctx,
+                                          va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.pyramid_me = CAST(VP9E_SET_PYRAMID_ME, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_frame_time_budget(vpx_codec_alg_priv_t *ctx,
+                                                  va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.frame_time_budget = CAST(VP9E_SET_FRAME_TIME_BUDGET, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_scene_cut_key_frame(vpx_codec_alg_priv_t *ctx,
+                                                    va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.scene_cut_key_frame = CAST(VP9E_SET_SCENE_CUT_KEY_FRAME, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
+static vpx_codec_err_t ctrl_set_async_psnr(vpx_codec_alg_priv_t *ctx,
+                                           va_list args) {
+  struct vp9_extracfg extra_cfg = ctx->extra_cfg;
+  extra_cfg.async_psnr = CAST(VP9E_SET_ASYNC_PSNR, args);
+  return update_extra_cfg(ctx, &extra_cfg);
+}
+
 static vpx_codec_err_t ctrl_set_disable_loopfilter(vpx_codec_alg_priv_t *ctx,
                                                    va_list args) {
   VP9_COMP *const cpi = ctx->cpi;
@@ -1991,6 +2063,10 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_SET_DISABLE_LOOPFILTER, ctrl_set_disable_loopfilter },
   { VP9E_SET_RTC_EXTERNAL_RATECTRL, ctrl_set_rtc_external_ratectrl },
   { VP9E_SET_EXTERNAL_RATE_CONTROL, ctrl_set_external_rate_control },
+  { VP9E_SET_PYRAMID_ME, ctrl_set_pyramid_me },
+  { VP9E_SET_FRAME_TIME_BUDGET, ctrl_set_frame_time_budget },
+  { VP9E_SET_SCENE_CUT_KEY_FRAME, ctrl_set_scene_cut_key_frame },
+  { VP9E_SET_ASYNC_PSNR, ctrl_set_async_psnr },
 
   // Getters
   { VP8E_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -2001,6 +2077,7 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   { VP9E_GET_SVC_LAYER_ID, ctrl_get_svc_layer_id },
   { VP9E_GET_ACTIVEMAP, ctrl_get_active_map },
   { VP9E_GET_LEVEL, ctrl_get_level },
+  { VP9E_GET_ARENA_STATS, ctrl_get_arena_stats },
   { VP9E_GET_SVC_REF_FRAME_CONFIG, ctrl_get_svc_ref_frame_config },
 
   { -1, NULL },
@@ -2295,6 +2372,10 @@ void vp9_dump_encoder_config(const VP9EncoderConfig *oxcf, FILE *fp) {
   DUMP_STRUCT_VALUE(fp, oxcf, tile_rows);
 
   DUMP_STRUCT_VALUE(fp, oxcf, enable_tpl_model);
+  DUMP_STRUCT_VALUE(fp, oxcf, pyramid_me);
+  DUMP_STRUCT_VALUE(fp, oxcf, frame_time_budget);
+  DUMP_STRUCT_VALUE(fp, oxcf, scene_cut_key_frame);
+  DUMP_STRUCT_VALUE(fp, oxcf, async_psnr);
 
   DUMP_STRUCT_VALUE(fp, oxcf, max_threads);
 
@@ -273,6 +273,8 @@ static vpx_codec_err_t init_decoder(vpx_codec_alg_priv_t *ctx) {
   RANGE_CHECK(ctx, lpf_opt, 0, 1);
   ctx->pbi->lpf_mt_opt = ctx->lpf_opt;
 
+  ctx->pbi->skip_non_ref_frames = ctx->skip_non_ref_frames;
+
   // If postprocessing was enabled by the application and a
   // configuration has not been provided, default it.
   if (!ctx->postproc_cfg_set && (ctx->base.init_flags & VPX_CODEC_USE_POSTPROC))
@@ -648,6 +650,17 @@ static vpx_codec_err_t ctrl_set_skip_loop_filter(vpx_codec_alg_priv_t *ctx,
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_skip_non_ref_frames(vpx_codec_alg_priv_t *ctx,
+                                                    va_list args) {
+  ctx->skip_non_ref_frames = va_arg(args, int);
+
+  if (ctx->pbi != NULL) {
+    ctx->pbi->skip_non_ref_frames = ctx->skip_non_ref_frames;
+  }
+
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t ctrl_set_spatial_layer_svc(vpx_codec_alg_priv_t *ctx,
                                                   va_list args) {
   ctx->svc_decoding = 1;
@@ -685,6 +698,7 @@ static vpx_codec_ctrl_fn_map_t decoder_ctrl_maps[] = {
   { VP9_DECODE_SVC_SPATIAL_LAYER, ctrl_set_spatial_layer_svc },
   { VP9D_SET_ROW_MT, ctrl_set_row_mt },
   { VP9D_SET_LOOP_FILTER_OPT, ctrl_enable_lpf_opt },
+  { VP9D_SET_SKIP_NON_REF_FRAMES, ctrl_set_skip_non_ref_frames },
 
   // Getters
   { VPXD_GET_LAST_QUANTIZER, ctrl_get_quantizer },
@@ -0,0 +1,293 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_frame_buffer_pool.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_util/vpx_thread.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_memfd_create)
+#define VPX_FB_POOL_MEMFD 1
+#endif
+#endif
+#ifndef VPX_FB_POOL_MEMFD
+#define VPX_FB_POOL_MEMFD 0
+#endif
+
+#define POOL_ALIGN 32
+
+typedef struct pool_buffer {
+  uint8_t *data;
+  size_t size;
+  int fd;
+  int decoder_ref;
+  int export_ref;
+} pool_buffer;
+
+struct vpx_frame_buffer_pool {
+  pool_buffer *buffers;
+  int num_buffers;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+#endif
+};
+
+static void pool_lock(vpx_frame_buffer_pool_t *pool) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&pool->mutex);
+#else
+  (void)pool;
+#endif
+}
+
+static void pool_unlock(vpx_frame_buffer_pool_t *pool) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&pool->mutex);
+#else
+  (void)pool;
+#endif
+}
+
+static void free_buffer(pool_buffer *buf) {
+#if VPX_FB_POOL_MEMFD
+  if (buf->data != NULL) munmap(buf->data, buf->size);
+  if (buf->fd >= 0) close(buf->fd);
+#else
+  vpx_free(buf->data);
+#endif
+  buf->data = NULL;
+  buf->size = 0;
+  buf->fd = -1;
+}
+
+// Makes |buf| hold at least |min_size| bytes. Newly allocated bytes are zero.
+static int grow_buffer(pool_buffer *buf, size_t min_size) {
+#if VPX_FB_POOL_MEMFD
+  void *data;
+  if (buf->fd < 0) {
+    buf->fd = (int)syscall(SYS_memfd_create, "vpx-frame-buffer", 1U);
+    if (buf->fd < 0) return -1;
+  }
+  // Growing the file keeps the existing contents and zero fills the tail.
+  if (ftruncate(buf->fd, (off_t)min_size) != 0) return -1;
+  data = mmap(NULL, min_size, PROT_READ | PROT_WRITE, MAP_SHARED, buf->fd, 0);
+  if (data == MAP_FAILED) return -1;
+  if (buf->data != NULL) munmap(buf->data, buf->size);
+  buf->data = (uint8_t *)data;
+#else
+  uint8_t *const data = (uint8_t *)vpx_calloc(min_size, 1);
+  if (data == NULL) return -1;
+  vpx_free(buf->data);
+  buf->data = data;
+#endif
+  buf->size = min_size;
+  return 0;
+}
+
+// Returns a free buffer of at least |min_size| bytes, or NULL.
+static pool_buffer *get_free_buffer(vpx_frame_buffer_pool_t *pool,
+                                    size_t min_size) {
+  int i;
+  for (i = 0; i < pool->num_buffers; ++i) {
+    pool_buffer *const buf = &pool->buffers[i];
+    if (buf->decoder_ref || buf->export_ref) continue;
+    if (buf->size < min_size && grow_buffer(buf, min_size)) return NULL;
+    return buf;
+  }
+  return NULL;
+}
+
+static pool_buffer *find_buffer(vpx_frame_buffer_pool_t *pool,
+                                const void *priv) {
+  const pool_buffer *const buf = (const pool_buffer *)priv;
+  if (buf < pool->buffers || buf >= pool->buffers + pool->num_buffers) {
+    return NULL;
+  }
+  return &pool->buffers[buf - pool->buffers];
+}
+
+vpx_frame_buffer_pool_t *vpx_frame_buffer_pool_create(int max_buffers) {
+  int i;
+  vpx_frame_buffer_pool_t *pool;
+  if (max_buffers <= 0) return NULL;
+  pool = (vpx_frame_buffer_pool_t *)vpx_calloc(1, sizeof(*pool));
+  if (pool == NULL) return NULL;
+  pool->buffers =
+      (pool_buffer *)vpx_calloc(max_buffers, sizeof(*pool->buffers));
+  if (pool->buffers == NULL) {
+    vpx_free(pool);
+    return NULL;
+  }
+  pool->num_buffers = max_buffers;
+  for (i = 0; i < max_buffers; ++i) pool->buffers[i].fd = -1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_init(&pool->mutex, NULL);
+#endif
+  return pool;
+}
+
+void vpx_frame_buffer_pool_destroy(vpx_frame_buffer_pool_t *pool) {
+  int i;
+  if (pool == NULL) return;
+  for (i = 0; i < pool->num_buffers; ++i) free_buffer(&pool->buffers[i]);
+#if CONFIG_MULTITHREAD
+  pthread_mutex_destroy(&pool->mutex);
+#endif
+  vpx_free(pool->buffers);
+  vpx_free(pool);
+}
+
+vpx_codec_err_t vpx_frame_buffer_pool_attach(vpx_frame_buffer_pool_t *pool,
+                                             vpx_codec_ctx_t *ctx) {
+  if (pool == NULL) return VPX_CODEC_INVALID_PARAM;
+  return vpx_codec_set_frame_buffer_functions(
+      ctx, vpx_frame_buffer_pool_get, vpx_frame_buffer_pool_release, pool);
+}
+
+int vpx_frame_buffer_pool_get(void *priv, size_t min_size,
+                              vpx_codec_frame_buffer_t *fb) {
+  vpx_frame_buffer_pool_t *const pool = (vpx_frame_buffer_pool_t *)priv;
+  pool_buffer *buf;
+  if (pool == NULL || fb == NULL) return -1;
+
+  pool_lock(pool);
+  buf = get_free_buffer(pool, min_size);
+  if (buf != NULL) buf->decoder_ref = 1;
+  pool_unlock(pool);
+  if (buf == NULL) return -1;
+
+  fb->data = buf->data;
+  fb->size = buf->size;
+  fb->priv = buf;
+  return 0;
+}
+
+int vpx_frame_buffer_pool_release(void *priv, vpx_codec_frame_buffer_t *fb) {
+  vpx_frame_buffer_pool_t *const pool = (vpx_frame_buffer_pool_t *)priv;
+  pool_buffer *buf;
+  if (pool == NULL || fb == NULL) return -1;
+  buf = find_buffer(pool, fb->priv);
+  if (buf == NULL) return -1;
+
+  pool_lock(pool);
+  buf->decoder_ref = 0;
+  pool_unlock(pool);
+  return 0;
+}
+
+static void copy_plane(const uint8_t *src, int src_stride, uint8_t *dst,
+                       int dst_stride, size_t width_in_bytes, int rows) {
+  int y;
+  for (y = 0; y < rows; ++y) {
+    memcpy(dst, src, width_in_bytes);
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+vpx_codec_err_t vpx_frame_buffer_pool_export(vpx_frame_buffer_pool_t *pool,
+                                             const vpx_image_t *img,
+                                             vpx_shared_frame_t *frame) {
+  const int bps = (img != NULL && (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH)) ? 2
+                                                                          : 1;
+  pool_buffer *buf = NULL;
+  int plane;
+
+  if (pool == NULL || img == NULL || frame == NULL) {
+    return VPX_CODEC_INVALID_PARAM;
+  }
+
+  memset(frame, 0, sizeof(*frame));
+  frame->fmt = img->fmt;
+  frame->d_w = img->d_w;
+  frame->d_h = img->d_h;
+  frame->x_chroma_shift = img->x_chroma_shift;
+  frame->y_chroma_shift = img->y_chroma_shift;
+  frame->bit_depth = img->bit_depth;
+
+  pool_lock(pool);
+  if (img->fb_priv != NULL) buf = find_buffer(pool, img->fb_priv);
+
+  if (buf != NULL) {
+    // Decoded in place: describe the planes within the decoder's buffer.
+    for (plane = 0; plane < 3; ++plane) {
+      frame->offset[plane] = (size_t)(img->planes[plane] - buf->data);
+      frame->stride[plane] = img->stride[plane];
+    }
+  } else {
+    // Foreign image (e.g. from VP8): copy the visible area into a free
+    // buffer with a packed, aligned layout.
+    size_t size = 0;
+    for (plane = 0; plane < 3; ++plane) {
+      const int xs = plane ? img->x_chroma_shift : 0;
+      const int ys = plane ? img->y_chroma_shift : 0;
+      const int w = (img->d_w + xs) >> xs;
+      const int h = (img->d_h + ys) >> ys;
+      frame->stride[plane] = (w * bps + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1);
+      frame->offset[plane] = size;
+      size += (size_t)frame->stride[plane] * h;
+    }
+    buf = get_free_buffer(pool, size);
+    if (buf != NULL) {
+      for (plane = 0; plane < 3; ++plane) {
+        const int xs = plane ? img->x_chroma_shift : 0;
+        const int ys = plane ? img->y_chroma_shift : 0;
+        copy_plane(img->planes[plane], img->stride[plane],
+                   buf->data + frame->offset[plane], frame->stride[plane],
+                   (size_t)((img->d_w + xs) >> xs) * bps,
+                   (img->d_h + ys) >> ys);
+      }
+    }
+  }
+
+  if (buf != NULL) {
+    ++buf->export_ref;
+    frame->id = (int)(buf - pool->buffers);
+    frame->fd = buf->fd;
+    frame->size = buf->size;
+  }
+  pool_unlock(pool);
+  return buf != NULL ? VPX_CODEC_OK : VPX_CODEC_MEM_ERROR;
+}
+
+vpx_codec_err_t vpx_frame_buffer_pool_unref(vpx_frame_buffer_pool_t *pool,
+                                            int id) {
+  vpx_codec_err_t res = VPX_CODEC_OK;
+  if (pool == NULL || id < 0 || id >= pool->num_buffers) {
+    return VPX_CODEC_INVALID_PARAM;
+  }
+  pool_lock(pool);
+  if (pool->buffers[id].export_ref > 0) {
+    --pool->buffers[id].export_ref;
+  } else {
+    res = VPX_CODEC_INVALID_PARAM;
+  }
+  pool_unlock(pool);
+  return res;
+}
+
+int vpx_frame_buffer_pool_num_in_use(vpx_frame_buffer_pool_t *pool) {
+  int i, count = 0;
+  if (pool == NULL) return 0;
+  pool_lock(pool);
+  for (i = 0; i < pool->num_buffers; ++i) {
+    count += pool->buffers[i].decoder_ref || pool->buffers[i].export_ref;
+  }
+  pool_unlock(pool);
+  return count;
+}
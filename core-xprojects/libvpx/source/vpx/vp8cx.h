@@ -742,6 +742,116 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP9
    */
   VP9E_GET_LAST_QUANTIZER_SVC_LAYERS,
+
+  /*!\brief Codec control function to enable pyramid motion estimation.
+   *
+   * When enabled, a coarse motion field is estimated once per frame on
+   * downsampled planes and used to seed the per-block motion searches
+   * against LAST_FRAME. This helps content with large, fast motion.
+   *
+   * 0: off (default), 1: on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_PYRAMID_ME,
+
+  /*!\brief Codec control function to set a per-frame encode time budget.
+   *
+   * The value is the target encode time of a frame in microseconds. In one
+   * pass real-time mode with cpu_used of 5 or more, the encoder measures the
+   * time spent on each frame and moves between speeds 5 and 9, starting from
+   * cpu_used, to keep the average encode time within the budget. The output
+   * then depends on the machine load and is not reproducible.
+   *
+   * 0: keep the speed set with VP8E_SET_CPUUSED (default).
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_FRAME_TIME_BUDGET,
+
+  /*!\brief Codec control function to get the statistics of the arenas that
+   * hold the per-sequence and per-frame scratch buffers of the encoder.
+   *
+   * Once the encoder has seen its largest frame, the arenas serve every
+   * frame without calling the heap, so heap_allocs stops increasing.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_ARENA_STATS,
+
+  /*!\brief Codec control function to code scene cuts as key frames in one
+   * pass CBR mode.
+   *
+   * Before the frame type is chosen, the source is compared with the
+   * previous source on a subsampled set of superblocks. When the difference
+   * jumps well above its recent average over most of the picture, as on a
+   * slide change in a screen share, the frame is coded as a key frame rather
+   * than as an inter frame with no useful reference. Scene cut key frames are
+   * at least half a second apart. Not used with spatial or temporal layers.
+   *
+   * 0: off (default), 1: on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_SCENE_CUT_KEY_FRAME,
+
+  /*!\brief Codec control function to encode the resolutions of a
+   * multi-resolution encoder concurrently.
+   *
+   * Each lower resolution is encoded on its own thread and the highest one
+   * on the calling thread. A higher resolution starts as soon as the next
+   * lower one has decided its frame type and references, and reuses its
+   * motion as its macroblock rows complete. vpx_codec_encode() returns once
+   * all resolutions are encoded. The output is the same as when they are
+   * encoded one after another. Set it on every encoder of the group.
+   *
+   * 0: off (default), 1: on.
+   *
+   * Supported in codecs: VP8
+   */
+  VP8E_SET_MULTI_RES_PIPELINE,
+
+  /*!\brief Codec control function to choose the frame quantizer from a size
+   * model instead of recoding.
+   *
+   * In good quality mode, a frame whose size misses its target is normally
+   * encoded again at a new Q, mode decision and motion search included,
+   * until the size fits. With this set, the cost of the coefficient tokens
+   * of each macroblock is measured during the first encode and scaled to
+   * predict the frame size at other Q. The frame is then coded at most once
+   * more, at the predicted Q, with the modes and motion vectors of the first
+   * encode kept and only the residuals quantized again. A change of frame
+   * type still requires a full encode.
+   *
+   * 0: off (default), 1: on.
+   *
+   * Supported in codecs: VP8
+   */
+  VP8E_SET_RECODE_FREE_RC,
+
+  /*!\brief Codec control function to get the number of times frames were
+   * encoded again and the time it took.
+   *
+   * Supported in codecs: VP8
+   */
+  VP8E_GET_RECODE_STATS,
+
+  /*!\brief Codec control function to compute PSNR in the background.
+   *
+   * With VPX_CODEC_USE_PSNR, the PSNR of each shown frame is normally
+   * computed on the calling thread once the frame is coded, split by rows
+   * across the encoder threads when there are several. With this set, it is
+   * computed on a thread of its own while the next frame is coded instead.
+   * The VPX_CODEC_PSNR_PKT of a frame is then returned by the following call
+   * to vpx_codec_encode() that codes a shown frame, ahead of that frame, and
+   * the PSNR of the last frame by the call that flushes the encoder. The
+   * values are the same either way.
+   *
+   * 0: off (default), 1: on.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_ASYNC_PSNR,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -933,6 +1043,32 @@ typedef struct vpx_svc_spatial_layer_sync {
   int base_layer_intra_only; /**< Flag for setting Intra-only frame on base */
 } vpx_svc_spatial_layer_sync_t;
 
+/*!\brief vp9 encoder arena statistics.
+ *
+ * The counters are cumulative over the life of the encoder and cover all of
+ * its arenas.
+ */
+typedef struct vpx_arena_stats {
+  uint64_t heap_allocs;  /**< Number of allocations made from the heap */
+  uint64_t heap_bytes;   /**< Bytes allocated from the heap */
+  uint64_t arena_allocs; /**< Number of allocations served by the arenas */
+  uint64_t arena_bytes;  /**< Bytes served by the arenas */
+} vpx_arena_stats_t;
+
+/*!\brief vp8 encoder recode statistics.
+ *
+ * The counters are cumulative over the life of the encoder. The times cover
+ * the mode decision, transform, quantization and tokenization of the frames,
+ * not the bitstream packing or loop filtering.
+ */
+typedef struct vpx_recode_stats {
+  uint64_t frames;          /**< Number of frames encoded */
+  uint64_t recodes;         /**< Extra encodes that redid the mode decision */
+  uint64_t requantizations; /**< Extra encodes that kept the modes */
+  uint64_t encode_us;       /**< Time spent encoding the frames */
+  uint64_t extra_encode_us; /**< Part of encode_us spent in extra encodes */
+} vpx_recode_stats_t;
+
 /*!\cond */
 /*!\brief VP8 encoder control function parameter type
  *
@@ -1110,6 +1246,30 @@ VPX_CTRL_USE_TYPE(VP9E_SET_RTC_EXTERNAL_RATECTRL, int)
 VPX_CTRL_USE_TYPE(VP9E_SET_EXTERNAL_RATE_CONTROL, vpx_rc_funcs_t *)
 #define VPX_CTRL_VP9E_SET_EXTERNAL_RATE_CONTROL
 
+VPX_CTRL_USE_TYPE(VP9E_SET_PYRAMID_ME, unsigned int)
+#define VPX_CTRL_VP9E_SET_PYRAMID_ME
+
+VPX_CTRL_USE_TYPE(VP9E_SET_FRAME_TIME_BUDGET, unsigned int)
+#define VPX_CTRL_VP9E_SET_FRAME_TIME_BUDGET
+
+VPX_CTRL_USE_TYPE(VP9E_GET_ARENA_STATS, vpx_arena_stats_t *)
+#define VPX_CTRL_VP9E_GET_ARENA_STATS
+
+VPX_CTRL_USE_TYPE(VP9E_SET_SCENE_CUT_KEY_FRAME, unsigned int)
+#define VPX_CTRL_VP9E_SET_SCENE_CUT_KEY_FRAME
+
+VPX_CTRL_USE_TYPE(VP8E_SET_MULTI_RES_PIPELINE, unsigned int)
+#define VPX_CTRL_VP8E_SET_MULTI_RES_PIPELINE
+
+VPX_CTRL_USE_TYPE(VP8E_SET_RECODE_FREE_RC, unsigned int)
+#define VPX_CTRL_VP8E_SET_RECODE_FREE_RC
+
+VPX_CTRL_USE_TYPE(VP8E_GET_RECODE_STATS, vpx_recode_stats_t *)
+#define VPX_CTRL_VP8E_GET_RECODE_STATS
+
+VPX_CTRL_USE_TYPE(VP9E_SET_ASYNC_PSNR, unsigned int)
+#define VPX_CTRL_VP9E_SET_ASYNC_PSNR
+
 /*!\endcond */
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
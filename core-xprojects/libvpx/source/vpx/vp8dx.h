@@ -142,6 +142,21 @@ enum vp8_dec_control_id {
    */
   VP9D_SET_LOOP_FILTER_OPT,
 
+  /*!\brief Codec control function to skip reconstruction of non-reference
+   * frames.
+   *
+   * 0 : off, every frame is reconstructed (default)
+   * 1 : on, frames that refresh no reference buffer are only parsed. They
+   *     still update the entropy contexts and motion vector state so the
+   *     following frames decode exactly, but produce no output image.
+   *
+   * Intended for seeking: enable it while decoding from the preceding
+   * keyframe up to the target frame, then disable it.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9D_SET_SKIP_NON_REF_FRAMES,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -199,6 +214,8 @@ VPX_CTRL_USE_TYPE(VP9_SET_SKIP_LOOP_FILTER, int)
 VPX_CTRL_USE_TYPE(VP9D_SET_ROW_MT, int)
 #define VPX_CTRL_VP9_SET_LOOP_FILTER_OPT
 VPX_CTRL_USE_TYPE(VP9D_SET_LOOP_FILTER_OPT, int)
+#define VPX_CTRL_VP9D_SET_SKIP_NON_REF_FRAMES
+VPX_CTRL_USE_TYPE(VP9D_SET_SKIP_NON_REF_FRAMES, int)
 
 /*!\endcond */
 /*! @} - end defgroup vp8_decoder */
@@ -26,6 +26,7 @@ API_DOC_SRCS-yes += vpx_decoder.h
 API_DOC_SRCS-yes += vpx_encoder.h
 API_DOC_SRCS-yes += vpx_ext_ratectrl.h
 API_DOC_SRCS-yes += vpx_frame_buffer.h
+API_DOC_SRCS-yes += vpx_frame_buffer_pool.h
 API_DOC_SRCS-yes += vpx_image.h
 
 API_SRCS-yes += src/vpx_decoder.c
@@ -38,6 +39,8 @@ API_SRCS-yes += src/vpx_image.c
 API_SRCS-yes += vpx_codec.h
 API_SRCS-yes += vpx_codec.mk
 API_SRCS-yes += vpx_frame_buffer.h
+API_SRCS-yes += vpx_frame_buffer_pool.h
+API_SRCS-yes += src/vpx_frame_buffer_pool.c
 API_SRCS-yes += vpx_image.h
 API_SRCS-yes += vpx_integer.h
 API_SRCS-yes += vpx_ext_ratectrl.h
@@ -25,7 +25,7 @@ extern "C" {
  * types, removing or reassigning enums, adding/removing/rearranging
  * fields to structures.
  */
-#define VPX_EXT_RATECTRL_ABI_VERSION (1)
+#define VPX_EXT_RATECTRL_ABI_VERSION (2)
 
 /*!\brief Abstract rate control model handler
  *
@@ -91,6 +91,23 @@ typedef struct vpx_rc_encodeframe_result {
   int actual_encoding_qindex; /**< the actual qindex used to encode the frame*/
 } vpx_rc_encodeframe_result_t;
 
+/*!\brief Temporal dependency model stats of a frame
+ *
+ * The block costs of the temporal dependency (TPL) model summed over a frame.
+ * The encoder sends them with the group of pictures the frame belongs to
+ * through get_gop_decisions() defined in vpx_rc_funcs_t.
+ */
+typedef struct vpx_rc_tpl_frame_stats {
+  /*!
+   * 0: The model has not run on the frame and the costs are zero.
+   * 1: Valid
+   */
+  int valid;
+  int64_t intra_cost;  /**< sum of the intra prediction costs*/
+  int64_t inter_cost;  /**< sum of the inter prediction costs*/
+  int64_t mc_dep_cost; /**< sum of the costs propagated from later frames*/
+} vpx_rc_tpl_frame_stats_t;
+
 /*!\brief Status returned by rate control callback functions.
  */
 typedef enum vpx_rc_status {
@@ -244,6 +261,41 @@ typedef struct vpx_rc_firstpass_stats {
   int num_frames;
 } vpx_rc_firstpass_stats_t;
 
+/*!\brief Group of pictures sent to the external rate control model
+ *
+ * The encoder sends the frames of the current group of pictures that are not
+ * coded yet through get_gop_decisions() defined in vpx_rc_funcs_t. This
+ * happens when the group starts and again once the temporal dependency model
+ * has run on it.
+ */
+typedef struct vpx_rc_gop_info {
+  /*!
+   * Number of entries in frame_info and tpl_stats.
+   */
+  int num_frames;
+  /*!
+   * The frames in coding order. The reference frames are only known when a
+   * frame is coded, so ref_frame_valid_list is all zero here.
+   */
+  const vpx_rc_encodeframe_info_t *frame_info;
+  /*!
+   * Temporal dependency model stats of the frames in frame_info.
+   */
+  const vpx_rc_tpl_frame_stats_t *tpl_stats;
+  /*!
+   * First pass stats of the show frames the group spans, starting with the
+   * smallest show_index in frame_info.
+   */
+  const vpx_rc_frame_stats_t *frame_stats;
+  int num_frame_stats; /**< number of entries in frame_stats*/
+  /*!
+   * Results of the frames coded since the previous call, in coding order.
+   * They take the place of update_encodeframe_result().
+   */
+  const vpx_rc_encodeframe_result_t *results;
+  int num_results; /**< number of entries in results*/
+} vpx_rc_gop_info_t;
+
 /*!\brief Encode config sent to external rate control model
  */
 typedef struct vpx_rc_config {
@@ -310,6 +362,21 @@ typedef vpx_rc_status_t (*vpx_rc_update_encodeframe_result_cb_fn_t)(
     vpx_rc_model_t rate_ctrl_model,
     const vpx_rc_encodeframe_result_t *encode_frame_result);
 
+/*!\brief Receive the encode decisions of a group of pictures callback
+ * prototype
+ *
+ * This callback is invoked by the encoder to receive the encode decisions of
+ * all the frames in gop_info at once from the external rate control model.
+ *
+ * \param[in]  rate_ctrl_model    rate control model
+ * \param[in]  gop_info           the frames of the group of pictures
+ * \param[out] frame_decisions    encode decisions of the gop_info->num_frames
+ *                                frames, in coding order
+ */
+typedef vpx_rc_status_t (*vpx_rc_get_gop_decisions_cb_fn_t)(
+    vpx_rc_model_t rate_ctrl_model, const vpx_rc_gop_info_t *gop_info,
+    vpx_rc_encodeframe_decision_t *frame_decisions);
+
 /*!\brief Delete the external rate control model callback prototype
  *
  * This callback is invoked by the encoder to delete the external rate control
@@ -347,6 +414,19 @@ typedef struct vpx_rc_funcs {
    * Delete the external rate control model.
    */
   vpx_rc_delete_model_cb_fn_t delete_model;
+  /*!
+   * Get the encode decisions of a group of pictures from the external rate
+   * control model. Optional: when it is set, the encoder calls it instead of
+   * get_encodeframe_decision() and update_encodeframe_result(). The results
+   * of the frames coded after the last call are sent through
+   * update_encodeframe_result(), if set, when the model is deleted.
+   */
+  vpx_rc_get_gop_decisions_cb_fn_t get_gop_decisions;
+  /*!
+   * If nonzero, get_gop_decisions() runs on a thread of its own while the
+   * encoder sets up the frame, so it must not call into the encoder.
+   */
+  int async_gop_decisions;
   /*!
    * Private data for the external rate control model.
    */
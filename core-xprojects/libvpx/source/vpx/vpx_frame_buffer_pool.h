@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_VPX_VPX_FRAME_BUFFER_POOL_H_
+#define VPX_VPX_VPX_FRAME_BUFFER_POOL_H_
+
+/*!\file
+ * \brief Describes a shared memory pool for the external frame buffer
+ *        interface.
+ *
+ * The pool implements the callbacks of vpx_frame_buffer.h on top of shared
+ * memory. Where the platform supports it (Linux memfd) every buffer is
+ * backed by its own file descriptor, so a decoded frame can be handed to
+ * another process, which maps it read-only without copying pixels.
+ * Elsewhere the pool still works as a recycling buffer pool but frames are
+ * not shareable (vpx_shared_frame_t::fd is -1).
+ *
+ * Buffers are reference counted. A buffer is recycled only once the decoder
+ * has released it and every reference taken by vpx_frame_buffer_pool_export()
+ * has been dropped with vpx_frame_buffer_pool_unref().
+ *
+ * Recycled buffers are not cleared: they still hold the pixels of the frame
+ * they were last used for. Only memory newly added to the pool is zeroed.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include "./vpx_codec.h"
+#include "./vpx_frame_buffer.h"
+#include "./vpx_image.h"
+
+/*!\brief Opaque frame buffer pool. */
+typedef struct vpx_frame_buffer_pool vpx_frame_buffer_pool_t;
+
+/*!\brief Description of an exported frame.
+ *
+ * Everything a consumer process needs to rebuild a vpx_image_t from a
+ * mapping of \ref fd. Plane offsets are relative to the start of the mapping.
+ */
+typedef struct vpx_shared_frame {
+  int id;                      /**< Reference to return with unref */
+  int fd;                      /**< Shared memory fd, -1 if not shareable */
+  size_t size;                 /**< Size of the mapping in bytes */
+  size_t offset[3];            /**< Offset of the Y, U and V planes */
+  int stride[3];               /**< Stride of the Y, U and V planes */
+  vpx_img_fmt_t fmt;           /**< Image format */
+  unsigned int d_w;            /**< Displayed image width */
+  unsigned int d_h;            /**< Displayed image height */
+  unsigned int x_chroma_shift; /**< Subsampling order, X */
+  unsigned int y_chroma_shift; /**< Subsampling order, Y */
+  unsigned int bit_depth;      /**< Bit depth of the samples */
+} vpx_shared_frame_t;
+
+/*!\brief Create a pool holding at most \p max_buffers buffers.
+ *
+ * VP9 needs at least #VP9_MAXIMUM_REF_BUFFERS + #VPX_MAXIMUM_WORK_BUFFERS
+ * buffers, plus one per frame the application keeps exported at a time.
+ *
+ * \return The pool, or NULL on allocation failure.
+ */
+vpx_frame_buffer_pool_t *vpx_frame_buffer_pool_create(int max_buffers);
+
+/*!\brief Destroy the pool and unmap/close all buffers.
+ *
+ * The decoder using the pool must be destroyed first. Mappings held by other
+ * processes stay valid until they are unmapped.
+ */
+void vpx_frame_buffer_pool_destroy(vpx_frame_buffer_pool_t *pool);
+
+/*!\brief Install the pool as the external frame buffer allocator of \p ctx.
+ *
+ * Decoders without external frame buffer support (VP8) return
+ * VPX_CODEC_INCAPABLE; frames from such decoders may still be exported,
+ * which copies them into a pool buffer once.
+ */
+vpx_codec_err_t vpx_frame_buffer_pool_attach(vpx_frame_buffer_pool_t *pool,
+                                             vpx_codec_ctx_t *ctx);
+
+/*!\brief vpx_get_frame_buffer_cb_fn_t implementation, \p priv is the pool.
+ *
+ * A recycled buffer is returned as is, without being cleared.
+ */
+int vpx_frame_buffer_pool_get(void *priv, size_t min_size,
+                              vpx_codec_frame_buffer_t *fb);
+
+/*!\brief vpx_release_frame_buffer_cb_fn_t implementation, \p priv is the
+ *        pool.
+ */
+int vpx_frame_buffer_pool_release(void *priv, vpx_codec_frame_buffer_t *fb);
+
+/*!\brief Take a reference on the buffer holding \p img and describe it.
+ *
+ * If \p img was decoded into a buffer of this pool no pixels are copied.
+ * Otherwise the visible area of \p img is copied into a free pool buffer.
+ * The reference must be dropped with vpx_frame_buffer_pool_unref() once the
+ * consumer is done with the frame.
+ */
+vpx_codec_err_t vpx_frame_buffer_pool_export(vpx_frame_buffer_pool_t *pool,
+                                             const vpx_image_t *img,
+                                             vpx_shared_frame_t *frame);
+
+/*!\brief Drop a reference taken by vpx_frame_buffer_pool_export(). */
+vpx_codec_err_t vpx_frame_buffer_pool_unref(vpx_frame_buffer_pool_t *pool,
+                                            int id);
+
+/*!\brief Number of buffers currently referenced by the decoder or by an
+ *        export.
+ */
+int vpx_frame_buffer_pool_num_in_use(vpx_frame_buffer_pool_t *pool);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_VPX_VPX_FRAME_BUFFER_POOL_H_
@@ -197,10 +197,40 @@ int64_t vpx_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
+static INLINE int band_row(int height, int band, int num_bands) {
+  return (int)((int64_t)height * band / num_bands);
+}
+
+void vpx_sse_to_psnr_stats(const YV12_BUFFER_CONFIG *a, const uint64_t sse[3],
+                           double peak, PSNR_STATS *psnr) {
+  const int widths[3] = { a->y_crop_width, a->uv_crop_width, a->uv_crop_width };
+  const int heights[3] = { a->y_crop_height, a->uv_crop_height,
+                           a->uv_crop_height };
+  int i;
+  uint64_t total_sse = 0;
+  uint32_t total_samples = 0;
+
+  for (i = 0; i < 3; ++i) {
+    const uint32_t samples = widths[i] * heights[i];
+    psnr->sse[1 + i] = sse[i];
+    psnr->samples[1 + i] = samples;
+    psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, peak, (double)sse[i]);
+
+    total_sse += sse[i];
+    total_samples += samples;
+  }
+
+  psnr->sse[0] = total_sse;
+  psnr->samples[0] = total_samples;
+  psnr->psnr[0] =
+      vpx_sse_to_psnr((double)total_samples, peak, (double)total_sse);
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
-void vpx_calc_highbd_psnr(const YV12_BUFFER_CONFIG *a,
-                          const YV12_BUFFER_CONFIG *b, PSNR_STATS *psnr,
-                          uint32_t bit_depth, uint32_t in_bit_depth) {
+void vpx_calc_highbd_plane_sse(const YV12_BUFFER_CONFIG *a,
+                               const YV12_BUFFER_CONFIG *b, int band,
+                               int num_bands, uint32_t bit_depth,
+                               uint32_t in_bit_depth, uint64_t sse[3]) {
   const int widths[3] = { a->y_crop_width, a->uv_crop_width, a->uv_crop_width };
   const int heights[3] = { a->y_crop_height, a->uv_crop_height,
                            a->uv_crop_height };
@@ -208,47 +238,41 @@ void vpx_calc_highbd_psnr(const YV12_BUFFER_CONFIG *a,
   const int a_strides[3] = { a->y_stride, a->uv_stride, a->uv_stride };
   const uint8_t *b_planes[3] = { b->y_buffer, b->u_buffer, b->v_buffer };
   const int b_strides[3] = { b->y_stride, b->uv_stride, b->uv_stride };
-  int i;
-  uint64_t total_sse = 0;
-  uint32_t total_samples = 0;
-  const double peak = (double)((1 << in_bit_depth) - 1);
   const unsigned int input_shift = bit_depth - in_bit_depth;
+  int i;
 
   for (i = 0; i < 3; ++i) {
     const int w = widths[i];
-    const int h = heights[i];
-    const uint32_t samples = w * h;
-    uint64_t sse;
+    const int row = band_row(heights[i], band, num_bands);
+    const int h = band_row(heights[i], band + 1, num_bands) - row;
+    const uint8_t *const pa = a_planes[i] + row * a_strides[i];
+    const uint8_t *const pb = b_planes[i] + row * b_strides[i];
     if (a->flags & YV12_FLAG_HIGHBITDEPTH) {
       if (input_shift) {
-        sse = highbd_get_sse_shift(a_planes[i], a_strides[i], b_planes[i],
-                                   b_strides[i], w, h, input_shift);
+        sse[i] = highbd_get_sse_shift(pa, a_strides[i], pb, b_strides[i], w, h,
+                                      input_shift);
       } else {
-        sse = highbd_get_sse(a_planes[i], a_strides[i], b_planes[i],
-                             b_strides[i], w, h);
+        sse[i] = highbd_get_sse(pa, a_strides[i], pb, b_strides[i], w, h);
       }
     } else {
-      sse = get_sse(a_planes[i], a_strides[i], b_planes[i], b_strides[i], w, h);
+      sse[i] = get_sse(pa, a_strides[i], pb, b_strides[i], w, h);
     }
-    psnr->sse[1 + i] = sse;
-    psnr->samples[1 + i] = samples;
-    psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, peak, (double)sse);
-
-    total_sse += sse;
-    total_samples += samples;
   }
+}
 
-  psnr->sse[0] = total_sse;
-  psnr->samples[0] = total_samples;
-  psnr->psnr[0] =
-      vpx_sse_to_psnr((double)total_samples, peak, (double)total_sse);
+void vpx_calc_highbd_psnr(const YV12_BUFFER_CONFIG *a,
+                          const YV12_BUFFER_CONFIG *b, PSNR_STATS *psnr,
+                          uint32_t bit_depth, uint32_t in_bit_depth) {
+  uint64_t sse[3];
+  vpx_calc_highbd_plane_sse(a, b, 0, 1, bit_depth, in_bit_depth, sse);
+  vpx_sse_to_psnr_stats(a, sse, (double)((1 << in_bit_depth) - 1), psnr);
 }
 
 #endif  // !CONFIG_VP9_HIGHBITDEPTH
 
-void vpx_calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
-                   PSNR_STATS *psnr) {
-  static const double peak = 255.0;
+void vpx_calc_plane_sse(const YV12_BUFFER_CONFIG *a,
+                        const YV12_BUFFER_CONFIG *b, int band, int num_bands,
+                        uint64_t sse[3]) {
   const int widths[3] = { a->y_crop_width, a->uv_crop_width, a->uv_crop_width };
   const int heights[3] = { a->y_crop_height, a->uv_crop_height,
                            a->uv_crop_height };
@@ -257,25 +281,19 @@ void vpx_calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
   const uint8_t *b_planes[3] = { b->y_buffer, b->u_buffer, b->v_buffer };
   const int b_strides[3] = { b->y_stride, b->uv_stride, b->uv_stride };
   int i;
-  uint64_t total_sse = 0;
-  uint32_t total_samples = 0;
 
   for (i = 0; i < 3; ++i) {
-    const int w = widths[i];
-    const int h = heights[i];
-    const uint32_t samples = w * h;
-    const uint64_t sse =
-        get_sse(a_planes[i], a_strides[i], b_planes[i], b_strides[i], w, h);
-    psnr->sse[1 + i] = sse;
-    psnr->samples[1 + i] = samples;
-    psnr->psnr[1 + i] = vpx_sse_to_psnr(samples, peak, (double)sse);
-
-    total_sse += sse;
-    total_samples += samples;
+    const int row = band_row(heights[i], band, num_bands);
+    const int h = band_row(heights[i], band + 1, num_bands) - row;
+    sse[i] = get_sse(a_planes[i] + row * a_strides[i], a_strides[i],
+                     b_planes[i] + row * b_strides[i], b_strides[i],
+                     widths[i], h);
   }
+}
 
-  psnr->sse[0] = total_sse;
-  psnr->samples[0] = total_samples;
-  psnr->psnr[0] =
-      vpx_sse_to_psnr((double)total_samples, peak, (double)total_sse);
+void vpx_calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
+                   PSNR_STATS *psnr) {
+  uint64_t sse[3];
+  vpx_calc_plane_sse(a, b, 0, 1, sse);
+  vpx_sse_to_psnr_stats(a, sse, 255.0, psnr);
 }
@@ -40,10 +40,26 @@ int64_t vpx_highbd_get_y_sse(const YV12_BUFFER_CONFIG *a,
 void vpx_calc_highbd_psnr(const YV12_BUFFER_CONFIG *a,
                           const YV12_BUFFER_CONFIG *b, PSNR_STATS *psnr,
                           unsigned int bit_depth, unsigned int in_bit_depth);
+void vpx_calc_highbd_plane_sse(const YV12_BUFFER_CONFIG *a,
+                               const YV12_BUFFER_CONFIG *b, int band,
+                               int num_bands, unsigned int bit_depth,
+                               unsigned int in_bit_depth, uint64_t sse[3]);
 #endif
 void vpx_calc_psnr(const YV12_BUFFER_CONFIG *a, const YV12_BUFFER_CONFIG *b,
                    PSNR_STATS *psnr);
 
+// Sums of squared errors of the Y, U and V planes over the rows
+// [h * band / num_bands, h * (band + 1) / num_bands) of each plane of height
+// h, so that the work of vpx_calc_psnr() can be split up. Adding the sums of
+// all the bands gives the sums of the whole frame.
+void vpx_calc_plane_sse(const YV12_BUFFER_CONFIG *a,
+                        const YV12_BUFFER_CONFIG *b, int band, int num_bands,
+                        uint64_t sse[3]);
+
+// Fills in psnr from the sums of squared errors of the planes of a.
+void vpx_sse_to_psnr_stats(const YV12_BUFFER_CONFIG *a, const uint64_t sse[3],
+                           double peak, PSNR_STATS *psnr);
+
 double vpx_psnrhvs(const YV12_BUFFER_CONFIG *source,
                    const YV12_BUFFER_CONFIG *dest, double *phvs_y,
                    double *phvs_u, double *phvs_v, uint32_t bd, uint32_t in_bd);
@@ -68,69 +68,95 @@ static INLINE unsigned int sad(const uint8_t *src_ptr, int src_stride,
           vpx_sad##m##x##n##_c(src_ptr, src_stride, ref_array[i], ref_stride); \
   }
 
+// As above, for 8 independent blocks. This goes through the dispatched x4d
+// functions, so that targets without an x8d version still get their SIMD x4d
+// from the motion searches that use x8d.
+#define sadMxNx8D(m, n)                                                \
+  void vpx_sad##m##x##n##x8d_c(const uint8_t *src_ptr, int src_stride, \
+                               const uint8_t *const ref_array[],       \
+                               int ref_stride, uint32_t *sad_array) {  \
+    vpx_sad##m##x##n##x4d(src_ptr, src_stride, ref_array, ref_stride,  \
+                          sad_array);                                  \
+    vpx_sad##m##x##n##x4d(src_ptr, src_stride, ref_array + 4,          \
+                          ref_stride, sad_array + 4);                  \
+  }
+
 /* clang-format off */
 // 64x64
 sadMxN(64, 64)
 sadMxNx4D(64, 64)
+sadMxNx8D(64, 64)
 
 // 64x32
 sadMxN(64, 32)
 sadMxNx4D(64, 32)
+sadMxNx8D(64, 32)
 
 // 32x64
 sadMxN(32, 64)
 sadMxNx4D(32, 64)
+sadMxNx8D(32, 64)
 
 // 32x32
 sadMxN(32, 32)
 sadMxNxK(32, 32, 8)
 sadMxNx4D(32, 32)
+sadMxNx8D(32, 32)
 
 // 32x16
 sadMxN(32, 16)
 sadMxNx4D(32, 16)
+sadMxNx8D(32, 16)
 
 // 16x32
 sadMxN(16, 32)
 sadMxNx4D(16, 32)
+sadMxNx8D(16, 32)
 
 // 16x16
 sadMxN(16, 16)
 sadMxNxK(16, 16, 3)
 sadMxNxK(16, 16, 8)
 sadMxNx4D(16, 16)
+sadMxNx8D(16, 16)
 
 // 16x8
 sadMxN(16, 8)
 sadMxNxK(16, 8, 3)
 sadMxNxK(16, 8, 8)
 sadMxNx4D(16, 8)
+sadMxNx8D(16, 8)
 
 // 8x16
 sadMxN(8, 16)
 sadMxNxK(8, 16, 3)
 sadMxNxK(8, 16, 8)
 sadMxNx4D(8, 16)
+sadMxNx8D(8, 16)
 
 // 8x8
 sadMxN(8, 8)
 sadMxNxK(8, 8, 3)
 sadMxNxK(8, 8, 8)
 sadMxNx4D(8, 8)
+sadMxNx8D(8, 8)
 
 // 8x4
 sadMxN(8, 4)
 sadMxNx4D(8, 4)
+sadMxNx8D(8, 4)
 
 // 4x8
 sadMxN(4, 8)
 sadMxNx4D(4, 8)
+sadMxNx8D(4, 8)
 
 // 4x4
 sadMxN(4, 4)
 sadMxNxK(4, 4, 3)
 sadMxNxK(4, 4, 8)
 sadMxNx4D(4, 4)
+sadMxNx8D(4, 4)
 /* clang-format on */
 
 #if CONFIG_VP9_HIGHBITDEPTH
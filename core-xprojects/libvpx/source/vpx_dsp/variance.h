@@ -77,6 +77,8 @@ typedef struct vp9_variance_vtable {
   vpx_subp_avg_variance_fn_t svaf;
   vpx_sad_multi_d_fn_t sdx4df;
   vpx_sad_multi_fn_t sdx8f;
+  // SAD of 8 independent blocks; NULL where not available.
+  vpx_sad_multi_d_fn_t sdx8df;
 } vp9_variance_fn_ptr_t;
 #endif  // CONFIG_VP9
 
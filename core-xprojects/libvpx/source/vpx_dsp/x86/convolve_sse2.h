@@ -14,6 +14,8 @@
 #include <emmintrin.h>  // SSE2
 
 #include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_sse2.h"
 
 // Interprets the input register as 16-bit words 7 6 5 4 3 2 1 0, then returns
 // values at index 2 and 3 to return 3 2 3 2 3 2 3 2 as 16-bit words
@@ -85,4 +87,33 @@ static INLINE __m128i mm_round_epi16_sse2(const __m128i *const src,
   return _mm_srai_epi16(nearest_src, depth);
 }
 
+// Averages the w x h block in src into dst with the rounding of
+// vpx_convolve_avg_c(). w must be 4, 8 or a multiple of 16.
+static INLINE void convolve_avg_block_sse2(const uint8_t *src,
+                                           const ptrdiff_t src_stride,
+                                           uint8_t *dst,
+                                           const ptrdiff_t dst_stride,
+                                           const int w, int h) {
+  do {
+    if (w == 4) {
+      const __m128i s = load_unaligned_u32(src);
+      const __m128i d = load_unaligned_u32(dst);
+      store_unaligned_u32(dst, _mm_avg_epu8(s, d));
+    } else if (w == 8) {
+      const __m128i s = _mm_loadl_epi64((const __m128i *)src);
+      const __m128i d = _mm_loadl_epi64((const __m128i *)dst);
+      _mm_storel_epi64((__m128i *)dst, _mm_avg_epu8(s, d));
+    } else {
+      int x;
+      for (x = 0; x < w; x += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_avg_epu8(s, d));
+      }
+    }
+    src += src_stride;
+    dst += dst_stride;
+  } while (--h);
+}
+
 #endif  // VPX_VPX_DSP_X86_CONVOLVE_SSE2_H_
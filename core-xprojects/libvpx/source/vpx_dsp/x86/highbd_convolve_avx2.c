@@ -9,7 +9,10 @@
  */
 
 #include <immintrin.h>
+#include <string.h>
+
 #include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_filter.h"
 #include "vpx_dsp/x86/convolve.h"
 #include "vpx_dsp/x86/convolve_avx2.h"
 
@@ -1493,3 +1496,229 @@ HIGH_FUN_CONV_1D(avg_vert, y0_q4, y_step_q4, v,
 HIGH_FUN_CONV_2D(avg_, avx2, 1);
 
 #undef HIGHBD_FUNC
+
+// -----------------------------------------------------------------------------
+// Scaled convolution
+
+// Filters 8 horizontally scaled pixels starting at phase x_q4. Every output
+// pixel has its own source position and kernel, so each 128-bit lane holds the
+// 8 taps of one pixel: register k gets pixel k in the low lane and pixel k + 4
+// in the high lane, and the horizontal adds leave pixels 0-3 and 4-7 in order.
+// hi_offset is the phase distance to the high lane pixels, 0 for 4 wide blocks
+// to keep the reads inside the block.
+static INLINE __m128i highbd_scaled_filter_x8(const uint16_t *src,
+                                              const InterpKernel *x_filters,
+                                              const int x_q4,
+                                              const int x_step_q4,
+                                              const int hi_offset,
+                                              const __m256i *const max) {
+  const __m256i rounding = _mm256_set1_epi32(CONV8_ROUNDING_NUM);
+  __m256i p[4], a;
+  int k;
+
+  for (k = 0; k < 4; ++k) {
+    const int q0 = x_q4 + k * x_step_q4;
+    const int q1 = q0 + hi_offset;
+    const __m256i s = mm256_loadu2_si128(&src[q0 >> SUBPEL_BITS],
+                                         &src[q1 >> SUBPEL_BITS]);
+    const __m256i f = mm256_loadu2_si128(x_filters[q0 & SUBPEL_MASK],
+                                         x_filters[q1 & SUBPEL_MASK]);
+    p[k] = _mm256_madd_epi16(s, f);
+  }
+
+  p[0] = _mm256_hadd_epi32(p[0], p[1]);
+  p[2] = _mm256_hadd_epi32(p[2], p[3]);
+  a = _mm256_hadd_epi32(p[0], p[2]);
+  a = _mm256_add_epi32(a, rounding);
+  a = _mm256_srai_epi32(a, CONV8_ROUNDING_BITS);
+
+  // 0 1 2 3 0 1 2 3 | 4 5 6 7 4 5 6 7 -> 0 1 2 3 4 5 6 7
+  a = _mm256_packus_epi32(a, a);
+  a = _mm256_permute4x64_epi64(a, 0x08);
+  a = _mm256_min_epi16(a, *max);
+  return _mm256_castsi256_si128(a);
+}
+
+static void highbd_scaledconvolve_horiz_avx2(
+    const uint16_t *src, const ptrdiff_t src_stride, uint16_t *dst,
+    const ptrdiff_t dst_stride, const InterpKernel *const x_filters,
+    const int x0_q4, const int x_step_q4, const int w, const int h,
+    const int bd) {
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  const int hi_offset = (w >= 8) ? 4 * x_step_q4 : 0;
+  int x, y;
+  src -= SUBPEL_TAPS / 2 - 1;
+
+  for (y = 0; y < h; ++y) {
+    if (w >= 8) {
+      int x_q4 = x0_q4;
+      for (x = 0; x < w; x += 8) {
+        const __m128i res = highbd_scaled_filter_x8(src, x_filters, x_q4,
+                                                    x_step_q4, hi_offset, &max);
+        _mm_storeu_si128((__m128i *)&dst[x], res);
+        x_q4 += 8 * x_step_q4;
+      }
+    } else {
+      const __m128i res = highbd_scaled_filter_x8(src, x_filters, x0_q4,
+                                                  x_step_q4, hi_offset, &max);
+      _mm_storel_epi64((__m128i *)dst, res);
+    }
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+static void highbd_scaledconvolve_vert_avx2(
+    const uint16_t *src, const ptrdiff_t src_stride, uint16_t *dst,
+    const ptrdiff_t dst_stride, const InterpKernel *const y_filters,
+    const int y0_q4, const int y_step_q4, const int w, const int h,
+    const int bd) {
+  const __m256i max = _mm256_set1_epi16((1 << bd) - 1);
+  const __m256i rounding = _mm256_set1_epi32(CONV8_ROUNDING_NUM);
+  int x, y, k;
+  int y_q4 = y0_q4;
+
+  src -= src_stride * (SUBPEL_TAPS / 2 - 1);
+  for (y = 0; y < h; ++y) {
+    const uint16_t *const src_y = &src[(y_q4 >> SUBPEL_BITS) * src_stride];
+
+    if (y_q4 & SUBPEL_MASK) {
+      __m256i f[4];
+      pack_filters(y_filters[y_q4 & SUBPEL_MASK], f);
+
+      for (x = 0; x < w; x += 16) {
+        __m256i s[8], lo, hi, sum_lo, sum_hi, res;
+
+        // Blocks narrower than 16 only use the low lane.
+        for (k = 0; k < 8; ++k) {
+          const uint16_t *const row = src_y + k * src_stride + x;
+          if (w >= 16) {
+            s[k] = _mm256_loadu_si256((const __m256i *)row);
+          } else if (w == 8) {
+            s[k] =
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)row));
+          } else {
+            s[k] =
+                _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)row));
+          }
+        }
+
+        sum_lo = sum_hi = rounding;
+        for (k = 0; k < 4; ++k) {
+          lo = _mm256_unpacklo_epi16(s[2 * k], s[2 * k + 1]);
+          hi = _mm256_unpackhi_epi16(s[2 * k], s[2 * k + 1]);
+          sum_lo = _mm256_add_epi32(sum_lo, _mm256_madd_epi16(lo, f[k]));
+          sum_hi = _mm256_add_epi32(sum_hi, _mm256_madd_epi16(hi, f[k]));
+        }
+        sum_lo = _mm256_srai_epi32(sum_lo, CONV8_ROUNDING_BITS);
+        sum_hi = _mm256_srai_epi32(sum_hi, CONV8_ROUNDING_BITS);
+        res = _mm256_packus_epi32(sum_lo, sum_hi);
+        res = _mm256_min_epi16(res, max);
+
+        if (w >= 16) {
+          _mm256_storeu_si256((__m256i *)&dst[y * dst_stride + x], res);
+        } else if (w == 8) {
+          _mm_storeu_si128((__m128i *)&dst[y * dst_stride],
+                           _mm256_castsi256_si128(res));
+        } else {
+          _mm_storel_epi64((__m128i *)&dst[y * dst_stride],
+                           _mm256_castsi256_si128(res));
+        }
+      }
+    } else {
+      memcpy(&dst[y * dst_stride], &src_y[3 * src_stride], w * sizeof(*dst));
+    }
+    y_q4 += y_step_q4;
+  }
+}
+
+void vpx_highbd_scaled_2d_avx2(const uint16_t *src, ptrdiff_t src_stride,
+                               uint16_t *dst, ptrdiff_t dst_stride,
+                               const InterpKernel *filter, int x0_q4,
+                               int x_step_q4, int y0_q4, int y_step_q4, int w,
+                               int h, int bd) {
+  // See highbd_convolve() in vpx_dsp/vpx_convolve.c for the temp buffer size.
+  DECLARE_ALIGNED(32, uint16_t, temp[64 * 135]);
+  const int intermediate_height =
+      (((h - 1) * y_step_q4 + y0_q4) >> SUBPEL_BITS) + SUBPEL_TAPS;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(y_step_q4 <= 32 || (y_step_q4 <= 64 && h <= 32));
+  assert(x_step_q4 <= 64);
+
+  highbd_scaledconvolve_horiz_avx2(src - src_stride * (SUBPEL_TAPS / 2 - 1),
+                                   src_stride, temp, 64, filter, x0_q4,
+                                   x_step_q4, w, intermediate_height, bd);
+  highbd_scaledconvolve_vert_avx2(temp + 64 * (SUBPEL_TAPS / 2 - 1), 64, dst,
+                                  dst_stride, filter, y0_q4, y_step_q4, w, h,
+                                  bd);
+}
+
+void vpx_highbd_scaled_horiz_avx2(const uint16_t *src, ptrdiff_t src_stride,
+                                  uint16_t *dst, ptrdiff_t dst_stride,
+                                  const InterpKernel *filter, int x0_q4,
+                                  int x_step_q4, int y0_q4, int y_step_q4,
+                                  int w, int h, int bd) {
+  (void)y0_q4;
+  (void)y_step_q4;
+  assert(w <= 64);
+  assert(h <= 64);
+
+  highbd_scaledconvolve_horiz_avx2(src, src_stride, dst, dst_stride, filter,
+                                   x0_q4, x_step_q4, w, h, bd);
+}
+
+void vpx_highbd_scaled_vert_avx2(const uint16_t *src, ptrdiff_t src_stride,
+                                 uint16_t *dst, ptrdiff_t dst_stride,
+                                 const InterpKernel *filter, int x0_q4,
+                                 int x_step_q4, int y0_q4, int y_step_q4, int w,
+                                 int h, int bd) {
+  (void)x0_q4;
+  (void)x_step_q4;
+  assert(w <= 64);
+  assert(h <= 64);
+
+  highbd_scaledconvolve_vert_avx2(src, src_stride, dst, dst_stride, filter,
+                                  y0_q4, y_step_q4, w, h, bd);
+}
+
+void vpx_highbd_scaled_avg_2d_avx2(const uint16_t *src, ptrdiff_t src_stride,
+                                   uint16_t *dst, ptrdiff_t dst_stride,
+                                   const InterpKernel *filter, int x0_q4,
+                                   int x_step_q4, int y0_q4, int y_step_q4,
+                                   int w, int h, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, temp[64 * 64]);
+
+  vpx_highbd_scaled_2d_avx2(src, src_stride, temp, 64, filter, x0_q4,
+                            x_step_q4, y0_q4, y_step_q4, w, h, bd);
+  vpx_highbd_convolve_avg_avx2(temp, 64, dst, dst_stride, NULL, 0, 0, 0, 0, w,
+                               h, bd);
+}
+
+void vpx_highbd_scaled_avg_horiz_avx2(const uint16_t *src,
+                                      ptrdiff_t src_stride, uint16_t *dst,
+                                      ptrdiff_t dst_stride,
+                                      const InterpKernel *filter, int x0_q4,
+                                      int x_step_q4, int y0_q4, int y_step_q4,
+                                      int w, int h, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, temp[64 * 64]);
+
+  vpx_highbd_scaled_horiz_avx2(src, src_stride, temp, 64, filter, x0_q4,
+                               x_step_q4, y0_q4, y_step_q4, w, h, bd);
+  vpx_highbd_convolve_avg_avx2(temp, 64, dst, dst_stride, NULL, 0, 0, 0, 0, w,
+                               h, bd);
+}
+
+void vpx_highbd_scaled_avg_vert_avx2(const uint16_t *src, ptrdiff_t src_stride,
+                                     uint16_t *dst, ptrdiff_t dst_stride,
+                                     const InterpKernel *filter, int x0_q4,
+                                     int x_step_q4, int y0_q4, int y_step_q4,
+                                     int w, int h, int bd) {
+  DECLARE_ALIGNED(32, uint16_t, temp[64 * 64]);
+
+  vpx_highbd_scaled_vert_avx2(src, src_stride, temp, 64, filter, x0_q4,
+                              x_step_q4, y0_q4, y_step_q4, w, h, bd);
+  vpx_highbd_convolve_avg_avx2(temp, 64, dst, dst_stride, NULL, 0, 0, 0, 0, w,
+                               h, bd);
+}
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX2
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// Loads 16 pixels of a w pixel wide block: one segment of a row when w >= 16,
+// otherwise 16 / w consecutive rows.
+static INLINE __m256i load_pixels(const uint16_t *p, int stride, int w) {
+  if (w >= 16) return _mm256_loadu_si256((const __m256i *)p);
+  if (w == 8) {
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+        _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+  } else {
+    const __m128i r01 =
+        _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                           _mm_loadl_epi64((const __m128i *)(p + stride)));
+    const __m128i r23 = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)(p + 2 * stride)),
+        _mm_loadl_epi64((const __m128i *)(p + 3 * stride)));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r01), r23, 1);
+  }
+}
+
+// Adds |s - r| to the 32-bit lanes of *sum. Pixels are at most 12 bits, so
+// the absolute differences fit in signed 16 bits.
+static INLINE void accumulate_sad(const __m256i s, const __m256i r,
+                                  __m256i *const sum) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  const __m256i ad = _mm256_abs_epi16(_mm256_sub_epi16(s, r));
+  *sum = _mm256_add_epi32(*sum, _mm256_madd_epi16(ad, ones));
+}
+
+static INLINE uint32_t hsum_epi32(const __m256i v) {
+  const __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v),
+                                  _mm256_extracti128_si256(v, 1));
+  const __m128i t = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+  return (uint32_t)_mm_cvtsi128_si32(_mm_add_epi32(t, _mm_srli_si128(t, 4)));
+}
+
+// second_pred, when not NULL, is a contiguous w x h block averaged with the
+// reference before the difference is taken.
+static INLINE uint32_t highbd_sad_avx2(const uint8_t *src8, int src_stride,
+                                       const uint8_t *ref8, int ref_stride,
+                                       const uint8_t *second_pred8, int w,
+                                       int h) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref = CONVERT_TO_SHORTPTR(ref8);
+  const uint16_t *pred =
+      second_pred8 != NULL ? CONVERT_TO_SHORTPTR(second_pred8) : NULL;
+  const int rows = w >= 16 ? 1 : 16 / w;
+  __m256i sum = _mm256_setzero_si256();
+  int i, j;
+
+  for (i = 0; i < h; i += rows) {
+    for (j = 0; j < w; j += 16) {
+      const __m256i s = load_pixels(src + j, src_stride, w);
+      __m256i r = load_pixels(ref + j, ref_stride, w);
+      if (pred != NULL) {
+        r = _mm256_avg_epu16(r, _mm256_loadu_si256((const __m256i *)pred));
+        pred += 16;
+      }
+      accumulate_sad(s, r, &sum);
+    }
+    src += rows * src_stride;
+    ref += rows * ref_stride;
+  }
+  return hsum_epi32(sum);
+}
+
+static INLINE void highbd_sadx4d_avx2(const uint8_t *src8, int src_stride,
+                                      const uint8_t *const ref_array[4],
+                                      int ref_stride, uint32_t sad_array[4],
+                                      int w, int h) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *ref[4];
+  const int rows = w >= 16 ? 1 : 16 / w;
+  __m256i sums[4];
+  int i, j, k;
+
+  for (k = 0; k < 4; ++k) {
+    ref[k] = CONVERT_TO_SHORTPTR(ref_array[k]);
+    sums[k] = _mm256_setzero_si256();
+  }
+
+  for (i = 0; i < h; i += rows) {
+    for (j = 0; j < w; j += 16) {
+      const __m256i s = load_pixels(src + j, src_stride, w);
+      for (k = 0; k < 4; ++k)
+        accumulate_sad(s, load_pixels(ref[k] + j, ref_stride, w), &sums[k]);
+    }
+    src += rows * src_stride;
+    for (k = 0; k < 4; ++k) ref[k] += rows * ref_stride;
+  }
+
+  {
+    const __m256i t0 = _mm256_hadd_epi32(sums[0], sums[1]);
+    const __m256i t1 = _mm256_hadd_epi32(sums[2], sums[3]);
+    const __m256i t2 = _mm256_hadd_epi32(t0, t1);
+    _mm_storeu_si128((__m128i *)sad_array,
+                     _mm_add_epi32(_mm256_castsi256_si128(t2),
+                                   _mm256_extracti128_si256(t2, 1)));
+  }
+}
+
+#define HIGHBD_SADMXN_AVX2(m, n)                                               \
+  unsigned int vpx_highbd_sad##m##x##n##_avx2(                                 \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,          \
+      int ref_stride) {                                                        \
+    return highbd_sad_avx2(src_ptr, src_stride, ref_ptr, ref_stride, NULL, m,  \
+                           n);                                                 \
+  }                                                                            \
+                                                                               \
+  unsigned int vpx_highbd_sad##m##x##n##_avg_avx2(                             \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,          \
+      int ref_stride, const uint8_t *second_pred) {                            \
+    return highbd_sad_avx2(src_ptr, src_stride, ref_ptr, ref_stride,           \
+                           second_pred, m, n);                                 \
+  }                                                                            \
+                                                                               \
+  void vpx_highbd_sad##m##x##n##x4d_avx2(                                      \
+      const uint8_t *src_ptr, int src_stride,                                  \
+      const uint8_t *const ref_array[], int ref_stride, uint32_t *sad_array) { \
+    highbd_sadx4d_avx2(src_ptr, src_stride, ref_array, ref_stride, sad_array,  \
+                       m, n);                                                  \
+  }
+
+HIGHBD_SADMXN_AVX2(64, 64)
+HIGHBD_SADMXN_AVX2(64, 32)
+HIGHBD_SADMXN_AVX2(32, 64)
+HIGHBD_SADMXN_AVX2(32, 32)
+HIGHBD_SADMXN_AVX2(32, 16)
+HIGHBD_SADMXN_AVX2(16, 32)
+HIGHBD_SADMXN_AVX2(16, 16)
+HIGHBD_SADMXN_AVX2(16, 8)
+HIGHBD_SADMXN_AVX2(8, 16)
+HIGHBD_SADMXN_AVX2(8, 8)
+HIGHBD_SADMXN_AVX2(8, 4)
+HIGHBD_SADMXN_AVX2(4, 8)
+HIGHBD_SADMXN_AVX2(4, 4)
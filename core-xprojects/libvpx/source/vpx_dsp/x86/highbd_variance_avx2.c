@@ -0,0 +1,264 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/vpx_filter.h"
+#include "vpx_ports/mem.h"
+
+// Loads 16 pixels of a w pixel wide block: one segment of a row when w >= 16,
+// otherwise 16 / w rows. Only the first n rows are read; the rest of the
+// register is zeroed.
+static INLINE __m256i load_pixels(const uint16_t *p, int stride, int w,
+                                  int n) {
+  if (w >= 16) return _mm256_loadu_si256((const __m256i *)p);
+  if (w == 8) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)p);
+    const __m128i r1 = n > 1 ? _mm_loadu_si128((const __m128i *)(p + stride))
+                             : _mm_setzero_si128();
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+  } else {
+    __m128i r[4];
+    int i;
+    for (i = 0; i < 4; ++i) {
+      r[i] = i < n ? _mm_loadl_epi64((const __m128i *)(p + i * stride))
+                   : _mm_setzero_si128();
+    }
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_unpacklo_epi64(r[0], r[1])),
+        _mm_unpacklo_epi64(r[2], r[3]), 1);
+  }
+}
+
+// Computes the sum and the sum of squares of the differences of a w x h
+// block. Squares of 12-bit differences fill 25 bits, so the 32-bit lanes of
+// the sse accumulator are widened to 64 bits every 16 rows, after at most 64
+// additions.
+static INLINE void highbd_variance_avx2(const uint16_t *src, int src_stride,
+                                        const uint16_t *ref, int ref_stride,
+                                        int w, int h, uint64_t *sse,
+                                        int64_t *sum) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  const __m256i zero = _mm256_setzero_si256();
+  const int rows = w >= 16 ? 1 : 16 / w;
+  __m256i vsum = _mm256_setzero_si256();
+  __m256i vsse64 = _mm256_setzero_si256();
+  int i, j, k;
+
+  for (k = 0; k < h; k += 16) {
+    const int block_h = VPXMIN(16, h - k);
+    __m256i vsse = _mm256_setzero_si256();
+    for (i = 0; i < block_h; i += rows) {
+      const int n = VPXMIN(rows, block_h - i);
+      for (j = 0; j < w; j += 16) {
+        const __m256i s = load_pixels(src + j, src_stride, w, n);
+        const __m256i r = load_pixels(ref + j, ref_stride, w, n);
+        const __m256i diff = _mm256_sub_epi16(s, r);
+        vsum = _mm256_add_epi32(vsum, _mm256_madd_epi16(diff, ones));
+        vsse = _mm256_add_epi32(vsse, _mm256_madd_epi16(diff, diff));
+      }
+      src += rows * src_stride;
+      ref += rows * ref_stride;
+    }
+    vsse64 = _mm256_add_epi64(vsse64, _mm256_unpacklo_epi32(vsse, zero));
+    vsse64 = _mm256_add_epi64(vsse64, _mm256_unpackhi_epi32(vsse, zero));
+  }
+
+  {
+    const __m128i sse128 = _mm_add_epi64(_mm256_castsi256_si128(vsse64),
+                                         _mm256_extracti128_si256(vsse64, 1));
+    __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(vsum),
+                                   _mm256_extracti128_si256(vsum, 1));
+    sum128 = _mm_add_epi32(sum128, _mm_srli_si128(sum128, 8));
+    sum128 = _mm_add_epi32(sum128, _mm_srli_si128(sum128, 4));
+    _mm_storel_epi64((__m128i *)sse,
+                     _mm_add_epi64(sse128, _mm_srli_si128(sse128, 8)));
+    *sum = _mm_cvtsi128_si32(sum128);
+  }
+}
+
+static INLINE uint32_t highbd_8_variance_avx2(const uint16_t *src,
+                                              int src_stride,
+                                              const uint16_t *ref,
+                                              int ref_stride, int w, int h,
+                                              uint32_t *sse) {
+  uint64_t sse_long;
+  int64_t sum_long;
+  int sum;
+  highbd_variance_avx2(src, src_stride, ref, ref_stride, w, h, &sse_long,
+                       &sum_long);
+  *sse = (uint32_t)sse_long;
+  sum = (int)sum_long;
+  return *sse - (uint32_t)(((int64_t)sum * sum) / (w * h));
+}
+
+static INLINE uint32_t highbd_10_variance_avx2(const uint16_t *src,
+                                               int src_stride,
+                                               const uint16_t *ref,
+                                               int ref_stride, int w, int h,
+                                               uint32_t *sse) {
+  uint64_t sse_long;
+  int64_t sum_long;
+  int sum;
+  int64_t var;
+  highbd_variance_avx2(src, src_stride, ref, ref_stride, w, h, &sse_long,
+                       &sum_long);
+  *sse = (uint32_t)ROUND_POWER_OF_TWO(sse_long, 4);
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, 2);
+  var = (int64_t)(*sse) - (((int64_t)sum * sum) / (w * h));
+  return (var >= 0) ? (uint32_t)var : 0;
+}
+
+static INLINE uint32_t highbd_12_variance_avx2(const uint16_t *src,
+                                               int src_stride,
+                                               const uint16_t *ref,
+                                               int ref_stride, int w, int h,
+                                               uint32_t *sse) {
+  uint64_t sse_long;
+  int64_t sum_long;
+  int sum;
+  int64_t var;
+  highbd_variance_avx2(src, src_stride, ref, ref_stride, w, h, &sse_long,
+                       &sum_long);
+  *sse = (uint32_t)ROUND_POWER_OF_TWO(sse_long, 8);
+  sum = (int)ROUND_POWER_OF_TWO(sum_long, 4);
+  var = (int64_t)(*sse) - (((int64_t)sum * sum) / (w * h));
+  return (var >= 0) ? (uint32_t)var : 0;
+}
+
+// Rounded bilinear interpolation between the pixels of a and b. filter holds
+// the two taps of the kernel interleaved as 16-bit pairs.
+static INLINE __m256i bilinear_avx2(const __m256i a, const __m256i b,
+                                    const __m256i filter) {
+  const __m256i round = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+  __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), filter);
+  __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), filter);
+  lo = _mm256_srli_epi32(_mm256_add_epi32(lo, round), FILTER_BITS);
+  hi = _mm256_srli_epi32(_mm256_add_epi32(hi, round), FILTER_BITS);
+  return _mm256_packus_epi32(lo, hi);
+}
+
+// Filters h rows of a w pixel wide block against the pixels pixel_step away
+// and stores them contiguously in dst, which must have room for
+// h * w + 16 pixels.
+static INLINE void bilinear_block_avx2(const uint16_t *src, int src_stride,
+                                       int pixel_step, int w, int h,
+                                       int offset, uint16_t *dst) {
+  // The kernels of variance.c: { 128 - 16 * offset, 16 * offset }.
+  const int f1 = offset << 4;
+  const __m256i filter =
+      _mm256_set1_epi32(((1 << FILTER_BITS) - f1) | (f1 << 16));
+  const int rows = w >= 16 ? 1 : 16 / w;
+  int i, j;
+
+  for (i = 0; i < h; i += rows) {
+    const int n = VPXMIN(rows, h - i);
+    for (j = 0; j < w; j += 16) {
+      const uint16_t *const p = src + i * src_stride + j;
+      const __m256i a = load_pixels(p, src_stride, w, n);
+      const __m256i b = load_pixels(p + pixel_step, src_stride, w, n);
+      _mm256_storeu_si256((__m256i *)(dst + i * w + j),
+                          bilinear_avx2(a, b, filter));
+    }
+  }
+}
+
+// Builds the sub-pixel prediction of a w x h block like the two pass filter
+// of variance.c, optionally averaged with second_pred. Returns the prediction
+// and its stride, which is src itself when there is nothing to do.
+static INLINE const uint16_t *highbd_sub_pixel_pred_avx2(
+    const uint16_t *src, int src_stride, int x_offset, int y_offset,
+    const uint16_t *second_pred, int w, int h, uint16_t *temp, uint16_t *pred,
+    int *pred_stride) {
+  if (x_offset == 0 && y_offset == 0) {
+    if (second_pred == NULL) {
+      *pred_stride = src_stride;
+      return src;
+    }
+    bilinear_block_avx2(src, src_stride, 1, w, h, 0, pred);
+  } else if (y_offset == 0) {
+    bilinear_block_avx2(src, src_stride, 1, w, h, x_offset, pred);
+  } else if (x_offset == 0) {
+    bilinear_block_avx2(src, src_stride, src_stride, w, h, y_offset, pred);
+  } else {
+    bilinear_block_avx2(src, src_stride, 1, w, h + 1, x_offset, temp);
+    bilinear_block_avx2(temp, w, w, w, h, y_offset, pred);
+  }
+
+  if (second_pred != NULL) {
+    int i;
+    for (i = 0; i < w * h; i += 16) {
+      const __m256i p = _mm256_loadu_si256((const __m256i *)(pred + i));
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(second_pred + i));
+      _mm256_storeu_si256((__m256i *)(pred + i), _mm256_avg_epu16(p, s));
+    }
+  }
+  *pred_stride = w;
+  return pred;
+}
+
+#define HIGHBD_VAR_AVX2(bd, w, h)                                              \
+  uint32_t vpx_highbd_##bd##_variance##w##x##h##_avx2(                         \
+      const uint8_t *src_ptr, int src_stride, const uint8_t *ref_ptr,          \
+      int ref_stride, uint32_t *sse) {                                         \
+    return highbd_##bd##_variance_avx2(                                        \
+        CONVERT_TO_SHORTPTR(src_ptr), src_stride,                              \
+        CONVERT_TO_SHORTPTR(ref_ptr), ref_stride, w, h, sse);                  \
+  }                                                                            \
+                                                                               \
+  uint32_t vpx_highbd_##bd##_sub_pixel_variance##w##x##h##_avx2(               \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,      \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse) {                 \
+    uint16_t temp[(h + 1) * w + 16];                                           \
+    uint16_t pred[h * w + 16];                                                 \
+    int pred_stride;                                                           \
+    const uint16_t *const p = highbd_sub_pixel_pred_avx2(                      \
+        CONVERT_TO_SHORTPTR(src_ptr), src_stride, x_offset, y_offset, NULL, w, \
+        h, temp, pred, &pred_stride);                                          \
+    return highbd_##bd##_variance_avx2(p, pred_stride,                         \
+                                       CONVERT_TO_SHORTPTR(ref_ptr),           \
+                                       ref_stride, w, h, sse);                 \
+  }                                                                            \
+                                                                               \
+  uint32_t vpx_highbd_##bd##_sub_pixel_avg_variance##w##x##h##_avx2(           \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,      \
+      const uint8_t *ref_ptr, int ref_stride, uint32_t *sse,                   \
+      const uint8_t *second_pred) {                                            \
+    uint16_t temp[(h + 1) * w + 16];                                           \
+    uint16_t pred[h * w + 16];                                                 \
+    int pred_stride;                                                           \
+    const uint16_t *const p = highbd_sub_pixel_pred_avx2(                      \
+        CONVERT_TO_SHORTPTR(src_ptr), src_stride, x_offset, y_offset,          \
+        CONVERT_TO_SHORTPTR(second_pred), w, h, temp, pred, &pred_stride);     \
+    return highbd_##bd##_variance_avx2(p, pred_stride,                         \
+                                       CONVERT_TO_SHORTPTR(ref_ptr),           \
+                                       ref_stride, w, h, sse);                 \
+  }
+
+#define HIGHBD_VAR_ALL_AVX2(w, h) \
+  HIGHBD_VAR_AVX2(8, w, h)        \
+  HIGHBD_VAR_AVX2(10, w, h)       \
+  HIGHBD_VAR_AVX2(12, w, h)
+
+HIGHBD_VAR_ALL_AVX2(64, 64)
+HIGHBD_VAR_ALL_AVX2(64, 32)
+HIGHBD_VAR_ALL_AVX2(32, 64)
+HIGHBD_VAR_ALL_AVX2(32, 32)
+HIGHBD_VAR_ALL_AVX2(32, 16)
+HIGHBD_VAR_ALL_AVX2(16, 32)
+HIGHBD_VAR_ALL_AVX2(16, 16)
+HIGHBD_VAR_ALL_AVX2(16, 8)
+HIGHBD_VAR_ALL_AVX2(8, 16)
+HIGHBD_VAR_ALL_AVX2(8, 8)
+HIGHBD_VAR_ALL_AVX2(8, 4)
+HIGHBD_VAR_ALL_AVX2(4, 8)
+HIGHBD_VAR_ALL_AVX2(4, 4)
@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX2
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+
+// Each 64-bit lane of sums[i] holds a partial sum of ref i. Reduces them to
+// 4 32-bit totals.
+static INLINE void calc_final_4(const __m256i *const sums /*[4]*/,
+                                uint32_t *sad_array) {
+  const __m256i t0 = _mm256_hadd_epi32(sums[0], sums[1]);
+  const __m256i t1 = _mm256_hadd_epi32(sums[2], sums[3]);
+  const __m256i t2 = _mm256_hadd_epi32(t0, t1);
+  const __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(t2),
+                                    _mm256_extractf128_si256(t2, 1));
+  _mm_storeu_si128((__m128i *)sad_array, sum);
+}
+
+static INLINE void accumulate_8(__m256i *const sums /*[8]*/, const __m256i s,
+                                const __m256i *const r /*[8]*/) {
+  int i;
+  for (i = 0; i < 8; ++i)
+    sums[i] = _mm256_add_epi32(sums[i], _mm256_sad_epu8(r[i], s));
+}
+
+// Blocks at least 32 pixels wide: one source row segment is loaded once and
+// compared against all 8 refs.
+static INLINE void sad_wxhx8d_avx2(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *const ref_array[8],
+                                   int ref_stride, uint32_t sad_array[8],
+                                   int w, int h) {
+  int i, j, k;
+  __m256i sums[8];
+
+  for (k = 0; k < 8; ++k) sums[k] = _mm256_setzero_si256();
+
+  for (i = 0; i < h; ++i) {
+    for (j = 0; j < w; j += 32) {
+      __m256i r[8];
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(src_ptr + j));
+      for (k = 0; k < 8; ++k) {
+        r[k] = _mm256_loadu_si256(
+            (const __m256i *)(ref_array[k] + i * ref_stride + j));
+      }
+      accumulate_8(sums, s, r);
+    }
+    src_ptr += src_stride;
+  }
+
+  calc_final_4(sums, sad_array);
+  calc_final_4(sums + 4, sad_array + 4);
+}
+
+static INLINE __m256i load_16x2(const uint8_t *p, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+      _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+}
+
+// 16 pixel wide blocks: 2 rows per 256-bit register.
+static INLINE void sad16xhx8d_avx2(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *const ref_array[8],
+                                   int ref_stride, uint32_t sad_array[8],
+                                   int h) {
+  int i, k;
+  __m256i sums[8];
+
+  for (k = 0; k < 8; ++k) sums[k] = _mm256_setzero_si256();
+
+  for (i = 0; i < h; i += 2) {
+    __m256i r[8];
+    const __m256i s = load_16x2(src_ptr, src_stride);
+    for (k = 0; k < 8; ++k)
+      r[k] = load_16x2(ref_array[k] + i * ref_stride, ref_stride);
+    accumulate_8(sums, s, r);
+    src_ptr += 2 * src_stride;
+  }
+
+  calc_final_4(sums, sad_array);
+  calc_final_4(sums + 4, sad_array + 4);
+}
+
+static INLINE __m256i load_8x4(const uint8_t *p, int stride) {
+  const __m128i lo =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                         _mm_loadl_epi64((const __m128i *)(p + stride)));
+  const __m128i hi =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(p + 2 * stride)),
+                         _mm_loadl_epi64((const __m128i *)(p + 3 * stride)));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+// 8 pixel wide blocks: 4 rows per 256-bit register.
+static INLINE void sad8xhx8d_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *const ref_array[8],
+                                  int ref_stride, uint32_t sad_array[8],
+                                  int h) {
+  int i, k;
+  __m256i sums[8];
+
+  for (k = 0; k < 8; ++k) sums[k] = _mm256_setzero_si256();
+
+  for (i = 0; i < h; i += 4) {
+    __m256i r[8];
+    const __m256i s = load_8x4(src_ptr, src_stride);
+    for (k = 0; k < 8; ++k)
+      r[k] = load_8x4(ref_array[k] + i * ref_stride, ref_stride);
+    accumulate_8(sums, s, r);
+    src_ptr += 4 * src_stride;
+  }
+
+  calc_final_4(sums, sad_array);
+  calc_final_4(sums + 4, sad_array + 4);
+}
+
+static INLINE __m128i load_4x4(const uint8_t *p, int stride) {
+  const __m128i r01 = _mm_unpacklo_epi32(load_unaligned_u32(p),
+                                         load_unaligned_u32(p + stride));
+  const __m128i r23 = _mm_unpacklo_epi32(load_unaligned_u32(p + 2 * stride),
+                                         load_unaligned_u32(p + 3 * stride));
+  return _mm_unpacklo_epi64(r01, r23);
+}
+
+// 4 pixel wide blocks: 4 rows of 2 refs per 256-bit register.
+static INLINE void sad4xhx8d_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *const ref_array[8],
+                                  int ref_stride, uint32_t sad_array[8],
+                                  int h) {
+  int i, k;
+  __m256i sums[4];
+
+  for (k = 0; k < 4; ++k) sums[k] = _mm256_setzero_si256();
+
+  for (i = 0; i < h; i += 4) {
+    const __m128i s128 = load_4x4(src_ptr, src_stride);
+    const __m256i s =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(s128), s128, 1);
+    for (k = 0; k < 4; ++k) {
+      const __m256i r = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(
+              load_4x4(ref_array[2 * k] + i * ref_stride, ref_stride)),
+          load_4x4(ref_array[2 * k + 1] + i * ref_stride, ref_stride), 1);
+      sums[k] = _mm256_add_epi32(sums[k], _mm256_sad_epu8(r, s));
+    }
+    src_ptr += 4 * src_stride;
+  }
+
+  // The low lane of sums[k] holds ref 2 * k and the high lane ref 2 * k + 1.
+  {
+    const __m256i t0 = _mm256_hadd_epi32(sums[0], sums[1]);
+    const __m256i t1 = _mm256_hadd_epi32(sums[2], sums[3]);
+    const __m256i t2 = _mm256_hadd_epi32(t0, t1);
+    // t2 lane 0: refs 0, 2, 4, 6; lane 1: refs 1, 3, 5, 7.
+    const __m128i even = _mm256_castsi256_si128(t2);
+    const __m128i odd = _mm256_extracti128_si256(t2, 1);
+    _mm_storeu_si128((__m128i *)sad_array, _mm_unpacklo_epi32(even, odd));
+    _mm_storeu_si128((__m128i *)(sad_array + 4),
+                     _mm_unpackhi_epi32(even, odd));
+  }
+}
+
+#define SADWXHX8D_AVX2(w, h)                                                   \
+  void vpx_sad##w##x##h##x8d_avx2(const uint8_t *src_ptr, int src_stride,      \
+                                  const uint8_t *const ref_array[],            \
+                                  int ref_stride, uint32_t *sad_array) {       \
+    sad_wxhx8d_avx2(src_ptr, src_stride, ref_array, ref_stride, sad_array, w,  \
+                    h);                                                        \
+  }
+
+#define SADNXHX8D_AVX2(n, h)                                                   \
+  void vpx_sad##n##x##h##x8d_avx2(const uint8_t *src_ptr, int src_stride,      \
+                                  const uint8_t *const ref_array[],            \
+                                  int ref_stride, uint32_t *sad_array) {       \
+    sad##n##xhx8d_avx2(src_ptr, src_stride, ref_array, ref_stride, sad_array,  \
+                       h);                                                     \
+  }
+
+SADWXHX8D_AVX2(64, 64)
+SADWXHX8D_AVX2(64, 32)
+SADWXHX8D_AVX2(32, 64)
+SADWXHX8D_AVX2(32, 32)
+SADWXHX8D_AVX2(32, 16)
+SADNXHX8D_AVX2(16, 32)
+SADNXHX8D_AVX2(16, 16)
+SADNXHX8D_AVX2(16, 8)
+SADNXHX8D_AVX2(8, 16)
+SADNXHX8D_AVX2(8, 8)
+SADNXHX8D_AVX2(8, 4)
+SADNXHX8D_AVX2(4, 8)
+SADNXHX8D_AVX2(4, 4)
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX512
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Each 64-bit lane of sums[i] holds a partial sum of ref i. Reduces them to
+// 8 32-bit totals.
+static INLINE void calc_final_8(const __m512i *const sums /*[8]*/,
+                                uint32_t sad_array[8]) {
+  // Move the partial sums of odd refs to the high dword of each 64-bit lane.
+  const __m512i s01 = _mm512_or_si512(sums[0], _mm512_bslli_epi128(sums[1], 4));
+  const __m512i s23 = _mm512_or_si512(sums[2], _mm512_bslli_epi128(sums[3], 4));
+  const __m512i s45 = _mm512_or_si512(sums[4], _mm512_bslli_epi128(sums[5], 4));
+  const __m512i s67 = _mm512_or_si512(sums[6], _mm512_bslli_epi128(sums[7], 4));
+  // Each 128-bit lane: refs 0, 1, 2, 3 and refs 4, 5, 6, 7.
+  const __m512i s0123 = _mm512_add_epi32(_mm512_unpacklo_epi64(s01, s23),
+                                         _mm512_unpackhi_epi64(s01, s23));
+  const __m512i s4567 = _mm512_add_epi32(_mm512_unpacklo_epi64(s45, s67),
+                                         _mm512_unpackhi_epi64(s45, s67));
+  // Add the 4 128-bit lanes.
+  const __m256i a = _mm256_add_epi32(_mm512_castsi512_si256(s0123),
+                                     _mm512_extracti64x4_epi64(s0123, 1));
+  const __m256i b = _mm256_add_epi32(_mm512_castsi512_si256(s4567),
+                                     _mm512_extracti64x4_epi64(s4567, 1));
+  _mm_storeu_si128((__m128i *)sad_array,
+                   _mm_add_epi32(_mm256_castsi256_si128(a),
+                                 _mm256_extracti128_si256(a, 1)));
+  _mm_storeu_si128((__m128i *)(sad_array + 4),
+                   _mm_add_epi32(_mm256_castsi256_si128(b),
+                                 _mm256_extracti128_si256(b, 1)));
+}
+
+static INLINE __m512i load_32x2(const uint8_t *p, int stride) {
+  return _mm512_inserti64x4(
+      _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i *)p)),
+      _mm256_loadu_si256((const __m256i *)(p + stride)), 1);
+}
+
+// 64 pixel wide blocks: one row per 512-bit register.
+static INLINE void sad64xhx8d_avx512(const uint8_t *src_ptr, int src_stride,
+                                     const uint8_t *const ref_array[8],
+                                     int ref_stride, uint32_t sad_array[8],
+                                     int h) {
+  int i, k;
+  __m512i sums[8];
+
+  for (k = 0; k < 8; ++k) sums[k] = _mm512_setzero_si512();
+
+  for (i = 0; i < h; ++i) {
+    const __m512i s = _mm512_loadu_si512((const __m512i *)src_ptr);
+    for (k = 0; k < 8; ++k) {
+      const __m512i r =
+          _mm512_loadu_si512((const __m512i *)(ref_array[k] + i * ref_stride));
+      sums[k] = _mm512_add_epi32(sums[k], _mm512_sad_epu8(r, s));
+    }
+    src_ptr += src_stride;
+  }
+
+  calc_final_8(sums, sad_array);
+}
+
+// 32 pixel wide blocks: 2 rows per 512-bit register.
+static INLINE void sad32xhx8d_avx512(const uint8_t *src_ptr, int src_stride,
+                                     const uint8_t *const ref_array[8],
+                                     int ref_stride, uint32_t sad_array[8],
+                                     int h) {
+  int i, k;
+  __m512i sums[8];
+
+  for (k = 0; k < 8; ++k) sums[k] = _mm512_setzero_si512();
+
+  for (i = 0; i < h; i += 2) {
+    const __m512i s = load_32x2(src_ptr, src_stride);
+    for (k = 0; k < 8; ++k) {
+      const __m512i r = load_32x2(ref_array[k] + i * ref_stride, ref_stride);
+      sums[k] = _mm512_add_epi32(sums[k], _mm512_sad_epu8(r, s));
+    }
+    src_ptr += 2 * src_stride;
+  }
+
+  calc_final_8(sums, sad_array);
+}
+
+#define SADNXHX8D_AVX512(n, h)                                                 \
+  void vpx_sad##n##x##h##x8d_avx512(const uint8_t *src_ptr, int src_stride,    \
+                                    const uint8_t *const ref_array[],          \
+                                    int ref_stride, uint32_t *sad_array) {     \
+    sad##n##xhx8d_avx512(src_ptr, src_stride, ref_array, ref_stride,           \
+                         sad_array, h);                                        \
+  }
+
+SADNXHX8D_AVX512(64, 64)
+SADNXHX8D_AVX512(64, 32)
+SADNXHX8D_AVX512(32, 64)
+SADNXHX8D_AVX512(32, 32)
+SADNXHX8D_AVX512(32, 16)
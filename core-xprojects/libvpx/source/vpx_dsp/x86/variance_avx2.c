@@ -8,9 +8,12 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <assert.h>
 #include <immintrin.h>  // AVX2
 
 #include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_dsp/x86/mem_sse2.h"
 
 /* clang-format off */
 DECLARE_ALIGNED(32, static const uint8_t, bilinear_filters_avx2[512]) = {
@@ -605,6 +608,130 @@ static unsigned int sub_pixel_avg_variance32xh_avx2(
                          second_pred, second_stride, 1, height, sse);
 }
 
+// Loads 32 / w rows of a w pixel wide block (w <= 16) into one register. Only
+// the first n rows are read; the rest of the register is zeroed.
+static INLINE __m256i load_rows_avx2(const uint8_t *p, int stride, int w,
+                                     int n) {
+  if (w == 16) {
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)p);
+    const __m128i r1 = n > 1 ? _mm_loadu_si128((const __m128i *)(p + stride))
+                             : _mm_setzero_si128();
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+  } else if (w == 8) {
+    __m128i r[4];
+    int i;
+    for (i = 0; i < 4; ++i) {
+      r[i] = i < n ? _mm_loadl_epi64((const __m128i *)(p + i * stride))
+                   : _mm_setzero_si128();
+    }
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_unpacklo_epi64(r[0], r[1])),
+        _mm_unpacklo_epi64(r[2], r[3]), 1);
+  } else {
+    __m128i r[8];
+    int i;
+    assert(w == 4);
+    for (i = 0; i < 8; ++i) {
+      r[i] = i < n ? load_unaligned_u32(p + i * stride) : _mm_setzero_si128();
+    }
+    r[0] = _mm_unpacklo_epi64(_mm_unpacklo_epi32(r[0], r[1]),
+                              _mm_unpacklo_epi32(r[2], r[3]));
+    r[4] = _mm_unpacklo_epi64(_mm_unpacklo_epi32(r[4], r[5]),
+                              _mm_unpacklo_epi32(r[6], r[7]));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(r[0]), r[4], 1);
+  }
+}
+
+// Variance of a w pixel wide block (w <= 8), several rows per register.
+static INLINE void variance_small_avx2(const uint8_t *src, int src_stride,
+                                       const uint8_t *ref, int ref_stride,
+                                       int w, int h, __m256i *const vsse,
+                                       __m256i *const vsum) {
+  const int rows = 32 / w;
+  int i;
+  *vsum = _mm256_setzero_si256();
+  *vsse = _mm256_setzero_si256();
+
+  for (i = 0; i < h; i += rows) {
+    const int n = VPXMIN(rows, h - i);
+    const __m256i s = load_rows_avx2(src + i * src_stride, src_stride, w, n);
+    const __m256i r = load_rows_avx2(ref + i * ref_stride, ref_stride, w, n);
+    variance_kernel_avx2(s, r, vsse, vsum);
+  }
+}
+
+// Rounded bilinear interpolation between the pixels of a and b, using a
+// filter from bilinear_filters_avx2.
+static INLINE __m256i bilinear_avx2(const __m256i a, const __m256i b,
+                                    const __m256i filter) {
+  const __m256i pw8 = _mm256_set1_epi16(8);
+  __m256i lo = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(a, b), filter);
+  __m256i hi = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(a, b), filter);
+  lo = _mm256_srli_epi16(_mm256_add_epi16(lo, pw8), 4);
+  hi = _mm256_srli_epi16(_mm256_add_epi16(hi, pw8), 4);
+  return _mm256_packus_epi16(lo, hi);
+}
+
+// Filters h rows of a w pixel wide block (w <= 16) against the pixels
+// pixel_step away, and stores them contiguously in dst. dst must be 32 byte
+// aligned and have room for h * w + 32 bytes.
+static INLINE void bilinear_block_avx2(const uint8_t *src, int src_stride,
+                                       int pixel_step, int w, int h,
+                                       int offset, uint8_t *dst) {
+  const __m256i filter = _mm256_load_si256(
+      (const __m256i *)(bilinear_filters_avx2 + (offset << 5)));
+  const int rows = 32 / w;
+  int i;
+
+  for (i = 0; i < h; i += rows) {
+    const int n = VPXMIN(rows, h - i);
+    const uint8_t *const p = src + i * src_stride;
+    const __m256i a = load_rows_avx2(p, src_stride, w, n);
+    const __m256i b = load_rows_avx2(p + pixel_step, src_stride, w, n);
+    _mm256_store_si256((__m256i *)(dst + i * w), bilinear_avx2(a, b, filter));
+  }
+}
+
+// Builds the sub-pixel prediction of a w x h block (w <= 16) like the two
+// pass filter of variance.c, optionally averaged with second_pred. Returns
+// the prediction and its stride, which is src itself when there is nothing
+// to do.
+static INLINE const uint8_t *sub_pixel_pred_avx2(
+    const uint8_t *src, int src_stride, int x_offset, int y_offset,
+    const uint8_t *second_pred, int w, int h, uint8_t *temp, uint8_t *pred,
+    int *pred_stride) {
+  if (x_offset == 0 && y_offset == 0) {
+    if (second_pred == NULL) {
+      *pred_stride = src_stride;
+      return src;
+    }
+    bilinear_block_avx2(src, src_stride, 1, w, h, 0, pred);
+  } else if (y_offset == 0) {
+    bilinear_block_avx2(src, src_stride, 1, w, h, x_offset, pred);
+  } else if (x_offset == 0) {
+    bilinear_block_avx2(src, src_stride, src_stride, w, h, y_offset, pred);
+  } else {
+    bilinear_block_avx2(src, src_stride, 1, w, h + 1, x_offset, temp);
+    bilinear_block_avx2(temp, w, w, w, h, y_offset, pred);
+  }
+
+  if (second_pred != NULL) {
+    int i = 0;
+    for (; i + 32 <= w * h; i += 32) {
+      const __m256i p = _mm256_load_si256((const __m256i *)(pred + i));
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(second_pred + i));
+      _mm256_store_si256((__m256i *)(pred + i), _mm256_avg_epu8(p, s));
+    }
+    if (i < w * h) {
+      const __m128i p = _mm_load_si128((const __m128i *)(pred + i));
+      const __m128i s = _mm_loadu_si128((const __m128i *)(second_pred + i));
+      _mm_store_si128((__m128i *)(pred + i), _mm_avg_epu8(p, s));
+    }
+  }
+  *pred_stride = w;
+  return pred;
+}
+
 typedef void (*get_var_avx2)(const uint8_t *src_ptr, int src_stride,
                              const uint8_t *ref_ptr, int ref_stride,
                              unsigned int *sse, int *sum);
@@ -715,6 +842,61 @@ unsigned int vpx_variance64x64_avx2(const uint8_t *src_ptr, int src_stride,
   return *sse - (unsigned int)(((int64_t)sum * sum) >> 12);
 }
 
+unsigned int vpx_variance8x16_avx2(const uint8_t *src_ptr, int src_stride,
+                                   const uint8_t *ref_ptr, int ref_stride,
+                                   unsigned int *sse) {
+  int sum;
+  __m256i vsse, vsum;
+  variance_small_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 8, 16, &vsse,
+                      &vsum);
+  variance_final_from_16bit_sum_avx2(vsse, vsum, sse, &sum);
+  return *sse - (uint32_t)(((int64_t)sum * sum) >> 7);
+}
+
+unsigned int vpx_variance8x8_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *ref_ptr, int ref_stride,
+                                  unsigned int *sse) {
+  int sum;
+  __m256i vsse, vsum;
+  variance_small_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 8, 8, &vsse,
+                      &vsum);
+  variance_final_from_16bit_sum_avx2(vsse, vsum, sse, &sum);
+  return *sse - (uint32_t)(((int64_t)sum * sum) >> 6);
+}
+
+unsigned int vpx_variance8x4_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *ref_ptr, int ref_stride,
+                                  unsigned int *sse) {
+  int sum;
+  __m256i vsse, vsum;
+  variance_small_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 8, 4, &vsse,
+                      &vsum);
+  variance_final_from_16bit_sum_avx2(vsse, vsum, sse, &sum);
+  return *sse - (uint32_t)(((int64_t)sum * sum) >> 5);
+}
+
+unsigned int vpx_variance4x8_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *ref_ptr, int ref_stride,
+                                  unsigned int *sse) {
+  int sum;
+  __m256i vsse, vsum;
+  variance_small_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 4, 8, &vsse,
+                      &vsum);
+  variance_final_from_16bit_sum_avx2(vsse, vsum, sse, &sum);
+  return *sse - (uint32_t)(((int64_t)sum * sum) >> 5);
+}
+
+unsigned int vpx_variance4x4_avx2(const uint8_t *src_ptr, int src_stride,
+                                  const uint8_t *ref_ptr, int ref_stride,
+                                  unsigned int *sse) {
+  int sum;
+  __m256i vsse, vsum;
+  variance_small_avx2(src_ptr, src_stride, ref_ptr, ref_stride, 4, 4, &vsse,
+                      &vsum);
+  variance_final_from_16bit_sum_avx2(vsse, vsum, sse, &sum);
+  return *sse - (uint32_t)(((int64_t)sum * sum) >> 4);
+}
+
 unsigned int vpx_mse16x8_avx2(const uint8_t *src_ptr, int src_stride,
                               const uint8_t *ref_ptr, int ref_stride,
                               unsigned int *sse) {
@@ -787,3 +969,112 @@ unsigned int vpx_sub_pixel_avg_variance32x32_avx2(
                                                  second_pred, 32, 32, sse);
   return *sse - (uint32_t)(((int64_t)se * se) >> 10);
 }
+
+unsigned int vpx_sub_pixel_variance64x32_avx2(
+    const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,
+    const uint8_t *ref_ptr, int ref_stride, unsigned int *sse) {
+  unsigned int sse1;
+  const int se1 = sub_pixel_variance32xh_avx2(
+      src_ptr, src_stride, x_offset, y_offset, ref_ptr, ref_stride, 32, &sse1);
+  unsigned int sse2;
+  const int se2 =
+      sub_pixel_variance32xh_avx2(src_ptr + 32, src_stride, x_offset, y_offset,
+                                  ref_ptr + 32, ref_stride, 32, &sse2);
+  const int se = se1 + se2;
+  *sse = sse1 + sse2;
+  return *sse - (uint32_t)(((int64_t)se * se) >> 11);
+}
+
+unsigned int vpx_sub_pixel_variance32x64_avx2(
+    const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,
+    const uint8_t *ref_ptr, int ref_stride, unsigned int *sse) {
+  const int se = sub_pixel_variance32xh_avx2(
+      src_ptr, src_stride, x_offset, y_offset, ref_ptr, ref_stride, 64, sse);
+  return *sse - (uint32_t)(((int64_t)se * se) >> 11);
+}
+
+unsigned int vpx_sub_pixel_variance32x16_avx2(
+    const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,
+    const uint8_t *ref_ptr, int ref_stride, unsigned int *sse) {
+  const int se = sub_pixel_variance32xh_avx2(
+      src_ptr, src_stride, x_offset, y_offset, ref_ptr, ref_stride, 16, sse);
+  return *sse - (uint32_t)(((int64_t)se * se) >> 9);
+}
+
+unsigned int vpx_sub_pixel_avg_variance64x32_avx2(
+    const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,
+    const uint8_t *ref_ptr, int ref_stride, unsigned int *sse,
+    const uint8_t *second_pred) {
+  unsigned int sse1;
+  const int se1 = sub_pixel_avg_variance32xh_avx2(src_ptr, src_stride, x_offset,
+                                                  y_offset, ref_ptr, ref_stride,
+                                                  second_pred, 64, 32, &sse1);
+  unsigned int sse2;
+  const int se2 = sub_pixel_avg_variance32xh_avx2(
+      src_ptr + 32, src_stride, x_offset, y_offset, ref_ptr + 32, ref_stride,
+      second_pred + 32, 64, 32, &sse2);
+  const int se = se1 + se2;
+
+  *sse = sse1 + sse2;
+
+  return *sse - (uint32_t)(((int64_t)se * se) >> 11);
+}
+
+unsigned int vpx_sub_pixel_avg_variance32x64_avx2(
+    const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,
+    const uint8_t *ref_ptr, int ref_stride, unsigned int *sse,
+    const uint8_t *second_pred) {
+  const int se = sub_pixel_avg_variance32xh_avx2(src_ptr, src_stride, x_offset,
+                                                 y_offset, ref_ptr, ref_stride,
+                                                 second_pred, 32, 64, sse);
+  return *sse - (uint32_t)(((int64_t)se * se) >> 11);
+}
+
+unsigned int vpx_sub_pixel_avg_variance32x16_avx2(
+    const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,
+    const uint8_t *ref_ptr, int ref_stride, unsigned int *sse,
+    const uint8_t *second_pred) {
+  const int se = sub_pixel_avg_variance32xh_avx2(src_ptr, src_stride, x_offset,
+                                                 y_offset, ref_ptr, ref_stride,
+                                                 second_pred, 32, 16, sse);
+  return *sse - (uint32_t)(((int64_t)se * se) >> 9);
+}
+
+// Blocks narrower than 32 pixels filter into a contiguous buffer and reuse the
+// variance functions above.
+#define SUBPIX_VAR_AVX2(w, h)                                                 \
+  unsigned int vpx_sub_pixel_variance##w##x##h##_avx2(                        \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,     \
+      const uint8_t *ref_ptr, int ref_stride, unsigned int *sse) {            \
+    DECLARE_ALIGNED(32, uint8_t, temp[(h + 1) * w + 32]);                     \
+    DECLARE_ALIGNED(32, uint8_t, pred[h * w + 32]);                           \
+    int pred_stride;                                                          \
+    const uint8_t *const p =                                                  \
+        sub_pixel_pred_avx2(src_ptr, src_stride, x_offset, y_offset, NULL, w, \
+                            h, temp, pred, &pred_stride);                     \
+    return vpx_variance##w##x##h##_avx2(p, pred_stride, ref_ptr, ref_stride,  \
+                                        sse);                                 \
+  }                                                                           \
+                                                                              \
+  unsigned int vpx_sub_pixel_avg_variance##w##x##h##_avx2(                    \
+      const uint8_t *src_ptr, int src_stride, int x_offset, int y_offset,     \
+      const uint8_t *ref_ptr, int ref_stride, unsigned int *sse,              \
+      const uint8_t *second_pred) {                                           \
+    DECLARE_ALIGNED(32, uint8_t, temp[(h + 1) * w + 32]);                     \
+    DECLARE_ALIGNED(32, uint8_t, pred[h * w + 32]);                           \
+    int pred_stride;                                                          \
+    const uint8_t *const p =                                                  \
+        sub_pixel_pred_avx2(src_ptr, src_stride, x_offset, y_offset,          \
+                            second_pred, w, h, temp, pred, &pred_stride);     \
+    return vpx_variance##w##x##h##_avx2(p, pred_stride, ref_ptr, ref_stride,  \
+                                        sse);                                 \
+  }
+
+SUBPIX_VAR_AVX2(16, 32)
+SUBPIX_VAR_AVX2(16, 16)
+SUBPIX_VAR_AVX2(16, 8)
+SUBPIX_VAR_AVX2(8, 16)
+SUBPIX_VAR_AVX2(8, 8)
+SUBPIX_VAR_AVX2(8, 4)
+SUBPIX_VAR_AVX2(4, 8)
+SUBPIX_VAR_AVX2(4, 4)
@@ -10,11 +10,15 @@
 
 #include <immintrin.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_filter.h"
 #include "vpx_dsp/x86/convolve.h"
 #include "vpx_dsp/x86/convolve_avx2.h"
 #include "vpx_dsp/x86/convolve_sse2.h"
+#include "vpx_dsp/x86/mem_sse2.h"
+#include "vpx_dsp/x86/transpose_sse2.h"
 #include "vpx_ports/mem.h"
 
 // filters for 16_h8
@@ -988,4 +992,381 @@ FUN_CONV_1D(avg_vert, y0_q4, y_step_q4, v,
 //                              int w, int h);
 FUN_CONV_2D(, avx2, 0);
 FUN_CONV_2D(avg_, avx2, 1);
+
+// Loads the taps of filter0 into the low lane and those of filter1 into the
+// high lane, so that each lane applies its own 8-tap filter.
+static INLINE void shuffle_filter_x2_avx2(const int16_t *const filter0,
+                                          const int16_t *const filter1,
+                                          __m256i *const f) {
+  const __m256i f_values = mm256_loadu2_si128(filter0, filter1);
+  // pack and duplicate the filter values
+  f[0] = _mm256_shuffle_epi8(f_values, _mm256_set1_epi16(0x0200u));
+  f[1] = _mm256_shuffle_epi8(f_values, _mm256_set1_epi16(0x0604u));
+  f[2] = _mm256_shuffle_epi8(f_values, _mm256_set1_epi16(0x0a08u));
+  f[3] = _mm256_shuffle_epi8(f_values, _mm256_set1_epi16(0x0e0cu));
+}
+
+// Filters 8 rows at two horizontal positions: the low lane produces the column
+// at src0 and the high lane the column at src1. The results are stored as 8
+// bytes each at dst and dst + 8.
+static void filter_horiz_w8x2_avx2(const uint8_t *const src0,
+                                   const uint8_t *const src1,
+                                   const ptrdiff_t src_stride,
+                                   uint8_t *const dst,
+                                   const int16_t *const filter0,
+                                   const int16_t *const filter1) {
+  __m256i s[8], a[4], b[4], ss[4], f[4], temp;
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    s[i] = mm256_loadu2_epi64(src0 + i * src_stride, src1 + i * src_stride);
+  }
+
+  // Per lane transpose_16bit_4x8(), giving in each lane:
+  // 00 01 10 11 20 21 30 31  40 41 50 51 60 61 70 71
+  // 02 03 12 13 22 23 32 33  42 43 52 53 62 63 72 73
+  // 04 05 14 15 24 25 34 35  44 45 54 55 64 65 74 75
+  // 06 07 16 17 26 27 36 37  46 47 56 57 66 67 76 77
+  a[0] = _mm256_unpacklo_epi16(s[0], s[1]);
+  a[1] = _mm256_unpacklo_epi16(s[2], s[3]);
+  a[2] = _mm256_unpacklo_epi16(s[4], s[5]);
+  a[3] = _mm256_unpacklo_epi16(s[6], s[7]);
+  b[0] = _mm256_unpacklo_epi32(a[0], a[1]);
+  b[1] = _mm256_unpacklo_epi32(a[2], a[3]);
+  b[2] = _mm256_unpackhi_epi32(a[0], a[1]);
+  b[3] = _mm256_unpackhi_epi32(a[2], a[3]);
+  ss[0] = _mm256_unpacklo_epi64(b[0], b[1]);
+  ss[1] = _mm256_unpackhi_epi64(b[0], b[1]);
+  ss[2] = _mm256_unpacklo_epi64(b[2], b[3]);
+  ss[3] = _mm256_unpackhi_epi64(b[2], b[3]);
+
+  shuffle_filter_x2_avx2(filter0, filter1, f);
+  temp = convolve8_16_avx2(ss, f);
+  // shrink to 8 bit each 16 bits, one column in the low 8 bytes of each lane
+  temp = _mm256_packus_epi16(temp, temp);
+  _mm_storel_epi64((__m128i *)dst, _mm256_castsi256_si128(temp));
+  _mm_storel_epi64((__m128i *)(dst + 8), _mm256_extracti128_si256(temp, 1));
+}
+
+static INLINE void copy_column_8(const uint8_t *src, const ptrdiff_t src_stride,
+                                 uint8_t *const dst) {
+  int i;
+  for (i = 0; i < 8; ++i) dst[i] = src[i * src_stride];
+}
+
+// Processes 8x8 areas like scaledconvolve_horiz_w8() in the SSSE3 version, two
+// output columns per filter pass. Only whole 8 row strips are written, so h is
+// rounded up to a multiple of 8.
+static void scaledconvolve_horiz_w8_avx2(const uint8_t *src,
+                                         const ptrdiff_t src_stride,
+                                         uint8_t *dst,
+                                         const ptrdiff_t dst_stride,
+                                         const InterpKernel *const x_filters,
+                                         const int x0_q4, const int x_step_q4,
+                                         const int w, const int h) {
+  DECLARE_ALIGNED(16, uint8_t, temp[8 * 8]);
+  int x, y, z;
+  src -= SUBPEL_TAPS / 2 - 1;
+
+  for (y = 0; y < h; y += 8) {
+    int x_q4 = x0_q4;
+    for (x = 0; x < w; x += 8) {
+      __m128i t[8];
+      for (z = 0; z < 8; z += 2) {
+        const int x_q4_1 = x_q4 + x_step_q4;
+        const uint8_t *const src_x0 = &src[x_q4 >> SUBPEL_BITS];
+        const uint8_t *const src_x1 = &src[x_q4_1 >> SUBPEL_BITS];
+        const int subpel0 = x_q4 & SUBPEL_MASK;
+        const int subpel1 = x_q4_1 & SUBPEL_MASK;
+
+        // The full-pel kernel has a tap of 128, which does not fit the signed
+        // 8-bit operand of maddubs. Such a column is a plain copy: filter the
+        // other column in both lanes and overwrite it afterwards.
+        if (subpel0 | subpel1) {
+          filter_horiz_w8x2_avx2(subpel0 ? src_x0 : src_x1,
+                                 subpel1 ? src_x1 : src_x0, src_stride,
+                                 temp + z * 8,
+                                 x_filters[subpel0 ? subpel0 : subpel1],
+                                 x_filters[subpel1 ? subpel1 : subpel0]);
+        }
+        if (!subpel0) copy_column_8(src_x0 + 3, src_stride, temp + z * 8);
+        if (!subpel1) copy_column_8(src_x1 + 3, src_stride, temp + z * 8 + 8);
+        x_q4 += 2 * x_step_q4;
+      }
+
+      // transpose the 8x8 filters values back to dst
+      load_8bit_8x8(temp, 8, t);
+      transpose_8bit_8x8(t, t);
+      store_8bit_8x8(t, dst + x, dst_stride);
+    }
+
+    src += src_stride * 8;
+    dst += dst_stride * 8;
+  }
+}
+
+// Filters 32 pixels of one row per iteration.
+static void filter_vert_w32_avx2(const uint8_t *src, const ptrdiff_t src_stride,
+                                 uint8_t *const dst,
+                                 const int16_t *const filter, const int w) {
+  __m256i f[4];
+  int i;
+  shuffle_filter_avx2(filter, f);
+
+  for (i = 0; i < w; i += 32) {
+    __m256i s[8], s_lo[4], s_hi[4], temp_lo, temp_hi;
+    int k;
+
+    for (k = 0; k < 8; ++k) {
+      s[k] = _mm256_loadu_si256((const __m256i *)(src + k * src_stride));
+    }
+
+    s_lo[0] = _mm256_unpacklo_epi8(s[0], s[1]);
+    s_hi[0] = _mm256_unpackhi_epi8(s[0], s[1]);
+    s_lo[1] = _mm256_unpacklo_epi8(s[2], s[3]);
+    s_hi[1] = _mm256_unpackhi_epi8(s[2], s[3]);
+    s_lo[2] = _mm256_unpacklo_epi8(s[4], s[5]);
+    s_hi[2] = _mm256_unpackhi_epi8(s[4], s[5]);
+    s_lo[3] = _mm256_unpacklo_epi8(s[6], s[7]);
+    s_hi[3] = _mm256_unpackhi_epi8(s[6], s[7]);
+    temp_lo = convolve8_16_avx2(s_lo, f);
+    temp_hi = convolve8_16_avx2(s_hi, f);
+
+    // unpack and pack both work per lane, so the pixel order is preserved
+    _mm256_storeu_si256((__m256i *)&dst[i],
+                        _mm256_packus_epi16(temp_lo, temp_hi));
+    src += 32;
+  }
+}
+
+// Filters two 16 pixel rows at once, row 0 in the low lane and row 1 in the
+// high lane.
+static void filter_vert_w16x2_avx2(const uint8_t *const src0,
+                                   const uint8_t *const src1,
+                                   const ptrdiff_t src_stride,
+                                   uint8_t *const dst0, uint8_t *const dst1,
+                                   const int16_t *const filter0,
+                                   const int16_t *const filter1) {
+  __m256i s[8], s_lo[4], s_hi[4], f[4], temp_lo, temp_hi;
+  int k;
+
+  for (k = 0; k < 8; ++k) {
+    s[k] = mm256_loadu2_si128(src0 + k * src_stride, src1 + k * src_stride);
+  }
+
+  s_lo[0] = _mm256_unpacklo_epi8(s[0], s[1]);
+  s_hi[0] = _mm256_unpackhi_epi8(s[0], s[1]);
+  s_lo[1] = _mm256_unpacklo_epi8(s[2], s[3]);
+  s_hi[1] = _mm256_unpackhi_epi8(s[2], s[3]);
+  s_lo[2] = _mm256_unpacklo_epi8(s[4], s[5]);
+  s_hi[2] = _mm256_unpackhi_epi8(s[4], s[5]);
+  s_lo[3] = _mm256_unpacklo_epi8(s[6], s[7]);
+  s_hi[3] = _mm256_unpackhi_epi8(s[6], s[7]);
+  shuffle_filter_x2_avx2(filter0, filter1, f);
+  temp_lo = convolve8_16_avx2(s_lo, f);
+  temp_hi = convolve8_16_avx2(s_hi, f);
+  temp_lo = _mm256_packus_epi16(temp_lo, temp_hi);
+
+  _mm_storeu_si128((__m128i *)dst0, _mm256_castsi256_si128(temp_lo));
+  _mm_storeu_si128((__m128i *)dst1, _mm256_extracti128_si256(temp_lo, 1));
+}
+
+// Filters two 8 pixel rows at once, row 0 in the low lane and row 1 in the
+// high lane.
+static void filter_vert_w8x2_avx2(const uint8_t *const src0,
+                                  const uint8_t *const src1,
+                                  const ptrdiff_t src_stride,
+                                  uint8_t *const dst0, uint8_t *const dst1,
+                                  const int16_t *const filter0,
+                                  const int16_t *const filter1) {
+  __m256i s[8], ss[4], f[4], temp;
+  int k;
+
+  for (k = 0; k < 8; ++k) {
+    s[k] = mm256_loadu2_epi64(src0 + k * src_stride, src1 + k * src_stride);
+  }
+
+  ss[0] = _mm256_unpacklo_epi8(s[0], s[1]);
+  ss[1] = _mm256_unpacklo_epi8(s[2], s[3]);
+  ss[2] = _mm256_unpacklo_epi8(s[4], s[5]);
+  ss[3] = _mm256_unpacklo_epi8(s[6], s[7]);
+  shuffle_filter_x2_avx2(filter0, filter1, f);
+  temp = convolve8_16_avx2(ss, f);
+  temp = _mm256_packus_epi16(temp, temp);
+
+  _mm_storel_epi64((__m128i *)dst0, _mm256_castsi256_si128(temp));
+  _mm_storel_epi64((__m128i *)dst1, _mm256_extracti128_si256(temp, 1));
+}
+
+// Vertical pass for widths of 8 and up. Widths below 32 do not fill a register
+// from one row, so two output rows are filtered together.
+static void scaledconvolve_vert_avx2(const uint8_t *src,
+                                     const ptrdiff_t src_stride,
+                                     uint8_t *const dst,
+                                     const ptrdiff_t dst_stride,
+                                     const InterpKernel *const y_filters,
+                                     const int y0_q4, const int y_step_q4,
+                                     const int w, const int h) {
+  int y;
+  int y_q4 = y0_q4;
+
+  src -= src_stride * (SUBPEL_TAPS / 2 - 1);
+
+  if (w >= 32) {
+    for (y = 0; y < h; ++y) {
+      const uint8_t *src_y = &src[(y_q4 >> SUBPEL_BITS) * src_stride];
+      const int16_t *const y_filter = y_filters[y_q4 & SUBPEL_MASK];
+      if (y_q4 & SUBPEL_MASK) {
+        filter_vert_w32_avx2(src_y, src_stride, &dst[y * dst_stride], y_filter,
+                             w);
+      } else {
+        memcpy(&dst[y * dst_stride], &src_y[3 * src_stride], w);
+      }
+      y_q4 += y_step_q4;
+    }
+    return;
+  }
+
+  for (y = 0; y < h; y += 2) {
+    // An odd last row is computed twice into the same place.
+    const int y_q4_1 = (y + 1 < h) ? y_q4 + y_step_q4 : y_q4;
+    const uint8_t *const src_y0 = &src[(y_q4 >> SUBPEL_BITS) * src_stride];
+    const uint8_t *const src_y1 = &src[(y_q4_1 >> SUBPEL_BITS) * src_stride];
+    const int subpel0 = y_q4 & SUBPEL_MASK;
+    const int subpel1 = y_q4_1 & SUBPEL_MASK;
+    uint8_t *const dst0 = &dst[y * dst_stride];
+    uint8_t *const dst1 = (y + 1 < h) ? dst0 + dst_stride : dst0;
+
+    // As in the horizontal pass, full-pel rows are copied and the other row
+    // goes through both lanes.
+    if (subpel0 | subpel1) {
+      const uint8_t *const s0 = subpel0 ? src_y0 : src_y1;
+      const uint8_t *const s1 = subpel1 ? src_y1 : src_y0;
+      uint8_t *const d0 = subpel0 ? dst0 : dst1;
+      uint8_t *const d1 = subpel1 ? dst1 : dst0;
+      const int16_t *const f0 = y_filters[subpel0 ? subpel0 : subpel1];
+      const int16_t *const f1 = y_filters[subpel1 ? subpel1 : subpel0];
+      if (w == 16) {
+        filter_vert_w16x2_avx2(s0, s1, src_stride, d0, d1, f0, f1);
+      } else {
+        filter_vert_w8x2_avx2(s0, s1, src_stride, d0, d1, f0, f1);
+      }
+    }
+    if (!subpel0) memcpy(dst0, &src_y0[3 * src_stride], w);
+    if (!subpel1) memcpy(dst1, &src_y1[3 * src_stride], w);
+    y_q4 = y_q4_1 + y_step_q4;
+  }
+}
+
+// 4 pixel wide blocks do not fill the 256-bit kernels above; those go through
+// the SSSE3 versions.
+void vpx_scaled_2d_avx2(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst,
+                        ptrdiff_t dst_stride, const InterpKernel *filter,
+                        int x0_q4, int x_step_q4, int y0_q4, int y_step_q4,
+                        int w, int h) {
+  // See vpx_scaled_2d_ssse3() for the derivation of the temp buffer size.
+  DECLARE_ALIGNED(32, uint8_t, temp[(135 + 8) * 64]);
+  const int intermediate_height =
+      (((h - 1) * y_step_q4 + y0_q4) >> SUBPEL_BITS) + SUBPEL_TAPS;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(y_step_q4 <= 32 || (y_step_q4 <= 64 && h <= 32));
+  assert(x_step_q4 <= 64);
+
+  if (w < 8) {
+    vpx_scaled_2d_ssse3(src, src_stride, dst, dst_stride, filter, x0_q4,
+                        x_step_q4, y0_q4, y_step_q4, w, h);
+    return;
+  }
+
+  scaledconvolve_horiz_w8_avx2(src - src_stride * (SUBPEL_TAPS / 2 - 1),
+                               src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                               w, intermediate_height);
+  scaledconvolve_vert_avx2(temp + 64 * (SUBPEL_TAPS / 2 - 1), 64, dst,
+                           dst_stride, filter, y0_q4, y_step_q4, w, h);
+}
+
+void vpx_scaled_horiz_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                           uint8_t *dst, ptrdiff_t dst_stride,
+                           const InterpKernel *filter, int x0_q4,
+                           int x_step_q4, int y0_q4, int y_step_q4, int w,
+                           int h) {
+  DECLARE_ALIGNED(32, uint8_t, temp[(64 + 8) * 64]);
+  int y;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(x_step_q4 <= 64);
+
+  if (w < 8) {
+    vpx_scaled_horiz_ssse3(src, src_stride, dst, dst_stride, filter, x0_q4,
+                           x_step_q4, y0_q4, y_step_q4, w, h);
+    return;
+  }
+
+  if (!(h & 7)) {
+    scaledconvolve_horiz_w8_avx2(src, src_stride, dst, dst_stride, filter,
+                                 x0_q4, x_step_q4, w, h);
+    return;
+  }
+
+  scaledconvolve_horiz_w8_avx2(src, src_stride, temp, 64, filter, x0_q4,
+                               x_step_q4, w, h);
+  for (y = 0; y < h; ++y) memcpy(&dst[y * dst_stride], &temp[y * 64], w);
+}
+
+void vpx_scaled_vert_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                          uint8_t *dst, ptrdiff_t dst_stride,
+                          const InterpKernel *filter, int x0_q4, int x_step_q4,
+                          int y0_q4, int y_step_q4, int w, int h) {
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(y_step_q4 <= 64);
+
+  if (w < 8) {
+    vpx_scaled_vert_ssse3(src, src_stride, dst, dst_stride, filter, x0_q4,
+                          x_step_q4, y0_q4, y_step_q4, w, h);
+    return;
+  }
+
+  scaledconvolve_vert_avx2(src, src_stride, dst, dst_stride, filter, y0_q4,
+                           y_step_q4, w, h);
+}
+
+void vpx_scaled_avg_2d_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                            uint8_t *dst, ptrdiff_t dst_stride,
+                            const InterpKernel *filter, int x0_q4,
+                            int x_step_q4, int y0_q4, int y_step_q4, int w,
+                            int h) {
+  DECLARE_ALIGNED(32, uint8_t, temp[64 * 64]);
+
+  vpx_scaled_2d_avx2(src, src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                     y0_q4, y_step_q4, w, h);
+  convolve_avg_block_sse2(temp, 64, dst, dst_stride, w, h);
+}
+
+void vpx_scaled_avg_horiz_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const InterpKernel *filter, int x0_q4,
+                               int x_step_q4, int y0_q4, int y_step_q4, int w,
+                               int h) {
+  DECLARE_ALIGNED(32, uint8_t, temp[64 * 64]);
+
+  vpx_scaled_horiz_avx2(src, src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                        y0_q4, y_step_q4, w, h);
+  convolve_avg_block_sse2(temp, 64, dst, dst_stride, w, h);
+}
+
+void vpx_scaled_avg_vert_avx2(const uint8_t *src, ptrdiff_t src_stride,
+                              uint8_t *dst, ptrdiff_t dst_stride,
+                              const InterpKernel *filter, int x0_q4,
+                              int x_step_q4, int y0_q4, int y_step_q4, int w,
+                              int h) {
+  DECLARE_ALIGNED(32, uint8_t, temp[64 * 64]);
+
+  vpx_scaled_vert_avx2(src, src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                       y0_q4, y_step_q4, w, h);
+  convolve_avg_block_sse2(temp, 64, dst, dst_stride, w, h);
+}
 #endif  // HAVE_AX2 && HAVE_SSSE3
@@ -1073,6 +1073,92 @@ void vpx_scaled_2d_ssse3(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst,
   }
 }
 
+void vpx_scaled_horiz_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                            uint8_t *dst, ptrdiff_t dst_stride,
+                            const InterpKernel *filter, int x0_q4,
+                            int x_step_q4, int y0_q4, int y_step_q4, int w,
+                            int h) {
+  // scaledconvolve_horiz_w8() always writes whole 8 row strips, up to 8 rows
+  // beyond h, so filter into temp and copy out the requested rows.
+  DECLARE_ALIGNED(16, uint8_t, temp[(64 + 8) * 64]);
+  int y;
+  (void)y0_q4;
+  (void)y_step_q4;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(x_step_q4 <= 64);
+
+  if (w >= 8) {
+    scaledconvolve_horiz_w8(src, src_stride, temp, 64, filter, x0_q4,
+                            x_step_q4, w, h);
+    for (y = 0; y < h; ++y) memcpy(&dst[y * dst_stride], &temp[y * 64], w);
+  } else {
+    scaledconvolve_horiz_w4(src, src_stride, dst, dst_stride, filter, x0_q4,
+                            x_step_q4, w, h);
+  }
+}
+
+void vpx_scaled_vert_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                           uint8_t *dst, ptrdiff_t dst_stride,
+                           const InterpKernel *filter, int x0_q4,
+                           int x_step_q4, int y0_q4, int y_step_q4, int w,
+                           int h) {
+  (void)x0_q4;
+  (void)x_step_q4;
+
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(y_step_q4 <= 64);
+
+  if (w >= 16) {
+    scaledconvolve_vert_w16(src, src_stride, dst, dst_stride, filter, y0_q4,
+                            y_step_q4, w, h);
+  } else if (w == 8) {
+    scaledconvolve_vert_w8(src, src_stride, dst, dst_stride, filter, y0_q4,
+                           y_step_q4, w, h);
+  } else {
+    scaledconvolve_vert_w4(src, src_stride, dst, dst_stride, filter, y0_q4,
+                           y_step_q4, w, h);
+  }
+}
+
+void vpx_scaled_avg_2d_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                             uint8_t *dst, ptrdiff_t dst_stride,
+                             const InterpKernel *filter, int x0_q4,
+                             int x_step_q4, int y0_q4, int y_step_q4, int w,
+                             int h) {
+  DECLARE_ALIGNED(16, uint8_t, temp[64 * 64]);
+
+  vpx_scaled_2d_ssse3(src, src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                      y0_q4, y_step_q4, w, h);
+  convolve_avg_block_sse2(temp, 64, dst, dst_stride, w, h);
+}
+
+void vpx_scaled_avg_horiz_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const InterpKernel *filter, int x0_q4,
+                                int x_step_q4, int y0_q4, int y_step_q4,
+                                int w, int h) {
+  DECLARE_ALIGNED(16, uint8_t, temp[64 * 64]);
+
+  vpx_scaled_horiz_ssse3(src, src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                         y0_q4, y_step_q4, w, h);
+  convolve_avg_block_sse2(temp, 64, dst, dst_stride, w, h);
+}
+
+void vpx_scaled_avg_vert_ssse3(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const InterpKernel *filter, int x0_q4,
+                               int x_step_q4, int y0_q4, int y_step_q4, int w,
+                               int h) {
+  DECLARE_ALIGNED(16, uint8_t, temp[64 * 64]);
+
+  vpx_scaled_vert_ssse3(src, src_stride, temp, 64, filter, x0_q4, x_step_q4,
+                        y0_q4, y_step_q4, w, h);
+  convolve_avg_block_sse2(temp, 64, dst, dst_stride, w, h);
+}
+
 // void vpx_convolve8_ssse3(const uint8_t *src, ptrdiff_t src_stride,
 //                          uint8_t *dst, ptrdiff_t dst_stride,
 //                          const InterpKernel *filter, int x0_q4,
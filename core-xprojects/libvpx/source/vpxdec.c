@@ -68,6 +68,8 @@ static const arg_def_t limitarg =
     ARG_DEF(NULL, "limit", 1, "Stop decoding after n frames");
 static const arg_def_t skiparg =
     ARG_DEF(NULL, "skip", 1, "Skip the first n input frames");
+static const arg_def_t seekarg = ARG_DEF(
+    NULL, "seek", 1, "Start output at the frame shown at n ms (WebM only)");
 static const arg_def_t postprocarg =
     ARG_DEF(NULL, "postproc", 0, "Postprocess decoded frames");
 static const arg_def_t summaryarg =
@@ -114,6 +116,7 @@ static const arg_def_t *all_args[] = { &help,
                                        &progressarg,
                                        &limitarg,
                                        &skiparg,
+                                       &seekarg,
                                        &postprocarg,
                                        &summaryarg,
                                        &outputfile,
@@ -526,6 +529,8 @@ static int main_loop(int argc, const char **argv_) {
   int do_md5 = 0, progress = 0;
   int stop_after = 0, postproc = 0, summary = 0, quiet = 1;
   int arg_skip = 0;
+  int seek = 0, seek_pending = 0;
+  unsigned int seek_ms = 0;
   int ec_enabled = 0;
   int keep_going = 0;
   int enable_row_mt = 0;
@@ -617,7 +622,10 @@ static int main_loop(int argc, const char **argv_) {
       stop_after = arg_parse_uint(&arg);
     else if (arg_match(&arg, &skiparg, argi))
       arg_skip = arg_parse_uint(&arg);
-    else if (arg_match(&arg, &postprocarg, argi))
+    else if (arg_match(&arg, &seekarg, argi)) {
+      seek = 1;
+      seek_ms = arg_parse_uint(&arg);
+    } else if (arg_match(&arg, &postprocarg, argi))
       postproc = 1;
     else if (arg_match(&arg, &md5arg, argi))
       do_md5 = 1;
@@ -824,6 +832,49 @@ static int main_loop(int argc, const char **argv_) {
     }
   }
 
+#if CONFIG_WEBM_IO
+  if (seek) {
+    const uint64_t target_ns = (uint64_t)seek_ms * 1000000;
+    if (input.vpx_input_ctx->file_type != FILE_TYPE_WEBM ||
+        webm_seek_to_keyframe(input.webm_ctx, target_ns)) {
+      fprintf(stderr, "Failed to seek to %u ms.\n", seek_ms);
+      goto fail;
+    }
+
+    // Decode from the keyframe up to the target without output. Frames no
+    // later frame depends on are only parsed.
+    if (interface->fourcc == VP9_FOURCC &&
+        vpx_codec_control(&decoder, VP9D_SET_SKIP_NON_REF_FRAMES, 1)) {
+      fprintf(stderr, "Failed to skip non-reference frames: %s\n",
+              vpx_codec_error(&decoder));
+      goto fail;
+    }
+    while (!dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) {
+      if (input.webm_ctx->timestamp_ns >= target_ns) {
+        seek_pending = 1;
+        break;
+      }
+      if (vpx_codec_decode(&decoder, buf, (unsigned int)bytes_in_buffer, NULL,
+                           0)) {
+        warn("Failed to decode frame before seek target: %s",
+             vpx_codec_error(&decoder));
+        if (!keep_going) goto fail;
+      }
+    }
+    if (interface->fourcc == VP9_FOURCC &&
+        vpx_codec_control(&decoder, VP9D_SET_SKIP_NON_REF_FRAMES, 0)) {
+      fprintf(stderr, "Failed to re-enable non-reference frames: %s\n",
+              vpx_codec_error(&decoder));
+      goto fail;
+    }
+  }
+#else
+  if (seek) {
+    fprintf(stderr, "Seeking requires WebM support (%u ms).\n", seek_ms);
+    goto fail;
+  }
+#endif
+
   frame_avail = 1;
   got_data = 0;
 
@@ -838,7 +889,9 @@ static int main_loop(int argc, const char **argv_) {
 
     frame_avail = 0;
     if (!stop_after || frame_in < stop_after) {
-      if (!dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) {
+      if (seek_pending ||
+          !dec_read_frame(&input, &buf, &bytes_in_buffer, &buffer_size)) {
+        seek_pending = 0;
         frame_avail = 1;
         frame_in++;
 
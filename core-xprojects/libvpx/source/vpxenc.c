@@ -49,6 +49,9 @@
 #include "./webmenc.h"
 #endif
 #include "./y4minput.h"
+#if CONFIG_MULTITHREAD
+#include "vpx_util/vpx_thread.h"
+#endif
 
 static size_t wrap_fwrite(const void *ptr, size_t size, size_t nmemb,
                           FILE *stream) {
@@ -145,6 +148,10 @@ static const arg_def_t framerate =
     ARG_DEF(NULL, "fps", 1, "Stream frame rate (rate/scale)");
 static const arg_def_t use_webm =
     ARG_DEF(NULL, "webm", 0, "Output WebM (default when WebM IO is enabled)");
+static const arg_def_t webm_live =
+    ARG_DEF(NULL, "webm-live", 0,
+            "Output live WebM: no seeking or cues, so pipes work, and "
+            "clusters start at key frames");
 static const arg_def_t use_ivf = ARG_DEF(NULL, "ivf", 0, "Output IVF");
 static const arg_def_t out_part =
     ARG_DEF("P", "output-partitions", 0,
@@ -159,6 +166,10 @@ static const arg_def_t disable_warnings =
 static const arg_def_t disable_warning_prompt =
     ARG_DEF("y", "disable-warning-prompt", 0,
             "Display warnings, but do not prompt user to continue.");
+static const arg_def_t parallel_streams =
+    ARG_DEF(NULL, "parallel-streams", 1,
+            "Encode each stream on its own thread, queueing up to n frames "
+            "per stream (0: off)");
 
 #if CONFIG_VP9_HIGHBITDEPTH
 static const arg_def_t test16bitinternalarg = ARG_DEF(
@@ -182,12 +193,14 @@ static const arg_def_t *main_args[] = { &help,
                                         &verbosearg,
                                         &psnrarg,
                                         &use_webm,
+                                        &webm_live,
                                         &use_ivf,
                                         &out_part,
                                         &q_hist_n,
                                         &rate_hist_n,
                                         &disable_warnings,
                                         &disable_warning_prompt,
+                                        &parallel_streams,
                                         &recontest,
                                         NULL };
 
@@ -396,6 +409,9 @@ static const arg_def_t token_parts =
     ARG_DEF(NULL, "token-parts", 1, "Number of token partitions to use, log2");
 static const arg_def_t screen_content_mode =
     ARG_DEF(NULL, "screen-content-mode", 1, "Screen content mode");
+static const arg_def_t recode_free_rc = ARG_DEF(
+    NULL, "recode-free-rc", 1,
+    "Size frames from the first encode instead of recoding them (0..1)");
 static const arg_def_t *vp8_args[] = { &cpu_used_vp8,
                                        &auto_altref_vp8,
                                        &noise_sens,
@@ -410,6 +426,7 @@ static const arg_def_t *vp8_args[] = { &cpu_used_vp8,
                                        &max_intra_rate_pct,
                                        &gf_cbr_boost_pct,
                                        &screen_content_mode,
+                                       &recode_free_rc,
                                        NULL };
 static const int vp8_arg_ctrl_map[] = { VP8E_SET_CPUUSED,
                                         VP8E_SET_ENABLEAUTOALTREF,
@@ -425,6 +442,7 @@ static const int vp8_arg_ctrl_map[] = { VP8E_SET_CPUUSED,
                                         VP8E_SET_MAX_INTRA_BITRATE_PCT,
                                         VP8E_SET_GF_CBR_BOOST_PCT,
                                         VP8E_SET_SCREEN_CONTENT_MODE,
+                                        VP8E_SET_RECODE_FREE_RC,
                                         0 };
 #endif
 
@@ -526,6 +544,26 @@ static const arg_def_t disable_loopfilter =
             "0: Loopfilter on for all frames (default)\n"
             "1: Loopfilter off for non reference frames\n"
             "2: Loopfilter off for all frames");
+
+static const arg_def_t pyramid_me =
+    ARG_DEF(NULL, "pyramid-me", 1,
+            "Seed motion search with frame level pyramid motion estimation "
+            "(0: off (default), 1: on)");
+
+static const arg_def_t frame_time_budget =
+    ARG_DEF(NULL, "frame-time-budget", 1,
+            "Adapt the realtime speed to this encode time per frame in "
+            "microseconds (0: off (default))");
+
+static const arg_def_t scene_cut_key_frame =
+    ARG_DEF(NULL, "scene-cut-kf", 1,
+            "Code scene cuts as key frames in one pass CBR mode "
+            "(0: off (default), 1: on)");
+
+static const arg_def_t async_psnr =
+    ARG_DEF(NULL, "async-psnr", 1,
+            "Compute PSNR in the background while the next frame is coded "
+            "(0: off (default), 1: on)");
 #endif
 
 #if CONFIG_VP9_ENCODER
@@ -557,6 +595,10 @@ static const arg_def_t *vp9_args[] = { &cpu_used_vp9,
                                        &target_level,
                                        &row_mt,
                                        &disable_loopfilter,
+                                       &pyramid_me,
+                                       &frame_time_budget,
+                                       &scene_cut_key_frame,
+                                       &async_psnr,
 // NOTE: The entries above have a corresponding entry in vp9_arg_ctrl_map. The
 // entries below do not have a corresponding entry in vp9_arg_ctrl_map. They
 // must be listed at the end of vp9_args.
@@ -593,6 +635,10 @@ static const int vp9_arg_ctrl_map[] = { VP8E_SET_CPUUSED,
                                         VP9E_SET_TARGET_LEVEL,
                                         VP9E_SET_ROW_MT,
                                         VP9E_SET_DISABLE_LOOPFILTER,
+                                        VP9E_SET_PYRAMID_ME,
+                                        VP9E_SET_FRAME_TIME_BUDGET,
+                                        VP9E_SET_SCENE_CUT_KEY_FRAME,
+                                        VP9E_SET_ASYNC_PSNR,
                                         0 };
 #endif
 
@@ -700,6 +746,20 @@ struct stream_state {
   struct vpx_image *img;
   vpx_codec_ctx_t decoder;
   int mismatch_seen;
+  FileOffset ivf_header_pos;
+  size_t ivf_frame_size;
+  /* Stream whose scaled source this stream is downscaled from, or NULL to
+   * scale from the input frame.
+   */
+  struct stream_state *scale_parent;
+  /* Image the scaled source of the current frame is written to, and whether
+   * it has been written yet.
+   */
+  struct vpx_image *source;
+  int source_ready;
+#if CONFIG_MULTITHREAD
+  struct stream_queue *queue;
+#endif
 };
 
 static void validate_positive_rational(const char *msg,
@@ -799,10 +859,19 @@ static void parse_global_config(struct VpxEncoderConfig *global, char **argv) {
       global->disable_warnings = 1;
     else if (arg_match(&arg, &disable_warning_prompt, argi))
       global->disable_warning_prompt = 1;
+    else if (arg_match(&arg, &parallel_streams, argi))
+      global->parallel_streams = arg_parse_uint(&arg);
     else
       argj++;
   }
 
+#if !CONFIG_MULTITHREAD
+  if (global->parallel_streams) {
+    warn("Built without multithreading support, encoding streams serially\n");
+    global->parallel_streams = 0;
+  }
+#endif
+
   if (global->pass) {
     /* DWIM: Assume the user meant passes=2 if pass=2 is specified */
     if (global->pass > global->passes) {
@@ -869,6 +938,7 @@ static struct stream_state *new_stream(struct VpxEncoderConfig *global,
 #if CONFIG_WEBM_IO
     stream->config.stereo_fmt = STEREO_FORMAT_MONO;
     stream->webm_ctx.last_pts_ns = -1;
+    stream->webm_ctx.live = 0;
     stream->webm_ctx.writer = NULL;
     stream->webm_ctx.segment = NULL;
 #endif
@@ -938,6 +1008,13 @@ static int parse_stream_params(struct VpxEncoderConfig *global,
       config->write_webm = 1;
 #else
       die("Error: --webm specified but webm is disabled.");
+#endif
+    } else if (arg_match(&arg, &webm_live, argi)) {
+#if CONFIG_WEBM_IO
+      config->write_webm = 1;
+      stream->webm_ctx.live = 1;
+#else
+      die("Error: --webm-live specified but webm is disabled.");
 #endif
     } else if (arg_match(&arg, &use_ivf, argi)) {
       config->write_webm = 0;
@@ -1264,8 +1341,9 @@ static void open_output_file(struct stream_state *stream,
 
   if (!stream->file) fatal("Failed to open output file");
 
-  if (stream->config.write_webm && fseek(stream->file, 0, SEEK_CUR))
-    fatal("WebM output to pipes not supported.");
+  if (stream->config.write_webm && !stream->webm_ctx.live &&
+      fseek(stream->file, 0, SEEK_CUR))
+    fatal("WebM output to pipes not supported, use --webm-live.");
 
 #if CONFIG_WEBM_IO
   if (stream->config.write_webm) {
@@ -1362,6 +1440,117 @@ static void initialize_encoder(struct stream_state *stream,
 #endif
 }
 
+static void scale_image(struct stream_state *stream, vpx_image_t *src,
+                        vpx_image_t *dst) {
+  const int highbd = CONFIG_VP9_HIGHBITDEPTH &&
+                     (src->fmt & VPX_IMG_FMT_HIGHBITDEPTH) != 0;
+
+  if (highbd && src->fmt != VPX_IMG_FMT_I42016) {
+    fprintf(stderr, "%s can only scale 4:2:0 inputs\n", exec_name);
+    exit(EXIT_FAILURE);
+  }
+  if (!highbd && src->fmt != VPX_IMG_FMT_I420 &&
+      src->fmt != VPX_IMG_FMT_YV12) {
+    fprintf(stderr, "%s can only scale 4:2:0 8bpp inputs\n", exec_name);
+    exit(EXIT_FAILURE);
+  }
+#if CONFIG_LIBYUV
+  if (highbd) {
+    I420Scale_16(
+        (uint16_t *)src->planes[VPX_PLANE_Y], src->stride[VPX_PLANE_Y] / 2,
+        (uint16_t *)src->planes[VPX_PLANE_U], src->stride[VPX_PLANE_U] / 2,
+        (uint16_t *)src->planes[VPX_PLANE_V], src->stride[VPX_PLANE_V] / 2,
+        src->d_w, src->d_h, (uint16_t *)dst->planes[VPX_PLANE_Y],
+        dst->stride[VPX_PLANE_Y] / 2, (uint16_t *)dst->planes[VPX_PLANE_U],
+        dst->stride[VPX_PLANE_U] / 2, (uint16_t *)dst->planes[VPX_PLANE_V],
+        dst->stride[VPX_PLANE_V] / 2, dst->d_w, dst->d_h, kFilterBox);
+  } else {
+    I420Scale(src->planes[VPX_PLANE_Y], src->stride[VPX_PLANE_Y],
+              src->planes[VPX_PLANE_U], src->stride[VPX_PLANE_U],
+              src->planes[VPX_PLANE_V], src->stride[VPX_PLANE_V], src->d_w,
+              src->d_h, dst->planes[VPX_PLANE_Y], dst->stride[VPX_PLANE_Y],
+              dst->planes[VPX_PLANE_U], dst->stride[VPX_PLANE_U],
+              dst->planes[VPX_PLANE_V], dst->stride[VPX_PLANE_V], dst->d_w,
+              dst->d_h, kFilterBox);
+  }
+  (void)stream;
+#else
+  (void)dst;
+  stream->encoder.err = 1;
+  ctx_exit_on_error(&stream->encoder,
+                    "Stream %d: Failed to encode frame.\n"
+                    "Scaling disabled in this configuration. \n"
+                    "To enable, configure with --enable-libyuv\n",
+                    stream->index);
+#endif
+}
+
+static int needs_scaling(const struct stream_state *stream, int width,
+                         int height) {
+  return stream->config.cfg.g_w != (unsigned int)width ||
+         stream->config.cfg.g_h != (unsigned int)height;
+}
+
+/* Builds the tree the streams' sources are downscaled through. Each stream
+ * that needs scaling is downscaled from the smallest other scaled stream
+ * that is at least as large in both dimensions, so that a ladder such as
+ * 1080p/720p/480p/360p is scaled 1080p->720p->480p->360p and each step only
+ * reads an image close to its own size. Streams of equal size are chained
+ * in stream order, which keeps the tree acyclic.
+ */
+static void setup_scale_tree(struct stream_state *streams, int width,
+                             int height) {
+  struct stream_state *stream;
+  struct stream_state *parent;
+
+  for (stream = streams; stream; stream = stream->next) {
+    const unsigned int w = stream->config.cfg.g_w;
+    const unsigned int h = stream->config.cfg.g_h;
+
+    stream->scale_parent = NULL;
+    if (!needs_scaling(stream, width, height)) continue;
+
+    for (parent = streams; parent; parent = parent->next) {
+      const unsigned int pw = parent->config.cfg.g_w;
+      const unsigned int ph = parent->config.cfg.g_h;
+
+      if (parent == stream || !needs_scaling(parent, width, height)) continue;
+      if (pw < w || ph < h) continue;
+      if (pw == w && ph == h && parent->index > stream->index) continue;
+      if (!stream->scale_parent ||
+          (uint64_t)pw * ph < (uint64_t)stream->scale_parent->config.cfg.g_w *
+                                  stream->scale_parent->config.cfg.g_h)
+        stream->scale_parent = parent;
+    }
+  }
+}
+
+/* Returns the current frame at the stream's configured size, downscaling it
+ * from the stream's parent in the scale tree (and the parent from its own,
+ * as needed) the first time it is requested for this frame.
+ */
+static vpx_image_t *get_stream_source(struct stream_state *stream,
+                                      vpx_image_t *img) {
+  const struct vpx_codec_enc_cfg *cfg = &stream->config.cfg;
+  vpx_image_t *src = img;
+
+  if (!needs_scaling(stream, img->d_w, img->d_h)) return img;
+  if (stream->source_ready) return stream->source;
+
+  if (stream->scale_parent) src = get_stream_source(stream->scale_parent, img);
+  if (!stream->source) {
+    stream->img = vpx_img_alloc(NULL,
+                                (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH)
+                                    ? VPX_IMG_FMT_I42016
+                                    : VPX_IMG_FMT_I420,
+                                cfg->g_w, cfg->g_h, 16);
+    stream->source = stream->img;
+  }
+  scale_image(stream, src, stream->source);
+  stream->source_ready = 1;
+  return stream->source;
+}
+
 static void encode_frame(struct stream_state *stream,
                          struct VpxEncoderConfig *global, struct vpx_image *img,
                          unsigned int frames_in) {
@@ -1376,70 +1565,7 @@ static void encode_frame(struct stream_state *stream,
       (cfg->g_timebase.den * (int64_t)(frames_in)*global->framerate.den) /
       cfg->g_timebase.num / global->framerate.num;
 
-/* Scale if necessary */
-#if CONFIG_VP9_HIGHBITDEPTH
-  if (img) {
-    if ((img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) &&
-        (img->d_w != cfg->g_w || img->d_h != cfg->g_h)) {
-      if (img->fmt != VPX_IMG_FMT_I42016) {
-        fprintf(stderr, "%s can only scale 4:2:0 inputs\n", exec_name);
-        exit(EXIT_FAILURE);
-      }
-#if CONFIG_LIBYUV
-      if (!stream->img) {
-        stream->img =
-            vpx_img_alloc(NULL, VPX_IMG_FMT_I42016, cfg->g_w, cfg->g_h, 16);
-      }
-      I420Scale_16(
-          (uint16_t *)img->planes[VPX_PLANE_Y], img->stride[VPX_PLANE_Y] / 2,
-          (uint16_t *)img->planes[VPX_PLANE_U], img->stride[VPX_PLANE_U] / 2,
-          (uint16_t *)img->planes[VPX_PLANE_V], img->stride[VPX_PLANE_V] / 2,
-          img->d_w, img->d_h, (uint16_t *)stream->img->planes[VPX_PLANE_Y],
-          stream->img->stride[VPX_PLANE_Y] / 2,
-          (uint16_t *)stream->img->planes[VPX_PLANE_U],
-          stream->img->stride[VPX_PLANE_U] / 2,
-          (uint16_t *)stream->img->planes[VPX_PLANE_V],
-          stream->img->stride[VPX_PLANE_V] / 2, stream->img->d_w,
-          stream->img->d_h, kFilterBox);
-      img = stream->img;
-#else
-      stream->encoder.err = 1;
-      ctx_exit_on_error(&stream->encoder,
-                        "Stream %d: Failed to encode frame.\n"
-                        "Scaling disabled in this configuration. \n"
-                        "To enable, configure with --enable-libyuv\n",
-                        stream->index);
-#endif
-    }
-  }
-#endif
-  if (img && (img->d_w != cfg->g_w || img->d_h != cfg->g_h)) {
-    if (img->fmt != VPX_IMG_FMT_I420 && img->fmt != VPX_IMG_FMT_YV12) {
-      fprintf(stderr, "%s can only scale 4:2:0 8bpp inputs\n", exec_name);
-      exit(EXIT_FAILURE);
-    }
-#if CONFIG_LIBYUV
-    if (!stream->img)
-      stream->img =
-          vpx_img_alloc(NULL, VPX_IMG_FMT_I420, cfg->g_w, cfg->g_h, 16);
-    I420Scale(
-        img->planes[VPX_PLANE_Y], img->stride[VPX_PLANE_Y],
-        img->planes[VPX_PLANE_U], img->stride[VPX_PLANE_U],
-        img->planes[VPX_PLANE_V], img->stride[VPX_PLANE_V], img->d_w, img->d_h,
-        stream->img->planes[VPX_PLANE_Y], stream->img->stride[VPX_PLANE_Y],
-        stream->img->planes[VPX_PLANE_U], stream->img->stride[VPX_PLANE_U],
-        stream->img->planes[VPX_PLANE_V], stream->img->stride[VPX_PLANE_V],
-        stream->img->d_w, stream->img->d_h, kFilterBox);
-    img = stream->img;
-#else
-    stream->encoder.err = 1;
-    ctx_exit_on_error(&stream->encoder,
-                      "Stream %d: Failed to encode frame.\n"
-                      "Scaling disabled in this configuration. \n"
-                      "To enable, configure with --enable-libyuv\n",
-                      stream->index);
-#endif
-  }
+  if (img) img = get_stream_source(stream, img);
 
   vpx_usec_timer_start(&timer);
   vpx_codec_encode(&stream->encoder, img, frame_start,
@@ -1469,15 +1595,12 @@ static void get_cx_data(struct stream_state *stream,
 
   *got_data = 0;
   while ((pkt = vpx_codec_get_cx_data(&stream->encoder, &iter))) {
-    static size_t fsize = 0;
-    static FileOffset ivf_header_pos = 0;
-
     switch (pkt->kind) {
       case VPX_CODEC_CX_FRAME_PKT:
         if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
           stream->frames_out++;
         }
-        if (!global->quiet)
+        if (!global->quiet && !global->parallel_streams)
           fprintf(stderr, " %6luF", (unsigned long)pkt->data.frame.sz);
 
         update_rate_histogram(stream->rate_hist, cfg, pkt);
@@ -1488,17 +1611,18 @@ static void get_cx_data(struct stream_state *stream,
 #endif
         if (!stream->config.write_webm) {
           if (pkt->data.frame.partition_id <= 0) {
-            ivf_header_pos = ftello(stream->file);
-            fsize = pkt->data.frame.sz;
+            stream->ivf_header_pos = ftello(stream->file);
+            stream->ivf_frame_size = pkt->data.frame.sz;
 
-            ivf_write_frame_header(stream->file, pkt->data.frame.pts, fsize);
+            ivf_write_frame_header(stream->file, pkt->data.frame.pts,
+                                   stream->ivf_frame_size);
           } else {
-            fsize += pkt->data.frame.sz;
+            stream->ivf_frame_size += pkt->data.frame.sz;
 
             if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
               const FileOffset currpos = ftello(stream->file);
-              fseeko(stream->file, ivf_header_pos, SEEK_SET);
-              ivf_write_frame_size(stream->file, fsize);
+              fseeko(stream->file, stream->ivf_header_pos, SEEK_SET);
+              ivf_write_frame_size(stream->file, stream->ivf_frame_size);
               fseeko(stream->file, currpos, SEEK_SET);
             }
           }
@@ -1537,7 +1661,7 @@ static void get_cx_data(struct stream_state *stream,
           stream->psnr_sse_total += pkt->data.psnr.sse[0];
           stream->psnr_samples_total += pkt->data.psnr.samples[0];
           for (i = 0; i < 4; i++) {
-            if (!global->quiet)
+            if (!global->quiet && !global->parallel_streams)
               fprintf(stderr, "%.3f ", pkt->data.psnr.psnr[i]);
             stream->psnr_totals[i] += pkt->data.psnr.psnr[i];
           }
@@ -1567,6 +1691,23 @@ static void show_psnr(struct stream_state *stream, double peak) {
   fprintf(stderr, "\n");
 }
 
+#if CONFIG_VP8_ENCODER
+static void show_recode_stats(struct stream_state *stream) {
+  vpx_recode_stats_t stats;
+
+  if (vpx_codec_control(&stream->encoder, VP8E_GET_RECODE_STATS, &stats) ||
+      !stats.frames)
+    return;
+
+  fprintf(stderr,
+          "Stream %d recodes %" PRIu64 " requantizations %" PRIu64
+          " in %" PRIu64 " frames, %" PRIu64 " of %" PRIu64
+          " us encoding them again\n",
+          stream->index, stats.recodes, stats.requantizations, stats.frames,
+          stats.extra_encode_us, stats.encode_us);
+}
+#endif
+
 static float usec_to_fps(uint64_t usec, unsigned int frames) {
   return (float)(usec > 0 ? frames * 1000000.0 / (float)usec : 0);
 }
@@ -1648,6 +1789,189 @@ static void test_decode(struct stream_state *stream,
   vpx_img_free(&dec_img);
 }
 
+#if CONFIG_MULTITHREAD
+/* Bounded queue of source frames between the main thread, which reads and
+ * scales the input, and a stream's encoder thread. Each stream owns its
+ * slots, so a frame is released as soon as that stream has encoded it and
+ * a slow stream only stalls the input once its queue is full.
+ */
+struct stream_queue {
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  pthread_t thread;
+  struct VpxEncoderConfig *global;
+  vpx_image_t *frames;
+  unsigned int *frame_numbers;
+  int size;
+  int head;
+  int count;
+  int eos;
+};
+
+static void encode_and_write_frame(struct stream_state *stream,
+                                   struct VpxEncoderConfig *global,
+                                   vpx_image_t *img, unsigned int frames_in,
+                                   int *got_data) {
+  encode_frame(stream, global, img, frames_in);
+  update_quantizer_histogram(stream);
+  get_cx_data(stream, global, got_data);
+  if (*got_data && global->test_decode != TEST_DECODE_OFF)
+    test_decode(stream, global->test_decode, global->codec);
+}
+
+static THREADFN stream_thread(void *arg) {
+  struct stream_state *const stream = (struct stream_state *)arg;
+  struct stream_queue *const queue = stream->queue;
+  unsigned int frames_in = 0;
+  int got_data;
+
+  for (;;) {
+    vpx_image_t *img;
+
+    pthread_mutex_lock(&queue->mutex);
+    while (!queue->count && !queue->eos)
+      pthread_cond_wait(&queue->cond, &queue->mutex);
+    if (!queue->count) {
+      pthread_mutex_unlock(&queue->mutex);
+      break;
+    }
+    img = &queue->frames[queue->head];
+    frames_in = queue->frame_numbers[queue->head];
+    pthread_mutex_unlock(&queue->mutex);
+
+    encode_and_write_frame(stream, queue->global, img, frames_in, &got_data);
+
+    pthread_mutex_lock(&queue->mutex);
+    queue->head = (queue->head + 1) % queue->size;
+    --queue->count;
+    pthread_cond_signal(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+  }
+
+  /* Flush the frames the encoder is still holding. */
+  do {
+    encode_and_write_frame(stream, queue->global, NULL, frames_in, &got_data);
+  } while (got_data);
+
+  return THREAD_RETURN(NULL);
+}
+
+static void stream_queue_start(struct stream_state *stream,
+                               struct VpxEncoderConfig *global) {
+  struct stream_queue *const queue = calloc(1, sizeof(*queue));
+
+  if (!queue) fatal("Failed to allocate frame queue");
+  queue->global = global;
+  queue->size = global->parallel_streams;
+  queue->frames = calloc(queue->size, sizeof(*queue->frames));
+  queue->frame_numbers = calloc(queue->size, sizeof(*queue->frame_numbers));
+  if (!queue->frames || !queue->frame_numbers)
+    fatal("Failed to allocate frame queue");
+  pthread_mutex_init(&queue->mutex, NULL);
+  pthread_cond_init(&queue->cond, NULL);
+  stream->queue = queue;
+  if (pthread_create(&queue->thread, NULL, stream_thread, stream))
+    fatal("Stream %d: Failed to create encoder thread", stream->index);
+}
+
+/* Waits for a free slot in the stream's queue and makes it the destination
+ * the stream's source for img is written to.
+ */
+static void stream_queue_reserve(struct stream_state *stream,
+                                 const vpx_image_t *img) {
+  struct stream_queue *const queue = stream->queue;
+  vpx_image_t *slot;
+
+  pthread_mutex_lock(&queue->mutex);
+  while (queue->count == queue->size)
+    pthread_cond_wait(&queue->cond, &queue->mutex);
+  slot = &queue->frames[(queue->head + queue->count) % queue->size];
+  pthread_mutex_unlock(&queue->mutex);
+
+  if (!slot->img_data) {
+    if (needs_scaling(stream, img->d_w, img->d_h)) {
+      vpx_img_alloc(slot,
+                    (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? VPX_IMG_FMT_I42016
+                                                          : VPX_IMG_FMT_I420,
+                    stream->config.cfg.g_w, stream->config.cfg.g_h, 16);
+    } else {
+      vpx_img_alloc(slot, img->fmt, img->d_w, img->d_h, 16);
+    }
+    if (!slot->img_data) fatal("Failed to allocate frame queue");
+  }
+  stream->source = slot;
+  stream->source_ready = 0;
+}
+
+static void copy_image(const vpx_image_t *src, vpx_image_t *dst) {
+  const int bytes_per_sample = (src->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  int plane;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const unsigned char *src_row = src->planes[plane];
+    unsigned char *dst_row = dst->planes[plane];
+    int w = vpx_img_plane_width(src, plane) * bytes_per_sample;
+    const int h = vpx_img_plane_height(src, plane);
+    int y;
+
+    /* NV12 interleaves U and V in the U plane. */
+    if (src->fmt == VPX_IMG_FMT_NV12 && plane > 0) {
+      if (plane == 2) break;
+      w *= 2;
+    }
+    for (y = 0; y < h; ++y) {
+      memcpy(dst_row, src_row, w);
+      src_row += src->stride[plane];
+      dst_row += dst->stride[plane];
+    }
+  }
+  dst->bit_depth = src->bit_depth;
+}
+
+/* Writes the stream's source for img into the slot reserved by
+ * stream_queue_reserve() and hands it to the stream's encoder thread. All
+ * streams must have reserved their slot first, since a stream may be scaled
+ * from another stream's slot.
+ */
+static void stream_queue_push(struct stream_state *stream, vpx_image_t *img,
+                              unsigned int frames_in) {
+  struct stream_queue *const queue = stream->queue;
+  vpx_image_t *const src = get_stream_source(stream, img);
+
+  if (src != stream->source) copy_image(src, stream->source);
+
+  pthread_mutex_lock(&queue->mutex);
+  queue->frame_numbers[(queue->head + queue->count) % queue->size] =
+      frames_in;
+  ++queue->count;
+  pthread_cond_signal(&queue->cond);
+  pthread_mutex_unlock(&queue->mutex);
+}
+
+/* Signals the end of the input and waits for the stream's encoder thread to
+ * drain its queue and flush the encoder.
+ */
+static void stream_queue_finish(struct stream_state *stream) {
+  struct stream_queue *const queue = stream->queue;
+  int i;
+
+  pthread_mutex_lock(&queue->mutex);
+  queue->eos = 1;
+  pthread_cond_signal(&queue->cond);
+  pthread_mutex_unlock(&queue->mutex);
+  pthread_join(queue->thread, NULL);
+
+  for (i = 0; i < queue->size; ++i) vpx_img_free(&queue->frames[i]);
+  pthread_mutex_destroy(&queue->mutex);
+  pthread_cond_destroy(&queue->cond);
+  free(queue->frames);
+  free(queue->frame_numbers);
+  free(queue);
+  stream->queue = NULL;
+  stream->source = NULL;
+}
+#endif  // CONFIG_MULTITHREAD
+
 static void print_time(const char *label, int64_t etl) {
   int64_t hours;
   int64_t mins;
@@ -1845,6 +2169,7 @@ int main(int argc, const char **argv_) {
     FOREACH_STREAM(
         open_output_file(stream, &global, &input.pixel_aspect_ratio));
     FOREACH_STREAM(initialize_encoder(stream, &global));
+    setup_scale_tree(streams, input.width, input.height);
 
 #if CONFIG_VP9_HIGHBITDEPTH
     if (strcmp(global.codec->name, "vp9") == 0) {
@@ -1865,6 +2190,11 @@ int main(int argc, const char **argv_) {
     }
 #endif
 
+#if CONFIG_MULTITHREAD
+    if (global.parallel_streams)
+      FOREACH_STREAM(stream_queue_start(stream, &global));
+#endif
+
     frame_avail = 1;
     got_data = 0;
 
@@ -1882,7 +2212,7 @@ int main(int argc, const char **argv_) {
           float fps = usec_to_fps(cx_time, seen_frames);
           fprintf(stderr, "\rPass %d/%d ", pass + 1, global.passes);
 
-          if (stream_cnt == 1)
+          if (stream_cnt == 1 && !global.parallel_streams)
             fprintf(stderr, "frame %4d/%-4d %7" PRId64 "B ", frames_in,
                     streams->frames_out, (int64_t)streams->nbytes);
           else
@@ -1915,7 +2245,27 @@ int main(int argc, const char **argv_) {
         } else {
           frame_to_encode = &raw;
         }
+#else
+        vpx_image_t *frame_to_encode = &raw;
+#endif
+#if CONFIG_MULTITHREAD
+        if (global.parallel_streams) {
+          if (frame_avail) {
+            vpx_usec_timer_start(&timer);
+            FOREACH_STREAM(stream_queue_reserve(stream, frame_to_encode));
+            FOREACH_STREAM(
+                stream_queue_push(stream, frame_to_encode, frames_in));
+            vpx_usec_timer_mark(&timer);
+            cx_time += vpx_usec_timer_elapsed(&timer);
+          }
+          fflush(stdout);
+          if (!global.quiet) fprintf(stderr, "\033[K");
+          continue;
+        }
+#endif
+        FOREACH_STREAM(stream->source_ready = 0);
         vpx_usec_timer_start(&timer);
+#if CONFIG_VP9_HIGHBITDEPTH
         if (use_16bit_internal) {
           assert(frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH);
           FOREACH_STREAM({
@@ -1932,8 +2282,8 @@ int main(int argc, const char **argv_) {
                                       frames_in));
         }
 #else
-        vpx_usec_timer_start(&timer);
-        FOREACH_STREAM(encode_frame(stream, &global, frame_avail ? &raw : NULL,
+        FOREACH_STREAM(encode_frame(stream, &global,
+                                    frame_avail ? frame_to_encode : NULL,
                                     frames_in));
 #endif
         vpx_usec_timer_mark(&timer);
@@ -1979,6 +2329,17 @@ int main(int argc, const char **argv_) {
       if (!global.quiet) fprintf(stderr, "\033[K");
     }
 
+#if CONFIG_MULTITHREAD
+    if (global.parallel_streams) {
+      struct vpx_usec_timer timer;
+
+      vpx_usec_timer_start(&timer);
+      FOREACH_STREAM(stream_queue_finish(stream));
+      vpx_usec_timer_mark(&timer);
+      cx_time += vpx_usec_timer_elapsed(&timer);
+    }
+#endif
+
     if (stream_cnt > 1) fprintf(stderr, "\n");
 
     if (!global.quiet) {
@@ -2007,6 +2368,12 @@ int main(int argc, const char **argv_) {
       }
     }
 
+#if CONFIG_VP8_ENCODER
+    if (global.verbose && global.codec->fourcc == VP8_FOURCC) {
+      FOREACH_STREAM(show_recode_stats(stream));
+    }
+#endif
+
     FOREACH_STREAM(vpx_codec_destroy(&stream->encoder));
 
     if (global.test_decode != TEST_DECODE_OFF) {
@@ -2055,6 +2422,7 @@ int main(int argc, const char **argv_) {
   if (allocated_raw_shift) vpx_img_free(&raw_shift);
 #endif
   vpx_img_free(&raw);
+  FOREACH_STREAM(vpx_img_free(stream->img));
   free(argv);
   free(streams);
   return res ? EXIT_FAILURE : EXIT_SUCCESS;
@@ -10,11 +10,16 @@
 
 #include "./webmdec.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <cstdio>
 
+#include "third_party/libwebm/common/webmids.h"
 #include "third_party/libwebm/mkvparser/mkvparser.h"
 #include "third_party/libwebm/mkvparser/mkvreader.h"
+#if CONFIG_MULTITHREAD
+#include "vpx_util/vpx_thread.h"
+#endif
 
 namespace {
 
@@ -57,43 +62,124 @@ void rewind_and_reset(struct WebmInputContext *const webm_ctx,
   reset(webm_ctx);
 }
 
-}  // namespace
+// Returns the cluster after |cluster|. Clusters are loaded from the file as
+// they are reached rather than all at open, so this loads the next one when
+// the segment has not been parsed that far yet. Returns nullptr at the end
+// of the segment or on error.
+const mkvparser::Cluster *get_next_cluster(
+    mkvparser::Segment *const segment,
+    const mkvparser::Cluster *const cluster) {
+  const mkvparser::Cluster *next = segment->GetNext(cluster);
+  while (next != nullptr && next->EOS() && !segment->DoneParsing()) {
+    if (segment->LoadCluster() != 0) break;
+    next = segment->GetNext(cluster);
+  }
+  if (next == nullptr || next->EOS()) return nullptr;
+  return next;
+}
 
-int file_is_webm(struct WebmInputContext *webm_ctx,
-                 struct VpxInputContext *vpx_ctx) {
-  mkvparser::MkvReader *const reader = new mkvparser::MkvReader(vpx_ctx->file);
+// Parses the segment headers and the first cluster only. The Cues normally
+// follow the clusters, so they are located through the SeekHead instead of
+// by loading every cluster in between; webm_seek_to_keyframe() then goes
+// straight to the cluster it needs. Returns the first video track, or
+// nullptr if the input is not a usable WebM file.
+const mkvparser::VideoTrack *open_segment(
+    struct WebmInputContext *const webm_ctx, FILE *const file) {
+  mkvparser::MkvReader *const reader = new mkvparser::MkvReader(file);
   webm_ctx->reader = reader;
   webm_ctx->reached_eos = 0;
 
   mkvparser::EBMLHeader header;
   long long pos = 0;
-  if (header.Parse(reader, pos) < 0) {
-    rewind_and_reset(webm_ctx, vpx_ctx);
-    return 0;
-  }
+  if (header.Parse(reader, pos) < 0) return nullptr;
 
   mkvparser::Segment *segment;
-  if (mkvparser::Segment::CreateInstance(reader, pos, segment)) {
-    rewind_and_reset(webm_ctx, vpx_ctx);
-    return 0;
-  }
+  if (mkvparser::Segment::CreateInstance(reader, pos, segment)) return nullptr;
   webm_ctx->segment = segment;
-  if (segment->Load() < 0) {
-    rewind_and_reset(webm_ctx, vpx_ctx);
-    return 0;
+  if (segment->ParseHeaders() != 0) return nullptr;
+
+  // Clusters found through the Cues are preloaded out of order, which the
+  // parser only supports in a segment of known size.
+  const mkvparser::SeekHead *const seek_head = segment->GetSeekHead();
+  if (seek_head != nullptr && segment->GetCues() == nullptr &&
+      segment->m_size >= 0) {
+    for (int i = 0; i < seek_head->GetCount(); ++i) {
+      const mkvparser::SeekHead::Entry *const entry = seek_head->GetEntry(i);
+      if (entry->id != libwebm::kMkvCues) continue;
+      // Unusable Cues are ignored: seeking then scans from the first cluster.
+      long long cues_pos;
+      long cues_len;
+      segment->ParseCues(entry->pos, cues_pos, cues_len);
+      break;
+    }
   }
+  if (segment->LoadCluster() < 0) return nullptr;
 
   const mkvparser::Tracks *const tracks = segment->GetTracks();
-  const mkvparser::VideoTrack *video_track = nullptr;
   for (unsigned long i = 0; i < tracks->GetTracksCount(); ++i) {
     const mkvparser::Track *const track = tracks->GetTrackByIndex(i);
     if (track->GetType() == mkvparser::Track::kVideo) {
-      video_track = static_cast<const mkvparser::VideoTrack *>(track);
       webm_ctx->video_track_index = static_cast<int>(track->GetNumber());
+      return static_cast<const mkvparser::VideoTrack *>(track);
+    }
+  }
+  return nullptr;
+}
+
+struct KeyframeJob {
+  const char *filename;
+  const uint64_t *timestamps_ns;
+  uint8_t **frames;
+  size_t *frame_sizes;
+  int begin;
+  int end;
+  int result;
+};
+
+// Reads the keyframes of job->timestamps_ns[begin, end) through a reader of
+// its own, so jobs can run on separate threads.
+int read_keyframes(KeyframeJob *const job) {
+  FILE *const file = fopen(job->filename, "rb");
+  if (file == nullptr) return -1;
+
+  struct WebmInputContext webm_ctx;
+  memset(&webm_ctx, 0, sizeof(webm_ctx));
+  int result = open_segment(&webm_ctx, file) != nullptr ? 0 : -1;
+  uint8_t *buffer = nullptr;
+  size_t buffer_size = 0;
+  for (int i = job->begin; result == 0 && i < job->end; ++i) {
+    if (webm_seek_to_keyframe(&webm_ctx, job->timestamps_ns[i])) continue;
+    if (webm_read_frame(&webm_ctx, &buffer, &buffer_size)) {
+      result = -1;
       break;
     }
+    job->frames[i] = static_cast<uint8_t *>(malloc(buffer_size));
+    if (job->frames[i] == nullptr) {
+      result = -1;
+      break;
+    }
+    memcpy(job->frames[i], buffer, buffer_size);
+    job->frame_sizes[i] = buffer_size;
   }
+  reset(&webm_ctx);
+  fclose(file);
+  return result;
+}
+
+#if CONFIG_MULTITHREAD
+THREADFN read_keyframes_thread(void *arg) {
+  KeyframeJob *const job = static_cast<KeyframeJob *>(arg);
+  job->result = read_keyframes(job);
+  return THREAD_RETURN(nullptr);
+}
+#endif
+
+}  // namespace
 
+int file_is_webm(struct WebmInputContext *webm_ctx,
+                 struct VpxInputContext *vpx_ctx) {
+  const mkvparser::VideoTrack *const video_track =
+      open_segment(webm_ctx, vpx_ctx->file);
   if (video_track == nullptr || video_track->GetCodecId() == nullptr) {
     rewind_and_reset(webm_ctx, vpx_ctx);
     return 0;
@@ -141,8 +227,8 @@ int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
       status = cluster->GetFirst(block_entry);
       get_new_block = true;
     } else if (block_entry_eos || block_entry->EOS()) {
-      cluster = segment->GetNext(cluster);
-      if (cluster == nullptr || cluster->EOS()) {
+      cluster = get_next_cluster(segment, cluster);
+      if (cluster == nullptr) {
         *buffer_size = 0;
         webm_ctx->reached_eos = 1;
         return 1;
@@ -221,4 +307,117 @@ int webm_guess_framerate(struct WebmInputContext *webm_ctx,
   return 0;
 }
 
+int webm_seek_to_keyframe(struct WebmInputContext *webm_ctx,
+                          uint64_t timestamp_ns) {
+  mkvparser::Segment *const segment =
+      reinterpret_cast<mkvparser::Segment *>(webm_ctx->segment);
+  const long long target = static_cast<long long>(timestamp_ns);
+  const mkvparser::Cluster *cluster = segment->GetFirst();
+
+  // The cue for the target is a lower bound: start scanning at its cluster.
+  const mkvparser::Cues *const cues = segment->GetCues();
+  const mkvparser::Track *const track =
+      segment->GetTracks()->GetTrackByNumber(webm_ctx->video_track_index);
+  if (cues != nullptr && track != nullptr && segment->m_size >= 0) {
+    while (!cues->DoneParsing()) cues->LoadCuePoint();
+    const mkvparser::CuePoint *cue_point;
+    const mkvparser::CuePoint::TrackPosition *track_position;
+    if (cues->Find(target, track, cue_point, track_position)) {
+      const mkvparser::BlockEntry *const block_entry =
+          cues->GetBlock(cue_point, track_position);
+      if (block_entry != nullptr) cluster = block_entry->GetCluster();
+    }
+  }
+
+  const mkvparser::Cluster *key_cluster = nullptr;
+  const mkvparser::BlockEntry *key_entry = nullptr;
+  for (; cluster != nullptr && !cluster->EOS();
+       cluster = get_next_cluster(segment, cluster)) {
+    const mkvparser::BlockEntry *block_entry;
+    if (cluster->GetTime() > target) break;
+    if (cluster->GetFirst(block_entry)) return -1;
+    while (block_entry != nullptr && !block_entry->EOS()) {
+      const mkvparser::Block *const block = block_entry->GetBlock();
+      if (block->GetTrackNumber() == webm_ctx->video_track_index) {
+        if (block->GetTime(cluster) > target) break;
+        if (block->IsKey()) {
+          key_cluster = cluster;
+          key_entry = block_entry;
+        }
+      }
+      if (cluster->GetNext(block_entry, block_entry)) return -1;
+    }
+  }
+  if (key_entry == nullptr) return -1;
+
+  webm_ctx->cluster = key_cluster;
+  webm_ctx->block_entry = key_entry;
+  webm_ctx->block = key_entry->GetBlock();
+  webm_ctx->block_frame_index = 0;
+  webm_ctx->reached_eos = 0;
+  return 0;
+}
+
+int webm_read_keyframes(const char *filename, const uint64_t *timestamps_ns,
+                        int count, int num_threads, uint8_t **frames,
+                        size_t *frame_sizes) {
+  for (int i = 0; i < count; ++i) {
+    frames[i] = nullptr;
+    frame_sizes[i] = 0;
+  }
+  if (count <= 0) return 0;
+  if (num_threads > count) num_threads = count;
+  if (num_threads < 1) num_threads = 1;
+
+  // Each job takes a contiguous run of timestamps, so a job scanning forward
+  // between nearby targets reuses the clusters it has already loaded.
+  KeyframeJob *const jobs = new KeyframeJob[num_threads];
+  for (int t = 0; t < num_threads; ++t) {
+    jobs[t].filename = filename;
+    jobs[t].timestamps_ns = timestamps_ns;
+    jobs[t].frames = frames;
+    jobs[t].frame_sizes = frame_sizes;
+    jobs[t].begin = count * t / num_threads;
+    jobs[t].end = count * (t + 1) / num_threads;
+    jobs[t].result = -1;
+  }
+
+#if CONFIG_MULTITHREAD
+  pthread_t *const threads = new pthread_t[num_threads];
+  bool *const started = new bool[num_threads];
+  for (int t = 1; t < num_threads; ++t) {
+    started[t] =
+        !pthread_create(&threads[t], nullptr, read_keyframes_thread, &jobs[t]);
+  }
+  jobs[0].result = read_keyframes(&jobs[0]);
+  for (int t = 1; t < num_threads; ++t) {
+    if (started[t]) {
+      pthread_join(threads[t], nullptr);
+    } else {
+      jobs[t].result = read_keyframes(&jobs[t]);
+    }
+  }
+  delete[] started;
+  delete[] threads;
+#else
+  for (int t = 0; t < num_threads; ++t) {
+    jobs[t].result = read_keyframes(&jobs[t]);
+  }
+#endif
+
+  int result = 0;
+  for (int t = 0; t < num_threads; ++t) {
+    if (jobs[t].result) result = -1;
+  }
+  delete[] jobs;
+  if (result) {
+    for (int i = 0; i < count; ++i) {
+      free(frames[i]);
+      frames[i] = nullptr;
+      frame_sizes[i] = 0;
+    }
+  }
+  return result;
+}
+
 void webm_free(struct WebmInputContext *webm_ctx) { reset(webm_ctx); }
@@ -33,7 +33,9 @@ struct WebmInputContext {
 };
 
 // Checks if the input is a WebM file. If so, initializes WebMInputContext so
-// that webm_read_frame can be called to retrieve a video frame.
+// that webm_read_frame can be called to retrieve a video frame. Only the
+// headers, the Cues and the first cluster are parsed here; the remaining
+// clusters are loaded as webm_read_frame or webm_seek_to_keyframe reach them.
 // Returns 1 on success and 0 on failure or input is not WebM file.
 // TODO(vigneshv): Refactor this function into two smaller functions specific
 // to their task.
@@ -59,6 +61,29 @@ int webm_read_frame(struct WebmInputContext *webm_ctx, uint8_t **buffer,
 int webm_guess_framerate(struct WebmInputContext *webm_ctx,
                          struct VpxInputContext *vpx_ctx);
 
+// Positions the context so that the next webm_read_frame() returns the last
+// video keyframe at or before |timestamp_ns|. The cues are used to find the
+// cluster to start from when the file has them; block headers are scanned
+// from there (or from the first cluster) without reading any frame data.
+// Return values:
+//      0 - Success
+//     -1 - No keyframe at or before |timestamp_ns|, the context is unchanged
+int webm_seek_to_keyframe(struct WebmInputContext *webm_ctx,
+                          uint64_t timestamp_ns);
+
+// Reads, for each of the |count| timestamps, the last video keyframe at or
+// before it, as webm_seek_to_keyframe() followed by webm_read_frame() would.
+// |filename| is opened by up to |num_threads| workers, each with a reader of
+// its own, so the clusters needed are parsed in parallel. frames[i] receives
+// a buffer allocated with malloc(), to be freed by the caller, holding
+// frame_sizes[i] bytes; it is NULL if there is no such keyframe.
+// Return values:
+//      0 - Success
+//     -1 - Error, no buffers are returned
+int webm_read_keyframes(const char *filename, const uint64_t *timestamps_ns,
+                        int count, int num_threads, uint8_t **frames,
+                        size_t *frame_sizes);
+
 // Resets the WebMInputContext.
 void webm_free(struct WebmInputContext *webm_ctx);
 
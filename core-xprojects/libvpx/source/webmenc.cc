@@ -9,26 +9,191 @@
  */
 #include "./webmenc.h"
 
+#include <string.h>
+
+#include <atomic>
 #include <string>
 
 #include "third_party/libwebm/mkvmuxer/mkvmuxer.h"
 #include "third_party/libwebm/mkvmuxer/mkvmuxerutil.h"
 #include "third_party/libwebm/mkvmuxer/mkvwriter.h"
+#if CONFIG_MULTITHREAD
+#include "vpx_util/vpx_thread.h"
+#endif
 
 namespace {
 const uint64_t kDebugTrackUid = 0xDEADBEEF;
 const int kVideoTrackNumber = 1;
+const uint32_t kWriterBufferSize = 1 << 20;
+
+// Collects the many small writes of the muxer in a large buffer, which is
+// written to the file on a thread while the next one fills. A seek, or
+// Drain(), waits for everything before it to be written. Write errors on the
+// thread are reported by the next call.
+class BufferedMkvWriter : public mkvmuxer::IMkvWriter {
+ public:
+  BufferedMkvWriter(FILE *file, bool seekable)
+      : file_(file), seekable_(seekable), position_(0), fill_size_(0),
+        error_(false) {
+    fill_ = new uint8_t[kWriterBufferSize];
+#if CONFIG_MULTITHREAD
+    flush_ = new uint8_t[kWriterBufferSize];
+    flush_size_ = 0;
+    stop_ = false;
+    pthread_mutex_init(&mutex_, nullptr);
+    pthread_cond_init(&cond_, nullptr);
+    has_thread_ = !pthread_create(&thread_, nullptr, FlushThread, this);
+#endif
+  }
+
+  ~BufferedMkvWriter() override {
+    Drain();
+#if CONFIG_MULTITHREAD
+    if (has_thread_) {
+      pthread_mutex_lock(&mutex_);
+      stop_ = true;
+      pthread_cond_signal(&cond_);
+      pthread_mutex_unlock(&mutex_);
+      pthread_join(thread_, nullptr);
+    }
+    pthread_mutex_destroy(&mutex_);
+    pthread_cond_destroy(&cond_);
+    delete[] flush_;
+#endif
+    delete[] fill_;
+  }
+
+  mkvmuxer::int64 Position() const override { return position_; }
+
+  mkvmuxer::int32 Position(mkvmuxer::int64 position) override {
+    if (!seekable_ || !Drain()) return -1;
+    if (fseeko(file_, static_cast<FileOffset>(position), SEEK_SET)) return -1;
+    position_ = position;
+    return 0;
+  }
+
+  bool Seekable() const override { return seekable_; }
+
+  mkvmuxer::int32 Write(const void *buffer, mkvmuxer::uint32 length) override {
+    if (error_) return -1;
+    if (length > kWriterBufferSize - fill_size_) {
+      Flush();
+      if (length > kWriterBufferSize) {
+        if (!Drain() || fwrite(buffer, 1, length, file_) != length) {
+          error_ = true;
+          return -1;
+        }
+        position_ += length;
+        return 0;
+      }
+    }
+    memcpy(fill_ + fill_size_, buffer, length);
+    fill_size_ += length;
+    position_ += length;
+    return 0;
+  }
+
+  void ElementStartNotify(mkvmuxer::uint64 /*element_id*/,
+                          mkvmuxer::int64 /*position*/) override {}
+
+  // Starts writing out the buffered data without waiting for it.
+  void Flush() {
+    if (fill_size_ == 0) return;
+#if CONFIG_MULTITHREAD
+    if (has_thread_) {
+      pthread_mutex_lock(&mutex_);
+      while (flush_size_ > 0) pthread_cond_wait(&cond_, &mutex_);
+      uint8_t *const buffer = flush_;
+      flush_ = fill_;
+      flush_size_ = fill_size_;
+      fill_ = buffer;
+      fill_size_ = 0;
+      pthread_cond_signal(&cond_);
+      pthread_mutex_unlock(&mutex_);
+      return;
+    }
+#endif
+    if (fwrite(fill_, 1, fill_size_, file_) != fill_size_) error_ = true;
+    fill_size_ = 0;
+  }
+
+  // Writes out all the buffered data. Returns false if any write failed.
+  bool Drain() {
+    Flush();
+#if CONFIG_MULTITHREAD
+    if (has_thread_) {
+      pthread_mutex_lock(&mutex_);
+      while (flush_size_ > 0) pthread_cond_wait(&cond_, &mutex_);
+      pthread_mutex_unlock(&mutex_);
+    }
+#endif
+    if (fflush(file_)) error_ = true;
+    return !error_;
+  }
+
+ private:
+#if CONFIG_MULTITHREAD
+  static THREADFN FlushThread(void *arg) {
+    BufferedMkvWriter *const writer = static_cast<BufferedMkvWriter *>(arg);
+    pthread_mutex_lock(&writer->mutex_);
+    for (;;) {
+      while (writer->flush_size_ == 0 && !writer->stop_)
+        pthread_cond_wait(&writer->cond_, &writer->mutex_);
+      if (writer->flush_size_ == 0) break;
+      // The flush buffer belongs to this thread until flush_size_ is reset.
+      pthread_mutex_unlock(&writer->mutex_);
+      const bool ok = fwrite(writer->flush_, 1, writer->flush_size_,
+                             writer->file_) == writer->flush_size_;
+      pthread_mutex_lock(&writer->mutex_);
+      if (!ok) writer->error_ = true;
+      writer->flush_size_ = 0;
+      pthread_cond_signal(&writer->cond_);
+    }
+    pthread_mutex_unlock(&writer->mutex_);
+    return THREAD_RETURN(nullptr);
+  }
+#endif
+
+  FILE *const file_;
+  const bool seekable_;
+  mkvmuxer::int64 position_;
+  uint8_t *fill_;
+  uint32_t fill_size_;
+  // Also set by the flush thread, which does not hold the mutex while the
+  // writer reads it.
+  std::atomic<bool> error_;
+#if CONFIG_MULTITHREAD
+  uint8_t *flush_;
+  uint32_t flush_size_;
+  bool stop_;
+  bool has_thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t cond_;
+  pthread_t thread_;
+#endif
+
+  LIBWEBM_DISALLOW_COPY_AND_ASSIGN(BufferedMkvWriter);
+};
 }  // namespace
 
 void write_webm_file_header(struct WebmOutputContext *webm_ctx,
                             const vpx_codec_enc_cfg_t *cfg,
                             stereo_format_t stereo_fmt, unsigned int fourcc,
                             const struct VpxRational *par) {
-  mkvmuxer::MkvWriter *const writer = new mkvmuxer::MkvWriter(webm_ctx->stream);
+  BufferedMkvWriter *const writer =
+      new BufferedMkvWriter(webm_ctx->stream, !webm_ctx->live);
   mkvmuxer::Segment *const segment = new mkvmuxer::Segment();
   segment->Init(writer);
-  segment->set_mode(mkvmuxer::Segment::kFile);
-  segment->OutputCues(true);
+  if (webm_ctx->live) {
+    // Only start clusters at key frames, so each one decodes on its own.
+    segment->set_mode(mkvmuxer::Segment::kLive);
+    segment->OutputCues(false);
+    segment->set_max_cluster_duration(0);
+    segment->set_max_cluster_size(0);
+  } else {
+    segment->set_mode(mkvmuxer::Segment::kFile);
+    segment->OutputCues(true);
+  }
 
   mkvmuxer::SegmentInfo *const info = segment->GetSegmentInfo();
   const uint64_t kTimecodeScale = 1000000;
@@ -80,14 +245,18 @@ void write_webm_block(struct WebmOutputContext *webm_ctx,
   segment->AddFrame(static_cast<uint8_t *>(pkt->data.frame.buf),
                     pkt->data.frame.sz, kVideoTrackNumber, pts_ns,
                     pkt->data.frame.flags & VPX_FRAME_IS_KEY);
+  // A live reader should see each frame as soon as it is muxed.
+  if (webm_ctx->live)
+    reinterpret_cast<BufferedMkvWriter *>(webm_ctx->writer)->Flush();
 }
 
 void write_webm_file_footer(struct WebmOutputContext *webm_ctx) {
-  mkvmuxer::MkvWriter *const writer =
-      reinterpret_cast<mkvmuxer::MkvWriter *>(webm_ctx->writer);
+  BufferedMkvWriter *const writer =
+      reinterpret_cast<BufferedMkvWriter *>(webm_ctx->writer);
   mkvmuxer::Segment *const segment =
       reinterpret_cast<mkvmuxer::Segment *>(webm_ctx->segment);
   segment->Finalize();
+  if (!writer->Drain()) warn("Failed to write WebM output.");
   delete segment;
   delete writer;
   webm_ctx->writer = nullptr;
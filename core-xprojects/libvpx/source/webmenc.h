@@ -22,6 +22,9 @@ extern "C" {
 
 struct WebmOutputContext {
   int debug;
+  /* Write for live streaming: the output is never seeked, so it may be a
+   * pipe, there are no cues and every cluster starts with a key frame. */
+  int live;
   FILE *stream;
   int64_t last_pts_ns;
   void *writer;
@@ -15,7 +15,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "./vpx_config.h"
 #include "vpx/vpx_integer.h"
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+#include "vpx_ports/x86.h"
+#endif
+#if CONFIG_MULTITHREAD
+#include "vpx_util/vpx_thread.h"
+#endif
 #include "y4minput.h"
 
 // Reads 'size' bytes from 'file' into 'buf' with some fault tolerance.
@@ -245,7 +252,20 @@ static int parse_tags(y4m_input *y4m_ctx, FILE *file) {
   The 4:2:2 modes look exactly the same, except there are twice as many chroma
    lines, and they are vertically co-sited with the luma samples in both the
    mpeg2 and jpeg cases (thus requiring no vertical resampling).*/
-static void y4m_42xmpeg2_42xjpeg_helper(unsigned char *_dst,
+void y4m_42xmpeg2_42xjpeg_row_c(unsigned char *_dst, const unsigned char *_src,
+                                int _w) {
+  int x;
+  for (x = 0; x < _w; x++) {
+    _dst[x] = (unsigned char)OC_CLAMPI(
+        0,
+        (4 * _src[x - 2] - 17 * _src[x - 1] + 114 * _src[x] +
+         35 * _src[x + 1] - 9 * _src[x + 2] + _src[x + 3] + 64) >>
+            7,
+        255);
+  }
+}
+
+static void y4m_42xmpeg2_42xjpeg_helper(y4m_input *_y4m, unsigned char *_dst,
                                         const unsigned char *_src, int _c_w,
                                         int _c_h) {
   int y;
@@ -263,13 +283,9 @@ static void y4m_42xmpeg2_42xjpeg_helper(unsigned char *_dst,
               7,
           255);
     }
-    for (; x < _c_w - 3; x++) {
-      _dst[x] = (unsigned char)OC_CLAMPI(
-          0,
-          (4 * _src[x - 2] - 17 * _src[x - 1] + 114 * _src[x] +
-           35 * _src[x + 1] - 9 * _src[x + 2] + _src[x + 3] + 64) >>
-              7,
-          255);
+    if (x < _c_w - 3) {
+      (*_y4m->filter_42xmpeg2_42xjpeg)(_dst + x, _src + x, _c_w - 3 - x);
+      x = _c_w - 3;
     }
     for (; x < _c_w; x++) {
       _dst[x] = (unsigned char)OC_CLAMPI(
@@ -348,7 +364,7 @@ static void y4m_convert_42xpaldv_42xjpeg(y4m_input *_y4m, unsigned char *_dst,
     /*First do the horizontal re-sampling.
       This is the same as the mpeg2 case, except that after the horizontal
        case, we need to apply a second vertical filter.*/
-    y4m_42xmpeg2_42xjpeg_helper(tmp, _aux, c_w, c_h);
+    y4m_42xmpeg2_42xjpeg_helper(_y4m, tmp, _aux, c_w, c_h);
     _aux += c_sz;
     switch (pli) {
       case 1: {
@@ -440,45 +456,58 @@ static void y4m_convert_42xpaldv_42xjpeg(y4m_input *_y4m, unsigned char *_dst,
   }
 }
 
+void y4m_422jpeg_420jpeg_row_c(unsigned char *_dst, const unsigned char *_src,
+                               int _src_stride, int _w) {
+  int x;
+  for (x = 0; x < _w; x++) {
+    _dst[x] = (unsigned char)OC_CLAMPI(
+        0,
+        (3 * (_src[x - 2 * _src_stride] + _src[x + 3 * _src_stride]) -
+         17 * (_src[x - _src_stride] + _src[x + 2 * _src_stride]) +
+         78 * (_src[x] + _src[x + _src_stride]) + 64) >>
+            7,
+        255);
+  }
+}
+
 /*Perform vertical filtering to reduce a single plane from 4:2:2 to 4:2:0.
   This is used as a helper by several converation routines.*/
-static void y4m_422jpeg_420jpeg_helper(unsigned char *_dst,
+static void y4m_422jpeg_420jpeg_helper(y4m_input *_y4m, unsigned char *_dst,
                                        const unsigned char *_src, int _c_w,
                                        int _c_h) {
   int y;
   int x;
-  /*Filter: [3 -17 78 78 -17 3]/128, derived from a 6-tap Lanczos window.*/
-  for (x = 0; x < _c_w; x++) {
-    for (y = 0; y < OC_MINI(_c_h, 2); y += 2) {
-      _dst[(y >> 1) * _c_w] =
-          OC_CLAMPI(0,
-                    (64 * _src[0] + 78 * _src[OC_MINI(1, _c_h - 1) * _c_w] -
-                     17 * _src[OC_MINI(2, _c_h - 1) * _c_w] +
-                     3 * _src[OC_MINI(3, _c_h - 1) * _c_w] + 64) >>
-                        7,
-                    255);
-    }
-    for (; y < _c_h - 3; y += 2) {
-      _dst[(y >> 1) * _c_w] =
-          OC_CLAMPI(0,
-                    (3 * (_src[(y - 2) * _c_w] + _src[(y + 3) * _c_w]) -
-                     17 * (_src[(y - 1) * _c_w] + _src[(y + 2) * _c_w]) +
-                     78 * (_src[y * _c_w] + _src[(y + 1) * _c_w]) + 64) >>
-                        7,
-                    255);
-    }
-    for (; y < _c_h; y += 2) {
-      _dst[(y >> 1) * _c_w] = OC_CLAMPI(
-          0,
-          (3 * (_src[(y - 2) * _c_w] + _src[(_c_h - 1) * _c_w]) -
-           17 * (_src[(y - 1) * _c_w] + _src[OC_MINI(y + 2, _c_h - 1) * _c_w]) +
-           78 * (_src[y * _c_w] + _src[OC_MINI(y + 1, _c_h - 1) * _c_w]) +
-           64) >>
-              7,
-          255);
+  /*Filter: [3 -17 78 78 -17 3]/128, derived from a 6-tap Lanczos window.
+    The rows are filtered one at a time, the ones away from the edges with the
+     row kernel.*/
+  for (y = 0; y < _c_h; y += 2) {
+    unsigned char *dst = _dst + (y >> 1) * _c_w;
+    if (y == 0) {
+      for (x = 0; x < _c_w; x++) {
+        dst[x] = OC_CLAMPI(0,
+                           (64 * _src[x] +
+                            78 * _src[OC_MINI(1, _c_h - 1) * _c_w + x] -
+                            17 * _src[OC_MINI(2, _c_h - 1) * _c_w + x] +
+                            3 * _src[OC_MINI(3, _c_h - 1) * _c_w + x] + 64) >>
+                               7,
+                           255);
+      }
+    } else if (y < _c_h - 3) {
+      (*_y4m->filter_422jpeg_420jpeg)(dst, _src + y * _c_w, _c_w, _c_w);
+    } else {
+      for (x = 0; x < _c_w; x++) {
+        dst[x] = OC_CLAMPI(
+            0,
+            (3 * (_src[(y - 2) * _c_w + x] + _src[(_c_h - 1) * _c_w + x]) -
+             17 * (_src[(y - 1) * _c_w + x] +
+                   _src[OC_MINI(y + 2, _c_h - 1) * _c_w + x]) +
+             78 * (_src[y * _c_w + x] +
+                   _src[OC_MINI(y + 1, _c_h - 1) * _c_w + x]) +
+             64) >>
+                7,
+            255);
+      }
     }
-    _src++;
-    _dst++;
   }
 }
 
@@ -539,7 +568,7 @@ static void y4m_convert_422jpeg_420jpeg(y4m_input *_y4m, unsigned char *_dst,
   c_sz = c_w * c_h;
   dst_c_sz = dst_c_w * dst_c_h;
   for (pli = 1; pli < 3; pli++) {
-    y4m_422jpeg_420jpeg_helper(_dst, _aux, c_w, c_h);
+    y4m_422jpeg_420jpeg_helper(_y4m, _dst, _aux, c_w, c_h);
     _aux += c_sz;
     _dst += dst_c_sz;
   }
@@ -608,9 +637,9 @@ static void y4m_convert_422_420jpeg(y4m_input *_y4m, unsigned char *_dst,
        less memory consumption and better cache performance, but we do them
        separately for simplicity.*/
     /*First do horizontal filtering (convert to 422jpeg)*/
-    y4m_42xmpeg2_42xjpeg_helper(tmp, _aux, c_w, c_h);
+    y4m_42xmpeg2_42xjpeg_helper(_y4m, tmp, _aux, c_w, c_h);
     /*Now do the vertical filtering.*/
-    y4m_422jpeg_420jpeg_helper(_dst, tmp, c_w, c_h);
+    y4m_422jpeg_420jpeg_helper(_y4m, _dst, tmp, c_w, c_h);
     _aux += c_sz;
     _dst += dst_c_sz;
   }
@@ -738,11 +767,25 @@ static void y4m_convert_411_420jpeg(y4m_input *_y4m, unsigned char *_dst,
     }
     tmp -= tmp_sz;
     /*Now do the vertical filtering.*/
-    y4m_422jpeg_420jpeg_helper(_dst, tmp, dst_c_w, c_h);
+    y4m_422jpeg_420jpeg_helper(_y4m, _dst, tmp, dst_c_w, c_h);
     _dst += dst_c_sz;
   }
 }
 
+void y4m_444_420jpeg_row_c(unsigned char *_dst, const unsigned char *_src,
+                           int _w) {
+  int x;
+  for (x = 0; x < _w; x++) {
+    const unsigned char *src = _src + 2 * x;
+    _dst[x] = (unsigned char)OC_CLAMPI(0,
+                                       (3 * (src[-2] + src[3]) -
+                                        17 * (src[-1] + src[2]) +
+                                        78 * (src[0] + src[1]) + 64) >>
+                                           7,
+                                       255);
+  }
+}
+
 /*Convert 444 to 420jpeg.*/
 static void y4m_convert_444_420jpeg(y4m_input *_y4m, unsigned char *_dst,
                                     unsigned char *_aux) {
@@ -779,13 +822,10 @@ static void y4m_convert_444_420jpeg(y4m_input *_y4m, unsigned char *_dst,
                                     7,
                                 255);
       }
-      for (; x < c_w - 3; x += 2) {
-        tmp[x >> 1] = OC_CLAMPI(0,
-                                (3 * (_aux[x - 2] + _aux[x + 3]) -
-                                 17 * (_aux[x - 1] + _aux[x + 2]) +
-                                 78 * (_aux[x] + _aux[x + 1]) + 64) >>
-                                    7,
-                                255);
+      if (x < c_w - 3) {
+        const int n = (c_w - 2 - x) >> 1;
+        (*_y4m->filter_444_420jpeg)(tmp + (x >> 1), _aux + x, n);
+        x += 2 * n;
       }
       for (; x < c_w; x += 2) {
         tmp[x >> 1] =
@@ -801,7 +841,7 @@ static void y4m_convert_444_420jpeg(y4m_input *_y4m, unsigned char *_dst,
     }
     tmp -= tmp_sz;
     /*Now do the vertical filtering.*/
-    y4m_422jpeg_420jpeg_helper(_dst, tmp, dst_c_w, c_h);
+    y4m_422jpeg_420jpeg_helper(_y4m, _dst, tmp, dst_c_w, c_h);
     _dst += dst_c_sz;
   }
 }
@@ -868,6 +908,30 @@ int y4m_input_open(y4m_input *y4m_ctx, FILE *file, char *skip_buffer,
   y4m_ctx->bit_depth = 8;
   y4m_ctx->aux_buf = NULL;
   y4m_ctx->dst_buf = NULL;
+  y4m_ctx->read_ahead = NULL;
+  y4m_ctx->filter_422jpeg_420jpeg = y4m_422jpeg_420jpeg_row_c;
+  y4m_ctx->filter_42xmpeg2_42xjpeg = y4m_42xmpeg2_42xjpeg_row_c;
+  y4m_ctx->filter_444_420jpeg = y4m_444_420jpeg_row_c;
+#if VPX_ARCH_X86 || VPX_ARCH_X86_64
+  {
+    const int simd_caps = x86_simd_caps();
+    (void)simd_caps;
+#if HAVE_SSE2
+    if (simd_caps & HAS_SSE2) {
+      y4m_ctx->filter_422jpeg_420jpeg = y4m_422jpeg_420jpeg_row_sse2;
+      y4m_ctx->filter_42xmpeg2_42xjpeg = y4m_42xmpeg2_42xjpeg_row_sse2;
+      y4m_ctx->filter_444_420jpeg = y4m_444_420jpeg_row_sse2;
+    }
+#endif
+#if HAVE_AVX2
+    if (simd_caps & HAS_AVX2) {
+      y4m_ctx->filter_422jpeg_420jpeg = y4m_422jpeg_420jpeg_row_avx2;
+      y4m_ctx->filter_42xmpeg2_42xjpeg = y4m_42xmpeg2_42xjpeg_row_avx2;
+      y4m_ctx->filter_444_420jpeg = y4m_444_420jpeg_row_avx2;
+    }
+#endif
+  }
+#endif
   if (strcmp(y4m_ctx->chroma_type, "420") == 0 ||
       strcmp(y4m_ctx->chroma_type, "420jpeg") == 0 ||
       strcmp(y4m_ctx->chroma_type, "420mpeg2") == 0) {
@@ -1093,18 +1157,31 @@ int y4m_input_open(y4m_input *y4m_ctx, FILE *file, char *skip_buffer,
   return 0;
 }
 
-void y4m_input_close(y4m_input *_y4m) {
-  free(_y4m->dst_buf);
-  free(_y4m->aux_buf);
-}
+#if CONFIG_MULTITHREAD
+/*A ring of converted frames filled by a thread ahead of the caller.
+  count includes the frame handed out by the last fetch, which stays at
+   head until the next fetch releases it.*/
+struct y4m_read_ahead {
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  pthread_t thread;
+  y4m_input *y4m;
+  FILE *file;
+  unsigned char **bufs;
+  int size;
+  int head;
+  int count;
+  int in_use;
+  /*Set once the thread has stopped, with the result that stopped it.*/
+  int done;
+  int result;
+  int stop;
+};
+#endif
 
-int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
+static int y4m_read_frame(y4m_input *_y4m, FILE *_fin, unsigned char *_dst,
+                          unsigned char *_aux) {
   char frame[6];
-  int pic_sz;
-  int c_w;
-  int c_h;
-  int c_sz;
-  int bytes_per_sample = _y4m->bit_depth > 8 ? 2 : 1;
   /*Read and skip the frame header.*/
   if (!file_read(frame, 6, _fin)) return 0;
   if (memcmp(frame, "FRAME", 5)) {
@@ -1122,17 +1199,160 @@ int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
     }
   }
   /*Read the frame data that needs no conversion.*/
-  if (!file_read(_y4m->dst_buf, _y4m->dst_buf_read_sz, _fin)) {
+  if (!file_read(_dst, _y4m->dst_buf_read_sz, _fin)) {
     fprintf(stderr, "Error reading Y4M frame data.\n");
     return -1;
   }
   /*Read the frame data that does need conversion.*/
-  if (!file_read(_y4m->aux_buf, _y4m->aux_buf_read_sz, _fin)) {
+  if (!file_read(_aux, _y4m->aux_buf_read_sz, _fin)) {
     fprintf(stderr, "Error reading Y4M frame data.\n");
     return -1;
   }
   /*Now convert the just read frame.*/
-  (*_y4m->convert)(_y4m, _y4m->dst_buf, _y4m->aux_buf);
+  (*_y4m->convert)(_y4m, _dst, _aux);
+  return 1;
+}
+
+#if CONFIG_MULTITHREAD
+static THREADFN y4m_read_ahead_thread(void *arg) {
+  struct y4m_read_ahead *const ra = (struct y4m_read_ahead *)arg;
+  int result;
+  do {
+    unsigned char *buf;
+    pthread_mutex_lock(&ra->mutex);
+    while (ra->count == ra->size && !ra->stop)
+      pthread_cond_wait(&ra->cond, &ra->mutex);
+    if (ra->stop) {
+      pthread_mutex_unlock(&ra->mutex);
+      break;
+    }
+    buf = ra->bufs[(ra->head + ra->count) % ra->size];
+    pthread_mutex_unlock(&ra->mutex);
+
+    /*The thread owns aux_buf from here on: the caller no longer converts.*/
+    result = y4m_read_frame(ra->y4m, ra->file, buf, ra->y4m->aux_buf);
+
+    pthread_mutex_lock(&ra->mutex);
+    if (result > 0) {
+      ra->count++;
+    } else {
+      ra->done = 1;
+      ra->result = result;
+    }
+    pthread_cond_signal(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+  } while (result > 0);
+  return THREAD_RETURN(NULL);
+}
+
+/*Hands out the next frame in *buf, after releasing the one handed out by
+   the previous call.*/
+static int y4m_read_ahead_fetch(struct y4m_read_ahead *ra,
+                                unsigned char **buf) {
+  pthread_mutex_lock(&ra->mutex);
+  if (ra->in_use) {
+    ra->head = (ra->head + 1) % ra->size;
+    ra->count--;
+    ra->in_use = 0;
+    pthread_cond_signal(&ra->cond);
+  }
+  while (ra->count == 0 && !ra->done)
+    pthread_cond_wait(&ra->cond, &ra->mutex);
+  if (ra->count == 0) {
+    const int result = ra->result;
+    pthread_mutex_unlock(&ra->mutex);
+    return result;
+  }
+  ra->in_use = 1;
+  *buf = ra->bufs[ra->head];
+  pthread_mutex_unlock(&ra->mutex);
+  return 1;
+}
+
+static void y4m_read_ahead_free(struct y4m_read_ahead *ra) {
+  int i;
+  for (i = 0; i < ra->size; i++) free(ra->bufs[i]);
+  free(ra->bufs);
+  free(ra);
+}
+#endif
+
+int y4m_input_start_read_ahead(y4m_input *y4m_ctx, FILE *file, int num_frames) {
+#if CONFIG_MULTITHREAD
+  struct y4m_read_ahead *ra;
+  size_t buf_sz = y4m_ctx->dst_buf_sz;
+  int i;
+  if (y4m_ctx->read_ahead != NULL || num_frames < 2) return -1;
+  if (y4m_ctx->bit_depth > 8) buf_sz *= 2;
+  ra = (struct y4m_read_ahead *)calloc(1, sizeof(*ra));
+  if (ra == NULL) return -1;
+  ra->bufs = (unsigned char **)calloc(num_frames, sizeof(*ra->bufs));
+  if (ra->bufs == NULL) {
+    free(ra);
+    return -1;
+  }
+  ra->size = num_frames;
+  for (i = 0; i < num_frames; i++) {
+    ra->bufs[i] = (unsigned char *)malloc(buf_sz);
+    if (ra->bufs[i] == NULL) {
+      y4m_read_ahead_free(ra);
+      return -1;
+    }
+  }
+  ra->y4m = y4m_ctx;
+  ra->file = file;
+  pthread_mutex_init(&ra->mutex, NULL);
+  pthread_cond_init(&ra->cond, NULL);
+  if (pthread_create(&ra->thread, NULL, y4m_read_ahead_thread, ra)) {
+    pthread_mutex_destroy(&ra->mutex);
+    pthread_cond_destroy(&ra->cond);
+    y4m_read_ahead_free(ra);
+    return -1;
+  }
+  y4m_ctx->read_ahead = ra;
+  return 0;
+#else
+  (void)y4m_ctx;
+  (void)file;
+  (void)num_frames;
+  return -1;
+#endif
+}
+
+void y4m_input_close(y4m_input *_y4m) {
+#if CONFIG_MULTITHREAD
+  struct y4m_read_ahead *const ra = _y4m->read_ahead;
+  if (ra != NULL) {
+    pthread_mutex_lock(&ra->mutex);
+    ra->stop = 1;
+    pthread_cond_signal(&ra->cond);
+    pthread_mutex_unlock(&ra->mutex);
+    pthread_join(ra->thread, NULL);
+    pthread_mutex_destroy(&ra->mutex);
+    pthread_cond_destroy(&ra->cond);
+    y4m_read_ahead_free(ra);
+    _y4m->read_ahead = NULL;
+  }
+#endif
+  free(_y4m->dst_buf);
+  free(_y4m->aux_buf);
+}
+
+int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
+  unsigned char *buf = _y4m->dst_buf;
+  int pic_sz;
+  int c_w;
+  int c_h;
+  int c_sz;
+  int bytes_per_sample = _y4m->bit_depth > 8 ? 2 : 1;
+  int result;
+#if CONFIG_MULTITHREAD
+  if (_y4m->read_ahead != NULL)
+    result = y4m_read_ahead_fetch(_y4m->read_ahead, &buf);
+  else
+#endif
+    result = y4m_read_frame(_y4m, _fin, buf, _y4m->aux_buf);
+  if (result <= 0) return result;
   /*Fill in the frame buffer pointers.
     We don't use vpx_img_wrap() because it forces padding for odd picture
      sizes, which would require a separate fread call for every row.*/
@@ -1154,9 +1374,9 @@ int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
   _img->stride[VPX_PLANE_Y] = _img->stride[VPX_PLANE_ALPHA] =
       _y4m->pic_w * bytes_per_sample;
   _img->stride[VPX_PLANE_U] = _img->stride[VPX_PLANE_V] = c_w;
-  _img->planes[VPX_PLANE_Y] = _y4m->dst_buf;
-  _img->planes[VPX_PLANE_U] = _y4m->dst_buf + pic_sz;
-  _img->planes[VPX_PLANE_V] = _y4m->dst_buf + pic_sz + c_sz;
-  _img->planes[VPX_PLANE_ALPHA] = _y4m->dst_buf + pic_sz + 2 * c_sz;
+  _img->planes[VPX_PLANE_Y] = buf;
+  _img->planes[VPX_PLANE_U] = buf + pic_sz;
+  _img->planes[VPX_PLANE_V] = buf + pic_sz + c_sz;
+  _img->planes[VPX_PLANE_ALPHA] = buf + pic_sz + 2 * c_sz;
   return 1;
 }
@@ -15,6 +15,7 @@
 #define VPX_Y4MINPUT_H_
 
 #include <stdio.h>
+#include "./vpx_config.h"
 #include "vpx/vpx_image.h"
 
 #ifdef __cplusplus
@@ -27,6 +28,20 @@ typedef struct y4m_input y4m_input;
 typedef void (*y4m_convert_func)(y4m_input *_y4m, unsigned char *_dst,
                                  unsigned char *_src);
 
+/*The row kernels used by the chroma conversions.
+  A vertical filter computes _w samples of one destination row from the
+   source rows around _src, _src_stride bytes apart; the caller keeps the
+   taps inside the plane.
+  A horizontal filter computes _w samples from the source row at _src, which
+   must have valid samples on both sides of the range the taps cover.*/
+typedef void (*y4m_filter_v_func)(unsigned char *_dst,
+                                  const unsigned char *_src, int _src_stride,
+                                  int _w);
+typedef void (*y4m_filter_h_func)(unsigned char *_dst,
+                                  const unsigned char *_src, int _w);
+
+struct y4m_read_ahead;
+
 struct y4m_input {
   int pic_w;
   int pic_h;
@@ -54,6 +69,12 @@ struct y4m_input {
   enum vpx_img_fmt vpx_fmt;
   int bps;
   unsigned int bit_depth;
+  /*The row kernels, chosen for the CPU when the file is opened.*/
+  y4m_filter_v_func filter_422jpeg_420jpeg;
+  y4m_filter_h_func filter_42xmpeg2_42xjpeg;
+  y4m_filter_h_func filter_444_420jpeg;
+  /*The thread reading and converting frames ahead, if it was started.*/
+  struct y4m_read_ahead *read_ahead;
 };
 
 /**
@@ -69,6 +90,47 @@ int y4m_input_open(y4m_input *y4m_ctx, FILE *file, char *skip_buffer,
 void y4m_input_close(y4m_input *_y4m);
 int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *img);
 
+/**
+ * Starts a thread that reads and converts up to |num_frames| - 1 frames
+ * ahead of y4m_input_fetch_frame(), which then returns them in order. From
+ * then on |file| must only be read through y4m_input_fetch_frame(), and the
+ * image it returns stays valid until the next call. The output is the same
+ * as without the thread.
+ *
+ * Returns 0 on success, -1 if the thread could not be started, in which case
+ * the frames are read on the calling thread as before.
+ */
+int y4m_input_start_read_ahead(y4m_input *y4m_ctx, FILE *file, int num_frames);
+
+/*Filter: [3 -17 78 78 -17 3]/128, reads rows -2 to 3.*/
+void y4m_422jpeg_420jpeg_row_c(unsigned char *_dst, const unsigned char *_src,
+                               int _src_stride, int _w);
+/*Filter: [4 -17 114 35 -9 1]/128, reads samples -2 to _w + 2.*/
+void y4m_42xmpeg2_42xjpeg_row_c(unsigned char *_dst, const unsigned char *_src,
+                                int _w);
+/*Filter: [3 -17 78 78 -17 3]/128 at every other sample, reads samples -2 to
+   2 * _w + 1.*/
+void y4m_444_420jpeg_row_c(unsigned char *_dst, const unsigned char *_src,
+                           int _w);
+#if HAVE_SSE2
+void y4m_422jpeg_420jpeg_row_sse2(unsigned char *_dst,
+                                  const unsigned char *_src, int _src_stride,
+                                  int _w);
+void y4m_42xmpeg2_42xjpeg_row_sse2(unsigned char *_dst,
+                                   const unsigned char *_src, int _w);
+void y4m_444_420jpeg_row_sse2(unsigned char *_dst, const unsigned char *_src,
+                              int _w);
+#endif
+#if HAVE_AVX2
+void y4m_422jpeg_420jpeg_row_avx2(unsigned char *_dst,
+                                  const unsigned char *_src, int _src_stride,
+                                  int _w);
+void y4m_42xmpeg2_42xjpeg_row_avx2(unsigned char *_dst,
+                                   const unsigned char *_src, int _w);
+void y4m_444_420jpeg_row_avx2(unsigned char *_dst, const unsigned char *_src,
+                              int _w);
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "y4minput.h"
+
+/*The 16-bit unpacks and packs below both work within 128-bit lanes, so the
+   samples come back out in order.
+  All the filters have taps summing to 128 with the negative ones no larger
+   than 17 * 2 * 255, so the positive and negative parts fit in 16 bits.
+  Subtracting with unsigned saturation clamps at 0 and the final pack clamps
+   at 255, which matches OC_CLAMPI(0, x >> 7, 255) exactly.*/
+static INLINE __m256i round_shift_clamp(__m256i pos, __m256i neg) {
+  return _mm256_srli_epi16(_mm256_subs_epu16(pos, neg), 7);
+}
+
+/*Filter: [3 -17 78 78 -17 3]/128.*/
+static INLINE __m256i filter_jpeg(__m256i a, __m256i b, __m256i c, __m256i d,
+                                  __m256i e, __m256i f) {
+  const __m256i af = _mm256_add_epi16(a, f);
+  const __m256i cd = _mm256_add_epi16(c, d);
+  const __m256i pos = _mm256_add_epi16(
+      _mm256_add_epi16(_mm256_mullo_epi16(af, _mm256_set1_epi16(3)),
+                       _mm256_mullo_epi16(cd, _mm256_set1_epi16(78))),
+      _mm256_set1_epi16(64));
+  const __m256i neg =
+      _mm256_mullo_epi16(_mm256_add_epi16(b, e), _mm256_set1_epi16(17));
+  return round_shift_clamp(pos, neg);
+}
+
+/*Filter: [4 -17 114 35 -9 1]/128.*/
+static INLINE __m256i filter_mpeg2(__m256i a, __m256i b, __m256i c, __m256i d,
+                                   __m256i e, __m256i f) {
+  const __m256i pos = _mm256_add_epi16(
+      _mm256_add_epi16(_mm256_mullo_epi16(a, _mm256_set1_epi16(4)),
+                       _mm256_mullo_epi16(c, _mm256_set1_epi16(114))),
+      _mm256_add_epi16(_mm256_mullo_epi16(d, _mm256_set1_epi16(35)),
+                       _mm256_add_epi16(f, _mm256_set1_epi16(64))));
+  const __m256i neg =
+      _mm256_add_epi16(_mm256_mullo_epi16(b, _mm256_set1_epi16(17)),
+                       _mm256_mullo_epi16(e, _mm256_set1_epi16(9)));
+  return round_shift_clamp(pos, neg);
+}
+
+void y4m_422jpeg_420jpeg_row_avx2(unsigned char *_dst,
+                                  const unsigned char *_src, int _src_stride,
+                                  int _w) {
+  const __m256i zero = _mm256_setzero_si256();
+  int x;
+  for (x = 0; x + 32 <= _w; x += 32) {
+    const unsigned char *src = _src + x;
+    const __m256i s0 =
+        _mm256_loadu_si256((const __m256i *)(src - 2 * _src_stride));
+    const __m256i s1 = _mm256_loadu_si256((const __m256i *)(src - _src_stride));
+    const __m256i s2 = _mm256_loadu_si256((const __m256i *)src);
+    const __m256i s3 = _mm256_loadu_si256((const __m256i *)(src + _src_stride));
+    const __m256i s4 =
+        _mm256_loadu_si256((const __m256i *)(src + 2 * _src_stride));
+    const __m256i s5 =
+        _mm256_loadu_si256((const __m256i *)(src + 3 * _src_stride));
+    const __m256i lo = filter_jpeg(
+        _mm256_unpacklo_epi8(s0, zero), _mm256_unpacklo_epi8(s1, zero),
+        _mm256_unpacklo_epi8(s2, zero), _mm256_unpacklo_epi8(s3, zero),
+        _mm256_unpacklo_epi8(s4, zero), _mm256_unpacklo_epi8(s5, zero));
+    const __m256i hi = filter_jpeg(
+        _mm256_unpackhi_epi8(s0, zero), _mm256_unpackhi_epi8(s1, zero),
+        _mm256_unpackhi_epi8(s2, zero), _mm256_unpackhi_epi8(s3, zero),
+        _mm256_unpackhi_epi8(s4, zero), _mm256_unpackhi_epi8(s5, zero));
+    _mm256_storeu_si256((__m256i *)(_dst + x), _mm256_packus_epi16(lo, hi));
+  }
+  if (x < _w) {
+    y4m_422jpeg_420jpeg_row_c(_dst + x, _src + x, _src_stride, _w - x);
+  }
+}
+
+void y4m_42xmpeg2_42xjpeg_row_avx2(unsigned char *_dst,
+                                   const unsigned char *_src, int _w) {
+  const __m256i zero = _mm256_setzero_si256();
+  int x;
+  for (x = 0; x + 32 <= _w; x += 32) {
+    const unsigned char *src = _src + x;
+    const __m256i s0 = _mm256_loadu_si256((const __m256i *)(src - 2));
+    const __m256i s1 = _mm256_loadu_si256((const __m256i *)(src - 1));
+    const __m256i s2 = _mm256_loadu_si256((const __m256i *)src);
+    const __m256i s3 = _mm256_loadu_si256((const __m256i *)(src + 1));
+    const __m256i s4 = _mm256_loadu_si256((const __m256i *)(src + 2));
+    const __m256i s5 = _mm256_loadu_si256((const __m256i *)(src + 3));
+    const __m256i lo = filter_mpeg2(
+        _mm256_unpacklo_epi8(s0, zero), _mm256_unpacklo_epi8(s1, zero),
+        _mm256_unpacklo_epi8(s2, zero), _mm256_unpacklo_epi8(s3, zero),
+        _mm256_unpacklo_epi8(s4, zero), _mm256_unpacklo_epi8(s5, zero));
+    const __m256i hi = filter_mpeg2(
+        _mm256_unpackhi_epi8(s0, zero), _mm256_unpackhi_epi8(s1, zero),
+        _mm256_unpackhi_epi8(s2, zero), _mm256_unpackhi_epi8(s3, zero),
+        _mm256_unpackhi_epi8(s4, zero), _mm256_unpackhi_epi8(s5, zero));
+    _mm256_storeu_si256((__m256i *)(_dst + x), _mm256_packus_epi16(lo, hi));
+  }
+  if (x < _w) y4m_42xmpeg2_42xjpeg_row_c(_dst + x, _src + x, _w - x);
+}
+
+void y4m_444_420jpeg_row_avx2(unsigned char *_dst, const unsigned char *_src,
+                              int _w) {
+  const __m256i mask = _mm256_set1_epi16(0x00ff);
+  int x;
+  for (x = 0; x + 16 <= _w; x += 16) {
+    const unsigned char *src = _src + 2 * x;
+    /*Output x takes src[2x - 2] to src[2x + 3], which are the even and odd
+       samples of these three loads.*/
+    const __m256i s0 = _mm256_loadu_si256((const __m256i *)(src - 2));
+    const __m256i s1 = _mm256_loadu_si256((const __m256i *)src);
+    const __m256i s2 = _mm256_loadu_si256((const __m256i *)(src + 2));
+    const __m256i out =
+        filter_jpeg(_mm256_and_si256(s0, mask), _mm256_srli_epi16(s0, 8),
+                    _mm256_and_si256(s1, mask), _mm256_srli_epi16(s1, 8),
+                    _mm256_and_si256(s2, mask), _mm256_srli_epi16(s2, 8));
+    /*The pack works within 128-bit lanes, so gather the low halves.*/
+    const __m256i packed =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(out, out), 0xD8);
+    _mm_storeu_si128((__m128i *)(_dst + x), _mm256_castsi256_si128(packed));
+  }
+  if (x < _w) y4m_444_420jpeg_row_c(_dst + x, _src + 2 * x, _w - x);
+}
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2026 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "y4minput.h"
+
+/*All the filters have taps summing to 128 with the negative ones no larger
+   than 17 * 2 * 255, so the positive and negative parts fit in 16 bits.
+  Subtracting with unsigned saturation clamps at 0 and the final pack clamps
+   at 255, which matches OC_CLAMPI(0, x >> 7, 255) exactly.*/
+static INLINE __m128i round_shift_clamp(__m128i pos, __m128i neg) {
+  return _mm_srli_epi16(_mm_subs_epu16(pos, neg), 7);
+}
+
+/*Filter: [3 -17 78 78 -17 3]/128.*/
+static INLINE __m128i filter_jpeg(__m128i a, __m128i b, __m128i c, __m128i d,
+                                  __m128i e, __m128i f) {
+  const __m128i pos = _mm_add_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(a, f), _mm_set1_epi16(3)),
+                    _mm_mullo_epi16(_mm_add_epi16(c, d), _mm_set1_epi16(78))),
+      _mm_set1_epi16(64));
+  const __m128i neg = _mm_mullo_epi16(_mm_add_epi16(b, e), _mm_set1_epi16(17));
+  return round_shift_clamp(pos, neg);
+}
+
+/*Filter: [4 -17 114 35 -9 1]/128.*/
+static INLINE __m128i filter_mpeg2(__m128i a, __m128i b, __m128i c, __m128i d,
+                                   __m128i e, __m128i f) {
+  const __m128i pos = _mm_add_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(a, _mm_set1_epi16(4)),
+                    _mm_mullo_epi16(c, _mm_set1_epi16(114))),
+      _mm_add_epi16(_mm_mullo_epi16(d, _mm_set1_epi16(35)),
+                    _mm_add_epi16(f, _mm_set1_epi16(64))));
+  const __m128i neg = _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(17)),
+                                    _mm_mullo_epi16(e, _mm_set1_epi16(9)));
+  return round_shift_clamp(pos, neg);
+}
+
+void y4m_422jpeg_420jpeg_row_sse2(unsigned char *_dst,
+                                  const unsigned char *_src, int _src_stride,
+                                  int _w) {
+  const __m128i zero = _mm_setzero_si128();
+  int x;
+  for (x = 0; x + 16 <= _w; x += 16) {
+    const unsigned char *src = _src + x;
+    const __m128i s0 =
+        _mm_loadu_si128((const __m128i *)(src - 2 * _src_stride));
+    const __m128i s1 = _mm_loadu_si128((const __m128i *)(src - _src_stride));
+    const __m128i s2 = _mm_loadu_si128((const __m128i *)src);
+    const __m128i s3 = _mm_loadu_si128((const __m128i *)(src + _src_stride));
+    const __m128i s4 =
+        _mm_loadu_si128((const __m128i *)(src + 2 * _src_stride));
+    const __m128i s5 =
+        _mm_loadu_si128((const __m128i *)(src + 3 * _src_stride));
+    const __m128i lo = filter_jpeg(
+        _mm_unpacklo_epi8(s0, zero), _mm_unpacklo_epi8(s1, zero),
+        _mm_unpacklo_epi8(s2, zero), _mm_unpacklo_epi8(s3, zero),
+        _mm_unpacklo_epi8(s4, zero), _mm_unpacklo_epi8(s5, zero));
+    const __m128i hi = filter_jpeg(
+        _mm_unpackhi_epi8(s0, zero), _mm_unpackhi_epi8(s1, zero),
+        _mm_unpackhi_epi8(s2, zero), _mm_unpackhi_epi8(s3, zero),
+        _mm_unpackhi_epi8(s4, zero), _mm_unpackhi_epi8(s5, zero));
+    _mm_storeu_si128((__m128i *)(_dst + x), _mm_packus_epi16(lo, hi));
+  }
+  if (x < _w) {
+    y4m_422jpeg_420jpeg_row_c(_dst + x, _src + x, _src_stride, _w - x);
+  }
+}
+
+void y4m_42xmpeg2_42xjpeg_row_sse2(unsigned char *_dst,
+                                   const unsigned char *_src, int _w) {
+  const __m128i zero = _mm_setzero_si128();
+  int x;
+  for (x = 0; x + 16 <= _w; x += 16) {
+    const unsigned char *src = _src + x;
+    const __m128i s0 = _mm_loadu_si128((const __m128i *)(src - 2));
+    const __m128i s1 = _mm_loadu_si128((const __m128i *)(src - 1));
+    const __m128i s2 = _mm_loadu_si128((const __m128i *)src);
+    const __m128i s3 = _mm_loadu_si128((const __m128i *)(src + 1));
+    const __m128i s4 = _mm_loadu_si128((const __m128i *)(src + 2));
+    const __m128i s5 = _mm_loadu_si128((const __m128i *)(src + 3));
+    const __m128i lo = filter_mpeg2(
+        _mm_unpacklo_epi8(s0, zero), _mm_unpacklo_epi8(s1, zero),
+        _mm_unpacklo_epi8(s2, zero), _mm_unpacklo_epi8(s3, zero),
+        _mm_unpacklo_epi8(s4, zero), _mm_unpacklo_epi8(s5, zero));
+    const __m128i hi = filter_mpeg2(
+        _mm_unpackhi_epi8(s0, zero), _mm_unpackhi_epi8(s1, zero),
+        _mm_unpackhi_epi8(s2, zero), _mm_unpackhi_epi8(s3, zero),
+        _mm_unpackhi_epi8(s4, zero), _mm_unpackhi_epi8(s5, zero));
+    _mm_storeu_si128((__m128i *)(_dst + x), _mm_packus_epi16(lo, hi));
+  }
+  if (x < _w) y4m_42xmpeg2_42xjpeg_row_c(_dst + x, _src + x, _w - x);
+}
+
+void y4m_444_420jpeg_row_sse2(unsigned char *_dst, const unsigned char *_src,
+                              int _w) {
+  const __m128i mask = _mm_set1_epi16(0x00ff);
+  int x;
+  for (x = 0; x + 8 <= _w; x += 8) {
+    const unsigned char *src = _src + 2 * x;
+    /*Output x takes src[2x - 2] to src[2x + 3], which are the even and odd
+       samples of these three loads.*/
+    const __m128i s0 = _mm_loadu_si128((const __m128i *)(src - 2));
+    const __m128i s1 = _mm_loadu_si128((const __m128i *)src);
+    const __m128i s2 = _mm_loadu_si128((const __m128i *)(src + 2));
+    const __m128i out = filter_jpeg(
+        _mm_and_si128(s0, mask), _mm_srli_epi16(s0, 8), _mm_and_si128(s1, mask),
+        _mm_srli_epi16(s1, 8), _mm_and_si128(s2, mask), _mm_srli_epi16(s2, 8));
+    _mm_storel_epi64((__m128i *)(_dst + x), _mm_packus_epi16(out, out));
+  }
+  if (x < _w) y4m_444_420jpeg_row_c(_dst + x, _src + 2 * x, _w - x);
+}